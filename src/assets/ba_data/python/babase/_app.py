@@ -593,6 +593,7 @@ class App:
         """
         assert _babase.in_logic_thread()
         assert not self._initial_sign_in_completed
+        _babase.mark_startup_phase('initial_sign_in')
 
         # Tell meta it can start scanning extra stuff that just showed
         # up (namely account workspaces).
@@ -788,6 +789,8 @@ class App:
 
         # __FEATURESET_APP_SUBSYSTEM_CREATE_END__
 
+        _babase.mark_startup_phase('app_subsystems_create')
+
         # We're a pretty short-lived state. This should flip us to
         # 'loading'.
         self._init_completed = True
@@ -828,8 +831,11 @@ class App:
         """Called when meta-scan is done doing its thing."""
         assert _babase.in_logic_thread()
 
+        _babase.mark_startup_phase('meta_scan')
+
         # Now that we know what's out there, build our final plugin set.
         self.plugins.on_meta_scan_complete()
+        _babase.mark_startup_phase('plugins_load')
 
         assert not self._meta_scan_completed
         self._meta_scan_completed = True
@@ -138,6 +138,9 @@ class DevConsoleSubsystem:
             DevConsoleTabAppModes,
             DevConsoleTabUI,
             DevConsoleTabLogging,
+            DevConsoleTabEventLoops,
+            DevConsoleTabAudio,
+            DevConsoleTabMemory,
             DevConsoleTabTest,
         )
 
@@ -148,6 +151,9 @@ class DevConsoleSubsystem:
             DevConsoleTabEntry('AppModes', DevConsoleTabAppModes),
             DevConsoleTabEntry('UI', DevConsoleTabUI),
             DevConsoleTabEntry('Logging', DevConsoleTabLogging),
+            DevConsoleTabEntry('EventLoops', DevConsoleTabEventLoops),
+            DevConsoleTabEntry('Audio', DevConsoleTabAudio),
+            DevConsoleTabEntry('Memory', DevConsoleTabMemory),
         ]
         if os.environ.get('BA_DEV_CONSOLE_TEST_TAB', '0') == '1':
             self.tabs.append(DevConsoleTabEntry('Test', DevConsoleTabTest))
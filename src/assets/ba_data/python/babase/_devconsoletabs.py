@@ -604,6 +604,311 @@ class DevConsoleTabLogging(DevConsoleTab):
         )
 
 
+class DevConsoleTabEventLoops(DevConsoleTab):
+    """Tab showing latency and queue metrics for event loops."""
+
+    @override
+    def refresh(self) -> None:
+        enabled = _babase.get_event_loop_metrics_enabled()
+        bwidth = 140.0
+        bheight = 30.0
+        top = self.height - 10.0
+        left = 10.0
+        self.button(
+            'Metrics ON' if enabled else 'Metrics OFF',
+            pos=(left, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._toggle_enabled,
+            style='bright' if enabled else 'normal',
+        )
+        self.button(
+            'Refresh',
+            pos=(left + bwidth + 10.0, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self.request_refresh,
+        )
+        self.button(
+            'Reset',
+            pos=(left + 2.0 * (bwidth + 10.0), top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._reset,
+        )
+
+        bounds = _babase.get_event_loop_latency_bucket_bounds()
+        metrics = _babase.get_event_loop_metrics()
+        y = top - bheight - 25.0
+        row_height = 18.0
+        columns: list[tuple[str, float, Literal['left', 'right']]] = [
+            ('Loop', 0.0, 'left'),
+            ('Calls', 200.0, 'right'),
+            ('Avg Lat', 290.0, 'right'),
+            ('Max Lat', 380.0, 'right'),
+            (f'>{self._fmt_us(bounds[2])}', 450.0, 'right'),
+            ('Depth', 520.0, 'right'),
+            ('Max Depth', 610.0, 'right'),
+            ('Busiest Source', 630.0, 'left'),
+        ]
+        for label, x, align in columns:
+            self.text(
+                label,
+                pos=(left + x, y),
+                h_anchor='left',
+                h_align=align,
+                scale=0.6,
+            )
+        for name, entry in sorted(metrics.items()):
+            y -= row_height
+            calls = entry['calls']
+            avg = entry['latency_total_us'] // calls if calls else 0
+            slow = sum(entry['latency_histogram'][3:])
+            sources = entry['sources']
+            busiest = (
+                max(sources.items(), key=lambda i: i[1]['total_us'])
+                if sources
+                else None
+            )
+            vals = [
+                name,
+                str(calls),
+                self._fmt_us(avg),
+                self._fmt_us(entry['latency_max_us']),
+                str(slow),
+                str(entry['queue_depth']),
+                str(entry['queue_depth_max']),
+                (
+                    f'{busiest[0][:60]}'
+                    f' ({self._fmt_us(busiest[1]["total_us"])})'
+                    if busiest is not None
+                    else '-'
+                ),
+            ]
+            for val, (_label, x, align) in zip(vals, columns):
+                self.text(
+                    val,
+                    pos=(left + x, y),
+                    h_anchor='left',
+                    h_align=align,
+                    scale=0.5,
+                )
+
+    @staticmethod
+    def _fmt_us(val: int) -> str:
+        if val >= 1000000:
+            return f'{val / 1000000.0:.1f}s'
+        if val >= 1000:
+            return f'{val / 1000.0:.1f}ms'
+        return f'{val}us'
+
+    def _toggle_enabled(self) -> None:
+        _babase.set_event_loop_metrics_enabled(
+            not _babase.get_event_loop_metrics_enabled()
+        )
+        self.request_refresh()
+
+    def _reset(self) -> None:
+        _babase.get_event_loop_metrics(reset=True)
+        self.request_refresh()
+
+
+class DevConsoleTabAudio(DevConsoleTab):
+    """Tab showing audio-thread stats."""
+
+    @override
+    def refresh(self) -> None:
+        bwidth = 140.0
+        bheight = 30.0
+        top = self.height - 10.0
+        left = 10.0
+        self.button(
+            'Refresh',
+            pos=(left, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self.request_refresh,
+        )
+        self.button(
+            'Reset',
+            pos=(left + bwidth + 10.0, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._reset,
+        )
+
+        stats = _babase.get_audio_stats()
+        count = stats['process_count']
+        avg = stats['process_time_total_us'] // count if count else 0
+        rows = [
+            ('Process Calls', str(count)),
+            ('Avg Process Time', DevConsoleTabEventLoops._fmt_us(avg)),
+            (
+                'Max Process Time',
+                DevConsoleTabEventLoops._fmt_us(stats['process_time_max_us']),
+            ),
+            (
+                'Sources (Active/Total)',
+                f'{stats["active_sources"]}/{stats["sources"]}',
+            ),
+            ('Streaming Sources', str(stats['streaming_sources'])),
+            ('Pending Loads', str(stats['pending_loads'])),
+            ('Stream Underruns', str(stats['stream_underruns'])),
+            ('Stream Decode Misses', str(stats['stream_decode_misses'])),
+            ('OpenAL Errors', str(stats['al_errors'])),
+            ('Culled Voices', str(stats['culled_voices'])),
+            ('Stolen Voices', str(stats['stolen_voices'])),
+        ]
+        y = top - bheight - 25.0
+        for label, val in rows:
+            self.text(
+                label,
+                pos=(left, y),
+                h_anchor='left',
+                h_align='left',
+                scale=0.6,
+            )
+            self.text(
+                val,
+                pos=(left + 300.0, y),
+                h_anchor='left',
+                h_align='right',
+                scale=0.6,
+            )
+            y -= 18.0
+
+    def _reset(self) -> None:
+        _babase.get_audio_stats(reset=True)
+        self.request_refresh()
+
+
+class DevConsoleTabMemory(DevConsoleTab):
+    """Tab showing memory accounting by subsystem."""
+
+    @override
+    def refresh(self) -> None:
+        import tracemalloc
+
+        enabled = _babase.get_memory_accounting_enabled()
+        bwidth = 140.0
+        bheight = 30.0
+        top = self.height - 10.0
+        left = 10.0
+        self.button(
+            'Accounting ON' if enabled else 'Accounting OFF',
+            pos=(left, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._toggle_enabled,
+            style='bright' if enabled else 'normal',
+        )
+        self.button(
+            'Refresh',
+            pos=(left + bwidth + 10.0, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self.request_refresh,
+        )
+        self.button(
+            'Reset Rates',
+            pos=(left + 2.0 * (bwidth + 10.0), top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._reset,
+        )
+
+        report = _babase.get_memory_accounting()
+        duration = max(report['duration'], 0.001)
+        rows: list[tuple[str, int, int, float, float]] = []
+
+        # Python allocations come from tracemalloc, which we run
+        # alongside native accounting.
+        if tracemalloc.is_tracing():
+            current, _peak = tracemalloc.get_traced_memory()
+            rows.append(('Python (tracemalloc)', current, 0, 0.0, 0.0))
+        for name, asset in report['assets'].items():
+            rows.append(
+                (f'Assets: {name}', asset['bytes'], asset['count'], 0.0, 0.0)
+            )
+        for name, tag in report['tags'].items():
+            rows.append(
+                (
+                    name,
+                    tag['live_bytes'],
+                    tag['live_count'],
+                    tag['alloc_bytes'] / duration,
+                    tag['free_count'] / duration,
+                )
+            )
+
+        y = top - bheight - 25.0
+        row_height = 18.0
+        columns: list[tuple[str, float, Literal['left', 'right']]] = [
+            ('Tag', 0.0, 'left'),
+            ('Live', 460.0, 'right'),
+            ('Count', 550.0, 'right'),
+            ('Alloc/s', 650.0, 'right'),
+            ('Frees/s', 740.0, 'right'),
+        ]
+        for label, x, align in columns:
+            self.text(
+                label,
+                pos=(left + x, y),
+                h_anchor='left',
+                h_align=align,
+                scale=0.6,
+            )
+        max_rows = max(0, int((y - 10.0) / row_height))
+        for name, live, count, alloc_rate, free_rate in rows[:max_rows]:
+            y -= row_height
+            vals = [
+                name[:70],
+                self._fmt_bytes(live),
+                str(count) if count else '-',
+                self._fmt_bytes(int(alloc_rate)) if alloc_rate else '-',
+                f'{free_rate:.1f}' if free_rate else '-',
+            ]
+            for val, (_label, x, align) in zip(vals, columns):
+                self.text(
+                    val,
+                    pos=(left + x, y),
+                    h_anchor='left',
+                    h_align=align,
+                    scale=0.5,
+                )
+
+    @staticmethod
+    def _fmt_bytes(val: int) -> str:
+        if abs(val) >= 1024 * 1024:
+            return f'{val / (1024.0 * 1024.0):.1f}MB'
+        if abs(val) >= 1024:
+            return f'{val / 1024.0:.1f}KB'
+        return f'{val}B'
+
+    def _toggle_enabled(self) -> None:
+        import tracemalloc
+
+        enabled = not _babase.get_memory_accounting_enabled()
+        _babase.set_memory_accounting_enabled(enabled)
+        if enabled and not tracemalloc.is_tracing():
+            tracemalloc.start()
+        elif not enabled and tracemalloc.is_tracing():
+            tracemalloc.stop()
+        self.request_refresh()
+
+    def _reset(self) -> None:
+        _babase.get_memory_accounting(reset=True)
+        self.request_refresh()
+
+
 class DevConsoleTabTest(DevConsoleTab):
     """Test dev-console tab."""
 
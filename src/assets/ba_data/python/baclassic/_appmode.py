@@ -10,9 +10,8 @@ from typing import TYPE_CHECKING, override
 
 from bacommon.app import AppExperience
 import babase
+import bascenev1
 import bauiv1
-from bauiv1lib.connectivity import wait_for_connectivity
-from bauiv1lib.account.signin import show_sign_in_prompt
 
 import _baclassic
 
@@ -143,6 +142,20 @@ class ClassicAppMode(babase.AppMode):
         self._have_connectivity = plus.cloud.is_connected()
         self._update_for_connectivity_change(self._have_connectivity)
 
+        # Add a dev-console tab for session-command bandwidth stats.
+        if not any(t.name == 'Session' for t in app.devconsole.tabs):
+            app.devconsole.tabs.append(
+                babase.DevConsoleTabEntry(
+                    'Session', bascenev1.DevConsoleTabSessionCommands
+                )
+            )
+        if not any(t.name == 'Step' for t in app.devconsole.tabs):
+            app.devconsole.tabs.append(
+                babase.DevConsoleTabEntry(
+                    'Step', bascenev1.DevConsoleTabStepProfile
+                )
+            )
+
     @override
     def on_deactivate(self) -> None:
 
@@ -480,6 +493,7 @@ class ClassicAppMode(babase.AppMode):
         )
 
     def _root_ui_achievements_press(self) -> None:
+        from bauiv1lib.connectivity import wait_for_connectivity
         from bauiv1lib.achievements import AchievementsWindow
 
         if not self._ensure_signed_in_v1():
@@ -497,6 +511,7 @@ class ClassicAppMode(babase.AppMode):
         )
 
     def _root_ui_inbox_press(self) -> None:
+        from bauiv1lib.connectivity import wait_for_connectivity
         from bauiv1lib.inbox import InboxWindow
 
         if not self._ensure_signed_in():
@@ -512,6 +527,7 @@ class ClassicAppMode(babase.AppMode):
         )
 
     def _root_ui_store_press(self) -> None:
+        from bauiv1lib.connectivity import wait_for_connectivity
         from bauiv1lib.store.browser import StoreBrowserWindow
 
         if not self._ensure_signed_in_v1():
@@ -575,6 +591,8 @@ class ClassicAppMode(babase.AppMode):
 
     def _ensure_signed_in(self) -> bool:
         """Make sure we're signed in (requiring modern v2 accounts)."""
+        from bauiv1lib.account.signin import show_sign_in_prompt
+
         plus = bauiv1.app.plus
         if plus is None:
             bauiv1.screenmessage('This requires plus.', color=(1, 0, 0))
@@ -587,6 +605,8 @@ class ClassicAppMode(babase.AppMode):
 
     def _ensure_signed_in_v1(self) -> bool:
         """Make sure we're signed in (allowing legacy v1-only accounts)."""
+        from bauiv1lib.account.signin import show_sign_in_prompt
+
         plus = bauiv1.app.plus
         if plus is None:
             bauiv1.screenmessage('This requires plus.', color=(1, 0, 0))
@@ -611,6 +631,7 @@ class ClassicAppMode(babase.AppMode):
         )
 
     def _root_ui_chest_slot_pressed(self, index: int) -> None:
+        from bauiv1lib.connectivity import wait_for_connectivity
         from bauiv1lib.chest import (
             ChestWindow0,
             ChestWindow1,
@@ -542,6 +542,35 @@ class ClassicAppSubsystem(babase.AppSubsystem):
 
         run_cpu_benchmark()
 
+    def run_physics_benchmark(
+        self,
+        broadphases: Sequence[str] = ('hash', 'simple', 'quadtree', 'sap'),
+        body_counts: Sequence[int] = (25, 50, 100, 200),
+    ) -> None:
+        """Kick off a benchmark to test physics step speeds."""
+        from baclassic._benchmark import run_physics_benchmark
+
+        run_physics_benchmark(broadphases, body_counts)
+
+    def run_scripted_benchmark(
+        self, duration: float = 40.0, results_path: str | None = None
+    ) -> None:
+        """Kick off the scripted frame-time benchmark."""
+        from baclassic._benchmark import run_scripted_benchmark
+
+        run_scripted_benchmark(duration, results_path)
+
+    def run_replay_benchmark(
+        self,
+        file_name: str,
+        step: float = 1.0 / 60.0,
+        results_path: str | None = None,
+    ) -> None:
+        """Kick off a fixed-step replay playback benchmark."""
+        from baclassic._benchmark import run_replay_benchmark
+
+        run_replay_benchmark(file_name, step, results_path)
+
     def run_media_reload_benchmark(self) -> None:
         """Kick off a benchmark to test media reloading speeds."""
         from baclassic._benchmark import run_media_reload_benchmark
@@ -3,6 +3,7 @@
 """Benchmark/Stress-Test related functionality."""
 from __future__ import annotations
 
+import logging
 import random
 from dataclasses import dataclass
 from typing import TYPE_CHECKING, override
@@ -12,7 +13,7 @@ import bascenev1
 import _baclassic
 
 if TYPE_CHECKING:
-    from typing import Any, Sequence
+    from typing import Any, Callable, Sequence
 
 
 def run_cpu_benchmark() -> None:
@@ -53,6 +54,286 @@ def run_cpu_benchmark() -> None:
     bascenev1.new_host_session(BenchmarkSession, benchmark_type='cpu')
 
 
+def run_physics_benchmark(
+    broadphases: Sequence[str], body_counts: Sequence[int]
+) -> None:
+    """Run a physics benchmark.
+
+    Drops increasing numbers of crates into a map under each requested
+    collision broadphase and logs the average time spent per physics
+    step.
+    """
+    # pylint: disable=cyclic-import
+
+    if babase.app.classic is not None:
+        babase.app.classic.save_ui_state()
+
+    runs = [(bp, count) for bp in broadphases for count in body_counts]
+
+    class PhysicsBenchmarkActivity(
+        bascenev1.Activity[bascenev1.Player, bascenev1.Team]
+    ):
+        """Activity for physics benchmark."""
+
+        def __init__(self, settings: dict):
+            super().__init__(settings)
+            self._map_type = bascenev1.get_map_class('Football Stadium')
+            self._map_type.preload()
+            self._map: bascenev1.Map | None = None
+            self._crate_mesh = bascenev1.getmesh('tnt')
+            self._crate_tex = bascenev1.gettexture('tnt')
+            self._bodies: list[bascenev1.Node] = []
+            self._runs = list(runs)
+            self._mark: tuple[int, int] = (0, 0)
+            self._timer: bascenev1.Timer | None = None
+
+        @override
+        def on_begin(self) -> None:
+            super().on_begin()
+            self._map = self._map_type()
+            self._next_run()
+
+        def _next_run(self) -> None:
+            for body in self._bodies:
+                body.delete()
+            self._bodies = []
+            if not self._runs:
+                logging.info('Physics benchmark complete.')
+                self.session.end()
+                return
+            broadphase, count = self._runs[0]
+            self.globalsnode.physics_broadphase = broadphase
+            for _i in range(count):
+                pos = (
+                    random.uniform(-8.0, 8.0),
+                    random.uniform(2.0, 10.0),
+                    random.uniform(-4.0, 4.0),
+                )
+                self._bodies.append(
+                    bascenev1.newnode(
+                        'prop',
+                        attrs={
+                            'position': pos,
+                            'mesh': self._crate_mesh,
+                            'body': 'crate',
+                            'color_texture': self._crate_tex,
+                            'reflection': 'soft',
+                            'reflection_scale': [0.23],
+                        },
+                    )
+                )
+
+            # Let things spawn and start settling before measuring.
+            self._timer = bascenev1.Timer(1.0, self._start_measure)
+
+        def _start_measure(self) -> None:
+            gnode = self.globalsnode
+            self._mark = (gnode.step, gnode.physics_process_microsecs)
+            self._timer = bascenev1.Timer(3.0, self._end_measure)
+
+        def _end_measure(self) -> None:
+            gnode = self.globalsnode
+            steps = gnode.step - self._mark[0]
+            microsecs = gnode.physics_process_microsecs - self._mark[1]
+            broadphase, count = self._runs.pop(0)
+            logging.info(
+                'Physics benchmark: broadphase=%s bodies=%d'
+                ' avg_step_ms=%.3f (%d steps)',
+                broadphase,
+                count,
+                microsecs / max(1, steps) / 1000.0,
+                steps,
+            )
+            self._next_run()
+
+    class PhysicsBenchmarkSession(bascenev1.Session):
+        """Session type for physics benchmark."""
+
+        def __init__(self) -> None:
+            depsets: Sequence[bascenev1.DependencySet] = []
+            super().__init__(depsets)
+            self.benchmark_type = 'physics'
+            self.setactivity(bascenev1.newactivity(PhysicsBenchmarkActivity))
+
+        @override
+        def on_player_request(self, player: bascenev1.SessionPlayer) -> bool:
+            return False
+
+    bascenev1.new_host_session(PhysicsBenchmarkSession)
+
+
+def run_scripted_benchmark(
+    duration: float = 40.0, results_path: str | None = None
+) -> None:
+    """Run the built-in scripted benchmark.
+
+    Plays a fixed scenario: a camera fly-through of a map that fills up
+    with bots, with particle-heavy explosions on a set schedule. Frame,
+    logic and render time percentiles are logged as json when done and
+    also written to results_path if given, so devices and builds can be
+    compared.
+    """
+    # pylint: disable=cyclic-import
+    from bascenev1lib.actor import spazbot
+    from bascenev1lib.actor.bomb import Blast
+
+    if babase.app.classic is not None:
+        babase.app.classic.save_ui_state()
+
+    bot_types: list[type[spazbot.SpazBot]] = [
+        spazbot.BrawlerBot,
+        spazbot.BomberBot,
+        spazbot.ChargerBot,
+        spazbot.TriggerBot,
+        spazbot.StickyBot,
+        spazbot.BouncyBot,
+    ]
+
+    # Camera keys as (fraction of duration, position, target).
+    camera_keys = [
+        (0.0, (0.0, 12.0, 20.0), (0.0, 1.0, 0.0)),
+        (0.2, (-14.0, 6.0, 10.0), (-4.0, 1.0, 0.0)),
+        (0.4, (-4.0, 3.0, 6.0), (0.0, 1.0, 0.0)),
+        (0.6, (10.0, 4.0, 8.0), (4.0, 1.0, 0.0)),
+        (0.8, (14.0, 10.0, -8.0), (0.0, 1.0, 0.0)),
+        (1.0, (0.0, 16.0, 14.0), (0.0, 1.0, 0.0)),
+    ]
+
+    class ScriptedBenchmarkActivity(
+        bascenev1.Activity[bascenev1.Player, bascenev1.Team]
+    ):
+        """Activity for the scripted benchmark."""
+
+        def __init__(self, settings: dict):
+            super().__init__(settings)
+            self._map_type = bascenev1.get_map_class('Football Stadium')
+            self._map_type.preload()
+            self._map: bascenev1.Map | None = None
+            self._bots: spazbot.SpazBotSet | None = None
+            self._rand = random.Random(1234)
+            self._timers: list[bascenev1.Timer] = []
+
+        @override
+        def on_begin(self) -> None:
+            super().on_begin()
+            self._map = self._map_type()
+            self._bots = spazbot.SpazBotSet()
+
+            # Bot AI draws from the global generator; seed it so runs
+            # play out as similarly as possible.
+            random.seed(1234)
+
+            # Characters pile in over the first half; explosions and
+            # particle bursts happen throughout.
+            for i in range(24):
+                self._timers.append(
+                    bascenev1.Timer(
+                        0.5 + i * duration * 0.5 / 24,
+                        babase.Call(self._spawn_bot, i),
+                    )
+                )
+            burst_time = 3.0
+            while burst_time < duration - 1.0:
+                self._timers.append(bascenev1.Timer(burst_time, self._burst))
+                burst_time += 2.5
+            self._timers.append(bascenev1.Timer(duration, self._finish))
+
+            _baclassic.start_scripted_benchmark(
+                [
+                    (frac * duration, *pos, *target)
+                    for frac, pos, target in camera_keys
+                ],
+                info={
+                    'scenario': 'scripted_v1',
+                    'graphics_quality': str(
+                        babase.app.config.resolve('Graphics Quality')
+                    ),
+                    'texture_quality': str(
+                        babase.app.config.resolve('Texture Quality')
+                    ),
+                },
+            )
+
+        def _spawn_bot(self, index: int) -> None:
+            assert self._bots is not None
+            pos = (
+                self._rand.uniform(-10.0, 10.0),
+                1.0,
+                self._rand.uniform(-5.0, 5.0),
+            )
+            self._bots.spawn_bot(
+                bot_types[index % len(bot_types)], pos=pos, spawn_time=0.5
+            )
+
+        def _burst(self) -> None:
+            pos = (
+                self._rand.uniform(-8.0, 8.0),
+                1.0,
+                self._rand.uniform(-4.0, 4.0),
+            )
+            Blast(position=pos, blast_radius=2.5).autoretain()
+            bascenev1.emitfx(
+                position=pos,
+                velocity=(0.0, 6.0, 0.0),
+                count=300,
+                scale=1.2,
+                spread=2.0,
+                chunk_type='spark',
+            )
+            bascenev1.emitfx(
+                position=pos,
+                count=100,
+                spread=1.5,
+                chunk_type='ice',
+            )
+
+        def _finish(self) -> None:
+            results = _baclassic.stop_scripted_benchmark(
+                results_path=results_path
+            )
+            logging.info('Scripted benchmark results: %s', results)
+            self._timers = []
+            if self._bots is not None:
+                self._bots.clear()
+            self.session.end()
+
+    class ScriptedBenchmarkSession(bascenev1.Session):
+        """Session type for the scripted benchmark."""
+
+        def __init__(self) -> None:
+            depsets: Sequence[bascenev1.DependencySet] = []
+            super().__init__(depsets)
+            self.benchmark_type = 'gpu'
+            self.setactivity(bascenev1.newactivity(ScriptedBenchmarkActivity))
+
+        @override
+        def on_player_request(self, player: bascenev1.SessionPlayer) -> bool:
+            return False
+
+    bascenev1.new_host_session(ScriptedBenchmarkSession, benchmark_type='gpu')
+
+
+def run_replay_benchmark(
+    file_name: str,
+    step: float = 1.0 / 60.0,
+    results_path: str | None = None,
+    call: Callable[[str], None] | None = None,
+) -> None:
+    """Play a replay through as a regression benchmark.
+
+    Display-time advances by exactly step seconds per update so each run
+    simulates and draws the same frames regardless of how fast the device
+    is. Session update, scene draw and frame timing percentiles are
+    passed to call as json when done (or logged if no call is given) and
+    also written to results_path if given. Works in headless builds too.
+    """
+    if babase.app.classic is not None:
+        babase.app.classic.save_ui_state()
+    _baclassic.start_replay_benchmark(
+        file_name, step=step, results_path=results_path, call=call
+    )
+
+
 @dataclass
 class _StressTestArgs:
     playlist_type: str
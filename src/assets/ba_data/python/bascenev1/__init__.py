@@ -62,6 +62,7 @@ from babase import (
 
 from _bascenev1 import (
     ActivityData,
+    analyze_replay,
     basetime,
     basetimer,
     BaseTimer,
@@ -89,6 +90,7 @@ from _bascenev1 import (
     get_public_party_max_size,
     get_random_names,
     get_replay_speed_exponent,
+    get_session_command_stats,
     get_ui_input_device,
     getactivity,
     getcollisionmesh,
@@ -113,6 +115,7 @@ from _bascenev1 import (
     new_replay_session,
     newactivity,
     newnode,
+    newnodes,
     Node,
     pause_replay,
     printnodes,
@@ -140,7 +143,10 @@ from _bascenev1 import (
     set_public_party_queue_enabled,
     set_public_party_stats_url,
     set_replay_speed_exponent,
+    set_session_command_stats_enabled,
+    set_spectator_relay_enabled,
     set_touchscreen_editing,
+    set_upstream_bandwidth_limit,
     Sound,
     Texture,
     time,
@@ -154,7 +160,11 @@ from bascenev1._campaign import init_campaigns, Campaign
 from bascenev1._collision import Collision, getcollision
 from bascenev1._coopgame import CoopGameActivity
 from bascenev1._coopsession import CoopSession
-from bascenev1._debug import print_live_object_warnings
+from bascenev1._debug import (
+    DevConsoleTabSessionCommands,
+    DevConsoleTabStepProfile,
+    print_live_object_warnings,
+)
 from bascenev1._dependency import (
     Dependency,
     DependencyComponent,
@@ -247,6 +257,7 @@ __all__ = [
     'Activity',
     'ActivityData',
     'Actor',
+    'analyze_replay',
     'animate',
     'animate_array',
     'add_clean_frame_callback',
@@ -290,6 +301,8 @@ __all__ = [
     'Dependency',
     'DependencyComponent',
     'DependencySet',
+    'DevConsoleTabSessionCommands',
+    'DevConsoleTabStepProfile',
     'DieMessage',
     'disconnect_client',
     'disconnect_from_host',
@@ -337,6 +350,7 @@ __all__ = [
     'get_random_names',
     'get_remote_app_name',
     'get_replay_speed_exponent',
+    'get_session_command_stats',
     'get_trophy_string',
     'get_ui_input_device',
     'getactivity',
@@ -380,6 +394,7 @@ __all__ = [
     'new_replay_session',
     'newactivity',
     'newnode',
+    'newnodes',
     'Node',
     'NodeActor',
     'NodeNotFoundError',
@@ -438,7 +453,10 @@ __all__ = [
     'set_player_rejoin_cooldown',
     'set_max_players_override',
     'set_replay_speed_exponent',
+    'set_session_command_stats_enabled',
+    'set_spectator_relay_enabled',
     'set_touchscreen_editing',
+    'set_upstream_bandwidth_limit',
     'setmusic',
     'Setting',
     'ShouldShatterMessage',
@@ -76,6 +76,40 @@ class Activity(DependencyComponent, Generic[PlayerT, TeamT]):
        the current map. Generally this should be on for games and off for
        transitions/score-screens/etc. that persist between maps."""
 
+    physics_broadphase = 'hash'
+    """Collision broadphase used by the scene's physics; one of 'hash',
+       'simple', 'quadtree', or 'sap'. The default works well for typical
+       games; activities with unusual body counts or layouts may benefit
+       from another."""
+
+    physics_parallel_islands = False
+    """If True, independent groups of touching bodies are solved on
+       multiple threads. Results are identical either way; this can help
+       activities with lots of bodies stay within the step budget."""
+
+    batch_collision_callbacks = False
+    """If True, material 'call' actions triggered during a physics step
+       are collected and handed to Python together at the end of the
+       step's collision processing instead of one at a time. Callbacks
+       still run in the same order and with bascenev1.getcollision()
+       describing their collision; this just cuts per-call overhead in
+       activities with lots of them."""
+
+    physics_deterministic = False
+    """If True, physics steps are computed so that identical state and
+       inputs always give identical results (pinned float modes, serial
+       island solving, collisions handled in a fixed order). Somewhat
+       slower; meant for lockstep/rollback style experiments. Results
+       still only match between builds using the same compiler settings."""
+
+    coalesce_collision_messages = False
+    """If True, a material 'message' action sent to the same node on
+       behalf of the same opposing node several times within a physics
+       step (such as a blast touching each part of a character) is only
+       delivered once. This cuts down on message storms from big
+       explosions but only suits handlers that don't care how many parts
+       are touching."""
+
     slow_motion = False
     """If True, runs in slow motion and turns down sound pitch."""
 
@@ -416,6 +450,13 @@ class Activity(DependencyComponent, Generic[PlayerT, TeamT]):
             # set some global values based on what the activity wants.
             glb.use_fixed_vr_overlay = self.use_fixed_vr_overlay
             glb.allow_kick_idle_players = self.allow_kick_idle_players
+            glb.physics_broadphase = self.physics_broadphase
+            glb.physics_parallel_islands = self.physics_parallel_islands
+            glb.batch_collision_callbacks = self.batch_collision_callbacks
+            glb.physics_deterministic = self.physics_deterministic
+            glb.coalesce_collision_messages = (
+                self.coalesce_collision_messages
+            )
             if self.inherits_slow_motion and prev_globals is not None:
                 glb.slow_motion = prev_globals.slow_motion
             else:
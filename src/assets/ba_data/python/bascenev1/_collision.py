@@ -4,12 +4,15 @@
 
 from __future__ import annotations
 
+import logging
 from typing import TYPE_CHECKING
 
 import babase
 import _bascenev1
 
 if TYPE_CHECKING:
+    from typing import Any, Callable
+
     import bascenev1
 
 
@@ -19,9 +22,24 @@ class Collision:
     Category: **Gameplay Classes**
     """
 
+    def __init__(self) -> None:
+        # Snapshot of collision info while running batched callbacks:
+        # (position, sourcenode, opposingnode, opposingbody).
+        self._batched_info: (
+            tuple[
+                tuple[float, float, float],
+                bascenev1.Node | None,
+                bascenev1.Node | None,
+                int,
+            ]
+            | None
+        ) = None
+
     @property
     def position(self) -> bascenev1.Vec3:
         """The position of the current collision."""
+        if self._batched_info is not None:
+            return babase.Vec3(self._batched_info[0])
         return babase.Vec3(_bascenev1.get_collision_info('position'))
 
     @property
@@ -32,7 +50,10 @@ class Collision:
         though the node should always exist (at least at the start of the
         collision callback).
         """
-        node = _bascenev1.get_collision_info('sourcenode')
+        if self._batched_info is not None:
+            node = self._batched_info[1]
+        else:
+            node = _bascenev1.get_collision_info('sourcenode')
         assert isinstance(node, (_bascenev1.Node, type(None)))
         if not node:
             raise babase.NodeNotFoundError()
@@ -46,7 +67,10 @@ class Collision:
         This can be expected in some cases such as in 'disconnect'
         callbacks triggered by deleting a currently-colliding node.
         """
-        node = _bascenev1.get_collision_info('opposingnode')
+        if self._batched_info is not None:
+            node = self._batched_info[2]
+        else:
+            node = _bascenev1.get_collision_info('opposingnode')
         assert isinstance(node, (_bascenev1.Node, type(None)))
         if not node:
             raise babase.NodeNotFoundError()
@@ -55,6 +79,8 @@ class Collision:
     @property
     def opposingbody(self) -> int:
         """The body index on the opposing node in the current collision."""
+        if self._batched_info is not None:
+            return self._batched_info[3]
         body = _bascenev1.get_collision_info('opposingbody')
         assert isinstance(body, int)
         return body
@@ -70,3 +96,23 @@ def getcollision() -> Collision:
     Category: **Gameplay Functions**
     """
     return _collision
+
+
+def dispatch_collision_batch(
+    events: list[tuple[Callable[[], Any], Any]]
+) -> None:
+    """Run material callbacks queued up during a physics step.
+
+    (internal)
+
+    Used when an activity enables batch_collision_callbacks; each event
+    is a callable and a snapshot of the collision it was triggered by.
+    """
+    for call, info in events:
+        _collision._batched_info = info  # pylint: disable=protected-access
+        try:
+            call()
+        except Exception:
+            logging.exception('Error in collision callback %s.', call)
+        finally:
+            _collision._batched_info = None  # pylint: disable=protected-access
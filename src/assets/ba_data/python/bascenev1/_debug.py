@@ -3,12 +3,14 @@
 """Debugging functionality."""
 from __future__ import annotations
 
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, override
 
 import babase
 
+import _bascenev1
+
 if TYPE_CHECKING:
-    from typing import Any
+    from typing import Any, Literal
 
     import bascenev1
 
@@ -66,3 +68,192 @@ def print_live_object_warnings(
     for actor in actors:
         babase.app.classic.printed_live_object_warning = True
         print(f'ERROR: Actor found {when}: {actor}')
+
+
+class DevConsoleTabSessionCommands(babase.DevConsoleTab):
+    """Dev-console tab showing which session commands use bandwidth."""
+
+    def __init__(self) -> None:
+        self._enabled = False
+
+    @override
+    def refresh(self) -> None:
+        bwidth = 140.0
+        bheight = 30.0
+        top = self.height - 10.0
+        left = 10.0
+        self.button(
+            'Stats ON' if self._enabled else 'Stats OFF',
+            pos=(left, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._toggle_enabled,
+            style='bright' if self._enabled else 'normal',
+        )
+        self.button(
+            'Refresh',
+            pos=(left + bwidth + 10.0, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self.request_refresh,
+        )
+        self.button(
+            'Reset',
+            pos=(left + 2.0 * (bwidth + 10.0), top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._reset,
+        )
+
+        # Biggest consumers first.
+        stats = _bascenev1.get_session_command_stats()
+        entries = sorted(
+            stats.items(),
+            key=lambda item: item[1]['compressed_bytes'],
+            reverse=True,
+        )
+        total = sum(entry['compressed_bytes'] for entry in stats.values())
+        y = top - bheight - 25.0
+        row_height = 18.0
+        columns: list[tuple[str, float, Literal['left', 'right']]] = [
+            ('Command', 0.0, 'left'),
+            ('Count', 360.0, 'right'),
+            ('Bytes', 470.0, 'right'),
+            ('Compressed', 590.0, 'right'),
+            ('Share', 660.0, 'right'),
+        ]
+        for label, x, align in columns:
+            self.text(
+                label,
+                pos=(left + x, y),
+                h_anchor='left',
+                h_align=align,
+                scale=0.6,
+            )
+        max_rows = max(0, int((y - 10.0) / row_height) - 1)
+        for name, entry in entries[:max_rows]:
+            y -= row_height
+            share = 100.0 * entry['compressed_bytes'] / max(total, 1)
+            vals = [
+                name,
+                str(entry['count']),
+                str(entry['bytes']),
+                str(entry['compressed_bytes']),
+                f'{share:.1f}%',
+            ]
+            for val, (_label, x, align) in zip(vals, columns):
+                self.text(
+                    val,
+                    pos=(left + x, y),
+                    h_anchor='left',
+                    h_align=align,
+                    scale=0.5,
+                )
+
+    def _toggle_enabled(self) -> None:
+        self._enabled = not self._enabled
+        _bascenev1.set_session_command_stats_enabled(self._enabled)
+        self.request_refresh()
+
+    def _reset(self) -> None:
+        _bascenev1.get_session_command_stats(reset=True)
+        self.request_refresh()
+
+
+class DevConsoleTabStepProfile(babase.DevConsoleTab):
+    """Dev-console tab showing where scene step time goes."""
+
+    def __init__(self) -> None:
+        self._enabled = False
+
+    @override
+    def refresh(self) -> None:
+        bwidth = 140.0
+        bheight = 30.0
+        top = self.height - 10.0
+        left = 10.0
+        self.button(
+            'Profile ON' if self._enabled else 'Profile OFF',
+            pos=(left, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._toggle_enabled,
+            style='bright' if self._enabled else 'normal',
+        )
+        self.button(
+            'Refresh',
+            pos=(left + bwidth + 10.0, top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self.request_refresh,
+        )
+        self.button(
+            'Reset',
+            pos=(left + 2.0 * (bwidth + 10.0), top - bheight),
+            size=(bwidth, bheight),
+            h_anchor='left',
+            label_scale=0.6,
+            call=self._reset,
+        )
+
+        profile = _bascenev1.get_step_profile()
+        steps = max(1, profile['steps'])
+
+        # Phases first, then node types and material actions, each
+        # biggest first.
+        rows: list[tuple[str, str, float]] = [
+            ('phase', name, val)
+            for name, val in profile['phases'].items()
+        ]
+        for kind in ('node_types', 'material_actions'):
+            rows += sorted(
+                (
+                    (kind[:-1], name, entry['ms'])
+                    for name, entry in profile[kind].items()
+                ),
+                key=lambda row: row[2],
+                reverse=True,
+            )
+
+        y = top - bheight - 25.0
+        row_height = 18.0
+        columns: list[tuple[str, float, Literal['left', 'right']]] = [
+            ('Kind', 0.0, 'left'),
+            ('Name', 140.0, 'left'),
+            ('Total ms', 500.0, 'right'),
+            ('ms/step', 610.0, 'right'),
+        ]
+        for label, x, align in columns:
+            self.text(
+                label,
+                pos=(left + x, y),
+                h_anchor='left',
+                h_align=align,
+                scale=0.6,
+            )
+        max_rows = max(0, int((y - 10.0) / row_height) - 1)
+        for kind, name, total in rows[:max_rows]:
+            y -= row_height
+            vals = [kind, name, f'{total:.1f}', f'{total / steps:.3f}']
+            for val, (_label, x, align) in zip(vals, columns):
+                self.text(
+                    val,
+                    pos=(left + x, y),
+                    h_anchor='left',
+                    h_align=align,
+                    scale=0.5,
+                )
+
+    def _toggle_enabled(self) -> None:
+        self._enabled = not self._enabled
+        _bascenev1.set_step_profiling_enabled(self._enabled)
+        self.request_refresh()
+
+    def _reset(self) -> None:
+        _bascenev1.get_step_profile(reset=True)
+        self.request_refresh()
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -26,6 +27,31 @@
 
 namespace ballistica::base {
 
+// In lowest-latency mode we sleep until this close to our next frame and
+// then spin the rest of the way so frames kick off right on time.
+const microsecs_t kPreciseSleepSpinTime{1000};
+
+// Whether an event is user input that should show up on screen.
+static auto IsInputEvent(const SDL_Event& event) -> bool {
+  switch (event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+    case SDL_TEXTINPUT:
+    case SDL_MOUSEMOTION:
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+    case SDL_MOUSEWHEEL:
+    case SDL_JOYAXISMOTION:
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+    case SDL_JOYBALLMOTION:
+    case SDL_JOYHATMOTION:
+      return true;
+    default:
+      return false;
+  }
+}
+
 /// RAII-friendly way to mark where in the main thread we're allowed to run
 /// graphics code (only applies in strict-graphics-context mode).
 class AppAdapterSDL::ScopedAllowGraphics_ {
@@ -215,12 +241,16 @@ void AppAdapterSDL::RunMainThreadEventLoopToCompletion() {
     // Events.
     SDL_Event event;
     while (SDL_PollEvent(&event) && (!done_)) {
+      if (pending_input_time_ == 0 && IsInputEvent(event)) {
+        pending_input_time_ = g_core->AppTimeMicrosecs();
+      }
       HandleSDLEvent_(event);
     }
 
     // Draw.
     if (!hidden_ && TryRender()) {
       SDL_GL_SwapWindow(sdl_window_);
+      UpdateInputLatency_();
     }
 
     // Sleep.
@@ -258,6 +288,25 @@ auto AppAdapterSDL::TryRender() -> bool {
   }
 }
 
+void AppAdapterSDL::UpdateInputLatency_() {
+  // Any frame built after we saw input should be showing it. This is
+  // measured to when our swap returns, which with vsync on is about when
+  // the frame actually hits the screen.
+  if (pending_input_time_ == 0
+      || g_base->graphics_server->last_rendered_frame_build_time()
+             < pending_input_time_) {
+    return;
+  }
+  auto latency_ms =
+      static_cast<float>(g_core->AppTimeMicrosecs() - pending_input_time_)
+      / 1000.0f;
+  pending_input_time_ = 0;
+  g_base->logic->event_loop()->PushCall([latency_ms] {
+    g_base->graphics->SetTimingLaneValue(TimingLane::kInputLatency,
+                                         latency_ms);
+  });
+}
+
 void AppAdapterSDL::SleepUntilNextEventCycle_(microsecs_t cycle_start_time) {
   // Special case: if we're hidden, we simply sleep for a long bit; no fancy
   // timing.
@@ -292,6 +341,23 @@ void AppAdapterSDL::SleepUntilNextEventCycle_(microsecs_t cycle_start_time) {
   if (vsync_actually_enabled_) {
     millisecs_per_frame = 99 * millisecs_per_frame / 100;
   }
+
+  // In lowest-latency mode we want frames going out at exact intervals, so
+  // we sleep most of the way and spin the rest instead of leaning on the
+  // oversleep system to even things out over time.
+  if (g_base->graphics_server->lowest_latency()) {
+    microsecs_t target_time = cycle_start_time + millisecs_per_frame;
+    if (target_time - now > kPreciseSleepSpinTime) {
+      g_core->platform->SleepMicrosecs(target_time - now
+                                       - kPreciseSleepSpinTime);
+    }
+    while (g_core->AppTimeMicrosecs() < target_time) {
+      std::this_thread::yield();
+    }
+    oversleep_ = 0;
+    return;
+  }
+
   microsecs_t target_time = cycle_start_time + millisecs_per_frame - oversleep_;
 
   // Set a minimum so we don't sleep if we're within a few millisecs of
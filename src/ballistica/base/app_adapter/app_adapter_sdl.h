@@ -75,6 +75,7 @@ class AppAdapterSDL : public AppAdapter {
   void AddSDLInputDevice_(JoystickInput* input, int index);
   void RemoveSDLInputDevice_(int index);
   void SleepUntilNextEventCycle_(microsecs_t cycle_start_time);
+  void UpdateInputLatency_();
 
   int max_fps_{60};
   bool done_{};
@@ -96,6 +97,9 @@ class AppAdapterSDL : public AppAdapter {
   std::mutex strict_graphics_calls_mutex_;
   std::vector<Runnable*> strict_graphics_calls_;
   microsecs_t oversleep_{};
+
+  /// When we first saw input that hasn't made it to the screen yet (or 0).
+  microsecs_t pending_input_time_{};
   std::vector<JoystickInput*> sdl_joysticks_;
   Vector2f window_size_{1.0f, 1.0f};
   SDL_Window* sdl_window_{};
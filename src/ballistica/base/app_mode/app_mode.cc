@@ -49,6 +49,8 @@ auto AppMode::GetHeadlessNextDisplayTimeStep() -> microsecs_t {
   return kHeadlessMaxDisplayTimeStep;
 }
 
+auto AppMode::IsHeadlessIdle() -> bool { return false; }
+
 auto AppMode::GetPartySize() const -> int { return 0; }
 
 auto AppMode::GetNetworkDebugString() -> std::string { return ""; }
@@ -47,6 +47,13 @@ class AppMode {
   /// builds.
   virtual auto GetHeadlessNextDisplayTimeStep() -> microsecs_t;
 
+  /// Return whether the app-mode currently has nothing to do until some
+  /// outside event arrives. Headless builds sleep up to
+  /// kHeadlessIdleMaxDisplayTimeStep between steps while this is true; the
+  /// app-mode must call Logic::WakeHeadlessDisplayTime() when it stops
+  /// being idle.
+  virtual auto IsHeadlessIdle() -> bool;
+
   /// Create a delegate for an input-device.
   /// Return a raw pointer allocated using Object::NewDeferred.
   virtual auto CreateInputDeviceDelegate(InputDevice* device)
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_ASSETS_ASSET_H_
 #define BALLISTICA_BASE_ASSETS_ASSET_H_
 
+#include <atomic>
 #include <mutex>
 #include <string>
 
@@ -36,6 +37,21 @@ class Asset : public Object {
   virtual auto GetName() const -> std::string { return "invalid"; }
   virtual auto GetNameFull() const -> std::string { return GetName(); }
 
+  /// Rough number of bytes a pending Load() will push to the renderer/etc.
+  /// Used to spread loads across frames. Should only be called from the
+  /// thread that runs the asset's loads.
+  virtual auto GetPendingLoadSize() const -> size_t { return 0; }
+
+  /// Rough number of bytes of CPU and GPU memory this asset holds once
+  /// loaded. Used to keep asset types within their memory budgets when
+  /// pruning. Can be called from any thread.
+  virtual auto GetMemoryCost() const -> size_t { return memory_cost_; }
+
+  /// Whether DoPreload() can run on a worker thread alongside other
+  /// preloads. Assets relying on non-thread-safe platform calls should
+  /// return false to be preloaded directly on the assets thread.
+  virtual auto CanPreloadConcurrently() const -> bool { return true; }
+
   // Used to lock asset payloads for modification in a RAII manner.
   // FIXME - need to better define the times when payloads need to
   //  be locked. For instance, we ensure everything is loaded at the
@@ -101,6 +117,8 @@ class Asset : public Object {
   // (same as DoLoad).
   virtual void DoUnload() = 0;
 
+  void set_memory_cost(size_t val) { memory_cost_ = val; }
+
   // Do we still use/need this?
   bool valid_ = false;
 
@@ -122,6 +140,7 @@ class Asset : public Object {
   // we only include a single reference to ourself in it.
   int64_t last_frame_def_num_ = 0;
   millisecs_t last_used_time_ = 0;
+  std::atomic<size_t> memory_cost_{};
   bool preloaded_ = false;
   bool loaded_ = false;
   std::mutex mutex_;
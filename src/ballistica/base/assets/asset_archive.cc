@@ -0,0 +1,237 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/assets/asset_archive.h"
+
+#if !BA_OSTYPE_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "ballistica/base/assets/assets.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+const uint32_t kAssetArchiveMagic = 0x4B504142;  // 'BAPK'
+const uint32_t kAssetArchiveVersion = 1;
+const size_t kAssetArchiveHeaderSize = 16;
+const size_t kAssetArchiveEntryHeaderSize = 20;
+
+static auto ReadU32_(const uint8_t* src) -> uint32_t {
+  uint32_t val;
+  memcpy(&val, src, sizeof(val));
+  return val;
+}
+
+static auto ReadU64_(const uint8_t* src) -> uint64_t {
+  uint64_t val;
+  memcpy(&val, src, sizeof(val));
+  return val;
+}
+
+auto MappedFile::Open(const std::string& path) -> std::unique_ptr<MappedFile> {
+  std::unique_ptr<MappedFile> file{new MappedFile()};
+
+#if BA_OSTYPE_WINDOWS
+  // No mmap here; just pull the whole thing in.
+  FILE* f = g_core->platform->FOpen(path.c_str(), "rb");
+  if (!f) {
+    return nullptr;
+  }
+  fseek(f, 0, SEEK_END);
+  long file_size = ftell(f);  // NOLINT
+  fseek(f, 0, SEEK_SET);
+  if (file_size > 0) {
+    file->buffer_.resize(static_cast<size_t>(file_size));
+    if (fread(file->buffer_.data(), file->buffer_.size(), 1, f) != 1) {
+      fclose(f);
+      return nullptr;
+    }
+  }
+  fclose(f);
+  file->data_ = file->buffer_.data();
+  file->size_ = file->buffer_.size();
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st{};
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  file->size_ = static_cast<size_t>(st.st_size);
+  if (file->size_ > 0) {
+    void* mem = mmap(nullptr, file->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mem == MAP_FAILED) {
+      close(fd);
+      return nullptr;
+    }
+    file->data_ = static_cast<const uint8_t*>(mem);
+    file->mapped_ = true;
+  }
+
+  // The mapping keeps the file alive on its own.
+  close(fd);
+#endif
+
+  return file;
+}
+
+MappedFile::~MappedFile() {
+#if !BA_OSTYPE_WINDOWS
+  if (mapped_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+#endif
+}
+
+auto AssetArchive::Open(const std::string& path)
+    -> std::unique_ptr<AssetArchive> {
+  if (!g_core->platform->FilePathExists(path)) {
+    return nullptr;
+  }
+  std::unique_ptr<AssetArchive> archive{new AssetArchive()};
+  archive->path_ = path;
+  archive->file_ = MappedFile::Open(path);
+  if (!archive->file_) {
+    throw Exception("Can't open asset archive: '" + path + "'");
+  }
+  archive->data_ = archive->file_->data();
+  archive->size_ = archive->file_->size();
+  archive->Index_();
+  return archive;
+}
+
+AssetArchive::~AssetArchive() = default;
+
+void AssetArchive::Index_() {
+  if (size_ < kAssetArchiveHeaderSize
+      || ReadU32_(data_) != kAssetArchiveMagic) {
+    throw Exception("Invalid asset archive: '" + path_ + "'");
+  }
+  uint32_t version = ReadU32_(data_ + 4);
+  if (version != kAssetArchiveVersion) {
+    throw Exception("Unsupported asset archive version "
+                    + std::to_string(version) + ": '" + path_ + "'");
+  }
+  uint32_t entry_count = ReadU32_(data_ + 8);
+  entries_.reserve(entry_count);
+  size_t pos = kAssetArchiveHeaderSize;
+  for (uint32_t i = 0; i < entry_count; ++i) {
+    if (pos + kAssetArchiveEntryHeaderSize > size_) {
+      throw Exception("Truncated asset archive index: '" + path_ + "'");
+    }
+    uint64_t offset = ReadU64_(data_ + pos);
+    uint64_t size = ReadU64_(data_ + pos + 8);
+    uint32_t name_length = ReadU32_(data_ + pos + 16);
+    pos += kAssetArchiveEntryHeaderSize;
+    if (pos + name_length > size_ || offset > size_ || size > size_ - offset) {
+      throw Exception("Corrupt asset archive index: '" + path_ + "'");
+    }
+    std::string name(reinterpret_cast<const char*>(data_ + pos), name_length);
+    pos += name_length;
+    entries_[name] = {static_cast<size_t>(offset), static_cast<size_t>(size)};
+  }
+}
+
+auto AssetArchive::Find(const std::string& name, const uint8_t** data,
+                        size_t* size) const -> bool {
+  auto i = entries_.find(name);
+  if (i == entries_.end()) {
+    return false;
+  }
+  *data = data_ + i->second.offset;
+  *size = i->second.size;
+  return true;
+}
+
+AssetFile::AssetFile(const std::string& path) {
+  if (!g_base->assets->FindArchivedFile(path, &data_, &size_)) {
+    data_ = nullptr;
+    file_ = g_core->platform->FOpen(path.c_str(), "rb");
+  }
+}
+
+AssetFile::~AssetFile() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+auto AssetFile::Read(void* buffer, size_t size, size_t count) -> size_t {
+  if (file_) {
+    return fread(buffer, size, count, file_);
+  }
+  if (size == 0) {
+    return 0;
+  }
+  size_t available = (size_ - pos_) / size;
+  size_t items = std::min(count, available);
+  if (items > 0) {
+    memcpy(buffer, data_ + pos_, items * size);
+    pos_ += items * size;
+  }
+  return items;
+}
+
+auto AssetFile::Seek(long offset, int origin) -> int {  // NOLINT
+  if (file_) {
+    return fseek(file_, offset, origin);
+  }
+  long base;  // NOLINT
+  switch (origin) {
+    case SEEK_SET:
+      base = 0;
+      break;
+    case SEEK_CUR:
+      base = static_cast<long>(pos_);  // NOLINT
+      break;
+    case SEEK_END:
+      base = static_cast<long>(size_);  // NOLINT
+      break;
+    default:
+      return -1;
+  }
+  long new_pos = base + offset;  // NOLINT
+  if (new_pos < 0 || static_cast<size_t>(new_pos) > size_) {
+    return -1;
+  }
+  pos_ = static_cast<size_t>(new_pos);
+  return 0;
+}
+
+auto AssetFile::View(size_t size) -> const uint8_t* {
+  if (!data_ || size > size_ - pos_) {
+    return nullptr;
+  }
+  const uint8_t* out = data_ + pos_;
+  pos_ += size;
+  return out;
+}
+
+auto AssetFile::ReadRemaining() -> std::string {
+  if (data_) {
+    std::string out(reinterpret_cast<const char*>(data_ + pos_), size_ - pos_);
+    pos_ = size_;
+    return out;
+  }
+  std::string out;
+  if (file_) {
+    char buffer[4096];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file_)) > 0) {
+      out.append(buffer, count);
+    }
+  }
+  return out;
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,112 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_ASSET_ARCHIVE_H_
+#define BALLISTICA_BASE_ASSETS_ASSET_ARCHIVE_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// A read-only file mapped into memory (or simply read in where we don't
+/// have mmap).
+class MappedFile {
+ public:
+  /// Returns nullptr if the file can't be opened or mapped.
+  static auto Open(const std::string& path) -> std::unique_ptr<MappedFile>;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+  auto data() const -> const uint8_t* { return data_; }
+  auto size() const -> size_t { return size_; }
+
+ private:
+  MappedFile() = default;
+
+  const uint8_t* data_{};
+  size_t size_{};
+  bool mapped_{};
+  std::vector<uint8_t> buffer_;
+};
+
+/// A packed archive of asset files with an index up front, mapped into
+/// memory so that files within it can be read as slices with no further
+/// file-system calls. Archives are built by 'pcommand asset_archive_build'.
+///
+/// Layout (all little-endian): a 16 byte header of magic 'BAPK', version,
+/// entry count and reserved; then per entry a u64 offset, u64 size, u32
+/// name length and the name bytes (relative path using '/'); then file
+/// data at the given offsets.
+class AssetArchive {
+ public:
+  /// Map and index the archive at the provided path. Returns nullptr if
+  /// it doesn't exist; throws if it exists but is invalid.
+  static auto Open(const std::string& path) -> std::unique_ptr<AssetArchive>;
+  ~AssetArchive();
+
+  auto path() const -> const std::string& { return path_; }
+  auto entry_count() const -> size_t { return entries_.size(); }
+
+  /// Look up a file by its path relative to the archive root. On success
+  /// returns true and points data at its contents, which remain valid for
+  /// the life of the archive.
+  auto Find(const std::string& name, const uint8_t** data, size_t* size) const
+      -> bool;
+
+ private:
+  struct Entry_ {
+    size_t offset;
+    size_t size;
+  };
+  AssetArchive() = default;
+  void Index_();
+
+  std::string path_;
+  std::unique_ptr<MappedFile> file_;
+  const uint8_t* data_{};
+  size_t size_{};
+  std::unordered_map<std::string, Entry_> entries_;
+};
+
+/// Reads an asset file given a path from Assets::FindAssetFile, which may
+/// be a loose file or a slice of an AssetArchive. Covers the bits of
+/// stdio our loaders use.
+class AssetFile {
+ public:
+  explicit AssetFile(const std::string& path);
+  ~AssetFile();
+  AssetFile(const AssetFile&) = delete;
+  auto operator=(const AssetFile&) -> AssetFile& = delete;
+
+  auto is_open() const -> bool { return file_ != nullptr || data_ != nullptr; }
+
+  /// Like fread(); returns the number of whole items read.
+  auto Read(void* buffer, size_t size, size_t count) -> size_t;
+
+  /// Like fseek(); returns 0 on success.
+  auto Seek(long offset, int origin) -> int;
+
+  /// For archive slices, return a pointer to the next size bytes and
+  /// advance past them, without copying. Returns nullptr for loose
+  /// files or if not enough data remains; use Read() in that case.
+  auto View(size_t size) -> const uint8_t*;
+
+  /// Read everything from the current position to the end.
+  auto ReadRemaining() -> std::string;
+
+ private:
+  FILE* file_{};
+  const uint8_t* data_{};
+  size_t size_{};
+  size_t pos_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_ASSET_ARCHIVE_H_
@@ -0,0 +1,102 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_ASSET_MAP_H_
+#define BALLISTICA_BASE_ASSETS_ASSET_MAP_H_
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ballistica/shared/foundation/object.h"
+
+namespace ballistica::base {
+
+/// Name to asset map used by Assets.
+///
+/// Only the logic thread adds or removes entries, so lookups from the
+/// logic thread need no locking at all. Entries are split across shards
+/// by name hash, each with its own mutex which writers hold while
+/// modifying it and other threads hold while iterating it. This lets
+/// something like the graphics thread walk all textures without making
+/// logic-thread lookups wait on it.
+template <typename T>
+class AssetMap {
+ public:
+  AssetMap() = default;
+  AssetMap(const AssetMap&) = delete;
+  auto operator=(const AssetMap&) -> AssetMap& = delete;
+
+  /// Look up an asset by name. Logic thread only.
+  auto Find(const std::string& name) const -> T* {
+    const Shard_& shard{ShardFor_(name)};
+    auto i = shard.assets.find(name);
+    return i == shard.assets.end() ? nullptr : i->second.get();
+  }
+
+  /// Add an asset. Logic thread only.
+  void Insert(const std::string& name, const Object::Ref<T>& asset) {
+    Shard_& shard{ShardFor_(name)};
+    std::scoped_lock lock(shard.mutex);
+    auto result = shard.assets.emplace(name, asset);
+    if (result.second) {
+      size_++;
+    } else {
+      result.first->second = asset;
+    }
+  }
+
+  /// Run call(T*) for each asset. Can be called from any thread, but
+  /// call must not add or remove assets.
+  template <typename F>
+  void ForEach(const F& call) const {
+    for (const Shard_& shard : shards_) {
+      std::scoped_lock lock(shard.mutex);
+      for (auto&& i : shard.assets) {
+        call(i.second.get());
+      }
+    }
+  }
+
+  /// Remove each asset for which pred(T*) returns true. Logic thread
+  /// only.
+  template <typename F>
+  void EraseIf(const F& pred) {
+    for (Shard_& shard : shards_) {
+      std::scoped_lock lock(shard.mutex);
+      for (auto i = shard.assets.begin(); i != shard.assets.end();) {
+        if (pred(i->second.get())) {
+          i = shard.assets.erase(i);
+          size_--;
+        } else {
+          ++i;
+        }
+      }
+    }
+  }
+
+  auto size() const -> size_t { return size_; }
+
+ private:
+  static constexpr size_t kShardCount = 16;
+
+  struct Shard_ {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Object::Ref<T> > assets;
+  };
+
+  auto ShardFor_(const std::string& name) -> Shard_& {
+    return shards_[std::hash<std::string>{}(name) % kShardCount];
+  }
+  auto ShardFor_(const std::string& name) const -> const Shard_& {
+    return shards_[std::hash<std::string>{}(name) % kShardCount];
+  }
+
+  Shard_ shards_[kShardCount];
+  std::atomic<size_t> size_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_ASSET_MAP_H_
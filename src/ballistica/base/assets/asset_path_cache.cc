@@ -0,0 +1,150 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/assets/asset_path_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// Bump this if the on-disk layout changes.
+const uint32_t kAssetPathCacheVersion = 1;
+const uint32_t kAssetPathCacheMagic = 0x43504142;  // 'BAPC'
+
+// Anything bigger than this is not something we wrote.
+const size_t kAssetPathCacheMaxSize{16 * 1024 * 1024};
+
+auto AssetPathCache::DiskPath_() -> std::string {
+  return g_core->platform->GetVolatileDataDirectory() + BA_DIRSLASH
+         + "assetpaths";
+}
+
+void AssetPathCache::Load(const std::string& validation_key) {
+  assert(g_base->InLogicThread());
+  validation_key_ = validation_key;
+  paths_.clear();
+  loaded_ = true;
+  dirty_ = false;
+
+  FILE* f = g_core->platform->FOpen(DiskPath_().c_str(), "rb");
+  if (!f) {
+    return;
+  }
+
+  // Pull the whole thing in one read and then parse in place.
+  std::vector<uint8_t> buffer;
+  if (fseek(f, 0, SEEK_END) == 0) {
+    long size = ftell(f);  // NOLINT
+    if (size > 0 && static_cast<size_t>(size) <= kAssetPathCacheMaxSize
+        && fseek(f, 0, SEEK_SET) == 0) {
+      buffer.resize(static_cast<size_t>(size));
+      if (fread(buffer.data(), buffer.size(), 1, f) != 1) {
+        buffer.clear();
+      }
+    }
+  }
+  fclose(f);
+
+  size_t pos{};
+  auto read_u32 = [&buffer, &pos](uint32_t* val) {
+    if (buffer.size() - pos < sizeof(*val)) {
+      return false;
+    }
+    memcpy(val, buffer.data() + pos, sizeof(*val));
+    pos += sizeof(*val);
+    return true;
+  };
+  auto read_string = [&buffer, &pos, &read_u32](std::string* val) {
+    uint32_t size;
+    if (!read_u32(&size) || buffer.size() - pos < size) {
+      return false;
+    }
+    val->assign(reinterpret_cast<const char*>(buffer.data() + pos), size);
+    pos += size;
+    return true;
+  };
+
+  uint32_t header[4]{};
+  std::string stored_key;
+  for (auto&& val : header) {
+    if (!read_u32(&val)) {
+      return;
+    }
+  }
+  if (header[0] != kAssetPathCacheMagic || header[1] != kAssetPathCacheVersion
+      || header[2] != static_cast<uint32_t>(kEngineBuildNumber)
+      || !read_string(&stored_key) || stored_key != validation_key_) {
+    return;
+  }
+  for (uint32_t i = 0; i < header[3]; ++i) {
+    std::string key, path;
+    if (!read_string(&key) || !read_string(&path)) {
+      // Truncated or corrupt; don't trust any of it.
+      paths_.clear();
+      return;
+    }
+    paths_.emplace(std::move(key), std::move(path));
+  }
+}
+
+void AssetPathCache::Store(const std::string& key, const std::string& path) {
+  assert(g_base->InLogicThread());
+  if (!loaded_) {
+    return;
+  }
+  auto result = paths_.emplace(key, path);
+  if (result.second) {
+    dirty_ = true;
+  }
+}
+
+void AssetPathCache::SaveIfDirty() {
+  assert(g_base->InLogicThread());
+  if (!dirty_) {
+    return;
+  }
+  dirty_ = false;
+
+  std::vector<uint8_t> buffer;
+  auto write_u32 = [&buffer](uint32_t val) {
+    auto* bytes = reinterpret_cast<const uint8_t*>(&val);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(val));
+  };
+  auto write_string = [&buffer, &write_u32](const std::string& val) {
+    write_u32(static_cast<uint32_t>(val.size()));
+    buffer.insert(buffer.end(), val.begin(), val.end());
+  };
+  write_u32(kAssetPathCacheMagic);
+  write_u32(kAssetPathCacheVersion);
+  write_u32(static_cast<uint32_t>(kEngineBuildNumber));
+  write_u32(static_cast<uint32_t>(paths_.size()));
+  write_string(validation_key_);
+  for (auto&& entry : paths_) {
+    write_string(entry.first);
+    write_string(entry.second);
+  }
+
+  // Write to a temp file and move it into place so a reader never sees a
+  // partial file.
+  g_core->platform->MakeDir(g_core->platform->GetVolatileDataDirectory(),
+                            true);
+  std::string path = DiskPath_();
+  std::string tmp_path = path + ".tmp";
+  FILE* f = g_core->platform->FOpen(tmp_path.c_str(), "wb");
+  if (!f) {
+    return;
+  }
+  bool ok = fwrite(buffer.data(), buffer.size(), 1, f) == 1;
+  fclose(f);
+  if (!ok || g_core->platform->Rename(tmp_path.c_str(), path.c_str()) != 0) {
+    g_core->platform->Unlink(tmp_path.c_str());
+  }
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,50 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_ASSET_PATH_CACHE_H_
+#define BALLISTICA_BASE_ASSETS_ASSET_PATH_CACHE_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Remembers where asset files were found so later launches can skip
+/// probing the filesystem for each candidate path. Persisted to the
+/// volatile data directory and only trusted by the same engine build
+/// with the same asset paths, so it is meant for installs whose assets
+/// don't change underneath a build (such as servers). Logic thread only.
+class AssetPathCache {
+ public:
+  /// Read any saved entries for the given validation key (which should
+  /// describe everything results depend on besides the build itself).
+  void Load(const std::string& validation_key);
+
+  /// Return the cached path for a key, or nullptr if there is none.
+  auto Find(const std::string& key) const -> const std::string* {
+    auto i = paths_.find(key);
+    return i == paths_.end() ? nullptr : &i->second;
+  }
+
+  void Store(const std::string& key, const std::string& path);
+
+  /// Write our entries to disk if any were added since the last load or
+  /// save.
+  void SaveIfDirty();
+
+  auto loaded() const { return loaded_; }
+  auto size() const { return paths_.size(); }
+
+ private:
+  static auto DiskPath_() -> std::string;
+
+  std::string validation_key_;
+  std::unordered_map<std::string, std::string> paths_;
+  bool loaded_{};
+  bool dirty_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_ASSET_PATH_CACHE_H_
@@ -2,10 +2,12 @@
 
 #include "ballistica/base/assets/assets.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
@@ -19,9 +21,11 @@
 #include "ballistica/base/audio/audio_server.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/base/graphics/support/graphics_client_context.h"
 #include "ballistica/base/graphics/text/text_packer.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/base/python/base_python.h"
+#include "ballistica/base/support/app_config.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/foundation/event_loop.h"
@@ -34,8 +38,9 @@ static const bool kShowPruningInfo = false;
 
 #define SHOW_PRUNING_INFO 0
 
-// Standard prune time for unused assets: 10 minutes (1000ms * 60 * 10).
-#define STANDARD_ASSET_PRUNE_TIME 600000
+// How long an asset must go unused before it can be pruned to bring its
+// type back under budget: 1 minute.
+#define STANDARD_ASSET_PRUNE_TIME 60000
 
 // More aggressive prune time for dynamically-generated text-textures: 10
 // seconds.
@@ -49,6 +54,7 @@ static const bool kShowPruningInfo = false;
 Assets::Assets() {
   asset_paths_.emplace_back(g_core->GetDataDirectory() + BA_DIRSLASH
                             + "ba_data");
+  AddArchive_(asset_paths_.back());
   for (bool& have_pending_load : have_pending_loads_) {
     have_pending_load = false;
   }
@@ -56,6 +62,25 @@ Assets::Assets() {
   InitSpecialChars();
 }
 
+void Assets::DoApplyAppConfig() {
+  assert(g_base->InLogicThread());
+  auto budget_bytes = [](AppConfig::IntID id) {
+    int megabytes = g_base->app_config->Resolve(id);
+    return megabytes > 0 ? static_cast<size_t>(megabytes) * 1024 * 1024
+                         : size_t{0};
+  };
+  memory_budgets_[static_cast<int>(AssetType::kTexture)] =
+      budget_bytes(AppConfig::IntID::kTextureCacheBudgetMB);
+  memory_budgets_[static_cast<int>(AssetType::kMesh)] =
+      budget_bytes(AppConfig::IntID::kMeshCacheBudgetMB);
+  memory_budgets_[static_cast<int>(AssetType::kCollisionMesh)] =
+      budget_bytes(AppConfig::IntID::kCollisionMeshCacheBudgetMB);
+  generated_textures_.set_budget(
+      budget_bytes(AppConfig::IntID::kGeneratedTextureCacheBudgetMB));
+  generated_textures_.set_disk_cache_enabled(
+      g_base->app_config->Resolve(AppConfig::BoolID::kTextTextureDiskCache));
+}
+
 void Assets::LoadSystemTexture(SysTextureID id, const char* name) {
   assert(asset_lists_locked_);
   system_textures_.push_back(GetTexture(name));
@@ -151,13 +176,10 @@ void Assets::StartLoading() {
   LoadSystemTexture(SysTextureID::kTouchArrowsActions, "touchArrowsActions");
   LoadSystemTexture(SysTextureID::kRGBStripes, "rgbStripes");
   LoadSystemTexture(SysTextureID::kUIAtlas2, "uiAtlas2");
-  LoadSystemTexture(SysTextureID::kFontSmall1, "fontSmall1");
-  LoadSystemTexture(SysTextureID::kFontSmall2, "fontSmall2");
-  LoadSystemTexture(SysTextureID::kFontSmall3, "fontSmall3");
-  LoadSystemTexture(SysTextureID::kFontSmall4, "fontSmall4");
-  LoadSystemTexture(SysTextureID::kFontSmall5, "fontSmall5");
-  LoadSystemTexture(SysTextureID::kFontSmall6, "fontSmall6");
-  LoadSystemTexture(SysTextureID::kFontSmall7, "fontSmall7");
+
+  // Note: fontSmall1 through fontSmall7 (mostly non-latin glyphs) are not
+  // system textures; TextGroup loads them when some text actually needs
+  // them and they get pruned like anything else once nothing does.
   LoadSystemTexture(SysTextureID::kFontExtras, "fontExtras");
   LoadSystemTexture(SysTextureID::kFontExtras2, "fontExtras2");
   LoadSystemTexture(SysTextureID::kFontExtras3, "fontExtras3");
@@ -303,6 +325,7 @@ void Assets::StartLoading() {
   LoadSystemMesh(SysMeshID::kWing, "wing");
 
   sys_assets_loaded_ = true;
+  asset_path_cache_.SaveIfDirty();
 }
 
 void Assets::PrintLoadInfo() {
@@ -310,8 +333,6 @@ void Assets::PrintLoadInfo() {
   char buffer[256];
   int num = 1;
 
-  // Need to lock lists while iterating over them.
-  AssetListLock lock;
   s = "Assets load results:  (all times in milliseconds):\n";
   snprintf(buffer, sizeof(buffer), "    %-50s %10s %10s", "FILE",
            "PRELOAD_TIME", "LOAD_TIME");
@@ -319,140 +340,111 @@ void Assets::PrintLoadInfo() {
   g_core->Log(LogName::kBaAssets, LogLevel::kInfo, s);
   millisecs_t total_preload_time = 0;
   millisecs_t total_load_time = 0;
-  assert(asset_lists_locked_);
-  for (auto&& i : meshes_) {
-    millisecs_t preload_time = i.second->preload_time();
-    millisecs_t load_time = i.second->load_time();
-    total_preload_time += preload_time;
-    total_load_time += load_time;
-    snprintf(buffer, sizeof(buffer), "%-3d %-50s %10d %10d", num,
-             i.second->GetName().c_str(),
-             static_cast_check_fit<int>(preload_time),
-             static_cast_check_fit<int>(load_time));
-    g_core->Log(LogName::kBaAssets, LogLevel::kInfo, buffer);
-    num++;
-  }
-  assert(asset_lists_locked_);
-  for (auto&& i : collision_meshes_) {
-    millisecs_t preload_time = i.second->preload_time();
-    millisecs_t load_time = i.second->load_time();
-    total_preload_time += preload_time;
-    total_load_time += load_time;
-    snprintf(buffer, sizeof(buffer), "%-3d %-50s %10d %10d", num,
-             i.second->GetName().c_str(),
-             static_cast_check_fit<int>(preload_time),
-             static_cast_check_fit<int>(load_time));
-    g_core->Log(LogName::kBaAssets, LogLevel::kInfo, buffer);
-    num++;
-  }
-  assert(asset_lists_locked_);
-  for (auto&& i : sounds_) {
-    millisecs_t preload_time = i.second->preload_time();
-    millisecs_t load_time = i.second->load_time();
-    total_preload_time += preload_time;
-    total_load_time += load_time;
-    snprintf(buffer, sizeof(buffer), "%-3d %-50s %10d %10d", num,
-             i.second->GetName().c_str(),
-             static_cast_check_fit<int>(preload_time),
-             static_cast_check_fit<int>(load_time));
-    g_core->Log(LogName::kBaAssets, LogLevel::kInfo, buffer);
-    num++;
-  }
-  assert(asset_lists_locked_);
-  for (auto&& i : datas_) {
-    millisecs_t preload_time = i.second->preload_time();
-    millisecs_t load_time = i.second->load_time();
+  auto print_asset = [&](Asset* asset, const std::string& name) {
+    millisecs_t preload_time = asset->preload_time();
+    millisecs_t load_time = asset->load_time();
     total_preload_time += preload_time;
     total_load_time += load_time;
     snprintf(buffer, sizeof(buffer), "%-3d %-50s %10d %10d", num,
-             i.second->GetName().c_str(),
-             static_cast_check_fit<int>(preload_time),
+             name.c_str(), static_cast_check_fit<int>(preload_time),
              static_cast_check_fit<int>(load_time));
     g_core->Log(LogName::kBaAssets, LogLevel::kInfo, buffer);
     num++;
-  }
-  assert(asset_lists_locked_);
-  for (auto&& i : textures_) {
-    millisecs_t preload_time = i.second->preload_time();
-    millisecs_t load_time = i.second->load_time();
-    total_preload_time += preload_time;
-    total_load_time += load_time;
-    snprintf(buffer, sizeof(buffer), "%-3d %-50s %10d %10d", num,
-             i.second->file_name_full().c_str(),
-             static_cast_check_fit<int>(preload_time),
-             static_cast_check_fit<int>(load_time));
-    g_core->Log(LogName::kBaAssets, LogLevel::kInfo, buffer);
-    num++;
-  }
+  };
+  meshes_.ForEach([&](MeshAsset* a) { print_asset(a, a->GetName()); });
+  collision_meshes_.ForEach(
+      [&](CollisionMeshAsset* a) { print_asset(a, a->GetName()); });
+  sounds_.ForEach([&](SoundAsset* a) { print_asset(a, a->GetName()); });
+  datas_.ForEach([&](DataAsset* a) { print_asset(a, a->GetName()); });
+  textures_.ForEach(
+      [&](TextureAsset* a) { print_asset(a, a->file_name_full()); });
   snprintf(buffer, sizeof(buffer),
            "Total preload time (loading data from disk): %i\nTotal load time "
            "(feeding data to OpenGL, etc): %i",
            static_cast<int>(total_preload_time),
            static_cast<int>(total_load_time));
   g_core->Log(LogName::kBaAssets, LogLevel::kInfo, buffer);
+
+  // Memory use against the budgets Prune() works towards.
+  for (auto&& usage : GetMemoryUsage()) {
+    size_t budget = memory_budgets_[static_cast<int>(usage.type)];
+    std::string budget_str =
+        budget == 0 ? std::string("none")
+                    : std::to_string(budget / (1024 * 1024)) + " MB";
+    std::string label = std::string(usage.name) + ":";
+    snprintf(buffer, sizeof(buffer), "%-16s %5d assets %8.2f MB (budget %s)",
+             label.c_str(), static_cast<int>(usage.count),
+             static_cast<double>(usage.bytes) / (1024.0 * 1024.0),
+             budget_str.c_str());
+    g_core->Log(LogName::kBaAssets, LogLevel::kInfo, buffer);
+  }
+}
+
+auto Assets::GetMemoryUsage() -> std::vector<MemoryUsage> {
+  std::vector<MemoryUsage> usages;
+  size_t texture_cost{};
+  auto add_texture_cost = [&texture_cost](TextureAsset* a) {
+    texture_cost += a->GetMemoryCost();
+  };
+  textures_.ForEach(add_texture_cost);
+  text_textures_.ForEach(add_texture_cost);
+  qr_textures_.ForEach(add_texture_cost);
+  usages.push_back({"Textures", AssetType::kTexture,
+                    static_cast<size_t>(total_texture_count()), texture_cost});
+  size_t mesh_cost{};
+  meshes_.ForEach(
+      [&mesh_cost](MeshAsset* a) { mesh_cost += a->GetMemoryCost(); });
+  usages.push_back({"Meshes", AssetType::kMesh, meshes_.size(), mesh_cost});
+  size_t collision_mesh_cost{};
+  collision_meshes_.ForEach([&collision_mesh_cost](CollisionMeshAsset* a) {
+    collision_mesh_cost += a->GetMemoryCost();
+  });
+  usages.push_back({"CollisionMeshes", AssetType::kCollisionMesh,
+                    collision_meshes_.size(), collision_mesh_cost});
+  size_t sound_cost{};
+  sounds_.ForEach(
+      [&sound_cost](SoundAsset* a) { sound_cost += a->GetMemoryCost(); });
+  usages.push_back({"Sounds", AssetType::kSound, sounds_.size(), sound_cost});
+  size_t data_cost{};
+  datas_.ForEach(
+      [&data_cost](DataAsset* a) { data_cost += a->GetMemoryCost(); });
+  usages.push_back({"Datas", AssetType::kData, datas_.size(), data_cost});
+  return usages;
 }
 
 void Assets::MarkAllAssetsForLoad() {
   assert(g_base->InLogicThread());
 
-  // Need to keep lists locked while iterating over them.
-  AssetListLock m_lock;
-  for (auto&& i : textures_) {
-    if (!i.second->preloaded()) {
-      Asset::LockGuard lock(i.second.get());
-      have_pending_loads_[static_cast<int>(AssetType::kTexture)] = true;
-      MarkAssetForLoad(i.second.get());
-    }
-  }
-  for (auto&& i : text_textures_) {
-    if (!i.second->preloaded()) {
-      Asset::LockGuard lock(i.second.get());
-      have_pending_loads_[static_cast<int>(AssetType::kTexture)] = true;
-      MarkAssetForLoad(i.second.get());
+  auto mark = [this](Asset* asset) {
+    if (!asset->preloaded()) {
+      Asset::LockGuard lock(asset);
+      have_pending_loads_[static_cast<int>(asset->GetAssetType())] = true;
+      MarkAssetForLoad(asset);
     }
-  }
-  for (auto&& i : qr_textures_) {
-    if (!i.second->preloaded()) {
-      Asset::LockGuard lock(i.second.get());
-      have_pending_loads_[static_cast<int>(AssetType::kTexture)] = true;
-      MarkAssetForLoad(i.second.get());
-    }
-  }
-  for (auto&& i : meshes_) {
-    if (!i.second->preloaded()) {
-      Asset::LockGuard lock(i.second.get());
-      have_pending_loads_[static_cast<int>(AssetType::kMesh)] = true;
-      MarkAssetForLoad(i.second.get());
-    }
-  }
+  };
+  textures_.ForEach(mark);
+  text_textures_.ForEach(mark);
+  qr_textures_.ForEach(mark);
+  meshes_.ForEach(mark);
 }
 
 // Call this from the graphics thread to immediately unload all
 // assets used by it. (for when GL context gets lost, etc).
 void Assets::UnloadRendererBits(bool do_textures, bool do_meshes) {
   assert(g_base->app_adapter->InGraphicsContext());
-  // need to keep lists locked while iterating over them..
-  AssetListLock m_lock;
+  // Note that the lists lock themselves while we iterate, so this never
+  // holds up lookups in the logic thread.
+  auto unload = [](Asset* asset) {
+    Asset::LockGuard lock(asset);
+    asset->Unload(true);
+  };
   if (do_textures) {
-    assert(asset_lists_locked_);
-    for (auto&& i : textures_) {
-      Asset::LockGuard lock(i.second.get());
-      i.second->Unload(true);
-    }
-    for (auto&& i : text_textures_) {
-      Asset::LockGuard lock(i.second.get());
-      i.second->Unload(true);
-    }
-    for (auto&& i : qr_textures_) {
-      Asset::LockGuard lock(i.second.get());
-      i.second->Unload(true);
-    }
+    textures_.ForEach(unload);
+    text_textures_.ForEach(unload);
+    qr_textures_.ForEach(unload);
   }
   if (do_meshes) {
-    for (auto&& i : meshes_) {
-      Asset::LockGuard lock(i.second.get());
-      i.second->Unload(true);
-    }
+    meshes_.ForEach(unload);
   }
 }
 
@@ -475,18 +467,15 @@ auto Assets::GetCollisionMesh(const std::string& file_name)
 }
 
 template <typename T>
-auto Assets::GetAsset(const std::string& file_name,
-                      std::unordered_map<std::string, Object::Ref<T> >* c_list)
+auto Assets::GetAsset(const std::string& file_name, AssetMap<T>* c_list)
     -> Object::Ref<T> {
   assert(g_base->InLogicThread());
-  assert(asset_lists_locked_);
   assert(asset_loads_allowed_);
-  auto i = c_list->find(file_name);
-  if (i != c_list->end()) {
-    return Object::Ref<T>(i->second.get());
+  if (T* existing = c_list->Find(file_name)) {
+    return Object::Ref<T>(existing);
   } else {
     auto d(Object::New<T>(file_name));
-    (*c_list)[file_name] = d;
+    c_list->Insert(file_name, d);
     {
       Asset::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetAssetType())] = true;
@@ -499,14 +488,12 @@ auto Assets::GetAsset(const std::string& file_name,
 
 auto Assets::GetTexture(TextPacker* packer) -> Object::Ref<TextureAsset> {
   assert(g_base->InLogicThread());
-  assert(asset_lists_locked_);
   const std::string& hash(packer->hash());
-  auto i = text_textures_.find(hash);
-  if (i != text_textures_.end()) {
-    return Object::Ref<TextureAsset>(i->second.get());
+  if (TextureAsset* existing = text_textures_.Find(hash)) {
+    return Object::Ref<TextureAsset>(existing);
   } else {
     auto d{Object::New<TextureAsset>(packer)};
-    text_textures_[hash] = d;
+    text_textures_.Insert(hash, d);
     {
       Asset::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetAssetType())] = true;
@@ -520,13 +507,11 @@ auto Assets::GetTexture(TextPacker* packer) -> Object::Ref<TextureAsset> {
 auto Assets::GetQRCodeTexture(const std::string& url)
     -> Object::Ref<TextureAsset> {
   assert(g_base->InLogicThread());
-  assert(asset_lists_locked_);
-  auto i = qr_textures_.find(url);
-  if (i != qr_textures_.end()) {
-    return Object::Ref<TextureAsset>(i->second.get());
+  if (TextureAsset* existing = qr_textures_.Find(url)) {
+    return Object::Ref<TextureAsset>(existing);
   } else {
     auto d(Object::New<TextureAsset>(url));
-    qr_textures_[url] = d;
+    qr_textures_.Insert(url, d);
     {
       Asset::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetAssetType())] = true;
@@ -542,14 +527,12 @@ auto Assets::GetQRCodeTexture(const std::string& url)
 auto Assets::GetCubeMapTexture(const std::string& file_name)
     -> Object::Ref<TextureAsset> {
   assert(g_base->InLogicThread());
-  assert(asset_lists_locked_);
-  auto i = textures_.find(file_name);
-  if (i != textures_.end()) {
-    return Object::Ref<TextureAsset>(i->second.get());
+  if (TextureAsset* existing = textures_.Find(file_name)) {
+    return Object::Ref<TextureAsset>(existing);
   } else {
     auto d(Object::New<TextureAsset>(file_name, TextureType::kCubeMap,
                                      TextureMinQuality::kLow));
-    textures_[file_name] = d;
+    textures_.Insert(file_name, d);
     {
       Asset::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetAssetType())] = true;
@@ -565,10 +548,8 @@ auto Assets::GetCubeMapTexture(const std::string& file_name)
 auto Assets::GetTexture(const std::string& file_name)
     -> Object::Ref<TextureAsset> {
   assert(g_base->InLogicThread());
-  assert(asset_lists_locked_);
-  auto i = textures_.find(file_name);
-  if (i != textures_.end()) {
-    return Object::Ref<TextureAsset>(i->second.get());
+  if (TextureAsset* existing = textures_.Find(file_name)) {
+    return Object::Ref<TextureAsset>(existing);
   } else {
     static std::set<std::string>* quality_map_medium = nullptr;
     static std::set<std::string>* quality_map_high = nullptr;
@@ -605,7 +586,7 @@ auto Assets::GetTexture(const std::string& file_name)
     }
 
     auto d(Object::New<TextureAsset>(file_name, TextureType::k2D, min_quality));
-    textures_[file_name] = d;
+    textures_.Insert(file_name, d);
     {
       Asset::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetAssetType())] = true;
@@ -627,8 +608,11 @@ void Assets::MarkAssetForLoad(Asset* c) {
   // once it makes it back to us we can delete the ref (in
   // ClearPendingLoadsDoneList)
 
+  // Anything requested before system assets are all in is a system
+  // asset; those get preloaded first.
   auto asset_ref_ptr = new Object::Ref<Asset>(c);
-  g_base->assets_server->PushPendingPreload(asset_ref_ptr);
+  g_base->assets_server->PushPendingPreload(
+      asset_ref_ptr, !g_base->assets->sys_assets_loaded());
 }
 
 #pragma clang diagnostic push
@@ -639,7 +623,6 @@ auto Assets::GetMeshPendingLoadCount() -> int {
   if (!have_pending_loads_[static_cast<int>(AssetType::kMesh)]) {
     return 0;
   }
-  AssetListLock lock;
   int total = GetAssetPendingLoadCount(&meshes_, AssetType::kMesh);
   if (total == 0) {
     // When fully loaded, stop counting.
@@ -652,7 +635,6 @@ auto Assets::GetTexturePendingLoadCount() -> int {
   if (!have_pending_loads_[static_cast<int>(AssetType::kTexture)]) {
     return 0;
   }
-  AssetListLock lock;
   int total = (GetAssetPendingLoadCount(&textures_, AssetType::kTexture)
                + GetAssetPendingLoadCount(&text_textures_, AssetType::kTexture)
                + GetAssetPendingLoadCount(&qr_textures_, AssetType::kTexture));
@@ -667,7 +649,6 @@ auto Assets::GetSoundPendingLoadCount() -> int {
   if (!have_pending_loads_[static_cast<int>(AssetType::kSound)]) {
     return 0;
   }
-  AssetListLock lock;
   int total = GetAssetPendingLoadCount(&sounds_, AssetType::kSound);
   if (total == 0) {
     // When fully loaded, stop counting.
@@ -680,7 +661,6 @@ auto Assets::GetDataPendingLoadCount() -> int {
   if (!have_pending_loads_[static_cast<int>(AssetType::kData)]) {
     return 0;
   }
-  AssetListLock lock;
   int total = GetAssetPendingLoadCount(&datas_, AssetType::kData);
   if (total == 0) {
     // When fully loaded, stop counting.
@@ -693,7 +673,6 @@ auto Assets::GetCollisionMeshPendingLoadCount() -> int {
   if (!have_pending_loads_[static_cast<int>(AssetType::kCollisionMesh)]) {
     return 0;
   }
-  AssetListLock lock;
   int total =
       GetAssetPendingLoadCount(&collision_meshes_, AssetType::kCollisionMesh);
   if (total == 0) {
@@ -718,26 +697,21 @@ auto Assets::GetPendingLoadCount() -> int {
 }
 
 template <typename T>
-auto Assets::GetAssetPendingLoadCount(
-    std::unordered_map<std::string, Object::Ref<T> >* t_list, AssetType type)
+auto Assets::GetAssetPendingLoadCount(AssetMap<T>* t_list, AssetType type)
     -> int {
   assert(g_base->InLogicThread());
-  assert(asset_lists_locked_);
 
   int c = 0;
-  for (auto&& i : (*t_list)) {
-    if (i.second.exists()) {
-      if (i.second->TryLock()) {
-        Asset::LockGuard lock(i.second.get(),
-                              Asset::LockGuard::Type::kInheritLock);
-        if (!i.second->loaded()) {
-          c++;
-        }
-      } else {
+  t_list->ForEach([&c](T* asset) {
+    if (asset->TryLock()) {
+      Asset::LockGuard lock(asset, Asset::LockGuard::Type::kInheritLock);
+      if (!asset->loaded()) {
         c++;
       }
+    } else {
+      c++;
     }
-  }
+  });
   return c;
 }
 
@@ -748,9 +722,131 @@ auto Assets::RunPendingAudioLoads() -> bool {
 }
 
 // Runs the pending loads that need to run from the graphics thread.
-auto Assets::RunPendingGraphicsLoads() -> bool {
+auto Assets::RunPendingGraphicsLoads(size_t* byte_budget) -> bool {
   assert(g_base->app_adapter->InGraphicsContext());
-  return RunPendingLoadList(&pending_loads_graphics_);
+  bool loads_remain = RunPendingLoadList(&pending_loads_graphics_, byte_budget);
+  bool streams_remain = RunPendingTextureStreams_(byte_budget);
+  return loads_remain || streams_remain;
+}
+
+auto Assets::RunPendingTextureStreams_(size_t* byte_budget) -> bool {
+  std::vector<Object::Ref<Asset>*> streams;
+  {
+    std::scoped_lock lock(pending_load_list_mutex_);
+    if (pending_texture_streams_.empty()) {
+      return false;
+    }
+    streams.swap(pending_texture_streams_);
+  }
+
+  // Streams share the regular load budget but always come after actual
+  // loads; a blurry texture beats a missing one.
+  std::vector<Object::Ref<Asset>*> finished;
+  std::vector<Object::Ref<Asset>*> unfinished;
+  for (auto* stream : streams) {
+    if (byte_budget && *byte_budget == 0) {
+      unfinished.push_back(stream);
+      continue;
+    }
+    auto* texture = static_cast<TextureAsset*>(stream->get());
+    if (byte_budget) {
+      *byte_budget -= std::min(texture->GetPendingStreamSize(), *byte_budget);
+    }
+    texture->LoadStream();
+    finished.push_back(stream);
+  }
+  {
+    std::scoped_lock lock(pending_load_list_mutex_);
+    for (auto* stream : unfinished) {
+      pending_texture_streams_.push_back(stream);
+    }
+    for (auto* stream : finished) {
+      pending_loads_done_.push_back(stream);
+    }
+  }
+  if (!finished.empty()) {
+    g_base->logic->event_loop()->PushCall(
+        [] { g_base->assets->ClearPendingLoadsDoneList(); });
+  }
+  return !unfinished.empty();
+}
+
+void Assets::UpdateTextureStreaming(int64_t frame_number,
+                                    size_t budget_bytes) {
+  assert(g_base->InLogicThread());
+
+  // Textures drawn within this many frames count as in use and get their
+  // full detail; ones not drawn for this many are fair game for eviction.
+  const int64_t kInUseFrames = 30;
+  const int64_t kEvictFrames = 600;
+
+  // Limit how much streaming we have going at once so it can't crowd out
+  // regular loads.
+  const int kMaxStreamsInFlight = 4;
+
+  size_t resident_bytes{};
+  int in_flight{};
+  std::vector<TextureAsset*> wanted;
+  std::vector<TextureAsset*> evictable;
+  textures_.ForEach([&](TextureAsset* texture) {
+    if (!texture->loaded()) {
+      return;
+    }
+    resident_bytes += texture->resident_bytes();
+    if (!texture->streamable()) {
+      return;
+    }
+    if (texture->streaming()) {
+      in_flight++;
+      return;
+    }
+    int64_t age = frame_number - texture->last_frame_def_num();
+    if (age <= kInUseFrames) {
+      if (texture->resident_level() > texture->full_level()) {
+        wanted.push_back(texture);
+      }
+    } else if (age > kEvictFrames
+               && texture->resident_level()
+                      < texture->full_level()
+                            + TextureAsset::kStreamSkipLevels) {
+      evictable.push_back(texture);
+    }
+  });
+
+  // Most recently drawn stuff streams in first.
+  std::sort(wanted.begin(), wanted.end(),
+            [](TextureAsset* a, TextureAsset* b) {
+              return a->last_frame_def_num() > b->last_frame_def_num();
+            });
+  for (auto* texture : wanted) {
+    if (in_flight >= kMaxStreamsInFlight) {
+      break;
+    }
+    texture->RequestResidentLevel(texture->full_level());
+    in_flight++;
+  }
+
+  if (budget_bytes == 0 || resident_bytes <= budget_bytes) {
+    return;
+  }
+
+  // Over budget; drop top levels from whatever has gone unused longest.
+  std::sort(evictable.begin(), evictable.end(),
+            [](TextureAsset* a, TextureAsset* b) {
+              return a->last_frame_def_num() < b->last_frame_def_num();
+            });
+  for (auto* texture : evictable) {
+    if (in_flight >= kMaxStreamsInFlight || resident_bytes <= budget_bytes) {
+      break;
+    }
+    // Each level dropped leaves about a quarter of what was there.
+    size_t bytes = texture->resident_bytes();
+    int level = texture->full_level() + TextureAsset::kStreamSkipLevels;
+    size_t kept_bytes = bytes >> (2 * (level - texture->resident_level()));
+    resident_bytes -= bytes - kept_bytes;
+    texture->RequestResidentLevel(level);
+    in_flight++;
+  }
 }
 
 // Runs the pending loads that run in the main thread.  Also clears the list of
@@ -761,7 +857,8 @@ auto Assets::RunPendingLoadsLogicThread() -> bool {
 }
 
 template <typename T>
-auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
+auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list,
+                                size_t* byte_budget) -> bool {
   bool flush = false;
   millisecs_t starttime = g_core->AppTimeMillisecs();
 
@@ -783,6 +880,11 @@ auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
       return false;
     }
 
+    // If we've already used up our budget.
+    if (byte_budget && *byte_budget == 0) {
+      return true;
+    }
+
     // Pull the contents of c_list and set it to empty.
     l.swap(*c_list);
   }
@@ -797,12 +899,18 @@ auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
     while (true) {
       for (auto i = l.begin(); i != l.end(); i++) {
         if (!out_of_time) {
+          if (byte_budget) {
+            size_t size = (***i).GetPendingLoadSize();
+            *byte_budget -= std::min(size, *byte_budget);
+          }
           (***i).Load(false);
 
           // If the load finished, pop it on our "done-loading" list.. otherwise
           // keep it around.
           l_finished.push_back(*i);  // else l_unfinished.push_back(*i);
-          if (g_core->AppTimeMillisecs() - starttime > PENDING_LOAD_PROCESS_TIME
+          if ((g_core->AppTimeMillisecs() - starttime
+                   > PENDING_LOAD_PROCESS_TIME
+               || (byte_budget && *byte_budget == 0))
               && !flush) {
             out_of_time = true;
           }
@@ -841,205 +949,175 @@ auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
   return (!l.empty());
 }
 
+template <typename T>
+void Assets::CollectPruneCandidates_(AssetMap<T>* assets,
+                                     millisecs_t min_idle_time,
+                                     std::vector<PruneCandidate_>* candidates,
+                                     size_t* total_cost) {
+  millisecs_t current_time = g_core->AppTimeMillisecs();
+  assets->ForEach([&](T* asset) {
+    size_t cost = asset->GetMemoryCost();
+    *total_cost += cost;
+
+    // Anything referenced outside of our list is in use, and anything not
+    // yet preloaded isn't holding anything worth freeing.
+    if (asset->object_strong_ref_count() <= 1 && asset->preloaded()
+        && current_time - asset->last_used_time() > min_idle_time) {
+      candidates->push_back({asset, asset->last_used_time(), cost});
+    }
+  });
+}
+
+void Assets::SelectPruneVictims_(std::vector<PruneCandidate_>* candidates,
+                                 size_t total_cost, size_t budget,
+                                 std::unordered_set<Asset*>* victims) {
+  if (total_cost <= budget) {
+    return;
+  }
+
+  // Least recently used goes first.
+  std::sort(candidates->begin(), candidates->end(),
+            [](const PruneCandidate_& a, const PruneCandidate_& b) {
+              return a.last_used_time < b.last_used_time;
+            });
+  for (auto&& candidate : *candidates) {
+    if (total_cost <= budget) {
+      break;
+    }
+    victims->insert(candidate.asset);
+    total_cost -= std::min(total_cost, candidate.cost);
+  }
+}
+
 void Assets::Prune(int level) {
   assert(g_base->InLogicThread());
-  millisecs_t current_time = g_core->AppTimeMillisecs();
 
-  // Need lists locked while accessing/modifying them.
-  AssetListLock lock;
+  // We get called periodically; a fine time to persist any newly found
+  // asset paths.
+  asset_path_cache_.SaveIfDirty();
 
-  // We can specify level for more aggressive pruning (during memory warnings
-  // and whatnot).
+  // Assets are only evicted while their type is over its memory budget,
+  // least recently used first. We can specify level for more aggressive
+  // pruning (during memory warnings and whatnot); this shrinks budgets and
+  // how long things need to sit unused before we drop them.
   millisecs_t standard_asset_prune_time = STANDARD_ASSET_PRUNE_TIME;
   millisecs_t text_texture_prune_time = TEXT_TEXTURE_PRUNE_TIME;
   millisecs_t qr_texture_prune_time = QR_TEXTURE_PRUNE_TIME;
+  int budget_shift{};
   switch (level) {
     case 1:
-      standard_asset_prune_time = 120000;  // 2 min
-      text_texture_prune_time = 1000;      // 1 sec
-      qr_texture_prune_time = 1000;        // 1 sec
-      break;
-    case 2:
-      standard_asset_prune_time = 30000;  // 30 sec
+      standard_asset_prune_time = 10000;  // 10 sec
       text_texture_prune_time = 1000;     // 1 sec
       qr_texture_prune_time = 1000;       // 1 sec
+      budget_shift = 1;
       break;
-    case 3:
+    case 2:
       standard_asset_prune_time = 5000;  // 5 sec
       text_texture_prune_time = 1000;    // 1 sec
       qr_texture_prune_time = 1000;      // 1 sec
+      budget_shift = 2;
+      break;
+    case 3:
+      standard_asset_prune_time = 1000;  // 1 sec
+      text_texture_prune_time = 1000;    // 1 sec
+      qr_texture_prune_time = 1000;      // 1 sec
+      budget_shift = -1;
       break;
     default:
       break;
   }
+  auto budget = [this, budget_shift](AssetType type) -> size_t {
+    size_t val = memory_budgets_[static_cast<int>(type)];
+    if (val == 0) {
+      // No limit.
+      return budget_shift < 0 ? 0 : SIZE_MAX;
+    }
+    return budget_shift < 0 ? 0 : val >> budget_shift;
+  };
 
   std::vector<Object::Ref<Asset>*> graphics_thread_unloads;
-  std::vector<Object::Ref<Asset>*> audio_thread_unloads;
 
-  assert(asset_lists_locked_);
   auto old_texture_count = textures_.size();
   auto old_text_texture_count = text_textures_.size();
   auto old_qr_texture_count = qr_textures_.size();
   auto old_mesh_count = meshes_.size();
   auto old_collision_mesh_count = collision_meshes_.size();
-  auto old_sound_count = sounds_.size();
 
-  // Prune textures.
-  assert(asset_lists_locked_);
-  for (auto i = textures_.begin(); i != textures_.end();) {
-    TextureAsset* texture = i->second.get();
-    // Attempt to prune if there are no references remaining except our own and
-    // its been a while since it was used.
-    if (current_time - texture->last_used_time() > standard_asset_prune_time
-        && (texture->object_strong_ref_count() <= 1)) {
-      // If its preloaded/loaded we need to ask the graphics thread to unload it
-      // first.
-      if (texture->preloaded()) {
-        // Allocate a reference to keep this texture_data alive while the unload
-        // is happening.
-        graphics_thread_unloads.push_back(new Object::Ref<Asset>(texture));
-        auto i_next = i;
-        i_next++;
-        textures_.erase(i);
-        i = i_next;
-      }
-    } else {
-      i++;
-    }
-  }
-
-  // Prune text-textures more aggressively since we may generate lots of them
-  // FIXME - we may want to prune based on total number of these instead of
-  //  time.
-  assert(asset_lists_locked_);
-  for (auto i = text_textures_.begin(); i != text_textures_.end();) {
-    TextureAsset* texture = i->second.get();
-    // Attempt to prune if there are no references remaining except our own and
-    // its been a while since it was used.
-    if (current_time - texture->last_used_time() > text_texture_prune_time
-        && (texture->object_strong_ref_count() <= 1)) {
-      // If its preloaded/loaded we need to ask the graphics thread to unload it
-      // first.
-      if (texture->preloaded()) {
-        // Allocate a reference to keep this texture_data alive while the unload
-        // is happening.
-        graphics_thread_unloads.push_back(new Object::Ref<Asset>(texture));
-        auto i_next = i;
-        i_next++;
-        text_textures_.erase(i);
-        i = i_next;
-      }
-    } else {
-      i++;
-    }
-  }
+  std::vector<PruneCandidate_> candidates;
+  std::unordered_set<Asset*> victims;
+  size_t total_cost;
 
-  // Prune qr-textures.
-  assert(asset_lists_locked_);
-  for (auto i = qr_textures_.begin(); i != qr_textures_.end();) {
-    TextureAsset* texture = i->second.get();
-    // Attempt to prune if there are no references remaining except our own and
-    // its been a while since it was used.
-    if (current_time - texture->last_used_time() > qr_texture_prune_time
-        && (texture->object_strong_ref_count() <= 1)) {
-      // If its preloaded/loaded we need to ask the graphics thread to unload it
-      // first.
-      if (texture->preloaded()) {
-        // Allocate a reference to keep this texture_data alive while the unload
-        // is happening.
-        graphics_thread_unloads.push_back(new Object::Ref<Asset>(texture));
-        auto i_next = i;
-        i_next++;
-        qr_textures_.erase(i);
-        i = i_next;
-      }
-    } else {
-      i++;
+  // Graphics assets need to be unloaded by the graphics thread, so we
+  // allocate a reference to keep each alive while that happens.
+  auto erase_with_unload = [&victims, &graphics_thread_unloads](Asset* asset) {
+    if (victims.find(asset) == victims.end()) {
+      return false;
     }
+    graphics_thread_unloads.push_back(new Object::Ref<Asset>(asset));
+    return true;
+  };
+
+  // Prune textures. Text and qr textures share the texture budget but can
+  // go after less idle time since they're cheap to regenerate.
+  candidates.clear();
+  victims.clear();
+  total_cost = 0;
+  CollectPruneCandidates_(&textures_, standard_asset_prune_time, &candidates,
+                          &total_cost);
+  CollectPruneCandidates_(&text_textures_, text_texture_prune_time,
+                          &candidates, &total_cost);
+  CollectPruneCandidates_(&qr_textures_, qr_texture_prune_time, &candidates,
+                          &total_cost);
+  SelectPruneVictims_(&candidates, total_cost, budget(AssetType::kTexture),
+                      &victims);
+  if (!victims.empty()) {
+    textures_.EraseIf(erase_with_unload);
+    text_textures_.EraseIf(erase_with_unload);
+    qr_textures_.EraseIf(erase_with_unload);
   }
 
   // Prune meshes.
-  assert(asset_lists_locked_);
-  for (auto i = meshes_.begin(); i != meshes_.end();) {
-    MeshAsset* mesh = i->second.get();
-    // Attempt to prune if there are no references remaining except our own and
-    // its been a while since it was used.
-    if (current_time - mesh->last_used_time() > standard_asset_prune_time
-        && (mesh->object_strong_ref_count() <= 1)) {
-      // If its preloaded/loaded we need to ask the graphics thread to unload it
-      // first.
-      if (mesh->preloaded()) {
-        // Allocate a reference to keep this mesh_data alive while the unload
-        // is happening.
-        graphics_thread_unloads.push_back(new Object::Ref<Asset>(mesh));
-        auto i_next = i;
-        i_next++;
-        meshes_.erase(i);
-        i = i_next;
-      }
-    } else {
-      i++;
-    }
+  candidates.clear();
+  victims.clear();
+  total_cost = 0;
+  CollectPruneCandidates_(&meshes_, standard_asset_prune_time, &candidates,
+                          &total_cost);
+  SelectPruneVictims_(&candidates, total_cost, budget(AssetType::kMesh),
+                      &victims);
+  if (!victims.empty()) {
+    meshes_.EraseIf(erase_with_unload);
   }
 
   // Prune collision-meshes.
-  assert(asset_lists_locked_);
-  for (auto i = collision_meshes_.begin(); i != collision_meshes_.end();) {
-    CollisionMeshAsset* mesh = i->second.get();
-    // Attempt to prune if there are no references remaining except our own and
-    // its been a while since it was used.
-    if (current_time - mesh->last_used_time() > standard_asset_prune_time
-        && (mesh->object_strong_ref_count() <= 1)) {
+  candidates.clear();
+  victims.clear();
+  total_cost = 0;
+  CollectPruneCandidates_(&collision_meshes_, standard_asset_prune_time,
+                          &candidates, &total_cost);
+  SelectPruneVictims_(&candidates, total_cost,
+                      budget(AssetType::kCollisionMesh), &victims);
+  if (!victims.empty()) {
+    collision_meshes_.EraseIf([&victims](CollisionMeshAsset* mesh) {
+      if (victims.find(mesh) == victims.end()) {
+        return false;
+      }
       // We can unload it immediately since that happens here in the logic
       // thread.
       mesh->Unload();
-      auto i_next = i;
-      ++i_next;
-      collision_meshes_.erase(i);
-      i = i_next;
-    } else {
-      i++;
-    }
+      return true;
+    });
   }
 
-  // Prune sounds.
-  // (DISABLED FOR NOW - getting AL errors; need to better determine which
-  // sounds are still in active use by OpenAL and ensure references exist for
-  // them somewhere while that is the case
-  if (explicit_bool(false)) {
-    assert(asset_lists_locked_);
-    for (auto i = sounds_.begin(); i != sounds_.end();) {
-      SoundAsset* sound = i->second.get();
-      // Attempt to prune if there are no references remaining except our own
-      // and its been a while since it was used.
-      if (current_time - sound->last_used_time() > standard_asset_prune_time
-          && (sound->object_strong_ref_count() <= 1)) {
-        // If its preloaded/loaded we need to ask the audio thread to unload
-        // it first.
-        if (sound->preloaded()) {
-          // Allocate a reference to keep this sound_data alive while the unload
-          // is happening.
-          audio_thread_unloads.push_back(new Object::Ref<Asset>(sound));
-          auto i_next = i;
-          i_next++;
-          sounds_.erase(i);
-          i = i_next;
-        }
-      } else {
-        i++;
-      }
-    }
-  }
+  // Sounds and data are not pruned for now. (Sound pruning was getting AL
+  // errors; need to better determine which sounds are still in active use
+  // by OpenAL and ensure references exist for them somewhere while that
+  // is the case).
 
   if (!graphics_thread_unloads.empty()) {
     g_base->graphics_server->PushComponentUnloadCall(graphics_thread_unloads);
   }
-  if (!audio_thread_unloads.empty()) {
-    g_base->audio_server->PushComponentUnloadCall(audio_thread_unloads);
-  }
 
   if (kShowPruningInfo) {
-    assert(asset_lists_locked_);
     if (textures_.size() != old_texture_count) {
       g_core->Log(LogName::kBaAssets, LogLevel::kInfo,
                   "Textures pruned from " + std::to_string(old_texture_count)
@@ -1068,22 +1146,21 @@ void Assets::Prune(int level) {
                       + std::to_string(old_collision_mesh_count) + " to "
                       + std::to_string(collision_meshes_.size()));
     }
-    if (sounds_.size() != old_sound_count) {
-      g_core->Log(LogName::kBaAssets, LogLevel::kInfo,
-                  "Sounds pruned from " + std::to_string(old_sound_count)
-                      + " to " + std::to_string(sounds_.size()));
-    }
   }
 }
 
-auto Assets::FindAssetFile(FileType type, const std::string& name)
-    -> std::string {
+auto Assets::FindAssetFile(FileType type, const std::string& name,
+                           bool required) -> std::string {
   std::string file_out;
 
   // We don't protect package-path access so make sure its always from here.
   assert(g_base->InLogicThread());
 
   const char* ext = "";
+  // If set, a file with this extension wins over one with ext.
+  const char* preferred_ext = nullptr;
+  // If set, tried after preferred_ext but before ext.
+  const char* fallback_ext = nullptr;
   const char* prefix1 = "";
   const char* prefix2 = "";
 
@@ -1146,7 +1223,19 @@ auto Assets::FindAssetFile(FileType type, const std::string& name)
 #else
       // all else defaults to dds
       ext = ".dds";
+
+      // Without s3tc support our dds files get decompressed at load time;
+      // lz4tex files skip that (and its artifacts), so use them if we have
+      // them.
+      if (!g_base->graphics->placeholder_client_context()
+               ->SupportsTextureCompressionType(
+                   TextureCompressionType::kS3TC)) {
+        fallback_ext = ".lz4tex";
+      }
 #endif
+      // KTX2 files can hold any format and get converted at load time as
+      // needed, so they work everywhere; use one when it's there.
+      preferred_ext = ".ktx2";
       break;
     }
     default:
@@ -1155,27 +1244,77 @@ auto Assets::FindAssetFile(FileType type, const std::string& name)
 
   const std::vector<std::string>& asset_paths_used = asset_paths_;
 
+  // Servers restart often against the same assets, so they remember where
+  // things were found across launches instead of probing every time.
+  std::string cache_key;
+  if (g_core->HeadlessMode()) {
+    if (!asset_path_cache_.loaded()) {
+      std::string validation_key;
+      for (auto&& i : asset_paths_used) {
+        validation_key += i + "\n";
+      }
+      asset_path_cache_.Load(validation_key);
+    }
+    cache_key = std::to_string(static_cast<int>(type)) + ":" + name;
+    if (auto* path = asset_path_cache_.Find(cache_key)) {
+      return *path;
+    }
+  }
+
   for (auto&& i : asset_paths_used) {
+    // Sounds get opened directly by our ogg decoders, so they always come
+    // from loose files.
+    AssetArchive* archive =
+        type == FileType::kSound ? nullptr : FindArchive_(i);
+
     // TEMP - try our '2' stuff first.
     for (auto&& prefix : {prefix2, prefix1}) {
-      file_out = i + "/" + prefix + name + ext;  // NOLINT
-      bool exists;
-
-      // '#' denotes a cube map texture, which is actually 6 files.
-      if (strchr(file_out.c_str(), '#')) {
-        // Just look for one of them i guess.
-        std::string tmp_name = file_out;
-        tmp_name.replace(tmp_name.find('#'), 1, "_+x");
-        exists = g_core->platform->FilePathExists(tmp_name);
-      } else {
-        exists = g_core->platform->FilePathExists(file_out);
-      }
-      if (exists) {
-        return file_out;
+      for (auto&& try_ext : {preferred_ext, fallback_ext, ext}) {
+        if (try_ext == nullptr) {
+          continue;
+        }
+        std::string rel_path = std::string(prefix) + name + try_ext;
+        file_out = i + "/" + rel_path;  // NOLINT
+        bool exists;
+
+        // '#' denotes a cube map texture, which is actually 6 files.
+        bool cube_map = strchr(file_out.c_str(), '#') != nullptr;
+        if (cube_map) {
+          // Just look for one of them i guess.
+          rel_path.replace(rel_path.find('#'), 1, "_+x");
+        }
+
+        // Archived files come back as the same path a loose one would
+        // have; the loaders resolve that through FindArchivedFile().
+        const uint8_t* data;
+        size_t size;
+        if (archive && archive->Find(rel_path, &data, &size)) {
+          if (!cache_key.empty()) {
+            asset_path_cache_.Store(cache_key, file_out);
+          }
+          return file_out;
+        }
+        if (cube_map) {
+          std::string tmp_name = file_out;
+          tmp_name.replace(tmp_name.find('#'), 1, "_+x");
+          exists = g_core->platform->FilePathExists(tmp_name);
+        } else {
+          exists = g_core->platform->FilePathExists(file_out);
+        }
+        if (exists) {
+          if (!cache_key.empty()) {
+            asset_path_cache_.Store(cache_key, file_out);
+          }
+          return file_out;
+        }
       }
     }
   }
 
+  if (!required) {
+    return "";
+  }
+
   // We wanna fail gracefully for some types.
   if (type == FileType::kSound && name != "blank") {
     g_core->Log(LogName::kBaAssets, LogLevel::kError,
@@ -1221,6 +1360,12 @@ void Assets::AddPendingLoad(Object::Ref<Asset>* c) {
   }
 }
 
+void Assets::AddPendingTextureStream(Object::Ref<Asset>* c) {
+  assert((**c).GetAssetType() == AssetType::kTexture);
+  std::scoped_lock lock(pending_load_list_mutex_);
+  pending_texture_streams_.push_back(c);
+}
+
 void Assets::ClearPendingLoadsDoneList() {
   assert(g_base->InLogicThread());
 
@@ -1247,6 +1392,50 @@ void Assets::AddPackage(const std::string& name, const std::string& path) {
     }
   }
   packages_[name] = path;
+  AddArchive_(path);
+}
+
+void Assets::AddArchive_(const std::string& root) {
+  std::unique_ptr<AssetArchive> archive;
+  try {
+    archive = AssetArchive::Open(root + ".bapack");
+  } catch (const std::exception& e) {
+    g_core->Log(LogName::kBaAssets, LogLevel::kError,
+                std::string("Error opening asset archive: ") + e.what());
+  }
+  if (!archive) {
+    return;
+  }
+  g_core->Log(LogName::kBaAssets, LogLevel::kDebug,
+              "Using asset archive '" + archive->path() + "' ("
+                  + std::to_string(archive->entry_count()) + " files).");
+  std::scoped_lock lock(archives_mutex_);
+  archives_.push_back({root, std::move(archive)});
+}
+
+auto Assets::FindArchive_(const std::string& root) -> AssetArchive* {
+  std::scoped_lock lock(archives_mutex_);
+  for (auto&& entry : archives_) {
+    if (entry.root == root) {
+      return entry.archive.get();
+    }
+  }
+  return nullptr;
+}
+
+auto Assets::FindArchivedFile(const std::string& path, const uint8_t** data,
+                              size_t* size) -> bool {
+  std::scoped_lock lock(archives_mutex_);
+  for (auto&& entry : archives_) {
+    const std::string& root{entry.root};
+    if (path.size() > root.size() + 1 && path.compare(0, root.size(), root) == 0
+        && path[root.size()] == '/') {
+      if (entry.archive->Find(path.substr(root.size() + 1), data, size)) {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 void Assets::InitSpecialChars() {
@@ -3,11 +3,17 @@
 #ifndef BALLISTICA_BASE_ASSETS_ASSETS_H_
 #define BALLISTICA_BASE_ASSETS_ASSETS_H_
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "ballistica/base/assets/asset_archive.h"
+#include "ballistica/base/assets/asset_path_cache.h"
+#include "ballistica/base/assets/asset_map.h"
+#include "ballistica/base/assets/generated_texture_cache.h"
 #include "ballistica/base/base.h"
 #include "ballistica/shared/foundation/object.h"
 
@@ -19,7 +25,12 @@ class Assets {
   Assets();
 
   void AddPackage(const std::string& name, const std::string& path);
+
+  /// Free unused assets, least recently used first, for any asset types
+  /// over their memory budgets. Higher levels shrink budgets for when
+  /// memory is tight.
   void Prune(int level = 0);
+  void DoApplyAppConfig();
 
   /// Finish loading any assets that have been preloaded but still need to be
   /// loaded by the proper thread.
@@ -28,18 +39,48 @@ class Assets {
   /// Return true if audio loads remain to be done.
   auto RunPendingAudioLoads() -> bool;
 
-  /// Return true if graphics loads remain to be done.
-  auto RunPendingGraphicsLoads() -> bool;
+  /// Return true if graphics loads remain to be done. If byte_budget is
+  /// passed, no new loads are started once it reaches zero, and the
+  /// estimated size of each load run is subtracted from it (a single load
+  /// may overshoot it).
+  auto RunPendingGraphicsLoads(size_t* byte_budget = nullptr) -> bool;
   void ClearPendingLoadsDoneList();
   template <typename T>
-  auto RunPendingLoadList(std::vector<Object::Ref<T>*>* assets) -> bool;
+  auto RunPendingLoadList(std::vector<Object::Ref<T>*>* assets,
+                          size_t* byte_budget = nullptr) -> bool;
 
   /// This function takes a newly allocated pointer which
   /// is deleted once the load is completed.
   void AddPendingLoad(Object::Ref<Asset>* c);
+
+  /// Like AddPendingLoad but for the graphics-thread half of a texture
+  /// resident-level change.
+  void AddPendingTextureStream(Object::Ref<Asset>* c);
+
+  /// Stream mip levels in for recently drawn textures and, when over
+  /// budget_bytes (0 for no limit), out for long-unused ones. Should be
+  /// called periodically from the logic thread with the current frame-def
+  /// number.
+  void UpdateTextureStreaming(int64_t frame_number, size_t budget_bytes);
   enum class FileType { kMesh, kCollisionMesh, kTexture, kSound, kData };
-  auto FindAssetFile(FileType fileType, const std::string& file_in)
-      -> std::string;
+
+  /// Return the path to an asset file. If it can't be found, some types
+  /// fall back to a placeholder and others throw; pass required=false to
+  /// get an empty string instead.
+  auto FindAssetFile(FileType fileType, const std::string& file_in,
+                     bool required = true) -> std::string;
+
+  /// If a path returned by FindAssetFile() lives in an asset archive,
+  /// point data at its bytes (valid for the life of the app) and return
+  /// true. Can be called from any thread.
+  auto FindArchivedFile(const std::string& path, const uint8_t** data,
+                        size_t* size) -> bool;
+
+  /// Pixels of recently generated text and qr-code textures, by content.
+  /// Can be used from any thread.
+  auto generated_textures() -> GeneratedTextureCache* {
+    return &generated_textures_;
+  }
 
   /// Unload renderer-specific bits only (gl display lists, etc) - used when
   /// recreating/adjusting the renderer.
@@ -50,6 +91,17 @@ class Assets {
   void MarkAllAssetsForLoad();
   void PrintLoadInfo();
 
+  struct MemoryUsage {
+    const char* name{};
+    AssetType type{};
+    size_t count{};
+    size_t bytes{};
+  };
+
+  /// Current asset counts and rough memory use (see
+  /// Asset::GetMemoryCost()) by type.
+  auto GetMemoryUsage() -> std::vector<MemoryUsage>;
+
   auto GetMeshPendingLoadCount() -> int;
   auto GetTexturePendingLoadCount() -> int;
   auto GetSoundPendingLoadCount() -> int;
@@ -62,7 +114,11 @@ class Assets {
   /// Return the total number of pending loads.
   auto GetPendingLoadCount() -> int;
 
-  /// You must hold one of these locks while calling GetXXX() below.
+  /// Serializes logic-thread code working with the asset lists. Lookups
+  /// and adds only ever happen in the logic thread and other threads
+  /// iterating the lists lock them individually (see AssetMap), so
+  /// nothing here waits on other threads. GetXXX() no longer requires
+  /// this, but existing callers holding one are fine.
   class AssetListLock {
    public:
     AssetListLock();
@@ -80,7 +136,7 @@ class Assets {
   auto SysSound(SysSoundID id) -> SoundAsset*;
   auto SysMesh(SysMeshID id) -> MeshAsset*;
 
-  /// Load/cache custom assets. Make sure you hold a AssetListLock.
+  /// Load/cache custom assets. Logic thread only.
   auto GetTexture(const std::string& file_name) -> Object::Ref<TextureAsset>;
   auto GetTexture(TextPacker* packer) -> Object::Ref<TextureAsset>;
   auto GetQRCodeTexture(const std::string& url) -> Object::Ref<TextureAsset>;
@@ -130,18 +186,34 @@ class Assets {
   void InitSpecialChars();
 
   template <typename T>
-  auto GetAssetPendingLoadCount(
-      std::unordered_map<std::string, Object::Ref<T> >* t_list, AssetType type)
-      -> int;
+  auto GetAssetPendingLoadCount(AssetMap<T>* t_list, AssetType type) -> int;
+
+  struct PruneCandidate_ {
+    Asset* asset;
+    millisecs_t last_used_time;
+    size_t cost;
+  };
+  template <typename T>
+  void CollectPruneCandidates_(AssetMap<T>* assets, millisecs_t min_idle_time,
+                               std::vector<PruneCandidate_>* candidates,
+                               size_t* total_cost);
+  void SelectPruneVictims_(std::vector<PruneCandidate_>* candidates,
+                           size_t total_cost, size_t budget,
+                           std::unordered_set<Asset*>* victims);
 
   template <typename T>
-  auto GetAsset(const std::string& file_name,
-                std::unordered_map<std::string, Object::Ref<T> >* c_list)
+  auto GetAsset(const std::string& file_name, AssetMap<T>* c_list)
       -> Object::Ref<T>;
 
+  auto RunPendingTextureStreams_(size_t* byte_budget) -> bool;
+
   int language_state_{};
   bool have_pending_loads_[static_cast<int>(AssetType::kLast)]{};
 
+  // Bytes each asset type may use before Prune() starts evicting; 0 for
+  // no limit.
+  size_t memory_budgets_[static_cast<int>(AssetType::kLast)]{};
+
   // Will be true while a AssetListLock exists. Good to debug-verify this
   // during any asset list access.
   bool asset_lists_locked_{};
@@ -151,6 +223,21 @@ class Assets {
   std::vector<std::string> asset_paths_;
   std::unordered_map<std::string, std::string> packages_;
 
+  /// Opens '<root>.bapack' if it exists and serves files under root from
+  /// it from then on.
+  void AddArchive_(const std::string& root);
+  auto FindArchive_(const std::string& root) -> AssetArchive*;
+
+  // Archives are never removed, so pointers into them stay valid.
+  struct ArchiveEntry_ {
+    std::string root;
+    std::unique_ptr<AssetArchive> archive;
+  };
+  std::vector<ArchiveEntry_> archives_;
+  std::mutex archives_mutex_;
+  GeneratedTextureCache generated_textures_;
+  AssetPathCache asset_path_cache_;
+
   // For use by AssetListLock; don't manually acquire.
   std::mutex asset_lists_mutex_;
 
@@ -161,14 +248,13 @@ class Assets {
   std::vector<Object::Ref<MeshAsset> > system_meshes_;
 
   // All existing assets by filename (including internal).
-  std::unordered_map<std::string, Object::Ref<TextureAsset> > textures_;
-  std::unordered_map<std::string, Object::Ref<TextureAsset> > text_textures_;
-  std::unordered_map<std::string, Object::Ref<TextureAsset> > qr_textures_;
-  std::unordered_map<std::string, Object::Ref<MeshAsset> > meshes_;
-  std::unordered_map<std::string, Object::Ref<SoundAsset> > sounds_;
-  std::unordered_map<std::string, Object::Ref<DataAsset> > datas_;
-  std::unordered_map<std::string, Object::Ref<CollisionMeshAsset> >
-      collision_meshes_;
+  AssetMap<TextureAsset> textures_;
+  AssetMap<TextureAsset> text_textures_;
+  AssetMap<TextureAsset> qr_textures_;
+  AssetMap<MeshAsset> meshes_;
+  AssetMap<SoundAsset> sounds_;
+  AssetMap<DataAsset> datas_;
+  AssetMap<CollisionMeshAsset> collision_meshes_;
 
   // Components that have been preloaded but need to be loaded.
   std::mutex pending_load_list_mutex_;
@@ -177,6 +263,7 @@ class Assets {
   std::vector<Object::Ref<Asset>*> pending_loads_datas_;
   std::vector<Object::Ref<Asset>*> pending_loads_other_;
   std::vector<Object::Ref<Asset>*> pending_loads_done_;
+  std::vector<Object::Ref<Asset>*> pending_texture_streams_;
 
   // Text & Language (need to mold this into more asset-like concepts).
   std::mutex language_mutex_;
@@ -2,15 +2,17 @@
 
 #include "ballistica/base/assets/assets_server.h"
 
-#include <cstdio>
-#include <string>
+#include <algorithm>
+#include <atomic>
 #include <vector>
 
 #include "ballistica/base/assets/asset.h"
 #include "ballistica/base/assets/assets.h"
+#include "ballistica/base/assets/texture_asset.h"
 #include "ballistica/base/graphics/graphics.h"
-#include "ballistica/base/support/huffman.h"
-#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/core.h"
+#include "ballistica/core/support/thread_trace.h"
+#include "ballistica/shared/foundation/job_system.h"
 #include "ballistica/shared/foundation/event_loop.h"
 
 namespace ballistica::base {
@@ -33,13 +35,16 @@ void AssetsServer::OnAppStartInThread_() {
       987 * 1000, true, NewLambdaRunnable([this] { Process_(); }).get());
 }
 
-void AssetsServer::PushPendingPreload(Object::Ref<Asset>* asset_ref_ptr) {
-  event_loop()->PushCall([this, asset_ref_ptr] {
+void AssetsServer::PushPendingPreload(Object::Ref<Asset>* asset_ref_ptr,
+                                      bool high_priority) {
+  event_loop()->PushCall([this, asset_ref_ptr, high_priority] {
     assert(g_base->InAssetsThread());
 
     // Add our pointer to one of the preload lists and shake our preload
     // thread to wake it up
-    if ((**asset_ref_ptr).GetAssetType() == AssetType::kSound) {
+    if (high_priority) {
+      pending_preloads_priority_.push_back(asset_ref_ptr);
+    } else if ((**asset_ref_ptr).GetAssetType() == AssetType::kSound) {
       pending_preloads_audio_.push_back(asset_ref_ptr);
     } else {
       pending_preloads_.push_back(asset_ref_ptr);
@@ -48,190 +53,18 @@ void AssetsServer::PushPendingPreload(Object::Ref<Asset>* asset_ref_ptr) {
   });
 }
 
-void AssetsServer::PushBeginWriteReplayCall(uint16_t protocol_version) {
-  event_loop()->PushCall([this, protocol_version] {
-    if (replays_broken_) {
-      return;
-    }
-
-    // We only allow writing one replay at once; make sure that's actually
-    // the case.
-    if (writing_replay_) {
-      g_core->Log(
-          LogName::kBaAssets, LogLevel::kError,
-          "AssetsServer got BeginWriteReplayCall while already writing");
-      WriteReplayMessages_();
-      if (replay_out_file_) {
-        fclose(replay_out_file_);
-      }
-      replay_out_file_ = nullptr;
-      replays_broken_ = true;
-      return;
-    }
-    writing_replay_ = true;
-
-    std::string f_name = "__lastReplay";
-    assert(g_core);
-    std::string file_path =
-        g_core->platform->GetReplaysDir() + BA_DIRSLASH + f_name + ".brp";
-    replay_out_file_ = g_core->platform->FOpen(file_path.c_str(), "wb");
-    replay_bytes_written_ = 0;
-
-    if (!replay_out_file_) {
-      g_core->Log(LogName::kBa, LogLevel::kError,
-                  "unable to open output-stream file: '" + file_path + "'");
-    } else {
-      // Write file id and protocol-version.
-      // NOTE: We always write replays in our host protocol version
-      // no matter what the client stream is.
-      uint32_t file_id = kBrpFileID;
-      uint16_t version = protocol_version;
-      if ((fwrite(&file_id, sizeof(file_id), 1, replay_out_file_) != 1)
-          || (fwrite(&version, sizeof(version), 1, replay_out_file_) != 1)) {
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        g_core->Log(LogName::kBa, LogLevel::kError,
-                    "error writing replay file header: "
-                        + g_core->platform->GetErrnoString());
-      }
-      replay_bytes_written_ = 5;
-    }
-
-    // Trigger our process timer to go off immediately (we may need to wake
-    // it up).
-    g_base->assets_server->process_timer_->SetLength(0);
-  });
-}
-
-void AssetsServer::PushAddMessageToReplayCall(
-    const std::vector<uint8_t>& data) {
-  event_loop()->PushCall([this, data] {
-    if (replays_broken_) {
-      return;
-    }
-
-    // Sanity check.
-    if (!writing_replay_) {
-      g_core->Log(
-          LogName::kBa, LogLevel::kError,
-          "AssetsServer got AddMessageToReplayCall while not writing replay");
-      replays_broken_ = true;
-      return;
-    }
-
-    // Just add it to our list.
-    if (replay_out_file_) {
-      // If we've got too much data built up (lets go with 10 megs for now),
-      // abort.
-      if (replay_message_bytes_ > 10000000) {
-        g_core->Log(LogName::kBa, LogLevel::kError,
-                    "replay output buffer exceeded 10 megs; aborting replay");
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        replay_message_bytes_ = 0;
-        replay_messages_.clear();
-        return;
-      }
-      replay_message_bytes_ += data.size();
-      replay_messages_.push_back(data);
-    }
-  });
-}
-
-void AssetsServer::PushEndWriteReplayCall() {
-  event_loop()->PushCall([this] {
-    if (replays_broken_) {
-      return;
-    }
-
-    // Sanity check.
-    if (!writing_replay_) {
-      g_core->Log(LogName::kBa, LogLevel::kError,
-                  "_finishWritingReplay called while not writing");
-      replays_broken_ = true;
-      return;
-    }
-    WriteReplayMessages_();
-
-    // Whether or not we actually have a file has no impact on our
-    // writing_replay_ status.
-    if (replay_out_file_) {
-      fclose(replay_out_file_);
-      replay_out_file_ = nullptr;
-    }
-    writing_replay_ = false;
+void AssetsServer::PushPendingTextureStream(
+    Object::Ref<Asset>* asset_ref_ptr) {
+  event_loop()->PushCall([asset_ref_ptr] {
+    assert(g_base->InAssetsThread());
+    assert((**asset_ref_ptr).GetAssetType() == AssetType::kTexture);
+    static_cast<TextureAsset*>(asset_ref_ptr->get())->PreloadStream();
+    g_base->assets->AddPendingTextureStream(asset_ref_ptr);
   });
 }
 
-void AssetsServer::WriteReplayMessages_() {
-  if (replay_out_file_) {
-    for (auto&& i : replay_messages_) {
-      std::vector<uint8_t> data_compressed = g_base->huffman->compress(i);
-
-      // If message length is < 254, write length as one byte.
-      // If its between 254 and 65535, write 254 and then 2 length bytes
-      // otherwise write 255 and then 4 length bytes.
-      auto len32 = static_cast<uint32_t>(data_compressed.size());
-      {
-        uint8_t len8;
-        if (len32 < 254) {
-          len8 = static_cast_check_fit<uint8_t>(len32);
-        } else if (len32 < 65535) {
-          len8 = 254;
-        } else {
-          len8 = 255;
-        }
-        if (fwrite(&len8, 1, 1, replay_out_file_) != 1) {
-          fclose(replay_out_file_);
-          replay_out_file_ = nullptr;
-          g_core->Log(LogName::kBaAudio, LogLevel::kError,
-                      "Error writing replay file: "
-                          + g_core->platform->GetErrnoString());
-          return;
-        }
-      }
-      // write 16 bit val if need be.
-      if (len32 >= 254) {
-        if (len32 <= 65535) {
-          auto len16 = static_cast_check_fit<uint16_t>(len32);
-          if (fwrite(&len16, 2, 1, replay_out_file_) != 1) {
-            fclose(replay_out_file_);
-            replay_out_file_ = nullptr;
-            g_core->Log(LogName::kBaAudio, LogLevel::kError,
-                        "Error writing replay file: "
-                            + g_core->platform->GetErrnoString());
-            return;
-          }
-        } else {
-          if (fwrite(&len32, 4, 1, replay_out_file_) != 1) {
-            fclose(replay_out_file_);
-            replay_out_file_ = nullptr;
-            g_core->Log(LogName::kBaAudio, LogLevel::kError,
-                        "Error writing replay file: "
-                            + g_core->platform->GetErrnoString());
-            return;
-          }
-        }
-      }
-      // Write buffer.
-      size_t result = fwrite(&(data_compressed[0]), data_compressed.size(), 1,
-                             replay_out_file_);
-      if (result != 1) {
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        g_core->Log(
-            LogName::kBaAudio, LogLevel::kError,
-            "Error writing replay file: " + g_core->platform->GetErrnoString());
-        return;
-      }
-      replay_bytes_written_ += data_compressed.size() + 2;
-    }
-    replay_messages_.clear();
-    replay_message_bytes_ = 0;
-  }
-}
-
 void AssetsServer::Process_() {
+  BA_TRACE_SCOPE("AssetsServer::Process");
   // Make sure we don't do any loading until we know what kind/quality of
   // textures we'll be loading.
 
@@ -242,35 +75,72 @@ void AssetsServer::Process_() {
     return;
   }
 
-  // Process exactly 1 preload item. Empty out our non-audio list first
-  // (audio is less likely to cause noticeable hitches if it needs to be
-  // loaded on-demand, so that's a lower priority for us).
-  if (!pending_preloads_.empty()) {
-    (**pending_preloads_.back()).Preload();
-    // Pass the ref-pointer along to the load queue.
-    g_base->assets->AddPendingLoad(pending_preloads_.back());
-    pending_preloads_.pop_back();
-  } else if (!pending_preloads_audio_.empty()) {
-    (**pending_preloads_audio_.back()).Preload();
-    // Pass the ref-pointer along to the load queue.
-    g_base->assets->AddPendingLoad(pending_preloads_audio_.back());
-    pending_preloads_audio_.pop_back();
+  // Grab a chunk of preloads and work through it with a few runners on
+  // the job system (we're one of them). Each runner pulls the next item as
+  // soon as it finishes its last, so we keep several reads in flight the
+  // whole way through instead of stalling each batch on its slowest file.
+  // Each item is passed along to its load queue as soon as it is done, so
+  // the graphics/audio threads can get going on the early finishers.
+  // Anything that can't preload concurrently just runs here up front.
+  JobSystem* job_system = g_core->job_system;
+  std::vector<Object::Ref<Asset>*> preloads;
+  for (int i = 0; i < kMaxPreloadsPerProcess; ++i) {
+    Object::Ref<Asset>* asset_ref_ptr = PopPendingPreload_();
+    if (!asset_ref_ptr) {
+      break;
+    }
+    if (!job_system || !(**asset_ref_ptr).CanPreloadConcurrently()) {
+      (**asset_ref_ptr).Preload();
+      g_base->assets->AddPendingLoad(asset_ref_ptr);
+      continue;
+    }
+    preloads.push_back(asset_ref_ptr);
+  }
+  if (!preloads.empty()) {
+    std::atomic<size_t> next_preload{};
+    auto run = [&preloads, &next_preload] {
+      for (size_t i = next_preload++; i < preloads.size();
+           i = next_preload++) {
+        (**preloads[i]).Preload();
+        g_base->assets->AddPendingLoad(preloads[i]);
+      }
+    };
+    int runner_count =
+        std::min({kMaxConcurrentPreloads, job_system->thread_count() + 1,
+                  static_cast<int>(preloads.size())});
+    JobSystem::Group group;
+    for (int i = 1; i < runner_count; ++i) {
+      job_system->Push(&group, run);
+    }
+    try {
+      run();
+    } catch (...) {
+      job_system->Wait(&group);
+      throw;
+    }
+    job_system->Wait(&group);
   }
 
-  // If we're writing a replay, dump anything we've got built up.
-  if (writing_replay_) {
-    WriteReplayMessages_();
+  // If we've got nothing left, just sleep indefinitely.
+  if (pending_preloads_priority_.empty() && pending_preloads_.empty()
+      && pending_preloads_audio_.empty()) {
+    process_timer_->SetLength(-1);
   }
+}
 
-  // If we've got nothing left, set our timer to go off every now and then
-  // if we're writing a replay.. otherwise just sleep indefinitely.
-  if (pending_preloads_.empty() && pending_preloads_audio_.empty()) {
-    if (writing_replay_) {
-      process_timer_->SetLength(1000 * 1000);
-    } else {
-      process_timer_->SetLength(-1);
+auto AssetsServer::PopPendingPreload_() -> Object::Ref<Asset>* {
+  // Empty out our priority list first and then non-audio (audio is less
+  // likely to cause noticeable hitches if it needs to be loaded
+  // on-demand, so that's a lower priority for us).
+  for (auto* list : {&pending_preloads_priority_, &pending_preloads_,
+                     &pending_preloads_audio_}) {
+    if (!list->empty()) {
+      Object::Ref<Asset>* asset_ref_ptr = list->back();
+      list->pop_back();
+      return asset_ref_ptr;
     }
   }
+  return nullptr;
 }
 
 }  // namespace ballistica::base
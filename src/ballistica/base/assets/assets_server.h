@@ -3,8 +3,6 @@
 #ifndef BALLISTICA_BASE_ASSETS_ASSETS_SERVER_H_
 #define BALLISTICA_BASE_ASSETS_ASSETS_SERVER_H_
 
-#include <cstdio>
-#include <list>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -16,27 +14,36 @@ class AssetsServer {
  public:
   AssetsServer();
   void OnMainThreadStartApp();
-  void PushBeginWriteReplayCall(uint16_t protocol_version);
-  void PushEndWriteReplayCall();
-  void PushAddMessageToReplayCall(const std::vector<uint8_t>& data);
-  void PushPendingPreload(Object::Ref<Asset>* asset_ref_ptr);
+  /// Queue an asset to be preloaded and then passed along to its load
+  /// queue. High priority preloads (system assets, which we can't do
+  /// anything without) go before everything else.
+  void PushPendingPreload(Object::Ref<Asset>* asset_ref_ptr,
+                          bool high_priority = false);
+
+  /// Read a texture's new mip levels (see
+  /// TextureAsset::RequestResidentLevel) and pass it along to the graphics
+  /// thread. Takes a newly allocated ref pointer, like PushPendingPreload.
+  void PushPendingTextureStream(Object::Ref<Asset>* asset_ref_ptr);
   auto event_loop() const -> EventLoop* { return event_loop_; }
 
  private:
   void OnAppStartInThread_();
   void Process_();
-  void WriteReplayMessages_();
+  auto PopPendingPreload_() -> Object::Ref<Asset>*;
 
-  std::list<std::vector<uint8_t> > replay_messages_;
+  /// Most preloads we run at once on the job system. Generally disk
+  /// bound beyond this.
+  static constexpr int kMaxConcurrentPreloads = 8;
+
+  /// Most preloads we take on per processing pass before checking back in
+  /// with our event loop.
+  static constexpr int kMaxPreloadsPerProcess = 64;
+
+  std::vector<Object::Ref<Asset>*> pending_preloads_priority_;
   std::vector<Object::Ref<Asset>*> pending_preloads_;
   std::vector<Object::Ref<Asset>*> pending_preloads_audio_;
   EventLoop* event_loop_{};
-  FILE* replay_out_file_{};
   Timer* process_timer_{};
-  size_t replay_bytes_written_{};
-  size_t replay_message_bytes_{};
-  bool writing_replay_{};
-  bool replays_broken_{};
 };
 
 }  // namespace ballistica::base
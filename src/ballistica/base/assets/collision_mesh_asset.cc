@@ -3,14 +3,22 @@
 #include "ballistica/base/assets/collision_mesh_asset.h"
 
 #include <cstdio>
+#include <cstring>
 #include <string>
+#include <vector>
 
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/platform/core_platform.h"
 
 namespace ballistica::base {
 
+// Cob data is single-precision floats; we hand it to ODE as-is.
+#ifndef dSINGLE
+#error collision meshes expect single-precision ODE
+#endif
+
 CollisionMeshAsset::CollisionMeshAsset(const std::string& file_name_in)
     : file_name_(file_name_in) {
   assert(g_base && g_base->assets);
@@ -30,87 +38,69 @@ auto CollisionMeshAsset::GetName() const -> std::string {
 void CollisionMeshAsset::DoPreload() {
   assert(!file_name_.empty());
 
-  FILE* f = g_core->platform->FOpen(file_name_full_.c_str(), "rb");
-  uint32_t i_vals[2];
-  if (!f) {
-    throw Exception("Can't open collision mesh file: '" + file_name_full_
-                    + "'");
+  // Cob files are just a header followed by the vertex, index, and normal
+  // arrays ODE wants, so we hand it those right where they sit in memory
+  // (either in an already-mapped archive or our own mapping of the file).
+  const uint8_t* data;
+  size_t size;
+  if (!g_base->assets->FindArchivedFile(file_name_full_, &data, &size)) {
+    mapped_file_ = MappedFile::Open(file_name_full_);
+    if (!mapped_file_) {
+      throw Exception("Can't open collision mesh file: '" + file_name_full_
+                      + "'");
+    }
+    data = mapped_file_->data();
+    size = mapped_file_->size();
   }
 
-  uint32_t version;
-  if (fread(&version, sizeof(version), 1, f) != 1) {
+  uint32_t header[3];  // id, vertex-count, face-count
+  if (size < sizeof(header)) {
     throw Exception("Error reading file header for '" + file_name_full_ + "'");
   }
-
-  if (version != kCobFileID) {
+  memcpy(header, data, sizeof(header));
+  if (header[0] != kCobFileID) {
     throw Exception("File '" + file_name_full_
                     + " is in an old format or not a cob file (got id "
-                    + std::to_string(version) + ", "
+                    + std::to_string(header[0]) + ", "
                     + std::to_string(kCobFileID) + ")");
   }
 
-  // Read the vertex count and face count.
-  if (fread(i_vals, sizeof(i_vals), 1, f) != 1) {
+  // 3 floats per vertex, 3 indices per face, and 3 floats per face-normal.
+  size_t vertex_count = header[1];
+  size_t index_count = static_cast<size_t>(header[2]) * 3;
+  size_t vertices_size = vertex_count * 3 * sizeof(dReal);
+  size_t indices_size = index_count * sizeof(uint32_t);
+  size_t normals_size = index_count * sizeof(dReal);
+  size_t body_size = vertices_size + indices_size + normals_size;
+  if (size - sizeof(header) < body_size) {
     throw Exception("Read failed for " + file_name_full_);
   }
+  const uint8_t* body = data + sizeof(header);
 
-  size_t vertex_count = i_vals[0];
-  size_t tri_count = i_vals[1];
-
-  // Need 3 floats per vertex.
-  vertices_.resize(vertex_count * 3);
-
-  // Need 3 indices per face.
-  indices_.resize(tri_count * 3);
-
-  // Need 3 floats per face-normal.
-  normals_.resize(tri_count * 3);
-
-  if (fread(&(vertices_[0]), vertices_.size() * sizeof(dReal), 1, f) != 1) {
-    throw Exception("Read failed for " + file_name_full_);
-  }
-  if (fread(&(indices_[0]), indices_.size() * sizeof(uint32_t), 1, f) != 1) {
-    throw Exception("Read failed for " + file_name_full_);
-  }
-  if (fread(&(normals_[0]), normals_.size() * sizeof(dReal), 1, f) != 1) {
-    throw Exception("Read failed for " + file_name_full_);
+  // Archives and mappings keep things aligned, but play it safe.
+  if (reinterpret_cast<uintptr_t>(body) % alignof(uint32_t) != 0) {
+    data_copy_.resize(body_size / sizeof(uint32_t));
+    memcpy(data_copy_.data(), body, body_size);
+    body = reinterpret_cast<const uint8_t*>(data_copy_.data());
   }
-
-  fclose(f);
+  auto* vertices = reinterpret_cast<const dReal*>(body);
+  auto* indices = reinterpret_cast<const uint32_t*>(body + vertices_size);
+  auto* normals =
+      reinterpret_cast<const dReal*>(body + vertices_size + indices_size);
 
   tri_mesh_data_ = dGeomTriMeshDataCreate();
   BA_PRECONDITION(tri_mesh_data_);
 
-  if (!g_core->HeadlessMode()) {
-    tri_mesh_data_bg_ = dGeomTriMeshDataCreate();
-    BA_PRECONDITION(tri_mesh_data_bg_);
-  }
-
-#ifdef dSINGLE
-  dGeomTriMeshDataBuildSingle1(
-      tri_mesh_data_, &(vertices_[0]), 3 * sizeof(dReal),
-      static_cast_check_fit<int>(vertex_count), &(indices_[0]),
-      static_cast<int>(indices_.size()), 3 * sizeof(uint32_t), &(normals_[0]));
-  if (!g_core->HeadlessMode()) {
-    dGeomTriMeshDataBuildSingle1(tri_mesh_data_bg_, &(vertices_[0]),
-                                 3 * sizeof(dReal), i_vals[0], &(indices_[0]),
-                                 static_cast<int>(indices_.size()),
-                                 3 * sizeof(uint32_t), &(normals_[0]));
-  }
-#else
-#ifndef dDOUBLE
-#error single or double precition not defined
-#endif
-  dGeomTriMeshDataBuildDouble1(
-      tri_mesh_data_, &(vertices_[0]), 3 * sizeof(dReal), vertex_count,
-      &(indices_[0]), indices_.size(), 3 * sizeof(uint32_t), &(normals_[0]));
-  if (!HeadlessMode()) {
-    dGeomTriMeshDataBuildDouble1(
-        tri_mesh_data_bg_, &(vertices_[0]), 3 * sizeof(dReal), i_vals[0],
-        &(indices_[0]), indices_.size(), 3 * sizeof(uint32_t), &(normals_[0]));
-  }
-#endif  // dSINGLE
-}  // namespace ballistica
+  // Building the data also builds its collision tree, which is the bulk of
+  // the work here. Queries only read from it (with single-precision
+  // verts; double ones go through a scratch cache) so the logic and
+  // bg-dynamics threads can share one.
+  dGeomTriMeshDataBuildSingle1(tri_mesh_data_, vertices, 3 * sizeof(dReal),
+                               static_cast_check_fit<int>(vertex_count),
+                               indices, static_cast_check_fit<int>(index_count),
+                               3 * sizeof(uint32_t), normals);
+  set_memory_cost(body_size);
+}
 
 void CollisionMeshAsset::DoLoad() { assert(g_base->InLogicThread()); }
 
@@ -128,9 +118,9 @@ void CollisionMeshAsset::DoUnload() {
   }
 
   dGeomTriMeshDataDestroy(tri_mesh_data_);
-  if (tri_mesh_data_bg_) {
-    dGeomTriMeshDataDestroy(tri_mesh_data_bg_);
-  }
+  tri_mesh_data_ = nullptr;
+  mapped_file_.reset();
+  std::vector<uint32_t>().swap(data_copy_);
 }
 
 auto CollisionMeshAsset::GetMeshData() -> dTriMeshDataID {
@@ -141,7 +131,8 @@ auto CollisionMeshAsset::GetMeshData() -> dTriMeshDataID {
 auto CollisionMeshAsset::GetBGMeshData() -> dTriMeshDataID {
   assert(loaded());
   assert(!g_core->HeadlessMode());
-  return tri_mesh_data_bg_;
+  assert(tri_mesh_data_);
+  return tri_mesh_data_;
 }
 
 }  // namespace ballistica::base
@@ -3,10 +3,12 @@
 #ifndef BALLISTICA_BASE_ASSETS_COLLISION_MESH_ASSET_H_
 #define BALLISTICA_BASE_ASSETS_COLLISION_MESH_ASSET_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "ballistica/base/assets/asset.h"
+#include "ballistica/base/assets/asset_archive.h"
 #include "ode/ode.h"
 
 namespace ballistica::base {
@@ -24,16 +26,21 @@ class CollisionMeshAsset : public Asset {
   auto GetName() const -> std::string override;
 
   auto GetMeshData() -> dTriMeshDataID;
+
+  /// Mesh data for the bg-dynamics thread. This is currently the same
+  /// data as GetMeshData(), as it is never modified after we build it.
   auto GetBGMeshData() -> dTriMeshDataID;
 
  private:
   std::string file_name_;
   std::string file_name_full_;
-  std::vector<dReal> vertices_;
-  std::vector<uint32_t> indices_;
-  std::vector<dReal> normals_;
+
+  // ODE references our file data directly, so we hold onto it for as long
+  // as our mesh data lives: a loose file we've mapped ourself (archived
+  // ones are mapped already), or a copy should it ever be misaligned.
+  std::unique_ptr<MappedFile> mapped_file_;
+  std::vector<uint32_t> data_copy_;
   dTriMeshDataID tri_mesh_data_{};
-  dTriMeshDataID tri_mesh_data_bg_{};
 };
 
 }  // namespace ballistica::base
@@ -6,9 +6,9 @@
 
 #include <string>
 
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/core/python/core_python.h"
-#include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::base {
 
@@ -39,7 +39,12 @@ void DataAsset::DoPreload() {
   // and then do the Python work in Load(). This should still avoid the nastiest
   // IO-related hitches at least..
 
-  raw_input_ = Utils::FileToString(file_name_full_);
+  AssetFile f(file_name_full_);
+  if (!f.is_open()) {
+    throw Exception("Can't open data file: '" + file_name_full_ + "'");
+  }
+  raw_input_ = f.ReadRemaining();
+  set_memory_cost(raw_input_.size());
 }
 
 void DataAsset::DoLoad() {
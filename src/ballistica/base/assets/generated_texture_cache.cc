@@ -0,0 +1,217 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/assets/generated_texture_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "ballistica/base/assets/texture_asset_preload_data.h"
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// Bump this if the on-disk layout changes.
+const uint32_t kGeneratedTextureCacheVersion = 1;
+const uint32_t kGeneratedTextureCacheMagic = 0x43544142;  // 'BATC'
+
+static auto BytesPerPixel_(TextureFormat format) -> int {
+  switch (format) {
+    case TextureFormat::kRGBA_8888:
+      return 4;
+    case TextureFormat::kRGB_888:
+      return 3;
+    case TextureFormat::kRGBA_4444:
+    case TextureFormat::kRGB_565:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+void GeneratedTextureCache::set_budget(size_t bytes) {
+  std::scoped_lock lock(mutex_);
+  budget_ = bytes;
+  Trim_();
+}
+
+void GeneratedTextureCache::set_disk_cache_enabled(bool enabled) {
+  std::scoped_lock lock(mutex_);
+  disk_cache_enabled_ = enabled;
+}
+
+auto GeneratedTextureCache::size() -> size_t {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+auto GeneratedTextureCache::bytes() -> size_t {
+  std::scoped_lock lock(mutex_);
+  return bytes_;
+}
+
+auto GeneratedTextureCache::Find(const std::string& key, bool persistent,
+                                 TextureAssetPreloadData* data) -> bool {
+  assert(data);
+  std::scoped_lock lock(mutex_);
+  auto i = entries_.find(key);
+  if (i != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, i->second.lru_position);
+    Fill_(i->second, data);
+    return true;
+  }
+  if (!persistent || !disk_cache_enabled_) {
+    return false;
+  }
+  Entry_ entry;
+  if (!ReadFromDisk_(key, &entry)) {
+    return false;
+  }
+  Fill_(entry, data);
+  Insert_(key, std::move(entry));
+  return true;
+}
+
+void GeneratedTextureCache::Store(const std::string& key, bool persistent,
+                                  const TextureAssetPreloadData& data) {
+  int bytes_per_pixel = BytesPerPixel_(data.formats[0]);
+  assert(bytes_per_pixel > 0);
+  if (bytes_per_pixel == 0 || data.buffers[0] == nullptr) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (budget_ == 0 && !(persistent && disk_cache_enabled_)) {
+    return;
+  }
+  Entry_ entry;
+  entry.width = data.widths[0];
+  entry.height = data.heights[0];
+  entry.format = data.formats[0];
+  size_t size = static_cast<size_t>(entry.width)
+                * static_cast<size_t>(entry.height) * bytes_per_pixel;
+  entry.pixels.assign(data.buffers[0], data.buffers[0] + size);
+  if (persistent && disk_cache_enabled_) {
+    WriteToDisk_(key, entry);
+  }
+  Insert_(key, std::move(entry));
+}
+
+void GeneratedTextureCache::Insert_(const std::string& key, Entry_&& entry) {
+  auto i = entries_.find(key);
+  if (i != entries_.end()) {
+    bytes_ -= i->second.pixels.size();
+    lru_.erase(i->second.lru_position);
+    entries_.erase(i);
+  }
+  lru_.push_front(key);
+  entry.lru_position = lru_.begin();
+  bytes_ += entry.pixels.size();
+  entries_.emplace(key, std::move(entry));
+  Trim_();
+}
+
+void GeneratedTextureCache::Trim_() {
+  while (bytes_ > budget_ && !lru_.empty()) {
+    auto i = entries_.find(lru_.back());
+    assert(i != entries_.end());
+    bytes_ -= i->second.pixels.size();
+    entries_.erase(i);
+    lru_.pop_back();
+  }
+}
+
+void GeneratedTextureCache::Fill_(const Entry_& entry,
+                                  TextureAssetPreloadData* data) {
+  auto* buffer = static_cast<uint8_t*>(malloc(entry.pixels.size()));
+  memcpy(buffer, entry.pixels.data(), entry.pixels.size());
+  data->buffers[0] = buffer;
+  data->widths[0] = entry.width;
+  data->heights[0] = entry.height;
+  data->formats[0] = entry.format;
+  data->base_level = 0;
+}
+
+auto GeneratedTextureCache::DiskPath_(const std::string& key) -> std::string {
+  // FNV-1a; the full key is stored in the file and checked on read, so
+  // collisions just mean a miss.
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.tex",
+           static_cast<unsigned long long>(hash));  // NOLINT
+  return g_core->platform->GetVolatileDataDirectory() + BA_DIRSLASH
+         + "textcache" + BA_DIRSLASH + name;
+}
+
+auto GeneratedTextureCache::ReadFromDisk_(const std::string& key,
+                                          Entry_* entry) -> bool {
+  std::string path = DiskPath_(key);
+  FILE* f = g_core->platform->FOpen(path.c_str(), "rb");
+  if (!f) {
+    return false;
+  }
+  bool ok = false;
+  uint32_t header[4]{};
+  int32_t dims[3]{};
+  if (fread(header, sizeof(header), 1, f) == 1
+      && header[0] == kGeneratedTextureCacheMagic
+      && header[1] == kGeneratedTextureCacheVersion
+      && header[2] == static_cast<uint32_t>(kEngineBuildNumber)
+      && header[3] == key.size() && fread(dims, sizeof(dims), 1, f) == 1) {
+    std::string stored_key(header[3], '\0');
+    int bytes_per_pixel =
+        BytesPerPixel_(static_cast<TextureFormat>(dims[2]));
+    if (fread(stored_key.data(), stored_key.size(), 1, f) == 1
+        && stored_key == key && bytes_per_pixel > 0 && dims[0] > 0
+        && dims[1] > 0) {
+      entry->width = dims[0];
+      entry->height = dims[1];
+      entry->format = static_cast<TextureFormat>(dims[2]);
+      entry->pixels.resize(static_cast<size_t>(dims[0])
+                           * static_cast<size_t>(dims[1]) * bytes_per_pixel);
+      ok = fread(entry->pixels.data(), entry->pixels.size(), 1, f) == 1;
+    }
+  }
+  fclose(f);
+  return ok;
+}
+
+void GeneratedTextureCache::WriteToDisk_(const std::string& key,
+                                         const Entry_& entry) {
+  std::string path = DiskPath_(key);
+  if (!made_disk_cache_dir_) {
+    g_core->platform->MakeDir(g_core->platform->GetVolatileDataDirectory()
+                                  + BA_DIRSLASH + "textcache",
+                              true);
+    made_disk_cache_dir_ = true;
+  }
+
+  // Write to a temp file and move it into place so a reader never sees a
+  // partial file.
+  std::string tmp_path = path + ".tmp";
+  FILE* f = g_core->platform->FOpen(tmp_path.c_str(), "wb");
+  if (!f) {
+    return;
+  }
+  uint32_t header[4]{kGeneratedTextureCacheMagic,
+                     kGeneratedTextureCacheVersion,
+                     static_cast<uint32_t>(kEngineBuildNumber),
+                     static_cast<uint32_t>(key.size())};
+  int32_t dims[3]{entry.width, entry.height,
+                  static_cast<int32_t>(entry.format)};
+  bool ok = fwrite(header, sizeof(header), 1, f) == 1
+            && fwrite(dims, sizeof(dims), 1, f) == 1
+            && fwrite(key.data(), key.size(), 1, f) == 1
+            && fwrite(entry.pixels.data(), entry.pixels.size(), 1, f) == 1;
+  fclose(f);
+  if (!ok || g_core->platform->Rename(tmp_path.c_str(), path.c_str()) != 0) {
+    g_core->platform->Unlink(tmp_path.c_str());
+  }
+}
+
+}  // namespace ballistica::base
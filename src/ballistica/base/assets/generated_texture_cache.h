@@ -0,0 +1,72 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_GENERATED_TEXTURE_CACHE_H_
+#define BALLISTICA_BASE_ASSETS_GENERATED_TEXTURE_CACHE_H_
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Holds on to the pixels of textures we generate at runtime (text pages
+/// and qr codes) keyed by their content, so recreating an identical
+/// texture (after a prune, for another TextGroup, etc.) skips the
+/// rasterizing. Entries are dropped least-recently-used first once over
+/// budget. Text pages can also be persisted to disk so they survive
+/// across launches. Can be used from any thread.
+class GeneratedTextureCache {
+ public:
+  /// Max bytes of pixel data to keep in memory; 0 disables the cache.
+  void set_budget(size_t bytes);
+
+  /// Whether persistent entries are read from and written to disk.
+  void set_disk_cache_enabled(bool enabled);
+
+  /// If we've got pixels for key, fill out level 0 of data with a copy of
+  /// them and return true. Checks the disk cache too if persistent.
+  auto Find(const std::string& key, bool persistent,
+            TextureAssetPreloadData* data) -> bool;
+
+  /// Store a copy of level 0 of data under key (and write it to disk if
+  /// persistent). Data must be uncompressed.
+  void Store(const std::string& key, bool persistent,
+             const TextureAssetPreloadData& data);
+
+  auto size() -> size_t;
+  auto bytes() -> size_t;
+
+ private:
+  struct Entry_ {
+    std::vector<uint8_t> pixels;
+    int width{};
+    int height{};
+    TextureFormat format{TextureFormat::kNone};
+    std::list<std::string>::iterator lru_position;
+  };
+
+  static auto DiskPath_(const std::string& key) -> std::string;
+  auto ReadFromDisk_(const std::string& key, Entry_* entry) -> bool;
+  void WriteToDisk_(const std::string& key, const Entry_& entry);
+  void Insert_(const std::string& key, Entry_&& entry);
+  void Trim_();
+  static void Fill_(const Entry_& entry, TextureAssetPreloadData* data);
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry_> entries_;
+
+  // Most recently used at the front.
+  std::list<std::string> lru_;
+  size_t bytes_{};
+  size_t budget_{};
+  bool disk_cache_enabled_{};
+  bool made_disk_cache_dir_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_GENERATED_TEXTURE_CACHE_H_
@@ -2,10 +2,14 @@
 
 #include "ballistica/base/assets/mesh_asset.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/graphics/graphics_server.h"
 #include "ballistica/base/graphics/renderer/renderer.h"
@@ -14,10 +18,27 @@
 
 namespace ballistica::base {
 
-MeshAsset::MeshAsset(const std::string& file_name_in)
+const int kMaxMeshLODs{2};
+
+// How much of the screen's height a mesh must cover (at high quality) to
+// draw at each detail level; lower qualities switch down sooner.
+const float kMeshLODScreenSizes[kMaxMeshLODs]{0.15f, 0.06f};
+
+MeshAsset::MeshAsset(const std::string& file_name_in, bool find_lods)
     : file_name_(file_name_in) {
   file_name_full_ =
       g_base->assets->FindAssetFile(Assets::FileType::kMesh, file_name_in);
+  if (find_lods && !g_core->HeadlessMode()) {
+    for (int i = 1; i <= kMaxMeshLODs; ++i) {
+      std::string lod_name = file_name_in + "_lod" + std::to_string(i);
+      if (g_base->assets
+              ->FindAssetFile(Assets::FileType::kMesh, lod_name, false)
+              .empty()) {
+        break;
+      }
+      lods_.push_back(Object::New<MeshAsset>(lod_name, false));
+    }
+  }
   valid_ = true;
 }
 
@@ -32,9 +53,19 @@ void MeshAsset::DoPreload() {
 #if !BA_HEADLESS_BUILD
 
   assert(!file_name_.empty());
-  FILE* f = g_core->platform->FOpen(file_name_full_.c_str(), "rb");
-  if (!f) {
-    throw Exception("Can't open mesh file: '" + file_name_full_ + "'");
+
+  // Mesh files are laid out just as we hand them to the renderer (a 16
+  // byte header, vertices, then indices) so we use them right where they
+  // sit in memory instead of reading them into buffers of our own.
+  const uint8_t* data;
+  size_t size;
+  if (!g_base->assets->FindArchivedFile(file_name_full_, &data, &size)) {
+    mapped_file_ = MappedFile::Open(file_name_full_);
+    if (!mapped_file_) {
+      throw Exception("Can't open mesh file: '" + file_name_full_ + "'");
+    }
+    data = mapped_file_->data();
+    size = mapped_file_->size();
   }
 
   // We currently read/write in little-endian since that's all we run on at the
@@ -43,94 +74,150 @@ void MeshAsset::DoPreload() {
 #error FIX THIS FOR BIG ENDIAN
 #endif
 
-  uint32_t version;
-  if (fread(&version, sizeof(version), 1, f) != 1) {
+  uint32_t header[4];  // id, mesh-format, vertex-count, face-count
+  if (size < sizeof(header)) {
     throw Exception("Error reading file header for '" + file_name_full_ + "'");
   }
-  if (version != kBobFileID) {
+  memcpy(header, data, sizeof(header));
+  if (header[0] != kBobFileID) {
     throw Exception("File: '" + file_name_full_
                     + "' is an old format or not a bob file (got id "
-                    + std::to_string(version) + ", "
+                    + std::to_string(header[0]) + ", "
                     + std::to_string(kBobFileID) + ")");
   }
-
-  uint32_t mesh_format;
-  if (fread(&mesh_format, sizeof(mesh_format), 1, f) != 1) {
-    throw Exception("Error reading mesh_format for '" + file_name_full_ + "'");
-  }
-  format_ = static_cast<MeshFormat>(mesh_format);
+  format_ = static_cast<MeshFormat>(header[1]);
   BA_PRECONDITION((format_ == MeshFormat::kUV16N8Index8)
                   || (format_ == MeshFormat::kUV16N8Index16)
                   || (format_ == MeshFormat::kUV16N8Index32));
-
-  uint32_t vertex_count;
-  if (fread(&vertex_count, sizeof(vertex_count), 1, f) != 1) {
-    throw Exception("Error reading vertex_count for '" + file_name_full_ + "'");
-  }
-
-  uint32_t face_count;
-  if (fread(&face_count, sizeof(face_count), 1, f) != 1) {
-    throw Exception("Error reading face_count for '" + file_name_full_ + "'");
-  }
-
-  vertices_.resize(vertex_count);
-  if (fread(&(vertices_[0]), vertices_.size() * sizeof(VertexObjectFull), 1, f)
-      != 1) {
+  size_t vertex_count{header[2]};
+  size_t index_count{static_cast<size_t>(header[3]) * 3};
+  size_t vertices_size{vertex_count * sizeof(VertexObjectFull)};
+  size_t index_size{static_cast<size_t>(GetIndexSize())};
+  if (size - sizeof(header) < vertices_size + index_count * index_size) {
     throw Exception("Read failed for " + file_name_full_);
   }
-  switch (GetIndexSize()) {
-    case 1: {
-      indices8_.resize(face_count * 3);
-      if (fread(indices8_.data(), indices8_.size() * sizeof(uint8_t), 1, f)
-          != 1) {
-        throw Exception("Read failed for " + file_name_full_);
-      }
+  const uint8_t* body = data + sizeof(header);
+
+  // Archives and mappings keep things aligned, but play it safe.
+  if (reinterpret_cast<uintptr_t>(body) % alignof(VertexObjectFull) != 0) {
+    size_t body_size{vertices_size + index_count * index_size};
+    data_copy_.resize((body_size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+    memcpy(data_copy_.data(), body, body_size);
+    body = reinterpret_cast<const uint8_t*>(data_copy_.data());
+  }
+  vertices_ = {reinterpret_cast<const VertexObjectFull*>(body), vertex_count};
+  const uint8_t* index_data = body + vertices_size;
+  switch (index_size) {
+    case 1:
+      indices8_ = {index_data, index_count};
       break;
-    }
-    case 2: {
-      indices16_.resize(face_count * 3);
-      if (fread(indices16_.data(), indices16_.size() * sizeof(uint16_t), 1, f)
-          != 1) {
-        throw Exception("Read failed for " + file_name_full_);
-      }
+    case 2:
+      indices16_ = {reinterpret_cast<const uint16_t*>(index_data), index_count};
       break;
-    }
-    case 4: {
-      indices32_.resize(face_count * 3);
-      if (fread(indices32_.data(), indices32_.size() * sizeof(uint32_t), 1, f)
-          != 1) {
-        throw Exception("Read failed for " + file_name_full_);
-      }
+    case 4:
+      indices32_ = {reinterpret_cast<const uint32_t*>(index_data), index_count};
       break;
-    }
     default:
       throw Exception();
   }
 
-  fclose(f);
+  float radius_squared{};
+  for (auto&& vertex : vertices_) {
+    radius_squared = std::max(
+        radius_squared, vertex.position[0] * vertex.position[0]
+                            + vertex.position[1] * vertex.position[1]
+                            + vertex.position[2] * vertex.position[2]);
+  }
+  bounds_radius_ = sqrtf(radius_squared);
+
+  // Our CPU-side copies go away after load but the renderer holds the same.
+  size_t memory_cost = vertices_.size() * sizeof(vertices_[0])
+                       + indices8_.size() + indices16_.size() * sizeof(uint16_t)
+                       + indices32_.size() * sizeof(uint32_t);
+  for (auto&& lod : lods_) {
+    lod->DoPreload();
+    memory_cost += lod->GetMemoryCost();
+  }
+  set_memory_cost(memory_cost);
 
 #endif  // BA_HEADLESS_BUILD
 }
 
+auto MeshAsset::GetPendingLoadSize() const -> size_t {
+  if (!preloaded() || loaded()) {
+    return 0;
+  }
+  size_t size = vertices_.size() * sizeof(vertices_[0]) + indices8_.size()
+                + indices16_.size() * sizeof(uint16_t)
+                + indices32_.size() * sizeof(uint32_t);
+  for (auto&& lod : lods_) {
+    size += lod->vertices_.size() * sizeof(lod->vertices_[0])
+            + lod->indices8_.size() + lod->indices16_.size() * sizeof(uint16_t)
+            + lod->indices32_.size() * sizeof(uint32_t);
+  }
+  return size;
+}
+
 void MeshAsset::DoLoad() {
   assert(!renderer_data_.exists());
   renderer_data_ = g_base->graphics_server->renderer()->NewMeshAssetData(*this);
+  for (auto&& lod : lods_) {
+    lod->DoLoad();
+  }
+
+  // Once we're loaded we no longer need our file data.
+  ReleaseData_();
+}
 
-  // once we're loaded lets free up our vert data memory
-  std::vector<VertexObjectFull>().swap(vertices_);
-  std::vector<uint8_t>().swap(indices8_);
-  std::vector<uint16_t>().swap(indices16_);
-  std::vector<uint32_t>().swap(indices32_);
+void MeshAsset::ReleaseData_() {
+  vertices_ = {};
+  indices8_ = {};
+  indices16_ = {};
+  indices32_ = {};
+  mapped_file_.reset();
+  std::vector<uint32_t>().swap(data_copy_);
 }
 
 void MeshAsset::DoUnload() {
   assert(valid_);
   assert(renderer_data_.exists());
-  std::vector<VertexObjectFull>().swap(vertices_);
-  std::vector<uint8_t>().swap(indices8_);
-  std::vector<uint16_t>().swap(indices16_);
-  std::vector<uint32_t>().swap(indices32_);
+  ReleaseData_();
   renderer_data_.Clear();
+  for (auto&& lod : lods_) {
+    lod->ReleaseData_();
+    lod->renderer_data_.Clear();
+  }
+}
+
+auto MeshAsset::GetLODForTransform(const Matrix44f& model_view,
+                                   const Matrix44f& projection,
+                                   GraphicsQuality quality) const
+    -> const MeshAsset* {
+  // Only perspective projections shrink things with distance.
+  if (lods_.empty() || projection.m[11] != -1.0f) {
+    return this;
+  }
+  float distance = -model_view.m[14];
+  if (distance <= 0.0f) {
+    return this;
+  }
+  float scale = sqrtf(model_view.m[0] * model_view.m[0]
+                      + model_view.m[1] * model_view.m[1]
+                      + model_view.m[2] * model_view.m[2]);
+  float screen_size = bounds_radius_ * scale * projection.m[5] / distance;
+  if (quality <= GraphicsQuality::kLow) {
+    screen_size *= 0.5f;
+  } else if (quality == GraphicsQuality::kMedium) {
+    screen_size *= 0.7f;
+  }
+  const MeshAsset* mesh = this;
+  for (size_t i = 0; i < lods_.size(); ++i) {
+    if (screen_size >= kMeshLODScreenSizes[i]) {
+      break;
+    }
+    mesh = lods_[i].get();
+  }
+  return mesh;
 }
 
 }  // namespace ballistica::base
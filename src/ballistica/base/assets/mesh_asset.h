@@ -3,21 +3,28 @@
 #ifndef BALLISTICA_BASE_ASSETS_MESH_ASSET_H_
 #define BALLISTICA_BASE_ASSETS_MESH_ASSET_H_
 
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "ballistica/base/assets/asset.h"
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/base/assets/mesh_asset_renderer_data.h"
+#include "ballistica/shared/math/matrix44f.h"
 
 namespace ballistica::base {
 
 class MeshAsset : public Asset {
  public:
   MeshAsset() = default;
-  explicit MeshAsset(const std::string& file_name_in);
+  /// Any lower-detail variants of the mesh ('<name>_lod1', '<name>_lod2')
+  /// that exist are picked up too unless find_lods is false.
+  explicit MeshAsset(const std::string& file_name_in, bool find_lods = true);
   void DoPreload() override;
   void DoLoad() override;
   void DoUnload() override;
+  auto GetPendingLoadSize() const -> size_t override;
   auto GetAssetType() const -> AssetType override;
   auto GetName() const -> std::string override;
 
@@ -25,12 +32,26 @@ class MeshAsset : public Asset {
     assert(renderer_data_.exists());
     return renderer_data_.get();
   }
-  auto vertices() const -> const std::vector<VertexObjectFull>& {
+  /// Our vertex and index data; these point straight into the mesh file
+  /// as mapped into memory, and are only valid between preload and load.
+  auto vertices() const -> std::span<const VertexObjectFull> {
     return vertices_;
   }
-  auto indices8() const -> const std::vector<uint8_t>& { return indices8_; }
-  auto indices16() const -> const std::vector<uint16_t>& { return indices16_; }
-  auto indices32() const -> const std::vector<uint32_t>& { return indices32_; }
+  auto indices8() const -> std::span<const uint8_t> { return indices8_; }
+  auto indices16() const -> std::span<const uint16_t> { return indices16_; }
+  auto indices32() const -> std::span<const uint32_t> { return indices32_; }
+
+  /// Max distance of any vertex from the mesh origin.
+  auto bounds_radius() const { return bounds_radius_; }
+
+  /// Pick the variant of this mesh to draw with the given transforms; ie:
+  /// a lower-detail one when it covers only a small part of the screen.
+  /// Returns this mesh if we have no variants (or the projection isn't a
+  /// perspective one). Graphics context only.
+  auto GetLODForTransform(const Matrix44f& model_view,
+                          const Matrix44f& projection,
+                          GraphicsQuality quality) const -> const MeshAsset*;
+
   auto GetIndexSize() const -> int {
     switch (format_) {
       case MeshFormat::kUV16N8Index8:
@@ -45,14 +66,28 @@ class MeshAsset : public Asset {
   }
 
  private:
+  void ReleaseData_();
+
   Object::Ref<MeshAssetRendererData> renderer_data_;
   std::string file_name_;
   std::string file_name_full_;
   MeshFormat format_{};
-  std::vector<VertexObjectFull> vertices_;
-  std::vector<uint8_t> indices8_;
-  std::vector<uint16_t> indices16_;
-  std::vector<uint32_t> indices32_;
+
+  // Where our file lives while we hold data from it: a loose file we've
+  // mapped ourself (archived ones are mapped already), or a copy in the
+  // rare case the data isn't aligned for direct use.
+  std::unique_ptr<MappedFile> mapped_file_;
+  std::vector<uint32_t> data_copy_;
+  std::span<const VertexObjectFull> vertices_;
+  std::span<const uint8_t> indices8_;
+  std::span<const uint16_t> indices16_;
+  std::span<const uint32_t> indices32_;
+
+  // Lower-detail variants, most detailed first.
+  std::vector<Object::Ref<MeshAsset>> lods_;
+
+  // Max distance of any vertex from the mesh origin.
+  float bounds_radius_{};
   BA_DISALLOW_CLASS_COPIES(MeshAsset);
 };
 
@@ -0,0 +1,237 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/assets/replay_writer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/base/support/huffman.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/foundation/event_loop.h"
+
+namespace ballistica::base {
+
+// Size at which we write out our current block.
+const size_t kReplayBlockSize = 256 * 1024;
+
+// If our thread falls this far behind, we give up on the replay.
+const size_t kMaxPendingReplayBytes = 10000000;
+
+ReplayWriter::ReplayWriter() = default;
+
+void ReplayWriter::OnMainThreadStartApp() {
+  // Spin up our thread.
+  event_loop_ = new EventLoop(EventLoopID::kFileOut);
+  g_core->suspendable_event_loops.push_back(event_loop_);
+}
+
+void ReplayWriter::PushBeginWriteReplayCall(uint16_t protocol_version) {
+  event_loop()->PushCall(
+      [this, protocol_version] { BeginWriteReplay_(protocol_version); });
+}
+
+void ReplayWriter::PushAddMessageToReplayCall(
+    const std::vector<uint8_t>& data) {
+  pending_bytes_ += data.size();
+  event_loop()->PushCall([this, data] {
+    pending_bytes_ -= data.size();
+    AddMessage_(data);
+  });
+}
+
+void ReplayWriter::PushEndWriteReplayCall() {
+  event_loop()->PushCall([this] { EndWriteReplay_(); });
+}
+
+void ReplayWriter::BeginWriteReplay_(uint16_t protocol_version) {
+  assert(event_loop()->ThreadIsCurrent());
+  if (replays_broken_) {
+    return;
+  }
+
+  // We only allow writing one replay at once; make sure that's actually
+  // the case.
+  if (writing_replay_) {
+    g_core->Log(LogName::kBaAssets, LogLevel::kError,
+                "ReplayWriter got BeginWriteReplayCall while already writing");
+    WriteBlock_();
+    CloseFile_();
+    replays_broken_ = true;
+    return;
+  }
+  writing_replay_ = true;
+
+  std::string f_name = "__lastReplay";
+  assert(g_core);
+  std::string file_path =
+      g_core->platform->GetReplaysDir() + BA_DIRSLASH + f_name + ".brp";
+  out_file_ = g_core->platform->FOpen(file_path.c_str(), "wb");
+  bytes_written_ = 0;
+  block_.clear();
+  keyframes_.clear();
+
+  if (!out_file_) {
+    g_core->Log(LogName::kBa, LogLevel::kError,
+                "unable to open output-stream file: '" + file_path + "'");
+    return;
+  }
+
+  // We do our own buffering.
+  setvbuf(out_file_, nullptr, _IONBF, 0);
+
+  // Write file id and protocol-version.
+  // NOTE: We always write replays in our host protocol version
+  // no matter what the client stream is.
+  uint32_t file_id = kBrpFileIDIndexed;
+  uint16_t version = protocol_version;
+  block_.reserve(kReplayBlockSize + kReplayBlockSize / 4);
+  block_.resize(sizeof(file_id) + sizeof(version));
+  memcpy(block_.data(), &file_id, sizeof(file_id));
+  memcpy(block_.data() + sizeof(file_id), &version, sizeof(version));
+}
+
+void ReplayWriter::AddMessage_(const std::vector<uint8_t>& data) {
+  assert(event_loop()->ThreadIsCurrent());
+  assert(!data.empty());
+  if (replays_broken_) {
+    return;
+  }
+
+  // Sanity check.
+  if (!writing_replay_) {
+    g_core->Log(
+        LogName::kBa, LogLevel::kError,
+        "ReplayWriter got AddMessageToReplayCall while not writing replay");
+    replays_broken_ = true;
+    return;
+  }
+  if (!out_file_) {
+    return;
+  }
+
+  // If we've got too much data built up (lets go with 10 megs for now),
+  // abort.
+  if (pending_bytes_ > kMaxPendingReplayBytes) {
+    g_core->Log(LogName::kBa, LogLevel::kError,
+                "replay output buffer exceeded 10 megs; aborting replay");
+    CloseFile_();
+    return;
+  }
+
+  // Note where keyframes land so we can index them at the end.
+  if (data[0] == BA_MESSAGE_REPLAY_KEYFRAME && data.size() >= 9) {
+    int64_t base_time;
+    memcpy(&base_time, data.data() + 1, sizeof(base_time));
+    auto file_offset = static_cast<int64_t>(bytes_written_ + block_.size());
+    keyframes_.emplace_back(base_time, file_offset);
+  }
+
+  g_base->huffman->compress(data.data(), data.size(), &compress_buffer_);
+
+  // If message length is < 254, write length as one byte.
+  // If its between 254 and 65535, write 254 and then 2 length bytes
+  // otherwise write 255 and then 4 length bytes.
+  auto len32 = static_cast<uint32_t>(compress_buffer_.size());
+  size_t offset = block_.size();
+  if (len32 < 254) {
+    block_.resize(offset + 1 + len32);
+    block_[offset] = static_cast_check_fit<uint8_t>(len32);
+    offset += 1;
+  } else if (len32 <= 65535) {
+    auto len16 = static_cast_check_fit<uint16_t>(len32);
+    block_.resize(offset + 1 + sizeof(len16) + len32);
+    block_[offset] = 254;
+    memcpy(block_.data() + offset + 1, &len16, sizeof(len16));
+    offset += 1 + sizeof(len16);
+  } else {
+    block_.resize(offset + 1 + sizeof(len32) + len32);
+    block_[offset] = 255;
+    memcpy(block_.data() + offset + 1, &len32, sizeof(len32));
+    offset += 1 + sizeof(len32);
+  }
+  memcpy(block_.data() + offset, compress_buffer_.data(), len32);
+
+  if (block_.size() >= kReplayBlockSize) {
+    WriteBlock_();
+  }
+}
+
+void ReplayWriter::EndWriteReplay_() {
+  assert(event_loop()->ThreadIsCurrent());
+  if (replays_broken_) {
+    return;
+  }
+
+  // Sanity check.
+  if (!writing_replay_) {
+    g_core->Log(LogName::kBa, LogLevel::kError,
+                "_finishWritingReplay called while not writing");
+    replays_broken_ = true;
+    return;
+  }
+  if (out_file_) {
+    AppendIndex_();
+    WriteBlock_();
+  }
+
+  // Whether or not we actually have a file has no impact on our
+  // writing_replay_ status.
+  CloseFile_();
+  writing_replay_ = false;
+}
+
+void ReplayWriter::AppendIndex_() {
+  // A zero length marks the end of messages; the index follows.
+  auto index_offset =
+      static_cast<int64_t>(bytes_written_ + block_.size() + 1);
+  auto count = static_cast<uint32_t>(keyframes_.size());
+  uint32_t footer_id = kBrpIndexFooterID;
+  size_t offset = block_.size();
+  block_.resize(offset + 1 + sizeof(count)
+                + keyframes_.size() * sizeof(int64_t) * 2
+                + sizeof(index_offset) + sizeof(footer_id));
+  uint8_t* ptr = block_.data() + offset;
+  *ptr++ = 0;
+  memcpy(ptr, &count, sizeof(count));
+  ptr += sizeof(count);
+  for (auto&& keyframe : keyframes_) {
+    memcpy(ptr, &keyframe.first, sizeof(keyframe.first));
+    ptr += sizeof(keyframe.first);
+    memcpy(ptr, &keyframe.second, sizeof(keyframe.second));
+    ptr += sizeof(keyframe.second);
+  }
+  memcpy(ptr, &index_offset, sizeof(index_offset));
+  ptr += sizeof(index_offset);
+  memcpy(ptr, &footer_id, sizeof(footer_id));
+  keyframes_.clear();
+}
+
+void ReplayWriter::WriteBlock_() {
+  if (!out_file_ || block_.empty()) {
+    block_.clear();
+    return;
+  }
+  if (fwrite(block_.data(), block_.size(), 1, out_file_) != 1) {
+    g_core->Log(
+        LogName::kBaAssets, LogLevel::kError,
+        "Error writing replay file: " + g_core->platform->GetErrnoString());
+    CloseFile_();
+  } else {
+    bytes_written_ += block_.size();
+  }
+  block_.clear();
+}
+
+void ReplayWriter::CloseFile_() {
+  if (out_file_) {
+    fclose(out_file_);
+    out_file_ = nullptr;
+  }
+  block_.clear();
+  keyframes_.clear();
+}
+
+}  // namespace ballistica::base
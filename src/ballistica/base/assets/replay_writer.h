@@ -0,0 +1,54 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_REPLAY_WRITER_H_
+#define BALLISTICA_BASE_ASSETS_REPLAY_WRITER_H_
+
+#include <atomic>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Writes replay files in a thread of its own.
+///
+/// Messages are compressed as they arrive and accumulated into large
+/// blocks which go to disk with a single write each, so recording doesn't
+/// compete with asset loading or make lots of tiny writes.
+class ReplayWriter {
+ public:
+  ReplayWriter();
+  void OnMainThreadStartApp();
+  void PushBeginWriteReplayCall(uint16_t protocol_version);
+  void PushEndWriteReplayCall();
+  void PushAddMessageToReplayCall(const std::vector<uint8_t>& data);
+  auto event_loop() const -> EventLoop* { return event_loop_; }
+
+ private:
+  void BeginWriteReplay_(uint16_t protocol_version);
+  void EndWriteReplay_();
+  void AddMessage_(const std::vector<uint8_t>& data);
+  void AppendIndex_();
+  void WriteBlock_();
+  void CloseFile_();
+
+  EventLoop* event_loop_{};
+  FILE* out_file_{};
+  std::vector<uint8_t> block_;
+  std::vector<uint8_t> compress_buffer_;
+
+  // Base-times and file offsets of keyframes in the replay being written.
+  std::vector<std::pair<int64_t, int64_t>> keyframes_;
+  size_t bytes_written_{};
+
+  // Message bytes pushed to our thread but not yet handled there.
+  std::atomic<size_t> pending_bytes_{};
+  bool writing_replay_{};
+  bool replays_broken_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_REPLAY_WRITER_H_
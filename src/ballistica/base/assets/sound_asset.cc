@@ -4,7 +4,10 @@
 
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #if BA_ENABLE_AUDIO
@@ -15,6 +18,7 @@
 #endif
 #endif  // BA_ENABLE_AUDIO
 
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/audio/audio_server.h"
 #include "ballistica/base/python/base_python.h"
@@ -161,15 +165,15 @@ static auto LoadOgg(const char* file_name, std::vector<char>* buffer,
   return !fallback;
 }
 
-static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
-                          ALenum* format, ALsizei* freq) {
+void SoundAsset::LoadCachedOgg_() {
+  const char* file_name = file_name_full_.c_str();
   std::string sound_cache_dir =
       g_core->platform->GetVolatileDataDirectory() + BA_DIRSLASH + "audiocache";
-  static bool made_sound_cache_dir = false;
-  if (!made_sound_cache_dir) {
+  // Sounds can be preloaded from multiple threads at once.
+  static std::once_flag made_sound_cache_dir;
+  std::call_once(made_sound_cache_dir, [&sound_cache_dir] {
     g_core->platform->MakeDir(sound_cache_dir);
-    made_sound_cache_dir = true;
-  }
+  });
   std::vector<char> b(strlen(file_name) + 1);
   memcpy(b.data(), file_name, b.size());
   for (char* c = &b[0]; *c != 0; c++) {
@@ -177,50 +181,59 @@ static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
   }
   std::string cache_file_name = sound_cache_dir + "/" + &b[0] + ".cache";
 
-  // If we have a cache file and it matches the mod time on the ogg, attempt to
-  // load it.
+  // If we have a cache file and it matches the mod time on the ogg, map it
+  // in; its pcm goes straight from there to OpenAL when we load.
   struct BA_STAT stat_ogg{};
   time_t ogg_mod_time = 0;
   if (g_core->platform->Stat(file_name, &stat_ogg) == 0) {
     ogg_mod_time = stat_ogg.st_mtime;
   }
-  FILE* f_cache = g_core->platform->FOpen(cache_file_name.c_str(), "rb");
-  if (f_cache && ogg_mod_time != 0) {
-    bool got_cache = false;
-    time_t cache_mod_time;
-    if (fread(&cache_mod_time, sizeof(cache_mod_time), 1, f_cache) == 1) {
-      if (cache_mod_time == ogg_mod_time) {
-        if (fread(&(*format), sizeof((*format)), 1, f_cache) == 1) {
-          if (fread(&(*freq), sizeof((*freq)), 1, f_cache) == 1) {
-            uint32_t buffer_size;
-            if (fread(&buffer_size, sizeof(buffer_size), 1, f_cache) == 1) {
-              (*buffer).resize(buffer_size);
-              if (fread(&(*buffer)[0], buffer_size, 1, f_cache) == 1) {
-                got_cache = true;
-              }
-            }
-          }
-        }
+  if (ogg_mod_time != 0) {
+    if (auto cache = MappedFile::Open(cache_file_name)) {
+      // Layout: ogg mod time, format, freq, pcm size, pcm.
+      const size_t header_size =
+          sizeof(time_t) + sizeof(ALenum) + sizeof(ALsizei) + sizeof(uint32_t);
+      time_t cache_mod_time{};
+      ALenum format{};
+      ALsizei freq{};
+      uint32_t pcm_size{};
+      if (cache->size() >= header_size) {
+        const uint8_t* src = cache->data();
+        memcpy(&cache_mod_time, src, sizeof(cache_mod_time));
+        src += sizeof(cache_mod_time);
+        memcpy(&format, src, sizeof(format));
+        src += sizeof(format);
+        memcpy(&freq, src, sizeof(freq));
+        src += sizeof(freq);
+        memcpy(&pcm_size, src, sizeof(pcm_size));
       }
-    }
-    fclose(f_cache);
-    if (got_cache) {
-      // At a loss for how this happened, but wound up loading cache files
-      // with invalid formats of 0 once. Report and ignore if we see
-      // something like that.
-      if (*format != AL_FORMAT_MONO16 && *format != AL_FORMAT_STEREO16) {
-        g_core->Log(LogName::kBaAudio, LogLevel::kError,
-                    std::string("Ignoring invalid audio cache of ") + file_name
-                        + " with format " + std::to_string(*format));
-      } else {
-        return;  // SUCCESS!!!!
+      if (cache_mod_time == ogg_mod_time
+          && pcm_size <= cache->size() - header_size) {
+        // At a loss for how this happened, but wound up loading cache
+        // files with invalid formats of 0 once. Report and ignore if we
+        // see something like that.
+        if (format != AL_FORMAT_MONO16 && format != AL_FORMAT_STEREO16) {
+          g_core->Log(LogName::kBaAudio, LogLevel::kError,
+                      std::string("Ignoring invalid audio cache of ")
+                          + file_name + " with format "
+                          + std::to_string(format));
+        } else {
+          format_ = format;
+          freq_ = freq;
+          pcm_data_ = cache->data() + header_size;
+          pcm_size_ = pcm_size;
+          pcm_file_ = std::move(cache);
+          return;  // SUCCESS!!!!
+        }
       }
     }
   }
 
   // Ok that didn't work. Load the actual ogg.
-  (*buffer).clear();
-  bool success = LoadOgg(file_name, buffer, format, freq);
+  load_buffer_.clear();
+  bool success = LoadOgg(file_name, &load_buffer_, &format_, &freq_);
+  pcm_data_ = reinterpret_cast<const uint8_t*>(load_buffer_.data());
+  pcm_size_ = load_buffer_.size();
 
   // If the load went cleanly, attempt to write a cache file.
   if (success) {
@@ -228,11 +241,11 @@ static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
     bool success2 = false;
     if (f) {
       if (fwrite(&ogg_mod_time, sizeof(ogg_mod_time), 1, f) == 1) {
-        if (fwrite(&(*format), sizeof((*format)), 1, f) == 1) {
-          if (fwrite(&(*freq), sizeof((*freq)), 1, f) == 1) {
-            auto buffer_size = static_cast<uint32_t>((*buffer).size());
+        if (fwrite(&format_, sizeof(format_), 1, f) == 1) {
+          if (fwrite(&freq_, sizeof(freq_), 1, f) == 1) {
+            auto buffer_size = static_cast<uint32_t>(load_buffer_.size());
             if (fwrite(&buffer_size, sizeof(buffer_size), 1, f) == 1) {
-              if (fwrite(&(*buffer)[0], buffer_size, 1, f) == 1) {
+              if (fwrite(&load_buffer_[0], buffer_size, 1, f) == 1) {
                 success2 = true;
               }
             }
@@ -248,7 +261,6 @@ static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
     }
   }
 }
-
 #endif  // BA_ENABLE_AUDIO
 
 SoundAsset::SoundAsset(const std::string& file_name_in)
@@ -258,6 +270,8 @@ SoundAsset::SoundAsset(const std::string& file_name_in)
   valid_ = true;
 }
 
+SoundAsset::~SoundAsset() = default;
+
 auto SoundAsset::GetAssetType() const -> AssetType { return AssetType::kSound; }
 
 auto SoundAsset::GetName() const -> std::string {
@@ -274,7 +288,8 @@ void SoundAsset::DoPreload() {
     is_streamed_ = true;
   } else if (strstr(file_name_full_.c_str(), ".ogg")) {
     is_streamed_ = false;
-    LoadCachedOgg(file_name_full_.c_str(), &load_buffer_, &format_, &freq_);
+    LoadCachedOgg_();
+    set_memory_cost(pcm_size_);
   } else {
     throw Exception("Unsupported sound file (needs to end in .ogg): '"
                     + file_name_full_ + "'");
@@ -296,13 +311,17 @@ void SoundAsset::DoLoad() {
     alGenBuffers(1, &buffer_);
     CHECK_AL_ERROR;
 
-    // Preload pulled data into our load-buffer, and send that along to openal.
-    alBufferData(buffer_, format_, &load_buffer_[0],
-                 static_cast<ALsizei>(load_buffer_.size()), freq_);
+    // Preload pulled pcm into our load-buffer or mapped cache file; send
+    // that along to openal.
+    alBufferData(buffer_, format_, pcm_data_, static_cast<ALsizei>(pcm_size_),
+                 freq_);
 
     CHECK_AL_ERROR;
 
-    // Done with load buffer; clear its used memory.
+    // Done with our pcm; clear its used memory.
+    pcm_file_.reset();
+    pcm_data_ = nullptr;
+    pcm_size_ = 0;
     std::vector<char>().swap(load_buffer_);
   }
 
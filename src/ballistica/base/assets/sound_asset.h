@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_ASSETS_SOUND_ASSET_H_
 #define BALLISTICA_BASE_ASSETS_SOUND_ASSET_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,7 @@ class SoundAsset : public Asset {
  public:
   SoundAsset() = default;
   explicit SoundAsset(const std::string& file_name_in);
+  ~SoundAsset() override;
 
   void DoPreload() override;
   void DoLoad() override;
@@ -40,11 +42,19 @@ class SoundAsset : public Asset {
   std::string file_name_full_;
   bool is_streamed_{};
 #if BA_ENABLE_AUDIO
+  /// Decode our ogg (or map in its previously decoded pcm).
+  void LoadCachedOgg_();
+
   ALuint buffer_{};
   ALenum format_{};
   ALsizei freq_{};
 #endif  // BA_ENABLE_AUDIO
+  // Pcm waiting to go to OpenAL; points into either our load-buffer or
+  // our mapped cache file.
   std::vector<char> load_buffer_;
+  std::unique_ptr<MappedFile> pcm_file_;
+  const uint8_t* pcm_data_{};
+  size_t pcm_size_{};
   millisecs_t last_play_time_{};
 };
 
@@ -10,6 +10,8 @@
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/assets/assets.h"
+#include "ballistica/base/assets/assets_server.h"
+#include "ballistica/base/assets/generated_texture_cache.h"
 #include "ballistica/base/assets/texture_asset_preload_data.h"
 #include "ballistica/base/assets/texture_asset_renderer_data.h"
 #include "ballistica/base/graphics/graphics.h"
@@ -18,6 +20,8 @@
 #include "ballistica/base/graphics/text/text_packer.h"
 #include "ballistica/base/graphics/texture/dds.h"
 #include "ballistica/base/graphics/texture/ktx.h"
+#include "ballistica/base/graphics/texture/ktx2.h"
+#include "ballistica/base/graphics/texture/lz4tex.h"
 #include "ballistica/base/graphics/texture/pvr.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "external/qr_code_generator/QrCode.hpp"
@@ -48,6 +52,74 @@ static void Rgba8888UnpremultiplyInPlace_(uint8_t* src, size_t cb) {
   }
 }
 
+// Don't bother streaming textures with fewer levels than this beyond the
+// ones we'd skip; they're small enough to just load fully.
+const int kTextureStreamMinLevels = 5;
+
+static auto IsCompressedFormat_(TextureFormat format) -> bool {
+  switch (format) {
+    case TextureFormat::kDXT1:
+    case TextureFormat::kDXT5:
+    case TextureFormat::kETC1:
+    case TextureFormat::kETC2_RGB:
+    case TextureFormat::kETC2_RGBA:
+    case TextureFormat::kPVR2:
+    case TextureFormat::kPVR4:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Number of consecutive levels available starting at the base level.
+static auto CountLevels_(const TextureAssetPreloadData& data) -> int {
+  int count{};
+  for (int i = data.base_level; i < kMaxTextureLevels && data.buffers[i];
+       ++i) {
+    count++;
+  }
+  return count;
+}
+
+// Free everything finer than level and make it the new base level.
+static void DropTopLevels_(TextureAssetPreloadData* data, int level) {
+  for (int i = 0; i < level && i < kMaxTextureLevels; ++i) {
+    if (data->buffers[i]) {
+      free(data->buffers[i]);
+      data->buffers[i] = nullptr;
+    }
+  }
+  data->base_level = std::max(data->base_level, level);
+}
+
+static auto EstimateResidentBytes_(const TextureAssetPreloadData& data)
+    -> size_t {
+  int base = data.base_level;
+  if (!data.buffers[base]) {
+    return 0;
+  }
+  size_t pixels = static_cast<size_t>(data.widths[base])
+                  * static_cast<size_t>(data.heights[base]);
+  switch (data.formats[base]) {
+    // Uncompressed stuff gets the rest of its mips generated on the gpu,
+    // which adds about a third.
+    case TextureFormat::kRGBA_8888:
+      return pixels * 4 * 4 / 3;
+    case TextureFormat::kRGB_888:
+      return pixels * 3 * 4 / 3;
+    case TextureFormat::kRGBA_4444:
+    case TextureFormat::kRGB_565:
+      return pixels * 2 * 4 / 3;
+    default: {
+      size_t size{};
+      for (int i = base; i < kMaxTextureLevels && data.buffers[i]; ++i) {
+        size += data.sizes[i];
+      }
+      return size;
+    }
+  }
+}
+
 TextureAsset::TextureAsset() = default;
 
 TextureAsset::TextureAsset(const std::string& file_in, TextureType type_in,
@@ -115,6 +187,17 @@ void TextureAsset::DoPreload() {
   if (packer_.exists()) {
     assert(type_ == TextureType::k2D);
 
+    // Identical text at the same quality rasterizes identically, so
+    // reuse recent results (or ones from previous runs) when we can.
+    std::string cache_key =
+        "t" + std::to_string(static_cast<int>(texture_quality)) + ":"
+        + packer_->hash();
+    preload_datas_.resize(1);
+    if (g_base->assets->generated_textures()->Find(cache_key, true,
+                                                   &preload_datas_[0])) {
+      return;
+    }
+
     int width = packer_->texture_width();
     int height = packer_->texture_height();
     float quality_scale = 1.0f;
@@ -159,7 +242,6 @@ void TextureAsset::DoPreload() {
     // even just alpha if there's no non-white colors present.
     // NOTE: This data is also coming in premultiplied (on apple at least) so we
     // need to take care of that.
-    preload_datas_.resize(1);
     assert(width >= 0 && height >= 0);
     size_t buffer_size =
         static_cast<size_t>(width) * static_cast<size_t>(height) * 4u;
@@ -177,15 +259,22 @@ void TextureAsset::DoPreload() {
     // Downsample this down to rgba4444 in-place.
     TextureAssetPreloadData::rgba8888_to_rgba4444_in_place(buffer, buffer_size);
     preload_datas_[0].formats[0] = TextureFormat::kRGBA_4444;
+    g_base->assets->generated_textures()->Store(cache_key, true,
+                                                preload_datas_[0]);
 
   } else if (is_qr_code_) {
+    std::string cache_key = "q:" + file_name_;
+    preload_datas_.resize(1);
+    if (g_base->assets->generated_textures()->Find(cache_key, false,
+                                                   &preload_datas_[0])) {
+      return;
+    }
     const qrcodegen::QrCode qr2{qrcodegen::QrCode::encodeText(
         file_name_.c_str(), qrcodegen::QrCode::Ecc::HIGH)};
     int qr_size = qr2.getSize();
 
     int width = 512;
     int height = 512;
-    preload_datas_.resize(1);
     assert(width >= 0 && height >= 0);
     size_t buffer_size =
         static_cast<size_t>(width) * static_cast<size_t>(height) * 2u;
@@ -212,108 +301,13 @@ void TextureAsset::DoPreload() {
     preload_datas_[0].heights[0] = height;
     preload_datas_[0].formats[0] = TextureFormat::kRGB_565;
     preload_datas_[0].base_level = 0;
+    g_base->assets->generated_textures()->Store(cache_key, false,
+                                                preload_datas_[0]);
   } else {
     if (type_ == TextureType::k2D) {
       preload_datas_.resize(1);
-
-      int file_name_size = static_cast<int>(file_name_full_.size());
-      BA_PRECONDITION(file_name_size > 4);
-
-      // Etc1 or dxt3 for non-alpha and dxt5 for alpha (.android_dds files).
-      if (file_name_size > 12
-          && !strcmp(file_name_full_.c_str() + file_name_size - 12,
-                     ".android_dds")) {
-        LoadDDS(file_name_full_, preload_datas_[0].buffers,
-                preload_datas_[0].widths, preload_datas_[0].heights,
-                preload_datas_[0].formats, preload_datas_[0].sizes,
-                texture_quality, static_cast<uint8_t>(min_quality_),
-                &preload_datas_[0].base_level);
-
-        // We should only be loading this if we support etc1 in hardware.
-        assert(g_base->graphics->placeholder_client_context()
-                   ->SupportsTextureCompressionType(
-                       TextureCompressionType::kETC1));
-
-        // Decompress dxt1/dxt5 ones if we don't natively support S3TC.
-        if (!g_base->graphics->placeholder_client_context()
-                 ->SupportsTextureCompressionType(
-                     TextureCompressionType::kS3TC)) {
-          if ((preload_datas_[0].formats[preload_datas_[0].base_level]
-               == TextureFormat::kDXT5)
-              || (preload_datas_[0].formats[preload_datas_[0].base_level]
-                  == TextureFormat::kDXT1)) {
-            preload_datas_[0].ConvertToUncompressed(this);
-          }
-        }
-      } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4,
-                         ".dds")) {
-        // Dxt1 for non-alpha and dxt5 for alpha (.dds files).
-        LoadDDS(file_name_full_, preload_datas_[0].buffers,
-                preload_datas_[0].widths, preload_datas_[0].heights,
-                preload_datas_[0].formats, preload_datas_[0].sizes,
-                texture_quality, static_cast<int>(min_quality_),
-                &preload_datas_[0].base_level);
-
-        // Decompress dxt1/dxt5 if we don't natively support it.
-        if (!g_base->graphics->placeholder_client_context()
-                 ->SupportsTextureCompressionType(
-                     TextureCompressionType::kS3TC)) {
-          preload_datas_[0].ConvertToUncompressed(this);
-        }
-      } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4,
-                         ".ktx")) {
-        // Etc2 or etc1 for non-alpha and etc2 for alpha (.ktx files).
-        try {
-          LoadKTX(file_name_full_, preload_datas_[0].buffers,
-                  preload_datas_[0].widths, preload_datas_[0].heights,
-                  preload_datas_[0].formats, preload_datas_[0].sizes,
-                  texture_quality, static_cast<uint8_t>(min_quality_),
-                  &preload_datas_[0].base_level);
-        } catch (const std::exception& e) {
-          throw Exception("Error loading file '" + file_name_full_
-                          + "': " + e.what());
-        }
-
-        // Decompress etc2 if we don't natively support it.
-        if (((preload_datas_[0].formats[preload_datas_[0].base_level]
-              == TextureFormat::kETC2_RGB)
-             || (preload_datas_[0].formats[preload_datas_[0].base_level]
-                 == TextureFormat::kETC2_RGBA))
-            && (!g_base->graphics->placeholder_client_context()
-                     ->SupportsTextureCompressionType(
-                         TextureCompressionType::kETC2))) {
-          preload_datas_[0].ConvertToUncompressed(this);
-        }
-
-        // Decompress etc1 if we don't natively support it.
-        if ((preload_datas_[0].formats[preload_datas_[0].base_level]
-             == TextureFormat::kETC1)
-            && (!g_base->graphics->placeholder_client_context()
-                     ->SupportsTextureCompressionType(
-                         TextureCompressionType::kETC1))) {
-          preload_datas_[0].ConvertToUncompressed(this);
-        }
-
-      } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4,
-                         ".pvr")) {
-        // Pvr for all (.pvr files).
-        LoadPVR(file_name_full_, preload_datas_[0].buffers,
-                preload_datas_[0].widths, preload_datas_[0].heights,
-                preload_datas_[0].formats, preload_datas_[0].sizes,
-                texture_quality, static_cast<uint8_t>(min_quality_),
-                &preload_datas_[0].base_level);
-
-        // We should only be loading this if we support pvr in hardware.
-        assert(
-            g_base->graphics->placeholder_client_context()
-                ->SupportsTextureCompressionType(TextureCompressionType::kPVR));
-      } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4,
-                         ".nop")) {
-        // Dummy path for headless; nothing to do here.
-      } else {
-        throw Exception("Invalid texture file name: '" + file_name_full_ + "'");
-      }
-
+      Preload2DFile_(&preload_datas_[0], texture_quality);
+      SetUpStreaming_(&preload_datas_[0]);
     } else if (type_ == TextureType::kCubeMap) {
       preload_datas_.resize(6);
       std::string name;
@@ -390,6 +384,30 @@ void TextureAsset::DoPreload() {
                        TextureCompressionType::kS3TC)) {
             preload_datas_[d].ConvertToUncompressed(this);
           }
+        } else if (file_name_size > 7
+                   && !strcmp(file_name_full_.c_str() + file_name_size - 7,
+                              ".lz4tex")) {
+          // Uncompressed pixels in lz4 blocks (.lz4tex files); cube maps
+          // keep their full bit depth.
+          LoadLZ4Tex(name, preload_datas_[d].buffers, preload_datas_[d].widths,
+                     preload_datas_[d].heights, preload_datas_[d].formats,
+                     preload_datas_[d].sizes, texture_quality,
+                     static_cast<uint8_t>(min_quality_), false,
+                     &preload_datas_[d].base_level);
+        } else if (file_name_size > 5
+                   && !strcmp(file_name_full_.c_str() + file_name_size - 5,
+                              ".ktx2")) {
+          // Any format (.ktx2 files); convert if the gpu can't take it.
+          try {
+            LoadKTX2(name, preload_datas_[d].buffers, preload_datas_[d].widths,
+                     preload_datas_[d].heights, preload_datas_[d].formats,
+                     preload_datas_[d].sizes, texture_quality,
+                     static_cast<uint8_t>(min_quality_),
+                     &preload_datas_[d].base_level);
+          } catch (const std::exception& e) {
+            throw Exception("Error loading file '" + name + "': " + e.what());
+          }
+          preload_datas_[d].ConvertToSupported(this);
         } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4,
                            ".ktx")) {
           // Etc2 or etc1 for non-alpha and etc2 for alpha (.ktx files)
@@ -446,6 +464,209 @@ void TextureAsset::DoPreload() {
   }
 }
 
+void TextureAsset::Preload2DFile_(TextureAssetPreloadData* data,
+                                  TextureQuality texture_quality) {
+  int file_name_size = static_cast<int>(file_name_full_.size());
+  BA_PRECONDITION(file_name_size > 4);
+  auto* client_context = g_base->graphics->placeholder_client_context();
+
+  // Etc1 or dxt3 for non-alpha and dxt5 for alpha (.android_dds files).
+  if (file_name_size > 12
+      && !strcmp(file_name_full_.c_str() + file_name_size - 12,
+                 ".android_dds")) {
+    LoadDDS(file_name_full_, data->buffers, data->widths, data->heights,
+            data->formats, data->sizes, texture_quality,
+            static_cast<uint8_t>(min_quality_), &data->base_level);
+
+    // We should only be loading this if we support etc1 in hardware.
+    assert(client_context->SupportsTextureCompressionType(
+        TextureCompressionType::kETC1));
+
+    // Decompress dxt1/dxt5 ones if we don't natively support S3TC.
+    if (!client_context->SupportsTextureCompressionType(
+            TextureCompressionType::kS3TC)) {
+      if ((data->formats[data->base_level] == TextureFormat::kDXT5)
+          || (data->formats[data->base_level] == TextureFormat::kDXT1)) {
+        data->ConvertToUncompressed(this);
+      }
+    }
+  } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4, ".dds")) {
+    // Dxt1 for non-alpha and dxt5 for alpha (.dds files).
+    LoadDDS(file_name_full_, data->buffers, data->widths, data->heights,
+            data->formats, data->sizes, texture_quality,
+            static_cast<int>(min_quality_), &data->base_level);
+
+    // Decompress dxt1/dxt5 if we don't natively support it.
+    if (!client_context->SupportsTextureCompressionType(
+            TextureCompressionType::kS3TC)) {
+      data->ConvertToUncompressed(this);
+    }
+  } else if (file_name_size > 7
+             && !strcmp(file_name_full_.c_str() + file_name_size - 7,
+                        ".lz4tex")) {
+    // Uncompressed pixels in lz4 blocks (.lz4tex files); reduced to 16 bit
+    // as they're decoded, same as textures we decompress.
+    LoadLZ4Tex(file_name_full_, data->buffers, data->widths, data->heights,
+               data->formats, data->sizes, texture_quality,
+               static_cast<uint8_t>(min_quality_), true, &data->base_level);
+  } else if (file_name_size > 5
+             && !strcmp(file_name_full_.c_str() + file_name_size - 5,
+                        ".ktx2")) {
+    // Any format (.ktx2 files); convert if the gpu can't take it.
+    try {
+      LoadKTX2(file_name_full_, data->buffers, data->widths, data->heights,
+               data->formats, data->sizes, texture_quality,
+               static_cast<uint8_t>(min_quality_), &data->base_level);
+    } catch (const std::exception& e) {
+      throw Exception("Error loading file '" + file_name_full_
+                      + "': " + e.what());
+    }
+    data->ConvertToSupported(this);
+  } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4, ".ktx")) {
+    // Etc2 or etc1 for non-alpha and etc2 for alpha (.ktx files).
+    try {
+      LoadKTX(file_name_full_, data->buffers, data->widths, data->heights,
+              data->formats, data->sizes, texture_quality,
+              static_cast<uint8_t>(min_quality_), &data->base_level);
+    } catch (const std::exception& e) {
+      throw Exception("Error loading file '" + file_name_full_
+                      + "': " + e.what());
+    }
+
+    // Decompress etc2 if we don't natively support it.
+    if (((data->formats[data->base_level] == TextureFormat::kETC2_RGB)
+         || (data->formats[data->base_level] == TextureFormat::kETC2_RGBA))
+        && (!client_context->SupportsTextureCompressionType(
+            TextureCompressionType::kETC2))) {
+      data->ConvertToUncompressed(this);
+    }
+
+    // Decompress etc1 if we don't natively support it.
+    if ((data->formats[data->base_level] == TextureFormat::kETC1)
+        && (!client_context->SupportsTextureCompressionType(
+            TextureCompressionType::kETC1))) {
+      data->ConvertToUncompressed(this);
+    }
+
+  } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4, ".pvr")) {
+    // Pvr for all (.pvr files).
+    LoadPVR(file_name_full_, data->buffers, data->widths, data->heights,
+            data->formats, data->sizes, texture_quality,
+            static_cast<uint8_t>(min_quality_), &data->base_level);
+
+    // We should only be loading this if we support pvr in hardware.
+    assert(client_context->SupportsTextureCompressionType(
+        TextureCompressionType::kPVR));
+  } else if (!strcmp(file_name_full_.c_str() + file_name_size - 4, ".nop")) {
+    // Dummy path for headless; nothing to do here.
+  } else {
+    throw Exception("Invalid texture file name: '" + file_name_full_ + "'");
+  }
+}
+
+void TextureAsset::SetUpStreaming_(TextureAssetPreloadData* data) {
+  // Only compressed textures that came with their full mip chain can
+  // stream; uncompressed ones get their mips generated on the gpu from
+  // the top level.
+  full_level_ = data->base_level;
+  streamable_ =
+      IsCompressedFormat_(data->formats[data->base_level])
+      && CountLevels_(*data) >= kStreamSkipLevels + kTextureStreamMinLevels;
+
+  // Start out with just the lower levels; the top ones come in once we
+  // are actually drawn.
+  if (streamable_) {
+    DropTopLevels_(data, data->base_level + kStreamSkipLevels);
+  }
+  resident_level_ = data->base_level;
+}
+
+void TextureAsset::RequestResidentLevel(int level) {
+  assert(g_base->InLogicThread());
+  assert(streamable_ && !streaming_);
+  streaming_ = true;
+  stream_level_ = level;
+
+  // Like regular loads, this reference rides along through the assets and
+  // graphics threads and comes back to the logic thread to die.
+  g_base->assets_server->PushPendingTextureStream(new Object::Ref<Asset>(this));
+}
+
+void TextureAsset::PreloadStream() {
+  assert(g_base->InAssetsThread());
+  LockGuard lock(this);
+  assert(!stream_preload_data_);
+  auto data = std::make_unique<TextureAssetPreloadData>();
+  try {
+    Preload2DFile_(data.get(), g_base->graphics->placeholder_texture_quality());
+  } catch (const std::exception& e) {
+    g_core->Log(LogName::kBaAssets, LogLevel::kWarning,
+                "Error streaming texture '" + file_name_full_
+                    + "': " + e.what());
+    return;
+  }
+
+  // If the file got converted to something we can't stream (say the
+  // renderer changed out from under us), just leave things as they are.
+  if (!IsCompressedFormat_(data->formats[data->base_level])) {
+    return;
+  }
+  DropTopLevels_(data.get(), stream_level_);
+  if (!data->buffers[data->base_level]) {
+    return;
+  }
+  stream_preload_data_ = std::move(data);
+}
+
+auto TextureAsset::GetPendingStreamSize() const -> size_t {
+  return stream_preload_data_ ? EstimateResidentBytes_(*stream_preload_data_)
+                              : 0;
+}
+
+void TextureAsset::LoadStream() {
+  assert(g_base->app_adapter->InGraphicsContext());
+  LockGuard lock(this);
+  auto data = std::move(stream_preload_data_);
+
+  // We may have been unloaded while this was in flight; in that case the
+  // next regular load will pick things up.
+  if (data && loaded() && renderer_data_.exists()) {
+    // Renderers build from our preload data, so slot the streamed data in
+    // there for the duration.
+    assert(preload_datas_.empty());
+    preload_datas_.resize(1);
+    auto& preload_data{preload_datas_[0]};
+    std::swap(preload_data.buffers, data->buffers);
+    std::swap(preload_data.sizes, data->sizes);
+    std::swap(preload_data.formats, data->formats);
+    std::swap(preload_data.widths, data->widths);
+    std::swap(preload_data.heights, data->heights);
+    std::swap(preload_data.base_level, data->base_level);
+
+    auto renderer_data =
+        g_base->graphics_server->renderer()->NewTextureData(*this);
+    renderer_data->Load();
+    renderer_data_ = renderer_data;
+    resident_level_ = preload_data.base_level;
+    resident_bytes_ = EstimateResidentBytes_(preload_data);
+    preload_datas_.clear();
+  }
+  streaming_ = false;
+}
+
+auto TextureAsset::GetPendingLoadSize() const -> size_t {
+  if (!preloaded() || loaded()) {
+    return 0;
+  }
+  size_t size{};
+  for (auto&& preload_data : preload_datas_) {
+    for (int i = preload_data.base_level; i < kMaxTextureLevels; ++i) {
+      size += preload_data.sizes[i];
+    }
+  }
+  return size;
+}
+
 void TextureAsset::DoLoad() {
   assert(g_base->app_adapter->InGraphicsContext());
   assert(!renderer_data_.exists());
@@ -456,7 +677,12 @@ void TextureAsset::DoLoad() {
   // Store our base-level from the preload-data so we know if we're lower than
   // full quality.
   assert(!preload_datas_.empty());
-  base_level_ = preload_datas_[0].base_level;
+  base_level_ = streamable_ ? full_level_.load() : preload_datas_[0].base_level;
+  size_t resident_bytes{};
+  for (auto&& preload_data : preload_datas_) {
+    resident_bytes += EstimateResidentBytes_(preload_data);
+  }
+  resident_bytes_ = resident_bytes;
 
   // If we're done, kill our preload data.
   preload_datas_.clear();
@@ -468,6 +694,7 @@ void TextureAsset::DoUnload() {
   assert(renderer_data_.exists());
   renderer_data_.Clear();
   base_level_ = 0;
+  resident_bytes_ = 0;
 }
 
 }  // namespace ballistica::base
@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_BASE_ASSETS_TEXTURE_ASSET_H_
 #define BALLISTICA_BASE_ASSETS_TEXTURE_ASSET_H_
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,6 +15,11 @@ namespace ballistica::base {
 // A lovely texture asset.
 class TextureAsset : public Asset {
  public:
+  /// Top mip levels held back from the initial load of streamable
+  /// textures (and dropped again when evicting). Each level is roughly
+  /// 3/4 of a texture's memory.
+  static constexpr int kStreamSkipLevels = 2;
+
   TextureAsset();
   ~TextureAsset() override;
 
@@ -29,11 +36,18 @@ class TextureAsset : public Asset {
   void DoPreload() override;
   void DoLoad() override;
   void DoUnload() override;
+  auto GetPendingLoadSize() const -> size_t override;
 
   auto file_name() const -> const std::string& { return file_name_; }
   auto file_name_full() const -> const std::string& { return file_name_full_; }
   auto texture_type() const -> TextureType { return type_; }
   auto is_qr_code() const -> bool { return is_qr_code_; }
+
+  // Text textures are rendered through platform text APIs which we can't
+  // assume are safe to use from multiple threads.
+  auto CanPreloadConcurrently() const -> bool override {
+    return !packer_.exists();
+  }
   auto preload_datas() const -> const std::vector<TextureAssetPreloadData>& {
     return preload_datas_;
   }
@@ -43,7 +57,42 @@ class TextureAsset : public Asset {
   }
   auto base_level() const -> int { return base_level_; }
 
+  /// Whether this texture's top mip levels can be streamed in and out
+  /// after its initial load. Only meaningful once loaded.
+  auto streamable() const -> bool { return streamable_; }
+
+  /// Finest mip level (in file terms) currently on the GPU.
+  auto resident_level() const -> int { return resident_level_; }
+
+  /// Finest mip level we'd show at the current texture quality.
+  auto full_level() const -> int { return full_level_; }
+
+  /// Rough GPU memory currently used by this texture.
+  auto resident_bytes() const -> size_t { return resident_bytes_; }
+  auto GetMemoryCost() const -> size_t override { return resident_bytes_; }
+
+  /// Whether a resident-level change is in flight.
+  auto streaming() const -> bool { return streaming_; }
+
+  /// Kick off an asynchronous reload of this texture with the provided
+  /// finest mip level. The file is read on the assets thread and swapped
+  /// in by the graphics thread. Logic thread only.
+  void RequestResidentLevel(int level);
+
+  /// Assets-thread half of a resident-level change.
+  void PreloadStream();
+
+  /// Graphics-thread half of a resident-level change.
+  void LoadStream();
+
+  /// Rough number of bytes a pending LoadStream() will push to the GPU.
+  auto GetPendingStreamSize() const -> size_t;
+
  private:
+  void Preload2DFile_(TextureAssetPreloadData* data,
+                      TextureQuality texture_quality);
+  void SetUpStreaming_(TextureAssetPreloadData* data);
+
   Object::Ref<TextPacker> packer_;
   bool is_qr_code_{};
   std::string file_name_;
@@ -53,6 +102,13 @@ class TextureAsset : public Asset {
   TextureMinQuality min_quality_{TextureMinQuality::kLow};
   Object::Ref<TextureAssetRendererData> renderer_data_;
   int base_level_{};
+  int stream_level_{};
+  std::unique_ptr<TextureAssetPreloadData> stream_preload_data_;
+  std::atomic<int> resident_level_{};
+  std::atomic<int> full_level_{};
+  std::atomic<size_t> resident_bytes_{};
+  std::atomic<bool> streamable_{};
+  std::atomic<bool> streaming_{};
 };
 
 }  // namespace ballistica::base
@@ -6,6 +6,8 @@
 #include <cstring>
 
 #include "ballistica/base/assets/texture_asset.h"
+#include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/support/graphics_client_context.h"
 #include "ballistica/base/graphics/texture/ktx.h"
 
 namespace ballistica::base {
@@ -91,7 +93,8 @@ static void rgba8888_to_rgb888_in_place(void* src, int cb) {
   }
 }
 
-static void rgb888_to_rgb565_in_place(void* src, size_t cb) {
+void TextureAssetPreloadData::rgb888_to_rgb565_in_place(void* src,
+                                                        size_t cb) {
   // compute the actual number of pixel elements in the buffer.
   size_t cpel = cb / 3;
   auto* psrc = static_cast<uint8_t*>(src);
@@ -565,6 +568,38 @@ void TextureAssetPreloadData::ConvertToUncompressed(TextureAsset* texture) {
   }
 }
 
+void TextureAssetPreloadData::ConvertToSupported(TextureAsset* texture) {
+  auto* context = g_base->graphics->placeholder_client_context();
+  bool supported;
+  switch (formats[base_level]) {
+    case TextureFormat::kDXT1:
+    case TextureFormat::kDXT5:
+      supported = context->SupportsTextureCompressionType(
+          TextureCompressionType::kS3TC);
+      break;
+    case TextureFormat::kETC1:
+      supported = context->SupportsTextureCompressionType(
+          TextureCompressionType::kETC1);
+      break;
+    case TextureFormat::kETC2_RGB:
+    case TextureFormat::kETC2_RGBA:
+      supported = context->SupportsTextureCompressionType(
+          TextureCompressionType::kETC2);
+      break;
+    case TextureFormat::kPVR2:
+    case TextureFormat::kPVR4:
+      supported = context->SupportsTextureCompressionType(
+          TextureCompressionType::kPVR);
+      break;
+    default:
+      supported = true;
+      break;
+  }
+  if (!supported) {
+    ConvertToUncompressed(texture);
+  }
+}
+
 TextureAssetPreloadData::~TextureAssetPreloadData() {
   for (auto& buffer : buffers) {
     if (buffer) {
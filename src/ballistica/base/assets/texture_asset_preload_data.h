@@ -17,6 +17,7 @@ const int kMaxTextureLevels = 14;
 class TextureAssetPreloadData {
  public:
   static void rgba8888_to_rgba4444_in_place(void* src, size_t cb);
+  static void rgb888_to_rgb565_in_place(void* src, size_t cb);
 
   TextureAssetPreloadData() {
     // There isn't a way to do this in bracket-init, is there?
@@ -28,6 +29,11 @@ class TextureAssetPreloadData {
   ~TextureAssetPreloadData();
   void ConvertToUncompressed(TextureAsset* texture);
 
+  /// Convert to uncompressed if our GPU can't handle the loaded
+  /// compression format directly. For loaders such as KTX2 whose output
+  /// format isn't known until the file is read.
+  void ConvertToSupported(TextureAsset* texture);
+
   uint8_t* buffers[kMaxTextureLevels]{};
   size_t sizes[kMaxTextureLevels]{};
   TextureFormat formats[kMaxTextureLevels]{};
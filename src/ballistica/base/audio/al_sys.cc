@@ -27,6 +27,7 @@ void _check_al_error(const char* file, int line) {
     g_core->Log(LogName::kBaAudio, LogLevel::kError,
                 Utils::BaseName(file) + ":" + std::to_string(line)
                     + ": OpenAL Error: " + GetALErrorString(al_err) + ";");
+    g_base->audio_server->OnALError();
   }
 }
 
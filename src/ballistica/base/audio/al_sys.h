@@ -37,6 +37,9 @@ namespace ballistica::base {
 const int kAudioStreamBufferSize = 4096 * 8;
 const int kAudioStreamBufferCount = 7;
 
+// How many buffers' worth of pcm streamers decode ahead off-thread.
+const int kAudioStreamDecodeAheadCount = 4;
+
 // Some OpenAL Error handling utils.
 auto GetALErrorString(ALenum err) -> const char*;
 
@@ -9,7 +9,6 @@
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/support/app_config.h"
 #include "ballistica/core/platform/core_platform.h"  // IWYU pragma: keep.
-#include "ballistica/shared/foundation/event_loop.h"
 
 namespace ballistica::base {
 
@@ -45,10 +44,17 @@ void Audio::OnAppShutdownComplete() { assert(g_base->InLogicThread()); }
 
 void Audio::StepDisplayTime() { assert(g_base->InLogicThread()); }
 
+void Audio::SubmitCommands() {
+  assert(g_base->InLogicThread());
+  g_base->audio_server->SubmitSourceCommands();
+}
+
 void Audio::DoApplyAppConfig() {
   assert(g_base->InLogicThread());
   SetVolumes(g_base->app_config->Resolve(AppConfig::FloatID::kMusicVolume),
              g_base->app_config->Resolve(AppConfig::FloatID::kSoundVolume));
+  g_base->audio_server->PushSetVoiceBudgetCall(
+      g_base->app_config->Resolve(AppConfig::IntID::kAudioVoiceBudget));
 }
 
 void Audio::OnScreenSizeChange() { assert(g_base->InLogicThread()); }
@@ -72,13 +78,11 @@ void Audio::SetListenerOrientation(const Vector3f& forward,
 
 // This stops a particular sound play ID only.
 void Audio::PushSourceStopSoundCall(uint32_t play_id) {
-  g_base->audio_server->event_loop()->PushCall(
-      [play_id] { g_base->audio_server->StopSound(play_id); });
+  g_base->audio_server->PushStopSoundCall(play_id);
 }
 
 void Audio::PushSourceFadeOutCall(uint32_t play_id, uint32_t time) {
-  g_base->audio_server->event_loop()->PushCall(
-      [play_id, time] { g_base->audio_server->FadeSoundOut(play_id, time); });
+  g_base->audio_server->PushFadeSoundOutCall(play_id, time);
 }
 
 // Seems we get a false alarm here.
@@ -29,6 +29,10 @@ class Audio {
   virtual void OnScreenSizeChange();
   virtual void StepDisplayTime();
 
+  /// Send along all source commands issued since the last call. Called
+  /// once per display-time step once everything else has had its say.
+  void SubmitCommands();
+
   /// Can be keyed off of to cut corners in audio (leaving sounds out, etc.)
   /// Currently just piggybacks off graphics quality settings but this logic
   /// may get fancier in the future.
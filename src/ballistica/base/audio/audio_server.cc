@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "ballistica/core/support/thread_trace.h"
 #include "ballistica/shared/buildconfig/buildconfig_common.h"
 
 // Ew fixme.
@@ -56,6 +57,21 @@ const int kAudioProcessIntervalNormal{500 * 1000};
 const int kAudioProcessIntervalFade{50 * 1000};
 const int kAudioProcessIntervalPendingLoad{1 * 1000};
 
+// Buffered source commands get sent along early if this many pile up.
+const size_t kMaxPendingSourceCommands{256};
+
+// Distance attenuation settings for our sources. In vr mode we keep the
+// microphone a bit closer to the camera for realism purposes, so we need
+// stuff louder in general.
+const float kSourceMaxDistance{100.0f};
+const float kSourceReferenceDistance{5.0f};
+const float kSourceReferenceDistanceVR{7.5f};
+const float kSourceRolloffFactor{0.3f};
+
+// One-shot sounds quieter than this (after distance attenuation) are
+// not worth a voice.
+const float kMinAudibleGain{0.01f};
+
 #if BA_DEBUG_BUILD || BA_TEST_BUILD
 const bool kShowInUseSounds{};
 #endif
@@ -115,6 +131,14 @@ class AudioServer::ThreadSource_ : public Object {
   auto source_sound() const -> SoundAsset* {
     return source_sound_ ? source_sound_->get() : nullptr;
   }
+  auto looping() const -> bool { return looping_; }
+
+  /// Rough gain we'd currently be heard at, including distance
+  /// attenuation (but not global volumes).
+  auto GetAudibility() const -> float;
+
+  /// Whether OpenAL still has us playing (as opposed to having finished).
+  auto IsPlayingInAL() const -> bool;
 
   void UpdatePitch();
   void UpdateVolume();
@@ -129,6 +153,7 @@ class AudioServer::ThreadSource_ : public Object {
  private:
   int id_{};
   bool looping_{};
+  bool positional_{true};
   bool valid_{};
   bool is_actually_playing_{};
   bool want_to_play_{};
@@ -140,6 +165,7 @@ class AudioServer::ThreadSource_ : public Object {
   uint32_t play_count_{};
   float fade_{1.0f};
   float gain_{1.0f};
+  Vector3f position_{0.0f, 0.0f, 0.0f};
   std::unique_ptr<AudioSource> client_source_;
   AudioServer* audio_server_{};
   const Object::Ref<SoundAsset>* source_sound_{};
@@ -638,109 +664,187 @@ void AudioServer::SetSuspended_(bool suspend) {
   }
 }
 
-void AudioServer::PushSourceSetIsMusicCall(uint32_t play_id, bool val) {
-  event_loop()->PushCall([this, play_id, val] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    if (s) {
-      s->SetIsMusic(val);
+void AudioServer::PushSourceCommand_(const SourceCommand_& command) {
+  bool submit;
+  {
+    std::scoped_lock lock(source_commands_mutex_);
+    source_commands_.push_back(command);
+    submit = source_commands_.size() >= kMaxPendingSourceCommands;
+  }
+  if (submit) {
+    SubmitSourceCommands();
+  }
+}
+
+void AudioServer::SubmitSourceCommands() {
+  std::vector<SourceCommand_> commands;
+  {
+    std::scoped_lock lock(source_commands_mutex_);
+    if (source_commands_.empty()) {
+      return;
     }
+    commands.swap(source_commands_);
+  }
+  event_loop()->PushCall([this, commands = std::move(commands)] {
+    RunSourceCommands_(commands);
   });
 }
 
-void AudioServer::PushSourceSetPositionalCall(uint32_t play_id, bool val) {
-  event_loop()->PushCall([this, play_id, val] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    if (s) {
-      s->SetPositional(val);
+void AudioServer::RunSourceCommands_(
+    const std::vector<SourceCommand_>& commands) {
+  assert(g_base->InAudioThread());
+  bool played{};
+  for (auto&& cmd : commands) {
+    if (cmd.type == SourceCommand_::Type::kFadeOut) {
+      FadeSoundOut(cmd.play_id, cmd.time);
+      continue;
     }
-  });
+    if (cmd.type == SourceCommand_::Type::kStopSound) {
+      StopSound(cmd.play_id);
+      continue;
+    }
+    ThreadSource_* s = GetPlayingSound_(cmd.play_id);
+    switch (cmd.type) {
+      case SourceCommand_::Type::kSetIsMusic:
+        if (s) {
+          s->SetIsMusic(cmd.bool_val);
+        }
+        break;
+      case SourceCommand_::Type::kSetPositional:
+        if (s) {
+          s->SetPositional(cmd.bool_val);
+        }
+        break;
+      case SourceCommand_::Type::kSetPosition:
+        if (s) {
+          s->SetPosition(cmd.vals[0], cmd.vals[1], cmd.vals[2]);
+        }
+        break;
+      case SourceCommand_::Type::kSetGain:
+        if (s) {
+          s->SetGain(cmd.vals[0]);
+        }
+        break;
+      case SourceCommand_::Type::kSetFade:
+        if (s) {
+          s->SetFade(cmd.vals[0]);
+        }
+        break;
+      case SourceCommand_::Type::kSetLooping:
+        if (s) {
+          s->SetLooping(cmd.bool_val);
+        }
+        break;
+      case SourceCommand_::Type::kPlay:
+        // If this play command is valid, pass it along. Otherwise, return
+        // it immediately for deletion.
+        if (s) {
+          s->Play(cmd.sound);
+        } else {
+          AddSoundRefDelete(cmd.sound);
+        }
+        played = true;
+        break;
+      case SourceCommand_::Type::kStop:
+        if (s) {
+          s->Stop();
+        }
+        break;
+      case SourceCommand_::Type::kEnd:
+        assert(s);
+        s->client_source()->Lock(5);
+        s->client_source()->set_client_queue_size(
+            s->client_source()->client_queue_size() - 1);
+        assert(s->client_source()->client_queue_size() >= 0);
+        s->client_source()->Unlock();
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Let's take this opportunity to pass on newly available sources. This
+  // way the more things clients are playing, the more tight our source
+  // availability checking gets (instead of solely relying on our periodic
+  // process() calls).
+  if (played) {
+    UpdateAvailableSources_();
+  }
+}
+
+void AudioServer::PushSourceSetIsMusicCall(uint32_t play_id, bool val) {
+  SourceCommand_ cmd{SourceCommand_::Type::kSetIsMusic, play_id};
+  cmd.bool_val = val;
+  PushSourceCommand_(cmd);
+}
+
+void AudioServer::PushSourceSetPositionalCall(uint32_t play_id, bool val) {
+  SourceCommand_ cmd{SourceCommand_::Type::kSetPositional, play_id};
+  cmd.bool_val = val;
+  PushSourceCommand_(cmd);
 }
 
 void AudioServer::PushSourceSetPositionCall(uint32_t play_id,
                                             const Vector3f& p) {
-  event_loop()->PushCall([this, play_id, p] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    if (s) {
-      s->SetPosition(p.x, p.y, p.z);
-    }
-  });
+  SourceCommand_ cmd{SourceCommand_::Type::kSetPosition, play_id};
+  cmd.vals[0] = p.x;
+  cmd.vals[1] = p.y;
+  cmd.vals[2] = p.z;
+  PushSourceCommand_(cmd);
 }
 
 void AudioServer::PushSourceSetGainCall(uint32_t play_id, float val) {
-  event_loop()->PushCall([this, play_id, val] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    if (s) {
-      s->SetGain(val);
-    }
-  });
+  SourceCommand_ cmd{SourceCommand_::Type::kSetGain, play_id};
+  cmd.vals[0] = val;
+  PushSourceCommand_(cmd);
 }
 
 void AudioServer::PushSourceSetFadeCall(uint32_t play_id, float val) {
-  event_loop()->PushCall([this, play_id, val] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    if (s) {
-      s->SetFade(val);
-    }
-  });
+  SourceCommand_ cmd{SourceCommand_::Type::kSetFade, play_id};
+  cmd.vals[0] = val;
+  PushSourceCommand_(cmd);
 }
 
 void AudioServer::PushSourceSetLoopingCall(uint32_t play_id, bool val) {
-  event_loop()->PushCall([this, play_id, val] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    if (s) {
-      s->SetLooping(val);
-    }
-  });
+  SourceCommand_ cmd{SourceCommand_::Type::kSetLooping, play_id};
+  cmd.bool_val = val;
+  PushSourceCommand_(cmd);
 }
 
 void AudioServer::PushSourcePlayCall(uint32_t play_id,
                                      Object::Ref<SoundAsset>* sound) {
-  event_loop()->PushCall([this, play_id, sound] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-
-    // If this play command is valid, pass it along.
-    // Otherwise, return it immediately for deletion.
-    if (s) {
-      s->Play(sound);
-    } else {
-      AddSoundRefDelete(sound);
-    }
-
-    // Let's take this opportunity to pass on newly available sources.
-    // This way the more things clients are playing, the more
-    // tight our source availability checking gets (instead of solely relying
-    // on our periodic process() calls).
-    UpdateAvailableSources_();
-  });
+  SourceCommand_ cmd{SourceCommand_::Type::kPlay, play_id};
+  cmd.sound = sound;
+  PushSourceCommand_(cmd);
 }
 
 void AudioServer::PushSourceStopCall(uint32_t play_id) {
-  event_loop()->PushCall([this, play_id] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    if (s) {
-      s->Stop();
-    }
-  });
+  PushSourceCommand_({SourceCommand_::Type::kStop, play_id});
 }
 
 void AudioServer::PushSourceEndCall(uint32_t play_id) {
-  event_loop()->PushCall([this, play_id] {
-    ThreadSource_* s = GetPlayingSound_(play_id);
-    assert(s);
-    s->client_source()->Lock(5);
-    s->client_source()->set_client_queue_size(
-        s->client_source()->client_queue_size() - 1);
-    assert(s->client_source()->client_queue_size() >= 0);
-    s->client_source()->Unlock();
-  });
+  PushSourceCommand_({SourceCommand_::Type::kEnd, play_id});
+}
+
+void AudioServer::PushFadeSoundOutCall(uint32_t play_id, uint32_t time) {
+  SourceCommand_ cmd{SourceCommand_::Type::kFadeOut, play_id};
+  cmd.time = time;
+  PushSourceCommand_(cmd);
+}
+
+void AudioServer::PushStopSoundCall(uint32_t play_id) {
+  PushSourceCommand_({SourceCommand_::Type::kStopSound, play_id});
 }
 
 void AudioServer::PushResetCall() {
+  // Anything queued before the reset should land before it.
+  SubmitSourceCommands();
   event_loop()->PushCall([this] { Reset_(); });
 }
 
 void AudioServer::PushSetListenerPositionCall(const Vector3f& p) {
   event_loop()->PushCall([this, p] {
+    listener_position_ = p;
 #if BA_ENABLE_AUDIO
     if (!suspended_ && !shutting_down_) {
       ALfloat lpos[3] = {p.x, p.y, p.z};
@@ -1031,9 +1135,12 @@ void AudioServer::OnDeviceDisconnected() {
 }
 
 void AudioServer::Process_() {
+  BA_TRACE_SCOPE("AudioServer::Process");
   assert(g_base->InAudioThread());
+  microsecs_t start_time = g_core->AppTimeMicrosecs();
   seconds_t real_time_seconds = g_core->AppTimeSeconds();
   millisecs_t real_time_millisecs = real_time_seconds * 1000;
+  int active_source_count{};
 
   // Only do real work if we're in normal running mode.
   if (!suspended_ && !shutting_down_) {
@@ -1044,6 +1151,11 @@ void AudioServer::Process_() {
 
     // Keep that available-sources list filled.
     UpdateAvailableSources_();
+    for (auto&& i : sources_) {
+      if (i->IsPlayingInAL()) {
+        active_source_count++;
+      }
+    }
 
     // Update our fading sound volumes.
     if (real_time_millisecs - last_sound_fade_process_time_ > 50) {
@@ -1079,6 +1191,18 @@ void AudioServer::Process_() {
   }
   UpdateTimerInterval_();
 
+  {
+    microsecs_t duration = g_core->AppTimeMicrosecs() - start_time;
+    std::scoped_lock lock(stats_mutex_);
+    stats_.process_count++;
+    stats_.process_time_total += duration;
+    stats_.process_time_max = std::max(stats_.process_time_max, duration);
+    stats_.source_count = static_cast<int>(sources_.size());
+    stats_.active_source_count = active_source_count;
+    stats_.streaming_source_count =
+        static_cast<int>(streaming_sources_.size());
+  }
+
   // In my brief unscientific testing with my airpods, a 0.2 second delay
   // between stopping sounds and killing the sound-system seems to be enough
   // for the mixer to spit out some silence so we don't hear sudden cut-offs
@@ -1172,18 +1296,11 @@ AudioServer::ThreadSource_::ThreadSource_(AudioServer* audio_server_in,
                 std::string("AL Error ") + GetALErrorString(err)
                     + " on source creation.");
   } else {
-    // In vr mode we keep the microphone a bit closer to the camera
-    // for realism purposes, so we need stuff louder in general.
-    if (g_core->vr_mode()) {
-      alSourcef(source_, AL_MAX_DISTANCE, 100);
-      alSourcef(source_, AL_REFERENCE_DISTANCE, 7.5f);
-    } else {
-      // In regular mode our mic is stuck closer to the action
-      // so less loudness is needed.
-      alSourcef(source_, AL_MAX_DISTANCE, 100);
-      alSourcef(source_, AL_REFERENCE_DISTANCE, 5.0f);
-    }
-    alSourcef(source_, AL_ROLLOFF_FACTOR, 0.3f);
+    alSourcef(source_, AL_MAX_DISTANCE, kSourceMaxDistance);
+    alSourcef(source_, AL_REFERENCE_DISTANCE,
+              g_core->vr_mode() ? kSourceReferenceDistanceVR
+                                : kSourceReferenceDistance);
+    alSourcef(source_, AL_ROLLOFF_FACTOR, kSourceRolloffFactor);
     CHECK_AL_ERROR;
   }
   *valid_out = valid_;
@@ -1320,6 +1437,7 @@ void AudioServer::ThreadSource_::SetLooping(bool loop) {
 }
 
 void AudioServer::ThreadSource_::SetPositional(bool p) {
+  positional_ = p;
 #if BA_ENABLE_AUDIO
   if (g_base->audio_server->suspended_
       || g_base->audio_server->shutting_down_) {
@@ -1335,6 +1453,7 @@ void AudioServer::ThreadSource_::SetPositional(bool p) {
 }
 
 void AudioServer::ThreadSource_::SetPosition(float x, float y, float z) {
+  position_ = Vector3f(x, y, z);
 #if BA_ENABLE_AUDIO
   if (g_base->audio_server->suspended_
       || g_base->audio_server->shutting_down_) {
@@ -1413,7 +1532,14 @@ auto AudioServer::ThreadSource_::Play(const Object::Ref<SoundAsset>* sound)
     bool music_should_play = ((g_base->audio_server->music_volume_ > 0.000001f)
                               && !g_base->audio_server->suspended_
                               && !g_base->audio_server->shutting_down_);
-    if ((!current_is_music_) || music_should_play) {
+    if (current_is_music_) {
+      if (music_should_play) {
+        ExecPlay();
+      }
+    } else if (looping_ || is_streamed_
+               || audio_server_->ClaimVoice_(this)) {
+      // Loops and streams are left alone; their owners expect them to
+      // keep going.
       ExecPlay();
     }
   }
@@ -1562,6 +1688,37 @@ void AudioServer::ThreadSource_::UpdateVolume() {
 #endif  // BA_ENABLE_AUDIO
 }
 
+auto AudioServer::ThreadSource_::GetAudibility() const -> float {
+  float gain = gain_ * fade_;
+  if (!positional_) {
+    return gain;
+  }
+
+  // Mirrors OpenAL's default inverse-distance-clamped model with our
+  // source settings.
+  float ref_distance = g_core->vr_mode() ? kSourceReferenceDistanceVR
+                                         : kSourceReferenceDistance;
+  float distance = (position_ - audio_server_->listener_position_).Length();
+  distance = std::clamp(distance, ref_distance, kSourceMaxDistance);
+  return gain * ref_distance
+         / (ref_distance + kSourceRolloffFactor * (distance - ref_distance));
+}
+
+auto AudioServer::ThreadSource_::IsPlayingInAL() const -> bool {
+#if BA_ENABLE_AUDIO
+  if (!is_actually_playing_ || audio_server_->suspended_
+      || audio_server_->shutting_down_) {
+    return false;
+  }
+  ALint state;
+  alGetSourcei(source_, AL_SOURCE_STATE, &state);
+  CHECK_AL_ERROR;
+  return state == AL_PLAYING;
+#else
+  return false;
+#endif
+}
+
 void AudioServer::ThreadSource_::UpdatePitch() {
 #if BA_ENABLE_AUDIO
   assert(g_base->InAudioThread());
@@ -1591,6 +1748,83 @@ void AudioServer::PushSetSoundPitchCall(float val) {
   event_loop()->PushCall([this, val] { SetSoundPitch_(val); });
 }
 
+void AudioServer::PushSetVoiceBudgetCall(int budget) {
+  event_loop()->PushCall([this, budget] { voice_budget_ = budget; });
+}
+
+auto AudioServer::ClaimVoice_(ThreadSource_* source) -> bool {
+  assert(g_base->InAudioThread());
+  float audibility = source->GetAudibility() * sound_volume_;
+  if (audibility < kMinAudibleGain) {
+    std::scoped_lock lock(stats_mutex_);
+    stats_.culled_voices++;
+    return false;
+  }
+  if (voice_budget_ <= 0) {
+    return true;
+  }
+
+  // Count what's playing and find the quietest one-shot we could cut.
+  int voice_count{};
+  ThreadSource_* weakest{};
+  float weakest_audibility{};
+  for (auto&& i : sources_) {
+    if (i == source || i->current_is_music() || !i->IsPlayingInAL()) {
+      continue;
+    }
+    voice_count++;
+    if (i->looping() || i->is_streamed()) {
+      continue;
+    }
+    float i_audibility = i->GetAudibility() * sound_volume_;
+    if (weakest == nullptr || i_audibility < weakest_audibility) {
+      weakest = i;
+      weakest_audibility = i_audibility;
+    }
+  }
+  if (voice_count < voice_budget_) {
+    return true;
+  }
+  if (weakest != nullptr && weakest_audibility < audibility) {
+    // It'll get recycled next time we update availability.
+    weakest->ExecStop();
+    std::scoped_lock lock(stats_mutex_);
+    stats_.stolen_voices++;
+    return true;
+  }
+  std::scoped_lock lock(stats_mutex_);
+  stats_.culled_voices++;
+  return false;
+}
+
+auto AudioServer::GetStats(bool reset) -> Stats {
+  std::scoped_lock lock(stats_mutex_);
+  Stats stats{stats_};
+  if (reset) {
+    stats_.process_count = 0;
+    stats_.process_time_total = stats_.process_time_max = 0;
+    stats_.stream_underruns = stats_.stream_decode_misses = 0;
+    stats_.al_errors = 0;
+    stats_.culled_voices = stats_.stolen_voices = 0;
+  }
+  return stats;
+}
+
+void AudioServer::OnStreamUnderrun() {
+  std::scoped_lock lock(stats_mutex_);
+  stats_.stream_underruns++;
+}
+
+void AudioServer::OnStreamDecodeMiss() {
+  std::scoped_lock lock(stats_mutex_);
+  stats_.stream_decode_misses++;
+}
+
+void AudioServer::OnALError() {
+  std::scoped_lock lock(stats_mutex_);
+  stats_.al_errors++;
+}
+
 void AudioServer::PushComponentUnloadCall(
     const std::vector<Object::Ref<Asset>*>& components) {
   event_loop()->PushCall([components] {
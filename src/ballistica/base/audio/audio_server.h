@@ -11,6 +11,7 @@
 
 #include "ballistica/base/base.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/math/vector3f.h"
 
 namespace ballistica::base {
 
@@ -25,12 +26,44 @@ class AudioServer {
     return play_id >> 16u;
   }
 
+  /// Counters for tracking down audio hitches. Totals are since the last
+  /// reset; source counts are as of the last process pass.
+  struct Stats {
+    int64_t process_count{};
+    microsecs_t process_time_total{};
+    microsecs_t process_time_max{};
+    int source_count{};
+    int active_source_count{};
+    int streaming_source_count{};
+    /// Streams that ran dry and had to be restarted.
+    int64_t stream_underruns{};
+    /// Stream buffers decoded inline because decode-ahead fell behind.
+    int64_t stream_decode_misses{};
+    int64_t al_errors{};
+    int64_t culled_voices{};
+    int64_t stolen_voices{};
+  };
+
   AudioServer();
   void OnMainThreadStartApp();
 
+  /// Return a snapshot of our stats, optionally resetting totals. Can be
+  /// called from any thread.
+  auto GetStats(bool reset) -> Stats;
+
+  // Called by streamers and our error checking to update stats.
+  void OnStreamUnderrun();
+  void OnStreamDecodeMiss();
+  void OnALError();
+
   void PushSetVolumesCall(float music_volume, float sound_volume);
   void PushSetSoundPitchCall(float val);
 
+  /// Set the max number of one-shot sounds that can play at once; when
+  /// over, the least audible ones get cut. 0 or less for no limit (beyond
+  /// our source count).
+  void PushSetVoiceBudgetCall(int budget);
+
   void PushSetListenerPositionCall(const Vector3f& p);
   void PushSetListenerOrientationCall(const Vector3f& forward,
                                       const Vector3f& up);
@@ -46,7 +79,9 @@ class AudioServer {
   void Shutdown();
   auto shutdown_completed() const { return shutdown_completed_; }
 
-  // Client sources use these to pass settings to the server.
+  // Client sources use these to pass settings to the server. Rather than
+  // each becoming its own event-loop message, these are buffered and sent
+  // over in batches by SubmitSourceCommands(), preserving their order.
   void PushSourceSetIsMusicCall(uint32_t play_id, bool val);
   void PushSourceSetPositionalCall(uint32_t play_id, bool val);
   void PushSourceSetPositionCall(uint32_t play_id, const Vector3f& p);
@@ -56,6 +91,13 @@ class AudioServer {
   void PushSourcePlayCall(uint32_t play_id, Object::Ref<SoundAsset>* sound);
   void PushSourceStopCall(uint32_t play_id);
   void PushSourceEndCall(uint32_t play_id);
+  void PushFadeSoundOutCall(uint32_t play_id, uint32_t time);
+  void PushStopSoundCall(uint32_t play_id);
+
+  /// Send all buffered source commands to the audio thread as a single
+  /// message. The logic thread calls this once per display-time step; it
+  /// also happens automatically if too many commands pile up.
+  void SubmitSourceCommands();
 
   // Fade a playing sound out over the given time.  If it is already
   // fading or does not exist, does nothing.
@@ -73,6 +115,31 @@ class AudioServer {
   class ThreadSource_;
   struct Impl_;
 
+  struct SourceCommand_ {
+    enum class Type : uint8_t {
+      kSetIsMusic,
+      kSetPositional,
+      kSetPosition,
+      kSetGain,
+      kSetFade,
+      kSetLooping,
+      kPlay,
+      kStop,
+      kEnd,
+      kFadeOut,
+      kStopSound
+    };
+    Type type;
+    uint32_t play_id;
+    bool bool_val{};
+    uint32_t time{};
+    float vals[3]{};
+    Object::Ref<SoundAsset>* sound{};
+  };
+
+  void PushSourceCommand_(const SourceCommand_& command);
+  void RunSourceCommands_(const std::vector<SourceCommand_>& commands);
+
   void OnAppStartInThread_();
   ~AudioServer();
 
@@ -97,6 +164,12 @@ class AudioServer {
   /// Send a component to the audio thread to delete.
   // void DeleteAssetComponent_(Asset* c);
 
+  /// Decide whether a one-shot sound about to start should actually
+  /// reach OpenAL. Culls inaudible sounds and, when over our voice
+  /// budget, stops the least audible voice playing if it is quieter than
+  /// the new one (or refuses the new one otherwise).
+  auto ClaimVoice_(ThreadSource_* source) -> bool;
+
   void UpdateTimerInterval_();
   void UpdateAvailableSources_();
   void UpdateMusicPlayState_();
@@ -130,12 +203,20 @@ class AudioServer {
   // int reset_result_reports_remaining_{3};
   // int reconnect_fail_count_{};
   int al_source_count_{};
+  int voice_budget_{};
+  Vector3f listener_position_{0.0f, 0.0f, 0.0f};
   seconds_t last_connected_time_{};
   seconds_t last_reset_attempt_time_{-999.0};
   seconds_t shutdown_start_time_{};
   seconds_t last_started_playing_time_{};
   millisecs_t last_sound_fade_process_time_{};
 
+  std::mutex stats_mutex_;
+  Stats stats_;
+
+  std::mutex source_commands_mutex_;
+  std::vector<SourceCommand_> source_commands_;
+
   std::mutex openalsoft_android_log_mutex_;
   std::string openalsoft_android_log_;
 
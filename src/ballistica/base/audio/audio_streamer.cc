@@ -3,8 +3,13 @@
 #include "ballistica/base/audio/audio_streamer.h"
 
 #include <cstdio>
+#include <exception>
+#include <mutex>
+#include <string>
 
+#include "ballistica/base/audio/audio_server.h"
 #include "ballistica/base/base.h"
+#include "ballistica/core/core.h"
 
 // Need to move away from OpenAL on Apple stuff.
 #if __clang__
@@ -19,11 +24,15 @@ AudioStreamer::AudioStreamer(const char* file_name, ALuint source_in, bool loop)
   assert(g_base->InAudioThread());
   alGenBuffers(kAudioStreamBufferCount, buffers_);
   CHECK_AL_ERROR;
+  for (auto&& chunk : chunks_) {
+    chunk.pcm.resize(kAudioStreamBufferSize);
+  }
 }
 
 AudioStreamer::~AudioStreamer() {
   assert(!playing_);
   assert(g_base->audio_server);
+  WaitForDecode_();
 
   alDeleteBuffers(kAudioStreamBufferCount, buffers_);
   CHECK_AL_ERROR;
@@ -46,6 +55,7 @@ auto AudioStreamer::Play() -> bool {
 
   alSourceQueueBuffers(source_, kAudioStreamBufferCount, buffers_);
   CHECK_AL_ERROR;
+  primed_ = true;
 
   alSourcePlay(source_);
   CHECK_AL_ERROR;
@@ -64,7 +74,14 @@ void AudioStreamer::Stop() {
   alSourceStop(source_);
   CHECK_AL_ERROR;
   playing_ = false;
+  primed_ = false;
   DetachBuffers();
+
+  // Toss anything decoded ahead; we start over from the top next time.
+  WaitForDecode_();
+  chunk_read_index_ = chunk_count_ = 0;
+  decode_eof_ = false;
+  eof_ = false;
   DoStop();
 }
 
@@ -115,6 +132,7 @@ void AudioStreamer::Update() {
   if (state != AL_PLAYING) {
     printf("AudioServer::Streamer: restarting playback\n");
     fflush(stdout);
+    g_base->audio_server->OnStreamUnderrun();
 
     alSourcePlay(source_);
     CHECK_AL_ERROR;
@@ -135,16 +153,43 @@ void AudioStreamer::DetachBuffers() {
 }
 
 auto AudioStreamer::Stream(ALuint buffer) -> bool {
-  char pcm[kAudioStreamBufferSize];
   int size = 0;
-  unsigned int rate;
   CHECK_AL_ERROR;
-  DoStream(pcm, &size, &rate);
-  if (size > 0) {
-    alBufferData(buffer, al_format(), pcm, size, static_cast<ALsizei>(rate));
-    CHECK_AL_ERROR;
-  } else {
+  {
+    std::scoped_lock lock(decode_mutex_);
+    if (chunk_count_ > 0) {
+      Chunk_& chunk{chunks_[chunk_read_index_]};
+      size = chunk.size;
+      if (size > 0) {
+        alBufferData(buffer, al_format(), chunk.pcm.data(), size,
+                     static_cast<ALsizei>(chunk.rate));
+        CHECK_AL_ERROR;
+      }
+      chunk_read_index_ =
+          (chunk_read_index_ + 1) % kAudioStreamDecodeAheadCount;
+      chunk_count_--;
+    } else if (!decode_eof_) {
+      // Nothing decoded ahead (just started or the decoder fell behind);
+      // do it ourself.
+      if (primed_ && DecodeAheadEnabled_()) {
+        g_base->audio_server->OnStreamDecodeMiss();
+      }
+      char pcm[kAudioStreamBufferSize];
+      unsigned int rate;
+      DoStream(pcm, &size, &rate);
+      if (size > 0) {
+        alBufferData(buffer, al_format(), pcm, size,
+                     static_cast<ALsizei>(rate));
+        CHECK_AL_ERROR;
+      } else {
+        decode_eof_ = true;
+      }
+    }
+  }
+  if (size <= 0) {
     eof_ = true;
+  } else {
+    KickDecode_();
   }
 
   // Suppress 'always returns true' lint.
@@ -155,6 +200,49 @@ auto AudioStreamer::Stream(ALuint buffer) -> bool {
   return true;
 }
 
+auto AudioStreamer::DecodeAheadEnabled_() -> bool {
+  return g_core->job_system != nullptr
+         && g_core->job_system->thread_count() > 0;
+}
+
+void AudioStreamer::KickDecode_() {
+  if (!DecodeAheadEnabled_() || decoding_.exchange(true)) {
+    return;
+  }
+  g_core->job_system->Push(&decode_group_, [this] { DecodeAhead_(); });
+}
+
+void AudioStreamer::DecodeAhead_() {
+  try {
+    while (true) {
+      std::scoped_lock lock(decode_mutex_);
+      if (chunk_count_ == kAudioStreamDecodeAheadCount || decode_eof_) {
+        break;
+      }
+      Chunk_& chunk{chunks_[(chunk_read_index_ + chunk_count_)
+                            % kAudioStreamDecodeAheadCount]};
+      chunk.size = 0;
+      DoStream(chunk.pcm.data(), &chunk.size, &chunk.rate);
+
+      // An empty chunk goes in the ring too so eof lands in order.
+      chunk_count_++;
+      if (chunk.size <= 0) {
+        decode_eof_ = true;
+      }
+    }
+  } catch (const std::exception& e) {
+    g_core->Log(LogName::kBaAudio, LogLevel::kError,
+                "Error decoding ahead for '" + file_name_ + "': " + e.what());
+  }
+  decoding_ = false;
+}
+
+void AudioStreamer::WaitForDecode_() {
+  if (g_core->job_system && !decode_group_.done()) {
+    g_core->job_system->Wait(&decode_group_);
+  }
+}
+
 #endif  // BA_ENABLE_AUDIO
 
 }  // namespace ballistica::base
@@ -3,16 +3,24 @@
 #ifndef BALLISTICA_BASE_AUDIO_AUDIO_STREAMER_H_
 #define BALLISTICA_BASE_AUDIO_AUDIO_STREAMER_H_
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "ballistica/base/audio/al_sys.h"  // FIXME: shouldn't need this here.
+#include "ballistica/shared/foundation/job_system.h"
 #include "ballistica/shared/foundation/object.h"
 
 namespace ballistica::base {
 
 #if BA_ENABLE_AUDIO
 // Provider for streamed audio data.
+//
+// Decoding is done ahead of time on the job system into a small ring of
+// pcm chunks, so the audio thread normally just hands ready chunks to
+// OpenAL. If the decoder falls behind we decode inline as before.
 class AudioStreamer : public Object {
  public:
   auto GetDefaultOwnerThread() const -> EventLoopID override {
@@ -47,8 +55,31 @@ class AudioStreamer : public Object {
   void set_format(Format format) { format_ = format; }
 
  private:
+  struct Chunk_ {
+    std::vector<char> pcm;
+    int size{};
+    unsigned int rate{};
+  };
+
+  static auto DecodeAheadEnabled_() -> bool;
+
+  // Start a decode-ahead job if one isn't already running.
+  void KickDecode_();
+  void DecodeAhead_();
+  void WaitForDecode_();
+
+  // Guards DoStream() calls and the chunk ring.
+  std::mutex decode_mutex_;
+  Chunk_ chunks_[kAudioStreamDecodeAheadCount];
+  int chunk_read_index_{};
+  int chunk_count_{};
+  bool decode_eof_{};
+  std::atomic<bool> decoding_{};
+  JobSystem::Group decode_group_;
   Format format_{Format::kInvalid};
   bool playing_{};
+  // Whether our initial buffers have been filled.
+  bool primed_{};
   bool loops_{};
   bool eof_{};
   ALuint buffers_[kAudioStreamBufferCount]{};
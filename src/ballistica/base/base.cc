@@ -10,6 +10,7 @@
 #include "ballistica/base/app_mode/empty_app_mode.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/assets/assets_server.h"
+#include "ballistica/base/assets/replay_writer.h"
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/audio/audio_server.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics_server.h"
@@ -66,6 +67,7 @@ BaseFeatureSet::BaseFeatureSet()
       networking{new Networking()},
       platform{BaseBuildSwitches::CreatePlatform()},
       python{new BasePython()},
+      replay_writer{new ReplayWriter()},
       stdio_console{g_buildconfig.enable_stdio_console() ? new StdioConsole()
                                                          : nullptr},
       text_graphics{new TextGraphics()},
@@ -134,12 +136,14 @@ void BaseFeatureSet::OnModuleExec(PyObject* module) {
   g_base->base_native_import_completed_ = true;
 
   g_core->Log(LogName::kBaLifecycle, LogLevel::kInfo, "_babase exec end");
+  g_core->MarkStartupPhase("babase_exec");
 }
 
 void BaseFeatureSet::OnReachedEndOfBaBaseImport() {
   assert(!base_import_completed_);
   g_base->python->ImportPythonAppObjs();
   base_import_completed_ = true;
+  g_core->MarkStartupPhase("babase_import");
 }
 
 auto BaseFeatureSet::Import() -> BaseFeatureSet* {
@@ -237,6 +241,7 @@ void BaseFeatureSet::StartApp() {
   network_writer->OnMainThreadStartApp();
   audio_server->OnMainThreadStartApp();
   assets_server->OnMainThreadStartApp();
+  replay_writer->OnMainThreadStartApp();
   app_adapter->OnMainThreadStartApp();
 
   // Ok; we're now official 'started'. Various code such as anything that
@@ -254,6 +259,7 @@ void BaseFeatureSet::StartApp() {
 
   g_core->Log(LogName::kBaLifecycle, LogLevel::kInfo,
               "start-app end (main thread)");
+  g_core->MarkStartupPhase("start_app");
 
   // Make some noise if this takes more than a few seconds. If we pass 5
   // seconds or so we start to trigger App-Not-Responding reports which
@@ -371,6 +377,9 @@ void BaseFeatureSet::SuspendApp() {
       case EventLoopID::kBGDynamics:
         msg += "bgdynamics";
         break;
+      case EventLoopID::kLog:
+        msg += "log";
+        break;
     }
     first = false;
   }
@@ -739,6 +748,13 @@ void BaseFeatureSet::PushDevConsolePrintCall(const std::string& msg,
   ui->PushDevConsolePrintCall(msg, scale, color);
 }
 
+void BaseFeatureSet::PushDevConsoleLogCall(const std::string& prefix,
+                                           Vector4f prefix_color,
+                                           const std::string& msg,
+                                           Vector4f color) {
+  ui->PushDevConsoleLogCall(prefix, prefix_color, msg, color);
+}
+
 PyObject* BaseFeatureSet::GetPyExceptionType(PyExcType exctype) {
   switch (exctype) {
     case PyExcType::kContext:
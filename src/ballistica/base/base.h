@@ -67,12 +67,16 @@ class ImageMesh;
 class Input;
 class InputDevice;
 class InputDeviceDelegate;
+class InputRecorder;
 class JoystickInput;
 class KeyboardInput;
 class Logic;
+class LogicProfiler;
 class Asset;
 class AssetsServer;
+class MappedFile;
 class MeshBufferBase;
+class MeshBufferVertexParticle;
 class MeshBufferVertexSprite;
 class MeshBufferVertexSimpleFull;
 class MeshBufferVertexSmokeFull;
@@ -102,14 +106,18 @@ class RenderTarget;
 class RemoteAppServer;
 class RemoteControlInput;
 class Repeater;
+class ReplayWriter;
 class ScoreToBeat;
+class ScopedPythonContextCallBatch;
 class ScreenMessages;
+class SimpleComponent;
 class AppAdapterSDL;
 class SDLContext;
 class SoundAsset;
 class SpriteMesh;
 class StdioConsole;
 class Module;
+class ParticleMesh;
 class TestInput;
 class TextGroup;
 class TextGraphics;
@@ -238,6 +246,20 @@ struct VertexSprite {
   float color[4];
 };
 
+/// A sprite that animates itself on the GPU. Holds a particle's state at
+/// birth; the vertex shader works out where it is at any later step.
+struct VertexParticle {
+  float position[3];
+  uint16_t uv[2];
+  float size;
+  float color[4];
+  /// Per-step velocity in xyz; w is a random seed for flickering.
+  float velocity[4];
+  /// Birth step, per-step life change, per-step size change, and flicker
+  /// scale.
+  float params[4];
+};
+
 enum class MeshFormat : uint8_t {
   /// 16bit UV, 8bit normal, 8bit pt-index.
   kUV16N8Index8,
@@ -292,7 +314,8 @@ enum class MeshDataType : uint8_t {
   kIndexedSimpleFull,
   kIndexedDualTextureFull,
   kIndexedSmokeFull,
-  kSprite
+  kSprite,
+  kParticle
 };
 
 struct TouchEvent {
@@ -408,6 +431,7 @@ enum class ShadingType : uint8_t {
   kPostProcessEyes,
   kPostProcessNormalDistort,
   kSprite,
+  kParticle,
   kCount
 };
 
@@ -463,13 +487,6 @@ enum class SysTextureID : uint8_t {
   kTouchArrowsActions,
   kRGBStripes,
   kUIAtlas2,
-  kFontSmall1,
-  kFontSmall2,
-  kFontSmall3,
-  kFontSmall4,
-  kFontSmall5,
-  kFontSmall6,
-  kFontSmall7,
   kFontExtras,
   kFontExtras2,
   kFontExtras3,
@@ -746,6 +763,8 @@ class BaseFeatureSet : public FeatureSetNativeComponent,
   void DoV1CloudLog(const std::string& msg) override;
   void PushDevConsolePrintCall(const std::string& msg, float scale,
                                Vector4f color) override;
+  void PushDevConsoleLogCall(const std::string& prefix, Vector4f prefix_color,
+                             const std::string& msg, Vector4f color) override;
   auto GetPyExceptionType(PyExcType exctype) -> PyObject* override;
   auto PrintPythonStackTrace() -> bool override;
   auto GetPyLString(PyObject* obj) -> std::string override;
@@ -821,6 +840,7 @@ class BaseFeatureSet : public FeatureSetNativeComponent,
   Networking* const networking;
   NetworkReader* const network_reader;
   NetworkWriter* const network_writer;
+  ReplayWriter* const replay_writer;
   StdioConsole* const stdio_console;
   TextGraphics* const text_graphics;
   UI* const ui;
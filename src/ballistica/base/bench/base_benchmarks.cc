@@ -0,0 +1,86 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/bench/bench.h"
+
+#if BA_BENCH_BUILD
+
+#include <cstdlib>
+#include <vector>
+
+#include "ballistica/base/graphics/texture/ktx.h"
+#include "ballistica/base/support/huffman.h"
+#include "ballistica/shared/math/random.h"
+
+namespace ballistica::base {
+
+// Something shaped like game traffic: lots of small values and zeros with
+// the occasional noisy float.
+static auto MakePacket_(size_t size) -> std::vector<uint8_t> {
+  RandomStream random(42);
+  std::vector<uint8_t> data(size);
+  for (auto&& byte : data) {
+    uint32_t r = random.NextUInt32();
+    byte = (r % 4 == 0) ? static_cast<uint8_t>(r >> 8)
+                        : static_cast<uint8_t>((r >> 8) % 8);
+  }
+
+  // Compressed data assumes the top bit of the first byte is unused.
+  data[0] &= 0x7F;
+  return data;
+}
+
+static auto BenchHuffman_() -> Huffman* {
+  static auto* huffman = [] {
+    auto* h = new Huffman();
+    h->build();
+    return h;
+  }();
+  return huffman;
+}
+
+BA_BENCHMARK(huffman_compress) {
+  auto* huffman = BenchHuffman_();
+  auto packet = MakePacket_(512);
+  std::vector<uint8_t> out;
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    huffman->compress(packet.data(), packet.size(), &out);
+    BenchmarkKeep(out);
+  }
+  state->bytes_processed =
+      state->iterations * static_cast<int64_t>(packet.size());
+}
+
+BA_BENCHMARK(huffman_decompress) {
+  auto* huffman = BenchHuffman_();
+  auto compressed = huffman->compress(MakePacket_(512));
+  std::vector<uint8_t> out;
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    huffman->decompress(compressed.data(), compressed.size(), &out);
+    BenchmarkKeep(out);
+  }
+  state->bytes_processed = state->iterations * 512;
+}
+
+BA_BENCHMARK(ktx_unpack_etc1) {
+  // Any bit pattern is a valid ETC1 block, so random data does fine.
+  const uint32_t kSize{256};
+  const unsigned int kETC1RGB8{0x8D64};
+  RandomStream random(7);
+  std::vector<uint8_t> blocks((kSize / 4) * (kSize / 4) * 8);
+  for (auto&& byte : blocks) {
+    byte = static_cast<uint8_t>(random.NextUInt32());
+  }
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    uint8_t* image{};
+    unsigned int format, internal_format, type;
+    KTXUnpackETC(blocks.data(), kETC1RGB8, kSize, kSize, &image, &format,
+                 &internal_format, &type, 0, false);
+    BenchmarkKeep(image);
+    free(image);
+  }
+  state->items_processed = state->iterations * kSize * kSize;
+}
+
+}  // namespace ballistica::base
+
+#endif  // BA_BENCH_BUILD
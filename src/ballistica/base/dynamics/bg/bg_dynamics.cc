@@ -2,8 +2,8 @@
 
 #include "ballistica/base/dynamics/bg/bg_dynamics.h"
 
+#include <algorithm>
 #include <memory>
-#include <utility>
 #include <vector>
 
 #include "ballistica/base/assets/assets.h"
@@ -17,6 +17,7 @@
 #include "ballistica/base/graphics/component/sprite_component.h"
 #include "ballistica/base/graphics/mesh/mesh_indexed_simple_full.h"
 #include "ballistica/base/graphics/mesh/mesh_indexed_smoke_full.h"
+#include "ballistica/base/graphics/mesh/particle_mesh.h"
 #include "ballistica/base/graphics/mesh/sprite_mesh.h"
 #include "ballistica/core/platform/core_platform.h"  // IWYU pragma: keep.
 #include "ballistica/shared/foundation/event_loop.h"
@@ -79,85 +80,97 @@ void BGDynamics::Step(const Vector3f& cam_pos, int step_millisecs) {
   d->graphics_quality = Graphics::GraphicsQualityFromRequest(
       g_base->graphics->settings()->graphics_quality,
       g_base->graphics->client_context()->auto_graphics_quality);
+  d->gpu_particles = g_base->graphics->gpu_particles();
+  d->target_step_ms = g_base->graphics->settings()->bg_dynamics_target_step_ms;
   d->step_millisecs = step_millisecs;
   d->cam_pos = cam_pos;
 
-  {  // Shadows.
-    BA_DEBUG_TIME_CHECK_BEGIN(bg_dynamic_shadow_list_lock);
-    {
-      std::scoped_lock lock(g_base->bg_dynamics_server->shadow_list_mutex());
-      auto size = g_base->bg_dynamics_server->shadows().size();
-      d->shadow_step_data_.resize(size);
-      if (size > 0) {
-        auto sd_client = &(g_base->bg_dynamics_server->shadows()[0]);
-        std::pair<BGDynamicsShadowData*, BGDynamicsServer::ShadowStepData>* sd =
-            &(d->shadow_step_data_[0]);
-        for (size_t i = 0; i < size; i++) {
-          // Set to nullptr (for ignore) if the client side is dead.
-          sd[i].first = sd_client[i]->client_dead ? nullptr : sd_client[i];
-          sd[i].second.position = sd_client[i]->pos_client;
-        }
-      }
-    }
-    BA_DEBUG_TIME_CHECK_END(bg_dynamic_shadow_list_lock, 10);
+  // These lists only ever change in the logic thread, and the server
+  // receives adds/removes through the same queue as steps, so anything we
+  // include here is guaranteed to still be alive when the step runs.
+  d->shadow_step_data_.resize(shadows_.size());
+  for (size_t i = 0; i < shadows_.size(); i++) {
+    auto& sd{d->shadow_step_data_[i]};
+    sd.first = shadows_[i];
+    sd.second.position = shadows_[i]->pos_client;
   }
-  {  // Volume lights.
-    BA_DEBUG_TIME_CHECK_BEGIN(bg_dynamic_volumelights_list_lock);
-    {
-      std::scoped_lock lock(
-          g_base->bg_dynamics_server->volume_light_list_mutex());
-      auto size = g_base->bg_dynamics_server->volume_lights().size();
-      d->volume_light_step_data_.resize(size);
-      if (size > 0) {
-        auto vd_client = &(g_base->bg_dynamics_server->volume_lights()[0]);
-        std::pair<BGDynamicsVolumeLightData*,
-                  BGDynamicsServer::VolumeLightStepData>* vd =
-            &(d->volume_light_step_data_[0]);
-        for (size_t i = 0; i < size; i++) {
-          // Set to nullptr (for ignore) if the client side is dead.
-          vd[i].first = vd_client[i]->client_dead ? nullptr : vd_client[i];
-          vd[i].second.pos = vd_client[i]->pos_client;
-          vd[i].second.radius = vd_client[i]->radius_client;
-          vd[i].second.r = vd_client[i]->r_client;
-          vd[i].second.g = vd_client[i]->g_client;
-          vd[i].second.b = vd_client[i]->b_client;
-        }
-      }
-    }
-    BA_DEBUG_TIME_CHECK_END(bg_dynamic_volumelights_list_lock, 10);
+  d->volume_light_step_data_.resize(volume_lights_.size());
+  for (size_t i = 0; i < volume_lights_.size(); i++) {
+    auto& vd{d->volume_light_step_data_[i]};
+    BGDynamicsVolumeLightData* light{volume_lights_[i]};
+    vd.first = light;
+    vd.second.pos = light->pos_client;
+    vd.second.radius = light->radius_client;
+    vd.second.r = light->r_client;
+    vd.second.g = light->g_client;
+    vd.second.b = light->b_client;
   }
-  {  // Fuses.
-    BA_DEBUG_TIME_CHECK_BEGIN(bg_dynamic_fuse_list_lock);
-    {
-      std::scoped_lock lock(g_base->bg_dynamics_server->fuse_list_mutex());
-      auto size = g_base->bg_dynamics_server->fuses().size();
-      d->fuse_step_data_.resize(size);
-      if (size > 0) {
-        auto fd_client = &(g_base->bg_dynamics_server->fuses()[0]);
-        std::pair<BGDynamicsFuseData*, BGDynamicsServer::FuseStepData>* fd =
-            &(d->fuse_step_data_[0]);
-        for (size_t i = 0; i < size; i++) {
-          // Set to nullptr (for ignore) if the client side is dead.
-          fd[i].first = fd_client[i]->client_dead_ ? nullptr : fd_client[i];
-          fd[i].second.transform = fd_client[i]->transform_client_;
-          fd[i].second.have_transform = fd_client[i]->have_transform_client_;
-          fd[i].second.length = fd_client[i]->length_client_;
-        }
-      }
-    }
-    BA_DEBUG_TIME_CHECK_END(bg_dynamic_fuse_list_lock, 10);
+  d->fuse_step_data_.resize(fuses_.size());
+  for (size_t i = 0; i < fuses_.size(); i++) {
+    auto& fd{d->fuse_step_data_[i]};
+    BGDynamicsFuseData* fuse{fuses_[i]};
+    fd.first = fuse;
+    fd.second.transform = fuse->transform_client_;
+    fd.second.have_transform = fuse->have_transform_client_;
+    fd.second.length = fuse->length_client_;
   }
 
   // Ok send the thread on its way.
   g_base->bg_dynamics_server->PushStep(d);
 }
 
-void BGDynamics::SetDrawSnapshot(BGDynamicsDrawSnapshot* s) {
+void BGDynamics::SetDrawSnapshot_(BGDynamicsDrawSnapshot* s) {
   // We were passed a raw pointer; assign it to our unique_ptr which will
   // take ownership of it and handle disposing it when we get the next one.
+  s->SetLogicThreadOwnership();
   draw_snapshot_ = std::unique_ptr<BGDynamicsDrawSnapshot>(s);
 }
 
+template <typename T>
+static void RemoveClientData(std::vector<T*>* list, T* data) {
+  auto i = std::find(list->begin(), list->end(), data);
+  assert(i != list->end());
+  if (i != list->end()) {
+    list->erase(i);
+  }
+}
+
+void BGDynamics::AddShadow(BGDynamicsShadowData* data) {
+  assert(g_base->InLogicThread());
+  shadows_.push_back(data);
+  g_base->bg_dynamics_server->PushAddShadowCall(data);
+}
+
+void BGDynamics::RemoveShadow(BGDynamicsShadowData* data) {
+  assert(g_base->InLogicThread());
+  RemoveClientData(&shadows_, data);
+  g_base->bg_dynamics_server->PushRemoveShadowCall(data);
+}
+
+void BGDynamics::AddVolumeLight(BGDynamicsVolumeLightData* data) {
+  assert(g_base->InLogicThread());
+  volume_lights_.push_back(data);
+  g_base->bg_dynamics_server->PushAddVolumeLightCall(data);
+}
+
+void BGDynamics::RemoveVolumeLight(BGDynamicsVolumeLightData* data) {
+  assert(g_base->InLogicThread());
+  RemoveClientData(&volume_lights_, data);
+  g_base->bg_dynamics_server->PushRemoveVolumeLightCall(data);
+}
+
+void BGDynamics::AddFuse(BGDynamicsFuseData* data) {
+  assert(g_base->InLogicThread());
+  fuses_.push_back(data);
+  g_base->bg_dynamics_server->PushAddFuseCall(data);
+}
+
+void BGDynamics::RemoveFuse(BGDynamicsFuseData* data) {
+  assert(g_base->InLogicThread());
+  RemoveClientData(&fuses_, data);
+  g_base->bg_dynamics_server->PushRemoveFuseCall(data);
+}
+
 void BGDynamics::TooSlow() {
   if (!EventLoop::AreEventLoopsSuspended()) {
     g_base->bg_dynamics_server->PushTooSlowCall();
@@ -177,6 +190,11 @@ void BGDynamics::SetDebrisKillHeight(float val) {
 void BGDynamics::Draw(FrameDef* frame_def) {
   assert(g_base->InLogicThread());
 
+  // Pick up the newest snapshot the server has finished (if any).
+  if (auto* snapshot = g_base->bg_dynamics_server->TakeDrawSnapshot()) {
+    SetDrawSnapshot_(snapshot);
+  }
+
   BGDynamicsDrawSnapshot* ds{draw_snapshot_.get()};
   if (!ds) {
     return;
@@ -202,6 +220,37 @@ void BGDynamics::Draw(FrameDef* frame_def) {
     c.Submit();
   }
 
+  // Draw GPU-animated sparks. We only upload new data when the set of
+  // sparks changes; otherwise we just redraw at the latest step.
+  if (ds->gpu_sparks) {
+    if (ds->gpu_sparks_changed) {
+      ds->gpu_sparks_changed = false;
+      have_gpu_sparks_ = ds->gpu_spark_vertices.exists();
+      if (have_gpu_sparks_) {
+        if (!gpu_sparks_mesh_.exists()) {
+          gpu_sparks_mesh_ = Object::New<ParticleMesh>();
+        }
+        gpu_sparks_mesh_->SetIndexData(ds->gpu_spark_indices);
+        gpu_sparks_mesh_->SetData(Object::Ref<MeshBuffer<VertexParticle>>(
+            ds->gpu_spark_vertices));
+      }
+    }
+    if (have_gpu_sparks_) {
+      bool draw_in_overlay = frame_def->quality() >= GraphicsQuality::kHigh;
+      SpriteComponent c(draw_in_overlay ? frame_def->overlay_3d_pass()
+                                        : frame_def->beauty_pass());
+      c.SetCameraAligned(true);
+      c.SetColor(2.0f, 2.0f, 2.0f, 1.0f);
+      c.SetOverlay(draw_in_overlay);
+      c.SetParticleStep(ds->gpu_spark_step);
+      c.SetTexture(g_base->assets->SysTexture(SysTextureID::kSparks));
+      c.DrawMesh(gpu_sparks_mesh_.get(), kMeshDrawFlagNoReflection);
+      c.Submit();
+    }
+  } else {
+    have_gpu_sparks_ = false;
+  }
+
   // Draw lights.
   if (ds->light_vertices.exists()) {
     assert(ds->light_indices.exists());
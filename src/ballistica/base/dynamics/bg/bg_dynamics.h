@@ -65,18 +65,30 @@ class BGDynamics {
   void AddTerrain(CollisionMeshAsset* o);
   void RemoveTerrain(CollisionMeshAsset* o);
 
-  // (sent to us by the bg dynamics server)
-  void SetDrawSnapshot(BGDynamicsDrawSnapshot* s);
+  // Client data registration. We keep our own lists of these so that
+  // building step data never has to touch the server's.
+  void AddShadow(BGDynamicsShadowData* data);
+  void RemoveShadow(BGDynamicsShadowData* data);
+  void AddVolumeLight(BGDynamicsVolumeLightData* data);
+  void RemoveVolumeLight(BGDynamicsVolumeLightData* data);
+  void AddFuse(BGDynamicsFuseData* data);
+  void RemoveFuse(BGDynamicsFuseData* data);
 
  private:
+  void SetDrawSnapshot_(BGDynamicsDrawSnapshot* s);
   void DrawChunks(FrameDef* frame_def, std::vector<Matrix44f>* instances,
                   BGDynamicsChunkType chunk_type);
   Object::Ref<SpriteMesh> lights_mesh_;
   Object::Ref<SpriteMesh> shadows_mesh_;
   Object::Ref<SpriteMesh> sparks_mesh_;
+  Object::Ref<ParticleMesh> gpu_sparks_mesh_;
+  bool have_gpu_sparks_{};
   Object::Ref<MeshIndexedSmokeFull> tendrils_mesh_;
   Object::Ref<MeshIndexedSimpleFull> fuses_mesh_;
   std::unique_ptr<BGDynamicsDrawSnapshot> draw_snapshot_;
+  std::vector<BGDynamicsShadowData*> shadows_;
+  std::vector<BGDynamicsVolumeLightData*> volume_lights_;
+  std::vector<BGDynamicsFuseData*> fuses_;
 };
 
 }  // namespace ballistica::base
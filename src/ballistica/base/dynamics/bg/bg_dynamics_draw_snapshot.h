@@ -5,6 +5,7 @@
 
 #include <vector>
 
+#include "ballistica/base/graphics/mesh/mesh_buffer_vertex_particle.h"
 #include "ballistica/base/graphics/mesh/mesh_buffer_vertex_simple_full.h"
 #include "ballistica/base/graphics/mesh/mesh_buffer_vertex_smoke_full.h"
 #include "ballistica/base/graphics/mesh/mesh_buffer_vertex_sprite.h"
@@ -37,7 +38,9 @@ class BGDynamicsDrawSnapshot {
                         static_cast<Object*>(light_indices.get()),
                         static_cast<Object*>(light_vertices.get()),
                         static_cast<Object*>(spark_indices.get()),
-                        static_cast<Object*>(spark_vertices.get())}) {
+                        static_cast<Object*>(spark_vertices.get()),
+                        static_cast<Object*>(gpu_spark_indices.get()),
+                        static_cast<Object*>(gpu_spark_vertices.get())}) {
         if (o) {
           o->SetThreadOwnership(Object::ThreadOwnership::kClassDefault);
         }
@@ -75,6 +78,15 @@ class BGDynamicsDrawSnapshot {
   // Sparks.
   Object::Ref<MeshIndexBuffer16> spark_indices;
   Object::Ref<MeshBufferVertexSprite> spark_vertices;
+
+  // GPU-animated sparks. Buffers are only provided when gpu_sparks_changed
+  // is set; otherwise whatever was last provided should be drawn at the
+  // new step.
+  Object::Ref<MeshIndexBuffer16> gpu_spark_indices;
+  Object::Ref<MeshBufferVertexParticle> gpu_spark_vertices;
+  float gpu_spark_step{};
+  bool gpu_sparks{};
+  bool gpu_sparks_changed{};
 };
 
 }  // namespace ballistica::base
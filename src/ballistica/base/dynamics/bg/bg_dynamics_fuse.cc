@@ -2,29 +2,28 @@
 
 #include "ballistica/base/dynamics/bg/bg_dynamics_fuse.h"
 
+#include "ballistica/base/dynamics/bg/bg_dynamics.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics_fuse_data.h"
 
 namespace ballistica::base {
 
 BGDynamicsFuse::BGDynamicsFuse() {
-  assert(g_base->bg_dynamics_server);
+  assert(g_base->bg_dynamics);
   assert(g_base->InLogicThread());
 
   // Allocate our data. We'll pass this to the BGDynamics thread, and
   // it'll then own it.
   data_ = new BGDynamicsFuseData();
-  g_base->bg_dynamics_server->PushAddFuseCall(data_);
+  g_base->bg_dynamics->AddFuse(data_);
 }
 
 BGDynamicsFuse::~BGDynamicsFuse() {
-  assert(g_base->bg_dynamics_server);
+  assert(g_base->bg_dynamics);
   assert(g_base->InLogicThread());
 
-  // Let the data know the client side is dead
-  // so that we're no longer included in step messages.
-  // (since by the time the worker gets it the data will be gone).
-  data_->client_dead_ = true;
-  g_base->bg_dynamics_server->PushRemoveFuseCall(data_);
+  // This drops us from step messages immediately and from the worker once
+  // it gets around to it (at which point the data will be gone).
+  g_base->bg_dynamics->RemoveFuse(data_);
 }
 
 void BGDynamicsFuse::SetTransform(const Matrix44f& t) {
@@ -92,7 +92,6 @@ struct BGDynamicsFuseData {
     }
   }
 
-  bool client_dead_{};
   float seg_len_{};
   Vector3f target_pts_[kFusePointCount]{};
   Vector3f dyn_pts_[kFusePointCount]{};
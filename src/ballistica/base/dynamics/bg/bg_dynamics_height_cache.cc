@@ -31,7 +31,7 @@ auto BGDynamicsHeightCache::SampleCell(int x, int z) -> float {
   int index = z * grid_width_ + x;
   assert(index >= 0 && index < static_cast<int>(heights_.size())
          && index < static_cast<int>(heights_valid_.size()));
-  if (heights_valid_[index]) {
+  if (heights_valid_[index] != kCellUnknown_) {
     return heights_[index];
   } else {
     Vector3f p(
@@ -46,6 +46,7 @@ auto BGDynamicsHeightCache::SampleCell(int x, int z) -> float {
     assert(shadow_ray_);
     dGeomSetPosition(shadow_ray_, p.x, p.y, p.z);
     float shadow_dist = y_max_ - y_min_;
+    bool hit{};
     for (auto& geom : geoms_) {
       dContact contact[1];
       if (dCollide(shadow_ray_, geom, kBGDynamicsHeightCacheMaxContacts,
@@ -53,21 +54,19 @@ auto BGDynamicsHeightCache::SampleCell(int x, int z) -> float {
         float len = p.y - contact[0].geom.pos[1];
         if (len < shadow_dist) {
           shadow_dist = len;
+          hit = true;
         }
       }
     }
     float height = y_max_ - shadow_dist;
     heights_[index] = height;
-    heights_valid_[index] = 1;
+    heights_valid_[index] = hit ? kCellHit_ : kCellEmpty_;
     return height;
   }
 }
 
-auto BGDynamicsHeightCache::Sample(const Vector3f& pos) -> float {
-  if (dirty_) {
-    Update();
-  }
-
+auto BGDynamicsHeightCache::GetCellBlend_(const Vector3f& pos) const
+    -> CellBlend_ {
   // Get sample point in grid coords.
   float x =
       static_cast<float>(grid_width_) * ((pos.x - x_min_) / (x_max_ - x_min_))
@@ -76,29 +75,75 @@ auto BGDynamicsHeightCache::Sample(const Vector3f& pos) -> float {
       static_cast<float>(grid_height_) * ((pos.z - z_min_) / (z_max_ - z_min_))
       - 0.5f;
 
-  // Sample the 4 contributing cells.
-  int x_min = static_cast<int>(floor(x));
-  x_min = std::max(0, std::min(grid_width_ - 1, x_min));
-  int x_max = static_cast<int>(ceil(x));
-  x_max = std::max(0, std::min(grid_width_ - 1, x_max));
-  float x_blend = fmod(x, 1.0f);
-  int z_min = static_cast<int>(floor(z));
-  z_min = std::max(0, std::min(grid_height_ - 1, z_min));
-  int z_max = static_cast<int>(ceil(z));
-  z_max = std::max(0, std::min(grid_height_ - 1, z_max));
-  float zBlend = fmod(z, 1.0f);
-
-  float xz = SampleCell(x_min, z_min);
-  float xZ = SampleCell(x_min, z_max);
-  float Xz = SampleCell(x_max, z_min);
-  float XZ = SampleCell(x_max, z_max);
+  // Find the 4 contributing cells.
+  CellBlend_ b{};
+  b.x_min = static_cast<int>(floor(x));
+  b.x_min = std::max(0, std::min(grid_width_ - 1, b.x_min));
+  b.x_max = static_cast<int>(ceil(x));
+  b.x_max = std::max(0, std::min(grid_width_ - 1, b.x_max));
+  b.x_blend = fmod(x, 1.0f);
+  b.z_min = static_cast<int>(floor(z));
+  b.z_min = std::max(0, std::min(grid_height_ - 1, b.z_min));
+  b.z_max = static_cast<int>(ceil(z));
+  b.z_max = std::max(0, std::min(grid_height_ - 1, b.z_max));
+  b.z_blend = fmod(z, 1.0f);
+  return b;
+}
+
+auto BGDynamicsHeightCache::Sample(const Vector3f& pos) -> float {
+  if (dirty_) {
+    Update();
+  }
+
+  CellBlend_ b{GetCellBlend_(pos)};
+  float xz = SampleCell(b.x_min, b.z_min);
+  float xZ = SampleCell(b.x_min, b.z_max);
+  float Xz = SampleCell(b.x_max, b.z_min);
+  float XZ = SampleCell(b.x_max, b.z_max);
 
   // Weighted blend per row.
-  float zFin = xz * (1.0f - x_blend) + Xz * x_blend;
-  float ZFin = xZ * (1.0f - x_blend) + XZ * x_blend;
+  float zFin = xz * (1.0f - b.x_blend) + Xz * b.x_blend;
+  float ZFin = xZ * (1.0f - b.x_blend) + XZ * b.x_blend;
 
   // Weighted blend of the two rows.
-  return zFin * (1.0f - zBlend) + ZFin * zBlend;
+  return zFin * (1.0f - b.z_blend) + ZFin * b.z_blend;
+}
+
+auto BGDynamicsHeightCache::SampleSurface(const Vector3f& pos, float* height,
+                                          Vector3f* normal) -> bool {
+  assert(height && normal);
+  if (dirty_) {
+    Update();
+  }
+
+  // Outside of our grid we've got nothing to say.
+  if (pos.x < x_min_ || pos.x > x_max_ || pos.z < z_min_ || pos.z > z_max_) {
+    return false;
+  }
+
+  CellBlend_ b{GetCellBlend_(pos)};
+  float xz = SampleCell(b.x_min, b.z_min);
+  float xZ = SampleCell(b.x_min, b.z_max);
+  float Xz = SampleCell(b.x_max, b.z_min);
+  float XZ = SampleCell(b.x_max, b.z_max);
+  if (!CellHit_(b.x_min, b.z_min) || !CellHit_(b.x_min, b.z_max)
+      || !CellHit_(b.x_max, b.z_min) || !CellHit_(b.x_max, b.z_max)) {
+    return false;
+  }
+  float zFin = xz * (1.0f - b.x_blend) + Xz * b.x_blend;
+  float ZFin = xZ * (1.0f - b.x_blend) + XZ * b.x_blend;
+  *height = zFin * (1.0f - b.z_blend) + ZFin * b.z_blend;
+
+  // Slope of our bilinear patch (zero along clamped edges).
+  float cell_width = (x_max_ - x_min_) / static_cast<float>(grid_width_);
+  float cell_depth = (z_max_ - z_min_) / static_cast<float>(grid_height_);
+  float dhdx = b.x_max != b.x_min ? ((Xz - xz) * (1.0f - b.z_blend)
+                                     + (XZ - xZ) * b.z_blend)
+                                        / cell_width
+                                  : 0.0f;
+  float dhdz = b.z_max != b.z_min ? (ZFin - zFin) / cell_depth : 0.0f;
+  *normal = Vector3f(-dhdx, 1.0f, -dhdz).Normalized();
+  return true;
 }
 
 void BGDynamicsHeightCache::SetGeoms(const std::vector<dGeomID>& geoms) {
@@ -17,11 +17,31 @@ class BGDynamicsHeightCache {
   BGDynamicsHeightCache();
   ~BGDynamicsHeightCache();
   auto Sample(const Vector3f& pos) -> float;
+
+  /// Sample height along with a surface normal (from the local slope of
+  /// the height map). Returns false if there is no surface at all under
+  /// some part of the sampled area (in which case outputs are undefined).
+  auto SampleSurface(const Vector3f& pos, float* height, Vector3f* normal)
+      -> bool;
   void SetGeoms(const std::vector<dGeomID>& geoms);
 
  private:
+  struct CellBlend_ {
+    int x_min, x_max, z_min, z_max;
+    float x_blend, z_blend;
+  };
   auto SampleCell(int x, int y) -> float;
+  auto GetCellBlend_(const Vector3f& pos) const -> CellBlend_;
+  auto CellHit_(int x, int z) const -> bool {
+    return heights_valid_[z * grid_width_ + x] == kCellHit_;
+  }
   void Update();
+
+  // Values for heights_valid_.
+  static constexpr uint8_t kCellUnknown_{0};
+  static constexpr uint8_t kCellHit_{1};
+  static constexpr uint8_t kCellEmpty_{2};
+
   std::vector<dGeomID> geoms_;
   std::vector<float> heights_;
   std::vector<uint8_t> heights_valid_;
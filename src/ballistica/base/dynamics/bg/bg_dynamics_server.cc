@@ -3,8 +3,10 @@
 #include "ballistica/base/dynamics/bg/bg_dynamics_server.h"
 
 #include <algorithm>
-#include <list>
+#include <cmath>
+#include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/assets/collision_mesh_asset.h"
@@ -17,7 +19,9 @@
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/core/platform/core_platform.h"  // IWYU pragma: keep.
+#include "ballistica/core/support/thread_trace.h"
 #include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/foundation/job_system.h"
 #include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::base {
@@ -36,6 +40,27 @@ const float kShadowOccludeDistance = 0.5f;
 // How big the shadow gets at its max dist.
 const float kMaxShadowScale = 3.0f;
 
+// Debris up to this size can collide against our height cache instead of
+// the actual terrain geometry...
+const float kHeightCacheCollideMaxSize = 0.2f;
+
+// ...as long as the surface there isn't too steep...
+const float kHeightCacheCollideMinNormalY = 0.7f;
+
+// ...and we're not too far below it (under an overhang or whatnot).
+const float kHeightCacheCollideMaxDepth = 0.3f;
+
+// Lowest our adaptive detail scale will go.
+const float kMinQualityScale = 0.2f;
+
+// How far (in multiples of their radius) volume lights reach smoke.
+const float kVolumeLightReach = 9.0f;
+
+// Smallest and most numerous cells we bin volume lights into along x/z so
+// smoke points only look at lights that can reach them.
+const float kVolumeLightCellSize = 2.0f;
+const int kVolumeLightGridMaxCells = 32;
+
 const float kSmokeBaseGlow = 0.0f;
 const float kSmokeGlow = 400.0f;
 
@@ -200,10 +225,10 @@ class BGDynamicsServer::Tendril {
 
     void UpdateGlow(const BGDynamicsServer& d, float glow_scale) {
       glow_r = glow_g = glow_b = 0.0f;
-      for (auto&& li : d.volume_lights_) {
+      for (auto&& li : d.VolumeLightsAt_(p)) {
         BGDynamicsVolumeLightData& l(*li);
         Vector3f& pLight(l.pos_worker);
-        float light_rad = l.radius_worker * 9.0f;  // Let's grow it a bit.
+        float light_rad = l.radius_worker * kVolumeLightReach;
         float light_rad_squared = light_rad * light_rad;
         float dist_squared = (pLight - p).LengthSquared();
         if (dist_squared <= light_rad_squared) {
@@ -349,7 +374,7 @@ class BGDynamicsServer::Tendril {
   float glow_scale_{};
   bool emitting_{};
   bool has_updated_{};
-  std::list<Slice> slices_{};
+  std::deque<Slice> slices_{};
   Slice cur_slice_{};
   Vector3f position_{0.0f, 0.0f, 0.0f};
   Vector3f prev_pos_{0.0f, 0.0f, 0.0f};
@@ -506,31 +531,94 @@ class BGDynamicsServer::Chunk {
   friend class BGDynamicsServer;
 };  // Chunk
 
-// Contains 2 ping-ponging particle buffers.
 void BGDynamicsServer::ParticleSet::Emit(const Vector3f& pos,
                                          const Vector3f& vel, float r, float g,
                                          float b, float a, float dlife,
                                          float size, float d_size,
                                          float flicker) {
-  particles[current_set].resize(particles[current_set].size() + 1);
-  Particle& p(particles[current_set].back());
-  p.x = pos.x;
-  p.y = pos.y;
-  p.z = pos.z;
-  p.vx = vel.x * 1.0f + 0.02f * (RandomFloat() - 0.5f);
-  p.vy = vel.y * 1.0f + 0.02f * (RandomFloat() - 0.5f);
-  p.vz = vel.z * 1.0f + 0.02f * (RandomFloat() - 0.5f);
-  p.r = r;
-  p.g = g;
-  p.b = b;
-  p.a = a;
-  p.life = 1.0f;
   assert(dlife < 0.0f);
-  p.d_life = dlife;
-  p.size = size;
-  p.flicker = 1.0f;
-  p.flicker_scale = flicker;
-  p.d_size = d_size;
+  if (gpu_animated_) {
+    EmitGPU_(pos, vel, r, g, b, a, dlife, size, d_size, flicker);
+    return;
+  }
+  if (x_.size() >= kMaxParticles) {
+    return;
+  }
+  x_.push_back(pos.x);
+  y_.push_back(pos.y);
+  z_.push_back(pos.z);
+  vx_.push_back(vel.x * 1.0f + 0.02f * (RandomFloat() - 0.5f));
+  vy_.push_back(vel.y * 1.0f + 0.02f * (RandomFloat() - 0.5f));
+  vz_.push_back(vel.z * 1.0f + 0.02f * (RandomFloat() - 0.5f));
+  r_.push_back(r);
+  g_.push_back(g);
+  b_.push_back(b);
+  a_.push_back(a);
+  life_.push_back(1.0f);
+  d_life_.push_back(dlife);
+  flicker_.push_back(1.0f);
+  flicker_scale_.push_back(flicker);
+  size_.push_back(size);
+  d_size_.push_back(d_size);
+}
+
+void BGDynamicsServer::ParticleSet::EmitGPU_(const Vector3f& pos,
+                                             const Vector3f& vel, float r,
+                                             float g, float b, float a,
+                                             float dlife, float size,
+                                             float d_size, float flicker) {
+  if (gpu_particles_.size() >= kMaxParticles) {
+    return;
+  }
+  GPUParticle_ p{};
+  VertexParticle& v{p.vertex};
+  v.position[0] = pos.x;
+  v.position[1] = pos.y;
+  v.position[2] = pos.z;
+  v.size = size;
+  v.color[0] = r;
+  v.color[1] = g;
+  v.color[2] = b;
+  v.color[3] = a;
+  v.velocity[0] = vel.x * 1.0f + 0.02f * (RandomFloat() - 0.5f);
+  v.velocity[1] = vel.y * 1.0f + 0.02f * (RandomFloat() - 0.5f);
+  v.velocity[2] = vel.z * 1.0f + 0.02f * (RandomFloat() - 0.5f);
+  v.velocity[3] = RandomFloat();
+  v.params[1] = dlife;
+  v.params[2] = d_size;
+  v.params[3] = flicker;
+
+  // Our state is a closed-form function of age, so we can work out
+  // exactly which step we die on (the same one the CPU path would cull
+  // us on).
+  p.birth_step = step_;
+  auto life_steps = static_cast<int64_t>(std::ceil(-1.0f / dlife));
+  if (size <= 0.0f) {
+    life_steps = 1;
+  } else if (d_size < 0.0f) {
+    life_steps = std::min(
+        life_steps, static_cast<int64_t>(std::ceil(size / -d_size)));
+  }
+  p.death_step = p.birth_step + std::max(int64_t{1}, life_steps);
+  gpu_particles_.push_back(p);
+  gpu_dirty_ = true;
+}
+
+void BGDynamicsServer::ParticleSet::SetGPUAnimated(bool val) {
+  if (val == gpu_animated_) {
+    return;
+  }
+  gpu_animated_ = val;
+  gpu_particles_.clear();
+  Resize_(0);
+  gpu_dirty_ = true;
+}
+
+void BGDynamicsServer::ParticleSet::Resize_(size_t size) {
+  for (auto* v : {&x_, &y_, &z_, &vx_, &vy_, &vz_, &r_, &g_, &b_, &a_, &life_,
+                  &d_life_, &flicker_, &flicker_scale_, &size_, &d_size_}) {
+    v->resize(size);
+  }
 }
 
 void BGDynamicsServer::ParticleSet::UpdateAndCreateSnapshot(
@@ -538,18 +626,37 @@ void BGDynamicsServer::ParticleSet::UpdateAndCreateSnapshot(
     Object::Ref<MeshBufferVertexSprite>* buffer) {
   assert(g_base->InBGDynamicsThread());
 
-  auto p_count = static_cast<uint32_t>(particles[current_set].size());
+  auto p_count = static_cast<uint32_t>(size());
 
   // Quick-out: return empty.
   if (p_count == 0) {
     return;
   }
 
-  Particle* p_src = &particles[current_set][0];
-
-  // Resize target to fit if all particles stay alive.
-  particles[!current_set].resize(particles[current_set].size());
-  Particle* p_dst = &particles[!current_set][0];
+  // Integrate and fade everything in bulk. These loops touch a few
+  // independent arrays each and vectorize nicely.
+  {
+    float* __restrict x = x_.data();
+    float* __restrict y = y_.data();
+    float* __restrict z = z_.data();
+    float* __restrict vy = vy_.data();
+    const float* __restrict vx = vx_.data();
+    const float* __restrict vz = vz_.data();
+    for (uint32_t i = 0; i < p_count; i++) {
+      x[i] += vx[i];
+      y[i] += vy[i];
+      z[i] += vz[i];
+      vy[i] -= 0.00001f;
+    }
+    float* __restrict life = life_.data();
+    float* __restrict psize = size_.data();
+    const float* __restrict d_life = d_life_.data();
+    const float* __restrict d_size = d_size_.data();
+    for (uint32_t i = 0; i < p_count; i++) {
+      life[i] += d_life[i];
+      psize[i] = std::max(0.0f, psize[i] + d_size[i]);
+    }
+  }
 
   auto* ibuf = Object::NewDeferred<MeshIndexBuffer16>(p_count * 6);
   // Logic thread is default owner for this type. It needs to be us until
@@ -563,102 +670,98 @@ void BGDynamicsServer::ParticleSet::UpdateAndCreateSnapshot(
   vbuf->SetThreadOwnership(Object::ThreadOwnership::kNextReferencing);
   *buffer = Object::CompleteDeferred(vbuf);
 
+  // Now cull dead particles (compacting survivors down in place), update
+  // flicker, and write vertices for anything visible.
   uint16_t* i_render = &(*index_buffer)->elements[0];
   VertexSprite* p_render = &(*buffer)->elements[0];
   uint32_t p_index = 0;
   uint32_t p_count_remaining = 0;
   uint32_t p_count_rendered = 0;
   for (uint32_t i = 0; i < p_count; i++) {
-    float life = p_src->life + p_src->d_life;
-
-    // Our opacity drops rapidly at the end.
-    float o = 1.0f - life;
-    o = 1.0f - (o * o * o);
-    float size = std::max(0.0f, p_src->size + p_src->d_size);
+    float life = life_[i];
+    float size = size_[i];
 
     // Kill the particle if life or size falls to 0.
-    if (life > 0.0f && size > 0) {
-      p_count_remaining++;
-      p_dst->life = life;
-      p_dst->size = size;
-      p_dst->x = p_src->x + p_src->vx;
-      p_dst->y = p_src->y + p_src->vy;
-      p_dst->z = p_src->z + p_src->vz;
-      p_dst->r = p_src->r;
-      p_dst->g = p_src->g;
-      p_dst->b = p_src->b;
-      p_dst->a = p_src->a;
-      p_dst->vx = p_src->vx;
-      p_dst->vy = p_src->vy - 0.00001f;
-      p_dst->vz = p_src->vz;
-      p_dst->d_life = p_src->d_life;
-      p_dst->d_size = p_src->d_size;
-      p_dst->flicker_scale = p_src->flicker_scale;
-
-      // Every so often update our flicker value if we're flickering.
-      if (p_src->flicker_scale != 0.0f) {
-        if (RandomFloat() < 0.2f) {
-          p_dst->flicker = std::max(
-              0.0f, 1.0f + (RandomFloat() - 0.5f) * p_src->flicker_scale);
-        } else {
-          p_dst->flicker = p_src->flicker;
-        }
-      } else {
-        p_dst->flicker = 1.0f;
-      }
-
-      // Render this point if it's got a positive size.
-      if (p_dst->flicker > 0.0f && p_dst->size > 0.0f) {
-        p_count_rendered++;
-
-        // Add our 6 indices.
-        {
-          i_render[0] = static_cast<uint16_t>(p_index);
-          i_render[1] = static_cast<uint16_t>(p_index + 1);
-          i_render[2] = static_cast<uint16_t>(p_index + 2);
-          i_render[3] = static_cast<uint16_t>(p_index + 1);
-          i_render[4] = static_cast<uint16_t>(p_index + 3);
-          i_render[5] = static_cast<uint16_t>(p_index + 2);
-        }
-
-        p_render[0].uv[0] = 0;
-        p_render[0].uv[1] = 0;
-        p_render[1].uv[0] = 0;
-        p_render[1].uv[1] = 65535;
-        p_render[2].uv[0] = 65535;
-        p_render[2].uv[1] = 0;
-        p_render[3].uv[0] = 65535;
-        p_render[3].uv[1] = 65535;
-
-        p_render[0].position[0] = p_render[1].position[0] =
-            p_render[2].position[0] = p_render[3].position[0] = p_dst->x;
-        p_render[0].position[1] = p_render[1].position[1] =
-            p_render[2].position[1] = p_render[3].position[1] = p_dst->y;
-        p_render[0].position[2] = p_render[1].position[2] =
-            p_render[2].position[2] = p_render[3].position[2] = p_dst->z;
-        p_render[0].size = p_render[1].size = p_render[2].size =
-            p_render[3].size = p_dst->size * p_dst->flicker;
-        p_render[0].color[0] = p_render[1].color[0] = p_render[2].color[0] =
-            p_render[3].color[0] = p_dst->r * o;
-        p_render[0].color[1] = p_render[1].color[1] = p_render[2].color[1] =
-            p_render[3].color[1] = p_dst->g * o;
-        p_render[0].color[2] = p_render[1].color[2] = p_render[2].color[2] =
-            p_render[3].color[2] = p_dst->b * o;
-        p_render[0].color[3] = p_render[1].color[3] = p_render[2].color[3] =
-            p_render[3].color[3] = p_dst->a * o;
-
-        i_render += 6;
-        p_render += 4;
-        p_index += 4;
+    if (!(life > 0.0f && size > 0.0f)) {
+      continue;
+    }
+    uint32_t d = p_count_remaining++;
+    if (d != i) {
+      x_[d] = x_[i];
+      y_[d] = y_[i];
+      z_[d] = z_[i];
+      vx_[d] = vx_[i];
+      vy_[d] = vy_[i];
+      vz_[d] = vz_[i];
+      r_[d] = r_[i];
+      g_[d] = g_[i];
+      b_[d] = b_[i];
+      a_[d] = a_[i];
+      life_[d] = life;
+      d_life_[d] = d_life_[i];
+      flicker_[d] = flicker_[i];
+      flicker_scale_[d] = flicker_scale_[i];
+      size_[d] = size;
+      d_size_[d] = d_size_[i];
+    }
+
+    // Every so often update our flicker value if we're flickering.
+    if (flicker_scale_[d] != 0.0f) {
+      if (RandomFloat() < 0.2f) {
+        flicker_[d] = std::max(
+            0.0f, 1.0f + (RandomFloat() - 0.5f) * flicker_scale_[d]);
       }
-      p_dst++;
+    } else {
+      flicker_[d] = 1.0f;
+    }
+
+    // Render this point if it's got a positive size.
+    float flicker = flicker_[d];
+    if (flicker > 0.0f) {
+      p_count_rendered++;
+
+      // Our opacity drops rapidly at the end.
+      float o = 1.0f - life;
+      o = 1.0f - (o * o * o);
+
+      // Add our 6 indices.
+      i_render[0] = static_cast<uint16_t>(p_index);
+      i_render[1] = static_cast<uint16_t>(p_index + 1);
+      i_render[2] = static_cast<uint16_t>(p_index + 2);
+      i_render[3] = static_cast<uint16_t>(p_index + 1);
+      i_render[4] = static_cast<uint16_t>(p_index + 3);
+      i_render[5] = static_cast<uint16_t>(p_index + 2);
+
+      // Our 4 corners differ only in uv.
+      VertexSprite v;
+      v.position[0] = x_[d];
+      v.position[1] = y_[d];
+      v.position[2] = z_[d];
+      v.size = size * flicker;
+      v.color[0] = r_[d] * o;
+      v.color[1] = g_[d] * o;
+      v.color[2] = b_[d] * o;
+      v.color[3] = a_[d] * o;
+      v.uv[0] = 0;
+      v.uv[1] = 0;
+      p_render[0] = v;
+      v.uv[1] = 65535;
+      p_render[1] = v;
+      v.uv[0] = 65535;
+      v.uv[1] = 0;
+      p_render[2] = v;
+      v.uv[1] = 65535;
+      p_render[3] = v;
+
+      i_render += 6;
+      p_render += 4;
+      p_index += 4;
     }
-    p_src++;
   }
 
-  // Clamp dst and render sets to account for deaths.
+  // Clamp our arrays and render sets to account for deaths.
   if (p_count != p_count_remaining) {
-    particles[!current_set].resize(p_count_remaining);
+    Resize_(p_count_remaining);
   }
 
   if (p_count != p_count_rendered) {
@@ -672,7 +775,84 @@ void BGDynamicsServer::ParticleSet::UpdateAndCreateSnapshot(
       (*buffer)->elements.resize(p_count_rendered * 4);
     }
   }
-  current_set = !current_set;
+}
+
+void BGDynamicsServer::ParticleSet::UpdateAndCreateGPUSnapshot(
+    Object::Ref<MeshIndexBuffer16>* index_buffer,
+    Object::Ref<MeshBufferVertexParticle>* buffer, float* step,
+    bool* changed) {
+  assert(g_base->InBGDynamicsThread());
+  assert(gpu_animated_);
+  assert(step && changed);
+
+  step_++;
+
+  // Cull anything that has run its course. This is the only per-particle
+  // work we do on the CPU in this mode.
+  auto new_end = std::remove_if(
+      gpu_particles_.begin(), gpu_particles_.end(),
+      [this](const GPUParticle_& p) { return p.death_step <= step_; });
+  if (new_end != gpu_particles_.end()) {
+    gpu_particles_.erase(new_end, gpu_particles_.end());
+    gpu_dirty_ = true;
+  }
+
+  *changed = gpu_dirty_;
+  if (gpu_dirty_) {
+    gpu_dirty_ = false;
+
+    // Rebase birth steps whenever we rebuild so values we hand the GPU
+    // stay small enough to be exact as floats.
+    gpu_base_step_ = step_;
+    auto p_count = static_cast<uint32_t>(gpu_particles_.size());
+    if (p_count == 0) {
+      *index_buffer = Object::Ref<MeshIndexBuffer16>();
+      *buffer = Object::Ref<MeshBufferVertexParticle>();
+    } else {
+      auto* ibuf = Object::NewDeferred<MeshIndexBuffer16>(p_count * 6);
+      // Logic thread is default owner for this type. It needs to be us
+      // until we hand it over, so set that up before creating the first
+      // ref.
+      ibuf->SetThreadOwnership(Object::ThreadOwnership::kNextReferencing);
+      *index_buffer = Object::CompleteDeferred(ibuf);
+
+      auto* vbuf = Object::NewDeferred<MeshBufferVertexParticle>(p_count * 4);
+      // Same here.
+      vbuf->SetThreadOwnership(Object::ThreadOwnership::kNextReferencing);
+      *buffer = Object::CompleteDeferred(vbuf);
+
+      uint16_t* i_render = &(*index_buffer)->elements[0];
+      VertexParticle* p_render = &(*buffer)->elements[0];
+      uint32_t p_index = 0;
+      for (auto&& p : gpu_particles_) {
+        i_render[0] = static_cast<uint16_t>(p_index);
+        i_render[1] = static_cast<uint16_t>(p_index + 1);
+        i_render[2] = static_cast<uint16_t>(p_index + 2);
+        i_render[3] = static_cast<uint16_t>(p_index + 1);
+        i_render[4] = static_cast<uint16_t>(p_index + 3);
+        i_render[5] = static_cast<uint16_t>(p_index + 2);
+
+        // Our 4 corners differ only in uv.
+        VertexParticle v{p.vertex};
+        v.params[0] = static_cast<float>(p.birth_step - gpu_base_step_);
+        v.uv[0] = 0;
+        v.uv[1] = 0;
+        p_render[0] = v;
+        v.uv[1] = 65535;
+        p_render[1] = v;
+        v.uv[0] = 65535;
+        v.uv[1] = 0;
+        p_render[2] = v;
+        v.uv[1] = 65535;
+        p_render[3] = v;
+
+        i_render += 6;
+        p_render += 4;
+        p_index += 4;
+      }
+    }
+  }
+  *step = static_cast<float>(step_ - gpu_base_step_);
 }
 
 BGDynamicsServer::BGDynamicsServer()
@@ -713,298 +893,399 @@ void BGDynamicsServer::UpdateFuses() {
   }
 }
 
-void BGDynamicsServer::UpdateTendrils() {
-  int render_slice_count = 0;
-
-  for (auto i = tendrils_.begin(); i != tendrils_.end();) {
-    Tendril& t(**i);
+// Run call(begin, end) over [0, count), spread across the job system if
+// we've got one.
+template <typename F>
+static void RunParallel(size_t count, const F& call) {
+  if (g_core->job_system) {
+    g_core->job_system->ParallelFor(count, 4, call);
+  } else if (count > 0) {
+    call(size_t{0}, count);
+  }
+}
 
-    // Kill off fully-dead tendrils.
-    if (!t.emitting_ && t.slices_.size() < 2) {
-      auto i_next = i;
-      i_next++;
-      if (t.type_ == BGDynamicsTendrilType::kThinSmoke) {
-        tendril_count_thin_--;
-      } else {
-        tendril_count_thick_--;
+void BGDynamicsServer::UpdateTendrils() {
+  // Kill off fully-dead tendrils (keeping survivors in order).
+  {
+    size_t out = 0;
+    for (auto* tendril : tendrils_) {
+      if (!tendril->emitting_ && tendril->slices_.size() < 2) {
+        if (tendril->type_ == BGDynamicsTendrilType::kThinSmoke) {
+          tendril_count_thin_--;
+        } else {
+          tendril_count_thick_--;
+        }
+        assert(tendril_count_thin_ >= 0 && tendril_count_thick_ >= 0);
+        delete tendril;
+        continue;
       }
-      assert(tendril_count_thin_ >= 0 && tendril_count_thick_ >= 0);
-      delete *i;
-      tendrils_.erase(i);
-      i = i_next;
-      continue;
+      tendrils_[out++] = tendril;
     }
+    tendrils_.resize(out);
+  }
 
-    // Clip transparent bits off the ends.
-    t.PruneSlices();
-
-    // Step existing tendril points.
-    t.UpdateSlices(this);
-
-    // Update the tendrils' physics if it is not being controlled.
-    if (t.controller_ == nullptr) {
-      t.prev_pos_ = t.position_;
-      t.velocity_ += Vector3f(0, -0.1f, 0);  // Gravity.
-      t.position_ += t.velocity_ * step_seconds_;
-    }
-
-    // If we're still emitting, potentially drop in some new slices.
-    if (t.emitting_) {
-      // Step from our last slice to our current position,
-      // dropping in new slices as we go.
-      Vector3f p = {0.0f, 0.0f, 0.0f};
-      float tex_coord{};
-      float emit_rate{};
-      float start_erode{};
-      float start_spread{};
-      int slice_count = static_cast<int>(t.slices_.size());
-      if (slice_count > 0) {
-        p = t.slices_.back().GetCenter();
-        tex_coord = t.slices_.back().p1.tex_coords[1];
-        emit_rate = t.slices_.back().emit_rate;
-        start_erode = t.slices_.back().start_erode;
-        start_spread = t.slices_.back().start_spread;
-      } else {
-        p = t.prev_pos_;
-        tex_coord = t.tex_coord_;
-        emit_rate = t.emit_rate_;
-        start_erode = t.start_erode_;
-        start_spread = t.start_spread_;
+  // Tendrils don't interact with each other, so the bulk of their work
+  // can be spread across the job system. Slice emission pulls from our
+  // (non-thread-safe) random source, so that part stays serial.
+  Tendril** tendrils{tendrils_.data()};
+  RunParallel(tendrils_.size(), [this, tendrils](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      Tendril& t(*tendrils[i]);
+
+      // Clip transparent bits off the ends.
+      t.PruneSlices();
+
+      // Step existing tendril points.
+      t.UpdateSlices(this);
+
+      // Update the tendrils' physics if it is not being controlled.
+      if (t.controller_ == nullptr) {
+        t.prev_pos_ = t.position_;
+        t.velocity_ += Vector3f(0, -0.1f, 0);  // Gravity.
+        t.position_ += t.velocity_ * step_seconds_;
       }
-      Vector3f march_dir = t.position_ - p;
-      float dist = march_dir.Length();
-
-      // We flip our shading depending on which way the tendril is pointing
-      // so that the light side is generally up.
-      float start_brightness{};
-      float start_brightness_2{};
-      if (t.shading_flip_) {
-        start_brightness = t.start_brightness_max_;
-        start_brightness_2 = t.start_brightness_min_;
-      } else {
-        start_brightness = t.start_brightness_min_;
-        start_brightness_2 = t.start_brightness_max_;
-      }
-
-      float start_brightness_rand = t.brightness_rand_;
-      float erode_rate_randomness = 0.5f;
-      float fade_rate_randomness = 2.0f;
-
-      if (dist > 0.001f) {
-        float span = 0.5f;
-        march_dir = march_dir.Normalized() * span;
-        Vector3f from_cam = cam_pos_ - p;
-        Vector3f side_vec = Vector3f::Cross(march_dir, from_cam).Normalized();
-
-        float inherit_velocity = 0.015f;
-
-        // If this is our first step, drop a span immediately.
-        if (!t.has_updated_) {
-          Vector3f r_uniform = Utils::Sphrand(0.2f * t.slice_rand_scale_);
-          float density = emit_rate > 0.1f ? 1.0f : emit_rate / 0.1f;
-
-          t.slices_.emplace_back();
-          Tendril::Slice& slice(t.slices_.back());
-          slice.emit_rate = emit_rate;
-          slice.start_erode = start_erode;
-          slice.start_spread = start_spread;
-          slice.p1.p = p - t.radius_ * side_vec * start_spread;
-          slice.p1.v = t.medium_velocity_ * 0.3f
-                       + t.velocity_ * inherit_velocity * 0.1f
-                       - side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
-                       + Utils::Sphrand(0.13f * t.point_rand_scale_);
-          slice.p1.tex_coords[0] = 0.0f;
-          slice.p1.tex_coords[1] = tex_coord;
-          slice.p1.erode = t.start_erode_;
-          slice.p1.erode_rate = std::max(
-              0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
-          slice.p1.age_ms = 0;
-          slice.p1.bouyancy = 0.3f + 0.2f * RandomFloat();
-          slice.p1.brightness = std::max(
-              0.0f, start_brightness
-                        + (RandomFloat() - 0.5f) * start_brightness_rand);
-          slice.p1.fade = 0.0f;
-          slice.p1.glow_r = slice.p1.glow_g = slice.p1.glow_b = 0.0f;
-          slice.p1.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
-
-          slice.p2.p = p + t.radius_ * side_vec * start_spread;
-          slice.p2.v = t.medium_velocity_ * 0.3f
-                       + t.velocity_ * inherit_velocity * 0.1f
-                       + side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
-                       + Utils::Sphrand(0.13f * t.point_rand_scale_);
-          slice.p2.tex_coords[0] = 0.25f;
-          slice.p2.tex_coords[1] = tex_coord;
-          slice.p2.erode = t.start_erode_;
-          slice.p2.erode_rate = std::max(
-              0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
-          slice.p2.age_ms = 0;
-          slice.p2.bouyancy = 0.3f + 0.2f * RandomFloat();
-          slice.p2.brightness = std::max(
-              0.0f, start_brightness_2
-                        + (RandomFloat() - 0.5f) * start_brightness_rand);
-          slice.p2.fade = 0.0f;
-          slice.p2.glow_r = slice.p2.glow_g = slice.p2.glow_b = 0.0f;
-          slice.p2.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
-        }
+    }
+  });
 
-        t.has_updated_ = true;
-        float tex_change_rate = 0.18f * t.tex_change_rate_;
-        float emit_change_rate = -0.4f * t.emit_rate_falloff_rate_;
-        float start_erode_change_rate = 1.0f;
-        float start_spread_change_rate = -0.35f;
-
-        // Reset our tex coord to that of the last span for marching purposes.
-        for (; dist > span; dist -= span) {  // NOLINT
-          p += march_dir;
-          tex_coord += span * tex_change_rate;
-          emit_rate = std::max(0.0f, emit_rate + span * emit_change_rate);
-          start_erode =
-              std::min(1.0f, start_erode + span * start_erode_change_rate);
-          start_spread =
-              std::max(1.0f, start_spread + span * start_spread_change_rate);
-
-          // General density stays high until emit rate gets low.
-          float density = emit_rate > 0.1f ? 1.0f : emit_rate / 0.1f;
-
-          Vector3f r_uniform = Utils::Sphrand(0.2f * t.slice_rand_scale_);
-          t.slices_.emplace_back();
-          Tendril::Slice& slice(t.slices_.back());
-          slice.emit_rate = emit_rate;
-          slice.start_erode = start_erode;
-          slice.start_spread = start_spread;
-          slice.p1.p = p - t.radius_ * side_vec * start_spread;
-          slice.p1.v = t.medium_velocity_ * 0.3f
-                       + t.velocity_ * inherit_velocity
-                       - side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
-                       + Utils::Sphrand(0.2f * t.point_rand_scale_);
-          slice.p1.tex_coords[0] = 0.0f;
-          slice.p1.tex_coords[1] = tex_coord;
-          slice.p1.erode = start_erode;
-          slice.p1.erode_rate = std::max(
-              0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
-          slice.p1.age_ms = 0;
-          slice.p1.bouyancy = 0.3f + 0.2f * RandomFloat();
-          slice.p1.brightness = std::max(
-              0.0f, start_brightness
-                        + (RandomFloat() - 0.5f) * start_brightness_rand);
-          slice.p1.fade = density * t.start_fade_scale_;
-          slice.p1.glow_r = slice.p1.glow_g = slice.p1.glow_b = 0.0f;
-          slice.p1.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
-
-          slice.p2.p = p + t.radius_ * side_vec * start_spread;
-          slice.p2.v = t.medium_velocity_ * 0.3f
-                       + t.velocity_ * inherit_velocity
-                       + side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
-                       + Utils::Sphrand(0.2f * t.point_rand_scale_);
-          slice.p2.tex_coords[0] = 0.25f;
-          slice.p2.tex_coords[1] = tex_coord;
-          slice.p2.erode = start_erode;
-          slice.p2.erode_rate = std::max(
-              0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
-          slice.p2.age_ms = 0;
-          slice.p2.bouyancy = 0.3f + 0.2f * RandomFloat();
-          slice.p2.brightness = std::max(
-              0.0f, start_brightness_2
-                        + (RandomFloat() - 0.5f) * start_brightness_rand);
-          slice.p2.fade = density * t.start_fade_scale_;
-          slice.p2.glow_r = slice.p2.glow_g = slice.p2.glow_b = 0.0f;
-          slice.p2.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
-
-          // If our emit rate has dropped to zero, this will be our last span.
-          if (t.emit_rate_ <= 0.001f) t.emitting_ = false;
-        }
-        // Add leftover dist to wind up with our current tex-coord/emit-rate.
-        t.tex_coord_ = tex_coord + (dist * tex_change_rate);
-        t.emit_rate_ = emit_rate + (dist * emit_change_rate);
-        t.start_erode_ = start_erode + (dist * start_erode_change_rate);
-        t.start_spread_ =
-            std::max(1.0f, start_spread + dist * start_spread_change_rate);
-
-        // Update our at-emitter slice.
-        float density = t.emit_rate_ > 0.1f ? 1.0f : t.emit_rate_ / 0.1f;
-
-        t.cur_slice_.p1.p =
-            t.position_ - t.radius_ * side_vec * t.start_spread_;
-        t.cur_slice_.p1.tex_coords[0] = 0.0f;
-        t.cur_slice_.p1.tex_coords[1] = t.tex_coord_;
-        t.cur_slice_.p1.erode = t.start_erode_;
-        t.cur_slice_.p1.erode_rate = std::max(
-            0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
-        t.cur_slice_.p1.age_ms = 0;
-        t.cur_slice_.p1.brightness = start_brightness;
-        t.cur_slice_.p1.fade = density * t.start_fade_scale_;
-        t.cur_slice_.p1.glow_r = t.cur_slice_.p1.glow_g =
-            t.cur_slice_.p1.glow_b = 0.0f;
-        t.cur_slice_.p1.fade_rate =
-            1.0f + fade_rate_randomness * (RandomFloat());
-
-        t.cur_slice_.p2.p =
-            t.position_ + t.radius_ * side_vec * t.start_spread_;
-        t.cur_slice_.p2.tex_coords[0] = 0.25f;
-        t.cur_slice_.p2.tex_coords[1] = t.tex_coord_;
-        t.cur_slice_.p2.erode = t.start_erode_;
-        t.cur_slice_.p2.erode_rate = std::max(
-            0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
-        t.cur_slice_.p2.age_ms = 0;
-        t.cur_slice_.p2.brightness = start_brightness_2;
-        t.cur_slice_.p2.fade = density * t.start_fade_scale_;
-        t.cur_slice_.p2.glow_r = t.cur_slice_.p2.glow_g =
-            t.cur_slice_.p2.glow_b = 0.0f;
-        t.cur_slice_.p2.fade_rate =
-            1.0f + fade_rate_randomness * (RandomFloat());
-      }
+  for (auto* tendril : tendrils_) {
+    if (tendril->emitting_) {
+      EmitTendrilSlices_(tendril);
     }
+  }
 
-    // Ok now update lighting and distortion on our tendril points and store
-    // them for rendering.
-    {
+  // Ok now update lighting and distortion on our tendril points and store
+  // them for rendering.
+  BinVolumeLights_();
+  RunParallel(tendrils_.size(), [this, tendrils](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      Tendril& t(*tendrils[i]);
       for (auto&& s : t.slices_) {
-        render_slice_count++;
         s.p1.UpdateGlow(*this, t.glow_scale_);
         s.p2.UpdateGlow(*this, t.glow_scale_);
         s.p1.UpdateDistortion(*this);
         s.p2.UpdateDistortion(*this);
       }
       // Also update our in-progress ones.
-      render_slice_count++;
       t.cur_slice_.p1.UpdateGlow(*this, t.glow_scale_);
       t.cur_slice_.p2.UpdateGlow(*this, t.glow_scale_);
       t.cur_slice_.p1.UpdateDistortion(*this);
       t.cur_slice_.p2.UpdateDistortion(*this);
     }
-    i++;
+  });
+}
+
+void BGDynamicsServer::BinVolumeLights_() {
+  volume_light_grid_w_ = volume_light_grid_h_ = 0;
+  if (volume_lights_.empty()) {
+    return;
+  }
+
+  // Size our grid to cover the reach of all lights, growing cells as
+  // needed to stay within our max cell count.
+  float min_x{}, min_z{}, max_x{}, max_z{};
+  for (size_t i = 0; i < volume_lights_.size(); ++i) {
+    auto& l{*volume_lights_[i]};
+    float reach = l.radius_worker * kVolumeLightReach;
+    if (i == 0) {
+      min_x = l.pos_worker.x - reach;
+      max_x = l.pos_worker.x + reach;
+      min_z = l.pos_worker.z - reach;
+      max_z = l.pos_worker.z + reach;
+    } else {
+      min_x = std::min(min_x, l.pos_worker.x - reach);
+      max_x = std::max(max_x, l.pos_worker.x + reach);
+      min_z = std::min(min_z, l.pos_worker.z - reach);
+      max_z = std::max(max_z, l.pos_worker.z + reach);
+    }
+  }
+  float cell_size =
+      std::max(kVolumeLightCellSize,
+               std::max(max_x - min_x, max_z - min_z)
+                   / static_cast<float>(kVolumeLightGridMaxCells));
+  auto cells_for = [cell_size](float extent) {
+    return std::clamp(static_cast<int>(extent / cell_size) + 1, 1,
+                      kVolumeLightGridMaxCells);
+  };
+  volume_light_grid_x_ = min_x;
+  volume_light_grid_z_ = min_z;
+  volume_light_cell_size_ = cell_size;
+  volume_light_grid_w_ = cells_for(max_x - min_x);
+  volume_light_grid_h_ = cells_for(max_z - min_z);
+  volume_light_cells_.resize(
+      static_cast<size_t>(volume_light_grid_w_ * volume_light_grid_h_));
+  for (auto&& cell : volume_light_cells_) {
+    cell.clear();
+  }
+  auto cell_x = [this](float x) {
+    return std::clamp(
+        static_cast<int>((x - volume_light_grid_x_) / volume_light_cell_size_),
+        0, volume_light_grid_w_ - 1);
+  };
+  auto cell_z = [this](float z) {
+    return std::clamp(
+        static_cast<int>((z - volume_light_grid_z_) / volume_light_cell_size_),
+        0, volume_light_grid_h_ - 1);
+  };
+  for (auto* light : volume_lights_) {
+    float reach = light->radius_worker * kVolumeLightReach;
+    int x1 = cell_x(light->pos_worker.x - reach);
+    int x2 = cell_x(light->pos_worker.x + reach);
+    int z1 = cell_z(light->pos_worker.z - reach);
+    int z2 = cell_z(light->pos_worker.z + reach);
+    for (int z = z1; z <= z2; ++z) {
+      for (int x = x1; x <= x2; ++x) {
+        volume_light_cells_[z * volume_light_grid_w_ + x].push_back(light);
+      }
+    }
+  }
+}
+
+auto BGDynamicsServer::VolumeLightsAt_(const Vector3f& p) const
+    -> const std::vector<BGDynamicsVolumeLightData*>& {
+  static const std::vector<BGDynamicsVolumeLightData*> kNoLights;
+  if (volume_light_grid_w_ == 0) {
+    return kNoLights;
+  }
+  float fx = (p.x - volume_light_grid_x_) / volume_light_cell_size_;
+  float fz = (p.z - volume_light_grid_z_) / volume_light_cell_size_;
+  if (fx < 0.0f || fz < 0.0f) {
+    return kNoLights;
+  }
+  auto x = static_cast<int>(fx);
+  auto z = static_cast<int>(fz);
+  if (x >= volume_light_grid_w_ || z >= volume_light_grid_h_) {
+    return kNoLights;
+  }
+  return volume_light_cells_[z * volume_light_grid_w_ + x];
+}
+
+void BGDynamicsServer::EmitTendrilSlices_(Tendril* tendril) {
+  Tendril& t(*tendril);
+  assert(t.emitting_);
+
+  // Step from our last slice to our current position,
+  // dropping in new slices as we go.
+  Vector3f p = {0.0f, 0.0f, 0.0f};
+  float tex_coord{};
+  float emit_rate{};
+  float start_erode{};
+  float start_spread{};
+  int slice_count = static_cast<int>(t.slices_.size());
+  if (slice_count > 0) {
+    p = t.slices_.back().GetCenter();
+    tex_coord = t.slices_.back().p1.tex_coords[1];
+    emit_rate = t.slices_.back().emit_rate;
+    start_erode = t.slices_.back().start_erode;
+    start_spread = t.slices_.back().start_spread;
+  } else {
+    p = t.prev_pos_;
+    tex_coord = t.tex_coord_;
+    emit_rate = t.emit_rate_;
+    start_erode = t.start_erode_;
+    start_spread = t.start_spread_;
+  }
+  Vector3f march_dir = t.position_ - p;
+  float dist = march_dir.Length();
+
+  // We flip our shading depending on which way the tendril is pointing
+  // so that the light side is generally up.
+  float start_brightness{};
+  float start_brightness_2{};
+  if (t.shading_flip_) {
+    start_brightness = t.start_brightness_max_;
+    start_brightness_2 = t.start_brightness_min_;
+  } else {
+    start_brightness = t.start_brightness_min_;
+    start_brightness_2 = t.start_brightness_max_;
+  }
+
+  float start_brightness_rand = t.brightness_rand_;
+  float erode_rate_randomness = 0.5f;
+  float fade_rate_randomness = 2.0f;
+
+  if (dist > 0.001f) {
+    // Use longer (and thus fewer) spans as our detail level drops.
+    float span = 0.5f / (0.5f + 0.5f * quality_scale_);
+    march_dir = march_dir.Normalized() * span;
+    Vector3f from_cam = cam_pos_ - p;
+    Vector3f side_vec = Vector3f::Cross(march_dir, from_cam).Normalized();
+
+    float inherit_velocity = 0.015f;
+
+    // If this is our first step, drop a span immediately.
+    if (!t.has_updated_) {
+      Vector3f r_uniform = Utils::Sphrand(0.2f * t.slice_rand_scale_);
+      float density = emit_rate > 0.1f ? 1.0f : emit_rate / 0.1f;
+
+      t.slices_.emplace_back();
+      Tendril::Slice& slice(t.slices_.back());
+      slice.emit_rate = emit_rate;
+      slice.start_erode = start_erode;
+      slice.start_spread = start_spread;
+      slice.p1.p = p - t.radius_ * side_vec * start_spread;
+      slice.p1.v = t.medium_velocity_ * 0.3f
+                   + t.velocity_ * inherit_velocity * 0.1f
+                   - side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
+                   + Utils::Sphrand(0.13f * t.point_rand_scale_);
+      slice.p1.tex_coords[0] = 0.0f;
+      slice.p1.tex_coords[1] = tex_coord;
+      slice.p1.erode = t.start_erode_;
+      slice.p1.erode_rate = std::max(
+          0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
+      slice.p1.age_ms = 0;
+      slice.p1.bouyancy = 0.3f + 0.2f * RandomFloat();
+      slice.p1.brightness = std::max(
+          0.0f, start_brightness
+                    + (RandomFloat() - 0.5f) * start_brightness_rand);
+      slice.p1.fade = 0.0f;
+      slice.p1.glow_r = slice.p1.glow_g = slice.p1.glow_b = 0.0f;
+      slice.p1.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
+
+      slice.p2.p = p + t.radius_ * side_vec * start_spread;
+      slice.p2.v = t.medium_velocity_ * 0.3f
+                   + t.velocity_ * inherit_velocity * 0.1f
+                   + side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
+                   + Utils::Sphrand(0.13f * t.point_rand_scale_);
+      slice.p2.tex_coords[0] = 0.25f;
+      slice.p2.tex_coords[1] = tex_coord;
+      slice.p2.erode = t.start_erode_;
+      slice.p2.erode_rate = std::max(
+          0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
+      slice.p2.age_ms = 0;
+      slice.p2.bouyancy = 0.3f + 0.2f * RandomFloat();
+      slice.p2.brightness = std::max(
+          0.0f, start_brightness_2
+                    + (RandomFloat() - 0.5f) * start_brightness_rand);
+      slice.p2.fade = 0.0f;
+      slice.p2.glow_r = slice.p2.glow_g = slice.p2.glow_b = 0.0f;
+      slice.p2.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
+    }
+
+    t.has_updated_ = true;
+    float tex_change_rate = 0.18f * t.tex_change_rate_;
+    float emit_change_rate = -0.4f * t.emit_rate_falloff_rate_;
+    float start_erode_change_rate = 1.0f;
+    float start_spread_change_rate = -0.35f;
+
+    // Reset our tex coord to that of the last span for marching purposes.
+    for (; dist > span; dist -= span) {  // NOLINT
+      p += march_dir;
+      tex_coord += span * tex_change_rate;
+      emit_rate = std::max(0.0f, emit_rate + span * emit_change_rate);
+      start_erode =
+          std::min(1.0f, start_erode + span * start_erode_change_rate);
+      start_spread =
+          std::max(1.0f, start_spread + span * start_spread_change_rate);
+
+      // General density stays high until emit rate gets low.
+      float density = emit_rate > 0.1f ? 1.0f : emit_rate / 0.1f;
+
+      Vector3f r_uniform = Utils::Sphrand(0.2f * t.slice_rand_scale_);
+      t.slices_.emplace_back();
+      Tendril::Slice& slice(t.slices_.back());
+      slice.emit_rate = emit_rate;
+      slice.start_erode = start_erode;
+      slice.start_spread = start_spread;
+      slice.p1.p = p - t.radius_ * side_vec * start_spread;
+      slice.p1.v = t.medium_velocity_ * 0.3f
+                   + t.velocity_ * inherit_velocity
+                   - side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
+                   + Utils::Sphrand(0.2f * t.point_rand_scale_);
+      slice.p1.tex_coords[0] = 0.0f;
+      slice.p1.tex_coords[1] = tex_coord;
+      slice.p1.erode = start_erode;
+      slice.p1.erode_rate = std::max(
+          0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
+      slice.p1.age_ms = 0;
+      slice.p1.bouyancy = 0.3f + 0.2f * RandomFloat();
+      slice.p1.brightness = std::max(
+          0.0f, start_brightness
+                    + (RandomFloat() - 0.5f) * start_brightness_rand);
+      slice.p1.fade = density * t.start_fade_scale_;
+      slice.p1.glow_r = slice.p1.glow_g = slice.p1.glow_b = 0.0f;
+      slice.p1.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
+
+      slice.p2.p = p + t.radius_ * side_vec * start_spread;
+      slice.p2.v = t.medium_velocity_ * 0.3f
+                   + t.velocity_ * inherit_velocity
+                   + side_vec * t.radius_ * t.side_spread_rate_ + r_uniform
+                   + Utils::Sphrand(0.2f * t.point_rand_scale_);
+      slice.p2.tex_coords[0] = 0.25f;
+      slice.p2.tex_coords[1] = tex_coord;
+      slice.p2.erode = start_erode;
+      slice.p2.erode_rate = std::max(
+          0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
+      slice.p2.age_ms = 0;
+      slice.p2.bouyancy = 0.3f + 0.2f * RandomFloat();
+      slice.p2.brightness = std::max(
+          0.0f, start_brightness_2
+                    + (RandomFloat() - 0.5f) * start_brightness_rand);
+      slice.p2.fade = density * t.start_fade_scale_;
+      slice.p2.glow_r = slice.p2.glow_g = slice.p2.glow_b = 0.0f;
+      slice.p2.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
+
+      // If our emit rate has dropped to zero, this will be our last span.
+      if (t.emit_rate_ <= 0.001f) t.emitting_ = false;
+    }
+    // Add leftover dist to wind up with our current tex-coord/emit-rate.
+    t.tex_coord_ = tex_coord + (dist * tex_change_rate);
+    t.emit_rate_ = emit_rate + (dist * emit_change_rate);
+    t.start_erode_ = start_erode + (dist * start_erode_change_rate);
+    t.start_spread_ =
+        std::max(1.0f, start_spread + dist * start_spread_change_rate);
+
+    // Update our at-emitter slice.
+    float density = t.emit_rate_ > 0.1f ? 1.0f : t.emit_rate_ / 0.1f;
+
+    t.cur_slice_.p1.p = t.position_ - t.radius_ * side_vec * t.start_spread_;
+    t.cur_slice_.p1.tex_coords[0] = 0.0f;
+    t.cur_slice_.p1.tex_coords[1] = t.tex_coord_;
+    t.cur_slice_.p1.erode = t.start_erode_;
+    t.cur_slice_.p1.erode_rate = std::max(
+        0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
+    t.cur_slice_.p1.age_ms = 0;
+    t.cur_slice_.p1.brightness = start_brightness;
+    t.cur_slice_.p1.fade = density * t.start_fade_scale_;
+    t.cur_slice_.p1.glow_r = t.cur_slice_.p1.glow_g =
+        t.cur_slice_.p1.glow_b = 0.0f;
+    t.cur_slice_.p1.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
+
+    t.cur_slice_.p2.p = t.position_ + t.radius_ * side_vec * t.start_spread_;
+    t.cur_slice_.p2.tex_coords[0] = 0.25f;
+    t.cur_slice_.p2.tex_coords[1] = t.tex_coord_;
+    t.cur_slice_.p2.erode = t.start_erode_;
+    t.cur_slice_.p2.erode_rate = std::max(
+        0.0f, density + erode_rate_randomness * (RandomFloat() - 0.5f));
+    t.cur_slice_.p2.age_ms = 0;
+    t.cur_slice_.p2.brightness = start_brightness_2;
+    t.cur_slice_.p2.fade = density * t.start_fade_scale_;
+    t.cur_slice_.p2.glow_r = t.cur_slice_.p2.glow_g =
+        t.cur_slice_.p2.glow_b = 0.0f;
+    t.cur_slice_.p2.fade_rate = 1.0f + fade_rate_randomness * (RandomFloat());
   }
 }
 
 void BGDynamicsServer::Clear() {
   // Clear chunks.
-  {
-    auto i = chunks_.begin();
-    while (i != chunks_.end()) {
-      delete *i;
-      chunks_.erase(i);
-      chunk_count_--;
-      i = chunks_.begin();
-      assert(chunk_count_ >= 0);
-    }
-    assert(chunk_count_ == 0);
+  for (auto* chunk : chunks_) {
+    delete chunk;
+    chunk_count_--;
+    assert(chunk_count_ >= 0);
   }
+  chunks_.clear();
+  assert(chunk_count_ == 0);
 
   // ..and tendrils.
-  {
-    auto i = tendrils_.begin();
-    while (i != tendrils_.end()) {
-      if ((**i).type_ == BGDynamicsTendrilType::kThinSmoke) {
-        tendril_count_thin_--;
-      } else {
-        tendril_count_thick_--;
-      }
-      delete *i;
-      tendrils_.erase(i);
-      i = tendrils_.begin();
+  for (auto* tendril : tendrils_) {
+    if (tendril->type_ == BGDynamicsTendrilType::kThinSmoke) {
+      tendril_count_thin_--;
+    } else {
+      tendril_count_thick_--;
     }
-    assert(tendril_count_thin_ == 0 && tendril_count_thick_ == 0);
+    delete tendril;
   }
+  tendrils_.clear();
+  assert(tendril_count_thin_ == 0 && tendril_count_thick_ == 0);
 }
 
 void BGDynamicsServer::PushEmitCall(const BGDynamicsEmission& def) {
@@ -1027,6 +1308,18 @@ void BGDynamicsServer::Emit(const BGDynamicsEmission& def) {
   int tendril_thin_max = 14;
   int chunk_max = 200;
 
+  // Scale everything by our adaptive detail level.
+  if (quality_scale_ < 1.0f) {
+    emit_count = static_cast<int>(static_cast<float>(emit_count)
+                                  * std::max(0.4f, quality_scale_));
+    tendril_thick_max = static_cast<int>(
+        static_cast<float>(tendril_thick_max) * quality_scale_);
+    tendril_thin_max = static_cast<int>(static_cast<float>(tendril_thin_max)
+                                        * quality_scale_);
+    chunk_max =
+        static_cast<int>(static_cast<float>(chunk_max) * quality_scale_);
+  }
+
   // Scale our counts down based on a few things.
   if (graphics_quality_ <= GraphicsQuality::kLow) {
     emit_count = static_cast<int>(static_cast<float>(emit_count) * 0.35f);
@@ -1414,7 +1707,6 @@ void BGDynamicsServer::PushRemoveTerrainCall(
 void BGDynamicsServer::PushAddShadowCall(BGDynamicsShadowData* shadow_data) {
   event_loop()->PushCall([this, shadow_data] {
     assert(g_base->InBGDynamicsThread());
-    std::scoped_lock lock(shadow_list_mutex_);
     shadows_.push_back(shadow_data);
   });
 }
@@ -1423,14 +1715,11 @@ void BGDynamicsServer::PushRemoveShadowCall(BGDynamicsShadowData* shadow_data) {
   event_loop()->PushCall([this, shadow_data] {
     assert(g_base->InBGDynamicsThread());
     bool found = false;
-    {
-      std::scoped_lock lock(shadow_list_mutex_);
-      for (auto i = shadows_.begin(); i != shadows_.end(); ++i) {
-        if ((*i) == shadow_data) {
-          found = true;
-          shadows_.erase(i);
-          break;
-        }
+    for (auto i = shadows_.begin(); i != shadows_.end(); ++i) {
+      if ((*i) == shadow_data) {
+        found = true;
+        shadows_.erase(i);
+        break;
       }
     }
     assert(found);
@@ -1442,7 +1731,6 @@ void BGDynamicsServer::PushAddVolumeLightCall(
     BGDynamicsVolumeLightData* volume_light_data) {
   event_loop()->PushCall([this, volume_light_data] {
     // Add to our internal list.
-    std::scoped_lock lock(volume_light_list_mutex_);
     volume_lights_.push_back(volume_light_data);
   });
 }
@@ -1452,14 +1740,11 @@ void BGDynamicsServer::PushRemoveVolumeLightCall(
   event_loop()->PushCall([this, volume_light_data] {
     // Remove from our list and kill.
     bool found = false;
-    {
-      std::scoped_lock lock(volume_light_list_mutex_);
-      for (auto i = volume_lights_.begin(); i != volume_lights_.end(); ++i) {
-        if ((*i) == volume_light_data) {
-          found = true;
-          volume_lights_.erase(i);
-          break;
-        }
+    for (auto i = volume_lights_.begin(); i != volume_lights_.end(); ++i) {
+      if ((*i) == volume_light_data) {
+        found = true;
+        volume_lights_.erase(i);
+        break;
       }
     }
     assert(found);
@@ -1469,7 +1754,6 @@ void BGDynamicsServer::PushRemoveVolumeLightCall(
 
 void BGDynamicsServer::PushAddFuseCall(BGDynamicsFuseData* fuse_data) {
   event_loop()->PushCall([this, fuse_data] {
-    std::scoped_lock lock(fuse_list_mutex_);
     fuses_.push_back(fuse_data);
   });
 }
@@ -1477,14 +1761,11 @@ void BGDynamicsServer::PushAddFuseCall(BGDynamicsFuseData* fuse_data) {
 void BGDynamicsServer::PushRemoveFuseCall(BGDynamicsFuseData* fuse_data) {
   event_loop()->PushCall([this, fuse_data] {
     bool found = false;
-    {
-      std::scoped_lock lock(fuse_list_mutex_);
-      for (auto i = fuses_.begin(); i != fuses_.end(); i++) {
-        if ((*i) == fuse_data) {
-          found = true;
-          fuses_.erase(i);
-          break;
-        }
+    for (auto i = fuses_.begin(); i != fuses_.end(); i++) {
+      if ((*i) == fuse_data) {
+        found = true;
+        fuses_.erase(i);
+        break;
       }
     }
     assert(found);
@@ -2233,8 +2514,15 @@ auto BGDynamicsServer::CreateDrawSnapshot() -> BGDynamicsDrawSnapshot* {
   if (!spark_particles_) {
     spark_particles_ = std::make_unique<ParticleSet>();
   }
-  spark_particles_->UpdateAndCreateSnapshot(&ss->spark_indices,
-                                            &ss->spark_vertices);
+  if (spark_particles_->gpu_animated()) {
+    ss->gpu_sparks = true;
+    spark_particles_->UpdateAndCreateGPUSnapshot(
+        &ss->gpu_spark_indices, &ss->gpu_spark_vertices, &ss->gpu_spark_step,
+        &ss->gpu_sparks_changed);
+  } else {
+    spark_particles_->UpdateAndCreateSnapshot(&ss->spark_indices,
+                                              &ss->spark_vertices);
+  }
 
   return ss;
 }  // NOLINT (yes this should be shorter)
@@ -2247,25 +2535,23 @@ void BGDynamicsServer::PushTooSlowCall() {
       int killcount =
           static_cast<int>(0.1f * static_cast<float>(chunks_.size()));
       int killed = 0;
-      auto i = chunks_.begin();
-      while (i != chunks_.end()) {
-        if (killed >= killcount) break;
-        auto i_next = i;
-        i_next++;
-
-        // Kill it if its killable; otherwise move to next.
-        if ((**i).can_die()) {
-          delete (*i);
-          chunks_.erase(i);
+      size_t out = 0;
+      for (auto* chunk : chunks_) {
+        // Kill it if its killable; otherwise keep it.
+        if (killed < killcount && chunk->can_die()) {
+          delete chunk;
           chunk_count_--;
           killed++;
+          continue;
         }
-        i = i_next;
+        chunks_[out++] = chunk;
       }
+      chunks_.resize(out);
+
       // ...and tendrils.
       killcount = static_cast<int>(0.2f * static_cast<float>(tendrils_.size()));
       for (int j = 0; j < killcount; j++) {
-        Tendril* t = *tendrils_.begin();
+        Tendril* t = tendrils_[j];
         if (t->type_ == BGDynamicsTendrilType::kThinSmoke) {
           tendril_count_thin_--;
         } else {
@@ -2273,13 +2559,14 @@ void BGDynamicsServer::PushTooSlowCall() {
         }
         assert(tendril_count_thin_ >= 0 && tendril_count_thick_ >= 0);
         delete t;
-        tendrils_.erase(tendrils_.begin());
       }
+      tendrils_.erase(tendrils_.begin(), tendrils_.begin() + killcount);
     }
   });
 }
 
 void BGDynamicsServer::Step(StepData* step_data) {
+  BA_TRACE_SCOPE("BGDynamicsServer::Step");
   assert(g_base->InBGDynamicsThread());
   assert(step_data);
 
@@ -2293,6 +2580,11 @@ void BGDynamicsServer::Step(StepData* step_data) {
 
   cam_pos_ = step_data->cam_pos;
 
+  if (!spark_particles_) {
+    spark_particles_ = std::make_unique<ParticleSet>();
+  }
+  spark_particles_->SetGPUAnimated(step_data->gpu_particles);
+
   // Apply all step data sent to us for our entities.
   for (auto&& i : step_data->shadow_step_data_) {
     BGDynamicsShadowData* shadow{i.first};
@@ -2322,9 +2614,18 @@ void BGDynamicsServer::Step(StepData* step_data) {
     }
   }
 
+  microsecs_t step_start_time{g_core->AppTimeMicrosecs()};
+
   // Handle shadows first since they need to get back to the client
-  // as soon as possible.
-  UpdateShadows();
+  // as soon as possible. When we're scaled way back we only refresh them
+  // every few steps; clients smooth these values anyway.
+  int shadow_interval = quality_scale_ > 0.6f    ? 1
+                        : quality_scale_ > 0.35f ? 2
+                                                 : 3;
+  if (++shadow_update_counter_ >= shadow_interval) {
+    shadow_update_counter_ = 0;
+    UpdateShadows();
+  }
 
   // Go ahead and run this step for all our existing stuff.
   dJointGroupEmpty(ode_contact_group_);
@@ -2341,11 +2642,7 @@ void BGDynamicsServer::Step(StepData* step_data) {
 
   // Now generate a snapshot of our state and send it to the logic thread so
   // they can draw us.
-  BGDynamicsDrawSnapshot* snapshot = CreateDrawSnapshot();
-  g_base->logic->event_loop()->PushCall([snapshot] {
-    snapshot->SetLogicThreadOwnership();
-    g_base->bg_dynamics->SetDrawSnapshot(snapshot);
-  });
+  PublishDrawSnapshot_(CreateDrawSnapshot());
 
   time_ms_ += step_milliseconds_;  // milliseconds per step
 
@@ -2353,32 +2650,77 @@ void BGDynamicsServer::Step(StepData* step_data) {
   // there to fill itself in slowly.
   collision_cache_->Precalc();
 
+  auto step_ms{
+      static_cast<float>(g_core->AppTimeMicrosecs() - step_start_time)
+      / 1000.0f};
+  last_step_ms_.store(step_ms, std::memory_order_relaxed);
+  UpdateQualityScale_(step_ms, step_data->target_step_ms);
+
   // Job's done!
-  {
-    std::scoped_lock lock(step_count_mutex_);
-    step_count_--;
-  }
-  assert(step_count_ >= 0);
+  int step_count = --step_count_;
+  assert(step_count >= 0);
 
   // Math sanity check.
-  if (step_count_ < 0) {
+  if (step_count < 0) {
     BA_LOG_ONCE(LogName::kBaGraphics, LogLevel::kWarning,
-                "BGDynamics step_count too low (" + std::to_string(step_count_)
+                "BGDynamics step_count too low (" + std::to_string(step_count)
                     + "); should not happen.");
   }
 }
 
+void BGDynamicsServer::UpdateQualityScale_(float step_ms, float target_ms) {
+  // Smooth out our measurements so single slow steps don't yank things
+  // around.
+  smoothed_step_ms_ = 0.9f * smoothed_step_ms_ + 0.1f * step_ms;
+
+  // With no target we just drift back to full detail.
+  if (target_ms <= 0.0f) {
+    quality_scale_ = std::min(1.0f, quality_scale_ + 0.002f);
+    return;
+  }
+
+  // Back off fairly quickly (in proportion to how far over we are) but
+  // recover slowly, and leave a bit of a dead zone in between so we don't
+  // oscillate.
+  float ratio = smoothed_step_ms_ / target_ms;
+  if (ratio > 1.0f) {
+    quality_scale_ -= std::min(0.02f, 0.01f * (ratio - 1.0f));
+  } else if (ratio < 0.75f) {
+    quality_scale_ += 0.002f;
+  }
+  quality_scale_ = std::clamp(quality_scale_, kMinQualityScale, 1.0f);
+}
+
+void BGDynamicsServer::PublishDrawSnapshot_(BGDynamicsDrawSnapshot* snapshot) {
+  assert(g_base->InBGDynamicsThread());
+  assert(snapshot);
+
+  // If the logic thread hasn't picked up our last one, reclaim it. Only we
+  // ever put anything in the slot, so once it is empty it stays that way
+  // until we store again.
+  if (BGDynamicsDrawSnapshot* pending =
+          latest_draw_snapshot_.exchange(nullptr, std::memory_order_acq_rel)) {
+    // GPU sparks only come with buffers when they change; if the one we're
+    // dropping had new ones, this one needs to carry them along.
+    if (pending->gpu_sparks_changed && snapshot->gpu_sparks
+        && !snapshot->gpu_sparks_changed) {
+      snapshot->gpu_spark_indices = std::move(pending->gpu_spark_indices);
+      snapshot->gpu_spark_vertices = std::move(pending->gpu_spark_vertices);
+      snapshot->gpu_sparks_changed = true;
+    }
+    delete pending;
+  }
+  latest_draw_snapshot_.store(snapshot, std::memory_order_release);
+}
+
 void BGDynamicsServer::PushStep(StepData* data) {
   // Increase our step count and ship it.
-  {
-    std::scoped_lock lock(step_count_mutex_);
-    step_count_++;
-  }
+  int step_count = ++step_count_;
 
   // Client thread should stop feeding us if we get clogged up.
-  if (step_count_ > 5) {
+  if (step_count > 5) {
     BA_LOG_ONCE(LogName::kBa, LogLevel::kWarning,
-                "BGDynamics step_count too high (" + std::to_string(step_count_)
+                "BGDynamics step_count too high (" + std::to_string(step_count)
                     + "); should not happen.");
   }
 
@@ -2412,9 +2754,9 @@ void BGDynamicsServer::PushAddTerrainCall(
 }
 
 void BGDynamicsServer::UpdateFields() {
-  auto i = fields_.begin();
-  while (i != fields_.end()) {
-    Field& f(**i);
+  size_t out = 0;
+  for (auto* field : fields_) {
+    Field& f(*field);
 
     // First off, kill this field if its time has come.
     {
@@ -2423,14 +2765,11 @@ void BGDynamicsServer::UpdateFields() {
         kill = true;
       }
       if (kill) {
-        auto i_next = i;
-        i_next++;
-        delete *i;
-        fields_.erase(i);
-        i = i_next;
+        delete field;
         continue;
       }
     }
+    fields_[out++] = field;
 
     // Update its distortion amount based on age (get an age in 0-1).
     float age = (time_ms() - f.birth_time_ms()) / f.lifespan_ms();
@@ -2465,8 +2804,8 @@ void BGDynamicsServer::UpdateFields() {
                       * Utils::SmoothStep(suck_2_end_time, 1.0f, age));
     }
     f.set_amt(f.amt() * f.mag());
-    i++;
   }
+  fields_.resize(out);
 }
 
 void BGDynamicsServer::TerrainCollideCallback(void* data, dGeomID geom1,
@@ -2476,50 +2815,101 @@ void BGDynamicsServer::TerrainCollideCallback(void* data, dGeomID geom1,
 
   if (int numc = dCollide(geom1, geom2, kMaxBGDynamicsContacts,
                           &contact[0].geom, sizeof(dContact))) {
-    BGDynamicsChunkType type = dyn->cb_type_;
-    dBodyID body = dyn->cb_body_;
-    float f_mult = type == BGDynamicsChunkType::kIce ? 0.04f : 1.0f;
-
-    // Slime chunks just slow down on collisions.
-    if (type == BGDynamicsChunkType::kSlime) {
-      const dReal* vel = dBodyGetLinearVel(body);
-      dBodySetLinearVel(body, vel[0] * 0.1f, vel[1] * 0.1f, vel[2] * 0.1f);
-      vel = dBodyGetAngularVel(body);
-      dBodySetAngularVel(body, vel[0] * 0.8f, vel[1] * 0.8f, vel[2] * 0.8f);
-    } else {
-      // Only look at some contacts.
-      // If we restrict the number of contacts returned we seem to get
-      // lopsided contacts and failing collisions, but if we just increment
-      // through all contacts at > 1 it seems to work ok.
-      int contact_incr = 1;
-      if (numc > 4) {
-        contact_incr = 2;
-        if (numc > 9) {
-          contact_incr = 3;
-          if (numc > 14) {
-            contact_incr = 4;
-          }
+    dyn->AddTerrainContacts_(contact, numc);
+  }
+}
+
+void BGDynamicsServer::AddTerrainContacts_(dContact* contact, int numc) {
+  BGDynamicsChunkType type = cb_type_;
+  dBodyID body = cb_body_;
+  float f_mult = type == BGDynamicsChunkType::kIce ? 0.04f : 1.0f;
+
+  // Slime chunks just slow down on collisions.
+  if (type == BGDynamicsChunkType::kSlime) {
+    const dReal* vel = dBodyGetLinearVel(body);
+    dBodySetLinearVel(body, vel[0] * 0.1f, vel[1] * 0.1f, vel[2] * 0.1f);
+    vel = dBodyGetAngularVel(body);
+    dBodySetAngularVel(body, vel[0] * 0.8f, vel[1] * 0.8f, vel[2] * 0.8f);
+  } else {
+    // Only look at some contacts.
+    // If we restrict the number of contacts returned we seem to get
+    // lopsided contacts and failing collisions, but if we just increment
+    // through all contacts at > 1 it seems to work ok.
+    int contact_incr = 1;
+    if (numc > 4) {
+      contact_incr = 2;
+      if (numc > 9) {
+        contact_incr = 3;
+        if (numc > 14) {
+          contact_incr = 4;
         }
       }
+    }
 
-      for (int i = 0; i < numc; i += contact_incr) {
-        // NOLINTNEXTLINE
-        contact[i].surface.mode = dContactBounce | dContactSoftCFM
-                                  | dContactSoftERP | dContactApprox1;
-        contact[i].surface.mu2 = 0;
-        contact[i].surface.bounce_vel = 0.1f;
-        contact[i].surface.mu = 0.5f * dyn->debris_friction_ * f_mult;
-        contact[i].surface.bounce = 0.4f;
-        contact[i].surface.soft_cfm = dyn->cb_cfm_;
-        contact[i].surface.soft_erp = dyn->cb_erp_;
-        dJointID constraint = dJointCreateContact(
-            dyn->ode_world_, dyn->ode_contact_group_, contact + i);
-        dJointAttach(constraint, body, nullptr);
-      }
+    for (int i = 0; i < numc; i += contact_incr) {
+      // NOLINTNEXTLINE
+      contact[i].surface.mode = dContactBounce | dContactSoftCFM
+                                | dContactSoftERP | dContactApprox1;
+      contact[i].surface.mu2 = 0;
+      contact[i].surface.bounce_vel = 0.1f;
+      contact[i].surface.mu = 0.5f * debris_friction_ * f_mult;
+      contact[i].surface.bounce = 0.4f;
+      contact[i].surface.soft_cfm = cb_cfm_;
+      contact[i].surface.soft_erp = cb_erp_;
+      dJointID constraint =
+          dJointCreateContact(ode_world_, ode_contact_group_, contact + i);
+      dJointAttach(constraint, body, nullptr);
     }
   }
 }
 
+auto BGDynamicsServer::CollideChunkWithHeightCache_(const Chunk& c) -> bool {
+  // Only worth it (and only accurate enough) for small stuff.
+  float max_size = std::max(c.size_[0], std::max(c.size_[1], c.size_[2]));
+  if (max_size > kHeightCacheCollideMaxSize) {
+    return false;
+  }
+  const dReal* pos = dGeomGetPosition(c.geom_);
+  Vector3f p(pos);
+  float height{};
+  Vector3f normal{};
+  if (!height_cache_->SampleSurface(p, &height, &normal)) {
+    return false;
+  }
+
+  // The height map only knows about the topmost surface and smooths over
+  // sharp edges, so leave anything underneath stuff or near steep bits
+  // to full collision.
+  if (normal.y < kHeightCacheCollideMinNormalY
+      || p.y < height - kHeightCacheCollideMaxDepth) {
+    return false;
+  }
+
+  // How far our box extends along the normal.
+  const dReal* r = dGeomGetRotation(c.geom_);
+  float extent{};
+  for (int i = 0; i < 3; ++i) {
+    extent += 0.5f * c.size_[i]
+              * std::abs(r[i] * normal.x + r[4 + i] * normal.y
+                         + r[8 + i] * normal.z);
+  }
+  float depth = extent - (p.y - height) * normal.y;
+  if (depth > 0.0f) {
+    dContact contact{};
+    Vector3f contact_pos = p - normal * extent;
+    contact.geom.pos[0] = contact_pos.x;
+    contact.geom.pos[1] = contact_pos.y;
+    contact.geom.pos[2] = contact_pos.z;
+    contact.geom.normal[0] = normal.x;
+    contact.geom.normal[1] = normal.y;
+    contact.geom.normal[2] = normal.z;
+    contact.geom.depth = depth;
+    contact.geom.g1 = c.geom_;
+    AddTerrainContacts_(&contact, 1);
+  }
+  return true;
+}
+
 void BGDynamicsServer::UpdateChunks() {
   dReal stiffness = 1000.0f;
   dReal damping = 10.0f;
@@ -2532,8 +2922,9 @@ void BGDynamicsServer::UpdateChunks() {
   // rather we explicitly test everything against our terrain objects;
   // this keeps things simple.
 
-  for (auto i = chunks_.begin(); i != chunks_.end();) {
-    Chunk& c(**i);
+  size_t out = 0;
+  for (auto* chunk : chunks_) {
+    Chunk& c(*chunk);
 
     // first off, kill this chunk if its time has come
     {
@@ -2548,16 +2939,13 @@ void BGDynamicsServer::UpdateChunks() {
         if (pos[1] < debris_kill_height_) kill = true;
       }
       if (kill) {
-        auto i_next = i;
-        i_next++;
-        delete *i;
-        chunks_.erase(i);
+        delete chunk;
         chunk_count_--;
         assert(chunk_count_ >= 0);
-        i = i_next;
         continue;
       }
     }
+    chunks_[out++] = chunk;
     BGDynamicsChunkType type = c.type();
 
     // Some spark-specific stuff.
@@ -2644,14 +3032,16 @@ void BGDynamicsServer::UpdateChunks() {
         c.shadow_dist_ = pos[1] - height_cache_->Sample(Vector3f(pos));
         cb_type_ = type;
         cb_body_ = body;
-        collision_cache_->CollideAgainstGeom(geom, this,
-                                             TerrainCollideCallback);
+        if (!CollideChunkWithHeightCache_(c)) {
+          collision_cache_->CollideAgainstGeom(geom, this,
+                                               TerrainCollideCallback);
+        }
         // Tell it to update any tendril it might have.
         c.UpdateTendril();
       }
     }
-    i++;
   }
+  chunks_.resize(out);
 }
 
 void BGDynamicsServer::UpdateShadows() {
@@ -2685,15 +3075,8 @@ void BGDynamicsServer::UpdateShadows() {
   }
 
   // Now plop this back onto the client side all at once.
-  {
-    BA_DEBUG_TIME_CHECK_BEGIN(bg_dynamic_shadow_list_lock);
-    {
-      std::scoped_lock lock(shadow_list_mutex_);
-      for (auto&& s : shadows_) {
-        s->UpdateClientData();
-      }
-    }
-    BA_DEBUG_TIME_CHECK_END(bg_dynamic_shadow_list_lock, 10);
+  for (auto&& s : shadows_) {
+    s->UpdateClientData();
   }
 }
 
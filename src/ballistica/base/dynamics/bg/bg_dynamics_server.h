@@ -3,9 +3,8 @@
 #ifndef BALLISTICA_BASE_DYNAMICS_BG_BG_DYNAMICS_SERVER_H_
 #define BALLISTICA_BASE_DYNAMICS_BG_BG_DYNAMICS_SERVER_H_
 
-#include <list>
+#include <atomic>
 #include <memory>
-#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -18,36 +17,73 @@ namespace ballistica::base {
 
 class BGDynamicsServer {
  public:
-  struct Particle {
-    float x;
-    float y;
-    float z;
-    // Note that velocities here are in units-per-step (avoids a mult).
-    float vx;
-    float vy;
-    float vz;
-    float r;
-    float g;
-    float b;
-    float a;
-    float life;
-    float d_life;
-    float flicker;
-    float flicker_scale;
-    float size;
-    float d_size;
-  };
-
+  /// Sparks and the like. Particles are stored as a structure-of-arrays
+  /// so the per-step integrate/fade passes are plain loops over
+  /// contiguous floats which compilers turn into SIMD code.
+  ///
+  /// Alternately, particles can be animated on the GPU. In that mode each
+  /// particle's birth state is handed to the renderer once and the CPU
+  /// only keeps track of when it dies.
   class ParticleSet {
    public:
-    std::vector<Particle> particles[2];
-    int current_set;
-    ParticleSet() : current_set(0) {}
     void Emit(const Vector3f& pos, const Vector3f& vel, float r, float g,
               float b, float a, float dlife, float size, float d_size,
               float flicker);
     void UpdateAndCreateSnapshot(Object::Ref<MeshIndexBuffer16>* index_buffer,
                                  Object::Ref<MeshBufferVertexSprite>* buffer);
+
+    /// Switch between CPU and GPU animation. Existing particles are
+    /// dropped.
+    void SetGPUAnimated(bool val);
+    auto gpu_animated() const { return gpu_animated_; }
+
+    /// GPU-animated counterpart to UpdateAndCreateSnapshot(). Buffers are
+    /// only created when the set of particles has changed since the last
+    /// call (as indicated by 'changed'); otherwise the previous ones
+    /// should be drawn again at the new step.
+    void UpdateAndCreateGPUSnapshot(
+        Object::Ref<MeshIndexBuffer16>* index_buffer,
+        Object::Ref<MeshBufferVertexParticle>* buffer, float* step,
+        bool* changed);
+
+    auto size() const -> size_t {
+      return gpu_animated_ ? gpu_particles_.size() : x_.size();
+    }
+
+   private:
+    struct GPUParticle_ {
+      VertexParticle vertex;
+      int64_t birth_step;
+      int64_t death_step;
+    };
+    // We render with 16 bit indices and 4 verts per particle.
+    static constexpr size_t kMaxParticles{65536 / 4};
+    void Resize_(size_t size);
+    void EmitGPU_(const Vector3f& pos, const Vector3f& vel, float r, float g,
+                  float b, float a, float dlife, float size, float d_size,
+                  float flicker);
+    std::vector<GPUParticle_> gpu_particles_;
+    int64_t step_{};
+    int64_t gpu_base_step_{};
+    bool gpu_animated_{};
+    bool gpu_dirty_{};
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> z_;
+    // Note that velocities here are in units-per-step (avoids a mult).
+    std::vector<float> vx_;
+    std::vector<float> vy_;
+    std::vector<float> vz_;
+    std::vector<float> r_;
+    std::vector<float> g_;
+    std::vector<float> b_;
+    std::vector<float> a_;
+    std::vector<float> life_;
+    std::vector<float> d_life_;
+    std::vector<float> flicker_;
+    std::vector<float> flicker_scale_;
+    std::vector<float> size_;
+    std::vector<float> d_size_;
   };
 
   struct ShadowStepData {
@@ -74,6 +110,8 @@ class BGDynamicsServer {
       return EventLoopID::kBGDynamics;
     }
     GraphicsQuality graphics_quality{};
+    bool gpu_particles{};
+    float target_step_ms{};
     int step_millisecs{};
     Vector3f cam_pos{0.0f, 0.0f, 0.0f};
 
@@ -92,6 +130,9 @@ class BGDynamicsServer {
   auto time_ms() const { return time_ms_; }
   auto graphics_quality() const -> GraphicsQuality { return graphics_quality_; }
 
+  /// Current adaptive detail scale (1 is full detail).
+  auto quality_scale() const -> float { return quality_scale_; }
+
   void PushAddVolumeLightCall(BGDynamicsVolumeLightData* volume_light_data);
   void PushRemoveVolumeLightCall(BGDynamicsVolumeLightData* volume_light_data);
   void PushAddFuseCall(BGDynamicsFuseData* fuse_data);
@@ -104,24 +145,31 @@ class BGDynamicsServer {
   auto spark_particles() const -> ParticleSet* {
     return spark_particles_.get();
   }
-  auto step_count() const -> int { return step_count_; }
+  /// Steps that have been pushed but not yet completed. Safe to call from
+  /// any thread.
+  auto step_count() const -> int { return step_count_.load(); }
   auto event_loop() const -> EventLoop* { return event_loop_; }
 
-  auto& shadow_list_mutex() { return shadow_list_mutex_; }
-  auto& volume_light_list_mutex() { return volume_light_list_mutex_; }
-  auto& fuse_list_mutex() { return fuse_list_mutex_; }
-  auto& step_count_mutex() { return step_count_mutex_; }
+  /// Grab the newest completed draw snapshot, or nullptr if there hasn't
+  /// been a new one since the last call. The caller takes ownership.
+  /// Never blocks; snapshots that are superseded before being taken are
+  /// simply dropped.
+  auto TakeDrawSnapshot() -> BGDynamicsDrawSnapshot* {
+    return latest_draw_snapshot_.exchange(nullptr, std::memory_order_acq_rel);
+  }
 
   const auto& terrains() const { return terrains_; }
-  const auto& shadows() const { return shadows_; }
-  const auto& volume_lights() const { return volume_lights_; }
-  const auto& fuses() const { return fuses_; }
   void PushStep(StepData* data);
   void PushTooSlowCall();
   void PushSetDebrisFrictionCall(float friction);
   void PushSetDebrisKillHeightCall(float height);
 
   auto step_seconds() const { return step_seconds_; }
+
+  /// How long our most recent step took (milliseconds). Any thread.
+  auto last_step_ms() const {
+    return last_step_ms_.load(std::memory_order_relaxed);
+  }
   auto step_milliseconds() const { return step_milliseconds_; }
 
  private:
@@ -132,6 +180,12 @@ class BGDynamicsServer {
   class TendrilController;
 
   static void TerrainCollideCallback(void* data, dGeomID o1, dGeomID o2);
+  void AddTerrainContacts_(dContact* contact, int count);
+
+  /// Collide a chunk against the height cache instead of our terrain.
+  /// Returns false if the chunk isn't a good candidate for that (in which
+  /// case it should go through regular collision).
+  auto CollideChunkWithHeightCache_(const Chunk& c) -> bool;
 
   void Emit(const BGDynamicsEmission& def);
   void Step(StepData* data);
@@ -139,9 +193,19 @@ class BGDynamicsServer {
   void UpdateFields();
   void UpdateChunks();
   void UpdateTendrils();
+  void EmitTendrilSlices_(Tendril* t);
+
+  /// Sort volume lights into a coarse x/z grid by what they can reach.
+  void BinVolumeLights_();
+
+  /// Volume lights that might reach a point (as of our last binning).
+  auto VolumeLightsAt_(const Vector3f& p) const
+      -> const std::vector<BGDynamicsVolumeLightData*>&;
   void UpdateFuses();
   void UpdateShadows();
   auto CreateDrawSnapshot() -> BGDynamicsDrawSnapshot*;
+  void PublishDrawSnapshot_(BGDynamicsDrawSnapshot* snapshot);
+  void UpdateQualityScale_(float step_ms, float target_ms);
   void CalcERPCFM(dReal stiffness, dReal damping, dReal* erp, dReal* cfm);
 
   EventLoop* event_loop_{};
@@ -163,20 +227,34 @@ class BGDynamicsServer {
   std::vector<BGDynamicsShadowData*> shadows_;
   std::vector<BGDynamicsVolumeLightData*> volume_lights_;
   std::vector<BGDynamicsFuseData*> fuses_;
+  std::vector<std::vector<BGDynamicsVolumeLightData*>> volume_light_cells_;
+  float volume_light_grid_x_{};
+  float volume_light_grid_z_{};
+  float volume_light_cell_size_{1.0f};
+  int volume_light_grid_w_{};
+  int volume_light_grid_h_{};
   dWorldID ode_world_{};
   dJointGroupID ode_contact_group_{};
 
-  // Held by the dynamics module when changing any of these lists.
-  // Should be grabbed by a client if they need to access the list safely.
-  std::mutex shadow_list_mutex_;
-  std::mutex volume_light_list_mutex_;
-  std::mutex fuse_list_mutex_;
-  int step_count_{};
-  std::mutex step_count_mutex_;
+  // Shadow, volume-light and fuse lists above are only touched in our
+  // thread; the logic thread keeps its own lists for building step data.
+  std::atomic<int> step_count_{};
+  std::atomic<float> last_step_ms_{};
+
+  // Scales effect counts/detail between roughly 0 and 1 to keep our step
+  // times near the target given to us in step data.
+  float quality_scale_{1.0f};
+  float smoothed_step_ms_{};
+  int shadow_update_counter_{};
+
+  // Finished snapshot waiting to be picked up by the logic thread. We
+  // build into a fresh snapshot, swap it in here, and the logic thread
+  // swaps it out for drawing, so neither side ever waits on the other.
+  std::atomic<BGDynamicsDrawSnapshot*> latest_draw_snapshot_{};
   std::unique_ptr<ParticleSet> spark_particles_{};
-  std::list<Chunk*> chunks_;
-  std::list<Field*> fields_;
-  std::list<Tendril*> tendrils_;
+  std::vector<Chunk*> chunks_;
+  std::vector<Field*> fields_;
+  std::vector<Tendril*> tendrils_;
   int tendril_count_thick_{};
   int tendril_count_thin_{};
   int chunk_count_{};
@@ -2,6 +2,7 @@
 
 #include "ballistica/base/dynamics/bg/bg_dynamics_shadow.h"
 
+#include "ballistica/base/dynamics/bg/bg_dynamics.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics_server.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics_shadow_data.h"
 #include "ballistica/base/graphics/graphics.h"
@@ -14,19 +15,17 @@ BGDynamicsShadow::BGDynamicsShadow(float height_scaling) {
   // allocate our shadow data... we'll pass this to the BGDynamics thread,
   // which will then own it.
   data_ = new BGDynamicsShadowData(height_scaling);
-  assert(g_base->bg_dynamics_server);
-  g_base->bg_dynamics_server->PushAddShadowCall(data_);
+  assert(g_base->bg_dynamics);
+  g_base->bg_dynamics->AddShadow(data_);
 }
 
 BGDynamicsShadow::~BGDynamicsShadow() {
   assert(g_base->InLogicThread());
-  assert(g_base->bg_dynamics_server);
+  assert(g_base->bg_dynamics);
 
-  // let the data know the client side is dead,
-  // so we're no longer included in step messages
-  // (since by the time the worker gets it the data will be gone)
-  data_->client_dead = true;
-  g_base->bg_dynamics_server->PushRemoveShadowCall(data_);
+  // This drops us from step messages immediately and from the worker once
+  // it gets around to it (at which point the data will be gone).
+  g_base->bg_dynamics->RemoveShadow(data_);
 }
 
 void BGDynamicsShadow::SetPosition(const Vector3f& pos) {
@@ -21,7 +21,6 @@ struct BGDynamicsShadowData {
 
   void Synchronize() { pos_worker = pos_client; }
 
-  bool client_dead{};
   float height_scaling{};
 
   // For use by worker:
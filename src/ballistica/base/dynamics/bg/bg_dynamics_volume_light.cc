@@ -2,6 +2,7 @@
 
 #include "ballistica/base/dynamics/bg/bg_dynamics_volume_light.h"
 
+#include "ballistica/base/dynamics/bg/bg_dynamics.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics_volume_light_data.h"
 
 namespace ballistica::base {
@@ -11,20 +12,17 @@ BGDynamicsVolumeLight::BGDynamicsVolumeLight() {
   // allocate our light data... we'll pass this to the BGDynamics thread,
   // which will then own it
   data_ = new BGDynamicsVolumeLightData();
-  assert(g_base->bg_dynamics_server);
-  g_base->bg_dynamics_server->PushAddVolumeLightCall(data_);
+  assert(g_base->bg_dynamics);
+  g_base->bg_dynamics->AddVolumeLight(data_);
 }
 
 BGDynamicsVolumeLight::~BGDynamicsVolumeLight() {
   assert(g_base->InLogicThread());
 
-  // let the data know the client side is dead,
-  // so we're no longer included in step messages
-  // (since by the time the worker gets it the data will be gone)
-  data_->client_dead = true;
-
-  assert(g_base->bg_dynamics_server);
-  g_base->bg_dynamics_server->PushRemoveVolumeLightCall(data_);
+  // This drops us from step messages immediately and from the worker once
+  // it gets around to it (at which point the data will be gone).
+  assert(g_base->bg_dynamics);
+  g_base->bg_dynamics->RemoveVolumeLight(data_);
 }
 
 void BGDynamicsVolumeLight::SetPosition(const Vector3f& pos) {
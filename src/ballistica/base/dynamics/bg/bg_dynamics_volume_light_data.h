@@ -8,7 +8,6 @@
 namespace ballistica::base {
 
 struct BGDynamicsVolumeLightData {
-  bool client_dead{};
 
   // Position value owned by the client.
   Vector3f pos_client{0.0f, 0.0f, 0.0f};
@@ -3,6 +3,9 @@
 #include "ballistica/base/dynamics/collision_cache.h"
 
 #include <algorithm>
+#include <cstring>
+#include <list>
+#include <mutex>
 #include <vector>
 
 #include "ballistica/base/assets/assets.h"
@@ -12,9 +15,13 @@
 
 namespace ballistica::base {
 
+std::mutex CollisionCache::stored_grids_mutex_;
+std::list<CollisionCache::StoredGrid> CollisionCache::stored_grids_;
+
 CollisionCache::CollisionCache() : test_box_{dCreateBox(nullptr, 1, 1, 1)} {}
 
 CollisionCache::~CollisionCache() {
+  StoreGrid();
   if (shadow_ray_) {
     dGeomDestroy(shadow_ray_);
   }
@@ -22,6 +29,7 @@ CollisionCache::~CollisionCache() {
 }
 
 void CollisionCache::SetGeoms(const std::vector<dGeomID>& geoms) {
+  StoreGrid();
   dirty_ = true;
   geoms_ = geoms;
 }
@@ -349,6 +357,80 @@ void CollisionCache::Update() {
   memset(&glow_[0], 0, cell_count);
   precalc_index_ = 0;
   dirty_ = false;
+
+  // If we've refined a grid for this exact geometry before, start there.
+  geometry_key_ = CalcGeometryKey();
+  if (geometry_key_ != 0) {
+    std::scoped_lock lock(stored_grids_mutex_);
+    for (auto i = stored_grids_.begin(); i != stored_grids_.end(); ++i) {
+      if (i->geometry_key == geometry_key_) {
+        if (i->cells.size() == cells_.size()) {
+          cells_ = i->cells;
+          precalc_index_ = i->precalc_index;
+        }
+        stored_grids_.splice(stored_grids_.begin(), stored_grids_, i);
+        break;
+      }
+    }
+  }
+}
+
+auto CollisionCache::CalcGeometryKey() const -> uint64_t {
+  if (geoms_.empty()) {
+    return 0;
+  }
+
+  // FNV-1a over world-space triangles (or just bounds for non-meshes).
+  uint64_t hash{0xcbf29ce484222325ULL};
+  auto add = [&hash](const void* data, size_t size) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+  };
+  for (auto&& geom : geoms_) {
+    int geom_class = dGeomGetClass(geom);
+    add(&geom_class, sizeof(geom_class));
+    if (geom_class == dTriMeshClass) {
+      int tri_count = dGeomTriMeshGetTriangleCount(geom);
+      add(&tri_count, sizeof(tri_count));
+      for (int i = 0; i < tri_count; ++i) {
+        dVector3 v[3];
+        dGeomTriMeshGetTriangle(geom, i, &v[0], &v[1], &v[2]);
+        for (auto&& vert : v) {
+          add(vert, 3 * sizeof(dReal));
+        }
+      }
+    } else {
+      dReal aabb[6];
+      dGeomGetAABB(geom, aabb);
+      add(aabb, sizeof(aabb));
+    }
+  }
+  // Zero means 'no key'.
+  return hash == 0 ? 1 : hash;
+}
+
+void CollisionCache::StoreGrid() {
+  if (dirty_ || geometry_key_ == 0 || cells_.empty()) {
+    return;
+  }
+  std::scoped_lock lock(stored_grids_mutex_);
+  auto i = std::find_if(
+      stored_grids_.begin(), stored_grids_.end(),
+      [this](const StoredGrid& g) { return g.geometry_key == geometry_key_; });
+  if (i == stored_grids_.end()) {
+    stored_grids_.emplace_front();
+    if (stored_grids_.size() > kMaxStoredGrids) {
+      stored_grids_.pop_back();
+    }
+  } else {
+    stored_grids_.splice(stored_grids_.begin(), stored_grids_, i);
+  }
+  StoredGrid& grid{stored_grids_.front()};
+  grid.geometry_key = geometry_key_;
+  grid.precalc_index = precalc_index_;
+  grid.cells = cells_;
 }
 
 }  // namespace ballistica::base
@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_BASE_DYNAMICS_COLLISION_CACHE_H_
 #define BALLISTICA_BASE_DYNAMICS_COLLISION_CACHE_H_
 
+#include <list>
+#include <mutex>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -12,6 +14,10 @@ namespace ballistica::base {
 
 // Given geoms, creates/samples a height map on the fly which can be used
 // for very fast AABB tests against the geometry.
+//
+// Refined height maps are kept around in memory keyed by a hash of the
+// geometry they describe, so loading the same map again (in this cache or
+// any other) starts out warm.
 class CollisionCache {
  public:
   CollisionCache();
@@ -28,14 +34,31 @@ class CollisionCache {
   void Precalc();
 
  private:
-  void TestCell(size_t cell_index, int x, int z);
-  void Update();
-  uint32_t precalc_index_{};
-  std::vector<dGeomID> geoms_;
   struct Cell {
     float height_confirmed_empty_;
     float height_confirmed_collide_;
   };
+  struct StoredGrid {
+    uint64_t geometry_key{};
+    uint32_t precalc_index{};
+    std::vector<Cell> cells;
+  };
+  void TestCell(size_t cell_index, int x, int z);
+  void Update();
+  auto CalcGeometryKey() const -> uint64_t;
+
+  /// Stash our current grid so future caches for the same geometry can
+  /// pick up where we left off.
+  void StoreGrid();
+
+  /// How many grids we hold on to (each is up to 512k).
+  static constexpr size_t kMaxStoredGrids = 8;
+  static std::mutex stored_grids_mutex_;
+  static std::list<StoredGrid> stored_grids_;
+
+  uint32_t precalc_index_{};
+  uint64_t geometry_key_{};
+  std::vector<dGeomID> geoms_;
   std::vector<Cell> cells_;
   std::vector<uint8_t> glow_;
   bool dirty_{true};
@@ -324,6 +324,8 @@ class RenderComponent {
 
   void EnsureDrawing() {
     if (state_ != State::kDrawing) {
+      // Anything batched up has to go out first to keep draw order intact.
+      g_base->graphics->overlay_quads()->Flush();
       WriteConfig();
       state_ = State::kDrawing;
 #if BA_DEBUG_BUILD
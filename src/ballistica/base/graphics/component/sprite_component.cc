@@ -13,7 +13,14 @@ void SpriteComponent::WriteConfig() {
   if (!texture_.exists()) {
     texture_ = g_base->assets->SysTexture(SysTextureID::kWhite);
   }
-  if (exponent_ == 1) {
+  if (particles_) {
+    assert(exponent_ == 1);
+    ConfigForShading(ShadingType::kParticle);
+    cmd_buffer_->PutFloats(color_r_, color_g_, color_b_, color_a_);
+    cmd_buffer_->PutInt(overlay_);
+    cmd_buffer_->PutFloat(particle_step_);
+    cmd_buffer_->PutTexture(texture_);
+  } else if (exponent_ == 1) {
     ConfigForShading(ShadingType::kSprite);
     cmd_buffer_->PutFloats(color_r_, color_g_, color_b_, color_a_);
     cmd_buffer_->PutInt(overlay_);
@@ -35,16 +35,26 @@ class SpriteComponent : public RenderComponent {
     texture_ = t;
   }
 
+  /// Draw ParticleMeshes, animated to the given step. (Particles are
+  /// always camera-aligned).
+  void SetParticleStep(float step) {
+    EnsureConfiguring();
+    particle_step_ = step;
+    particles_ = true;
+  }
+
  protected:
   void WriteConfig() override;
   bool have_color_{};
   bool camera_aligned_{};
   bool overlay_{};
+  bool particles_{};
   uint8_t exponent_{1};
   float color_r_{1.0f};
   float color_g_{1.0f};
   float color_b_{1.0f};
   float color_a_{1.0f};
+  float particle_step_{};
   Object::Ref<TextureAsset> texture_;
 };
 
@@ -51,6 +51,7 @@ PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers{};
 PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer{};
 PFNGLBINDBUFFERPROC glBindBuffer{};
 PFNGLBUFFERDATAPROC glBufferData{};
+PFNGLBUFFERSUBDATAPROC glBufferSubData{};
 PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage{};
 PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC glRenderbufferStorageMultisample{};
 PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer{};
@@ -72,6 +73,15 @@ PFNGLDETACHSHADERPROC glDetachShader{};
 PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog{};
 PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog{};
 PFNGLGETSTRINGIPROC glGetStringi{};
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced{};
+PFNGLGETPROGRAMBINARYPROC glGetProgramBinary{};
+PFNGLPROGRAMBINARYPROC glProgramBinary{};
+PFNGLPROGRAMPARAMETERIPROC glProgramParameteri{};
+PFNGLGENQUERIESPROC glGenQueries{};
+PFNGLDELETEQUERIESPROC glDeleteQueries{};
+PFNGLQUERYCOUNTERPROC glQueryCounter{};
+PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv{};
+PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v{};
 
 namespace ballistica::base {
 
@@ -144,6 +154,7 @@ void SysGLInit(RendererGL* renderer) {
   GET(PFNGLBINDRENDERBUFFERPROC, glBindRenderbuffer, true);
   GET(PFNGLBINDBUFFERPROC, glBindBuffer, true);
   GET(PFNGLBUFFERDATAPROC, glBufferData, true);
+  GET(PFNGLBUFFERSUBDATAPROC, glBufferSubData, true);
   GET(PFNGLRENDERBUFFERSTORAGEPROC, glRenderbufferStorage, true);
   GET(PFNGLFRAMEBUFFERRENDERBUFFERPROC, glFramebufferRenderbuffer, true);
   GET(PFNGLCHECKFRAMEBUFFERSTATUSPROC, glCheckFramebufferStatus, true);
@@ -169,6 +180,19 @@ void SysGLInit(RendererGL* renderer) {
   GET(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer, true);
   GET(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC, glRenderbufferStorageMultisample,
       true);
+  GET(PFNGLDRAWELEMENTSINSTANCEDPROC, glDrawElementsInstanced, true);
+
+  // Optional; used for caching program binaries.
+  GET(PFNGLGETPROGRAMBINARYPROC, glGetProgramBinary, false);
+  GET(PFNGLPROGRAMBINARYPROC, glProgramBinary, false);
+  GET(PFNGLPROGRAMPARAMETERIPROC, glProgramParameteri, false);
+
+  // Optional; used for GPU timing in the render profiler.
+  GET(PFNGLGENQUERIESPROC, glGenQueries, false);
+  GET(PFNGLDELETEQUERIESPROC, glDeleteQueries, false);
+  GET(PFNGLQUERYCOUNTERPROC, glQueryCounter, false);
+  GET(PFNGLGETQUERYOBJECTIVPROC, glGetQueryObjectiv, false);
+  GET(PFNGLGETQUERYOBJECTUI64VPROC, glGetQueryObjectui64v, false);
 }
 #undef GET
 #undef GET2
@@ -0,0 +1,177 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_GL_GPU_TIMER_GL_H_
+#define BALLISTICA_BASE_GRAPHICS_GL_GPU_TIMER_GL_H_
+
+#if BA_ENABLE_OPENGL
+
+#include <string>
+#include <vector>
+
+#include "ballistica/base/graphics/gl/renderer_gl.h"
+#include "ballistica/base/graphics/graphics_server.h"
+
+namespace ballistica::base {
+
+/// Times group-marker sections on the CPU and (where timestamp queries are
+/// available) on the GPU. Results are read back a few frames late so we
+/// never stall waiting on the GPU.
+class RendererGL::GPUTimerGL {
+ public:
+  explicit GPUTimerGL(bool use_queries) : use_queries_(use_queries) {}
+
+  ~GPUTimerGL() {
+    assert(g_base->app_adapter->InGraphicsContext());
+#if !BA_OPENGL_IS_ES
+    if (!g_base->graphics_server->renderer_context_lost()) {
+      for (auto&& frame : frames_) {
+        if (!frame.queries.empty()) {
+          glDeleteQueries(static_cast<GLsizei>(frame.queries.size()),
+                          frame.queries.data());
+        }
+      }
+    }
+#endif
+  }
+
+  auto active() const -> bool { return active_; }
+
+  void BeginFrame() {
+    assert(!active_);
+    frame_index_ = (frame_index_ + 1) % kFrameCount;
+    auto& frame{frames_[frame_index_]};
+    frame.sections.clear();
+    frame.queries_used = 0;
+    open_sections_.clear();
+    active_ = true;
+  }
+
+  /// Finish the current frame and append results for the oldest frame
+  /// we've got (if its queries have come back yet).
+  void EndFrame(std::vector<RenderProfileSection>* sections) {
+    assert(sections);
+    if (!active_) {
+      return;
+    }
+    while (!open_sections_.empty()) {
+      Pop();
+    }
+    active_ = false;
+    ReadResults_(&frames_[(frame_index_ + 1) % kFrameCount], sections);
+  }
+
+  void Push(const char* label) {
+    assert(active_);
+    auto& frame{frames_[frame_index_]};
+    Section_ section;
+    section.label = label;
+    section.depth = static_cast<int>(open_sections_.size());
+    section.cpu_start = g_core->AppTimeMicrosecs();
+    section.query_begin = AddQuery_(&frame);
+    open_sections_.push_back(frame.sections.size());
+    frame.sections.push_back(section);
+  }
+
+  void Pop() {
+    assert(active_);
+    if (open_sections_.empty()) {
+      return;
+    }
+    auto& frame{frames_[frame_index_]};
+    auto& section{frame.sections[open_sections_.back()]};
+    open_sections_.pop_back();
+    section.cpu_end = g_core->AppTimeMicrosecs();
+    section.query_end = AddQuery_(&frame);
+  }
+
+ private:
+  // How many frames are in flight before we read results back.
+  static constexpr int kFrameCount = 3;
+
+  struct Section_ {
+    std::string label;
+    int depth{};
+    microsecs_t cpu_start{};
+    microsecs_t cpu_end{};
+    int query_begin{-1};
+    int query_end{-1};
+  };
+
+  struct Frame_ {
+    std::vector<Section_> sections;
+    std::vector<GLuint> queries;
+    int queries_used{};
+  };
+
+  auto AddQuery_(Frame_* frame) -> int {
+    if (!use_queries_) {
+      return -1;
+    }
+#if BA_OPENGL_IS_ES
+    return -1;
+#else
+    if (frame->queries_used == static_cast<int>(frame->queries.size())) {
+      GLuint query{};
+      glGenQueries(1, &query);
+      frame->queries.push_back(query);
+    }
+    glQueryCounter(frame->queries[frame->queries_used], GL_TIMESTAMP);
+    BA_DEBUG_CHECK_GL_ERROR;
+    return frame->queries_used++;
+#endif
+  }
+
+  void ReadResults_(Frame_* frame, std::vector<RenderProfileSection>* out) {
+    if (frame->sections.empty()) {
+      return;
+    }
+
+    // Queries complete in order, so if the last is in they all are. If
+    // not, the GPU is way behind; just skip GPU times for this one.
+    bool have_gpu_times{};
+#if !BA_OPENGL_IS_ES
+    if (use_queries_ && frame->queries_used > 0) {
+      GLint available{};
+      glGetQueryObjectiv(frame->queries[frame->queries_used - 1],
+                         GL_QUERY_RESULT_AVAILABLE, &available);
+      have_gpu_times = (available != 0);
+    }
+#endif
+    for (auto&& section : frame->sections) {
+      RenderProfileSection result;
+      result.label = section.label;
+      result.depth = section.depth;
+      result.cpu_ms =
+          static_cast<float>(section.cpu_end - section.cpu_start) / 1000.0f;
+#if !BA_OPENGL_IS_ES
+      if (have_gpu_times && section.query_begin >= 0
+          && section.query_end >= 0) {
+        GLuint64 begin{};
+        GLuint64 end{};
+        glGetQueryObjectui64v(frame->queries[section.query_begin],
+                              GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame->queries[section.query_end],
+                              GL_QUERY_RESULT, &end);
+        result.gpu_ms =
+            end > begin ? static_cast<float>(end - begin) / 1000000.0f : 0.0f;
+      }
+#endif
+      out->push_back(result);
+    }
+    BA_DEBUG_CHECK_GL_ERROR;
+    frame->sections.clear();
+    frame->queries_used = 0;
+  }
+
+  Frame_ frames_[kFrameCount];
+  std::vector<size_t> open_sections_;
+  int frame_index_{};
+  bool use_queries_{};
+  bool active_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BA_ENABLE_OPENGL
+
+#endif  // BALLISTICA_BASE_GRAPHICS_GL_GPU_TIMER_GL_H_
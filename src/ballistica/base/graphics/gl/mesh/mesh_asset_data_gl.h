@@ -6,14 +6,20 @@
 #if BA_ENABLE_OPENGL
 
 #include <string>
+#include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/graphics/gl/gl_sys.h"
 #include "ballistica/base/graphics/gl/renderer_gl.h"
 #include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::base {
 
+/// Meshes whose vertices all lie within this distance of their origin get
+/// half-float positions; beyond it half precision starts to show.
+const float kMeshHalfPositionMaxRadius{2.0f};
+
 class RendererGL::MeshAssetDataGL : public MeshAssetRendererData {
  public:
   enum BufferType { kVertices, kIndices, kBufferCount };
@@ -38,34 +44,46 @@ class RendererGL::MeshAssetDataGL : public MeshAssetRendererData {
 
     BA_DEBUG_CHECK_GL_ERROR;
 
-    // Fill our vertex data buffer.
+    // Fill our vertex data buffer. We repack vertices tighter than they
+    // come in the file: normals go to 10:10:10 and positions for small
+    // meshes go to half floats (16 bytes per vertex instead of 24).
     renderer_->BindArrayBuffer(vbos_[kVertices]);
     BA_DEBUG_CHECK_GL_ERROR;
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast_check_fit<GLsizeiptr>(model.vertices().size()
-                                                   * sizeof(VertexObjectFull)),
-                 &(model.vertices()[0]), GL_STATIC_DRAW);
-    BA_DEBUG_CHECK_GL_ERROR;
-
-    glVertexAttribPointer(
-        kVertexAttrPosition, 3, GL_FLOAT, GL_FALSE, sizeof(VertexObjectFull),
-        reinterpret_cast<void*>(offsetof(VertexObjectFull, position)));
-    glEnableVertexAttribArray(kVertexAttrPosition);
-    glVertexAttribPointer(
-        kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(VertexObjectFull),
-        reinterpret_cast<void*>(offsetof(VertexObjectFull, uv)));
-    glEnableVertexAttribArray(kVertexAttrUV);
-    glVertexAttribPointer(
-        kVertexAttrNormal, 3, GL_SHORT, GL_TRUE, sizeof(VertexObjectFull),
-        reinterpret_cast<void*>(offsetof(VertexObjectFull, normal)));
-    glEnableVertexAttribArray(kVertexAttrNormal);
-    BA_DEBUG_CHECK_GL_ERROR;
+    if (model.bounds_radius() <= kMeshHalfPositionMaxRadius) {
+      std::vector<VertexHalf_> vertices(model.vertices().size());
+      for (size_t i = 0; i < vertices.size(); ++i) {
+        auto& src{model.vertices()[i]};
+        auto& dst{vertices[i]};
+        for (int j = 0; j < 3; ++j) {
+          dst.position[j] = Utils::FloatToHalf(src.position[j]);
+        }
+        dst.uv[0] = src.uv[0];
+        dst.uv[1] = src.uv[1];
+        dst.normal = PackNormal_(src.normal);
+      }
+      UploadVertices_(vertices, GL_HALF_FLOAT);
+    } else {
+      std::vector<VertexFloat_> vertices(model.vertices().size());
+      for (size_t i = 0; i < vertices.size(); ++i) {
+        auto& src{model.vertices()[i]};
+        auto& dst{vertices[i]};
+        for (int j = 0; j < 3; ++j) {
+          dst.position[j] = src.position[j];
+        }
+        dst.uv[0] = src.uv[0];
+        dst.uv[1] = src.uv[1];
+        dst.normal = PackNormal_(src.normal);
+      }
+      UploadVertices_(vertices, GL_FLOAT);
+    }
 
     // Fill our index data buffer.
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbos_[kIndices]);
 
     const GLvoid* index_data;
-    switch (model.GetIndexSize()) {
+    int index_size{model.GetIndexSize()};
+    std::vector<uint16_t> narrowed_indices;
+    switch (index_size) {
       case 1: {
         elem_count_ = static_cast<uint32_t>(model.indices8().size());
         index_type_ = GL_UNSIGNED_BYTE;
@@ -79,6 +97,17 @@ class RendererGL::MeshAssetDataGL : public MeshAssetRendererData {
         break;
       }
       case 4: {
+        // 16 bit indices halve index memory and bandwidth (and work on
+        // ES2), so drop down to them whenever every index fits.
+        if (model.vertices().size() <= 65536) {
+          narrowed_indices.assign(model.indices32().begin(),
+                                  model.indices32().end());
+          elem_count_ = static_cast<uint32_t>(narrowed_indices.size());
+          index_type_ = GL_UNSIGNED_SHORT;
+          index_data = static_cast<const GLvoid*>(narrowed_indices.data());
+          index_size = 2;
+          break;
+        }
         BA_LOG_ONCE(
             LogName::kBaGraphics, LogLevel::kWarning,
             "GL WARNING - USING 32 BIT INDICES WHICH WONT WORK IN ES2!!");
@@ -92,7 +121,7 @@ class RendererGL::MeshAssetDataGL : public MeshAssetRendererData {
     }
     glBufferData(
         GL_ELEMENT_ARRAY_BUFFER,
-        static_cast_check_fit<GLsizeiptr>(elem_count_ * model.GetIndexSize()),
+        static_cast_check_fit<GLsizeiptr>(elem_count_ * index_size),
         index_data, GL_STATIC_DRAW);
 
     BA_DEBUG_CHECK_GL_ERROR;
@@ -135,12 +164,62 @@ class RendererGL::MeshAssetDataGL : public MeshAssetRendererData {
     }
     BA_DEBUG_CHECK_GL_ERROR;
   }
+  void DrawInstanced(int instance_count) {
+    BA_DEBUG_CHECK_GL_ERROR;
+    if (elem_count_ > 0 && instance_count > 0) {
+      glDrawElementsInstanced(GL_TRIANGLES, elem_count_, index_type_, nullptr,
+                              instance_count);
+    }
+    BA_DEBUG_CHECK_GL_ERROR;
+  }
 
 #if BA_DEBUG_BUILD
   auto name() const -> const std::string& { return name_; }
 #endif
 
  private:
+  struct VertexHalf_ {
+    uint16_t position[4];
+    uint16_t uv[2];
+    uint32_t normal;
+  };
+
+  struct VertexFloat_ {
+    float position[3];
+    uint16_t uv[2];
+    uint32_t normal;
+  };
+
+  /// Pack a normalized-short normal into GL_INT_2_10_10_10_REV.
+  static auto PackNormal_(const int16_t* normal) -> uint32_t {
+    uint32_t packed{};
+    for (int i = 0; i < 3; ++i) {
+      auto val = static_cast<int32_t>(normal[i]) * 511 / 32767;
+      packed |= (static_cast<uint32_t>(val) & 0x3FFu) << (i * 10);
+    }
+    return packed;
+  }
+
+  template <typename T>
+  void UploadVertices_(const std::vector<T>& vertices, GLenum position_type) {
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast_check_fit<GLsizeiptr>(vertices.size() * sizeof(T)),
+                 vertices.data(), GL_STATIC_DRAW);
+    BA_DEBUG_CHECK_GL_ERROR;
+    glVertexAttribPointer(kVertexAttrPosition, 3, position_type, GL_FALSE,
+                          sizeof(T),
+                          reinterpret_cast<void*>(offsetof(T, position)));
+    glEnableVertexAttribArray(kVertexAttrPosition);
+    glVertexAttribPointer(kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
+                          sizeof(T), reinterpret_cast<void*>(offsetof(T, uv)));
+    glEnableVertexAttribArray(kVertexAttrUV);
+    glVertexAttribPointer(kVertexAttrNormal, 4, GL_INT_2_10_10_10_REV, GL_TRUE,
+                          sizeof(T),
+                          reinterpret_cast<void*>(offsetof(T, normal)));
+    glEnableVertexAttribArray(kVertexAttrNormal);
+    BA_DEBUG_CHECK_GL_ERROR;
+  }
+
 #if BA_DEBUG_BUILD
   std::string name_;
 #endif
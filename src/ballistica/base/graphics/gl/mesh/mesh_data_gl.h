@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_BASE_GRAPHICS_GL_MESH_MESH_DATA_GL_H_
 #define BALLISTICA_BASE_GRAPHICS_GL_MESH_MESH_DATA_GL_H_
 
+#include <algorithm>
+
 #include "ballistica/base/graphics/mesh/mesh_index_buffer_16.h"
 #include "ballistica/base/graphics/mesh/mesh_index_buffer_32.h"
 #if BA_ENABLE_OPENGL
@@ -119,11 +121,11 @@ class RendererGL::MeshDataGL : public MeshRendererData {
       renderer_->BindVertexArray_(vao_);
       elem_count_ = static_cast<uint32_t>(data->elements.size());
       assert(elem_count_ > 0);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   static_cast_check_fit<GLsizeiptr>(
-                       data->elements.size() * sizeof(data->elements[0])),
-                   &data->elements[0],
-                   dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+      UploadBuffer_(GL_ELEMENT_ARRAY_BUFFER, kIndexBuffer,
+                    static_cast_check_fit<GLsizeiptr>(
+                        data->elements.size() * sizeof(data->elements[0])),
+                    &data->elements[0],
+                    dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
       index_state_ = data->state;
       have_index_data_ = true;
       BA_LOG_ONCE(LogName::kBaGraphics, LogLevel::kWarning,
@@ -139,11 +141,11 @@ class RendererGL::MeshDataGL : public MeshRendererData {
       renderer_->BindVertexArray_(vao_);
       elem_count_ = static_cast<uint32_t>(data->elements.size());
       assert(elem_count_ > 0);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   static_cast_check_fit<GLsizeiptr>(
-                       data->elements.size() * sizeof(data->elements[0])),
-                   &data->elements[0],
-                   dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+      UploadBuffer_(GL_ELEMENT_ARRAY_BUFFER, kIndexBuffer,
+                    static_cast_check_fit<GLsizeiptr>(
+                        data->elements.size() * sizeof(data->elements[0])),
+                    &data->elements[0],
+                    dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
       index_state_ = data->state;
       have_index_data_ = true;
       index_type_ = GL_UNSIGNED_SHORT;
@@ -177,10 +179,10 @@ class RendererGL::MeshDataGL : public MeshRendererData {
       if (!uses_index_data_ && buffer_type == kVertexBufferPrimary) {
         elem_count_ = static_cast<uint32_t>(data->elements.size());
       }
-      glBufferData(GL_ARRAY_BUFFER,
-                   static_cast<GLsizeiptr>(data->elements.size()
-                                           * sizeof(data->elements[0])),
-                   &(data->elements[0]), draw_type);
+      UploadBuffer_(GL_ARRAY_BUFFER, buffer_type,
+                    static_cast<GLsizeiptr>(data->elements.size()
+                                            * sizeof(data->elements[0])),
+                    &(data->elements[0]), draw_type);
       BA_DEBUG_CHECK_GL_ERROR;
       *state = data->state;
       *have = true;
@@ -189,8 +191,35 @@ class RendererGL::MeshDataGL : public MeshRendererData {
     }
   }
 
-  // FIXME: Should do some sort of ring-buffer system.
+  // Upload data to one of our buffers, which must already be bound to
+  // target.
+  //
+  // Dynamic meshes get re-uploaded most frames, so for those we re-specify
+  // the buffer with no data and then fill it with glBufferSubData. This
+  // 'orphans' the old storage, letting the driver hand us fresh memory
+  // instead of stalling until the GPU is done reading the previous
+  // contents. We also round sizes up and never shrink, so the driver sees
+  // the same allocation size frame to frame and can recycle its storage.
+  void UploadBuffer_(GLenum target, BufferType buffer_type, GLsizeiptr size,
+                     const void* data, GLenum usage) {
+    if (!dynamic_draw_) {
+      glBufferData(target, size, data, usage);
+      return;
+    }
+    GLsizeiptr& capacity{buffer_capacities_[buffer_type]};
+    if (size > capacity) {
+      GLsizeiptr new_capacity = std::max(capacity, GLsizeiptr{1024});
+      while (new_capacity < size) {
+        new_capacity *= 2;
+      }
+      capacity = new_capacity;
+    }
+    glBufferData(target, capacity, nullptr, usage);
+    glBufferSubData(target, 0, size, data);
+  }
+
   GLuint vbos_[3]{};
+  GLsizeiptr buffer_capacities_[3]{};
   GLuint vao_{};
   auto GetBufferCount() const -> int {
     return uses_secondary_data_ ? 3 : (uses_index_data_ ? 2 : 1);
@@ -0,0 +1,55 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_GL_MESH_MESH_DATA_PARTICLE_GL_H_
+#define BALLISTICA_BASE_GRAPHICS_GL_MESH_MESH_DATA_PARTICLE_GL_H_
+
+#if BA_ENABLE_OPENGL
+
+#include "ballistica/base/graphics/gl/mesh/mesh_data_gl.h"
+
+namespace ballistica::base {
+
+class RendererGL::MeshDataParticleGL : public RendererGL::MeshDataGL {
+ public:
+  explicit MeshDataParticleGL(RendererGL* renderer)
+      : MeshDataGL(renderer, kUsesIndexBuffer) {
+    // Set up our vertex data.
+    renderer_->BindArrayBuffer(vbos_[kVertexBufferPrimary]);
+    glVertexAttribPointer(
+        kVertexAttrPosition, 3, GL_FLOAT, GL_FALSE, sizeof(VertexParticle),
+        reinterpret_cast<void*>(offsetof(VertexParticle, position)));
+    glEnableVertexAttribArray(kVertexAttrPosition);
+    glVertexAttribPointer(
+        kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(VertexParticle),
+        reinterpret_cast<void*>(offsetof(VertexParticle, uv)));
+    glEnableVertexAttribArray(kVertexAttrUV);
+    glVertexAttribPointer(
+        kVertexAttrSize, 1, GL_FLOAT, GL_FALSE, sizeof(VertexParticle),
+        reinterpret_cast<void*>(offsetof(VertexParticle, size)));
+    glEnableVertexAttribArray(kVertexAttrSize);
+    glVertexAttribPointer(
+        kVertexAttrColor, 4, GL_FLOAT, GL_FALSE, sizeof(VertexParticle),
+        reinterpret_cast<void*>(offsetof(VertexParticle, color)));
+    glEnableVertexAttribArray(kVertexAttrColor);
+    glVertexAttribPointer(
+        kVertexAttrVelocity, 4, GL_FLOAT, GL_FALSE, sizeof(VertexParticle),
+        reinterpret_cast<void*>(offsetof(VertexParticle, velocity)));
+    glEnableVertexAttribArray(kVertexAttrVelocity);
+    glVertexAttribPointer(
+        kVertexAttrParticleParams, 4, GL_FLOAT, GL_FALSE,
+        sizeof(VertexParticle),
+        reinterpret_cast<void*>(offsetof(VertexParticle, params)));
+    glEnableVertexAttribArray(kVertexAttrParticleParams);
+  }
+  void SetData(MeshBuffer<VertexParticle>* data) {
+    UpdateBufferData(kVertexBufferPrimary, data, &primary_state_,
+                     &have_primary_data_,
+                     dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+  }
+};
+
+}  // namespace ballistica::base
+
+#endif  // BA_ENABLE_OPENGL
+
+#endif  // BALLISTICA_BASE_GRAPHICS_GL_MESH_MESH_DATA_PARTICLE_GL_H_
@@ -22,22 +22,47 @@ class RendererGL::ShaderGL : public Object {
   }
 
   ShaderGL(GLenum type_in, const std::string& src_in) : type_(type_in) {
-    assert(g_base->app_adapter->InGraphicsContext());
-    BA_DEBUG_CHECK_GL_ERROR;
     assert(type_ == GL_FRAGMENT_SHADER || type_ == GL_VERTEX_SHADER);
-    shader_ = glCreateShader(type_);
-    BA_DEBUG_CHECK_GL_ERROR;
-    BA_PRECONDITION(shader_);
 #if !BA_OPENGL_IS_ES
-    std::string src_fin = src_in;
+    src_ = src_in;
     if (type_ == GL_FRAGMENT_SHADER) {
       // gl_FragColor is no more. Define our equivalent.
-      src_fin = "out vec4 " BA_GLSL_FRAGCOLOR ";\n" + src_fin;
+      src_ = "out vec4 " BA_GLSL_FRAGCOLOR ";\n" + src_;
     }
-    src_fin = "#version 150 core\n" + src_fin;
+    src_ = "#version 150 core\n" + src_;
 #else
-    std::string src_fin = src_in;
+    src_ = src_in;
 #endif
+  }
+
+  ~ShaderGL() override {
+    assert(g_base->app_adapter->InGraphicsContext());
+    if (shader_ && !g_base->graphics_server->renderer_context_lost()) {
+      glDeleteShader(shader_);
+      BA_DEBUG_CHECK_GL_ERROR;
+    }
+  }
+
+  /// Final source code for the shader.
+  auto source() const -> const std::string& { return src_; }
+
+  /// Return the GL shader, compiling it if need be. Compiling is deferred
+  /// so programs loaded from the binary cache can skip it entirely.
+  auto shader() -> GLuint {
+    if (!shader_) {
+      Compile_();
+    }
+    return shader_;
+  }
+
+ private:
+  void Compile_() {
+    assert(g_base->app_adapter->InGraphicsContext());
+    BA_DEBUG_CHECK_GL_ERROR;
+    shader_ = glCreateShader(type_);
+    BA_DEBUG_CHECK_GL_ERROR;
+    BA_PRECONDITION(shader_);
+    const std::string& src_fin{src_};
     const char* s = src_fin.c_str();
     glShaderSource(shader_, 1, &s, nullptr);
     glCompileShader(shader_);
@@ -76,17 +101,6 @@ class RendererGL::ShaderGL : public Object {
     BA_DEBUG_CHECK_GL_ERROR;
   }
 
-  ~ShaderGL() override {
-    assert(g_base->app_adapter->InGraphicsContext());
-    if (!g_base->graphics_server->renderer_context_lost()) {
-      glDeleteShader(shader_);
-      BA_DEBUG_CHECK_GL_ERROR;
-    }
-  }
-
-  auto shader() const -> GLuint { return shader_; }
-
- private:
   auto GetTypeName() const -> const char* {
     if (type_ == GL_VERTEX_SHADER) {
       return "vertex";
@@ -103,6 +117,7 @@ class RendererGL::ShaderGL : public Object {
   }
 
   std::string name_;
+  std::string src_;
   GLuint shader_{};
   GLenum type_{};
   BA_DISALLOW_CLASS_COPIES(ShaderGL);
@@ -135,50 +150,24 @@ class RendererGL::ProgramGL {
     BA_DEBUG_CHECK_GL_ERROR;
     program_ = glCreateProgram();
     BA_PRECONDITION(program_);
-    glAttachShader(program_, fragment_shader_->shader());
-    glAttachShader(program_, vertex_shader_->shader());
-    assert(pflags_ & PFLAG_USES_POSITION_ATTR);
-    if (pflags_ & PFLAG_USES_POSITION_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrPosition, "position");
-    }
-    if (pflags_ & PFLAG_USES_UV_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrUV, "uv");
-    }
-    if (pflags_ & PFLAG_USES_NORMAL_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrNormal, "normal");
-    }
-    if (pflags_ & PFLAG_USES_ERODE_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrErode, "erode");
-    }
-    if (pflags_ & PFLAG_USES_COLOR_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrColor, "color");
-    }
-    if (pflags_ & PFLAG_USES_SIZE_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrSize, "size");
-    }
-    if (pflags_ & PFLAG_USES_DIFFUSE_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrDiffuse, "diffuse");
-    }
-    if (pflags_ & PFLAG_USES_UV2_ATTR) {
-      glBindAttribLocation(program_, kVertexAttrUV2, "uv2");
-    }
-    glLinkProgram(program_);
-    GLint linkStatus;
-    glGetProgramiv(program_, GL_LINK_STATUS, &linkStatus);
-    if (linkStatus == GL_FALSE) {
-      g_core->Log(LogName::kBaGraphics, LogLevel::kError,
-                  "Link failed for program '" + name_ + "':\n" + GetInfo());
-    } else {
-      assert(linkStatus == GL_TRUE);
 
-      std::string info = GetInfo();
-      if (!info.empty()
-          && (strstr(info.c_str(), "error:") || strstr(info.c_str(), "warning:")
-              || strstr(info.c_str(), "Error:")
-              || strstr(info.c_str(), "Warning:"))) {
-        g_core->Log(LogName::kBaGraphics, LogLevel::kError,
-                    "WARNING: program using frag shader '" + name_
-                        + "' returned info:\n" + info);
+    // Try to load a previously linked binary of this program before
+    // falling back to compiling from source.
+    uint64_t binary_key{};
+    bool loaded_binary{};
+    if (renderer_->program_binary_support()) {
+      binary_key = renderer_->GetProgramBinaryKey_(
+          vertex_shader_->source(), fragment_shader_->source(), pflags_);
+      loaded_binary = renderer_->LoadProgramBinary_(program_, binary_key);
+    }
+    if (!loaded_binary) {
+      LinkFromSource_();
+      if (renderer_->program_binary_support()) {
+        GLint link_status{GL_FALSE};
+        glGetProgramiv(program_, GL_LINK_STATUS, &link_status);
+        if (link_status == GL_TRUE) {
+          renderer_->SaveProgramBinary_(program_, binary_key);
+        }
       }
     }
 
@@ -216,8 +205,10 @@ class RendererGL::ProgramGL {
   virtual ~ProgramGL() {
     assert(g_base->app_adapter->InGraphicsContext());
     if (!g_base->graphics_server->renderer_context_lost()) {
-      glDetachShader(program_, fragment_shader_->shader());
-      glDetachShader(program_, vertex_shader_->shader());
+      if (attached_shaders_) {
+        glDetachShader(program_, fragment_shader_->shader());
+        glDetachShader(program_, vertex_shader_->shader());
+      }
       glDeleteProgram(program_);
       BA_DEBUG_CHECK_GL_ERROR;
     }
@@ -335,6 +326,65 @@ class RendererGL::ProgramGL {
   auto renderer() const -> RendererGL* { return renderer_; }
 
  private:
+  void LinkFromSource_() {
+    glAttachShader(program_, fragment_shader_->shader());
+    glAttachShader(program_, vertex_shader_->shader());
+    attached_shaders_ = true;
+    assert(pflags_ & PFLAG_USES_POSITION_ATTR);
+    if (pflags_ & PFLAG_USES_POSITION_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrPosition, "position");
+    }
+    if (pflags_ & PFLAG_USES_UV_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrUV, "uv");
+    }
+    if (pflags_ & PFLAG_USES_NORMAL_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrNormal, "normal");
+    }
+    if (pflags_ & PFLAG_USES_ERODE_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrErode, "erode");
+    }
+    if (pflags_ & PFLAG_USES_COLOR_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrColor, "color");
+    }
+    if (pflags_ & PFLAG_USES_SIZE_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrSize, "size");
+    }
+    if (pflags_ & PFLAG_USES_DIFFUSE_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrDiffuse, "diffuse");
+    }
+    if (pflags_ & PFLAG_USES_UV2_ATTR) {
+      glBindAttribLocation(program_, kVertexAttrUV2, "uv2");
+    }
+    if (pflags_ & PFLAG_USES_PARTICLE_ATTRS) {
+      glBindAttribLocation(program_, kVertexAttrVelocity, "velocity");
+      glBindAttribLocation(program_, kVertexAttrParticleParams,
+                           "particleParams");
+    }
+    if (renderer_->program_binary_support()) {
+      glProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                          GL_TRUE);
+    }
+    glLinkProgram(program_);
+    GLint linkStatus;
+    glGetProgramiv(program_, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus == GL_FALSE) {
+      g_core->Log(LogName::kBaGraphics, LogLevel::kError,
+                  "Link failed for program '" + name_ + "':\n" + GetInfo());
+    } else {
+      assert(linkStatus == GL_TRUE);
+
+      std::string info = GetInfo();
+      if (!info.empty()
+          && (strstr(info.c_str(), "error:") || strstr(info.c_str(), "warning:")
+              || strstr(info.c_str(), "Error:")
+              || strstr(info.c_str(), "Warning:"))) {
+        g_core->Log(LogName::kBaGraphics, LogLevel::kError,
+                    "WARNING: program using frag shader '" + name_
+                        + "' returned info:\n" + info);
+      }
+    }
+  }
+
   RendererGL* renderer_{};
   Object::Ref<FragmentShaderGL> fragment_shader_;
   Object::Ref<VertexShaderGL> vertex_shader_;
@@ -353,6 +403,7 @@ class RendererGL::ProgramGL {
   int cam_pos_state_{};
   int model_world_matrix_state_{};
   int model_view_matrix_state_{};
+  bool attached_shaders_{};
   BA_DISALLOW_CLASS_COPIES(ProgramGL);
 };
 
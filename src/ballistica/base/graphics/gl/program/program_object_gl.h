@@ -5,6 +5,8 @@
 
 #if BA_ENABLE_OPENGL
 
+#include <algorithm>
+#include <memory>
 #include <string>
 
 #include "ballistica/base/graphics/gl/program/program_gl.h"
@@ -74,6 +76,75 @@ class RendererGL::ProgramObjectGL : public RendererGL::ProgramGL {
           glGetUniformLocation(program(), "colorize2Color");
       assert(colorize2_color_location_ != -1);
     }
+    if (flags & SHD_INSTANCED) {
+      instance_matrices_location_ =
+          glGetUniformLocation(program(), "instanceMatrices");
+      assert(instance_matrices_location_ != -1);
+    }
+  }
+
+  /// Whether GetInstancedProgram() can be used with this program.
+  auto SupportsInstancing() const -> bool {
+    return !(flags_ & (SHD_WORLD_SPACE_PTS | SHD_INSTANCED));
+  }
+
+  /// Return a twin of this program which draws up to
+  /// kMaxGLInstancesPerDraw instances per draw call, each with its own
+  /// transform applied on top of the current one. Created on first use.
+  auto GetInstancedProgram() -> ProgramObjectGL* {
+    assert(SupportsInstancing() && renderer()->instancing_support());
+    if (!instanced_program_) {
+      instanced_program_ =
+          std::make_unique<ProgramObjectGL>(renderer(), flags_ | SHD_INSTANCED);
+    }
+    return instanced_program_.get();
+  }
+
+  /// Match our color uniforms to those of another program with the same
+  /// flags (aside from instancing). Values are copied as-is, since tint
+  /// and ambient have already been applied to them.
+  void CopyUniformsFrom(const ProgramObjectGL& p) {
+    assert(IsBound());
+    assert((p.flags_ | SHD_INSTANCED) == (flags_ | SHD_INSTANCED));
+    if (p.r_ != r_ || p.g_ != g_ || p.b_ != b_ || p.a_ != a_) {
+      r_ = p.r_;
+      g_ = p.g_;
+      b_ = p.b_;
+      a_ = p.a_;
+      glUniform4f(color_location_, r_, g_, b_, a_);
+    }
+    if ((flags_ & SHD_ADD)
+        && (p.add_r_ != add_r_ || p.add_g_ != add_g_ || p.add_b_ != add_b_)) {
+      add_r_ = p.add_r_;
+      add_g_ = p.add_g_;
+      add_b_ = p.add_b_;
+      glUniform4f(color_add_location_, add_r_, add_g_, add_b_, 0.0f);
+    }
+    if ((flags_ & SHD_REFLECTION)
+        && (p.r_mult_r_ != r_mult_r_ || p.r_mult_g_ != r_mult_g_
+            || p.r_mult_b_ != r_mult_b_ || p.r_mult_a_ != r_mult_a_)) {
+      r_mult_r_ = p.r_mult_r_;
+      r_mult_g_ = p.r_mult_g_;
+      r_mult_b_ = p.r_mult_b_;
+      r_mult_a_ = p.r_mult_a_;
+      glUniform4f(reflect_mult_location_, r_mult_r_, r_mult_g_, r_mult_b_,
+                  r_mult_a_);
+    }
+    if (flags_ & SHD_COLORIZE) {
+      SetColorizeColor(p.colorize_r_, p.colorize_g_, p.colorize_b_,
+                       p.colorize_a_);
+    }
+    if (flags_ & SHD_COLORIZE2) {
+      SetColorize2Color(p.colorize2_r_, p.colorize2_g_, p.colorize2_b_,
+                        p.colorize2_a_);
+    }
+  }
+
+  void SetInstanceMatrices(const Matrix44f* matrices, int count) {
+    assert(flags_ & SHD_INSTANCED);
+    assert(IsBound());
+    assert(count > 0 && count <= kMaxGLInstancesPerDraw);
+    glUniformMatrix4fv(instance_matrices_location_, count, 0, matrices[0].m);
   }
 
   void SetColorTexture(const TextureAsset* t) {
@@ -177,7 +248,8 @@ class RendererGL::ProgramObjectGL : public RendererGL::ProgramGL {
            + std::to_string((flags & SHD_COLORIZE) != 0) + " colorize2:"
            + std::to_string((flags & SHD_COLORIZE2) != 0) + " transparent:"
            + std::to_string((flags & SHD_OBJ_TRANSPARENT) != 0) + " worldSpace:"
-           + std::to_string((flags & SHD_WORLD_SPACE_PTS) != 0);
+           + std::to_string((flags & SHD_WORLD_SPACE_PTS) != 0)
+           + " instanced:" + std::to_string((flags & SHD_INSTANCED) != 0);
   }
 
   auto GetPFlags(int flags) -> int {
@@ -202,6 +274,9 @@ class RendererGL::ProgramObjectGL : public RendererGL::ProgramGL {
         "vec4 vScreenCoord;\n";
     if ((flags & SHD_REFLECTION) || (flags & SHD_LIGHT_SHADOW))
       s += "uniform mat4 modelWorldMatrix;\n";
+    if (flags & SHD_INSTANCED)
+      s += "uniform mat4 instanceMatrices["
+           + std::to_string(kMaxGLInstancesPerDraw) + "];\n";
     if (flags & SHD_REFLECTION)
       s += BA_GLSL_VERTEX_IN " " BA_GLSL_MEDIUMP
                              "vec3 normal;\n" BA_GLSL_VERTEX_OUT
@@ -209,16 +284,26 @@ class RendererGL::ProgramObjectGL : public RendererGL::ProgramGL {
     if (flags & SHD_LIGHT_SHADOW)
       s += "uniform mat4 lightShadowProjectionMatrix;\n" BA_GLSL_VERTEX_OUT
            " " BA_GLSL_MEDIUMP "vec4 vLightShadowUV;\n";
+    // Instanced draws apply a per-instance transform to the mesh before
+    // anything else.
+    std::string pos = "position";
+    std::string norm = "vec4(normal,0.0)";
+    s += "void main() {\n";
+    if (flags & SHD_INSTANCED) {
+      s += "   mat4 instanceMatrix = instanceMatrices[gl_InstanceID];\n"
+           "   vec4 instancePos = instanceMatrix*position;\n";
+      pos = "instancePos";
+      norm = "(instanceMatrix*vec4(normal,0.0))";
+    }
     s +=
-        "void main() {\n"
         "   vUV = uv;\n"
-        "   gl_Position = modelViewProjectionMatrix*position;\n"
+        "   gl_Position = modelViewProjectionMatrix*" + pos + ";\n"
         "   vScreenCoord = vec4(gl_Position.xy/gl_Position.w,gl_Position.zw);\n"
         "   vScreenCoord.xy += vec2(1.0);\n"
         "   vScreenCoord.xy *= vec2(0.5*vScreenCoord.w);\n";
     if (((flags & SHD_LIGHT_SHADOW) || (flags & SHD_REFLECTION))
         && !(flags & SHD_WORLD_SPACE_PTS)) {
-      s += "   vec4 worldPos = modelWorldMatrix*position;\n";
+      s += "   vec4 worldPos = modelWorldMatrix*" + pos + ";\n";
     }
     if (flags & SHD_LIGHT_SHADOW) {
       if (flags & SHD_WORLD_SPACE_PTS)
@@ -231,7 +316,8 @@ class RendererGL::ProgramObjectGL : public RendererGL::ProgramGL {
         s += "   vReflect = reflect(vec3(position - camPos),normal);\n";
       else
         s += "   vReflect = reflect(vec3(worldPos - "
-             "camPos),normalize(vec3(modelWorldMatrix * vec4(normal,0.0))));\n";
+             "camPos),normalize(vec3(modelWorldMatrix * "
+             + norm + ")));\n";
     }
     s += "}";
     if (flags & SHD_DEBUG_PRINT)
@@ -337,7 +423,9 @@ class RendererGL::ProgramObjectGL : public RendererGL::ProgramGL {
   GLint colorize2_color_location_;
   GLint color_add_location_;
   GLint reflect_mult_location_;
+  GLint instance_matrices_location_{-1};
   int flags_;
+  std::unique_ptr<ProgramObjectGL> instanced_program_;
 };
 
 }  // namespace ballistica::base
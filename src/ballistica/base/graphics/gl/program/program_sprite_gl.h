@@ -26,7 +26,8 @@ class RendererGL::ProgramSpriteGL : public RendererGL::ProgramGL {
         r_(0),
         g_(0),
         b_(0),
-        a_(0) {
+        a_(0),
+        particle_step_(-1.0f) {
     SetTextureUnit("colorTex", kColorTexUnit);
 
     if (flags & SHD_OVERLAY) {
@@ -37,6 +38,11 @@ class RendererGL::ProgramSpriteGL : public RendererGL::ProgramGL {
       color_location_ = glGetUniformLocation(program(), "colorU");
       assert(color_location_ != -1);
     }
+    if (flags & SHD_PARTICLE) {
+      particle_step_location_ =
+          glGetUniformLocation(program(), "particleStepU");
+      assert(particle_step_location_ != -1);
+    }
     BA_DEBUG_CHECK_GL_ERROR;
   }
 
@@ -61,8 +67,22 @@ class RendererGL::ProgramSpriteGL : public RendererGL::ProgramGL {
     }
   }
 
+  /// Set the step particles are drawn at (relative to the same base as
+  /// their birth steps).
+  void SetParticleStep(float step) {
+    assert(flags_ & SHD_PARTICLE);
+    assert(IsBound());
+    if (step != particle_step_) {
+      particle_step_ = step;
+      glUniform1f(particle_step_location_, particle_step_);
+    }
+  }
+
  private:
   auto GetName(int flags) -> std::string {
+    if (flags & SHD_PARTICLE) {
+      return std::string("ParticleProgramGL");
+    }
     return std::string("SpriteProgramGL");
   }
 
@@ -70,6 +90,7 @@ class RendererGL::ProgramSpriteGL : public RendererGL::ProgramGL {
     int pflags = PFLAG_USES_POSITION_ATTR | PFLAG_USES_SIZE_ATTR
                  | PFLAG_USES_COLOR_ATTR | PFLAG_USES_UV_ATTR;
     if (flags & SHD_CAMERA_ALIGNED) pflags |= PFLAG_USES_CAM_ORIENT_MATRIX;
+    if (flags & SHD_PARTICLE) pflags |= PFLAG_USES_PARTICLE_ATTRS;
     return pflags;
   }
 
@@ -92,20 +113,54 @@ class RendererGL::ProgramSpriteGL : public RendererGL::ProgramGL {
       s += BA_GLSL_VERTEX_OUT " " BA_GLSL_LOWP "vec4 vScreenCoord;\n";
     }
 
+    if (flags & SHD_PARTICLE) {
+      s += "uniform " BA_GLSL_HIGHP "float particleStepU;\n" BA_GLSL_VERTEX_IN
+           " vec4 velocity;\n" BA_GLSL_VERTEX_IN " vec4 particleParams;\n";
+    }
+
     s += BA_GLSL_VERTEX_IN " " BA_GLSL_LOWP "vec4 color;\n" BA_GLSL_VERTEX_OUT
                            " " BA_GLSL_LOWP
                            "vec4 vColor;\n"
                            "void main() {\n";
 
+    // Particles work out their current state from their birth state.
+    // This mirrors the CPU update in BGDynamicsServer::ParticleSet:
+    // constant velocity apart from a tiny bit of per-step gravity, life
+    // and size changing linearly, and flicker picked at random every so
+    // often.
+    if (flags & SHD_PARTICLE) {
+      s += "   " BA_GLSL_HIGHP
+           "float age = max(particleStepU-particleParams.x, 0.0);\n"
+           "   " BA_GLSL_HIGHP
+           "float life = 1.0+particleParams.y*age;\n"
+           "   " BA_GLSL_HIGHP
+           "float pSize = max(0.0, size+particleParams.z*age);\n"
+           "   if (life <= 0.0) pSize = 0.0;\n"
+           "   if (particleParams.w != 0.0) {\n"
+           "     " BA_GLSL_HIGHP
+           "float r = fract(sin(velocity.w*91.3458+floor(age*0.2)*47.453)"
+           "*43758.5453);\n"
+           "     pSize *= max(0.0, 1.0+(r-0.5)*particleParams.w);\n"
+           "   }\n"
+           "   " BA_GLSL_HIGHP
+           "vec4 pPos = vec4(position.xyz+velocity.xyz*age"
+           "-vec3(0.0, 0.000005*age*(age-1.0), 0.0), 1.0);\n"
+           "   " BA_GLSL_LOWP
+           "float fade = 1.0-life;\n"
+           "   fade = 1.0-fade*fade*fade;\n";
+    } else {
+      s += "   " BA_GLSL_HIGHP "vec4 pPos = position;\n"
+           "   " BA_GLSL_HIGHP "float pSize = size;\n";
+    }
     if (flags & SHD_CAMERA_ALIGNED) {
       s += "   " BA_GLSL_HIGHP
            "vec4 pLocal = "
-           "(position+camOrientMatrix*vec4((uv.s-0.5)*size,0,(uv.t-0.5)*size,0)"
+           "(pPos+camOrientMatrix*vec4((uv.s-0.5)*pSize,0,(uv.t-0.5)*pSize,0)"
            ");\n";
     } else {
       s += "   " BA_GLSL_HIGHP
            "vec4 pLocal = "
-           "(position+vec4((uv.s-0.5)*size,0,(uv.t-0.5)*size,0));\n";
+           "(pPos+vec4((uv.s-0.5)*pSize,0,(uv.t-0.5)*pSize,0));\n";
     }
     s += "   gl_Position = modelViewProjectionMatrix*pLocal;\n"
          "   vUV = uv;\n";
@@ -114,6 +169,9 @@ class RendererGL::ProgramSpriteGL : public RendererGL::ProgramGL {
     } else {
       s += "   vColor = color;\n";
     }
+    if (flags & SHD_PARTICLE) {
+      s += "   vColor *= fade;\n";
+    }
     if (flags & SHD_OVERLAY)
       s += "   vScreenCoord = "
            "vec4(gl_Position.xy/gl_Position.w,gl_Position.zw);\n"
@@ -172,7 +230,9 @@ class RendererGL::ProgramSpriteGL : public RendererGL::ProgramGL {
   }
 
   float r_, g_, b_, a_;
+  float particle_step_;
   GLint color_location_;
+  GLint particle_step_location_{-1};
   int flags_;
 };
 
@@ -4,6 +4,7 @@
 #include "ballistica/base/graphics/gl/renderer_gl.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstdio>
 #include <iterator>
 #include <list>
@@ -13,6 +14,7 @@
 #include <vector>
 
 #include "ballistica/base/graphics/component/special_component.h"
+#include "ballistica/base/graphics/gl/gpu_timer_gl.h"
 #include "ballistica/base/graphics/gl/mesh/mesh_asset_data_gl.h"
 #include "ballistica/base/graphics/gl/mesh/mesh_data_dual_texture_full_gl.h"
 #include "ballistica/base/graphics/gl/mesh/mesh_data_gl.h"
@@ -20,6 +22,7 @@
 #include "ballistica/base/graphics/gl/mesh/mesh_data_simple_full_gl.h"
 #include "ballistica/base/graphics/gl/mesh/mesh_data_simple_split_gl.h"
 #include "ballistica/base/graphics/gl/mesh/mesh_data_smoke_full_gl.h"
+#include "ballistica/base/graphics/gl/mesh/mesh_data_particle_gl.h"
 #include "ballistica/base/graphics/gl/mesh/mesh_data_sprite_gl.h"
 #include "ballistica/base/graphics/gl/program/program_blur_gl.h"
 #include "ballistica/base/graphics/gl/program/program_gl.h"
@@ -31,6 +34,7 @@
 #include "ballistica/base/graphics/gl/program/program_sprite_gl.h"
 #include "ballistica/base/graphics/gl/render_target_gl.h"
 #include "ballistica/base/graphics/gl/texture_data_gl.h"
+#include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/math/rect.h"
 
 // Turn this off to see how much blend overdraw is occurring.
@@ -333,6 +337,53 @@ void RendererGL::CheckGLCapabilities_() {
     invalidate_framebuffer_support_ = false;
   }
 
+  // Instanced draws are core in GL 3.1+, but our ES shaders are still
+  // GLSL ES 1.00 which has no gl_InstanceID, so only use them on desktop.
+  instancing_support_ = !gl_is_es();
+
+  // Timestamp queries let us measure per-pass GPU time for the render
+  // profiler. These are core in GL 3.3 and only an extension on ES, which
+  // we don't bother with.
+  timer_query_support_ =
+      !gl_is_es()
+      && (gl_version_major() > 3
+          || (gl_version_major() == 3 && gl_version_minor() >= 3)
+          || CheckGLExtension(extensions, "timer_query"));
+#if BA_OSTYPE_WINDOWS
+  if (!glGenQueries || !glDeleteQueries || !glQueryCounter
+      || !glGetQueryObjectiv || !glGetQueryObjectui64v) {
+    timer_query_support_ = false;
+  }
+#endif
+
+  // Linked program binaries can be cached to disk so later launches can
+  // skip compiling shaders. This is standard in ES 3 and GL 4.1, but
+  // drivers are free to support zero binary formats.
+  program_binary_formats_.clear();
+  if (gl_is_es() || gl_version_major() > 4
+      || (gl_version_major() == 4 && gl_version_minor() >= 1)
+      || CheckGLExtension(extensions, "get_program_binary")) {
+    auto format_count = GLGetIntOptional(GL_NUM_PROGRAM_BINARY_FORMATS);
+    if (format_count && *format_count > 0) {
+      program_binary_formats_.resize(static_cast<size_t>(*format_count));
+      glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, program_binary_formats_.data());
+      BA_DEBUG_CHECK_GL_ERROR;
+    }
+  }
+#if BA_OSTYPE_WINDOWS
+  // These are loaded dynamically there and may be missing.
+  if (!glGetProgramBinary || !glProgramBinary || !glProgramParameteri) {
+    program_binary_formats_.clear();
+  }
+#endif
+  if (program_binary_support()) {
+    program_binary_driver_id_ =
+        std::string(vendor) + "\n" + renderer + "\n" + version_str;
+    program_binary_dir_ = g_core->platform->GetVolatileDataDirectory()
+                          + BA_DIRSLASH + "shadercache";
+    g_core->platform->MakeDir(program_binary_dir_, true);
+  }
+
   combined_texture_image_unit_count_ =
       GLGetInt(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
 
@@ -646,7 +697,7 @@ void RendererGL::CheckFunkyDepthIssue_() {
   SetBlend(false);
   SetDoubleSided_(false);
   test_rt1->DrawBegin(true, 1.0f, 1.0f, 1.0f, 1.0f);
-  ProgramSimpleGL* p = simple_color_prog_;
+  ProgramSimpleGL* p = simple_color_prog_.Get();
   p->Bind();
   p->SetColor(1, 0, 1);
   g_base->graphics_server->ModelViewReset();
@@ -663,7 +714,7 @@ void RendererGL::CheckFunkyDepthIssue_() {
   SetBlend(false);
   SetDoubleSided_(false);
   test_rt2->DrawBegin(false, 1.0f, 1.0f, 1.0f, 1.0f);
-  p = simple_tex_dtest_prog_;
+  p = simple_tex_dtest_prog_.Get();
   p->Bind();
   g_base->graphics_server->ModelViewReset();
   g_base->graphics_server->SetOrthoProjection(-1, 1, -1, 1, -1, 1);
@@ -689,8 +740,32 @@ void RendererGL::CheckFunkyDepthIssue_() {
 
 void RendererGL::PushGroupMarker(const char* label) {
   BA_GL_PUSH_GROUP_MARKER(label);
+  if (gpu_timer_ && gpu_timer_->active()) {
+    gpu_timer_->Push(label);
+  }
+}
+
+void RendererGL::PopGroupMarker() {
+  BA_GL_POP_GROUP_MARKER();
+  if (gpu_timer_ && gpu_timer_->active()) {
+    gpu_timer_->Pop();
+  }
+}
+
+void RendererGL::BeginProfileFrame() {
+  assert(g_base->app_adapter->InGraphicsContext());
+  if (!gpu_timer_) {
+    gpu_timer_ = std::make_unique<GPUTimerGL>(timer_query_support_);
+  }
+  gpu_timer_->BeginFrame();
+}
+
+void RendererGL::EndProfileFrame(std::vector<RenderProfileSection>* sections) {
+  assert(g_base->app_adapter->InGraphicsContext());
+  if (gpu_timer_) {
+    gpu_timer_->EndFrame(sections);
+  }
 }
-void RendererGL::PopGroupMarker() { BA_GL_POP_GROUP_MARKER(); }
 
 void RendererGL::InvalidateFramebuffer(bool color, bool depth,
                                        bool target_read_framebuffer) {
@@ -933,6 +1008,18 @@ void RendererGL::UpdateMeshes(
         m->SetData(data);
         break;
       }
+      case MeshDataType::kParticle: {
+        GET_MESH_DATA(MeshDataParticleGL, m);
+        GET_INDEX_BUFFER();
+        GET_BUFFER(MeshBuffer<VertexParticle>, data);
+        if (use_indices32) {
+          m->SetIndexData(indices32);
+        } else {
+          m->SetIndexData(indices16);
+        }
+        m->SetData(data);
+        break;
+      }
       default:
         throw Exception("Invalid meshdata type: "
                         + std::to_string(static_cast<int>(mesh_data->type())));
@@ -1008,7 +1095,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
           case ShadingType::kSimpleColor: {
             SetDoubleSided_(false);
             SetBlend(false);
-            ProgramSimpleGL* p = simple_color_prog_;
+            ProgramSimpleGL* p = simple_color_prog_.Get();
             p->Bind();
             float r, g, b;
             buffer->GetFloats(&r, &g, &b);
@@ -1020,7 +1107,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             bool premult = static_cast<bool>(buffer->GetInt());
             SetBlend(true);
             SetBlendPremult(premult);
-            ProgramSimpleGL* p = simple_color_prog_;
+            ProgramSimpleGL* p = simple_color_prog_.Get();
             p->Bind();
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
@@ -1032,7 +1119,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             bool premult = static_cast<bool>(buffer->GetInt());
             SetBlend(true);
             SetBlendPremult(premult);
-            ProgramSimpleGL* p = simple_color_prog_;
+            ProgramSimpleGL* p = simple_color_prog_.Get();
             p->Bind();
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
@@ -1042,7 +1129,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
           case ShadingType::kSimpleTexture: {
             SetDoubleSided_(false);
             SetBlend(false);
-            ProgramSimpleGL* p = simple_tex_prog_;
+            ProgramSimpleGL* p = simple_tex_prog_.Get();
             p->Bind();
             p->SetColorTexture(buffer->GetTexture());
             break;
@@ -1054,7 +1141,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlendPremult(premult);
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
-            ProgramSimpleGL* p = simple_tex_mod_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1067,7 +1154,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlendPremult(premult);
             float r, g, b, a, flatness;
             buffer->GetFloats(&r, &g, &b, &a, &flatness);
-            ProgramSimpleGL* p = simple_tex_mod_flatness_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_flatness_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1083,7 +1170,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
                 shadow_opacity;
             buffer->GetFloats(&r, &g, &b, &a, &shadow_offset_x,
                               &shadow_offset_y, &shadow_blur, &shadow_opacity);
-            ProgramSimpleGL* p = simple_tex_mod_shadow_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_shadow_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             const TextureAsset* t = buffer->GetTexture();
@@ -1106,7 +1193,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             buffer->GetFloats(&r, &g, &b, &a, &shadow_offset_x,
                               &shadow_offset_y, &shadow_blur, &shadow_opacity,
                               &flatness);
-            ProgramSimpleGL* p = simple_tex_mod_shadow_flatness_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_shadow_flatness_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             const TextureAsset* t = buffer->GetTexture();
@@ -1127,7 +1214,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlendPremult(premult);
             float r, g, b, a, glow_amount, glow_blur;
             buffer->GetFloats(&r, &g, &b, &a, &glow_amount, &glow_blur);
-            ProgramSimpleGL* p = simple_tex_mod_glow_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_glow_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             const TextureAsset* t = buffer->GetTexture();
@@ -1144,7 +1231,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlendPremult(premult);
             float r, g, b, a, glow_amount, glow_blur;
             buffer->GetFloats(&r, &g, &b, &a, &glow_amount, &glow_blur);
-            ProgramSimpleGL* p = simple_tex_mod_glow_maskuv2_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_glow_maskuv2_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             const TextureAsset* t = buffer->GetTexture();
@@ -1162,7 +1249,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlendPremult(premult);
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
-            ProgramSimpleGL* p = simple_tex_mod_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1173,7 +1260,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlend(false);
             float r, g, b;
             buffer->GetFloats(&r, &g, &b);
-            ProgramSimpleGL* p = simple_tex_mod_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1185,7 +1272,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             float r, g, b, colorize_r, colorize_g, colorize_b;
             buffer->GetFloats(&r, &g, &b, &colorize_r, &colorize_g,
                               &colorize_b);
-            ProgramSimpleGL* p = simple_tex_mod_colorized_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_colorized_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1200,7 +1287,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
                 colorize2_g, colorize2_b;
             buffer->GetFloats(&r, &g, &b, &colorize_r, &colorize_g, &colorize_b,
                               &colorize2_r, &colorize2_g, &colorize2_b);
-            ProgramSimpleGL* p = simple_tex_mod_colorized2_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_colorized2_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1217,7 +1304,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             buffer->GetFloats(&r, &g, &b, &a, &colorize_r, &colorize_g,
                               &colorize_b, &colorize2_r, &colorize2_g,
                               &colorize2_b);
-            ProgramSimpleGL* p = simple_tex_mod_colorized2_masked_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_colorized2_masked_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1235,7 +1322,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             float r, g, b, a, colorize_r, colorize_g, colorize_b;
             buffer->GetFloats(&r, &g, &b, &a, &colorize_r, &colorize_g,
                               &colorize_b);
-            ProgramSimpleGL* p = simple_tex_mod_colorized_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_colorized_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1253,7 +1340,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             buffer->GetFloats(&r, &g, &b, &a, &colorize_r, &colorize_g,
                               &colorize_b, &colorize2_r, &colorize2_g,
                               &colorize2_b);
-            ProgramSimpleGL* p = simple_tex_mod_colorized2_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_colorized2_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1273,7 +1360,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             buffer->GetFloats(&r, &g, &b, &a, &colorize_r, &colorize_g,
                               &colorize_b, &colorize2_r, &colorize2_g,
                               &colorize2_b);
-            ProgramSimpleGL* p = simple_tex_mod_colorized2_masked_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_colorized2_masked_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1288,7 +1375,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlend(false);
             float r, g, b;
             buffer->GetFloats(&r, &g, &b);
-            ProgramObjectGL* p = obj_prog_;
+            ProgramObjectGL* p = obj_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1301,7 +1388,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlendPremult(true);
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
-            ProgramSmokeGL* p = smoke_prog_;
+            ProgramSmokeGL* p = smoke_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1313,7 +1400,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlendPremult(true);
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
-            ProgramSmokeGL* p = smoke_overlay_prog_;
+            ProgramSmokeGL* p = smoke_overlay_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1327,19 +1414,18 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
           }
           case ShadingType::kPostProcessNormalDistort: {
             float distort = buffer->GetFloat();
-            ProgramPostProcessGL* p = postprocess_distort_prog_;
+            ProgramPostProcessGL* p = postprocess_distort_prog_.Get();
             StandardPostProcessSetup_(p, pass);
             p->SetDistort(distort);
             break;
           }
           case ShadingType::kPostProcess: {
-            ProgramPostProcessGL* p = postprocess_prog_;
+            ProgramPostProcessGL* p = postprocess_prog_.Get();
             StandardPostProcessSetup_(p, pass);
             break;
           }
           case ShadingType::kPostProcessEyes: {
-            assert(postprocess_eyes_prog_);
-            ProgramPostProcessGL* p = postprocess_eyes_prog_;
+            ProgramPostProcessGL* p = postprocess_eyes_prog_.Get();
             StandardPostProcessSetup_(p, pass);
             break;
           }
@@ -1356,14 +1442,38 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             ProgramSpriteGL* p;
             if (cam_aligned) {
               if (overlay) {
-                p = sprite_camalign_overlay_prog_;
+                p = sprite_camalign_overlay_prog_.Get();
               } else {
-                p = sprite_camalign_prog_;
+                p = sprite_camalign_prog_.Get();
               }
             } else {
               assert(!overlay);  // Unsupported combo.
-              p = sprite_prog_;
+              p = sprite_prog_.Get();
+            }
+            p->Bind();
+            if (overlay) {
+              p->SetDepthTexture(
+                  static_cast<RenderTargetGL*>(camera_render_target())
+                      ->framebuffer()
+                      ->depth_texture());
             }
+            p->SetColor(r, g, b, a);
+            p->SetColorTexture(buffer->GetTexture());
+            break;
+          }
+          case ShadingType::kParticle: {
+            SetDoubleSided_(false);
+            SetBlend(true);
+            SetBlendPremult(true);
+
+            float r, g, b, a;
+            buffer->GetFloats(&r, &g, &b, &a);
+            bool overlay = static_cast<bool>(buffer->GetInt());
+            float step = buffer->GetFloat();
+
+            // Particles are always camera-aligned.
+            ProgramSpriteGL* p = overlay ? particle_camalign_overlay_prog_.Get()
+                                         : particle_camalign_prog_.Get();
             p->Bind();
             if (overlay) {
               p->SetDepthTexture(
@@ -1372,6 +1482,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
                       ->depth_texture());
             }
             p->SetColor(r, g, b, a);
+            p->SetParticleStep(step);
             p->SetColorTexture(buffer->GetTexture());
             break;
           }
@@ -1384,7 +1495,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
 
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
-            ProgramObjectGL* p = obj_transparent_prog_;
+            ProgramObjectGL* p = obj_transparent_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1398,8 +1509,9 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             int world_space = buffer->GetInt();
             float r, g, b;
             buffer->GetFloats(&r, &g, &b);
-            ProgramObjectGL* p = world_space ? obj_lightshad_worldspace_prog_
-                                             : obj_lightshad_prog_;
+            ProgramObjectGL* p = world_space
+                                     ? obj_lightshad_worldspace_prog_.Get()
+                                     : obj_lightshad_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1433,7 +1545,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             auto light_shadow = static_cast<LightShadowType>(buffer->GetInt());
             float r, g, b, a;
             buffer->GetFloats(&r, &g, &b, &a);
-            ProgramObjectGL* p = obj_lightshad_transparent_prog_;
+            ProgramObjectGL* p = obj_lightshad_transparent_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1468,8 +1580,8 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             float r, g, b, reflect_r, reflect_g, reflect_b;
             buffer->GetFloats(&r, &g, &b, &reflect_r, &reflect_g, &reflect_b);
             ProgramObjectGL* p = world_space
-                                     ? obj_refl_lightshad_worldspace_prog_
-                                     : obj_refl_lightshad_prog_;
+                                     ? obj_refl_lightshad_worldspace_prog_.Get()
+                                     : obj_refl_lightshad_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1512,15 +1624,15 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
 
             // Testing why reflection is wonky.
             if (explicit_bool(false)) {
-              p = world_space ? obj_lightshad_worldspace_prog_
-                              : obj_lightshad_prog_;
+              p = world_space ? obj_lightshad_worldspace_prog_.Get()
+                              : obj_lightshad_prog_.Get();
               p->Bind();
               p->SetColor(r, g, b);
               p->SetColorTexture(buffer->GetTexture());
               buffer->GetTexture();
             } else {
-              p = world_space ? obj_refl_lightshad_worldspace_prog_
-                              : obj_refl_lightshad_prog_;
+              p = world_space ? obj_refl_lightshad_worldspace_prog_.Get()
+                              : obj_refl_lightshad_prog_.Get();
               p->Bind();
               p->SetColor(r, g, b);
               p->SetColorTexture(buffer->GetTexture());
@@ -1557,7 +1669,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
                 colorize_g, colorize_b;
             buffer->GetFloats(&r, &g, &b, &reflect_r, &reflect_g, &reflect_b,
                               &colorize_r, &colorize_g, &colorize_b);
-            ProgramObjectGL* p = obj_refl_lightshad_colorize_prog_;
+            ProgramObjectGL* p = obj_refl_lightshad_colorize_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1597,7 +1709,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             buffer->GetFloats(&r, &g, &b, &reflect_r, &reflect_g, &reflect_b,
                               &colorize_r, &colorize_g, &colorize_b,
                               &colorize2_r, &colorize2_g, &colorize2_b);
-            ProgramObjectGL* p = obj_refl_lightshad_colorize2_prog_;
+            ProgramObjectGL* p = obj_refl_lightshad_colorize2_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1638,7 +1750,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             float r, g, b, add_r, add_g, add_b, reflect_r, reflect_g, reflect_b;
             buffer->GetFloats(&r, &g, &b, &add_r, &add_g, &add_b, &reflect_r,
                               &reflect_g, &reflect_b);
-            ProgramObjectGL* p = obj_refl_lightshad_add_prog_;
+            ProgramObjectGL* p = obj_refl_lightshad_add_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1678,7 +1790,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             buffer->GetFloats(&r, &g, &b, &add_r, &add_g, &add_b, &reflect_r,
                               &reflect_g, &reflect_b, &colorize_r, &colorize_g,
                               &colorize_b);
-            ProgramObjectGL* p = obj_refl_lightshad_add_colorize_prog_;
+            ProgramObjectGL* p = obj_refl_lightshad_add_colorize_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1724,7 +1836,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
                               &reflect_g, &reflect_b, &colorize_r, &colorize_g,
                               &colorize_b, &colorize2_r, &colorize2_g,
                               &colorize2_b);
-            ProgramObjectGL* p = obj_refl_lightshad_add_colorize2_prog_;
+            ProgramObjectGL* p = obj_refl_lightshad_add_colorize2_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1766,8 +1878,8 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             // verified
             float r, g, b, reflect_r, reflect_g, reflect_b;
             buffer->GetFloats(&r, &g, &b, &reflect_r, &reflect_g, &reflect_b);
-            ProgramObjectGL* p =
-                world_space ? obj_refl_worldspace_prog_ : obj_refl_prog_;
+            ProgramObjectGL* p = world_space ? obj_refl_worldspace_prog_.Get()
+                                             : obj_refl_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b);
             p->SetColorTexture(buffer->GetTexture());
@@ -1784,7 +1896,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             float r, g, b, a, reflect_r, reflect_g, reflect_b;
             buffer->GetFloats(&r, &g, &b, &a, &reflect_r, &reflect_g,
                               &reflect_b);
-            ProgramObjectGL* p = obj_refl_transparent_prog_;
+            ProgramObjectGL* p = obj_refl_transparent_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1802,7 +1914,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
                 reflect_b;
             buffer->GetFloats(&r, &g, &b, &a, &add_r, &add_g, &add_b,
                               &reflect_r, &reflect_g, &reflect_b);
-            ProgramObjectGL* p = obj_refl_add_transparent_prog_;
+            ProgramObjectGL* p = obj_refl_add_transparent_prog_.Get();
             p->Bind();
             p->SetColor(r, g, b, a);
             p->SetColorTexture(buffer->GetTexture());
@@ -1815,7 +1927,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetDoubleSided_(true);
             SetBlend(true);
             SetBlendPremult(true);
-            ProgramShieldGL* p = shield_prog_;
+            ProgramShieldGL* p = shield_prog_.Get();
             p->Bind();
             p->SetDepthTexture(
                 static_cast<RenderTargetGL*>(camera_render_target())
@@ -1831,7 +1943,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             SetBlend(true);
             SetBlendPremult(true);
             auto source = (SpecialComponent::Source)buffer->GetInt();
-            ProgramSimpleGL* p = simple_tex_mod_prog_;
+            ProgramSimpleGL* p = simple_tex_mod_prog_.Get();
             p->Bind();
             switch (source) {
               case SpecialComponent::Source::kLightBuffer:
@@ -1895,6 +2007,10 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
         int flags = buffer->GetInt();
         const MeshAsset* m = buffer->GetMesh();
         assert(m);
+        m = m->GetLODForTransform(
+            g_base->graphics_server->model_view_matrix(),
+            g_base->graphics_server->projection_matrix(),
+            g_base->graphics_server->quality());
         auto mesh =
             static_cast_check_type<MeshAssetDataGL*>(m->renderer_data());
         assert(mesh);
@@ -1923,6 +2039,24 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
           break;
         }
         mesh->Bind();
+
+        // If we can, draw in big batches with an instanced twin of the
+        // current object shader instead of one draw call per matrix.
+        auto* p = dynamic_cast<ProgramObjectGL*>(GetActiveProgram_());
+        if (instancing_support_ && p && count > 1
+            && p->SupportsInstancing()) {
+          ProgramObjectGL* ip = p->GetInstancedProgram();
+          ip->Bind();
+          ip->CopyUniformsFrom(*p);
+          ip->PrepareToDraw();
+          for (int i = 0; i < count; i += kMaxGLInstancesPerDraw) {
+            int batch = std::min(count - i, kMaxGLInstancesPerDraw);
+            ip->SetInstanceMatrices(mats + i, batch);
+            mesh->DrawInstanced(batch);
+          }
+          p->Bind();
+          break;
+        }
         for (int i = 0; i < count; i++) {
           g_base->graphics_server->PushTransform();
           g_base->graphics_server->MultMatrix(mats[i]);
@@ -2151,7 +2285,7 @@ void RendererGL::BlitBuffer(RenderTarget* src_in, RenderTarget* dst_in,
     // Copied from ShadingType::kSimpleColor.
     SetDoubleSided_(false);
     SetBlend(false);
-    ProgramSimpleGL* p = simple_tex_prog_;
+    ProgramSimpleGL* p = simple_tex_prog_.Get();
     p->Bind();
     p->SetColorTexture(src->framebuffer()->texture());
     GetActiveProgram_()->PrepareToDraw();
@@ -2513,6 +2647,119 @@ auto RendererGL::GetAutoGraphicsQuality() -> GraphicsQuality {
 
 void RendererGL::RetainShader_(ProgramGL* p) { shaders_.emplace_back(p); }
 
+void RendererGL::RunIdleProgramLoad_() {
+  // One variant per frame keeps any compiling this involves from turning
+  // into a noticeable hitch. Variants that got used first are no-ops here.
+  if (!idle_program_loads_.empty()) {
+    auto load = std::move(idle_program_loads_.back());
+    idle_program_loads_.pop_back();
+    load();
+  }
+}
+
+auto RendererGL::GetProgramBinaryKey_(const std::string& vertex_src,
+                                      const std::string& fragment_src,
+                                      int pflags) const -> uint64_t {
+  // FNV-1a over everything that affects the linked result. Including the
+  // driver identity means driver updates simply miss the cache.
+  uint64_t hash{0xcbf29ce484222325ULL};
+  auto add = [&hash](const void* data, size_t size) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+  };
+  add(program_binary_driver_id_.data(), program_binary_driver_id_.size());
+  add(vertex_src.data(), vertex_src.size());
+  add(fragment_src.data(), fragment_src.size());
+  add(&pflags, sizeof(pflags));
+  return hash;
+}
+
+auto RendererGL::GetProgramBinaryPath_(uint64_t key) const -> std::string {
+  char name[32];
+  snprintf(name, sizeof(name), "%016" PRIx64 ".bin", key);
+  return program_binary_dir_ + BA_DIRSLASH + name;
+}
+
+// Cache files are a small header followed by the raw binary.
+static const uint32_t kProgramBinaryMagic{0x42504231};  // 'BPB1'
+static const uint32_t kProgramBinaryMaxSize{16 * 1024 * 1024};
+
+auto RendererGL::LoadProgramBinary_(GLuint program, uint64_t key) -> bool {
+  assert(program_binary_support());
+  std::string path = GetProgramBinaryPath_(key);
+  FILE* f = g_core->platform->FOpen(path.c_str(), "rb");
+  if (!f) {
+    return false;
+  }
+  uint32_t header[3]{};  // magic, format, size
+  std::vector<char> data;
+  bool got_data{};
+  if (fread(header, sizeof(header), 1, f) == 1
+      && header[0] == kProgramBinaryMagic && header[2] > 0
+      && header[2] <= kProgramBinaryMaxSize
+      && std::find(program_binary_formats_.begin(),
+                   program_binary_formats_.end(),
+                   static_cast<GLint>(header[1]))
+             != program_binary_formats_.end()) {
+    data.resize(header[2]);
+    got_data = (fread(data.data(), data.size(), 1, f) == 1);
+  }
+  fclose(f);
+  if (got_data) {
+    glProgramBinary(program, static_cast<GLenum>(header[1]), data.data(),
+                    static_cast<GLsizei>(data.size()));
+    GLint link_status{GL_FALSE};
+    glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+
+    // Drivers are allowed to reject binaries for any reason (and may flag
+    // an error while doing so); that just means we compile from source.
+    while (glGetError() != GL_NO_ERROR) {
+    }
+    if (link_status == GL_TRUE) {
+      return true;
+    }
+  }
+
+  // Whatever is there is no good; kill it so we write a fresh one.
+  g_core->platform->Unlink(path.c_str());
+  return false;
+}
+
+void RendererGL::SaveProgramBinary_(GLuint program, uint64_t key) {
+  assert(program_binary_support());
+  GLint length{};
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0 || static_cast<uint32_t>(length) > kProgramBinaryMaxSize) {
+    return;
+  }
+  std::vector<char> data(static_cast<size_t>(length));
+  GLsizei written{};
+  GLenum format{};
+  glGetProgramBinary(program, length, &written, &format, data.data());
+  BA_DEBUG_CHECK_GL_ERROR;
+  if (written <= 0) {
+    return;
+  }
+  std::string path = GetProgramBinaryPath_(key);
+  FILE* f = g_core->platform->FOpen(path.c_str(), "wb");
+  if (!f) {
+    return;
+  }
+  uint32_t header[3]{kProgramBinaryMagic, static_cast<uint32_t>(format),
+                     static_cast<uint32_t>(written)};
+  bool success = (fwrite(header, sizeof(header), 1, f) == 1
+                  && fwrite(data.data(), static_cast<size_t>(written), 1, f)
+                         == 1);
+  fclose(f);
+
+  // Attempt to clean up if it looks like something went wrong.
+  if (!success) {
+    g_core->platform->Unlink(path.c_str());
+  }
+}
+
 void RendererGL::Load() {
   assert(g_base->app_adapter->InGraphicsContext());
   assert(!data_loaded_);
@@ -2546,124 +2793,101 @@ void RendererGL::Load() {
   screen_mesh_->SetIndexData(&i_buffer);
   assert(shaders_.empty());
   BA_DEBUG_CHECK_GL_ERROR;
-  ProgramGL* p;
-  p = simple_color_prog_ = new ProgramSimpleGL(this, SHD_MODULATE);
-  RetainShader_(p);
-  p = simple_tex_prog_ = new ProgramSimpleGL(this, SHD_TEXTURE);
-  RetainShader_(p);
-  p = simple_tex_dtest_prog_ =
-      new ProgramSimpleGL(this, SHD_TEXTURE | SHD_DEPTH_BUG_TEST);
-  RetainShader_(p);
+  // Build what the ui and our depth check need right away, along with the
+  // post-process programs our quality level uses every frame. Other
+  // variants get built the first time they're drawn with or during spare
+  // frames after we load, whichever comes first. Post-process variants our
+  // quality level never uses don't get built at all.
+  const ProgramLoad_ now{ProgramLoad_::kNow};
+  const ProgramLoad_ idle{ProgramLoad_::kIdle};
+  const ProgramLoad_ pp_load{
+      g_base->graphics_server->quality() >= GraphicsQuality::kHigh
+          ? ProgramLoad_::kNow
+          : ProgramLoad_::kOnUse};
+  simple_color_prog_.Init(this, SHD_MODULATE, now);
+  simple_tex_prog_.Init(this, SHD_TEXTURE, now);
+  simple_tex_dtest_prog_.Init(this, SHD_TEXTURE | SHD_DEPTH_BUG_TEST, now);
 
   // Have to run this after we've created the shader to be able to test it.
   CheckFunkyDepthIssue_();
-  p = simple_tex_mod_prog_ =
-      new ProgramSimpleGL(this, SHD_TEXTURE | SHD_MODULATE);
-  RetainShader_(p);
-  p = simple_tex_mod_flatness_prog_ =
-      new ProgramSimpleGL(this, SHD_TEXTURE | SHD_MODULATE | SHD_FLATNESS);
-  RetainShader_(p);
-  p = simple_tex_mod_shadow_prog_ = new ProgramSimpleGL(
-      this, SHD_TEXTURE | SHD_MODULATE | SHD_SHADOW | SHD_MASK_UV2);
-  RetainShader_(p);
-  p = simple_tex_mod_shadow_flatness_prog_ =
-      new ProgramSimpleGL(this, SHD_TEXTURE | SHD_MODULATE | SHD_SHADOW
-                                    | SHD_MASK_UV2 | SHD_FLATNESS);
-  RetainShader_(p);
-  p = simple_tex_mod_glow_prog_ =
-      new ProgramSimpleGL(this, SHD_TEXTURE | SHD_MODULATE | SHD_GLOW);
-  RetainShader_(p);
-  p = simple_tex_mod_glow_maskuv2_prog_ = new ProgramSimpleGL(
-      this, SHD_TEXTURE | SHD_MODULATE | SHD_GLOW | SHD_MASK_UV2);
-  RetainShader_(p);
-  p = simple_tex_mod_colorized_prog_ =
-      new ProgramSimpleGL(this, SHD_TEXTURE | SHD_MODULATE | SHD_COLORIZE);
-  RetainShader_(p);
-  p = simple_tex_mod_colorized2_prog_ = new ProgramSimpleGL(
-      this, SHD_TEXTURE | SHD_MODULATE | SHD_COLORIZE | SHD_COLORIZE2);
-  RetainShader_(p);
-  p = simple_tex_mod_colorized2_masked_prog_ =
-      new ProgramSimpleGL(this, SHD_TEXTURE | SHD_MODULATE | SHD_COLORIZE
-                                    | SHD_COLORIZE2 | SHD_MASKED);
-  RetainShader_(p);
-  p = obj_prog_ = new ProgramObjectGL(this, 0);
-  RetainShader_(p);
-  p = obj_transparent_prog_ = new ProgramObjectGL(this, SHD_OBJ_TRANSPARENT);
-  RetainShader_(p);
-  p = obj_lightshad_transparent_prog_ =
-      new ProgramObjectGL(this, SHD_OBJ_TRANSPARENT | SHD_LIGHT_SHADOW);
-  RetainShader_(p);
-  p = obj_refl_prog_ = new ProgramObjectGL(this, SHD_REFLECTION);
-  RetainShader_(p);
-  p = obj_refl_worldspace_prog_ =
-      new ProgramObjectGL(this, SHD_REFLECTION | SHD_WORLD_SPACE_PTS);
-  RetainShader_(p);
-  p = obj_refl_transparent_prog_ =
-      new ProgramObjectGL(this, SHD_REFLECTION | SHD_OBJ_TRANSPARENT);
-  RetainShader_(p);
-  p = obj_refl_add_transparent_prog_ =
-      new ProgramObjectGL(this, SHD_REFLECTION | SHD_ADD | SHD_OBJ_TRANSPARENT);
-  RetainShader_(p);
-  p = obj_lightshad_prog_ = new ProgramObjectGL(this, SHD_LIGHT_SHADOW);
-  RetainShader_(p);
-  p = obj_lightshad_worldspace_prog_ =
-      new ProgramObjectGL(this, SHD_LIGHT_SHADOW | SHD_WORLD_SPACE_PTS);
-  RetainShader_(p);
-  p = obj_refl_lightshad_prog_ =
-      new ProgramObjectGL(this, SHD_LIGHT_SHADOW | SHD_REFLECTION);
-  RetainShader_(p);
-  p = obj_refl_lightshad_worldspace_prog_ = new ProgramObjectGL(
-      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_WORLD_SPACE_PTS);
-  RetainShader_(p);
-  p = obj_refl_lightshad_colorize_prog_ = new ProgramObjectGL(
-      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_COLORIZE);
-  RetainShader_(p);
-  p = obj_refl_lightshad_colorize2_prog_ = new ProgramObjectGL(
-      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_COLORIZE | SHD_COLORIZE2);
-  RetainShader_(p);
-  p = obj_refl_lightshad_add_prog_ =
-      new ProgramObjectGL(this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_ADD);
-  RetainShader_(p);
-  p = obj_refl_lightshad_add_colorize_prog_ = new ProgramObjectGL(
-      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_ADD | SHD_COLORIZE);
-  RetainShader_(p);
-  p = obj_refl_lightshad_add_colorize2_prog_ =
-      new ProgramObjectGL(this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_ADD
-                                    | SHD_COLORIZE | SHD_COLORIZE2);
-  RetainShader_(p);
-  p = smoke_prog_ =
-      new ProgramSmokeGL(this, SHD_OBJ_TRANSPARENT | SHD_WORLD_SPACE_PTS);
-  RetainShader_(p);
-  p = smoke_overlay_prog_ = new ProgramSmokeGL(
-      this, SHD_OBJ_TRANSPARENT | SHD_WORLD_SPACE_PTS | SHD_OVERLAY);
-  RetainShader_(p);
-  p = sprite_prog_ = new ProgramSpriteGL(this, SHD_COLOR);
-  RetainShader_(p);
-  p = sprite_camalign_prog_ =
-      new ProgramSpriteGL(this, SHD_CAMERA_ALIGNED | SHD_COLOR);
-  RetainShader_(p);
-  p = sprite_camalign_overlay_prog_ =
-      new ProgramSpriteGL(this, SHD_CAMERA_ALIGNED | SHD_OVERLAY | SHD_COLOR);
-  RetainShader_(p);
-  p = blur_prog_ = new ProgramBlurGL(this, 0);
-  RetainShader_(p);
-  p = shield_prog_ = new ProgramShieldGL(this, 0);
-  RetainShader_(p);
+  simple_tex_mod_prog_.Init(this, SHD_TEXTURE | SHD_MODULATE, now);
+  simple_tex_mod_flatness_prog_.Init(
+      this, SHD_TEXTURE | SHD_MODULATE | SHD_FLATNESS, now);
+  simple_tex_mod_shadow_prog_.Init(
+      this, SHD_TEXTURE | SHD_MODULATE | SHD_SHADOW | SHD_MASK_UV2, now);
+  simple_tex_mod_shadow_flatness_prog_.Init(
+      this,
+      SHD_TEXTURE | SHD_MODULATE | SHD_SHADOW | SHD_MASK_UV2 | SHD_FLATNESS,
+      now);
+  simple_tex_mod_glow_prog_.Init(this, SHD_TEXTURE | SHD_MODULATE | SHD_GLOW,
+                                 now);
+  simple_tex_mod_glow_maskuv2_prog_.Init(
+      this, SHD_TEXTURE | SHD_MODULATE | SHD_GLOW | SHD_MASK_UV2, now);
+  simple_tex_mod_colorized_prog_.Init(
+      this, SHD_TEXTURE | SHD_MODULATE | SHD_COLORIZE, now);
+  simple_tex_mod_colorized2_prog_.Init(
+      this, SHD_TEXTURE | SHD_MODULATE | SHD_COLORIZE | SHD_COLORIZE2, now);
+  simple_tex_mod_colorized2_masked_prog_.Init(
+      this,
+      SHD_TEXTURE | SHD_MODULATE | SHD_COLORIZE | SHD_COLORIZE2 | SHD_MASKED,
+      now);
+  obj_prog_.Init(this, 0, idle);
+  obj_transparent_prog_.Init(this, SHD_OBJ_TRANSPARENT, idle);
+  obj_lightshad_transparent_prog_.Init(
+      this, SHD_OBJ_TRANSPARENT | SHD_LIGHT_SHADOW, idle);
+  obj_refl_prog_.Init(this, SHD_REFLECTION, idle);
+  obj_refl_worldspace_prog_.Init(this, SHD_REFLECTION | SHD_WORLD_SPACE_PTS,
+                                 idle);
+  obj_refl_transparent_prog_.Init(this, SHD_REFLECTION | SHD_OBJ_TRANSPARENT,
+                                  idle);
+  obj_refl_add_transparent_prog_.Init(
+      this, SHD_REFLECTION | SHD_ADD | SHD_OBJ_TRANSPARENT, idle);
+  obj_lightshad_prog_.Init(this, SHD_LIGHT_SHADOW, idle);
+  obj_lightshad_worldspace_prog_.Init(
+      this, SHD_LIGHT_SHADOW | SHD_WORLD_SPACE_PTS, idle);
+  obj_refl_lightshad_prog_.Init(this, SHD_LIGHT_SHADOW | SHD_REFLECTION,
+                                idle);
+  obj_refl_lightshad_worldspace_prog_.Init(
+      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_WORLD_SPACE_PTS, idle);
+  obj_refl_lightshad_colorize_prog_.Init(
+      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_COLORIZE, idle);
+  obj_refl_lightshad_colorize2_prog_.Init(
+      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_COLORIZE | SHD_COLORIZE2,
+      idle);
+  obj_refl_lightshad_add_prog_.Init(
+      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_ADD, idle);
+  obj_refl_lightshad_add_colorize_prog_.Init(
+      this, SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_ADD | SHD_COLORIZE, idle);
+  obj_refl_lightshad_add_colorize2_prog_.Init(
+      this,
+      SHD_LIGHT_SHADOW | SHD_REFLECTION | SHD_ADD | SHD_COLORIZE
+          | SHD_COLORIZE2,
+      idle);
+  smoke_prog_.Init(this, SHD_OBJ_TRANSPARENT | SHD_WORLD_SPACE_PTS, idle);
+  smoke_overlay_prog_.Init(
+      this, SHD_OBJ_TRANSPARENT | SHD_WORLD_SPACE_PTS | SHD_OVERLAY, idle);
+  sprite_prog_.Init(this, SHD_COLOR, idle);
+  sprite_camalign_prog_.Init(this, SHD_CAMERA_ALIGNED | SHD_COLOR, idle);
+  sprite_camalign_overlay_prog_.Init(
+      this, SHD_CAMERA_ALIGNED | SHD_OVERLAY | SHD_COLOR, idle);
+  particle_camalign_prog_.Init(
+      this, SHD_CAMERA_ALIGNED | SHD_COLOR | SHD_PARTICLE, idle);
+  particle_camalign_overlay_prog_.Init(
+      this, SHD_CAMERA_ALIGNED | SHD_OVERLAY | SHD_COLOR | SHD_PARTICLE, idle);
+  blur_prog_.Init(this, 0, pp_load);
+  shield_prog_.Init(this, 0, idle);
 
   // Conditional seems to be a *very* slight win on some architectures (A7),
   // a loss on some (A5) and a wash on some (Adreno 320). Gonna wait before
   // a clean win before turning it on.
-  p = postprocess_prog_ = new ProgramPostProcessGL(this, high_qual_pp_flag);
-  RetainShader_(p);
-  if (g_base->graphics_server->quality() >= GraphicsQuality::kHigher) {
-    p = postprocess_eyes_prog_ = new ProgramPostProcessGL(this, SHD_EYES);
-    RetainShader_(p);
-  } else {
-    postprocess_eyes_prog_ = nullptr;
-  }
-  p = postprocess_distort_prog_ =
-      new ProgramPostProcessGL(this, SHD_DISTORT | high_qual_pp_flag);
-  RetainShader_(p);
+  postprocess_prog_.Init(this, high_qual_pp_flag, pp_load);
+  postprocess_eyes_prog_.Init(
+      this, SHD_EYES,
+      g_base->graphics_server->quality() >= GraphicsQuality::kHigher
+          ? ProgramLoad_::kNow
+          : ProgramLoad_::kOnUse);
+  postprocess_distort_prog_.Init(this, SHD_DISTORT | high_qual_pp_flag,
+                                 pp_load);
 
   // Generate our random value texture.
   // TODO(ericf): move this to assets.
@@ -2723,6 +2947,10 @@ void RendererGL::Load() {
   for (int i = 0; i < 2; i++) {
     recycle_mesh_datas_sprite_.push_back(new MeshDataSpriteGL(this));
   }
+  assert(recycle_mesh_datas_particle_.empty());
+  for (int i = 0; i < 2; i++) {
+    recycle_mesh_datas_particle_.push_back(new MeshDataParticleGL(this));
+  }
 
   // Re-sync with the GL state since we might be dealing with a new
   // context/etc.
@@ -2772,51 +3000,59 @@ void RendererGL::Unload() {
     delete i;
   }
   recycle_mesh_datas_sprite_.clear();
+  for (auto&& i : recycle_mesh_datas_particle_) {
+    delete i;
+  }
+  recycle_mesh_datas_particle_.clear();
   screen_mesh_.reset();
+  gpu_timer_.reset();
   if (!g_base->graphics_server->renderer_context_lost()) {
     glDeleteTextures(1, &random_tex_);
     glDeleteTextures(1, &vignette_tex_);
   }
   blur_buffers_.clear();
+  idle_program_loads_.clear();
   shaders_.clear();
-  simple_color_prog_ = nullptr;
-  simple_tex_prog_ = nullptr;
-  simple_tex_dtest_prog_ = nullptr;
-  simple_tex_mod_prog_ = nullptr;
-  simple_tex_mod_flatness_prog_ = nullptr;
-  simple_tex_mod_shadow_prog_ = nullptr;
-  simple_tex_mod_shadow_flatness_prog_ = nullptr;
-  simple_tex_mod_glow_prog_ = nullptr;
-  simple_tex_mod_glow_maskuv2_prog_ = nullptr;
-  simple_tex_mod_colorized_prog_ = nullptr;
-  simple_tex_mod_colorized2_prog_ = nullptr;
-  simple_tex_mod_colorized2_masked_prog_ = nullptr;
-  obj_prog_ = nullptr;
-  obj_transparent_prog_ = nullptr;
-  obj_refl_prog_ = nullptr;
-  obj_refl_worldspace_prog_ = nullptr;
-  obj_refl_transparent_prog_ = nullptr;
-  obj_refl_add_transparent_prog_ = nullptr;
-  obj_lightshad_prog_ = nullptr;
-  obj_lightshad_worldspace_prog_ = nullptr;
-  obj_refl_lightshad_prog_ = nullptr;
-  obj_refl_lightshad_worldspace_prog_ = nullptr;
-  obj_refl_lightshad_colorize_prog_ = nullptr;
-  obj_refl_lightshad_colorize2_prog_ = nullptr;
-  obj_refl_lightshad_add_prog_ = nullptr;
-  obj_refl_lightshad_add_colorize_prog_ = nullptr;
-  obj_refl_lightshad_add_colorize2_prog_ = nullptr;
-  smoke_prog_ = nullptr;
-  smoke_overlay_prog_ = nullptr;
-  sprite_prog_ = nullptr;
-  sprite_camalign_prog_ = nullptr;
-  sprite_camalign_overlay_prog_ = nullptr;
-  obj_lightshad_transparent_prog_ = nullptr;
-  blur_prog_ = nullptr;
-  shield_prog_ = nullptr;
-  postprocess_prog_ = nullptr;
-  postprocess_eyes_prog_ = nullptr;
-  postprocess_distort_prog_ = nullptr;
+  simple_color_prog_.Reset();
+  simple_tex_prog_.Reset();
+  simple_tex_dtest_prog_.Reset();
+  simple_tex_mod_prog_.Reset();
+  simple_tex_mod_flatness_prog_.Reset();
+  simple_tex_mod_shadow_prog_.Reset();
+  simple_tex_mod_shadow_flatness_prog_.Reset();
+  simple_tex_mod_glow_prog_.Reset();
+  simple_tex_mod_glow_maskuv2_prog_.Reset();
+  simple_tex_mod_colorized_prog_.Reset();
+  simple_tex_mod_colorized2_prog_.Reset();
+  simple_tex_mod_colorized2_masked_prog_.Reset();
+  obj_prog_.Reset();
+  obj_transparent_prog_.Reset();
+  obj_refl_prog_.Reset();
+  obj_refl_worldspace_prog_.Reset();
+  obj_refl_transparent_prog_.Reset();
+  obj_refl_add_transparent_prog_.Reset();
+  obj_lightshad_prog_.Reset();
+  obj_lightshad_worldspace_prog_.Reset();
+  obj_refl_lightshad_prog_.Reset();
+  obj_refl_lightshad_worldspace_prog_.Reset();
+  obj_refl_lightshad_colorize_prog_.Reset();
+  obj_refl_lightshad_colorize2_prog_.Reset();
+  obj_refl_lightshad_add_prog_.Reset();
+  obj_refl_lightshad_add_colorize_prog_.Reset();
+  obj_refl_lightshad_add_colorize2_prog_.Reset();
+  smoke_prog_.Reset();
+  smoke_overlay_prog_.Reset();
+  sprite_prog_.Reset();
+  sprite_camalign_prog_.Reset();
+  sprite_camalign_overlay_prog_.Reset();
+  particle_camalign_prog_.Reset();
+  particle_camalign_overlay_prog_.Reset();
+  obj_lightshad_transparent_prog_.Reset();
+  blur_prog_.Reset();
+  shield_prog_.Reset();
+  postprocess_prog_.Reset();
+  postprocess_eyes_prog_.Reset();
+  postprocess_distort_prog_.Reset();
   data_loaded_ = false;
   BA_DEBUG_CHECK_GL_ERROR;
 }
@@ -2931,6 +3167,20 @@ auto RendererGL::NewMeshData(MeshDataType mesh_type, MeshDrawType draw_type)
       return data;
       break;
     }
+    case MeshDataType::kParticle: {
+      MeshDataParticleGL* data;
+      // Use a recycled one if we've got one; otherwise create a new one.
+      auto i = recycle_mesh_datas_particle_.rbegin();
+      if (i != recycle_mesh_datas_particle_.rend()) {
+        data = *i;
+        recycle_mesh_datas_particle_.pop_back();
+      } else {
+        data = new MeshDataParticleGL(this);
+      }
+      data->set_dynamic_draw(draw_type == MeshDrawType::kDynamic);
+      return data;
+      break;
+    }
     default:
       throw Exception();
       break;
@@ -2990,6 +3240,14 @@ void RendererGL::DeleteMeshData(MeshRendererData* source_in,
       recycle_mesh_datas_sprite_.push_back(source);
       break;
     }
+    case MeshDataType::kParticle: {
+      auto source = static_cast<MeshDataParticleGL*>(source_in);
+      assert(source
+             && source == dynamic_cast<MeshDataParticleGL*>(source_in));
+      source->Reset();
+      recycle_mesh_datas_particle_.push_back(source);
+      break;
+    }
     default:
       throw Exception();
       break;
@@ -3014,7 +3272,7 @@ void RendererGL::DrawDebug() {
       SetDepthTesting(false);
       SetDoubleSided_(false);
       SetBlend(false);
-      ProgramSimpleGL* p = simple_tex_prog_;
+      ProgramSimpleGL* p = simple_tex_prog_.Get();
       p->Bind();
 
       g_base->graphics_server->ModelViewReset();
@@ -3071,11 +3329,15 @@ void RendererGL::GenerateCameraBufferBlurPasses() {
 
   if (cam_buffer->physical_width() != last_cam_buffer_width_
       || cam_buffer->physical_height() != last_cam_buffer_height_
-      || blur_res_count() != last_blur_res_count_ || blur_buffers_.empty()) {
+      || blur_res_count() != last_blur_res_count_
+      || g_base->graphics_server->fast_post_process()
+             != last_fast_post_process_
+      || blur_buffers_.empty()) {
     blur_buffers_.clear();
     last_cam_buffer_width_ = cam_buffer->physical_width();
     last_cam_buffer_height_ = cam_buffer->physical_height();
     last_blur_res_count_ = blur_res_count();
+    last_fast_post_process_ = g_base->graphics_server->fast_post_process();
     int w = static_cast<int>(last_cam_buffer_width_);
     int h = static_cast<int>(last_cam_buffer_height_);
 
@@ -3088,6 +3350,12 @@ void RendererGL::GenerateCameraBufferBlurPasses() {
       assert(h % 2 == 0);
       w /= 2;
       h /= 2;
+
+      // In fast mode we skip the half-res level (by far the priciest to
+      // fill) and go straight to quarter.
+      if (i == 0 && last_fast_post_process_) {
+        continue;
+      }
       blur_buffers_.push_back(Object::New<FramebufferObjectGL>(
           this, w, h,
           true,               // linear_interp
@@ -3101,7 +3369,8 @@ void RendererGL::GenerateCameraBufferBlurPasses() {
     }
 
     // Final redundant one (we run an extra blur without down-rezing).
-    if (g_base->graphics_server->quality() >= GraphicsQuality::kHigher)
+    if (g_base->graphics_server->quality() >= GraphicsQuality::kHigher
+        && !last_fast_post_process_)
       blur_buffers_.push_back(Object::New<FramebufferObjectGL>(
           this, w, h,
           true,   // linear_interp
@@ -3122,7 +3391,7 @@ void RendererGL::GenerateCameraBufferBlurPasses() {
   SetDoubleSided_(false);
   SetBlend(false);
 
-  ProgramBlurGL* p = blur_prog_;
+  ProgramBlurGL* p = blur_prog_.Get();
   p->Bind();
 
   FramebufferObjectGL* src_fb =
@@ -3137,6 +3406,12 @@ void RendererGL::GenerateCameraBufferBlurPasses() {
     if (fb->width() == src_fb->width()) {  // Our last one is equal res.
       p->SetPixelSize(2.0f / static_cast<float>(fb->width()),
                       2.0f / static_cast<float>(fb->height()));
+    } else if (fb->width() * 4 == src_fb->width()) {
+      // A fast-mode quarter-res downsample. Keep the same footprint as a
+      // regular first level (in source texels); our taps spaced a full
+      // dst texel apart would skip over most of the source and shimmer.
+      p->SetPixelSize(0.5f / static_cast<float>(fb->width()),
+                      0.5f / static_cast<float>(fb->height()));
     } else {
       p->SetPixelSize(1.0f / static_cast<float>(fb->width()),
                       1.0f / static_cast<float>(fb->height()));
@@ -3173,6 +3448,8 @@ void RendererGL::VRSyncRenderStates() {
 #endif  // BA_VR_BUILD
 
 void RendererGL::RenderFrameDefEnd() {
+  RunIdleProgramLoad_();
+
   // Need to set some states to keep cardboard happy.
 #if BA_CARDBOARD_BUILD
   if (g_core->vr_mode()) {
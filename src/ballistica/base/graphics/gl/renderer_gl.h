@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_GRAPHICS_GL_RENDERER_GL_H_
 #define BALLISTICA_BASE_GRAPHICS_GL_RENDERER_GL_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,6 +30,10 @@ namespace ballistica::base {
 // perhaps can reconsider that since the 3gs was 15 years ago.
 constexpr int kMaxGLTexUnitsUsed = 5;
 
+// Max instances drawn per instanced draw call. Each one costs a mat4 of
+// vertex uniform space, and GL 3.2 only guarantees 1024 components.
+constexpr int kMaxGLInstancesPerDraw = 32;
+
 class RendererGL : public Renderer {
   class TextureDataGL;
   class MeshAssetDataGL;
@@ -39,6 +44,7 @@ class RendererGL : public Renderer {
   class MeshDataDualTextureFullGL;
   class MeshDataSmokeFullGL;
   class MeshDataSpriteGL;
+  class MeshDataParticleGL;
   class RenderTargetGL;
   class FramebufferObjectGL;
   class ShaderGL;
@@ -52,6 +58,7 @@ class RendererGL : public Renderer {
   class ProgramShieldGL;
   class ProgramPostProcessGL;
   class ProgramSpriteGL;
+  class GPUTimerGL;
 
  public:
   void CheckGLVersion();
@@ -80,7 +87,8 @@ class RendererGL : public Renderer {
     PFLAG_USES_DIFFUSE_ATTR = 1 << 10,
     PFLAG_USES_CAM_ORIENT_MATRIX = 1 << 11,
     PFLAG_USES_MODEL_VIEW_MATRIX = 1 << 12,
-    PFLAG_USES_UV2_ATTR = 1 << 13
+    PFLAG_USES_UV2_ATTR = 1 << 13,
+    PFLAG_USES_PARTICLE_ATTRS = 1 << 14
   };
 
   // Flags affecting shader creation.
@@ -109,7 +117,9 @@ class RendererGL : public Renderer {
     SHD_MASK_UV2 = 1 << 21,
     SHD_CONDITIONAL = 1 << 22,
     SHD_FLATNESS = 1 << 23,
-    SHD_DEPTH_BUG_TEST = 1 << 24
+    SHD_DEPTH_BUG_TEST = 1 << 24,
+    SHD_INSTANCED = 1 << 25,
+    SHD_PARTICLE = 1 << 26
   };
 
   enum VertexAttr {
@@ -121,6 +131,8 @@ class RendererGL : public Renderer {
     kVertexAttrSize,
     kVertexAttrDiffuse,
     kVertexAttrUV2,
+    kVertexAttrVelocity,
+    kVertexAttrParticleParams,
     kVertexAttrCount
   };
 
@@ -167,6 +179,8 @@ class RendererGL : public Renderer {
       const std::vector<Object::Ref<MeshBufferBase> >& buffers) override;
   void PushGroupMarker(const char* label) override;
   void PopGroupMarker() override;
+  void BeginProfileFrame() override;
+  void EndProfileFrame(std::vector<RenderProfileSection>* sections) override;
   auto IsMSAAEnabled() const -> bool override;
   void InvalidateFramebuffer(bool color, bool depth,
                              bool target_read_framebuffer) override;
@@ -189,6 +203,8 @@ class RendererGL : public Renderer {
   auto invalidate_framebuffer_support() const {
     return invalidate_framebuffer_support_;
   }
+  auto instancing_support() const { return instancing_support_; }
+  auto timer_query_support() const { return timer_query_support_; }
 
   auto msaa_max_samples_rgb565() const {
     assert(msaa_max_samples_rgb565_ != -1);
@@ -218,6 +234,44 @@ class RendererGL : public Renderer {
   auto GLGetIntOptional(GLenum name) -> std::optional<int>;
 
  private:
+  /// When a program variant gets built.
+  enum class ProgramLoad_ {
+    kNow,    // As we load; for things needed on the very first frames.
+    kIdle,   // On first use, or in spare time after load if sooner.
+    kOnUse,  // On first use only; for things our settings rarely need.
+  };
+
+  /// A program variant that gets compiled on demand instead of all at
+  /// once as we load. Variants nobody draws with never get built at all.
+  template <typename T>
+  class LazyProgramGL {
+   public:
+    void Init(RendererGL* renderer, int flags, ProgramLoad_ load) {
+      assert(!program_);
+      renderer_ = renderer;
+      flags_ = flags;
+      if (load == ProgramLoad_::kNow) {
+        Get();
+      } else if (load == ProgramLoad_::kIdle) {
+        renderer->idle_program_loads_.emplace_back([this] { Get(); });
+      }
+    }
+    auto Get() -> T* {
+      if (!program_) {
+        assert(renderer_);
+        program_ = new T(renderer_, flags_);
+        renderer_->RetainShader_(program_);
+      }
+      return program_;
+    }
+    void Reset() { program_ = nullptr; }
+
+   private:
+    RendererGL* renderer_{};
+    T* program_{};
+    int flags_{};
+  };
+
   static auto GetFunkyDepthIssue_() -> bool;
   void CheckFunkyDepthIssue_();
   auto GetMSAASamplesForFramebuffer_(int width, int height) -> int;
@@ -228,6 +282,16 @@ class RendererGL : public Renderer {
                                  const RenderPass& pass);
   void SyncGLState_();
   void RetainShader_(ProgramGL* p);
+  void RunIdleProgramLoad_();
+  auto program_binary_support() const -> bool {
+    return !program_binary_formats_.empty();
+  }
+  auto GetProgramBinaryKey_(const std::string& vertex_src,
+                            const std::string& fragment_src, int pflags) const
+      -> uint64_t;
+  auto GetProgramBinaryPath_(uint64_t key) const -> std::string;
+  auto LoadProgramBinary_(GLuint program, uint64_t key) -> bool;
+  void SaveProgramBinary_(GLuint program, uint64_t key);
   void SetViewport_(GLint x, GLint y, GLsizei width, GLsizei height);
   void UseProgram_(ProgramGL* p);
   auto GetActiveProgram_() const -> ProgramGL* {
@@ -266,8 +330,14 @@ class RendererGL : public Renderer {
   bool got_screen_framebuffer_{};
   bool double_sided_{};
   bool invalidate_framebuffer_support_{};
+  bool instancing_support_{};
+  bool timer_query_support_{};
+  std::vector<GLint> program_binary_formats_;
+  std::string program_binary_driver_id_;
+  std::string program_binary_dir_;
   bool checked_gl_version_{};
   int last_blur_res_count_{};
+  bool last_fast_post_process_{};
   float last_cam_buffer_width_{};
   float last_cam_buffer_height_{};
   float vignette_tex_outer_r_{};
@@ -290,44 +360,47 @@ class RendererGL : public Renderer {
   millisecs_t dof_update_time_{};
   std::vector<Object::Ref<FramebufferObjectGL> > blur_buffers_;
   std::vector<std::unique_ptr<ProgramGL> > shaders_;
-  ProgramSimpleGL* simple_color_prog_{};
-  ProgramSimpleGL* simple_tex_prog_{};
-  ProgramSimpleGL* simple_tex_dtest_prog_{};
-  ProgramSimpleGL* simple_tex_mod_prog_{};
-  ProgramSimpleGL* simple_tex_mod_flatness_prog_{};
-  ProgramSimpleGL* simple_tex_mod_shadow_prog_{};
-  ProgramSimpleGL* simple_tex_mod_shadow_flatness_prog_{};
-  ProgramSimpleGL* simple_tex_mod_glow_prog_{};
-  ProgramSimpleGL* simple_tex_mod_glow_maskuv2_prog_{};
-  ProgramSimpleGL* simple_tex_mod_colorized_prog_{};
-  ProgramSimpleGL* simple_tex_mod_colorized2_prog_{};
-  ProgramSimpleGL* simple_tex_mod_colorized2_masked_prog_{};
-  ProgramObjectGL* obj_prog_{};
-  ProgramObjectGL* obj_transparent_prog_{};
-  ProgramObjectGL* obj_lightshad_transparent_prog_{};
-  ProgramObjectGL* obj_refl_prog_{};
-  ProgramObjectGL* obj_refl_worldspace_prog_{};
-  ProgramObjectGL* obj_refl_transparent_prog_{};
-  ProgramObjectGL* obj_refl_add_transparent_prog_{};
-  ProgramObjectGL* obj_lightshad_prog_{};
-  ProgramObjectGL* obj_lightshad_worldspace_prog_{};
-  ProgramObjectGL* obj_refl_lightshad_prog_{};
-  ProgramObjectGL* obj_refl_lightshad_worldspace_prog_{};
-  ProgramObjectGL* obj_refl_lightshad_colorize_prog_{};
-  ProgramObjectGL* obj_refl_lightshad_colorize2_prog_{};
-  ProgramObjectGL* obj_refl_lightshad_add_prog_{};
-  ProgramObjectGL* obj_refl_lightshad_add_colorize_prog_{};
-  ProgramObjectGL* obj_refl_lightshad_add_colorize2_prog_{};
-  ProgramSmokeGL* smoke_prog_{};
-  ProgramSmokeGL* smoke_overlay_prog_{};
-  ProgramSpriteGL* sprite_prog_{};
-  ProgramSpriteGL* sprite_camalign_prog_{};
-  ProgramSpriteGL* sprite_camalign_overlay_prog_{};
-  ProgramBlurGL* blur_prog_{};
-  ProgramShieldGL* shield_prog_{};
-  ProgramPostProcessGL* postprocess_prog_{};
-  ProgramPostProcessGL* postprocess_eyes_prog_{};
-  ProgramPostProcessGL* postprocess_distort_prog_{};
+  std::vector<std::function<void()> > idle_program_loads_;
+  LazyProgramGL<ProgramSimpleGL> simple_color_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_dtest_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_flatness_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_shadow_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_shadow_flatness_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_glow_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_glow_maskuv2_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_colorized_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_colorized2_prog_;
+  LazyProgramGL<ProgramSimpleGL> simple_tex_mod_colorized2_masked_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_transparent_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_lightshad_transparent_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_worldspace_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_transparent_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_add_transparent_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_lightshad_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_lightshad_worldspace_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_lightshad_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_lightshad_worldspace_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_lightshad_colorize_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_lightshad_colorize2_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_lightshad_add_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_lightshad_add_colorize_prog_;
+  LazyProgramGL<ProgramObjectGL> obj_refl_lightshad_add_colorize2_prog_;
+  LazyProgramGL<ProgramSmokeGL> smoke_prog_;
+  LazyProgramGL<ProgramSmokeGL> smoke_overlay_prog_;
+  LazyProgramGL<ProgramSpriteGL> sprite_prog_;
+  LazyProgramGL<ProgramSpriteGL> sprite_camalign_prog_;
+  LazyProgramGL<ProgramSpriteGL> sprite_camalign_overlay_prog_;
+  LazyProgramGL<ProgramSpriteGL> particle_camalign_prog_;
+  LazyProgramGL<ProgramSpriteGL> particle_camalign_overlay_prog_;
+  LazyProgramGL<ProgramBlurGL> blur_prog_;
+  LazyProgramGL<ProgramShieldGL> shield_prog_;
+  LazyProgramGL<ProgramPostProcessGL> postprocess_prog_;
+  LazyProgramGL<ProgramPostProcessGL> postprocess_eyes_prog_;
+  LazyProgramGL<ProgramPostProcessGL> postprocess_distort_prog_;
   static bool funky_depth_issue_set_;
   static bool funky_depth_issue_;
 #if BA_OSTYPE_ANDROID
@@ -342,12 +415,14 @@ class RendererGL : public Renderer {
   int bound_textures_2d_[kMaxGLTexUnitsUsed]{};
   int bound_textures_cube_map_[kMaxGLTexUnitsUsed]{};
   std::unique_ptr<MeshDataSimpleFullGL> screen_mesh_;
+  std::unique_ptr<GPUTimerGL> gpu_timer_;
   std::vector<MeshDataSimpleSplitGL*> recycle_mesh_datas_simple_split_;
   std::vector<MeshDataObjectSplitGL*> recycle_mesh_datas_object_split_;
   std::vector<MeshDataSimpleFullGL*> recycle_mesh_datas_simple_full_;
   std::vector<MeshDataDualTextureFullGL*> recycle_mesh_datas_dual_texture_full_;
   std::vector<MeshDataSmokeFullGL*> recycle_mesh_datas_smoke_full_;
   std::vector<MeshDataSpriteGL*> recycle_mesh_datas_sprite_;
+  std::vector<MeshDataParticleGL*> recycle_mesh_datas_particle_;
   int error_check_counter_{};
   GLint combined_texture_image_unit_count_{};
   GLint anisotropic_support_{};
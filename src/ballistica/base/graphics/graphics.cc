@@ -3,13 +3,17 @@
 #include "ballistica/base/graphics/graphics.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstdio>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/app_mode/app_mode.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics.h"
+#include "ballistica/base/dynamics/bg/bg_dynamics_server.h"
 #include "ballistica/base/graphics/component/object_component.h"
 #include "ballistica/base/graphics/component/post_process_component.h"
 #include "ballistica/base/graphics/component/simple_component.h"
@@ -29,6 +33,7 @@
 #include "ballistica/base/python/support/python_context_call.h"
 #include "ballistica/base/support/app_config.h"
 #include "ballistica/base/ui/ui.h"
+#include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/ballistica.h"
 #include "ballistica/shared/foundation/event_loop.h"
 
@@ -39,6 +44,8 @@ const float kProgressBarZDepth{0.0f};
 const int kProgressBarFadeTime{500};
 const float kDebugImgZDepth{-0.04f};
 const float kScreenMeshZDepth{-0.05f};
+const size_t kRenderProfileHistorySize{1000};
+const int kTextureStreamingUpdateFrames{15};
 
 auto Graphics::IsShaderTransparent(ShadingType c) -> bool {
   switch (c) {
@@ -63,6 +70,7 @@ auto Graphics::IsShaderTransparent(ShadingType c) -> bool {
     case ShadingType::kSmoke:
     case ShadingType::kSmokeOverlay:
     case ShadingType::kSprite:
+    case ShadingType::kParticle:
       return true;
     case ShadingType::kSimpleColor:
     case ShadingType::kSimpleTextureModulated:
@@ -117,6 +125,15 @@ void Graphics::DoApplyAppConfig() {
 
   show_fps_ = g_base->app_config->Resolve(AppConfig::BoolID::kShowFPS);
   show_ping_ = g_base->app_config->Resolve(AppConfig::BoolID::kShowPing);
+  parallel_draw_prep_ =
+      g_base->app_config->Resolve(AppConfig::BoolID::kParallelDrawPrep);
+  draw_culling_ = g_base->app_config->Resolve(AppConfig::BoolID::kDrawCulling);
+  sort_opaque_draws_ =
+      g_base->app_config->Resolve(AppConfig::BoolID::kSortOpaqueDraws);
+  show_render_profile_ =
+      g_base->app_config->Resolve(AppConfig::BoolID::kShowRenderProfile);
+  gpu_particles_ =
+      g_base->app_config->Resolve(AppConfig::BoolID::kGPUParticles);
 
   bool disable_camera_shake =
       g_base->app_config->Resolve(AppConfig::BoolID::kDisableCameraShake);
@@ -497,9 +514,24 @@ void Graphics::DrawMiscOverlays(FrameDef* frame_def) {
     }
   }
 
+  if (timing_lanes_) {
+    float width{500.0f};
+    timing_lanes_->Draw(pass, pass->virtual_width() - width - 50.0f, 50.0f,
+                        width, 40.0f);
+  }
+
   screenmessages->DrawMiscOverlays(frame_def);
 }
 
+void Graphics::SetTimingLanesVisible(bool visible) {
+  assert(g_base->InLogicThread());
+  if (visible && !timing_lanes_) {
+    timing_lanes_ = std::make_unique<TimingLanes>();
+  } else if (!visible) {
+    timing_lanes_.reset();
+  }
+}
+
 auto Graphics::GetDebugGraph(const std::string& name, bool smoothed)
     -> NetGraph* {
   auto out = debug_graphs_.find(name);
@@ -618,6 +650,31 @@ void Graphics::ClearFrameDefDeleteList() {
   std::scoped_lock lock(frame_def_delete_list_mutex_);
 
   for (auto& i : frame_def_delete_list_) {
+    if (show_render_profile_ && i->rendering()) {
+      GetDebugGraph("render 0: latency ms", true)
+          ->AddSample(g_base->logic->display_time() * 1000.0,
+                      static_cast<double>(i->latency_microsecs()) / 1000.0);
+    }
+    if (i->profile_render() && i->rendering()) {
+      if (show_render_profile_) {
+        AddRenderProfile(*i->render_profile());
+      }
+      if (timing_lanes_) {
+        auto& profile{*i->render_profile()};
+        float gpu_ms{};
+        for (auto&& section : profile.sections) {
+          if (section.depth == 0 && section.gpu_ms > 0.0f) {
+            gpu_ms += section.gpu_ms;
+          }
+        }
+        timing_lanes_->SetValue(TimingLane::kRenderCPU, profile.render_cpu_ms);
+        timing_lanes_->SetValue(TimingLane::kRenderGPU, gpu_ms);
+      }
+      if (frame_timing_capture_) {
+        frame_timing_capture_->AddRenderProfile(*i->render_profile());
+      }
+    }
+
     // We recycle our frame_defs so we don't have to reallocate all those
     // buffers.
     if (recycle_frame_defs_.size() < 5) {
@@ -629,6 +686,73 @@ void Graphics::ClearFrameDefDeleteList() {
   frame_def_delete_list_.clear();
 }
 
+void Graphics::AddRenderProfile(const RenderProfile& profile) {
+  assert(g_base->InLogicThread());
+
+  render_profile_history_.push_back(profile);
+  while (render_profile_history_.size() > kRenderProfileHistorySize) {
+    render_profile_history_.pop_front();
+  }
+
+  double now_d{g_base->logic->display_time() * 1000.0};
+  GetDebugGraph("render 1: build cpu ms", true)
+      ->AddSample(now_d, profile.build_cpu_ms);
+  GetDebugGraph("render 2: render cpu ms", true)
+      ->AddSample(now_d, profile.render_cpu_ms);
+
+  // Top level passes get their own graphs; GPU time if we've got it.
+  for (auto&& section : profile.sections) {
+    if (section.depth != 0) {
+      continue;
+    }
+    if (section.gpu_ms >= 0.0f) {
+      GetDebugGraph("render 3: " + section.label + " gpu ms", true)
+          ->AddSample(now_d, section.gpu_ms);
+    } else {
+      GetDebugGraph("render 3: " + section.label + " cpu ms", true)
+          ->AddSample(now_d, section.cpu_ms);
+    }
+  }
+}
+
+void Graphics::StartFrameTimingCapture() {
+  assert(g_base->InLogicThread());
+  frame_timing_capture_ = std::make_unique<FrameTimingCapture>();
+}
+
+auto Graphics::StopFrameTimingCapture() -> std::unique_ptr<FrameTimingCapture> {
+  assert(g_base->InLogicThread());
+  return std::move(frame_timing_capture_);
+}
+
+void Graphics::WriteRenderProfile(const std::string& path) {
+  assert(g_base->InLogicThread());
+  FILE* f = g_core->platform->FOpen(path.c_str(), "w");
+  if (!f) {
+    throw Exception("Unable to open '" + path + "' for writing.");
+  }
+  fprintf(f,
+          "frame,build_cpu_ms,render_cpu_ms,section,depth,section_cpu_ms,"
+          "section_gpu_ms\n");
+  for (auto&& profile : render_profile_history_) {
+    if (profile.sections.empty()) {
+      fprintf(f, "%" PRId64 ",%.3f,%.3f,,,,\n", profile.frame_number,
+              profile.build_cpu_ms, profile.render_cpu_ms);
+      continue;
+    }
+    for (auto&& section : profile.sections) {
+      fprintf(f, "%" PRId64 ",%.3f,%.3f,%s,%d,%.3f,", profile.frame_number,
+              profile.build_cpu_ms, profile.render_cpu_ms,
+              section.label.c_str(), section.depth, section.cpu_ms);
+      if (section.gpu_ms >= 0.0f) {
+        fprintf(f, "%.3f", section.gpu_ms);
+      }
+      fprintf(f, "\n");
+    }
+  }
+  fclose(f);
+}
+
 void Graphics::FadeScreen(bool to, millisecs_t time, PyObject* endcall) {
   assert(g_base->InLogicThread());
   // If there's an ourstanding fade-end command, go ahead and run it.
@@ -819,6 +943,17 @@ void Graphics::BuildAndPushFrameDef() {
   frame_def->set_display_time_elapsed_millisecs(elapsed_millisecs);
   frame_def->set_frame_number(frame_def_count_);
   frame_def->set_frame_number_filtered(frame_def_count_filtered_);
+  frame_def->set_profile_render(show_render_profile_
+                                || frame_timing_capture_ != nullptr
+                                || timing_lanes_ != nullptr);
+  if (frame_timing_capture_) {
+    frame_timing_capture_->AddFrame(app_time_microsecs);
+  }
+  if (timing_lanes_) {
+    timing_lanes_->SetValue(TimingLane::kBGDynamicsStep,
+                            g_base->bg_dynamics_server->last_step_ms());
+    timing_lanes_->AddSample();
+  }
 
   if (!internal_components_inited_) {
     InitInternalComponents(frame_def);
@@ -895,8 +1030,25 @@ void Graphics::BuildAndPushFrameDef() {
   frame_def->set_mesh_data_destroys(mesh_data_destroys_);
   mesh_data_destroys_.clear();
 
+  if (frame_def->profile_render()) {
+    auto* render_profile = frame_def->render_profile();
+    render_profile->frame_number = frame_def->frame_number();
+    render_profile->build_cpu_ms =
+        static_cast<float>(g_core->AppTimeMicrosecs() - app_time_microsecs)
+        / 1000.0f;
+  }
+
   g_base->graphics_server->EnqueueFrameDef(frame_def);
 
+  // Every so often, let assets shuffle texture mip levels around based on
+  // what we've been drawing.
+  if (frame_def_count_ % kTextureStreamingUpdateFrames == 0) {
+    g_base->assets->UpdateTextureStreaming(
+        frame_def_count_,
+        static_cast<size_t>(settings()->texture_residency_budget_mb) * 1024
+            * 1024);
+  }
+
   // Clean up frame_defs awaiting deletion.
   ClearFrameDefDeleteList();
 
@@ -3,15 +3,21 @@
 #ifndef BALLISTICA_BASE_GRAPHICS_GRAPHICS_H_
 #define BALLISTICA_BASE_GRAPHICS_GRAPHICS_H_
 
+#include <deque>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/graphics/support/frame_timing_capture.h"
 #include "ballistica/base/graphics/support/graphics_client_context.h"
 #include "ballistica/base/graphics/support/graphics_settings.h"
+#include "ballistica/base/graphics/support/render_profile.h"
+#include "ballistica/base/graphics/support/overlay_quad_batcher.h"
+#include "ballistica/base/graphics/support/timing_lanes.h"
 #include "ballistica/shared/foundation/object.h"
 #include "ballistica/shared/foundation/types.h"
 #include "ballistica/shared/generic/snapshot.h"
@@ -281,6 +287,35 @@ class Graphics {
   void set_show_net_info(bool val) { show_net_info_ = val; }
   auto GetDebugGraph(const std::string& name, bool smoothed) -> NetGraph*;
 
+  /// Show or hide live per-subsystem timing lanes (see TimingLanes).
+  void SetTimingLanesVisible(bool visible);
+  auto timing_lanes_visible() const { return timing_lanes_ != nullptr; }
+
+  /// Batches simple HUD quads drawn into overlay passes.
+  auto overlay_quads() -> OverlayQuadBatcher* { return &overlay_quads_; }
+
+  /// Feed the latest value for a timing lane. Does nothing unless they are
+  /// visible, though callers with costly values should check that first.
+  void SetTimingLaneValue(TimingLane lane, float value) {
+    if (timing_lanes_) {
+      timing_lanes_->SetValue(lane, value);
+    }
+  }
+
+  /// Write recently recorded render-profile timings to a CSV file.
+  /// Timings are only recorded while 'Show Render Profile' is enabled.
+  void WriteRenderProfile(const std::string& path);
+
+  /// Start collecting per-frame timings (discarding any capture already
+  /// running), or stop and hand back what was collected.
+  void StartFrameTimingCapture();
+  auto StopFrameTimingCapture() -> std::unique_ptr<FrameTimingCapture>;
+
+  /// The running capture, if any.
+  auto frame_timing_capture() const -> FrameTimingCapture* {
+    return frame_timing_capture_.get();
+  }
+
   // Used by meshes.
   void AddMeshDataCreate(MeshData* d);
   void AddMeshDataDestroy(MeshData* d);
@@ -310,6 +345,19 @@ class Graphics {
     camera_shake_disabled_ = disabled;
   }
   auto camera_shake_disabled() const { return camera_shake_disabled_; }
+
+  /// Whether scenes may spread node draw prep across worker threads.
+  auto parallel_draw_prep() const { return parallel_draw_prep_; }
+
+  /// Whether scenes may skip drawing nodes that can't be in view.
+  auto draw_culling() const { return draw_culling_; }
+
+  /// Whether render passes may reorder opaque draws to group state.
+  auto sort_opaque_draws() const { return sort_opaque_draws_; }
+
+  /// Whether bg-dynamics sparks should be animated on the GPU instead of
+  /// updated on the CPU each step.
+  auto gpu_particles() const { return gpu_particles_; }
   void set_camera_gyro_explicitly_disabled(bool disabled) {
     camera_gyro_explicitly_disabled_ = disabled;
   }
@@ -390,6 +438,7 @@ class Graphics {
   void DrawMiscOverlays(FrameDef* frame_def);
   void DrawLoadDot(RenderPass* pass);
   void ClearFrameDefDeleteList();
+  void AddRenderProfile(const RenderProfile& profile);
   void DrawProgressBar(RenderPass* pass, float opacity);
   void UpdateProgressBarProgress(float target);
   void UpdateGyro(microsecs_t time, microsecs_t elapsed);
@@ -416,6 +465,11 @@ class Graphics {
   bool gyro_enabled_{true};
   bool show_fps_{};
   bool show_ping_{};
+  bool parallel_draw_prep_{true};
+  bool draw_culling_{true};
+  bool sort_opaque_draws_{true};
+  bool gpu_particles_{true};
+  bool show_render_profile_{};
   bool show_net_info_{};
   bool tv_border_{};
   bool floor_reflection_{};
@@ -449,6 +503,10 @@ class Graphics {
   std::string ping_string_;
   std::string net_info_string_;
   std::map<std::string, Object::Ref<NetGraph>> debug_graphs_;
+  std::deque<RenderProfile> render_profile_history_;
+  std::unique_ptr<FrameTimingCapture> frame_timing_capture_;
+  std::unique_ptr<TimingLanes> timing_lanes_;
+  OverlayQuadBatcher overlay_quads_;
   std::mutex frame_def_delete_list_mutex_;
   std::list<Object::Ref<PythonContextCall>> clean_frame_commands_;
   std::vector<FrameDef*> recycle_frame_defs_;
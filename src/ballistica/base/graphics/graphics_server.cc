@@ -11,6 +11,7 @@
 #include "ballistica/base/graphics/renderer/renderer.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/thread_trace.h"
 #include "ballistica/shared/foundation/event_loop.h"
 
 namespace ballistica::base {
@@ -31,10 +32,21 @@ void GraphicsServer::EnqueueFrameDef(FrameDef* framedef) {
   // these to our thread event list, but currently we may spin-lock waiting
   // for new frames to appear which would prevent that from working; we
   // would need to change that code.
+  bool build_another{};
   {
     std::scoped_lock frame_def_lock(frame_def_mutex_);
-    assert(frame_def_ == nullptr);
-    frame_def_ = framedef;
+    frame_defs_.push_back(framedef);
+    frame_def_requested_ = false;
+
+    // Normally the next frame gets requested as we start (or finish)
+    // rendering this one, but when we're allowed to keep finished frames
+    // queued up we keep building until that queue is full.
+    build_another = frames_in_flight_ > 2
+                    && static_cast<int>(frame_defs_.size())
+                           < frames_in_flight_ - 1;
+  }
+  if (build_another) {
+    g_base->logic->event_loop()->PushCall([] { g_base->logic->Draw(); });
   }
 }
 
@@ -53,8 +65,26 @@ void GraphicsServer::ApplySettings(const GraphicsSettings* settings) {
 
   // Pull a few things out ourself such as screen resolution.
   tv_border_ = settings->tv_border;
+  {
+    std::scoped_lock frame_def_lock(frame_def_mutex_);
+    frames_in_flight_ = settings->frames_in_flight;
+  }
+  if (settings->fast_post_process != fast_post_process_) {
+    // This changes how our camera buffer is laid out, so treat it like a
+    // resize to get everything rebuilt.
+    fast_post_process_ = settings->fast_post_process;
+    if (renderer_) {
+      renderer_->OnScreenSizeChange();
+    }
+  }
+  graphics_load_budget_ =
+      static_cast<size_t>(settings->graphics_load_budget_kb) * 1024;
+  graphics_load_budget_remaining_ = graphics_load_budget_;
+  pixel_scale_ = settings->pixel_scale;
+  dynamic_resolution_.SetConfig(settings->dynamic_resolution_target_fps,
+                                settings->dynamic_resolution_min_scale);
   if (renderer_) {
-    renderer_->set_pixel_scale(settings->pixel_scale);
+    renderer_->set_pixel_scale(pixel_scale_ * dynamic_resolution_.scale());
   }
   // Note: need to look at both physical and virtual res here; its possible
   // for physical to stay the same but for virtual to change (ui-scale
@@ -117,6 +147,7 @@ void GraphicsServer::set_client_context(GraphicsClientContext* context) {
 }
 
 auto GraphicsServer::TryRender() -> bool {
+  BA_TRACE_SCOPE("GraphicsServer::TryRender");
   assert(g_base->app_adapter->InGraphicsContext());
 
   bool success{};
@@ -132,9 +163,37 @@ auto GraphicsServer::TryRender() -> bool {
     // Only actually render if we have a screen and aren't in a hold.
     auto target = renderer()->screen_render_target();
     if (target != nullptr && render_hold_ == 0) {
+      bool profile = frame_def->profile_render();
+
+      // Dynamic resolution needs frame timings too, so we run the
+      // renderer's profiling for it even when nobody asked for a profile.
+      bool dynamic_resolution = dynamic_resolution_.enabled();
+      microsecs_t start_time{};
+      if (profile || dynamic_resolution) {
+        start_time = g_core->AppTimeMicrosecs();
+        renderer_->BeginProfileFrame();
+      }
       PreprocessRenderFrameDef(frame_def);
       DrawRenderFrameDef(frame_def);
       FinishRenderFrameDef(frame_def);
+      frame_def->set_latency_microsecs(g_core->AppTimeMicrosecs()
+                                       - frame_def->app_time_microsecs());
+      if (profile || dynamic_resolution) {
+        std::vector<RenderProfileSection> local_sections;
+        auto* sections = profile ? &frame_def->render_profile()->sections
+                                 : &local_sections;
+        renderer_->EndProfileFrame(sections);
+        auto cpu_ms = static_cast<float>(g_core->AppTimeMicrosecs()
+                                         - start_time)
+                      / 1000.0f;
+        if (profile) {
+          frame_def->render_profile()->render_cpu_ms = cpu_ms;
+        }
+        if (dynamic_resolution) {
+          UpdateDynamicResolution_(*sections, cpu_ms);
+        }
+      }
+      last_rendered_frame_build_time_ = frame_def->app_time_microsecs();
       success = true;
     }
 
@@ -146,6 +205,7 @@ auto GraphicsServer::TryRender() -> bool {
 }
 
 auto GraphicsServer::WaitForRenderFrameDef_() -> FrameDef* {
+  BA_TRACE_SCOPE("GraphicsServer::WaitForRenderFrameDef");
   assert(g_base->app_adapter->InGraphicsContext());
   millisecs_t start_time = g_core->AppTimeMillisecs();
 
@@ -156,22 +216,40 @@ auto GraphicsServer::WaitForRenderFrameDef_() -> FrameDef* {
       return nullptr;
     }
 
-    // Do a bit of incremental loading every time through.
-    g_base->assets->RunPendingGraphicsLoads();
+    // Do a bit of incremental loading every time through, keeping to our
+    // per-frame budget so big loads get spread across frames.
+    g_base->assets->RunPendingGraphicsLoads(
+        graphics_load_budget_ ? &graphics_load_budget_remaining_ : nullptr);
 
     FrameDef* frame_def{};
+    int frames_in_flight{};
+    bool request_frame{};
     {
       std::scoped_lock llock(frame_def_mutex_);
-      if (frame_def_) {
-        frame_def = frame_def_;
-        frame_def_ = nullptr;
+      if (!frame_defs_.empty()) {
+        frame_def = frame_defs_.front();
+        frame_defs_.pop_front();
+      } else if (frames_in_flight_ == 1 && !frame_def_requested_) {
+        // In lowest-latency mode we don't ask for a frame until we're
+        // ready to render it, so it's built from input as fresh as
+        // possible (at the cost of waiting here while it gets built).
+        frame_def_requested_ = true;
+        request_frame = true;
       }
+      frames_in_flight = frames_in_flight_;
+    }
+    if (request_frame) {
+      g_base->logic->event_loop()->PushCall([] { g_base->logic->Draw(); });
     }
     if (frame_def) {
       // As soon as we start working on rendering a frame, ask the logic
       // thread to start working on the next one for us. Keeps things nice
-      // and pipelined.
-      g_base->logic->event_loop()->PushCall([] { g_base->logic->Draw(); });
+      // and pipelined. (In lowest-latency mode we instead wait until we're
+      // ready to render the next one; see above.)
+      if (frames_in_flight > 1) {
+        g_base->logic->event_loop()->PushCall([] { g_base->logic->Draw(); });
+      }
+      graphics_load_budget_remaining_ = graphics_load_budget_;
       return frame_def;
     }
 
@@ -185,7 +263,10 @@ auto GraphicsServer::WaitForRenderFrameDef_() -> FrameDef* {
       }
       break;  // Fail.
     }
-    core::CorePlatform::SleepMillisecs(1);
+
+    // In lowest-latency mode we expect to wait here for each frame as it
+    // gets built, so check back more often.
+    core::CorePlatform::SleepMicrosecs(frames_in_flight == 1 ? 100 : 1000);
   }
   return nullptr;
 }
@@ -236,6 +317,24 @@ void GraphicsServer::FinishRenderFrameDef(FrameDef* frame_def) {
   }
 }
 
+void GraphicsServer::UpdateDynamicResolution_(
+    const std::vector<RenderProfileSection>& sections, float cpu_ms) {
+  // Go by GPU time where the renderer can measure it (these results lag
+  // a few frames behind, which is fine for our purposes). Otherwise CPU
+  // render time is the best we've got; drivers tend to block in there
+  // when the GPU falls behind.
+  float gpu_ms{};
+  bool have_gpu_ms{};
+  for (auto&& section : sections) {
+    if (section.depth == 0 && section.gpu_ms >= 0.0f) {
+      gpu_ms += section.gpu_ms;
+      have_gpu_ms = true;
+    }
+  }
+  dynamic_resolution_.AddFrame(have_gpu_ms ? gpu_ms : cpu_ms);
+  renderer_->set_pixel_scale(pixel_scale_ * dynamic_resolution_.scale());
+}
+
 // Reload all media (for debugging/benchmarking purposes).
 void GraphicsServer::ReloadMedia_() {
   assert(g_base->app_adapter->InGraphicsContext());
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_GRAPHICS_GRAPHICS_SERVER_H_
 #define BALLISTICA_BASE_GRAPHICS_GRAPHICS_SERVER_H_
 
+#include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -10,6 +11,8 @@
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/graphics/support/dynamic_resolution.h"
+#include "ballistica/base/graphics/support/render_profile.h"
 #include "ballistica/shared/foundation/object.h"
 #include "ballistica/shared/generic/snapshot.h"
 #include "ballistica/shared/math/matrix44f.h"
@@ -80,6 +83,20 @@ class GraphicsServer {
   // Returns true if a frame was rendered.
   auto TryRender() -> bool;
 
+  /// Whether we're in lowest-latency mode, where each frame-def is only
+  /// requested once we're ready to render it (so it includes whatever
+  /// input came in right up until then).
+  auto lowest_latency() -> bool {
+    std::scoped_lock lock(frame_def_mutex_);
+    return frames_in_flight_ == 1;
+  }
+
+  /// App-time at which the frame-def most recently rendered by TryRender()
+  /// was built.
+  auto last_rendered_frame_build_time() const {
+    return last_rendered_frame_build_time_;
+  }
+
   // Init the modelview matrix to look here.
   void SetCamera(const Vector3f& eye, const Vector3f& target,
                  const Vector3f& up);
@@ -206,6 +223,12 @@ class GraphicsServer {
     return texture_quality_;
   }
 
+  /// Whether post-process blurs should start at quarter resolution.
+  auto fast_post_process() const {
+    assert(InGraphicsContext_());
+    return fast_post_process_;
+  }
+
   auto screen_pixel_width() const {
     assert(InGraphicsContext_());
     return res_x_;
@@ -299,6 +322,8 @@ class GraphicsServer {
   // void UpdateVirtualScreenRes_();
   void UpdateCamOrientMatrix_();
   void ReloadMedia_();
+  void UpdateDynamicResolution_(
+      const std::vector<RenderProfileSection>& sections, float cpu_ms);
   void UpdateModelViewProjectionMatrix_() {
     if (model_view_projection_matrix_dirty_) {
       model_view_projection_matrix_ = model_view_matrix_ * projection_matrix_;
@@ -323,6 +348,7 @@ class GraphicsServer {
   bool model_view_projection_matrix_dirty_{true};
   bool model_world_matrix_dirty_{true};
   bool tv_border_{};
+  bool fast_post_process_{};
   bool renderer_context_lost_{};
   bool texture_compression_types_set_{};
   bool cam_orient_matrix_dirty_{true};
@@ -330,6 +356,8 @@ class GraphicsServer {
   bool shutdown_completed_{};
   float res_x_{};
   float res_y_{};
+  float pixel_scale_{1.0f};
+  DynamicResolution dynamic_resolution_;
   float res_x_virtual_{};
   float res_y_virtual_{};
   Matrix44f model_view_matrix_{kMatrix44fIdentity};
@@ -346,6 +374,8 @@ class GraphicsServer {
   int cam_pos_state_{};
   int cam_orient_matrix_state_{};
   int settings_index_{-1};
+  size_t graphics_load_budget_{};
+  size_t graphics_load_budget_remaining_{};
   Vector3f cam_pos_{0.0f, 0.0f, 0.0f};
   Vector3f cam_target_{0.0f, 0.0f, 0.0f};
   Matrix44f light_shadow_projection_matrix_{kMatrix44fIdentity};
@@ -354,7 +384,11 @@ class GraphicsServer {
   std::vector<Matrix44f> model_view_stack_;
   std::list<MeshData*> mesh_datas_;
   Renderer* renderer_{};
-  FrameDef* frame_def_{};
+  // Frame-defs waiting to be rendered, oldest first.
+  std::deque<FrameDef*> frame_defs_;
+  int frames_in_flight_{2};
+  bool frame_def_requested_{};
+  microsecs_t last_rendered_frame_build_time_{};
   std::mutex frame_def_mutex_{};
 };
 
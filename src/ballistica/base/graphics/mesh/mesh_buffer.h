@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ballistica/base/graphics/mesh/mesh_buffer_base.h"
+#include "ballistica/shared/foundation/object_pool.h"
 
 namespace ballistica::base {
 
@@ -15,12 +16,35 @@ template <typename T>
 class MeshBuffer : public MeshBufferBase {
  public:
   MeshBuffer() = default;
-  explicit MeshBuffer(size_t initial_size) : elements(initial_size) {}
+  explicit MeshBuffer(size_t initial_size) : elements(initial_size) {
+    TrackElements_();
+  }
   MeshBuffer(size_t initial_size, const T* initial_data)
       : elements(initial_size) {
     memcpy(&elements[0], initial_data, initial_size * sizeof(T));
+    TrackElements_();
+  }
+  ~MeshBuffer() override {
+    if (MemoryAccounting::enabled()) {
+      MemoryAccounting::Untrack(&elements);
+    }
   }
+
+  // Lots of these get created and tossed every frame.
+  BA_OBJECT_POOLED(MeshBuffer<T>);
+
   std::vector<T> elements;
+
+ private:
+  // Element data is accounted for separately from the buffer objects
+  // themselves (as of construction; most are filled in at their final
+  // size).
+  void TrackElements_() {
+    if (MemoryAccounting::enabled()) {
+      MemoryAccounting::Track(&elements, "mesh_buffer_data",
+                              elements.size() * sizeof(T));
+    }
+  }
 };
 
 }  // namespace ballistica::base
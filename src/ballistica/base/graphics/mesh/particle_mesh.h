@@ -0,0 +1,19 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_MESH_PARTICLE_MESH_H_
+#define BALLISTICA_BASE_GRAPHICS_MESH_PARTICLE_MESH_H_
+
+#include "ballistica/base/graphics/mesh/mesh_indexed.h"
+
+namespace ballistica::base {
+
+// An indexed mesh of sprites that animate themselves on the GPU. Draw
+// with a SpriteComponent that has been given a particle step.
+class ParticleMesh
+    : public MeshIndexed<VertexParticle, MeshDataType::kParticle> {
+  using MeshIndexed::MeshIndexed;
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_MESH_PARTICLE_MESH_H_
@@ -18,7 +18,8 @@ void TextMesh::SetText(const std::string& text_in, HAlign alignment_h,
                        VAlign alignment_v, bool big, uint32_t min_val,
                        uint32_t max_val, TextMeshEntryType entry_type,
                        TextPacker* packer) {
-  if (text_in == text_) {
+  if (text_in == text_ && alignment_h == alignment_h_
+      && alignment_v == alignment_v_) {
     // Covers corner case where we assign a new string to empty.
     if (text_in.empty()) {
       SetEmpty();
@@ -26,6 +27,8 @@ void TextMesh::SetText(const std::string& text_in, HAlign alignment_h,
     return;
   }
   text_ = text_in;
+  alignment_h_ = alignment_h;
+  alignment_v_ = alignment_v;
 
   assert(Utils::IsValidUTF8(text_));
 
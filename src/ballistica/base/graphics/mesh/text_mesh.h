@@ -24,6 +24,8 @@ class TextMesh : public MeshIndexedDualTextureFull {
 
  private:
   std::string text_;
+  HAlign alignment_h_{};
+  VAlign alignment_v_{};
 };
 
 }  // namespace ballistica::base
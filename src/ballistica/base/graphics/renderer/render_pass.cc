@@ -334,7 +334,8 @@ void RenderPass::Render(RenderTarget* render_target, bool transparent) {
           ShadingType::kSimpleTextureModulatedTransparentGlow,
           ShadingType::kSimpleTextureModulatedTransparentGlowMaskUV2,
           ShadingType::kSmoke,
-          ShadingType::kSprite};
+          ShadingType::kSprite,
+          ShadingType::kParticle};
 
       ShadingType* component_types;
       int component_type_count;
@@ -392,6 +393,67 @@ void RenderPass::SetCamera(
   cam_area_of_interest_points_ = area_of_interest_points;
 }
 
+auto RenderPass::IsColumnVisible(const Vector3f& top, float bottom_y,
+                                 float radius) const -> bool {
+  Vector3f forward = (cam_target_ - cam_pos_).Normalized();
+  Vector3f right = Vector3f::Cross(forward, cam_up_).Normalized();
+  Vector3f up = Vector3f::Cross(right, forward);
+
+  // Tangents of our left, right, bottom, and top frustum edges.
+  float tan_l, tan_r, tan_b, tan_t;
+  if (cam_use_fov_tangents_) {
+    tan_l = cam_fov_l_tan_;
+    tan_r = cam_fov_r_tan_;
+    tan_b = cam_fov_b_tan_;
+    tan_t = cam_fov_t_tan_;
+  } else {
+    if (physical_height_ <= 0.0f) {
+      return true;
+    }
+    tan_b = tan_t = tanf((cam_fov_y_ / 2.0f) * kPi / 180.0f);
+    tan_l = tan_r = cam_fov_x_ > 0.0f
+                        ? tanf((cam_fov_x_ / 2.0f) * kPi / 180.0f)
+                        : tan_t * GetPhysicalAspectRatio();
+  }
+  float side_scales[4] = {1.0f / sqrtf(1.0f + tan_l * tan_l),
+                          1.0f / sqrtf(1.0f + tan_r * tan_r),
+                          1.0f / sqrtf(1.0f + tan_b * tan_b),
+                          1.0f / sqrtf(1.0f + tan_t * tan_t)};
+
+  // Returns a bitmask of the frustum planes a sphere lies fully outside.
+  auto outside_planes = [&](const Vector3f& center) -> int {
+    Vector3f d = center - cam_pos_;
+    float x = d.Dot(right);
+    float y = d.Dot(up);
+    float z = d.Dot(forward);
+    int planes{};
+    if (z < cam_near_clip_ - radius) planes |= 1;
+    if (z > cam_far_clip_ + radius) planes |= 2;
+    if ((-x - z * tan_l) * side_scales[0] > radius) planes |= 4;
+    if ((x - z * tan_r) * side_scales[1] > radius) planes |= 8;
+    if ((-y - z * tan_b) * side_scales[2] > radius) planes |= 16;
+    if ((y - z * tan_t) * side_scales[3] > radius) planes |= 32;
+    return planes;
+  };
+
+  // The frustum is convex, so if both ends of the column are outside the
+  // same plane, the whole thing is.
+  Vector3f bottom(top.x, bottom_y, top.z);
+  if ((outside_planes(top) & outside_planes(bottom)) == 0) {
+    return true;
+  }
+
+  // Reflections are drawn mirrored across y=0.
+  if (floor_reflection_) {
+    Vector3f top_m(top.x, -top.y, top.z);
+    Vector3f bottom_m(top.x, -bottom_y, top.z);
+    if ((outside_planes(top_m) & outside_planes(bottom_m)) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void RenderPass::Reset() {
   virtual_width_ = 0;
   virtual_height_ = 0;
@@ -493,8 +555,14 @@ void RenderPass::SetFrustum(float near_val, float far_val) {
 
 void RenderPass::Complete() {
   if (UsesWorldLists()) {
-    for (auto& command : commands_) {
-      command->Finalize();
+    // Opaque world stuff is depth-tested so we're free to rearrange it to
+    // cut down on state changes. Transparent stuff needs to stay in order.
+    bool sort = g_base->graphics->sort_opaque_draws();
+    for (int i = 0; i < static_cast<int>(ShadingType::kCount); ++i) {
+      if (sort && !Graphics::IsShaderTransparent(static_cast<ShadingType>(i))) {
+        commands_[i]->SortByState();
+      }
+      commands_[i]->Finalize();
     }
   } else {
     commands_flat_->Finalize();
@@ -98,6 +98,13 @@ class RenderPass {
                  float fov_tan_r, float fov_tan_b, float fov_tan_t,
                  const std::vector<Vector3f>& area_of_interest_points);
   auto frame_def() const -> FrameDef* { return frame_def_; }
+
+  /// Conservative check for whether anything drawn within radius of a
+  /// vertical segment from top down to bottom_y could show up in this
+  /// pass (including its floor reflection). Only returns false when it
+  /// definitely can't. Uses the camera as last set via SetCamera().
+  auto IsColumnVisible(const Vector3f& top, float bottom_y, float radius) const
+      -> bool;
   void Render(RenderTarget* t, bool transparent);
   auto tex_project_matrix() const -> const Matrix44f& {
     return tex_project_matrix_;
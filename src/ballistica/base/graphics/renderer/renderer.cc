@@ -8,10 +8,10 @@
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/graphics_server.h"
 #include "ballistica/core/core.h"
 
 #if BA_VR_BUILD
-#include "ballistica/base/graphics/graphics_server.h"
 #include "ballistica/base/graphics/graphics_vr.h"
 #endif
 
@@ -231,7 +231,9 @@ void Renderer::RenderFrameDef(FrameDef* frame_def) {
     // Note: We're forcing a shader-based blit for the moment; hardware blit
     // seems to be flaky on qualcomm hardware as of jan 14 (adreno 330, adreno
     // 320).
+    PushGroupMarker("Backing Blit");
     BlitBuffer(backing, screen_render_target(), false, true, true, true);
+    PopGroupMarker();
   }
 
   // Lastly, we no longer need depth on our screen target.
@@ -503,6 +505,8 @@ void Renderer::UpdateLightAndShadowBuffers(FrameDef* frame_def) {
                                    false,      // msaa
                                    false       // alpha
         );                                     // NOLINT(whitespace/parens)
+    light_render_target_neutral_ = false;
+    light_shadow_render_target_neutral_ = false;
   }
 }
 
@@ -516,18 +520,29 @@ void Renderer::RenderLightAndShadowPasses(FrameDef* frame_def) {
   SetDepthWriting(false);
   SetDepthTesting(false);
   SetDrawAtEqualDepth(false);
-  PushGroupMarker("Light Pass");
-  RenderTarget* r_target = light_render_target();
-  r_target->DrawBegin(true, kShadowNeutral, kShadowNeutral, kShadowNeutral,
-                      1.0f);
-  frame_def->light_pass()->Render(r_target, true);
-  PopGroupMarker();
-  PushGroupMarker("LightShadow Pass");
-  r_target = light_shadow_render_target();
+  RenderLightPass_(frame_def->light_pass(), light_render_target(),
+                   &light_render_target_neutral_, "Light Pass");
+  RenderLightPass_(frame_def->light_shadow_pass(),
+                   light_shadow_render_target(),
+                   &light_shadow_render_target_neutral_, "LightShadow Pass");
+}
+
+void Renderer::RenderLightPass_(RenderPass* pass, RenderTarget* r_target,
+                                bool* neutral, const char* marker) {
+  // An empty pass just leaves the buffer cleared to neutral, so if that's
+  // what's already in it from last time we can skip the clear and the
+  // fill-rate that goes with it. (Menus and quiet stretches of gameplay
+  // often have nothing in these passes.)
+  bool has_commands = pass->HasDrawCommands();
+  if (!has_commands && *neutral) {
+    return;
+  }
+  PushGroupMarker(marker);
   r_target->DrawBegin(true, kShadowNeutral, kShadowNeutral, kShadowNeutral,
                       1.0f);
-  frame_def->light_shadow_pass()->Render(r_target, true);
+  pass->Render(r_target, true);
   PopGroupMarker();
+  *neutral = !has_commands;
 }
 
 void Renderer::UpdateCameraRenderTargets(FrameDef* frame_def) {
@@ -563,6 +578,13 @@ void Renderer::UpdateCameraRenderTargets(FrameDef* frame_def) {
         blur_res_count_ = 1;
       }
 
+      // In fast mode our first blur level goes straight to quarter res, so
+      // it covers two halvings.
+      if (g_base->graphics_server->fast_post_process()
+          && blur_res_count_ < 2) {
+        blur_res_count_ = 2;
+      }
+
       // Now tweak our cam render target res so that its evenly divisible by
       // 2 for that many levels.
       int foo = 1;
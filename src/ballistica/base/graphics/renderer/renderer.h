@@ -136,6 +136,14 @@ class Renderer {
   virtual void SetDepthRange(float min, float max) = 0;
   virtual void FlipCullFace() = 0;
 
+  /// Start timing group-marker sections for a frame. Renderers that
+  /// don't support profiling can ignore this.
+  virtual void BeginProfileFrame() {}
+
+  /// Finish timing for a frame and append whatever section results are
+  /// available to the provided list.
+  virtual void EndProfileFrame(std::vector<RenderProfileSection>* sections) {}
+
  protected:
   virtual void DrawDebug() = 0;
   virtual void CheckForErrors() = 0;
@@ -179,6 +187,8 @@ class Renderer {
  private:
   void UpdateLightAndShadowBuffers(FrameDef* frame_def);
   void RenderLightAndShadowPasses(FrameDef* frame_def);
+  void RenderLightPass_(RenderPass* pass, RenderTarget* r_target,
+                        bool* neutral, const char* marker);
   void UpdateSizesQualitiesAndColors(FrameDef* frame_def);
   void DrawWorldToCameraBuffer(FrameDef* frame_def);
   void UpdatePixelScaleAndBackingBuffer(FrameDef* frame_def);
@@ -269,6 +279,10 @@ class Renderer {
   Object::Ref<RenderTarget> camera_msaa_render_target_;
   Object::Ref<RenderTarget> light_render_target_;
   Object::Ref<RenderTarget> light_shadow_render_target_;
+
+  // Whether these currently hold nothing but a neutral clear.
+  bool light_render_target_neutral_{};
+  bool light_shadow_render_target_neutral_{};
   Object::Ref<RenderTarget> vr_overlay_flat_render_target_;
 };
 
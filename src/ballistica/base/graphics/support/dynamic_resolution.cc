@@ -0,0 +1,84 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/dynamic_resolution.h"
+
+#include <algorithm>
+
+namespace ballistica::base {
+
+// Frames averaged per measurement.
+const int kDynamicResolutionWindow{30};
+
+// Scale changes in increments of this.
+const float kDynamicResolutionStep{0.05f};
+
+// Fractions of the frame budget above which a window counts as hot and
+// below which it counts as cool.
+const float kDynamicResolutionHighLoad{0.9f};
+const float kDynamicResolutionLowLoad{0.7f};
+
+// Consecutive cool windows needed before we step back up.
+const int kDynamicResolutionRecoverWindows{4};
+
+// Windows we sit out after a change to let timings settle.
+const int kDynamicResolutionCooldownWindows{2};
+
+void DynamicResolution::SetConfig(float target_fps, float min_scale) {
+  target_fps = std::max(0.0f, target_fps);
+  min_scale = std::clamp(min_scale, 0.1f, 1.0f);
+  if (target_fps == target_fps_ && min_scale == min_scale_) {
+    return;
+  }
+  target_fps_ = target_fps;
+  min_scale_ = min_scale;
+  Reset_();
+}
+
+void DynamicResolution::Reset_() {
+  scale_ = 1.0f;
+  window_cost_ = 0.0f;
+  window_frames_ = 0;
+  cool_windows_ = 0;
+  cooldown_windows_ = 0;
+}
+
+void DynamicResolution::AddFrame(float cost_ms) {
+  if (!enabled()) {
+    return;
+  }
+  window_cost_ += cost_ms;
+  window_frames_++;
+  if (window_frames_ < kDynamicResolutionWindow) {
+    return;
+  }
+  float load = window_cost_ / static_cast<float>(window_frames_)
+               / (1000.0f / target_fps_);
+  window_cost_ = 0.0f;
+  window_frames_ = 0;
+  if (cooldown_windows_ > 0) {
+    cooldown_windows_--;
+    return;
+  }
+  if (load > kDynamicResolutionHighLoad) {
+    cool_windows_ = 0;
+    if (scale_ > min_scale_) {
+      // Cost goes roughly with pixel count, so when we're way over take
+      // a bigger bite.
+      float step = load > 1.25f ? 2.0f * kDynamicResolutionStep
+                                : kDynamicResolutionStep;
+      scale_ = std::max(min_scale_, scale_ - step);
+      cooldown_windows_ = kDynamicResolutionCooldownWindows;
+    }
+  } else if (load < kDynamicResolutionLowLoad) {
+    cool_windows_++;
+    if (cool_windows_ >= kDynamicResolutionRecoverWindows && scale_ < 1.0f) {
+      cool_windows_ = 0;
+      scale_ = std::min(1.0f, scale_ + kDynamicResolutionStep);
+      cooldown_windows_ = kDynamicResolutionCooldownWindows;
+    }
+  } else {
+    cool_windows_ = 0;
+  }
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,42 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_DYNAMIC_RESOLUTION_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_DYNAMIC_RESOLUTION_H_
+
+namespace ballistica::base {
+
+/// Nudges render resolution up and down to keep frame render times within
+/// budget for a target frame rate. Frame costs are averaged over windows
+/// of frames; we drop a step as soon as a window runs hot but only climb
+/// back after several comfortably cool windows in a row, and hold still
+/// for a bit after any change, so we don't flap between resolutions (each
+/// change means rebuilding render targets). Graphics context only.
+class DynamicResolution {
+ public:
+  /// Set the frame rate to aim for (0 disables us, leaving scale at 1)
+  /// and the lowest scale we may go to.
+  void SetConfig(float target_fps, float min_scale);
+
+  auto enabled() const -> bool { return target_fps_ > 0.0f; }
+
+  /// Feed in the cost of a rendered frame in milliseconds; ideally GPU
+  /// time, though CPU render time works as a rougher stand-in.
+  void AddFrame(float cost_ms);
+
+  /// Scale to apply on top of the configured pixel scale.
+  auto scale() const -> float { return scale_; }
+
+ private:
+  void Reset_();
+  float target_fps_{};
+  float min_scale_{0.5f};
+  float scale_{1.0f};
+  float window_cost_{};
+  int window_frames_{};
+  int cool_windows_{};
+  int cooldown_windows_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_DYNAMIC_RESOLUTION_H_
@@ -0,0 +1,45 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/frame_arena.h"
+
+#include <algorithm>
+
+namespace ballistica::base {
+
+const size_t kFrameArenaMinBlockSize{64 * 1024};
+
+auto FrameArena::AllocateSlow_(size_t size, size_t alignment) -> void* {
+  // Move on to the next block if we have one it fits in; otherwise add a
+  // new one, twice the size of the last so we don't do this often.
+  size_t needed = size + alignment - 1;
+  while (current_block_ + 1 < blocks_.size()) {
+    current_block_++;
+    offset_ = 0;
+    if (needed <= blocks_[current_block_].size) {
+      return Allocate(size, alignment);
+    }
+  }
+  size_t block_size =
+      blocks_.empty() ? kFrameArenaMinBlockSize : blocks_.back().size * 2;
+  block_size = std::max(block_size, needed);
+  blocks_.push_back({std::make_unique<uint8_t[]>(block_size), block_size});
+  reserved_bytes_ += block_size;
+  current_block_ = blocks_.size() - 1;
+  offset_ = 0;
+  return Allocate(size, alignment);
+}
+
+void FrameArena::Reset() {
+  // If last frame spilled into multiple blocks, replace them with a single
+  // one that will hold it all next time.
+  if (blocks_.size() > 1) {
+    blocks_.clear();
+    blocks_.push_back(
+        {std::make_unique<uint8_t[]>(reserved_bytes_), reserved_bytes_});
+  }
+  current_block_ = 0;
+  offset_ = 0;
+  generation_++;
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,161 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_ARENA_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_ARENA_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ballistica::base {
+
+/// A bump allocator for data that lives exactly as long as one frame.
+///
+/// Each FrameDef owns one of these and resets it when the FrameDef is
+/// recycled for a new frame. Individual allocations are never freed; all
+/// memory is reclaimed at once in Reset(). If a frame needed more than one
+/// block, Reset() swaps them out for a single block big enough to hold
+/// everything, so a steady stream of similar frames settles into zero
+/// allocations.
+class FrameArena {
+ public:
+  FrameArena() = default;
+  FrameArena(const FrameArena&) = delete;
+  auto operator=(const FrameArena&) -> FrameArena& = delete;
+
+  /// Allocate some uninitialized memory. Alignment must be a power of 2.
+  auto Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+      -> void* {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    size_t offset = (offset_ + alignment - 1) & ~(alignment - 1);
+    if (current_block_ < blocks_.size()
+        && offset + size <= blocks_[current_block_].size) {
+      offset_ = offset + size;
+      return blocks_[current_block_].data.get() + offset;
+    }
+    return AllocateSlow_(size, alignment);
+  }
+
+  /// Reclaim everything allocated since the last reset. Anything still
+  /// pointing into the arena is invalid after this.
+  void Reset();
+
+  /// Incremented on each Reset(); lets holders of arena memory detect
+  /// that it has been reclaimed out from under them.
+  auto generation() const -> uint32_t { return generation_; }
+
+  /// Total memory held by the arena.
+  auto reserved_bytes() const -> size_t { return reserved_bytes_; }
+
+ private:
+  struct Block_ {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size{};
+  };
+  auto AllocateSlow_(size_t size, size_t alignment) -> void*;
+
+  std::vector<Block_> blocks_;
+  size_t current_block_{};
+  size_t offset_{};
+  size_t reserved_bytes_{};
+  uint32_t generation_{};
+};
+
+/// A bare-bones vector of trivially-copyable values stored in a
+/// FrameArena.
+///
+/// Growing simply grabs a bigger chunk of the arena and copies over; the
+/// old chunk is reclaimed along with everything else at the next arena
+/// reset. Contents are implicitly dropped when the arena resets.
+template <typename T>
+class FrameArenaVector {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+ public:
+  void set_arena(FrameArena* arena) {
+    arena_ = arena;
+    Reset();
+  }
+
+  /// Drop all contents (and our claim on arena memory).
+  void Reset() {
+    data_ = nullptr;
+    size_ = capacity_ = 0;
+    generation_ = arena_ ? arena_->generation() : 0;
+  }
+
+  auto size() const -> size_t { return IsCurrent_() ? size_ : 0; }
+  auto empty() const -> bool { return size() == 0; }
+
+  auto operator[](size_t index) -> T& {
+    assert(IsCurrent_() && index < size_);
+    return data_[index];
+  }
+  auto operator[](size_t index) const -> const T& {
+    assert(IsCurrent_() && index < size_);
+    return data_[index];
+  }
+
+  auto data() -> T* { return data_; }
+  auto begin() const -> const T* { return data_; }
+  auto end() const -> const T* { return data_ + size(); }
+
+  void push_back(const T& value) {
+    if (size_ == capacity_ || !IsCurrent_()) {
+      Grow_(size_ + 1);
+    }
+    data_[size_++] = value;
+  }
+
+  /// Change the size. Note that unlike std::vector, new elements are left
+  /// uninitialized; callers are expected to fill them in.
+  void resize(size_t size) {
+    if (size > capacity_ || !IsCurrent_()) {
+      Grow_(size);
+    }
+    size_ = size;
+  }
+
+ private:
+  auto IsCurrent_() const -> bool {
+    return arena_ == nullptr || generation_ == arena_->generation();
+  }
+
+  void Grow_(size_t min_capacity) {
+    assert(arena_);
+
+    // If the arena has been reset since we last grew, our old contents
+    // are gone.
+    if (!IsCurrent_()) {
+      Reset();
+      if (min_capacity <= capacity_) {
+        return;
+      }
+    }
+    size_t capacity = capacity_ < 16 ? 16 : capacity_ * 2;
+    if (capacity < min_capacity) {
+      capacity = min_capacity;
+    }
+    auto* data =
+        static_cast<T*>(arena_->Allocate(capacity * sizeof(T), alignof(T)));
+    if (size_ > 0) {
+      memcpy(data, data_, size_ * sizeof(T));
+    }
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  FrameArena* arena_{};
+  T* data_{};
+  size_t size_{};
+  size_t capacity_{};
+  uint32_t generation_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_ARENA_H_
@@ -9,6 +9,7 @@
 #include "ballistica/base/graphics/mesh/mesh_indexed_simple_full.h"
 #include "ballistica/base/graphics/mesh/mesh_indexed_simple_split.h"
 #include "ballistica/base/graphics/mesh/mesh_indexed_smoke_full.h"
+#include "ballistica/base/graphics/mesh/particle_mesh.h"
 #include "ballistica/base/graphics/mesh/sprite_mesh.h"
 #include "ballistica/base/graphics/renderer/render_pass.h"
 #include "ballistica/base/graphics/support/camera.h"
@@ -66,6 +67,9 @@ void FrameDef::Reset() {
   display_time_microsecs_ = 0;
   display_time_elapsed_microsecs_ = 0;
   frame_number_ = 0;
+  profile_render_ = false;
+  latency_microsecs_ = 0;
+  render_profile_.Reset();
 
 #if BA_DEBUG_BUILD
   defining_component_ = false;
@@ -73,6 +77,10 @@ void FrameDef::Reset() {
 
   benchmark_type_ = BenchmarkType::kNone;
 
+  // Reclaim all of last frame's scratch memory. Render-pass command
+  // buffers are reset below and start over from this.
+  arena_.Reset();
+
   mesh_data_creates_.clear();
   mesh_data_destroys_.clear();
 
@@ -120,6 +128,7 @@ void FrameDef::Reset() {
 
 void FrameDef::Complete() {
   assert(!defining_component_);
+  g_base->graphics->overlay_quads()->OnFrameDefComplete();
   light_pass_->Complete();
   light_shadow_pass_->Complete();
   beauty_pass_->Complete();
@@ -203,6 +212,16 @@ void FrameDef::AddMesh(Mesh* mesh) {
         mesh_buffers_.emplace_back(m->data());
         break;
       }
+      case MeshDataType::kParticle: {
+        auto* m = static_cast<ParticleMesh*>(mesh);
+        assert(m);
+        assert(m == dynamic_cast<ParticleMesh*>(mesh));
+        mesh_index_sizes_.push_back(
+            static_cast_check_fit<int8_t>(m->index_data_size()));
+        mesh_buffers_.emplace_back(m->GetIndexData());
+        mesh_buffers_.emplace_back(m->data());
+        break;
+      }
       default:
         throw Exception();
     }
@@ -7,7 +7,9 @@
 #include <vector>
 
 #include "ballistica/base/assets/asset.h"
+#include "ballistica/base/graphics/support/frame_arena.h"
 #include "ballistica/base/graphics/support/graphics_settings.h"
+#include "ballistica/base/graphics/support/render_profile.h"
 #include "ballistica/shared/generic/snapshot.h"
 #include "ballistica/shared/math/matrix44f.h"
 #include "ballistica/shared/math/vector2f.h"
@@ -216,6 +218,19 @@ class FrameDef {
 
   // auto pixel_scale() const { return pixel_scale_; }
 
+  /// Scratch memory that lives until this frame-def is recycled.
+  auto arena() -> FrameArena* { return &arena_; }
+
+  /// Whether timing info should be gathered for this frame.
+  auto profile_render() const -> bool { return profile_render_; }
+  void set_profile_render(bool val) { profile_render_ = val; }
+  auto render_profile() -> RenderProfile* { return &render_profile_; }
+
+  /// Time from when we started building this frame to when we were done
+  /// rendering it (set in the graphics thread; 0 if not rendered).
+  auto latency_microsecs() const { return latency_microsecs_; }
+  void set_latency_microsecs(microsecs_t val) { latency_microsecs_ = val; }
+
   auto* settings() const {
     assert(settings_snapshot_.exists());
     return settings_snapshot_->get();
@@ -225,7 +240,9 @@ class FrameDef {
   Object::Ref<Snapshot<GraphicsSettings>> settings_snapshot_;
   bool needs_clear_{};
   bool rendering_{};
+  bool profile_render_{};
   bool orbiting_{};
+  microsecs_t latency_microsecs_{};
   // bool tv_border_{};
   bool shadow_ortho_{};
   BenchmarkType benchmark_type_{BenchmarkType::kNone};
@@ -253,6 +270,9 @@ class FrameDef {
   RenderComponent* active_render_component_{};
 #endif
 
+  // Must come before our render-passes, which use it.
+  FrameArena arena_;
+
   std::unique_ptr<RenderPass> light_pass_;
   std::unique_ptr<RenderPass> light_shadow_pass_;
   std::unique_ptr<RenderPass> beauty_pass_;
@@ -272,6 +292,7 @@ class FrameDef {
   microsecs_t display_time_elapsed_millisecs_{};
   int64_t frame_number_{};
   int64_t frame_number_filtered_{};
+  RenderProfile render_profile_;
   Vector3f shadow_offset_{0.0f, 0.0f, 0.0f};
   Vector2f shadow_scale_{1.0f, 1.0f};
   Vector3f tint_{1.0f, 1.0f, 1.0f};
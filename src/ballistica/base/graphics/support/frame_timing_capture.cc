@@ -0,0 +1,102 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/frame_timing_capture.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "ballistica/shared/generic/json_stream.h"
+
+namespace ballistica::base {
+
+static void AddSample_(std::vector<float>* samples, float value) {
+  if (samples->size() < kFrameTimingCaptureMaxSamples) {
+    samples->push_back(value);
+  }
+}
+
+static void WriteStats_(JsonWriter* writer, const char* key,
+                        std::vector<float> values) {
+  writer->Key(key);
+  writer->BeginObject();
+  writer->Key("count");
+  writer->Number(static_cast<double>(values.size()));
+  if (!values.empty()) {
+    std::sort(values.begin(), values.end());
+    double total{};
+    for (auto value : values) {
+      total += value;
+    }
+    auto at = [&values](double fraction) {
+      return values[static_cast<size_t>(
+          fraction * static_cast<double>(values.size() - 1))];
+    };
+    writer->Key("mean");
+    writer->Number(total / static_cast<double>(values.size()));
+    writer->Key("p50");
+    writer->Number(at(0.5));
+    writer->Key("p95");
+    writer->Number(at(0.95));
+    writer->Key("p99");
+    writer->Number(at(0.99));
+    writer->Key("max");
+    writer->Number(values.back());
+  }
+  writer->EndObject();
+}
+
+void FrameTimingCapture::AddFrame(microsecs_t app_time) {
+  if (last_frame_time_ != -1) {
+    AddSample_(&frame_ms_,
+               static_cast<float>(app_time - last_frame_time_) / 1000.0f);
+  }
+  last_frame_time_ = app_time;
+}
+
+void FrameTimingCapture::AddLogicUpdate(microsecs_t duration) {
+  AddSample_(&logic_ms_, static_cast<float>(duration) / 1000.0f);
+}
+
+void FrameTimingCapture::AddSessionUpdate(microsecs_t duration) {
+  AddSample_(&session_update_ms_, static_cast<float>(duration) / 1000.0f);
+}
+
+void FrameTimingCapture::AddSceneDraw(microsecs_t duration) {
+  AddSample_(&scene_draw_ms_, static_cast<float>(duration) / 1000.0f);
+}
+
+void FrameTimingCapture::AddRenderProfile(const RenderProfile& profile) {
+  AddSample_(&build_ms_, profile.build_cpu_ms);
+  AddSample_(&render_cpu_ms_, profile.render_cpu_ms);
+
+  // Top level sections cover the whole frame; only count gpu time if the
+  // renderer measured all of them.
+  float gpu_ms{};
+  bool have_gpu{};
+  for (auto&& section : profile.sections) {
+    if (section.depth != 0) {
+      continue;
+    }
+    if (section.gpu_ms < 0.0f) {
+      have_gpu = false;
+      break;
+    }
+    gpu_ms += section.gpu_ms;
+    have_gpu = true;
+  }
+  if (have_gpu) {
+    AddSample_(&gpu_ms_, gpu_ms);
+  }
+}
+
+void FrameTimingCapture::WriteSummary(JsonWriter* writer) const {
+  WriteStats_(writer, "frame_ms", frame_ms_);
+  WriteStats_(writer, "logic_ms", logic_ms_);
+  WriteStats_(writer, "session_update_ms", session_update_ms_);
+  WriteStats_(writer, "scene_draw_ms", scene_draw_ms_);
+  WriteStats_(writer, "build_ms", build_ms_);
+  WriteStats_(writer, "render_cpu_ms", render_cpu_ms_);
+  WriteStats_(writer, "gpu_ms", gpu_ms_);
+}
+
+}  // namespace ballistica::base
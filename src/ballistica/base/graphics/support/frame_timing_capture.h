@@ -0,0 +1,57 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_TIMING_CAPTURE_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_TIMING_CAPTURE_H_
+
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/graphics/support/render_profile.h"
+
+namespace ballistica {
+class JsonWriter;
+}
+
+namespace ballistica::base {
+
+/// Most samples of each kind a capture will hold (a bit over an hour of
+/// frames at 120hz); anything past that is ignored.
+const size_t kFrameTimingCaptureMaxSamples{500000};
+
+/// Collects per-frame timings over a stretch of time so they can be
+/// summarized as percentiles: the interval between frames, logic updates
+/// (and the session updates within them), frame-def builds (and the scene
+/// draws within them) and render cpu/gpu time. Frames built while a
+/// capture is running get profiled regardless of 'Show Render Profile'.
+/// Logic thread only.
+class FrameTimingCapture {
+ public:
+  /// Called as each frame-def is built.
+  void AddFrame(microsecs_t app_time);
+  void AddLogicUpdate(microsecs_t duration);
+  void AddSessionUpdate(microsecs_t duration);
+  void AddSceneDraw(microsecs_t duration);
+
+  /// Called as each profiled frame-def comes back from rendering.
+  void AddRenderProfile(const RenderProfile& profile);
+
+  auto frame_count() const { return frame_ms_.size(); }
+
+  /// Write a summary (count, mean, p50/p95/p99 and max in milliseconds)
+  /// for each sample kind as members of the current json object.
+  void WriteSummary(JsonWriter* writer) const;
+
+ private:
+  std::vector<float> frame_ms_;
+  std::vector<float> logic_ms_;
+  std::vector<float> session_update_ms_;
+  std::vector<float> scene_draw_ms_;
+  std::vector<float> build_ms_;
+  std::vector<float> render_cpu_ms_;
+  std::vector<float> gpu_ms_;
+  microsecs_t last_frame_time_{-1};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_TIMING_CAPTURE_H_
@@ -21,6 +21,27 @@ GraphicsSettings::GraphicsSettings()
       graphics_quality{g_base->graphics->GraphicsQualityFromAppConfig()},
       texture_quality{g_base->graphics->TextureQualityFromAppConfig()},
       tv_border{
-          g_base->app_config->Resolve(AppConfig::BoolID::kEnableTVBorder)} {}
+          g_base->app_config->Resolve(AppConfig::BoolID::kEnableTVBorder)},
+      fast_post_process{
+          g_base->app_config->Resolve(AppConfig::BoolID::kFastPostProcess)},
+      graphics_load_budget_kb{std::max(
+          0, g_base->app_config->Resolve(
+                 AppConfig::IntID::kGraphicsLoadBudgetKB))},
+      frames_in_flight{std::clamp(
+          g_base->app_config->Resolve(AppConfig::IntID::kFramesInFlight), 1,
+          3)},
+      texture_residency_budget_mb{std::max(
+          0, g_base->app_config->Resolve(
+                 AppConfig::IntID::kTextureResidencyBudgetMB))},
+      bg_dynamics_target_step_ms{std::max(
+          0.0f, g_base->app_config->Resolve(
+                    AppConfig::FloatID::kBGDynamicsTargetStepMS))},
+      dynamic_resolution_target_fps{std::max(
+          0.0f, g_base->app_config->Resolve(
+                    AppConfig::FloatID::kDynamicResolutionTargetFPS))},
+      dynamic_resolution_min_scale{std::clamp(
+          g_base->app_config->Resolve(
+              AppConfig::FloatID::kDynamicResolutionMinScale),
+          0.1f, 1.0f)} {}
 
 }  // namespace ballistica::base
@@ -26,6 +26,36 @@ struct GraphicsSettings {
   GraphicsQualityRequest graphics_quality;
   TextureQualityRequest texture_quality;
   bool tv_border;
+
+  // Run post-process blur passes starting from quarter resolution instead
+  // of half, skipping the extra blur pass in higher quality. Cheaper depth
+  // of field and such at some cost in smoothness.
+  bool fast_post_process;
+
+  // Max kilobytes of texture/mesh data to push to the renderer per frame
+  // for incremental asset loads (0 for no limit).
+  int graphics_load_budget_kb;
+
+  // How many frames may be in the works at once between the logic and
+  // graphics threads (1-3). 1 gives the lowest input latency (the next
+  // frame isn't built until the last is rendered), 2 overlaps building
+  // with rendering, and 3 additionally keeps a finished frame queued up to
+  // ride out hitches at the cost of another frame of latency.
+  int frames_in_flight;
+
+  // Megabytes of texture memory to aim for; top mip levels of long-unused
+  // textures get evicted when over this (0 for no limit).
+  int texture_residency_budget_mb;
+
+  // Milliseconds of work per step the bg-dynamics thread should aim for;
+  // it scales its effects back when it runs over (0 to disable).
+  float bg_dynamics_target_step_ms;
+
+  // Frame rate to hold by lowering render resolution as far as
+  // dynamic_resolution_min_scale (on top of pixel_scale) when frames get
+  // expensive (0 to disable).
+  float dynamic_resolution_target_fps;
+  float dynamic_resolution_min_scale;
 };
 
 }  // namespace ballistica::base
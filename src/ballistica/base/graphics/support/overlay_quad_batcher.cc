@@ -0,0 +1,104 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/overlay_quad_batcher.h"
+
+#include <cmath>
+
+#include "ballistica/base/graphics/component/simple_component.h"
+#include "ballistica/base/graphics/mesh/mesh_indexed_simple_full.h"
+
+namespace ballistica::base {
+
+auto OverlayQuadBatcher::State::operator==(const State& other) const -> bool {
+  return pass == other.pass && texture == other.texture
+         && transparent == other.transparent
+         && premultiplied == other.premultiplied && color[0] == other.color[0]
+         && color[1] == other.color[1] && color[2] == other.color[2]
+         && color[3] == other.color[3];
+}
+
+OverlayQuadBatcher::OverlayQuadBatcher() = default;
+OverlayQuadBatcher::~OverlayQuadBatcher() = default;
+
+void OverlayQuadBatcher::AddQuad(const State& state, float x, float y,
+                                 float z, float width, float height,
+                                 float rotate) {
+  assert(g_base->InLogicThread());
+  assert(state.pass);
+  if (vertices_.empty()) {
+    state_ = state;
+  } else if (!(state == state_)
+             || static_cast<int>(vertices_.size())
+                    >= kOverlayQuadBatchMaxQuads * 4) {
+    Flush_();
+    state_ = state;
+  }
+
+  // Match the layout and uvs of ImageMesh (bottom-left, bottom-right,
+  // top-left, top-right).
+  float hw = width * 0.5f;
+  float hh = height * 0.5f;
+  float c{1.0f};
+  float s{};
+  if (rotate != 0.0f) {
+    c = cosf(rotate * kPiDeg);
+    s = sinf(rotate * kPiDeg);
+  }
+  const float corners[4][2] = {{-hw, -hh}, {hw, -hh}, {-hw, hh}, {hw, hh}};
+  const uint16_t uvs[4][2] = {{0, 65535}, {65535, 65535}, {0, 0}, {65535, 0}};
+  for (int i = 0; i < 4; ++i) {
+    VertexSimpleFull v{};
+    v.position[0] = x + corners[i][0] * c - corners[i][1] * s;
+    v.position[1] = y + corners[i][0] * s + corners[i][1] * c;
+    v.position[2] = z;
+    v.uv[0] = uvs[i][0];
+    v.uv[1] = uvs[i][1];
+    vertices_.push_back(v);
+  }
+}
+
+void OverlayQuadBatcher::Flush_() {
+  assert(!vertices_.empty());
+  auto quad_count = static_cast<int>(vertices_.size() / 4);
+  auto vertex_buffer(Object::New<MeshBuffer<VertexSimpleFull> >(
+      vertices_.size(), vertices_.data()));
+  auto index_buffer(Object::New<MeshIndexBuffer16>(quad_count * 6));
+  uint16_t* i = index_buffer->elements.data();
+  for (int q = 0; q < quad_count; ++q) {
+    auto v = static_cast_check_fit<uint16_t>(q * 4);
+    *i++ = v;
+    *i++ = static_cast<uint16_t>(v + 1);
+    *i++ = static_cast<uint16_t>(v + 2);
+    *i++ = static_cast<uint16_t>(v + 1);
+    *i++ = static_cast<uint16_t>(v + 3);
+    *i++ = static_cast<uint16_t>(v + 2);
+  }
+
+  // Clear out before drawing so our own component doesn't flush us again.
+  vertices_.clear();
+
+  // Each mesh can only carry one set of data per frame-def, so every
+  // flush within a frame gets its own.
+  if (next_mesh_ == meshes_.size()) {
+    meshes_.push_back(Object::New<MeshIndexedSimpleFull>());
+  }
+  auto& mesh{meshes_[next_mesh_++]};
+  mesh->SetIndexData(index_buffer);
+  mesh->SetData(vertex_buffer);
+
+  SimpleComponent c(state_.pass);
+  c.SetTransparent(state_.transparent);
+  c.SetPremultiplied(state_.premultiplied);
+  c.SetTexture(state_.texture);
+  c.SetColor(state_.color[0], state_.color[1], state_.color[2],
+             state_.color[3]);
+  c.DrawMesh(mesh.get());
+  c.Submit();
+}
+
+void OverlayQuadBatcher::OnFrameDefComplete() {
+  Flush();
+  next_mesh_ = 0;
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,66 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_OVERLAY_QUAD_BATCHER_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_OVERLAY_QUAD_BATCHER_H_
+
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/shared/foundation/object.h"
+
+namespace ballistica::base {
+
+/// Most quads we pack into a single batch mesh (keeps indices 16 bit).
+const int kOverlayQuadBatchMaxQuads{4096};
+
+/// Collects simple textured quads going into overlay passes (HUD images
+/// and the like) and draws consecutive runs of them that share a texture,
+/// color and blend mode as one mesh instead of one component per quad.
+///
+/// Quads are only held until some other component starts drawing or the
+/// frame-def completes, so draw order within each pass is unchanged.
+/// Logic thread only.
+class OverlayQuadBatcher {
+ public:
+  /// Everything that must match for quads to share a draw.
+  struct State {
+    RenderPass* pass{};
+    TextureAsset* texture{};
+    float color[4]{1.0f, 1.0f, 1.0f, 1.0f};
+    bool transparent{};
+    bool premultiplied{};
+
+    auto operator==(const State& other) const -> bool;
+  };
+
+  OverlayQuadBatcher();
+  ~OverlayQuadBatcher();
+
+  /// Add a unit image quad scaled to width by height, rotated rotate
+  /// degrees counter-clockwise, and centered at x, y, z in pass space.
+  void AddQuad(const State& state, float x, float y, float z, float width,
+               float height, float rotate = 0.0f);
+
+  /// Draw anything we're holding. Called automatically before any other
+  /// component draws.
+  void Flush() {
+    if (!vertices_.empty()) {
+      Flush_();
+    }
+  }
+
+  /// Called as a frame-def completes; flushes and recycles our meshes.
+  void OnFrameDefComplete();
+
+ private:
+  void Flush_();
+
+  State state_;
+  std::vector<VertexSimpleFull> vertices_;
+  std::vector<Object::Ref<MeshIndexedSimpleFull> > meshes_;
+  size_t next_mesh_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_OVERLAY_QUAD_BATCHER_H_
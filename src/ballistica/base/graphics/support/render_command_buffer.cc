@@ -0,0 +1,104 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/render_command_buffer.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace ballistica::base {
+
+void RenderCommandBuffer::SortByState() {
+  assert(!finalized_);
+  size_t unit_count = sort_units_.size();
+  if (!sortable_ || sort_nesting_ != 0 || unit_count < 2
+      || sort_units_[0].commands != 0) {
+    return;
+  }
+
+  // Key each unit on its first texture and then its first mesh.
+  struct Key {
+    const void* texture;
+    const void* mesh;
+    uint32_t unit;
+  };
+  FrameArenaVector<Key> keys;
+  keys.set_arena(frame_def_->arena());
+  keys.resize(unit_count);
+  for (size_t i = 0; i < unit_count; ++i) {
+    const SortUnit_& unit{sort_units_[i]};
+    bool last = (i + 1 == unit_count);
+    size_t textures_end =
+        last ? textures_.size() : sort_units_[i + 1].textures;
+    size_t meshes_end = last ? meshes_.size() : sort_units_[i + 1].meshes;
+    size_t mesh_datas_end =
+        last ? mesh_datas_.size() : sort_units_[i + 1].mesh_datas;
+    Key& key{keys[i]};
+    key.texture =
+        unit.textures < textures_end ? textures_[unit.textures] : nullptr;
+    if (unit.meshes < meshes_end) {
+      key.mesh = meshes_[unit.meshes];
+    } else if (unit.mesh_datas < mesh_datas_end) {
+      key.mesh = mesh_datas_[unit.mesh_datas];
+    } else {
+      key.mesh = nullptr;
+    }
+    key.unit = static_cast<uint32_t>(i);
+  }
+  auto less = [](const Key& a, const Key& b) {
+    if (a.texture != b.texture) {
+      return std::less<const void*>()(a.texture, b.texture);
+    }
+    return std::less<const void*>()(a.mesh, b.mesh);
+  };
+  if (std::is_sorted(keys.data(), keys.data() + unit_count, less)) {
+    return;
+  }
+  std::stable_sort(keys.data(), keys.data() + unit_count, less);
+
+  FrameArenaVector<uint32_t> order;
+  order.set_arena(frame_def_->arena());
+  order.resize(unit_count);
+  for (size_t i = 0; i < unit_count; ++i) {
+    order[i] = keys[i].unit;
+  }
+  ReorderStream_(&commands_, &SortUnit_::commands, order);
+  ReorderStream_(&fvals_, &SortUnit_::fvals, order);
+  ReorderStream_(&ivals_, &SortUnit_::ivals, order);
+  ReorderStream_(&meshes_, &SortUnit_::meshes, order);
+  ReorderStream_(&textures_, &SortUnit_::textures, order);
+  ReorderStream_(&mesh_datas_, &SortUnit_::mesh_datas, order);
+
+  // Our unit offsets no longer apply.
+  sort_units_.Reset();
+  sortable_ = false;
+}
+
+template <typename T>
+void RenderCommandBuffer::ReorderStream_(
+    FrameArenaVector<T>* stream, uint32_t SortUnit_::*field,
+    const FrameArenaVector<uint32_t>& order) {
+  size_t size = stream->size();
+  if (size == 0) {
+    return;
+  }
+  FrameArenaVector<T> sorted;
+  sorted.set_arena(frame_def_->arena());
+  sorted.resize(size);
+  size_t out = 0;
+  size_t unit_count = sort_units_.size();
+  for (size_t i = 0; i < unit_count; ++i) {
+    uint32_t unit = order[i];
+    size_t begin = sort_units_[unit].*field;
+    size_t end =
+        (unit + 1 == unit_count) ? size : sort_units_[unit + 1].*field;
+    if (end > begin) {
+      memcpy(sorted.data() + out, stream->data() + begin,
+             (end - begin) * sizeof(T));
+      out += end - begin;
+    }
+  }
+  assert(out == size);
+  *stream = sorted;
+}
+
+}  // namespace ballistica::base
@@ -3,10 +3,14 @@
 #ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_RENDER_COMMAND_BUFFER_H_
 #define BALLISTICA_BASE_GRAPHICS_SUPPORT_RENDER_COMMAND_BUFFER_H_
 
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
+#include "ballistica/base/assets/mesh_asset.h"
 #include "ballistica/base/assets/texture_asset.h"
 #include "ballistica/base/graphics/mesh/mesh_data.h"
+#include "ballistica/base/graphics/support/frame_arena.h"
 #include "ballistica/base/graphics/support/frame_def.h"
 #include "ballistica/shared/math/matrix44f.h"
 
@@ -54,6 +58,7 @@ class RenderCommandBuffer {
   RenderCommandBuffer() = default;
   void PutCommand(Command c) {
     assert(!finalized_);
+    TrackSortUnits_(c);
     commands_.push_back(c);
   }
 
@@ -62,170 +67,25 @@ class RenderCommandBuffer {
     fvals_.push_back(val);
   }
 
-  void PutFloats(float f1, float f2) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 2);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f = f2;
-  }
-
-  void PutFloats(float f1, float f2, float f3) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 3);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f = f3;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 4);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f = f4;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 5);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f = f5;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 6);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f = f6;
+  /// Write any number of floats with a single copy.
+  template <typename... Ts>
+  void PutFloats(Ts... vals) {
+    static_assert((std::is_arithmetic_v<Ts> && ...));
+    const float f[] = {static_cast<float>(vals)...};
+    PutRecord(f);
   }
 
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 7);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f = f7;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 8);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f = f8;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 9);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f = f9;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9, float f10) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 10);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f++ = f9;
-    *f = f10;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9, float f10, float f11,
-                 float f12) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 12);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f++ = f9;
-    *f++ = f10;
-    *f++ = f11;
-    *f = f12;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9, float f10, float f11, float f12,
-                 float f13, float f14, float f15) {
+  /// Write a fixed-size block of float data (a float array or a struct
+  /// made of floats) with a single copy. Read it back with GetRecord()
+  /// using the same type.
+  template <typename T>
+  void PutRecord(const T& record) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) % sizeof(float) == 0);
     assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 15);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f++ = f9;
-    *f++ = f10;
-    *f++ = f11;
-    *f++ = f12;
-    *f++ = f13;
-    *f++ = f14;
-    *f = f15;
+    size_t s = fvals_.size();
+    fvals_.resize(s + sizeof(T) / sizeof(float));
+    memcpy(&(fvals_[s]), &record, sizeof(T));
   }
 
   void PutFloatArray16(const float* f_in) {
@@ -304,149 +164,25 @@ class RenderCommandBuffer {
     return fvals_[fvals_index_++];
   }
 
-  void GetFloats(float* f1, float* f2) {
-    assert(finalized_);
-    assert(fvals_index_ + 2 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3) {
-    assert(finalized_);
-    assert(fvals_index_ + 3 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4) {
-    assert(finalized_);
-    assert(fvals_index_ + 4 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5) {
-    assert(finalized_);
-    assert(fvals_index_ + 5 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6) {
-    assert(finalized_);
-    assert(fvals_index_ + 6 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7) {
-    assert(finalized_);
-    assert(fvals_index_ + 7 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8) {
-    assert(finalized_);
-    assert(fvals_index_ + 8 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9) {
-    assert(finalized_);
-    assert(fvals_index_ + 9 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9, float* f10) {
-    assert(finalized_);
-    assert(fvals_index_ + 10 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-    *f10 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9, float* f10,
-                 float* f11, float* f12) {
-    assert(finalized_);
-    assert(fvals_index_ + 12 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-    *f10 = fvals_[fvals_index_++];
-    *f11 = fvals_[fvals_index_++];
-    *f12 = fvals_[fvals_index_++];
+  /// Read back floats written with a PutFloats() call of the same count.
+  template <typename... Ts>
+  void GetFloats(Ts*... vals) {
+    static_assert((std::is_same_v<Ts, float> && ...));
+    float f[sizeof...(Ts)];
+    GetRecord(&f);
+    size_t i{};
+    ((*vals = f[i++]), ...);
   }
 
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9, float* f10,
-                 float* f11, float* f12, float* f13, float* f14, float* f15) {
+  /// Read back a block written with PutRecord().
+  template <typename T>
+  void GetRecord(T* record) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) % sizeof(float) == 0);
     assert(finalized_);
-    assert(fvals_index_ + 15 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-    *f10 = fvals_[fvals_index_++];
-    *f11 = fvals_[fvals_index_++];
-    *f12 = fvals_[fvals_index_++];
-    *f13 = fvals_[fvals_index_++];
-    *f14 = fvals_[fvals_index_++];
-    *f15 = fvals_[fvals_index_++];
+    assert(fvals_index_ + sizeof(T) / sizeof(float) <= fvals_.size());
+    memcpy(record, &(fvals_[fvals_index_]), sizeof(T));
+    fvals_index_ += sizeof(T) / sizeof(float);
   }
 
   auto GetMatrix() -> Matrix44f* {
@@ -496,15 +232,25 @@ class RenderCommandBuffer {
   }
 
   void Reset() {
-    commands_.resize(0);
-    fvals_.resize(0);
-    ivals_.resize(0);
-    meshes_.resize(0);
-    textures_.resize(0);
-    mesh_datas_.resize(0);
+    commands_.Reset();
+    fvals_.Reset();
+    ivals_.Reset();
+    meshes_.Reset();
+    textures_.Reset();
+    mesh_datas_.Reset();
+    sort_units_.Reset();
+    sort_nesting_ = 0;
+    sortable_ = true;
     finalized_ = false;
   }
 
+  /// Reorder the buffer's contents to group together draws sharing
+  /// textures and meshes, minimizing state changes. Only valid for opaque
+  /// depth-tested draws where order doesn't affect results. Does nothing
+  /// if the buffer contains anything (such as a top-level transform) that
+  /// would make reordering unsafe. Call just before Finalize().
+  void SortByState();
+
   // Call once done writing to buffer.
   void Finalize() {
     assert(!finalized_);
@@ -550,15 +296,92 @@ class RenderCommandBuffer {
     return frame_def_;
   }
 
-  void set_frame_def(FrameDef* f) { frame_def_ = f; }
+  void set_frame_def(FrameDef* f) {
+    frame_def_ = f;
+    sort_units_.set_arena(f->arena());
+    commands_.set_arena(f->arena());
+    fvals_.set_arena(f->arena());
+    ivals_.set_arena(f->arena());
+    meshes_.set_arena(f->arena());
+    textures_.set_arena(f->arena());
+    mesh_datas_.set_arena(f->arena());
+  }
 
  private:
-  std::vector<Command> commands_;
-  std::vector<float> fvals_;
-  std::vector<int> ivals_;
-  std::vector<MeshAsset*> meshes_{};
-  std::vector<TextureAsset*> textures_{};
-  std::vector<MeshData*> mesh_datas_{};
+  // Where each independently-sortable chunk of the buffer starts in each
+  // of our streams. A chunk starts with each top-level shader command.
+  struct SortUnit_ {
+    uint32_t commands;
+    uint32_t fvals;
+    uint32_t ivals;
+    uint32_t meshes;
+    uint32_t textures;
+    uint32_t mesh_datas;
+  };
+
+  void TrackSortUnits_(Command c) {
+    switch (c) {
+      case Command::kShader:
+        if (sort_nesting_ == 0) {
+          sort_units_.push_back({static_cast<uint32_t>(commands_.size()),
+                                 static_cast<uint32_t>(fvals_.size()),
+                                 static_cast<uint32_t>(ivals_.size()),
+                                 static_cast<uint32_t>(meshes_.size()),
+                                 static_cast<uint32_t>(textures_.size()),
+                                 static_cast<uint32_t>(mesh_datas_.size())});
+        }
+        break;
+      case Command::kPushTransform:
+      case Command::kScissorPush:
+      case Command::kBeginDebugDrawTriangles:
+      case Command::kBeginDebugDrawLines:
+        sort_nesting_++;
+        break;
+      case Command::kPopTransform:
+      case Command::kScissorPop:
+      case Command::kEndDebugDraw:
+        sort_nesting_--;
+        break;
+      case Command::kTranslate2:
+      case Command::kTranslate3:
+      case Command::kCursorTranslate:
+      case Command::kScaleUniform:
+      case Command::kTranslateToProjectedPoint:
+#if BA_VR_BUILD
+      case Command::kTransformToRightHand:
+      case Command::kTransformToLeftHand:
+      case Command::kTransformToHead:
+#endif
+      case Command::kScale2:
+      case Command::kScale3:
+      case Command::kRotate:
+      case Command::kMultMatrix:
+      case Command::kFlipCullFace:
+        // State changes outside of a push/pop leak into whatever follows,
+        // so we can't move things around.
+        if (sort_nesting_ == 0) {
+          sortable_ = false;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  template <typename T>
+  void ReorderStream_(FrameArenaVector<T>* stream, uint32_t SortUnit_::*field,
+                      const FrameArenaVector<uint32_t>& order);
+
+  // All our storage comes out of our frame-def's arena, so filling
+  // buffers each frame involves no allocations.
+  FrameArenaVector<Command> commands_;
+  FrameArenaVector<float> fvals_;
+  FrameArenaVector<int> ivals_;
+  FrameArenaVector<MeshAsset*> meshes_;
+  FrameArenaVector<TextureAsset*> textures_;
+  FrameArenaVector<MeshData*> mesh_datas_;
+  FrameArenaVector<SortUnit_> sort_units_;
+  int sort_nesting_{};
+  bool sortable_{true};
   unsigned int commands_index_{};
   unsigned int fvals_index_{};
   unsigned int ivals_index_{};
@@ -0,0 +1,43 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_RENDER_PROFILE_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_RENDER_PROFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ballistica::base {
+
+/// Timing for one labeled section of rendering (one group-marker scope in
+/// the renderer).
+struct RenderProfileSection {
+  std::string label;
+  /// Nesting depth; 0 for top level sections.
+  int depth{};
+  float cpu_ms{};
+  /// Negative when the renderer can't measure GPU time.
+  float gpu_ms{-1.0f};
+};
+
+/// Timing breakdown for a frame. Filled in by the logic thread (build
+/// time) and the graphics thread (render time and sections) as the
+/// frame-def passes through them.
+struct RenderProfile {
+  int64_t frame_number{};
+  float build_cpu_ms{};
+  float render_cpu_ms{};
+  /// Renderers read GPU results back a few frames late to avoid stalling,
+  /// so these generally describe an earlier frame than frame_number.
+  std::vector<RenderProfileSection> sections;
+
+  void Reset() {
+    frame_number = 0;
+    build_cpu_ms = render_cpu_ms = 0.0f;
+    sections.clear();
+  }
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_RENDER_PROFILE_H_
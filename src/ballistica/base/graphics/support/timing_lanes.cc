@@ -0,0 +1,171 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/timing_lanes.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "ballistica/base/graphics/component/simple_component.h"
+#include "ballistica/base/graphics/mesh/image_mesh.h"
+#include "ballistica/base/graphics/mesh/mesh_indexed_simple_full.h"
+#include "ballistica/base/graphics/text/text_group.h"
+
+namespace ballistica::base {
+
+const int kTimingLaneCount{static_cast<int>(TimingLane::kLast)};
+
+struct TimingLaneInfo {
+  const char* label;
+  float r, g, b;
+};
+
+// Keep these in the same order as TimingLane.
+const TimingLaneInfo kTimingLaneInfos[kTimingLaneCount] = {
+    {"logic update ms", 0.3f, 0.6f, 1.0f},
+    {"bg-dynamics step ms", 0.6f, 0.4f, 1.0f},
+    {"render cpu ms", 0.2f, 1.0f, 0.3f},
+    {"render gpu ms", 0.8f, 1.0f, 0.2f},
+    {"packets in/s", 1.0f, 0.6f, 0.2f},
+    {"packets out/s", 1.0f, 0.4f, 0.4f},
+    {"jitter buffer ms", 0.3f, 1.0f, 1.0f},
+    {"input latency ms", 1.0f, 1.0f, 1.0f},
+};
+
+class TimingLanes::Impl {
+ public:
+  float values[kTimingLaneCount]{};
+  float samples[kTimingLanesSampleCount][kTimingLaneCount]{};
+  int next_sample{};
+  int sample_count{};
+  float v_max_smoothed[kTimingLaneCount]{};
+  ImageMesh bg_mesh;
+  MeshIndexedSimpleFull value_meshes[kTimingLaneCount];
+  TextGroup value_texts[kTimingLaneCount];
+  std::string value_strings[kTimingLaneCount];
+};
+
+TimingLanes::TimingLanes() : impl_(new TimingLanes::Impl()) {
+  for (auto& v : impl_->v_max_smoothed) {
+    v = 1.0f;
+  }
+}
+
+TimingLanes::~TimingLanes() = default;
+
+void TimingLanes::SetValue(TimingLane lane, float value) {
+  assert(lane < TimingLane::kLast);
+  impl_->values[static_cast<int>(lane)] = value;
+}
+
+void TimingLanes::AddSample() {
+  std::copy(impl_->values, impl_->values + kTimingLaneCount,
+            impl_->samples[impl_->next_sample]);
+  impl_->next_sample = (impl_->next_sample + 1) % kTimingLanesSampleCount;
+  impl_->sample_count =
+      std::min(impl_->sample_count + 1, kTimingLanesSampleCount);
+}
+
+void TimingLanes::Draw(RenderPass* pass, float x, float y, float width,
+                       float lane_height) {
+  auto& impl{*impl_};
+  int count = impl.sample_count;
+  int first = (impl.next_sample - count + kTimingLanesSampleCount)
+              % kTimingLanesSampleCount;
+  float graph_height = lane_height * 0.8f;
+  float x_step = width / static_cast<float>(kTimingLanesSampleCount - 1);
+
+  // Newest samples sit at the right edge.
+  float x_left =
+      x + x_step * static_cast<float>(kTimingLanesSampleCount - count);
+
+  impl.bg_mesh.SetPositionAndSize(x, y, 0.0f, width,
+                                  lane_height * kTimingLaneCount);
+
+  SimpleComponent c(pass);
+  c.SetTransparent(true);
+  c.SetColor(0.0f, 0.0f, 0.0f, 0.6f);
+  c.DrawMesh(&impl.bg_mesh);
+  for (int lane = 0; lane < kTimingLaneCount && count >= 2; ++lane) {
+    // Ease our scale towards the lane's current max so steady lanes
+    // fill their space without jumping around at every spike.
+    float v_max{};
+    for (int i = 0; i < count; ++i) {
+      v_max = std::max(
+          v_max, impl.samples[(first + i) % kTimingLanesSampleCount][lane]);
+    }
+    auto& v_max_smoothed{impl.v_max_smoothed[lane]};
+    v_max_smoothed = 0.95f * v_max_smoothed + 0.05f * v_max * 1.1f;
+    float v_scale = graph_height / std::max(v_max_smoothed, 0.001f);
+
+    // Two verts per sample and two tris between each neighboring pair.
+    float lane_y = y + lane_height * static_cast<float>(lane);
+    auto vertex_buffer(Object::New<MeshBuffer<VertexSimpleFull>>(count * 2));
+    VertexSimpleFull* v = vertex_buffer->elements.data();
+    for (int i = 0; i < count; ++i) {
+      float vx = x_left + x_step * static_cast<float>(i);
+      float vy = lane_y
+                 + std::min(graph_height,
+                            impl.samples[(first + i) % kTimingLanesSampleCount]
+                                        [lane]
+                                * v_scale);
+      v->position[0] = vx;
+      v->position[1] = lane_y;
+      v->position[2] = 0.0f;
+      v->uv[0] = v->uv[1] = 0;
+      v++;
+      v->position[0] = vx;
+      v->position[1] = vy;
+      v->position[2] = 0.0f;
+      v->uv[0] = v->uv[1] = 0;
+      v++;
+    }
+    auto index_buffer(Object::New<MeshIndexBuffer16>((count - 1) * 6));
+    uint16_t* i = index_buffer->elements.data();
+    for (int s = 0; s < count - 1; ++s) {
+      int v_count = s * 2;
+      *i++ = static_cast_check_fit<uint16_t>(v_count);
+      *i++ = static_cast_check_fit<uint16_t>(v_count + 2);
+      *i++ = static_cast_check_fit<uint16_t>(v_count + 1);
+      *i++ = static_cast_check_fit<uint16_t>(v_count + 2);
+      *i++ = static_cast_check_fit<uint16_t>(v_count + 3);
+      *i++ = static_cast_check_fit<uint16_t>(v_count + 1);
+    }
+    auto& mesh{impl.value_meshes[lane]};
+    mesh.SetIndexData(index_buffer);
+    mesh.SetData(vertex_buffer);
+    auto& info{kTimingLaneInfos[lane]};
+    c.SetColor(info.r, info.g, info.b, 0.7f);
+    c.DrawMesh(&mesh);
+  }
+  c.Submit();
+
+  // Labels with each lane's latest value.
+  SimpleComponent c2(pass);
+  c2.SetTransparent(true);
+  c2.SetFlatness(1.0f);
+  float text_scale = lane_height * 0.005f;
+  for (int lane = 0; lane < kTimingLaneCount; ++lane) {
+    auto& info{kTimingLaneInfos[lane]};
+    char val_str[64];
+    snprintf(val_str, sizeof(val_str), "%s %.2f", info.label,
+             impl.values[lane]);
+    auto& text{impl.value_texts[lane]};
+    if (impl.value_strings[lane] != val_str) {
+      impl.value_strings[lane] = val_str;
+      text.SetText(val_str, TextMesh::HAlign::kLeft, TextMesh::VAlign::kTop);
+    }
+    c2.SetColor(info.r, info.g, info.b, 1.0f);
+    auto xf = c2.ScopedTransform();
+    c2.Translate(x + 4.0f, y + lane_height * static_cast<float>(lane + 1));
+    c2.Scale(text_scale, text_scale);
+    int text_elem_count = text.GetElementCount();
+    for (int e = 0; e < text_elem_count; e++) {
+      c2.SetTexture(text.GetElementTexture(e));
+      c2.DrawMesh(text.GetElementMesh(e));
+    }
+  }
+  c2.Submit();
+}
+
+}  // namespace ballistica::base
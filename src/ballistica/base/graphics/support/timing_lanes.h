@@ -0,0 +1,55 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_TIMING_LANES_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_TIMING_LANES_H_
+
+#include <memory>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// How many frames of samples our timing lanes show.
+const int kTimingLanesSampleCount{240};
+
+enum class TimingLane : uint8_t {
+  kLogicUpdate,
+  kBGDynamicsStep,
+  kRenderCPU,
+  kRenderGPU,
+  kPacketsIn,
+  kPacketsOut,
+  kJitterBuffer,
+  kInputLatency,
+  kLast,
+};
+
+/// A stack of live graphs, one lane per subsystem (logic updates,
+/// bg-dynamics steps, render cpu/gpu time, connection packet rates, client
+/// jitter-buffer depth and input-to-screen latency), all sampled together
+/// once per frame into a shared ring so a hitch in one can be lined up
+/// against the others.
+/// Subsystems just set their lane's latest value whenever they have one;
+/// lanes without a new value hold their last one. Logic thread only.
+class TimingLanes {
+ public:
+  TimingLanes();
+  ~TimingLanes();
+
+  void SetValue(TimingLane lane, float value);
+
+  /// Record the current value of every lane as one sample.
+  void AddSample();
+
+  /// Draw our lanes stacked upward from x,y.
+  void Draw(RenderPass* pass, float x, float y, float width,
+            float lane_height);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_TIMING_LANES_H_
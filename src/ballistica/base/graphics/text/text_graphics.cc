@@ -1067,6 +1067,18 @@ void TextGraphics::GetOSTextSpanBoundsAndWidth(const std::string& s, Rect* r,
 }
 
 auto TextGraphics::GetStringWidth(const char* text, bool big) -> float {
+  // Key on the big flag as well as the text.
+  std::string key(big ? "1" : "0");
+  key += text;
+  if (const float* width = string_width_cache_.Find(key)) {
+    return *width;
+  }
+  float width = CalcStringWidth_(text, big);
+  string_width_cache_.Store(key, width);
+  return width;
+}
+
+auto TextGraphics::CalcStringWidth_(const char* text, bool big) -> float {
   assert(Utils::IsValidUTF8(text));
 
   // even if they ask for the big font, their string might not support it...
@@ -1143,6 +1155,19 @@ auto TextGraphics::GetStringHeight(const char* text) -> float {
 
 void TextGraphics::BreakUpString(const char* text, float width,
                                  std::vector<std::string>* v) {
+  // Key on the exact bits of the width as well as the text.
+  std::string key(reinterpret_cast<const char*>(&width), sizeof(width));
+  key += text;
+  if (auto* lines = broken_up_string_cache_.Find(key)) {
+    *v = *lines;
+    return;
+  }
+  CalcBrokenUpString_(text, width, v);
+  broken_up_string_cache_.Store(key, *v);
+}
+
+void TextGraphics::CalcBrokenUpString_(const char* text, float width,
+                                       std::vector<std::string>* v) {
   assert(Utils::IsValidUTF8(text));
   v->clear();
   std::vector<char> buffer_(strlen(text) + 1);
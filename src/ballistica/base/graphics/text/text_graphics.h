@@ -8,6 +8,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "ballistica/shared/foundation/object.h"
@@ -91,6 +92,51 @@ class TextGraphics {
 
  private:
   class TextSpanBoundsCacheEntry;
+
+  // A small least-recently-used cache of layout results keyed by string.
+  template <typename T>
+  class LayoutCache_ {
+   public:
+    explicit LayoutCache_(size_t max_size) : max_size_(max_size) {}
+
+    auto Find(const std::string& key) -> const T* {
+      auto i = entries_.find(key);
+      if (i == entries_.end()) {
+        return nullptr;
+      }
+      lru_.splice(lru_.end(), lru_, i->second.lru_position);
+      return &i->second.value;
+    }
+
+    void Store(const std::string& key, T value) {
+      auto i = entries_.find(key);
+      if (i != entries_.end()) {
+        i->second.value = std::move(value);
+        lru_.splice(lru_.end(), lru_, i->second.lru_position);
+        return;
+      }
+      auto& entry{entries_[key]};
+      entry.value = std::move(value);
+      entry.lru_position = lru_.insert(lru_.end(), key);
+      while (lru_.size() > max_size_) {
+        entries_.erase(lru_.front());
+        lru_.pop_front();
+      }
+    }
+
+   private:
+    struct Entry_ {
+      T value{};
+      std::list<std::string>::iterator lru_position;
+    };
+    std::unordered_map<std::string, Entry_> entries_;
+    std::list<std::string> lru_;
+    size_t max_size_;
+  };
+
+  auto CalcStringWidth_(const char* s, bool big) -> float;
+  void CalcBrokenUpString_(const char* text, float width,
+                           std::vector<std::string>* v);
   void LoadGlyphPage(uint32_t index);
 
   // Map of entries for fast lookup.
@@ -99,6 +145,11 @@ class TextGraphics {
 
   // List of entries for sorting by last-use-time
   std::list<Object::Ref<TextSpanBoundsCacheEntry> > text_span_bounds_cache_;
+
+  // UI and scene text ask for the same few strings over and over
+  // (scoreboards, counters, etc.) so we remember recent answers.
+  LayoutCache_<float> string_width_cache_{500};
+  LayoutCache_<std::vector<std::string> > broken_up_string_cache_{100};
   std::mutex glyph_load_mutex_;
   Glyph glyphs_extras_[100]{};
   Glyph glyphs_big_[64]{};
@@ -2,6 +2,8 @@
 
 #include "ballistica/base/graphics/text/text_group.h"
 
+#include <cstdio>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -14,11 +16,57 @@
 
 namespace ballistica::base {
 
+auto TextGroup::GetFontPageTexture_(int page) -> Object::Ref<TextureAsset> {
+  // Only the first page (ascii/latin) is kept around permanently; the rest
+  // get loaded on the assets thread the first time some text needs them.
+  // Entries hold refs so pages stay resident while in use.
+  char name[32];
+  snprintf(name, sizeof(name), "fontSmall%d", page);
+  Assets::AssetListLock lock;
+  return g_base->assets->GetTexture(name);
+}
+
 void TextGroup::SetText(const std::string& text, TextMesh::HAlign alignment_h,
                         TextMesh::VAlign alignment_v, bool big,
                         float resolution_scale) {
+  // Text nodes and widgets tend to get re-set to the same thing constantly;
+  // skip all the work in that case.
+  if (built_ && text == text_ && big == big_requested_
+      && alignment_h == alignment_h_ && alignment_v == alignment_v_
+      && resolution_scale == resolution_scale_) {
+    return;
+  }
+  built_ = true;
+  big_requested_ = big;
+  alignment_h_ = alignment_h;
+  alignment_v_ = alignment_v;
+  resolution_scale_ = resolution_scale;
   text_ = text;
 
+  // Hang on to our existing entries by font page so we can rebuild their
+  // meshes in place instead of making new ones; the renderer then just
+  // updates its existing buffers (and skips index uploads entirely when
+  // the glyph count hasn't changed). OS-rendered entries always start
+  // fresh since they need their text-packer filled in.
+  std::map<int, std::unique_ptr<TextMeshEntry>> old_entries;
+  for (auto&& entry : entries_) {
+    if (entry->type != TextMeshEntryType::kOSRendered) {
+      old_entries[entry->page] = std::move(entry);
+    }
+  }
+  entries_.clear();
+  auto take_entry = [&old_entries](int page) {
+    auto i = old_entries.find(page);
+    if (i == old_entries.end()) {
+      auto entry = std::make_unique<TextMeshEntry>();
+      entry->page = page;
+      return entry;
+    }
+    auto entry = std::move(i->second);
+    old_entries.erase(i);
+    return entry;
+  };
+
   // In order to *actually* draw big, all our letters
   // must be available in the big font.
   big_ = (big && TextGraphics::HaveBigChars(text));
@@ -30,9 +78,8 @@ void TextGroup::SetText(const std::string& text, TextMesh::HAlign alignment_h,
 
   // If we're drawing big we always just need 1 font page (the big one).
   if (big_) {
-    // Now create entries for each page we use.
-    entries_.clear();
-    std::unique_ptr<TextMeshEntry> entry(new TextMeshEntry());
+    std::unique_ptr<TextMeshEntry> entry = take_entry(-1);
+    entry->type = TextMeshEntryType::kRegular;
     entry->u_scale = entry->v_scale = 1.5f;
     entry->can_color = true;
     entry->max_flatness = 1.0f;
@@ -52,11 +99,14 @@ void TextGroup::SetText(const std::string& text, TextMesh::HAlign alignment_h,
     // (we iterate this in reverse so that our custom pages draw first;
     // we want that stuff to show up underneath normal text since we
     // sometimes use it as backing elements,etc)
-    entries_.clear();
     for (auto i = font_pages.rbegin(); i != font_pages.rend(); i++) {
       uint32_t min, max;
       g_base->text_graphics->GetFontPageCharRange(*i, &min, &max);
-      std::unique_ptr<TextMeshEntry> entry(new TextMeshEntry());
+      std::unique_ptr<TextMeshEntry> entry =
+          *i == static_cast<int>(TextGraphics::FontPage::kOSRendered)
+              ? std::make_unique<TextMeshEntry>()
+              : take_entry(*i);
+      entry->page = *i;
 
       // Our custom font page IDs start at value 9990 (kExtras1);
       // make sure for all private-use unicode chars (U+E000–U+F8FF)
@@ -132,25 +182,13 @@ void TextGroup::SetText(const std::string& text, TextMesh::HAlign alignment_h,
           entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall0);
           break;
         case 1:
-          entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall1);
-          break;
         case 2:
-          entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall2);
-          break;
         case 3:
-          entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall3);
-          break;
         case 4:
-          entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall4);
-          break;
         case 5:
-          entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall5);
-          break;
         case 6:
-          entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall6);
-          break;
         case 7:
-          entry->tex = g_base->assets->SysTexture(SysTextureID::kFontSmall7);
+          entry->tex = GetFontPageTexture_(*i);
           break;
         case static_cast<int>(TextGraphics::FontPage::kOSRendered):
           entry->tex = os_texture_;
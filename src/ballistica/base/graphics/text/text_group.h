@@ -75,7 +75,10 @@ class TextGroup : public Object {
                    float* carat_y);
 
  private:
+  static auto GetFontPageTexture_(int page) -> Object::Ref<TextureAsset>;
+
   struct TextMeshEntry {
+    int page;
     TextMeshEntryType type;
     Object::Ref<TextureAsset> tex;
     TextMesh mesh;
@@ -88,6 +91,14 @@ class TextGroup : public Object {
   std::vector<std::unique_ptr<TextMeshEntry>> entries_;
   std::string text_;
   bool big_{};
+
+  // What our current entries were built from, so we can skip rebuilding
+  // for repeat requests.
+  bool built_{};
+  bool big_requested_{};
+  TextMesh::HAlign alignment_h_{};
+  TextMesh::VAlign alignment_v_{};
+  float resolution_scale_{};
 };
 
 }  // namespace ballistica::base
@@ -6,6 +6,7 @@
 #include <cstdio>
 #include <string>
 
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/core/platform/core_platform.h"
 
 /* DDS loader written by Jon Watte 2002 */
@@ -37,15 +38,15 @@ void LoadDDS(const std::string& file_name, unsigned char** buffers, int* widths,
              TextureQuality texture_quality, int min_quality, int* base_level) {
   (*base_level) = 0;
 
-  FILE* f = g_core->platform->FOpen(file_name.c_str(), "rb");
-  if (!f) {
+  AssetFile f(file_name);
+  if (!f.is_open()) {
     throw Exception("can't open file: \"" + file_name + "\"");
   }
 
   DDS_header hdr{};
 
   //  DDS is so simple to read, too
-  BA_PRECONDITION(fread(&hdr, sizeof(hdr), 1, f) == 1);
+  BA_PRECONDITION(f.Read(&hdr, sizeof(hdr), 1) == 1);
   BA_PRECONDITION(hdr.dwMagic == DDS_MAGIC);
   BA_PRECONDITION(hdr.dwSize == 124);
 
@@ -69,7 +70,7 @@ void LoadDDS(const std::string& file_name, unsigned char** buffers, int* widths,
   } else if (PF_IS_EXTENDED(hdr.sPixelFormat)) {
     DDS_header_DX10 hExt;
 
-    BA_PRECONDITION(fread(&hExt, sizeof(hExt), 1, f) == 1);
+    BA_PRECONDITION(f.Read(&hExt, sizeof(hExt), 1) == 1);
 
     // Format should be unknown.
     // Hmmm we have no way of determining that this is etc1 data so we just
@@ -117,12 +118,12 @@ void LoadDDS(const std::string& file_name, unsigned char** buffers, int* widths,
         widths[ix] = static_cast<int>(x);
         heights[ix] = static_cast<int>(y);
         formats[ix] = li->internal_format;
-        BA_PRECONDITION(fread(buffers[ix], size, 1, f) == 1);
+        BA_PRECONDITION(f.Read(buffers[ix], size, 1) == 1);
       } else {
         buffers[ix] = nullptr;
-        BA_PRECONDITION(fseek(f, static_cast_check_fit<long>(size),  // NOLINT
-                              SEEK_CUR)
-                        == 0);
+        BA_PRECONDITION(
+            f.Seek(static_cast_check_fit<long>(size), SEEK_CUR)  // NOLINT
+            == 0);
       }
 
       x = (x + 1u) >> 1u;
@@ -135,7 +136,6 @@ void LoadDDS(const std::string& file_name, unsigned char** buffers, int* widths,
   } else {
     throw Exception("regular tex dds support disabled");
   }
-  fclose(f);
 }
 
 }  // namespace ballistica::base
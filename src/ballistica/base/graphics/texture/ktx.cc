@@ -2,8 +2,14 @@
 
 #include "ballistica/base/graphics/texture/ktx.h"
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/foundation/job_system.h"
 
 namespace ballistica::base {
 
@@ -57,12 +63,12 @@ typedef struct KTX_header_t {
 void LoadKTX(const std::string& file_name, unsigned char** buffers, int* widths,
              int* heights, TextureFormat* formats, size_t* sizes,
              TextureQuality texture_quality, int min_quality, int* base_level) {
-  FILE* f = g_core->platform->FOpen(file_name.c_str(), "rb");
-  if (!f) throw Exception("can't open file: \"" + file_name + "\"");
+  AssetFile f(file_name);
+  if (!f.is_open()) throw Exception("can't open file: \"" + file_name + "\"");
 
   KTX_header_t header{};
   static_assert(sizeof(header) == KTX_HEADER_SIZE);
-  BA_PRECONDITION(fread(&header, sizeof(header), 1, f) == 1);
+  BA_PRECONDITION(f.Read(&header, sizeof(header), 1) == 1);
 
   // Make some assumptions; we don't support arrays, more than 1 face, or kv
   // data of any form.
@@ -114,7 +120,7 @@ void LoadKTX(const std::string& file_name, unsigned char** buffers, int* widths,
   }
 
   for (uint32_t level = 0; level < header.numberOfMipmapLevels; ++level) {
-    if (fread(&size, sizeof(size), 1, f) != 1)
+    if (f.Read(&size, sizeof(size), 1) != 1)
       throw Exception("Error reading texture: '" + file_name + "'");
     sizeRounded = (size + 3) & ~(uint32_t)3;
     BA_PRECONDITION(
@@ -127,16 +133,15 @@ void LoadKTX(const std::string& file_name, unsigned char** buffers, int* widths,
       widths[level] = static_cast<uint32_t>(x);
       heights[level] = static_cast<uint32_t>(y);
       formats[level] = internal_format;
-      BA_PRECONDITION(fread(buffers[level], size, 1, f) == 1);
+      BA_PRECONDITION(f.Read(buffers[level], size, 1) == 1);
     } else {
       buffers[level] = nullptr;
-      BA_PRECONDITION(fseek(f, static_cast_check_fit<long>(size), SEEK_CUR)
+      BA_PRECONDITION(f.Seek(static_cast_check_fit<long>(size), SEEK_CUR)
                       == 0);
     }
     x = (x + 1) >> 1;
     y = (y + 1) >> 1;
   }
-  fclose(f);
 }
 
 /**
@@ -2043,8 +2048,6 @@ void KTXUnpackETC(const GLubyte* srcETC, const GLenum srcFormat,
                   GLubyte** dstImage, GLenum* format, GLenum* internal_format,
                   GLenum* type, GLint R16Formats, bool supportsSRGB) {
   unsigned int width, height;
-  unsigned int block_part1, block_part2;
-  unsigned int x, y;
   /*const*/ auto* src = (GLubyte*)srcETC;
   // AF_11BIT is used to compress R11 & RG11 though its not alpha data.
   enum { AF_NONE, AF_1BIT, AF_8BIT, AF_11BIT } alphaFormat = AF_NONE;
@@ -2189,7 +2192,12 @@ void KTXUnpackETC(const GLubyte* srcETC, const GLenum srcFormat,
     // return KTX_OUT_OF_MEMORY;
   }
 
-  if (alphaFormat != AF_NONE) setupAlphaTable();
+  // Multiple asset threads can land here at once; build the shared alpha
+  // table exactly once so it is read-only by the time any decoding runs.
+  if (alphaFormat != AF_NONE) {
+    static std::once_flag alpha_table_once;
+    std::call_once(alpha_table_once, setupAlphaTable);
+  }
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "ConstantConditionsOC"
@@ -2215,27 +2223,48 @@ void KTXUnpackETC(const GLubyte* srcETC, const GLenum srcFormat,
     //      }
     //    }
   } else {
-    for (y = 0; y < height / 4; y++) {
-      for (x = 0; x < width / 4; x++) {
-        // Decode alpha channel for RGBA
-        if (alphaFormat == AF_8BIT) {
-          decompressBlockAlphaC(src, *dstImage + 3, width, height, 4 * x, 4 * y,
-                                dstChannels);
-          src += 8;
+    // Each block writes only its own 4x4 pixels and every block row starts
+    // at a fixed offset in the source, so rows of blocks can be decoded
+    // independently; spread them across the job system.
+    unsigned int blocks_x = width / 4;
+    unsigned int blocks_y = height / 4;
+    size_t block_bytes = (alphaFormat == AF_8BIT) ? 16 : 8;
+    size_t src_row_bytes = blocks_x * block_bytes;
+    GLubyte* dst = *dstImage;
+    auto decode_rows = [=](size_t row_begin, size_t row_end) {
+      unsigned int part1, part2;
+      for (size_t by = row_begin; by < row_end; by++) {
+        const GLubyte* s = src + by * src_row_bytes;
+        int py = static_cast<int>(4 * by);
+        for (unsigned int bx = 0; bx < blocks_x; bx++) {
+          int px = static_cast<int>(4 * bx);
+          // Decode alpha channel for RGBA
+          if (alphaFormat == AF_8BIT) {
+            decompressBlockAlphaC(const_cast<GLubyte*>(s), dst + 3, width,
+                                  height, px, py, dstChannels);
+            s += 8;
+          }
+          // Decode color dstChannels
+          readBigEndian4byteWord(&part1, s);
+          s += 4;
+          readBigEndian4byteWord(&part2, s);
+          s += 4;
+          if (alphaFormat == AF_1BIT)
+            decompressBlockETC21BitAlphaC(part1, part2, dst, nullptr, width,
+                                          height, px, py, dstChannels);
+          else
+            decompressBlockETC2c(part1, part2, dst, width, height, px, py,
+                                 dstChannels);
         }
-        // Decode color dstChannels
-        readBigEndian4byteWord(&block_part1, src);
-        src += 4;
-        readBigEndian4byteWord(&block_part2, src);
-        src += 4;
-        if (alphaFormat == AF_1BIT)
-          decompressBlockETC21BitAlphaC(block_part1, block_part2, *dstImage,
-                                        nullptr, width, height, 4 * x, 4 * y,
-                                        dstChannels);
-        else
-          decompressBlockETC2c(block_part1, block_part2, *dstImage, width,
-                               height, 4 * x, 4 * y, dstChannels);
       }
+    };
+    // Aim for at least 256 blocks (4k pixels) per chunk; below that the
+    // scheduling overhead outweighs the decode itself.
+    size_t min_rows = std::max(size_t{1}, size_t{256} / std::max(blocks_x, 1u));
+    if (g_core && g_core->job_system) {
+      g_core->job_system->ParallelFor(blocks_y, min_rows, decode_rows);
+    } else {
+      decode_rows(0, blocks_y);
     }
   }
 
@@ -2250,8 +2279,7 @@ void KTXUnpackETC(const GLubyte* srcETC, const GLenum srcFormat,
     int dstRowBytes = dstPixelBytes * width;
     int activeRowBytes = activeWidth * dstPixelBytes;
     auto* newimg = (GLubyte*)malloc(dstPixelBytes * activeWidth * activeHeight);
-    unsigned int xx, yy;
-    int zz;
+    unsigned int yy;
 
     if (!newimg) {
       free(*dstImage);
@@ -2261,14 +2289,11 @@ void KTXUnpackETC(const GLubyte* srcETC, const GLenum srcFormat,
 
     /* Convert from total area to active area: */
 
+    // Active pixels in a row are contiguous, so copy whole rows at a time
+    // and let memcpy use wide loads instead of going byte by byte.
     for (yy = 0; yy < activeHeight; yy++) {
-      for (xx = 0; xx < activeWidth; xx++) {
-        for (zz = 0; zz < dstPixelBytes; zz++) {
-          // NOLINTNEXTLINE
-          newimg[yy * activeRowBytes + xx * dstPixelBytes + zz] =
-              (*dstImage)[yy * dstRowBytes + xx * dstPixelBytes + zz];
-        }
-      }
+      memcpy(newimg + yy * activeRowBytes, *dstImage + yy * dstRowBytes,
+             activeRowBytes);
     }
 
     free(*dstImage);
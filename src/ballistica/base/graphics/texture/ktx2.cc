@@ -0,0 +1,176 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/texture/ktx2.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "ballistica/base/assets/asset_archive.h"
+#include "ballistica/base/assets/texture_asset_preload_data.h"
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// The handful of Vulkan format values we map onto our own formats; KTX2
+// identifies its payloads by these.
+const uint32_t kVkFormatUndefined = 0;
+const uint32_t kVkFormatR8G8B8Unorm = 23;
+const uint32_t kVkFormatR8G8B8A8Unorm = 37;
+const uint32_t kVkFormatBC1RGBUnormBlock = 131;
+const uint32_t kVkFormatBC1RGBAUnormBlock = 133;
+const uint32_t kVkFormatBC3UnormBlock = 137;
+const uint32_t kVkFormatETC2R8G8B8UnormBlock = 147;
+const uint32_t kVkFormatETC2R8G8B8A8UnormBlock = 151;
+
+// Supercompression schemes defined by the KTX2 spec.
+const uint32_t kKTX2SupercompressionNone = 0;
+const uint32_t kKTX2SupercompressionBasisLZ = 1;
+
+struct KTX2Header {
+  uint8_t identifier[12];
+  uint32_t vk_format;
+  uint32_t type_size;
+  uint32_t pixel_width;
+  uint32_t pixel_height;
+  uint32_t pixel_depth;
+  uint32_t layer_count;
+  uint32_t face_count;
+  uint32_t level_count;
+  uint32_t supercompression_scheme;
+  uint32_t dfd_byte_offset;
+  uint32_t dfd_byte_length;
+  uint32_t kvd_byte_offset;
+  uint32_t kvd_byte_length;
+  uint64_t sgd_byte_offset;
+  uint64_t sgd_byte_length;
+};
+static_assert(sizeof(KTX2Header) == 80);
+
+struct KTX2LevelIndex {
+  uint64_t byte_offset;
+  uint64_t byte_length;
+  uint64_t uncompressed_byte_length;
+};
+static_assert(sizeof(KTX2LevelIndex) == 24);
+
+static auto TextureFormatForVkFormat(uint32_t vk_format) -> TextureFormat {
+  switch (vk_format) {
+    case kVkFormatR8G8B8Unorm:
+      return TextureFormat::kRGB_888;
+    case kVkFormatR8G8B8A8Unorm:
+      return TextureFormat::kRGBA_8888;
+    case kVkFormatBC1RGBUnormBlock:
+    case kVkFormatBC1RGBAUnormBlock:
+      return TextureFormat::kDXT1;
+    case kVkFormatBC3UnormBlock:
+      return TextureFormat::kDXT5;
+    case kVkFormatETC2R8G8B8UnormBlock:
+      return TextureFormat::kETC2_RGB;
+    case kVkFormatETC2R8G8B8A8UnormBlock:
+      return TextureFormat::kETC2_RGBA;
+    default:
+      return TextureFormat::kNone;
+  }
+}
+
+void LoadKTX2(const std::string& file_name, unsigned char** buffers,
+              int* widths, int* heights, TextureFormat* formats, size_t* sizes,
+              TextureQuality texture_quality, int min_quality,
+              int* base_level) {
+  static const uint8_t kIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                          0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+  AssetFile f(file_name);
+  if (!f.is_open()) {
+    throw Exception("can't open file: \"" + file_name + "\"");
+  }
+
+  KTX2Header header{};
+  BA_PRECONDITION(f.Read(&header, sizeof(header), 1) == 1);
+  if (memcmp(header.identifier, kIdentifier, sizeof(kIdentifier)) != 0) {
+    throw Exception("invalid KTX2 file: \"" + file_name + "\"");
+  }
+
+  // Basis payloads need a transcoder to turn them into something a GPU
+  // can use; we don't ship one, so call these out clearly instead of
+  // failing somewhere down the line.
+  if (header.vk_format == kVkFormatUndefined
+      || header.supercompression_scheme == kKTX2SupercompressionBasisLZ) {
+    throw Exception("Basis Universal KTX2 textures are not supported: \""
+                    + file_name + "\"");
+  }
+  if (header.supercompression_scheme != kKTX2SupercompressionNone) {
+    throw Exception("Unsupported KTX2 supercompression scheme "
+                    + std::to_string(header.supercompression_scheme) + ": \""
+                    + file_name + "\"");
+  }
+
+  TextureFormat internal_format = TextureFormatForVkFormat(header.vk_format);
+  if (internal_format == TextureFormat::kNone) {
+    throw Exception("Unsupported KTX2 vkFormat "
+                    + std::to_string(header.vk_format) + ": \"" + file_name
+                    + "\"");
+  }
+
+  // As with our other loaders, we only do plain 2d textures; cube maps
+  // come in as 6 separate files.
+  BA_PRECONDITION(header.pixel_width > 0 && header.pixel_height > 0
+                  && header.pixel_depth == 0);
+  BA_PRECONDITION(header.layer_count == 0);
+  BA_PRECONDITION(header.face_count == 1);
+
+  // A level count of 0 means 'generate mips at load time'; we always do
+  // that for uncompressed stuff anyway, so just treat it as 1.
+  uint32_t level_count = std::max(header.level_count, 1u);
+  BA_PRECONDITION(level_count <= kMaxTextureLevels);
+
+  KTX2LevelIndex levels[kMaxTextureLevels]{};
+  BA_PRECONDITION(f.Read(levels, sizeof(KTX2LevelIndex), level_count)
+                  == level_count);
+
+  (*base_level) = 0;
+
+  // Try dropping a level for med/low quality.
+  if ((texture_quality == TextureQuality::kLow
+       || texture_quality == TextureQuality::kMedium)
+      && (min_quality < 2)
+      && static_cast<int>(level_count) >= (*base_level) + 2) {
+    (*base_level)++;
+  }
+
+  // And one more for low in some cases.
+  if (texture_quality == TextureQuality::kLow && (min_quality < 1)
+      && (header.pixel_width > 128) && (header.pixel_height > 128)
+      && static_cast<int>(level_count) >= (*base_level) + 2) {
+    (*base_level)++;
+  }
+
+  int x = static_cast_check_fit<int>(header.pixel_width);
+  int y = static_cast_check_fit<int>(header.pixel_height);
+  for (uint32_t level = 0; level < level_count; ++level) {
+    if ((*base_level) <= static_cast<int>(level)) {
+      size_t size = static_cast_check_fit<size_t>(levels[level].byte_length);
+      BA_PRECONDITION(size > 0);
+      sizes[level] = size;
+      buffers[level] = static_cast<unsigned char*>(malloc(size));
+      BA_PRECONDITION(buffers[level]);
+      widths[level] = x;
+      heights[level] = y;
+      formats[level] = internal_format;
+      BA_PRECONDITION(
+          f.Seek(static_cast_check_fit<long>(levels[level].byte_offset),
+                 SEEK_SET)
+          == 0);
+      BA_PRECONDITION(f.Read(buffers[level], size, 1) == 1);
+    } else {
+      buffers[level] = nullptr;
+    }
+    x = std::max(1, x >> 1);
+    y = std::max(1, y >> 1);
+  }
+}
+
+}  // namespace ballistica::base
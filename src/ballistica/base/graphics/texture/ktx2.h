@@ -0,0 +1,23 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_TEXTURE_KTX2_H_
+#define BALLISTICA_BASE_GRAPHICS_TEXTURE_KTX2_H_
+
+#include <string>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Load a KTX2 container. Unlike our per-platform .ktx/.dds/.pvr files,
+/// these can hold any of the block formats we know about (or plain
+/// RGB/RGBA), so callers should expect to convert the result if the
+/// current GPU can't take it directly.
+void LoadKTX2(const std::string& file_name, unsigned char** buffers,
+              int* widths, int* heights, TextureFormat* formats, size_t* sizes,
+              TextureQuality texture_quality, int min_quality,
+              int* base_level);
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_TEXTURE_KTX2_H_
@@ -0,0 +1,288 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/texture/lz4tex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/assets/asset_archive.h"
+#include "ballistica/base/assets/texture_asset_preload_data.h"
+#include "ballistica/core/core.h"
+#include "ballistica/shared/foundation/job_system.h"
+
+namespace ballistica::base {
+
+const uint32_t kLZ4TexMagic{0x54345A4C};  // 'LZ4T'
+const uint32_t kLZ4TexVersion{1};
+const uint32_t kLZ4TexFormatRGBA8888{0};
+const uint32_t kLZ4TexFormatRGB888{1};
+const uint32_t kLZ4TexBlockStored{0x80000000u};
+
+// Keeps a bogus header from asking for absurd allocations.
+const uint32_t kLZ4TexMaxBlockSize{16 * 1024 * 1024};
+
+struct LZ4TexHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t format;
+  uint32_t width;
+  uint32_t height;
+  uint32_t level_count;
+  uint32_t block_size;
+};
+static_assert(sizeof(LZ4TexHeader) == 28);
+
+/// Decode a raw LZ4 block, which must come out to exactly dst_size bytes.
+/// Returns false for anything malformed.
+static auto DecodeLZ4Block(const uint8_t* src, size_t src_size, uint8_t* dst,
+                           size_t dst_size) -> bool {
+  const uint8_t* ip = src;
+  const uint8_t* iend = src + src_size;
+  uint8_t* op = dst;
+  uint8_t* oend = dst + dst_size;
+  auto read_length = [&ip, iend](size_t* length) {
+    uint8_t b;
+    do {
+      if (ip == iend) {
+        return false;
+      }
+      b = *ip++;
+      *length += b;
+    } while (b == 255);
+    return true;
+  };
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t literals = token >> 4u;
+    if (literals == 15 && !read_length(&literals)) {
+      return false;
+    }
+    if (static_cast<size_t>(iend - ip) < literals
+        || static_cast<size_t>(oend - op) < literals) {
+      return false;
+    }
+    memcpy(op, ip, literals);
+    ip += literals;
+    op += literals;
+
+    // The last sequence is literals only.
+    if (ip == iend) {
+      break;
+    }
+    if (iend - ip < 2) {
+      return false;
+    }
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8u);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+      return false;
+    }
+    size_t length = token & 15u;
+    if (length == 15 && !read_length(&length)) {
+      return false;
+    }
+    length += 4;
+    if (static_cast<size_t>(oend - op) < length) {
+      return false;
+    }
+    const uint8_t* match = op - offset;
+    if (offset >= length) {
+      memcpy(op, match, length);
+      op += length;
+    } else {
+      // Overlapping matches repeat the pattern; go a byte at a time.
+      for (size_t i = 0; i < length; ++i) {
+        *op++ = *match++;
+      }
+    }
+  }
+  return op == oend;
+}
+
+void LoadLZ4Tex(const std::string& file_name, unsigned char** buffers,
+                int* widths, int* heights, TextureFormat* formats,
+                size_t* sizes, TextureQuality texture_quality,
+                int min_quality, bool reduce_depth, int* base_level) {
+  AssetFile f(file_name);
+  if (!f.is_open()) {
+    throw Exception("can't open file: \"" + file_name + "\"");
+  }
+
+  LZ4TexHeader header{};
+  BA_PRECONDITION(f.Read(&header, sizeof(header), 1) == 1);
+  if (header.magic != kLZ4TexMagic || header.version != kLZ4TexVersion) {
+    throw Exception("invalid lz4tex file: \"" + file_name + "\"");
+  }
+  size_t pixel_size;
+  if (header.format == kLZ4TexFormatRGBA8888) {
+    pixel_size = 4;
+  } else if (header.format == kLZ4TexFormatRGB888) {
+    pixel_size = 3;
+  } else {
+    throw Exception("Unsupported lz4tex format "
+                    + std::to_string(header.format) + ": \"" + file_name
+                    + "\"");
+  }
+  BA_PRECONDITION(header.width > 0 && header.height > 0
+                  && header.width <= 16384 && header.height <= 16384);
+  BA_PRECONDITION(header.level_count > 0
+                  && header.level_count <= kMaxTextureLevels);
+  BA_PRECONDITION(header.block_size > 0
+                  && header.block_size <= kLZ4TexMaxBlockSize
+                  && header.block_size % pixel_size == 0);
+
+  uint32_t level_count = header.level_count;
+  uint32_t block_counts[kMaxTextureLevels]{};
+  BA_PRECONDITION(f.Read(block_counts, sizeof(uint32_t), level_count)
+                  == level_count);
+
+  (*base_level) = 0;
+
+  // Try dropping a level for med/low quality.
+  if ((texture_quality == TextureQuality::kLow
+       || texture_quality == TextureQuality::kMedium)
+      && (min_quality < 2)
+      && static_cast<int>(level_count) >= (*base_level) + 2) {
+    (*base_level)++;
+  }
+
+  // And one more for low in some cases.
+  if (texture_quality == TextureQuality::kLow && (min_quality < 1)
+      && (header.width > 128) && (header.height > 128)
+      && static_cast<int>(level_count) >= (*base_level) + 2) {
+    (*base_level)++;
+  }
+
+  // Read all block sizes, noting where our level's data starts.
+  std::vector<uint32_t> block_sizes;
+  size_t level_block_start{};
+  size_t data_offset{};
+  int x = static_cast<int>(header.width);
+  int y = static_cast<int>(header.height);
+  int level_width{};
+  int level_height{};
+  for (uint32_t level = 0; level < level_count; ++level) {
+    size_t level_size =
+        static_cast<size_t>(x) * static_cast<size_t>(y) * pixel_size;
+    BA_PRECONDITION(block_counts[level]
+                    == (level_size + header.block_size - 1)
+                           / header.block_size);
+    size_t start = block_sizes.size();
+    block_sizes.resize(start + block_counts[level]);
+    BA_PRECONDITION(f.Read(block_sizes.data() + start, sizeof(uint32_t),
+                           block_counts[level])
+                    == block_counts[level]);
+    if (static_cast<int>(level) < (*base_level)) {
+      for (size_t i = start; i < block_sizes.size(); ++i) {
+        data_offset += block_sizes[i] & ~kLZ4TexBlockStored;
+      }
+    } else if (static_cast<int>(level) == (*base_level)) {
+      level_block_start = start;
+      level_width = x;
+      level_height = y;
+    }
+    x = std::max(1, x >> 1);
+    y = std::max(1, y >> 1);
+  }
+  size_t level_blocks = block_counts[*base_level];
+  size_t level_size = static_cast<size_t>(level_width)
+                      * static_cast<size_t>(level_height) * pixel_size;
+  size_t compressed_size{};
+  std::vector<size_t> block_offsets(level_blocks);
+  for (size_t i = 0; i < level_blocks; ++i) {
+    block_offsets[i] = compressed_size;
+    uint32_t block_size = block_sizes[level_block_start + i];
+    BA_PRECONDITION((block_size & ~kLZ4TexBlockStored) <= kLZ4TexMaxBlockSize);
+    compressed_size += block_size & ~kLZ4TexBlockStored;
+  }
+
+  // Pull in the whole level in one go (or just look at it in place if it
+  // lives in a mapped archive).
+  size_t table_size =
+      sizeof(header) + sizeof(uint32_t) * (level_count + block_sizes.size());
+  BA_PRECONDITION(
+      f.Seek(static_cast_check_fit<long>(table_size + data_offset), SEEK_SET)
+      == 0);
+  std::vector<uint8_t> compressed;
+  const uint8_t* src = f.View(compressed_size);
+  if (!src) {
+    compressed.resize(compressed_size);
+    BA_PRECONDITION(compressed_size == 0
+                    || f.Read(compressed.data(), compressed_size, 1) == 1);
+    src = compressed.data();
+  }
+
+  // Work out what we're handing back.
+  TextureFormat format;
+  size_t out_pixel_size;
+  if (reduce_depth) {
+    format = pixel_size == 4 ? TextureFormat::kRGBA_4444
+                             : TextureFormat::kRGB_565;
+    out_pixel_size = 2;
+  } else {
+    format = pixel_size == 4 ? TextureFormat::kRGBA_8888
+                             : TextureFormat::kRGB_888;
+    out_pixel_size = pixel_size;
+  }
+  size_t out_size = level_size / pixel_size * out_pixel_size;
+  auto* out = static_cast<uint8_t*>(malloc(out_size));
+  BA_PRECONDITION(out);
+
+  // Blocks are independent, so decode (and convert) them in parallel.
+  // Converted blocks get decoded to scratch space first since the
+  // converters work in place.
+  auto decode = [&](size_t begin, size_t end) {
+    std::vector<uint8_t> scratch;
+    for (size_t i = begin; i < end; ++i) {
+      size_t offset = i * header.block_size;
+      size_t size = std::min<size_t>(header.block_size, level_size - offset);
+      uint32_t block_size = block_sizes[level_block_start + i];
+      uint8_t* dst = out + offset;
+      if (reduce_depth) {
+        scratch.resize(header.block_size);
+        dst = scratch.data();
+      }
+      const uint8_t* block = src + block_offsets[i];
+      if (block_size & kLZ4TexBlockStored) {
+        if ((block_size & ~kLZ4TexBlockStored) != size) {
+          throw Exception("Invalid lz4tex block.");
+        }
+        memcpy(dst, block, size);
+      } else if (!DecodeLZ4Block(block, block_size, dst, size)) {
+        throw Exception("Invalid lz4tex block.");
+      }
+      if (reduce_depth) {
+        if (pixel_size == 4) {
+          TextureAssetPreloadData::rgba8888_to_rgba4444_in_place(dst, size);
+        } else {
+          TextureAssetPreloadData::rgb888_to_rgb565_in_place(dst, size);
+        }
+        memcpy(out + offset / pixel_size * 2, dst, size / pixel_size * 2);
+      }
+    }
+  };
+  try {
+    if (g_core->job_system) {
+      g_core->job_system->ParallelFor(level_blocks, 1, decode);
+    } else {
+      decode(0, level_blocks);
+    }
+  } catch (const std::exception& e) {
+    free(out);
+    throw Exception("Error loading file '" + file_name + "': " + e.what());
+  }
+
+  for (uint32_t level = 0; level < level_count; ++level) {
+    buffers[level] = nullptr;
+  }
+  buffers[*base_level] = out;
+  sizes[*base_level] = out_size;
+  widths[*base_level] = level_width;
+  heights[*base_level] = level_height;
+  formats[*base_level] = format;
+}
+
+}  // namespace ballistica::base
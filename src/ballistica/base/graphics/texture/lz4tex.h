@@ -0,0 +1,33 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_TEXTURE_LZ4TEX_H_
+#define BALLISTICA_BASE_GRAPHICS_TEXTURE_LZ4TEX_H_
+
+#include <string>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Load an .lz4tex container; uncompressed RGBA or RGB levels split into
+/// independent LZ4 blocks. This is for platforms without usable block
+/// compression, where plain pixels would otherwise mean big disk reads.
+/// Blocks are decoded in parallel, and if reduce_depth is set they get
+/// dithered down to 4444/565 as they are decoded (as we do for textures
+/// decompressed at load time). Only the base level gets loaded since
+/// uncompressed textures get their mips generated on the gpu.
+///
+/// Layout is all little-endian u32s: magic ('LZ4T'), version, pixel
+/// format (0 for RGBA 8888, 1 for RGB 888), width, height, level count,
+/// and block size (uncompressed bytes per block; a multiple of the pixel
+/// size). Then a block count for each level, then a compressed size for
+/// each block of each level (with the high bit set for blocks stored
+/// uncompressed), then all block data in the same order.
+void LoadLZ4Tex(const std::string& file_name, unsigned char** buffers,
+                int* widths, int* heights, TextureFormat* formats,
+                size_t* sizes, TextureQuality texture_quality,
+                int min_quality, bool reduce_depth, int* base_level);
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_TEXTURE_LZ4TEX_H_
@@ -6,6 +6,7 @@
 #include <cstdio>
 #include <string>
 
+#include "ballistica/base/assets/asset_archive.h"
 #include "ballistica/core/platform/core_platform.h"
 
 namespace ballistica::base {
@@ -50,8 +51,8 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
              TextureQuality texture_quality, int min_quality, int* base_level) {
   (*base_level) = 0;
 
-  FILE* f = g_core->platform->FOpen(file_name.c_str(), "rb");
-  if (!f) throw Exception("can't open file: \"" + file_name + "\"");
+  AssetFile f(file_name);
+  if (!f.is_open()) throw Exception("can't open file: \"" + file_name + "\"");
 
   TextureFormat internal_format;
 
@@ -61,7 +62,7 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
   if (explicit_bool(true)) {
     _PVRTexHeader2 hdr2{};
 
-    BA_PRECONDITION(fread(&hdr2, 52, 1, f) == 1);
+    BA_PRECONDITION(f.Read(&hdr2, 52, 1) == 1);
     BA_PRECONDITION(hdr2.version == 0x03525650);
     BA_PRECONDITION(hdr2.flags == 0);
     BA_PRECONDITION(hdr2.color_space == 0);   // linear RGB
@@ -75,10 +76,9 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
     internal_format = TextureFormat::kPVR4;
 
     // Skip over metadata.
-    BA_PRECONDITION(fseek(f,
-                          static_cast_check_fit<long>(hdr2.metaSize),  // NOLINT
-                          SEEK_CUR)
-                    == 0);
+    BA_PRECONDITION(
+        f.Seek(static_cast_check_fit<long>(hdr2.metaSize), SEEK_CUR)  // NOLINT
+        == 0);
 
     width = hdr2.width;
     height = hdr2.height;
@@ -127,13 +127,12 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
         widths[ix] = width;
         heights[ix] = height;
         formats[ix] = internal_format;
-        BA_PRECONDITION(fread(buffers[ix], data_size, 1, f) == 1);
+        BA_PRECONDITION(f.Read(buffers[ix], data_size, 1) == 1);
       } else {
         buffers[ix] = nullptr;
-        BA_PRECONDITION(fseek(f,
-                              static_cast_check_fit<long>(data_size),  // NOLINT
-                              SEEK_CUR)
-                        == 0);
+        BA_PRECONDITION(
+            f.Seek(static_cast_check_fit<long>(data_size), SEEK_CUR)  // NOLINT
+            == 0);
       }
       width = std::max(width >> 1u, 1u);
       height = std::max(height >> 1u, 1u);
@@ -145,7 +144,7 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
 
     _PVRTexHeader hdr{};
 
-    BA_PRECONDITION(fread(&hdr, sizeof(hdr), 1, f) == 1);
+    BA_PRECONDITION(f.Read(&hdr, sizeof(hdr), 1) == 1);
     BA_PRECONDITION(hdr.headerLength == sizeof(_PVRTexHeader));
 
     pvrTag = hdr.pvrTag;
@@ -225,13 +224,12 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
         widths[ix] = width;
         heights[ix] = height;
         formats[ix] = internal_format;
-        BA_PRECONDITION(fread(buffers[ix], data_size, 1, f) == 1);
+        BA_PRECONDITION(f.Read(buffers[ix], data_size, 1) == 1);
       } else {
         buffers[ix] = nullptr;
-        BA_PRECONDITION(fseek(f,
-                              static_cast_check_fit<long>(data_size),  // NOLINT
-                              SEEK_CUR)
-                        == 0);
+        BA_PRECONDITION(
+            f.Seek(static_cast_check_fit<long>(data_size), SEEK_CUR)  // NOLINT
+            == 0);
       }
       data_offset += data_size;
 
@@ -241,7 +239,6 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
     }
     BA_PRECONDITION(ix == mip_map_count);
   }
-  fclose(f);
 }
 
 }  // namespace ballistica::base
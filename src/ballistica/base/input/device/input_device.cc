@@ -63,6 +63,7 @@ void InputDevice::RequestPlayer() {
   // Make note that we're being used in some way.
   UpdateLastActiveTime();
 
+  g_base->input->recorder().OnRequestPlayer(this);
   delegate_->RequestPlayer();
 }
 
@@ -74,7 +75,10 @@ auto InputDevice::AttachedToPlayer() const -> bool {
   return delegate_->AttachedToPlayer();
 }
 
-void InputDevice::DetachFromPlayer() { delegate_->DetachFromPlayer(); }
+void InputDevice::DetachFromPlayer() {
+  g_base->input->recorder().OnDetachFromPlayer(this);
+  delegate_->DetachFromPlayer();
+}
 
 void InputDevice::UpdateLastActiveTime() {
   // Special case: in attract-mode, prevent our virtual test devices from
@@ -98,6 +102,7 @@ void InputDevice::InputCommand(InputType type, float value) {
   // Make note that we're being used in some way.
   UpdateLastActiveTime();
 
+  g_base->input->recorder().OnInputCommand(this, type, value);
   delegate_->InputCommand(type, value);
 }
 
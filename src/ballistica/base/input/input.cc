@@ -337,6 +337,12 @@ void Input::AddInputDevice(InputDevice* device, bool standard_message) {
   if (standard_message && !device->ShouldBeHiddenFromUser()) {
     ShowStandardInputDeviceConnectedMessage_(device);
   }
+
+  // Release any events that beat us here.
+  if (!deferred_joystick_events_.empty()
+      && !joystick_drain_scheduled_.exchange(true)) {
+    g_base->logic->event_loop()->PushCall([this] { DrainJoystickEvents_(); });
+  }
 }
 
 void Input::PushRemoveInputDeviceCall(InputDevice* input_device,
@@ -350,6 +356,31 @@ void Input::PushRemoveInputDeviceCall(InputDevice* input_device,
 void Input::RemoveInputDevice(InputDevice* input, bool standard_message) {
   assert(g_base->InLogicThread());
 
+  // Make sure nothing still queued for this device outlives it. We may be
+  // getting called from within a drain, so just pull the ring's contents
+  // into the deferred list (which the next drain handles first) and blank
+  // out anything of ours in the batch currently being processed.
+  JoystickEvent_ entry;
+  while (joystick_event_ring_.TryPop(&entry)) {
+    deferred_joystick_events_.push_back(entry);
+  }
+  for (auto&& e : joystick_event_batch_) {
+    if (e.device == input) {
+      e.device = nullptr;
+    }
+  }
+  for (size_t i = 0; i < deferred_joystick_events_.size();) {
+    if (deferred_joystick_events_[i].device == input) {
+      deferred_joystick_events_.erase(deferred_joystick_events_.begin() + i);
+    } else {
+      ++i;
+    }
+  }
+  if (!deferred_joystick_events_.empty()
+      && !joystick_drain_scheduled_.exchange(true)) {
+    g_base->logic->event_loop()->PushCall([this] { DrainJoystickEvents_(); });
+  }
+
   if (standard_message && !input->ShouldBeHiddenFromUser()) {
     ShowStandardInputDeviceDisconnectedMessage_(input);
   }
@@ -527,7 +558,12 @@ void Input::OnAppSuspend() { assert(g_base->InLogicThread()); }
 
 void Input::OnAppUnsuspend() { assert(g_base->InLogicThread()); }
 
-void Input::OnAppShutdown() { assert(g_base->InLogicThread()); }
+void Input::OnAppShutdown() {
+  assert(g_base->InLogicThread());
+
+  // Don't lose a recording in progress.
+  recorder_.StopRecording();
+}
 
 void Input::OnAppShutdownComplete() { assert(g_base->InLogicThread()); }
 
@@ -595,6 +631,8 @@ void Input::StepDisplayTime() {
       (*input_device).Update();
     }
   }
+
+  recorder_.StepDisplayTime();
 }
 
 void Input::Reset() {
@@ -787,9 +825,91 @@ void Input::PushTextInputEvent(const std::string& text) {
 void Input::PushJoystickEvent(const SDL_Event& event,
                               InputDevice* input_device) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall([this, event, input_device] {
-    HandleJoystickEvent_(event, input_device);
-  });
+  assert(input_device);
+  JoystickEvent_ entry{event, input_device};
+  if (!joystick_event_ring_.TryPush(std::move(entry))) {
+    // The logic thread is way behind. Hand this one over as its own call,
+    // draining first so it still lands after everything already queued.
+    g_base->logic->event_loop()->PushCall([this, event, input_device] {
+      DrainJoystickEvents_();
+      if (input_device->index() < 0) {
+        deferred_joystick_events_.push_back(
+            JoystickEvent_{event, input_device});
+      } else {
+        HandleJoystickEvent_(event, input_device);
+      }
+    });
+    return;
+  }
+  if (!joystick_drain_scheduled_.exchange(true)) {
+    g_base->logic->event_loop()->PushCall([this] { DrainJoystickEvents_(); });
+  }
+}
+
+void Input::DrainJoystickEvents_() {
+  assert(g_base->InLogicThread());
+
+  // Clear this before popping; anything pushed from here on will schedule
+  // another drain.
+  joystick_drain_scheduled_ = false;
+
+  // Events held back last time are older than anything in the ring.
+  auto& batch{joystick_event_batch_};
+  batch.clear();
+  batch.swap(deferred_joystick_events_);
+  JoystickEvent_ entry;
+  while (joystick_event_ring_.TryPop(&entry)) {
+    batch.push_back(entry);
+  }
+  if (batch.empty()) {
+    return;
+  }
+
+  // Walk backwards dropping any axis value that gets overwritten later in
+  // the batch by the same device/axis. Any other event from a device
+  // (buttons, hats, etc.) ends the run for that device so we never move
+  // axis values across them.
+  coalesce_keys_.clear();
+  for (auto i = static_cast<ptrdiff_t>(batch.size()) - 1; i >= 0; --i) {
+    auto& e{batch[i]};
+    if (e.event.type == SDL_JOYAXISMOTION) {
+      std::pair<InputDevice*, int> key{e.device, e.event.jaxis.axis};
+      bool seen{};
+      for (auto&& k : coalesce_keys_) {
+        if (k == key) {
+          seen = true;
+          break;
+        }
+      }
+      if (seen) {
+        e.device = nullptr;
+      } else {
+        coalesce_keys_.push_back(key);
+      }
+    } else {
+      for (size_t j = 0; j < coalesce_keys_.size();) {
+        if (coalesce_keys_[j].first == e.device) {
+          coalesce_keys_[j] = coalesce_keys_.back();
+          coalesce_keys_.pop_back();
+        } else {
+          ++j;
+        }
+      }
+    }
+  }
+
+  // The ring can get events ahead of their device's add call (which goes
+  // through the regular event loop); hold those until the device lands.
+  for (auto&& e : batch) {
+    if (e.device == nullptr) {
+      continue;
+    }
+    if (e.device->index() < 0) {
+      deferred_joystick_events_.push_back(e);
+      continue;
+    }
+    HandleJoystickEvent_(e.event, e.device);
+  }
 }
 
 void Input::HandleJoystickEvent_(const SDL_Event& event,
@@ -1418,7 +1538,59 @@ void Input::HandleMouseUp_(int button, const Vector2f& position) {
 
 void Input::PushTouchEvent(const TouchEvent& e) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall([e, this] { HandleTouchEvent_(e); });
+  TouchEvent entry{e};
+  if (!touch_event_ring_.TryPush(std::move(entry))) {
+    g_base->logic->event_loop()->PushCall([e, this] {
+      DrainTouchEvents_();
+      HandleTouchEvent_(e);
+    });
+    return;
+  }
+  if (!touch_drain_scheduled_.exchange(true)) {
+    g_base->logic->event_loop()->PushCall([this] { DrainTouchEvents_(); });
+  }
+}
+
+void Input::DrainTouchEvents_() {
+  assert(g_base->InLogicThread());
+  touch_drain_scheduled_ = false;
+  auto& batch{touch_event_batch_};
+  batch.clear();
+  TouchEvent entry;
+  while (touch_event_ring_.TryPop(&entry)) {
+    batch.push_back(entry);
+  }
+
+  // Same deal as joystick axes: only the last move of a touch survives,
+  // and downs/ups/cancels are never reordered against its moves.
+  coalesce_touches_.clear();
+  touch_event_dropped_.assign(batch.size(), false);
+  for (auto i = static_cast<ptrdiff_t>(batch.size()) - 1; i >= 0; --i) {
+    auto& e{batch[i]};
+    bool seen{};
+    for (size_t j = 0; j < coalesce_touches_.size(); ++j) {
+      if (coalesce_touches_[j] == e.touch) {
+        seen = true;
+        if (e.type != TouchEvent::Type::kMoved) {
+          coalesce_touches_[j] = coalesce_touches_.back();
+          coalesce_touches_.pop_back();
+        }
+        break;
+      }
+    }
+    if (e.type == TouchEvent::Type::kMoved) {
+      if (seen) {
+        touch_event_dropped_[i] = true;
+      } else {
+        coalesce_touches_.push_back(e.touch);
+      }
+    }
+  }
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (!touch_event_dropped_[i]) {
+      HandleTouchEvent_(batch[i]);
+    }
+  }
 }
 
 void Input::HandleTouchEvent_(const TouchEvent& e) {
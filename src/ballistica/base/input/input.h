@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_INPUT_INPUT_H_
 #define BALLISTICA_BASE_INPUT_INPUT_H_
 
+#include <atomic>
 #include <list>
 #include <set>
 #include <string>
@@ -10,9 +11,12 @@
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/input/support/input_recorder.h"
+#include "ballistica/core/platform/support/min_sdl.h"
 #include "ballistica/shared/foundation/macros.h"
 #include "ballistica/shared/foundation/object.h"
 #include "ballistica/shared/foundation/types.h"
+#include "ballistica/shared/generic/mpsc_ring.h"
 
 namespace ballistica::base {
 
@@ -159,6 +163,9 @@ class Input {
   auto attract_mode() const { return attract_mode_; }
   void set_attract_mode(bool val) { attract_mode_ = val; }
 
+  /// Recording and playback of local input for repeatable benchmarks.
+  auto recorder() -> InputRecorder& { return recorder_; }
+
  private:
   auto ShouldAllowInputInAttractMode_(InputDevice* device) const -> bool;
   void UpdateInputDeviceCounts_();
@@ -177,6 +184,8 @@ class Input {
   void HandleSmoothMouseScroll_(const Vector2f& velocity, bool momentum);
   void HandleJoystickEvent_(const SDL_Event& event, InputDevice* input_device);
   void HandleTouchEvent_(const TouchEvent& e);
+  void DrainJoystickEvents_();
+  void DrainTouchEvents_();
   void ShowStandardInputDeviceConnectedMessage_(InputDevice* j);
   void ShowStandardInputDeviceDisconnectedMessage_(InputDevice* j);
   void PrintLockLabels_();
@@ -224,6 +233,25 @@ class Input {
   HandleKeyPressCall* keyboard_input_capture_press_{};
   HandleKeyReleaseCall* keyboard_input_capture_release_{};
   HandleJoystickEventCall* joystick_input_capture_{};
+
+  // Joystick and touch events travel from the event thread to the logic
+  // thread through these rings so that bursts of stick/drag motion can be
+  // coalesced before we process them.
+  struct JoystickEvent_ {
+    SDL_Event event{};
+    InputDevice* device{};
+  };
+  MPSCRing<JoystickEvent_, 1024> joystick_event_ring_;
+  MPSCRing<TouchEvent, 256> touch_event_ring_;
+  std::atomic<bool> joystick_drain_scheduled_{};
+  std::atomic<bool> touch_drain_scheduled_{};
+  std::vector<JoystickEvent_> joystick_event_batch_;
+  std::vector<JoystickEvent_> deferred_joystick_events_;
+  std::vector<TouchEvent> touch_event_batch_;
+  std::vector<std::pair<InputDevice*, int> > coalesce_keys_;
+  std::vector<void*> coalesce_touches_;
+  std::vector<bool> touch_event_dropped_;
+  InputRecorder recorder_;
 };
 
 }  // namespace ballistica::base
@@ -0,0 +1,214 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/input/support/input_recorder.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "ballistica/base/input/device/joystick_input.h"
+#include "ballistica/base/input/input.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/math/random.h"
+#include "ballistica/shared/python/python_command.h"
+
+namespace ballistica::base {
+
+const int kInputRecordingVersion{1};
+
+/// Most sources a recording can have; each needs its own device.
+const int kInputRecordingMaxSources{64};
+
+void InputRecorder::StartRecording(const std::string& path, uint64_t seed) {
+  assert(g_base->InLogicThread());
+  if (playing_) {
+    throw Exception("Can't record input during playback.");
+  }
+  if (recording_) {
+    StopRecording();
+  }
+  path_ = path;
+  seed_ = seed;
+  events_.clear();
+  sources_.clear();
+  ApplySeed_(seed_);
+  start_time_ = g_core->AppTimeMillisecs();
+  recording_ = true;
+}
+
+void InputRecorder::StopRecording() {
+  assert(g_base->InLogicThread());
+  if (!recording_) {
+    return;
+  }
+  recording_ = false;
+  FILE* f = g_core->platform->FOpen(path_.c_str(), "w");
+  if (!f) {
+    g_core->Log(LogName::kBaInput, LogLevel::kError,
+                "Unable to write input recording to '" + path_ + "'.");
+    return;
+  }
+  fprintf(f, "bainput %d %" PRIu64 "\n", kInputRecordingVersion, seed_);
+  for (auto&& e : events_) {
+    fprintf(f, "%" PRId64 " %d %d %d %.9g\n", static_cast<int64_t>(e.time),
+            e.source, static_cast<int>(e.type), static_cast<int>(e.input_type),
+            e.value);
+  }
+  fclose(f);
+  g_core->Log(LogName::kBaInput, LogLevel::kInfo,
+              "Wrote " + std::to_string(events_.size())
+                  + " input events from " + std::to_string(sources_.size())
+                  + " device(s) to '" + path_ + "'.");
+  events_.clear();
+  sources_.clear();
+}
+
+void InputRecorder::Record_(InputDevice* device, EventType_ type,
+                            InputType input_type, float value) {
+  assert(g_base->InLogicThread());
+  assert(device);
+  auto i = sources_.find(device->index());
+  if (i == sources_.end()) {
+    if (static_cast<int>(sources_.size()) >= kInputRecordingMaxSources) {
+      return;
+    }
+    i = sources_
+            .emplace(device->index(), static_cast<int>(sources_.size()))
+            .first;
+  }
+  events_.push_back(Event_{g_core->AppTimeMillisecs() - start_time_,
+                           i->second, type, input_type, value});
+}
+
+void InputRecorder::StartPlayback(const std::string& path) {
+  assert(g_base->InLogicThread());
+  if (recording_) {
+    throw Exception("Can't play back input while recording.");
+  }
+  StopPlayback();
+
+  FILE* f = g_core->platform->FOpen(path.c_str(), "r");
+  if (!f) {
+    throw Exception("Unable to open input recording '" + path + "'.");
+  }
+  std::vector<Event_> events;
+  int version{};
+  uint64_t seed{};
+  int source_count{};
+  bool ok = fscanf(f, "bainput %d %" SCNu64, &version, &seed) == 2
+            && version == kInputRecordingVersion;
+  while (ok) {
+    int64_t time;
+    int source, type, input_type;
+    float value;
+    int got = fscanf(f, "%" SCNd64 " %d %d %d %f", &time, &source, &type,
+                     &input_type, &value);
+    if (got == EOF) {
+      break;
+    }
+    if (got != 5 || source < 0 || source >= kInputRecordingMaxSources
+        || type < 0 || type > static_cast<int>(EventType_::kDetachFromPlayer)
+        || input_type < 0 || input_type > static_cast<int>(InputType::kLast)
+        || (!events.empty() && time < events.back().time)) {
+      ok = false;
+      break;
+    }
+    events.push_back(Event_{time, source, static_cast<EventType_>(type),
+                            static_cast<InputType>(input_type), value});
+    source_count = std::max(source_count, source + 1);
+  }
+  fclose(f);
+  if (!ok) {
+    throw Exception("Invalid input recording '" + path + "'.");
+  }
+
+  events_ = std::move(events);
+  next_event_ = 0;
+  seed_ = seed;
+  playing_ = true;
+  playback_started_ = false;
+
+  // Devices get added asynchronously; we hold off on starting the clock
+  // until they've all landed.
+  for (int i = 0; i < source_count; ++i) {
+    auto* device =
+        Object::NewDeferred<JoystickInput>(-1,  // Not an sdl joystick.
+                                           "RecordedInput",  // Device name.
+                                           false,   // Allow configuring?
+                                           false);  // Calibrate?
+    device->set_is_test_input(true);
+    g_base->input->PushAddInputDeviceCall(device, true);
+    devices_.push_back(device);
+  }
+}
+
+void InputRecorder::StopPlayback() {
+  assert(g_base->InLogicThread());
+  if (!playing_) {
+    return;
+  }
+  playing_ = false;
+  for (auto* device : devices_) {
+    g_base->input->PushRemoveInputDeviceCall(device, true);
+  }
+  devices_.clear();
+  events_.clear();
+}
+
+void InputRecorder::StepDisplayTime() {
+  assert(g_base->InLogicThread());
+  if (!playing_) {
+    return;
+  }
+  millisecs_t now = g_core->AppTimeMillisecs();
+  if (!playback_started_) {
+    for (auto* device : devices_) {
+      if (device->index() < 0) {
+        return;
+      }
+    }
+    playback_started_ = true;
+    ApplySeed_(seed_);
+    start_time_ = now;
+  }
+
+  // Events are applied at display-step granularity, so timing lines up
+  // with the recording to within a frame or so.
+  millisecs_t elapsed = now - start_time_;
+  while (next_event_ < events_.size()
+         && events_[next_event_].time <= elapsed) {
+    auto& e{events_[next_event_++]};
+    auto* device = devices_[e.source];
+    switch (e.type) {
+      case EventType_::kRequestPlayer:
+        device->RequestPlayer();
+        break;
+      case EventType_::kInputCommand:
+        device->InputCommand(e.input_type, e.value);
+        break;
+      case EventType_::kDetachFromPlayer:
+        device->DetachFromPlayer();
+        break;
+    }
+  }
+  if (next_event_ >= events_.size()) {
+    g_core->Log(LogName::kBaInput, LogLevel::kInfo,
+                "Input playback complete ("
+                    + std::to_string(static_cast<double>(elapsed) / 1000.0)
+                    + "s).");
+    StopPlayback();
+  }
+}
+
+void InputRecorder::ApplySeed_(uint64_t seed) {
+  assert(g_base->InLogicThread());
+  SeedThreadRandomStreams(seed);
+  srand(static_cast<unsigned int>(seed));  // NOLINT
+  PythonCommand("import random\nrandom.seed(" + std::to_string(seed) + ")",
+                "<input-recorder>")
+      .Exec(true, nullptr, nullptr);
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,91 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_INPUT_SUPPORT_INPUT_RECORDER_H_
+#define BALLISTICA_BASE_INPUT_SUPPORT_INPUT_RECORDER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Records what local input devices tell the game (join requests, player
+/// commands and leaves) along with when they did it, and plays recordings
+/// back later through stand-in devices. Random number generators get the
+/// same seed at the start of recording and of playback, so a recorded
+/// session can be run again to put the same gameplay load on logic and
+/// physics when comparing builds.
+///
+/// Recordings are plain text; a header line of "bainput <version> <seed>"
+/// followed by one "<time-ms> <source> <event> <input-type> <value>" line
+/// per event. Logic thread only.
+class InputRecorder {
+ public:
+  /// Seed random number generators and start recording, to be written to
+  /// path once stopped.
+  void StartRecording(const std::string& path, uint64_t seed);
+  void StopRecording();
+
+  /// Read a recording, seed random number generators the same way it did,
+  /// and start feeding its events to a fresh device for each source.
+  void StartPlayback(const std::string& path);
+  void StopPlayback();
+
+  auto recording() const -> bool { return recording_; }
+  auto playing() const -> bool { return playing_; }
+
+  /// Called by input devices as they send things to the game.
+  void OnRequestPlayer(InputDevice* device) {
+    if (recording_) {
+      Record_(device, EventType_::kRequestPlayer, InputType::kLast, 0.0f);
+    }
+  }
+  void OnInputCommand(InputDevice* device, InputType type, float value) {
+    if (recording_) {
+      Record_(device, EventType_::kInputCommand, type, value);
+    }
+  }
+  void OnDetachFromPlayer(InputDevice* device) {
+    if (recording_) {
+      Record_(device, EventType_::kDetachFromPlayer, InputType::kLast, 0.0f);
+    }
+  }
+
+  void StepDisplayTime();
+
+ private:
+  enum class EventType_ { kRequestPlayer, kInputCommand, kDetachFromPlayer };
+
+  struct Event_ {
+    millisecs_t time{};
+    int source{};
+    EventType_ type{};
+    InputType input_type{};
+    float value{};
+  };
+
+  void Record_(InputDevice* device, EventType_ type, InputType input_type,
+               float value);
+  static void ApplySeed_(uint64_t seed);
+
+  std::string path_;
+  std::vector<Event_> events_;
+  uint64_t seed_{};
+  millisecs_t start_time_{};
+  bool recording_{};
+  bool playing_{};
+  bool playback_started_{};
+
+  // Recording: sources assigned to device indices as they show up.
+  std::unordered_map<int, int> sources_;
+
+  // Playback: our stand-in device for each source, and where we are.
+  std::vector<JoystickInput*> devices_;
+  size_t next_event_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_INPUT_SUPPORT_INPUT_RECORDER_H_
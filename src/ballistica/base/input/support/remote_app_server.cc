@@ -3,6 +3,7 @@
 #include "ballistica/base/input/support/remote_app_server.h"
 
 #include <cstdio>
+#include <optional>
 #include <string>
 
 #include "ballistica/base/assets/assets.h"
@@ -223,6 +224,28 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
       // Take note that we heard from them.
       client->last_contact_time = g_core->AppTimeMillisecs();
 
+      // Runs of states that only move the d-pad get collapsed into a
+      // single axis event per axis. We flush before any button event so
+      // the order things arrive in is unchanged.
+      std::optional<float> pending_dpad_h;
+      std::optional<float> pending_dpad_v;
+      auto flush_dpad = [&] {
+        if (pending_dpad_h) {
+          HandleRemoteFloatEvent(client, RemoteEventType::kDPadH,
+                                 *pending_dpad_h);
+          pending_dpad_h.reset();
+        }
+        if (pending_dpad_v) {
+          HandleRemoteFloatEvent(client, RemoteEventType::kDPadV,
+                                 *pending_dpad_v);
+          pending_dpad_v.reset();
+        }
+      };
+      auto handle_button = [&](RemoteEventType type) {
+        flush_dpad();
+        HandleRemoteEvent(client, type);
+      };
+
       // Ok now iterate.
       uint8_t* val = buffer + 4;
       for (int i = 0; i < state_count; i++) {
@@ -256,54 +279,54 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
           // handled.
           if ((last_state & kRemoteStateHoldPosition)
               && !(state & kRemoteStateHoldPosition)) {
-            HandleRemoteEvent(client, RemoteEventType::kHoldPositionRelease);
+            handle_button(RemoteEventType::kHoldPositionRelease);
           } else if (!(last_state & kRemoteStateHoldPosition)
                      && (state & kRemoteStateHoldPosition)) {
-            HandleRemoteEvent(client, RemoteEventType::kHoldPositionPress);
+            handle_button(RemoteEventType::kHoldPositionPress);
           }
           if (dpad_h != last_dpad_h) {
-            HandleRemoteFloatEvent(client, RemoteEventType::kDPadH, dpad_h);
+            pending_dpad_h = dpad_h;
           }
           if (dpad_v != last_dpad_v) {
-            HandleRemoteFloatEvent(client, RemoteEventType::kDPadV, dpad_v);
+            pending_dpad_v = dpad_v;
           }
           if ((last_state & kRemoteStateBomb) && !(state & kRemoteStateBomb)) {
-            HandleRemoteEvent(client, RemoteEventType::kBombRelease);
+            handle_button(RemoteEventType::kBombRelease);
           } else if (!(last_state & kRemoteStateBomb)
                      && (state & kRemoteStateBomb)) {
-            HandleRemoteEvent(client, RemoteEventType::kBombPress);
+            handle_button(RemoteEventType::kBombPress);
           }
           if ((last_state & kRemoteStateJump) && !(state & kRemoteStateJump)) {
-            HandleRemoteEvent(client, RemoteEventType::kJumpRelease);
+            handle_button(RemoteEventType::kJumpRelease);
           } else if (!(last_state & kRemoteStateJump)
                      && (state & kRemoteStateJump)) {
-            HandleRemoteEvent(client, RemoteEventType::kJumpPress);
+            handle_button(RemoteEventType::kJumpPress);
           }
           if ((last_state & kRemoteStatePunch)
               && !(state & kRemoteStatePunch)) {
-            HandleRemoteEvent(client, RemoteEventType::kPunchRelease);
+            handle_button(RemoteEventType::kPunchRelease);
           } else if (!(last_state & kRemoteStatePunch)
                      && (state & kRemoteStatePunch)) {
-            HandleRemoteEvent(client, RemoteEventType::kPunchPress);
+            handle_button(RemoteEventType::kPunchPress);
           }
           if ((last_state & kRemoteStateThrow)
               && !(state & kRemoteStateThrow)) {
-            HandleRemoteEvent(client, RemoteEventType::kThrowRelease);
+            handle_button(RemoteEventType::kThrowRelease);
           } else if (!(last_state & kRemoteStateThrow)
                      && (state & kRemoteStateThrow)) {
-            HandleRemoteEvent(client, RemoteEventType::kThrowPress);
+            handle_button(RemoteEventType::kThrowPress);
           }
           if ((last_state & kRemoteStateMenu) && !(state & kRemoteStateMenu)) {
-            HandleRemoteEvent(client, RemoteEventType::kMenuRelease);
+            handle_button(RemoteEventType::kMenuRelease);
           } else if (!(last_state & kRemoteStateMenu)
                      && (state & kRemoteStateMenu)) {
-            HandleRemoteEvent(client, RemoteEventType::kMenuPress);
+            handle_button(RemoteEventType::kMenuPress);
           }
           if ((last_state & kRemoteStateRun) && !(state & kRemoteStateRun)) {
-            HandleRemoteEvent(client, RemoteEventType::kRunRelease);
+            handle_button(RemoteEventType::kRunRelease);
           } else if (!(last_state & kRemoteStateRun)
                      && (state & kRemoteStateRun)) {
-            HandleRemoteEvent(client, RemoteEventType::kRunPress);
+            handle_button(RemoteEventType::kRunPress);
           }
           client->state = state;
           client->next_state_id++;
@@ -311,6 +334,7 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
         state_id++;
         val += 3;
       }
+      flush_dpad();
 
       // Ok now send an ack with the state ID we're looking for next.
       uint8_t data[2] = {BA_PACKET_REMOTE_STATE_ACK, client->next_state_id};
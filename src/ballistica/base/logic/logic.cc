@@ -10,9 +10,11 @@
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/app_mode/app_mode.h"
+#include "ballistica/base/assets/assets.h"
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/input/input.h"
+#include "ballistica/base/logic/logic_profiler.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/platform/base_platform.h"
 #include "ballistica/base/python/base_python.h"
@@ -26,7 +28,8 @@
 
 namespace ballistica::base {
 
-Logic::Logic() : display_timers_(new TimerList()) {}
+Logic::Logic()
+    : display_timers_(new TimerList()), profiler_(new LogicProfiler()) {}
 
 void Logic::OnMainThreadStartApp() {
   // Spin up our logic thread and sit and wait for it to init.
@@ -139,9 +142,9 @@ void Logic::CompleteAppBootstrapping_() {
   // Set up our timers.
   process_pending_work_timer_ = event_loop()->NewTimer(
       0, true, NewLambdaRunnable([this] { ProcessPendingWork_(); }).get());
-  // asset_prune_timer_ = event_loop()->NewTimer(
-  //     2345 * 1000, true, NewLambdaRunnable([] { g_base->assets->Prune();
-  //     }).Get());
+  asset_prune_timer_ = event_loop()->NewTimer(
+      2345 * 1000, true,
+      NewLambdaRunnable([] { g_base->assets->Prune(); }).get());
 
   // Let our initial dummy app-mode know it has become active.
   g_base->app_mode()->OnActivate();
@@ -166,7 +169,9 @@ void Logic::OnAppRunning() {
   assert(g_base->InLogicThread());
   assert(g_base->CurrentContext().IsEmpty());
 
-  // Currently don't do anything here.
+  // Everything is up; report how long it took to get here.
+  g_core->MarkStartupPhase("app_running");
+  g_core->LogStartupPhases();
 }
 
 void Logic::OnInitialAppModeSet() {
@@ -303,6 +308,7 @@ void Logic::DoApplyAppConfig() {
   g_base->platform->DoApplyAppConfig();
   g_base->graphics->DoApplyAppConfig();
   g_base->audio->DoApplyAppConfig();
+  g_base->assets->DoApplyAppConfig();
   g_base->input->DoApplyAppConfig();
   g_base->ui->DoApplyAppConfig();
   g_base->app_mode()->DoApplyAppConfig();
@@ -342,6 +348,8 @@ void Logic::OnScreenSizeChange(float virtual_width, float virtual_height,
 // Bring all logic-thread stuff up to date for a new visual frame.
 void Logic::StepDisplayTime_() {
   assert(g_base->InLogicThread());
+  LogicProfiler::Scope profile_scope("StepDisplayTime");
+  microsecs_t step_start_time = core::CorePlatform::TimeMonotonicMicrosecs();
 
   // We have two different modes of operation here. When running in headless
   // mode, display time is driven by upcoming events such as sim steps; we
@@ -349,7 +357,10 @@ void Logic::StepDisplayTime_() {
   // events occur. When running with a gui, our display-time is driven by
   // real draw times and is intended to keep frame intervals as visually
   // consistent and smooth looking as possible.
-  if (g_core->HeadlessMode()) {
+  // (Either of these can be overridden with a fixed step).
+  if (fixed_display_time_step_ > 0) {
+    UpdateDisplayTimeForFixedStep_();
+  } else if (g_core->HeadlessMode()) {
     UpdateDisplayTimeForHeadlessMode_();
   } else {
     UpdateDisplayTimeForFrameDraw_();
@@ -357,20 +368,49 @@ void Logic::StepDisplayTime_() {
 
   // Give all our subsystems some update love.
   // Note: keep these in the same order as OnAppStart.
-  g_base->graphics->StepDisplayTime();
-  g_base->audio->StepDisplayTime();
-  g_base->input->StepDisplayTime();
-  g_base->ui->StepDisplayTime();
+  {
+    LogicProfiler::Scope s("graphics");
+    g_base->graphics->StepDisplayTime();
+  }
+  {
+    LogicProfiler::Scope s("audio");
+    g_base->audio->StepDisplayTime();
+  }
+  {
+    LogicProfiler::Scope s("input");
+    g_base->input->StepDisplayTime();
+  }
+  {
+    LogicProfiler::Scope s("ui");
+    g_base->ui->StepDisplayTime();
+  }
   g_core->platform->StepDisplayTime();
-  g_base->app_mode()->StepDisplayTime();
+  {
+    LogicProfiler::Scope s("app_mode");
+    g_base->app_mode()->StepDisplayTime();
+  }
   if (g_base->HavePlus()) {
+    LogicProfiler::Scope s("plus");
     g_base->Plus()->StepDisplayTime();
   }
-  g_base->python->StepDisplayTime();
+  {
+    LogicProfiler::Scope s("python");
+    g_base->python->StepDisplayTime();
+  }
 
   // Let's run display-timers *after* we step everything else so most things
   // they interact with will be in an up-to-date state.
-  display_timers_->Run(display_time_microsecs_);
+  {
+    LogicProfiler::Scope s("display_timers");
+    display_timers_->Run(display_time_microsecs_);
+  }
+
+  // Ship off all sound commands issued this step in one go.
+  g_base->audio->SubmitCommands();
+
+  // Now that the step's real work is done, use any slack it left to keep
+  // Python's young garbage in check.
+  g_base->python->RunIdleGarbageCollection(step_start_time);
 
   if (g_core->HeadlessMode()) {
     PostUpdateDisplayTimeForHeadlessMode_();
@@ -393,6 +433,16 @@ void Logic::OnAppModeChanged() {
   }
 }
 
+void Logic::WakeHeadlessDisplayTime() {
+  assert(g_base->InLogicThread());
+  if (!g_core->HeadlessMode() || !headless_display_time_step_timer_) {
+    return;
+  }
+  g_core->Log(LogName::kBaDisplayTime, LogLevel::kDebug,
+              "Waking headless display stepping.");
+  headless_display_time_step_timer_->SetLength(kHeadlessMinDisplayTimeStep);
+}
+
 void Logic::UpdateDisplayTimeForHeadlessMode_() {
   assert(g_base->InLogicThread());
   // In this case we just keep display time synced up with app time; we
@@ -424,15 +474,52 @@ void Logic::UpdateDisplayTimeForHeadlessMode_() {
   });
 }
 
+void Logic::SetFixedDisplayTimeStep(microsecs_t step) {
+  assert(g_base->InLogicThread());
+  BA_PRECONDITION(step >= 0);
+  fixed_display_time_step_ = step;
+
+  // Make sure our smoothing starts fresh if we switch back to it; it would
+  // otherwise see one giant interval.
+  last_display_time_update_app_time_ = -1.0;
+  WakeHeadlessDisplayTime();
+}
+
+void Logic::UpdateDisplayTimeForFixedStep_() {
+  assert(fixed_display_time_step_ > 0);
+  display_time_microsecs_ += fixed_display_time_step_;
+  display_time_increment_microsecs_ = fixed_display_time_step_;
+  display_time_ = static_cast<double>(display_time_microsecs_) / 1000000.0;
+  display_time_increment_ =
+      static_cast<double>(display_time_increment_microsecs_) / 1000000.0;
+}
+
 void Logic::PostUpdateDisplayTimeForHeadlessMode_() {
   assert(g_base->InLogicThread());
+
+  // With a fixed step we just run steps back to back.
+  if (fixed_display_time_step_ > 0) {
+    headless_display_time_step_timer_->SetLength(kHeadlessMinDisplayTimeStep);
+    return;
+  }
   // At this point we've stepped our app-mode, so let's ask it how long
   // we've got until the next event. We'll plug this into our display-update
   // timer so we can try to sleep exactly until that point.
-  auto headless_display_step_microsecs =
-      std::max(std::min(g_base->app_mode()->GetHeadlessNextDisplayTimeStep(),
-                        kHeadlessMaxDisplayTimeStep),
-               kHeadlessMinDisplayTimeStep);
+  //
+  // An idle app-mode has nothing scheduled and promises to wake us when
+  // that changes, so we can sleep much longer in that case. Either way we
+  // need to be up in time for our next display-timer.
+  auto max_step = g_base->app_mode()->IsHeadlessIdle()
+                      ? kHeadlessIdleMaxDisplayTimeStep
+                      : kHeadlessMaxDisplayTimeStep;
+  auto to_next_display_timer =
+      display_timers_->TimeToNextExpire(display_time_microsecs_);
+  if (to_next_display_timer >= 0) {
+    max_step = std::min(max_step, to_next_display_timer);
+  }
+  auto headless_display_step_microsecs = std::max(
+      std::min(g_base->app_mode()->GetHeadlessNextDisplayTimeStep(), max_step),
+      kHeadlessMinDisplayTimeStep);
 
   g_core->Log(
       LogName::kBaDisplayTime, LogLevel::kDebug,
@@ -705,6 +792,7 @@ void Logic::SetDisplayTimerLength(int timer_id, microsecs_t length) {
 }
 
 void Logic::ProcessPendingWork_() {
+  LogicProfiler::Scope profile_scope("pending_loads");
   have_pending_loads_ = g_base->assets->RunPendingLoadsLogicThread();
   UpdatePendingWorkTimer_();
 }
@@ -5,6 +5,7 @@
 
 #include <memory>
 
+#include "ballistica/base/base.h"
 #include "ballistica/shared/generic/runnable.h"
 
 namespace ballistica::base {
@@ -20,6 +21,11 @@ const microsecs_t kHeadlessMaxDisplayTimeStep{500000};
 /// limit on stepping overhead in cases where events are densely packed.
 const microsecs_t kHeadlessMinDisplayTimeStep{1000};
 
+/// The max amount of time a headless app can sleep while its app-mode
+/// reports being idle. Anything that ends the idle state should call
+/// Logic::WakeHeadlessDisplayTime() so we don't sit out the full sleep.
+const microsecs_t kHeadlessIdleMaxDisplayTimeStep{5000000};
+
 /// The logic subsystem of the app. This runs on a dedicated thread and is
 /// where most high level app logic happens. Much app functionality
 /// including UI calls must be run on the logic thread.
@@ -64,6 +70,11 @@ class Logic {
 
   void OnAppModeChanged();
 
+  /// In headless mode, cut short any current display-time sleep and step
+  /// again as soon as possible. Call this when something happens that an
+  /// idle app-mode needs to respond to (a client connecting, etc.).
+  void WakeHeadlessDisplayTime();
+
   void DoApplyAppConfig();
   void OnScreenSizeChange(float virtual_width, float virtual_height,
                           float pixel_width, float pixel_height);
@@ -113,16 +124,27 @@ class Logic {
     return display_time_increment_microsecs_;
   }
 
+  /// Advance display-time by exactly this much per step regardless of how
+  /// fast we're actually running (for deterministic playback such as
+  /// benchmarks). Headless builds step as fast as they can while this is
+  /// set. Pass 0 to go back to normal timing.
+  void SetFixedDisplayTimeStep(microsecs_t step);
+  auto fixed_display_time_step() const { return fixed_display_time_step_; }
+
   auto applied_app_config() const { return applied_app_config_; }
   auto shutting_down() const { return shutting_down_; }
   auto shutdown_completed() const { return shutdown_completed_; }
   auto graphics_ready() const { return graphics_ready_; }
   auto app_active() const { return app_active_; }
 
+  /// Scoped-marker profiling for the logic thread (off until enabled).
+  auto profiler() -> LogicProfiler& { return *profiler_; }
+
  private:
   void UpdateDisplayTimeForFrameDraw_();
   void UpdateDisplayTimeForHeadlessMode_();
   void PostUpdateDisplayTimeForHeadlessMode_();
+  void UpdateDisplayTimeForFixedStep_();
   void CompleteAppBootstrapping_();
   void ProcessPendingWork_();
   void UpdatePendingWorkTimer_();
@@ -132,6 +154,7 @@ class Logic {
   seconds_t display_time_increment_{1.0 / 60.0};
   microsecs_t display_time_microsecs_{};
   microsecs_t display_time_increment_microsecs_{1000000 / 60};
+  microsecs_t fixed_display_time_step_{};
 
   // Headless scheduling.
   Timer* headless_display_time_step_timer_{};
@@ -151,8 +174,10 @@ class Logic {
   bool shutdown_completed_{};
   bool graphics_ready_{};
   Timer* process_pending_work_timer_{};
+  Timer* asset_prune_timer_{};
   EventLoop* event_loop_{};
   std::unique_ptr<TimerList> display_timers_;
+  std::unique_ptr<LogicProfiler> profiler_;
 };
 
 }  // namespace ballistica::base
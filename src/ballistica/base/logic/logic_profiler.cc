@@ -0,0 +1,305 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/logic/logic_profiler.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/generic/utils.h"
+
+namespace ballistica::base {
+
+LogicProfiler* LogicProfiler::active_{};
+
+LogicProfiler::~LogicProfiler() {
+  if (sampler_thread_.joinable()) {
+    stop_sampling_ = true;
+    sampler_thread_.join();
+  }
+}
+
+void LogicProfiler::SetEnabled(bool enabled) {
+  assert(g_base->InLogicThread());
+  if (enabled) {
+    events_.clear();
+
+    // Samples in progress refer to labels by index so leave them be.
+    if (!sampling_) {
+      labels_.clear();
+      label_indices_.clear();
+    }
+    dropped_events_ = 0;
+    depth_ = 0;
+    start_time_ = core::CorePlatform::TimeMonotonicMicrosecs();
+  }
+  capturing_ = enabled;
+  UpdateActive_();
+}
+
+void LogicProfiler::UpdateActive_() {
+  if (capturing_ || sampling_) {
+    active_ = this;
+  } else if (active_ == this) {
+    active_ = nullptr;
+  }
+}
+
+void LogicProfiler::StartSampling(const std::string& path, seconds_t duration,
+                                  microsecs_t interval) {
+  assert(g_base->InLogicThread());
+  if (sampling_) {
+    throw Exception("Logic sampling is already running.");
+  }
+  if (duration <= 0.0 || interval <= 0) {
+    throw Exception("Sampling duration and interval must be positive.",
+                    PyExcType::kValue);
+  }
+
+  // Make sure we can write results before spending time gathering them.
+  FILE* f = g_core->platform->FOpen(path.c_str(), "wb");
+  if (!f) {
+    throw Exception("Unable to open '" + path + "' for writing.");
+  }
+  fclose(f);
+
+  if (!capturing_) {
+    labels_.clear();
+    label_indices_.clear();
+  }
+  samples_.clear();
+  sample_path_ = path;
+  stack_depth_ = 0;
+  stop_sampling_ = false;
+  sampling_ = true;
+  UpdateActive_();
+
+  auto end_time = core::CorePlatform::TimeMonotonicMicrosecs()
+                  + static_cast<microsecs_t>(duration * 1000000.0);
+  sampler_thread_ = std::thread(
+      [this, end_time, interval] { SamplerThreadMain_(end_time, interval); });
+}
+
+auto LogicProfiler::StopSampling() -> int64_t {
+  assert(g_base->InLogicThread());
+  if (!sampling_) {
+    return 0;
+  }
+  stop_sampling_ = true;
+  sampler_thread_.join();
+  sampling_ = false;
+  UpdateActive_();
+
+  int64_t count{};
+  for (auto&& sample : samples_) {
+    count += sample.second;
+  }
+  try {
+    WriteSamples_();
+    g_core->Log(LogName::kBa, LogLevel::kInfo,
+                "Wrote " + std::to_string(count) + " logic samples to '"
+                    + sample_path_ + "'.");
+  } catch (const Exception& exc) {
+    g_core->Log(LogName::kBa, LogLevel::kError,
+                std::string("Error writing logic samples: ") + exc.what());
+  }
+  samples_.clear();
+  return count;
+}
+
+void LogicProfiler::SamplerThreadMain_(microsecs_t end_time,
+                                       microsecs_t interval) {
+  while (!stop_sampling_) {
+    core::CorePlatform::SleepMicrosecs(interval);
+    if (stop_sampling_) {
+      break;
+    }
+    TakeSample_();
+    if (core::CorePlatform::TimeMonotonicMicrosecs() >= end_time) {
+      // Time's up; have the logic thread wrap things up (if it hasn't been
+      // stopped explicitly in the meantime).
+      g_base->logic->event_loop()->PushCall([this] { StopSampling(); });
+      break;
+    }
+  }
+}
+
+void LogicProfiler::TakeSample_() {
+  std::vector<std::pair<const char*, int>> stack;
+
+  // If the logic thread is mid-change, give it a moment and retry; worst
+  // case we skip this sample.
+  for (int attempt = 0; attempt < 4; ++attempt) {
+    uint32_t seq = stack_seq_.load(std::memory_order_acquire);
+    if (seq & 1u) {
+      std::this_thread::yield();
+      continue;
+    }
+    int depth = stack_depth_.load(std::memory_order_relaxed);
+    stack.clear();
+    for (int i = 0; i < depth; ++i) {
+      stack.emplace_back(stack_[i].name.load(std::memory_order_relaxed),
+                         stack_[i].label.load(std::memory_order_relaxed));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (stack_seq_.load(std::memory_order_relaxed) == seq) {
+      samples_[stack]++;
+      return;
+    }
+  }
+}
+
+void LogicProfiler::WriteSamples_() {
+  FILE* f = g_core->platform->FOpen(sample_path_.c_str(), "wb");
+  if (!f) {
+    throw Exception("Unable to open '" + sample_path_ + "' for writing.");
+  }
+
+  // Folded-stack lines are 'frame;frame;frame count', so semicolons in
+  // labels would split frames.
+  auto frame_name = [this](const std::pair<const char*, int>& frame) {
+    std::string name = frame.first;
+    if (frame.second >= 0 && frame.second < static_cast<int>(labels_.size())) {
+      name += ":" + labels_[frame.second];
+    }
+    for (auto&& c : name) {
+      if (c == ';' || c == '\n') {
+        c = ',';
+      }
+    }
+    return name;
+  };
+  for (auto&& sample : samples_) {
+    std::string line = "logic";
+    if (sample.first.empty()) {
+      line += ";other";
+    }
+    for (auto&& frame : sample.first) {
+      line += ";" + frame_name(frame);
+    }
+    fprintf(f, "%s %lld\n", line.c_str(),
+            static_cast<long long>(sample.second));  // NOLINT
+  }
+  fclose(f);
+}
+
+void LogicProfiler::Begin_(const char* name, int label, int64_t* index,
+                           int* stack_pos) {
+  assert(g_base->InLogicThread());
+  if (capturing_) {
+    if (events_.size() >= kLogicProfilerMaxEvents) {
+      dropped_events_++;
+    } else {
+      Event_ event;
+      event.name = name;
+      event.label = label;
+      event.depth = depth_++;
+      event.start = core::CorePlatform::TimeMonotonicMicrosecs();
+      events_.push_back(event);
+      *index = static_cast<int64_t>(events_.size()) - 1;
+    }
+  }
+  if (sampling_) {
+    int depth = stack_depth_.load(std::memory_order_relaxed);
+    if (depth < kLogicProfilerMaxSampleDepth) {
+      stack_seq_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      stack_[depth].name.store(name, std::memory_order_relaxed);
+      stack_[depth].label.store(label, std::memory_order_relaxed);
+      stack_depth_.store(depth + 1, std::memory_order_relaxed);
+      stack_seq_.fetch_add(1, std::memory_order_release);
+      *stack_pos = depth;
+    }
+  }
+}
+
+void LogicProfiler::End_(int64_t index, int stack_pos) {
+  // Scopes opened before a restart can close into a newer capture; ignore
+  // anything that isn't the innermost open event.
+  if (index >= 0 && index < static_cast<int64_t>(events_.size())) {
+    auto& event{events_[index]};
+    if (event.duration < 0 && event.depth == depth_ - 1) {
+      event.duration =
+          core::CorePlatform::TimeMonotonicMicrosecs() - event.start;
+      depth_--;
+    }
+  }
+  if (stack_pos >= 0 && sampling_
+      && stack_pos == stack_depth_.load(std::memory_order_relaxed) - 1) {
+    stack_seq_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    stack_depth_.store(stack_pos, std::memory_order_relaxed);
+    stack_seq_.fetch_add(1, std::memory_order_release);
+  }
+}
+
+auto LogicProfiler::Intern_(const std::string& label) -> int {
+  auto i = label_indices_.find(label);
+  if (i != label_indices_.end()) {
+    return i->second;
+  }
+  auto index = static_cast<int>(labels_.size());
+  labels_.push_back(label);
+  label_indices_[label] = index;
+  return index;
+}
+
+auto LogicProfiler::WriteChromeTrace(const std::string& path) -> size_t {
+  assert(g_base->InLogicThread());
+  FILE* f = g_core->platform->FOpen(path.c_str(), "wb");
+  if (!f) {
+    throw Exception("Unable to open '" + path + "' for writing.");
+  }
+  fputs("{\"traceEvents\":[\n", f);
+  fputs(
+      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+      "\"args\":{\"name\":\"logic\"}}",
+      f);
+
+  // Escape each distinct name just once.
+  std::vector<std::string> label_names;
+  label_names.reserve(labels_.size());
+  for (auto&& label : labels_) {
+    label_names.push_back(Utils::GetJSONString(label.c_str()));
+  }
+  std::unordered_map<const char*, std::string> native_names;
+
+  // Events still open (capture stopped mid-scope) run to the end.
+  microsecs_t end_time = core::CorePlatform::TimeMonotonicMicrosecs();
+  size_t count{};
+  for (auto&& event : events_) {
+    const std::string* name;
+    const char* category;
+    if (event.label >= 0) {
+      name = &label_names[event.label];
+      category = event.name;
+    } else {
+      auto i = native_names.find(event.name);
+      if (i == native_names.end()) {
+        i = native_names.emplace(event.name, Utils::GetJSONString(event.name))
+                .first;
+      }
+      name = &i->second;
+      category = "native";
+    }
+    microsecs_t duration =
+        event.duration >= 0 ? event.duration : end_time - event.start;
+    fprintf(f,
+            ",\n{\"name\":%s,\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+            "\"tid\":1,\"ts\":%lld,\"dur\":%lld}",
+            name->c_str(), category,
+            static_cast<long long>(event.start - start_time_),  // NOLINT
+            static_cast<long long>(duration));                  // NOLINT
+    count++;
+  }
+  fputs("\n]}\n", f);
+  fclose(f);
+  return count;
+}
+
+}  // namespace ballistica::base
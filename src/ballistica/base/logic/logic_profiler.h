@@ -0,0 +1,151 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_LOGIC_LOGIC_PROFILER_H_
+#define BALLISTICA_BASE_LOGIC_LOGIC_PROFILER_H_
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Most events a single capture will hold; anything past this is counted
+/// but not recorded.
+const size_t kLogicProfilerMaxEvents{500000};
+
+/// Deepest scope nesting the sampler sees; anything nested deeper is
+/// attributed to its ancestors.
+const int kLogicProfilerMaxSampleDepth{32};
+
+/// An optional scoped-marker profiler for the logic thread. While a capture
+/// is running, LogicProfiler::Scope instances record how long their blocks
+/// take, and the capture can be written out as a Chrome trace (viewable in
+/// chrome://tracing or Perfetto). Python calls are labeled by where they
+/// were created so expensive mod callbacks are easy to spot.
+///
+/// Separately, a sampler can run for a while in its own thread, noting
+/// which scopes the logic thread is in at regular intervals, and write the
+/// results as folded stacks (for flamegraph.pl, speedscope, etc.). This is
+/// cheap enough to leave running on a live server. Samples landing outside
+/// of any scope are counted as 'other' (idle or unmarked work).
+///
+/// Logic thread only, aside from the sampler's own reads.
+class LogicProfiler {
+ public:
+  /// Records the time spent in its enclosing block while a capture or
+  /// sampling is running; costs next to nothing otherwise.
+  class Scope {
+   public:
+    /// Name must be a string literal (or otherwise outlive the capture).
+    explicit Scope(const char* name) {
+      if (auto* profiler = active_) {
+        profiler->Begin_(name, -1, &index_, &stack_pos_);
+      }
+    }
+
+    /// For dynamic labels such as Python call locations. Labels are
+    /// interned so repeats are cheap.
+    Scope(const char* name, const std::string& label) {
+      if (auto* profiler = active_) {
+        profiler->Begin_(name, profiler->Intern_(label), &index_,
+                         &stack_pos_);
+      }
+    }
+
+    ~Scope() {
+      if (index_ >= 0 || stack_pos_ >= 0) {
+        if (auto* profiler = active_) {
+          profiler->End_(index_, stack_pos_);
+        }
+      }
+    }
+
+   private:
+    BA_DISALLOW_CLASS_COPIES(Scope);
+    int64_t index_{-1};
+    int stack_pos_{-1};
+  };
+
+  /// Start a new capture (discarding any previous one) or stop the current
+  /// one. A stopped capture is kept around until written or restarted.
+  LogicProfiler() = default;
+  ~LogicProfiler();
+
+  void SetEnabled(bool enabled);
+  auto enabled() const -> bool { return capturing_; }
+
+  /// Start sampling for up to the given duration, after which results are
+  /// written to path as folded stacks. Throws if already sampling.
+  void StartSampling(const std::string& path, seconds_t duration,
+                     microsecs_t interval);
+
+  /// Stop sampling early (if we're sampling) and write results. Returns
+  /// the number of samples written.
+  auto StopSampling() -> int64_t;
+  auto sampling() const -> bool { return sampling_; }
+
+  /// Write the current capture as Chrome trace-event json. Returns the
+  /// number of events written.
+  auto WriteChromeTrace(const std::string& path) -> size_t;
+
+  auto event_count() const -> size_t { return events_.size(); }
+  auto dropped_event_count() const -> int64_t { return dropped_events_; }
+
+ private:
+  struct Event_ {
+    const char* name{};
+    int label{-1};
+    int depth{};
+    microsecs_t start{};
+    microsecs_t duration{-1};
+  };
+
+  // One open scope as seen by the sampler thread.
+  struct StackFrame_ {
+    std::atomic<const char*> name{};
+    std::atomic<int> label{-1};
+  };
+
+  void Begin_(const char* name, int label, int64_t* index, int* stack_pos);
+  void End_(int64_t index, int stack_pos);
+  auto Intern_(const std::string& label) -> int;
+  void UpdateActive_();
+  void SamplerThreadMain_(microsecs_t end_time, microsecs_t interval);
+  void TakeSample_();
+  void WriteSamples_();
+
+  static LogicProfiler* active_;
+  bool capturing_{};
+  std::vector<Event_> events_;
+  std::vector<std::string> labels_;
+  std::unordered_map<std::string, int> label_indices_;
+  microsecs_t start_time_{};
+  int64_t dropped_events_{};
+  int depth_{};
+
+  // Our open-scope stack, written by the logic thread and read by the
+  // sampler thread. The sequence number is odd while the stack is being
+  // changed so the sampler can retry instead of reading a torn stack.
+  StackFrame_ stack_[kLogicProfilerMaxSampleDepth];
+  std::atomic<int> stack_depth_{};
+  std::atomic<uint32_t> stack_seq_{};
+
+  bool sampling_{};
+  std::atomic<bool> stop_sampling_{};
+  std::thread sampler_thread_;
+  std::string sample_path_;
+
+  // Sample counts per stack (name/label pairs, outermost first). Only
+  // touched by the sampler thread while it's running.
+  std::map<std::vector<std::pair<const char*, int>>, int64_t> samples_;
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_LOGIC_LOGIC_PROFILER_H_
@@ -0,0 +1,196 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/networking/network_conditioner.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/app_mode/app_mode.h"
+#include "ballistica/base/base.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_writer.h"
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/generic/lambda_runnable.h"
+#include "ballistica/shared/generic/timer_list.h"
+#include "ballistica/shared/math/random.h"
+
+namespace ballistica::base {
+
+// How often we check for held packets that are due. Delays come out
+// accurate to about this much.
+const microsecs_t kNetworkConditionerInterval{1000};
+
+void NetworkConditioner::SetConditions(const std::string& address,
+                                       const Conditions& conditions) {
+  assert(g_base->InLogicThread());
+  {
+    std::scoped_lock lock(mutex_);
+    if (address.empty()) {
+      default_conditions_ = conditions;
+      have_default_ = true;
+    } else {
+      conditions_[address] = conditions;
+    }
+    active_ = true;
+  }
+  g_base->network_writer->event_loop()->PushCall([this] { UpdateTimer_(); });
+}
+
+void NetworkConditioner::Clear() {
+  assert(g_base->InLogicThread());
+  {
+    std::scoped_lock lock(mutex_);
+    active_ = false;
+    have_default_ = false;
+    conditions_.clear();
+    links_.clear();
+    stats_ = {};
+  }
+  g_base->network_writer->event_loop()->PushCall([this] {
+    DeliverHeld_(true);
+    UpdateTimer_();
+  });
+}
+
+auto NetworkConditioner::GetStats() -> Stats {
+  std::scoped_lock lock(mutex_);
+  Stats stats = stats_;
+  stats.held = static_cast<int64_t>(held_.size());
+  return stats;
+}
+
+auto NetworkConditioner::Condition(bool outgoing,
+                                   const std::vector<uint8_t>& data,
+                                   const SockAddr& addr) -> bool {
+  std::scoped_lock lock(mutex_);
+  if (!active_) {
+    return true;
+  }
+  std::string address = addr.AddressString();
+  auto i = conditions_.find(address);
+  const Conditions* conditions;
+  if (i != conditions_.end()) {
+    conditions = &i->second;
+  } else if (have_default_) {
+    conditions = &default_conditions_;
+  } else {
+    return true;
+  }
+  stats_.conditioned++;
+
+  auto& random = ThreadRandomStream();
+  if (conditions->loss > 0.0f && random.NextFloat() < conditions->loss) {
+    stats_.dropped++;
+    return false;
+  }
+
+  // With a bandwidth cap, each packet has to wait for the ones ahead of it
+  // to finish 'transmitting' before its own transmit time starts.
+  microsecs_t now = core::CorePlatform::TimeMonotonicMicrosecs();
+  microsecs_t time = now;
+  if (conditions->bandwidth > 0) {
+    auto& link = links_[address];
+    auto& free_time =
+        outgoing ? link.outgoing_free_time : link.incoming_free_time;
+    free_time = std::max(free_time, now);
+    if (free_time - now > kNetworkConditionerMaxBacklog) {
+      stats_.overflowed++;
+      return false;
+    }
+    free_time += static_cast<microsecs_t>(data.size()) * 1000000
+                 / conditions->bandwidth;
+    time = free_time;
+  }
+  time += conditions->latency;
+  if (conditions->jitter > 0) {
+    time += static_cast<microsecs_t>(random.NextFloat()
+                                     * static_cast<float>(conditions->jitter));
+  }
+
+  bool duplicate = conditions->duplicate > 0.0f
+                   && random.NextFloat() < conditions->duplicate;
+  if (duplicate) {
+    stats_.duplicated++;
+
+    // Have the copy trail a bit behind the original.
+    Hold_(time + conditions->jitter + kNetworkConditionerInterval, outgoing,
+          data, addr);
+  }
+
+  // Pass it along as-is if it's not being delayed at all.
+  if (time == now) {
+    return true;
+  }
+  Hold_(time, outgoing, data, addr);
+  return false;
+}
+
+void NetworkConditioner::Hold_(microsecs_t time, bool outgoing,
+                               const std::vector<uint8_t>& data,
+                               const SockAddr& addr) {
+  held_.emplace(time, HeldPacket_{data, addr, outgoing});
+}
+
+void NetworkConditioner::UpdateTimer_() {
+  assert(g_base->network_writer->event_loop()->ThreadIsCurrent());
+  bool want_timer;
+  {
+    std::scoped_lock lock(mutex_);
+    want_timer = active_ || !held_.empty();
+  }
+  auto* event_loop = g_base->network_writer->event_loop();
+  if (want_timer && !timer_) {
+    timer_ = event_loop->NewTimer(kNetworkConditionerInterval, true,
+                                  NewLambdaRunnable([this] {
+                                    DeliverHeld_(false);
+                                    UpdateTimer_();
+                                  }).get());
+  } else if (!want_timer && timer_) {
+    event_loop->DeleteTimer(timer_->id());
+    timer_ = nullptr;
+  }
+}
+
+void NetworkConditioner::DeliverHeld_(bool all) {
+  assert(g_base->network_writer->event_loop()->ThreadIsCurrent());
+  std::vector<std::pair<std::vector<uint8_t>, SockAddr>> outgoing;
+  std::vector<std::pair<std::vector<uint8_t>, SockAddr>> incoming;
+  {
+    std::scoped_lock lock(mutex_);
+    microsecs_t now = core::CorePlatform::TimeMonotonicMicrosecs();
+    auto end = all ? held_.end() : held_.upper_bound(now);
+    for (auto i = held_.begin(); i != end; ++i) {
+      auto& packet = i->second;
+      (packet.outgoing ? outgoing : incoming)
+          .emplace_back(std::move(packet.data), packet.addr);
+    }
+    held_.erase(held_.begin(), end);
+  }
+  if (!outgoing.empty()) {
+    Networking::SendToBatch(outgoing);
+  }
+  if (!incoming.empty()) {
+    auto* logic_loop = g_base->logic->event_loop();
+    if (!logic_loop->CheckPushSafety()) {
+      BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kError,
+                  "Dropping conditioned input packets; logic thread is "
+                  "backed up.");
+      return;
+    }
+    auto* packets = new std::vector<std::pair<std::vector<uint8_t>, SockAddr>>(
+        std::move(incoming));
+    logic_loop->PushCall([packets] {
+      for (auto&& packet : *packets) {
+        g_base->app_mode()->HandleIncomingUDPPacket(packet.first,
+                                                    packet.second);
+      }
+      delete packets;
+    });
+  }
+}
+
+}  // namespace ballistica::base
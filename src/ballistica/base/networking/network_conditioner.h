@@ -0,0 +1,111 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_NETWORKING_NETWORK_CONDITIONER_H_
+#define BALLISTICA_BASE_NETWORKING_NETWORK_CONDITIONER_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/networking/sockaddr.h"
+
+namespace ballistica::base {
+
+/// Most queued-up transmit time a bandwidth-capped link will hold before
+/// it starts dropping packets (like a router's buffer filling up).
+const microsecs_t kNetworkConditionerMaxBacklog{1000000};
+
+/// Simulates a bad network for udp connection traffic so reliability and
+/// jitter handling can be tested without external tools. Outgoing packets
+/// are conditioned in the network-write thread just before hitting the
+/// socket and incoming connection packets are conditioned as the
+/// network-reader hands them off to the logic thread. Delayed packets are
+/// held here and released by a timer in the network-write thread.
+///
+/// Conditions apply separately to each direction, so latency set here
+/// adds twice over to round trip times.
+class NetworkConditioner {
+ public:
+  struct Conditions {
+    /// Constant delay added to each packet.
+    microsecs_t latency{};
+    /// Additional random delay (up to this much) added to each packet.
+    /// Note that this can reorder packets.
+    microsecs_t jitter{};
+    /// Chance (0-1) that a packet is dropped.
+    float loss{};
+    /// Chance (0-1) that a packet is delivered twice.
+    float duplicate{};
+    /// Max bytes per second per address; 0 for no limit.
+    int64_t bandwidth{};
+  };
+
+  struct Stats {
+    int64_t conditioned{};
+    int64_t dropped{};
+    int64_t duplicated{};
+    int64_t overflowed{};
+    int64_t held{};
+  };
+
+  /// Set conditions for traffic to and from an address (ip address only;
+  /// any port). An empty address sets the default for addresses without
+  /// their own conditions. Logic thread only.
+  void SetConditions(const std::string& address, const Conditions& conditions);
+
+  /// Remove all conditions; anything currently held is delivered right
+  /// away. Logic thread only.
+  void Clear();
+
+  /// Returns cumulative stats since the last Clear().
+  auto GetStats() -> Stats;
+
+  /// Whether any conditions are set. Cheap; check this before calling
+  /// Condition().
+  auto active() const -> bool {
+    return active_.load(std::memory_order_relaxed);
+  }
+
+  /// Run a packet through the conditions for its address. Returns true if
+  /// the caller should deliver it as normal; otherwise it has been dropped
+  /// or will be delivered later by us.
+  auto Condition(bool outgoing, const std::vector<uint8_t>& data,
+                 const SockAddr& addr) -> bool;
+
+ private:
+  struct HeldPacket_ {
+    std::vector<uint8_t> data;
+    SockAddr addr;
+    bool outgoing{};
+  };
+
+  struct Link_ {
+    microsecs_t outgoing_free_time{};
+    microsecs_t incoming_free_time{};
+  };
+
+  void Hold_(microsecs_t time, bool outgoing, const std::vector<uint8_t>& data,
+             const SockAddr& addr);
+  void UpdateTimer_();
+  void DeliverHeld_(bool all);
+
+  std::mutex mutex_;
+  std::atomic<bool> active_{};
+  bool have_default_{};
+  Conditions default_conditions_;
+  std::unordered_map<std::string, Conditions> conditions_;
+  std::unordered_map<std::string, Link_> links_;
+  std::multimap<microsecs_t, HeldPacket_> held_;
+  Stats stats_;
+
+  // Only touched in the network-write thread.
+  Timer* timer_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_NETWORKING_NETWORK_CONDITIONER_H_
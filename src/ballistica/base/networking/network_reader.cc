@@ -5,11 +5,13 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_mode/app_mode.h"
 #include "ballistica/base/input/support/remote_app_server.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_writer.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/generic/json.h"
@@ -18,8 +20,13 @@
 
 namespace ballistica::base {
 
+// Most readers we'll run when spreading receive work across threads.
+const int kMaxNetworkReaderThreads{16};
+
 NetworkReader::NetworkReader() = default;
 
+NetworkReader::~NetworkReader() = default;
+
 void NetworkReader::SetPort(int port) {
   assert(g_core->InMainThread());
   // Currently can't switch once this is set.
@@ -27,9 +34,94 @@ void NetworkReader::SetPort(int port) {
     return;
   }
   port4_ = port6_ = port;
+
+  // Servers can opt in to multiple reader threads. This is headless only;
+  // extra readers don't handle app suspension or remote-app traffic.
+  if (g_core->HeadlessMode()) {
+    auto count_env = g_core->platform->GetEnv("BA_NETWORK_READER_THREADS");
+    if (count_env) {
+      reader_count_ =
+          std::clamp(atoi(count_env->c_str()), 1, kMaxNetworkReaderThreads);
+    }
+  }
   thread_ = new std::thread(RunThreadStatic_, this);
 }
 
+void NetworkReader::StartHelpers_() {
+  assert(!helper_ && helpers_.empty());
+  for (int i = 1; i < reader_count_; ++i) {
+    auto helper = std::make_unique<NetworkReader>();
+    helper->helper_ = true;
+    helper->port4_ = port4_;
+    helper->port6_ = port6_;
+    helper->thread_ = new std::thread(RunThreadStatic_, helper.get());
+    helpers_.push_back(std::move(helper));
+  }
+  g_core->Log(LogName::kBaNetworking, LogLevel::kInfo,
+              "Running " + std::to_string(reader_count_)
+                  + " network reader threads on udp port "
+                  + std::to_string(port4_) + ".");
+}
+
+auto NetworkReader::SetReusePort_(int sd) -> bool {
+#ifdef SO_REUSEPORT
+  int on = 1;
+  return setsockopt(sd, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char*>(&on),
+                    sizeof(on))
+         == 0;
+#else
+  return false;
+#endif
+}
+
+auto NetworkReader::OpenReusePortSocket_(int family, int port) -> int {
+  int sd = socket(family, SOCK_DGRAM, 0);
+  if (sd < 0) {
+    return -1;
+  }
+  int result;
+  if (family == AF_INET6) {
+    int on = 1;
+    setsockopt(sd, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&on),
+               sizeof(on));
+  }
+  if (!SetReusePort_(sd)) {
+    g_core->platform->CloseSocket(sd);
+    return -1;
+  }
+  g_core->platform->SetSocketNonBlocking(sd);
+  if (family == AF_INET) {
+    struct sockaddr_in serv_addr{};
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);  // NOLINT
+    serv_addr.sin_port = htons(port);               // NOLINT
+    result = ::bind(sd, (struct sockaddr*)&serv_addr, sizeof(serv_addr));
+  } else {
+    struct sockaddr_in6 serv_addr{};
+    serv_addr.sin6_family = AF_INET6;
+    serv_addr.sin6_port = htons(port);  // NOLINT
+    serv_addr.sin6_addr = in6addr_any;
+    result = ::bind(sd, (struct sockaddr*)&serv_addr, sizeof(serv_addr));
+  }
+  if (result != 0) {
+    g_core->platform->CloseSocket(sd);
+    return -1;
+  }
+  return sd;
+}
+
+void NetworkReader::OpenHelperSockets_() {
+  // This needs to be locked during any socket-descriptor changes/writes.
+  std::scoped_lock lock(sd_mutex_);
+  sd4_ = OpenReusePortSocket_(AF_INET, port4_);
+  sd6_ = OpenReusePortSocket_(AF_INET6, port6_);
+  if (sd4_ == -1 && sd6_ == -1) {
+    BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kError,
+                "Unable to open sockets for extra network reader thread: "
+                    + g_core->platform->GetSocketErrorString());
+  }
+}
+
 void NetworkReader::OnAppSuspend() {
   assert(g_core->InMainThread());
   assert(!paused_);
@@ -185,7 +277,7 @@ void NetworkReader::DoSelect_(bool* can_read_4, bool* can_read_6) {
 auto NetworkReader::RunThread_() -> int {
   g_core->platform->SetCurrentThreadName("ballistica network-read");
 
-  if (!g_core->HeadlessMode()) {
+  if (!g_core->HeadlessMode() && !helper_) {
     remote_server_ = std::make_unique<RemoteAppServer>();
   }
 
@@ -197,14 +289,17 @@ auto NetworkReader::RunThread_() -> int {
       paused_cv_.wait(lock, [this] { return (!paused_); });
     }
 
-    OpenSockets_();
+    if (helper_) {
+      OpenHelperSockets_();
+    } else {
+      OpenSockets_();
+      if (reader_count_ > 1 && helpers_.empty()) {
+        StartHelpers_();
+      }
+    }
 
     // Now just listen and forward messages along.
-    char buffer[10000];
     while (true) {
-      sockaddr_storage from{};
-      socklen_t from_size = sizeof(from);
-
       bool can_read_4{};
       bool can_read_6{};
 
@@ -237,146 +332,19 @@ auto NetworkReader::RunThread_() -> int {
         if (!can_read) {
           continue;
         }
-        ssize_t rresult =
-            recvfrom(sd, buffer, sizeof(buffer), 0,
-                     reinterpret_cast<sockaddr*>(&from), &from_size);
-        if (rresult == 0) {
-          // Note: have gotten reports of server attacks with this log
-          // message repeating. So now only logging this once to eliminate
-          // repeated log overhead and hopefully make the attack less
-          // effective.
-          BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kError,
-                      "NetworkReader Recv got length 0; this shouldn't "
-                      "happen");
-        } else if (rresult == -1) {
-          // This needs to be locked during any sd changes/writes.
-          std::scoped_lock lock(sd_mutex_);
-
-          // If either of our sockets goes down lets close *both* of
-          // them.
-          if (sd4_ != -1) {
-            g_core->platform->CloseSocket(sd4_);
-            sd4_ = -1;
-          }
-          if (sd6_ != -1) {
-            g_core->platform->CloseSocket(sd6_);
-            sd6_ = -1;
-          }
-        } else {
-          assert(from_size >= 0);
-          auto rresult2{static_cast<size_t>(rresult)};
-          // If we get *any* data while paused, kill both our
-          // sockets (we ping ourself for this purpose).
-          if (paused_) {
-            // This needs to be locked during any sd changes/writes.
-            std::scoped_lock lock(sd_mutex_);
-            if (sd4_ != -1) {
-              g_core->platform->CloseSocket(sd4_);
-              sd4_ = -1;
-            }
-            if (sd6_ != -1) {
-              g_core->platform->CloseSocket(sd6_);
-              sd6_ = -1;
-            }
-            break;
-          }
-          switch (buffer[0]) {
-            case BA_PACKET_POKE:
-              break;
-            case BA_PACKET_SIMPLE_PING: {
-              // This needs to be locked during any sd changes/writes.
-              std::scoped_lock lock(sd_mutex_);
-              char msg[1] = {BA_PACKET_SIMPLE_PONG};
-              sendto(sd, msg, 1, 0, reinterpret_cast<sockaddr*>(&from),
-                     from_size);
-              break;
-            }
-            case BA_PACKET_JSON_PING: {
-              if (rresult2 > 1) {
-                std::vector<char> s_buffer(rresult2);
-                memcpy(s_buffer.data(), buffer + 1, rresult2 - 1);
-                s_buffer[rresult2 - 1] = 0;  // terminate string
-                std::string response =
-                    g_base->app_mode()->HandleJSONPing(s_buffer.data());
-                if (!response.empty()) {
-                  std::vector<char> msg(1 + response.size());
-                  msg[0] = BA_PACKET_JSON_PONG;
-                  memcpy(msg.data() + 1, response.c_str(), response.size());
-                  std::scoped_lock lock(sd_mutex_);
-                  sendto(
-                      sd, msg.data(),
-                      static_cast_check_fit<socket_send_length_t>(msg.size()),
-                      0, reinterpret_cast<sockaddr*>(&from), from_size);
-                }
-              }
-              break;
-            }
-            case BA_PACKET_JSON_PONG: {
-              if (rresult2 > 1) {
-                std::vector<char> s_buffer(rresult2);
-                memcpy(s_buffer.data(), buffer + 1, rresult2 - 1);
-                s_buffer[rresult2 - 1] = 0;  // terminate string
-                cJSON* data = cJSON_Parse(s_buffer.data());
-                if (data != nullptr) {
-                  cJSON_Delete(data);
-                }
-              }
-              break;
-            }
-            case BA_PACKET_REMOTE_PING:
-            case BA_PACKET_REMOTE_PONG:
-            case BA_PACKET_REMOTE_ID_REQUEST:
-            case BA_PACKET_REMOTE_ID_RESPONSE:
-            case BA_PACKET_REMOTE_DISCONNECT:
-            case BA_PACKET_REMOTE_STATE:
-            case BA_PACKET_REMOTE_STATE2:
-            case BA_PACKET_REMOTE_STATE_ACK:
-            case BA_PACKET_REMOTE_DISCONNECT_ACK:
-            case BA_PACKET_REMOTE_GAME_QUERY:
-            case BA_PACKET_REMOTE_GAME_RESPONSE:
-              // These packets are associated with the remote app; let the
-              // remote server handle them.
-              if (remote_server_) {
-                remote_server_->HandleData(
-                    sd, reinterpret_cast<uint8_t*>(buffer), rresult2,
-                    reinterpret_cast<sockaddr*>(&from),
-                    static_cast<size_t>(from_size));
-              }
-              break;
-
-            case BA_PACKET_CLIENT_REQUEST:
-            case BA_PACKET_CLIENT_ACCEPT:
-            case BA_PACKET_CLIENT_DENY:
-            case BA_PACKET_CLIENT_DENY_ALREADY_IN_PARTY:
-            case BA_PACKET_CLIENT_DENY_VERSION_MISMATCH:
-            case BA_PACKET_CLIENT_DENY_PARTY_FULL:
-            case BA_PACKET_DISCONNECT_FROM_CLIENT_REQUEST:
-            case BA_PACKET_DISCONNECT_FROM_CLIENT_ACK:
-            case BA_PACKET_DISCONNECT_FROM_HOST_REQUEST:
-            case BA_PACKET_DISCONNECT_FROM_HOST_ACK:
-            case BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED:
-            case BA_PACKET_HOST_GAMEPACKET_COMPRESSED: {
-              // These messages are associated with udp host/client
-              // connections.. pass them to the logic thread to wrangle.
-              std::vector<uint8_t> msg_buffer(rresult2);
-              memcpy(msg_buffer.data(), buffer, rresult2);
-              PushIncomingUDPPacketCall_(msg_buffer, SockAddr(from));
-              break;
-            }
-
-            case BA_PACKET_HOST_QUERY: {
-              g_base->app_mode()->HandleGameQuery(buffer, rresult2, &from);
-
-              // HandleGameQuery(buffer, rresult2, &from);
-              break;
-            }
-
-            default:
-              break;
-          }
+#if BA_ENABLE_SOCKET_MMSG
+        bool keep_reading = ReadPackets_(sd);
+#else
+        bool keep_reading = ReadPacket_(sd);
+#endif
+        if (!keep_reading) {
+          break;
         }
       }
 
+      // Ship off anything bound for connections in one go.
+      PushIncomingUDPPacketsCall_();
+
       // If *both* of our sockets are dead, break out.
       if (sd4_ == -1 && sd6_ == -1) {
         break;
@@ -388,8 +356,217 @@ auto NetworkReader::RunThread_() -> int {
   }
 }
 
-void NetworkReader::PushIncomingUDPPacketCall_(const std::vector<uint8_t>& data,
-                                               const SockAddr& addr) {
+auto NetworkReader::ReadPacket_(int sd) -> bool {
+  sockaddr_storage from{};
+  socklen_t from_size = sizeof(from);
+  char buffer[kRecvBufferSize];
+  ssize_t rresult = recvfrom(sd, buffer, sizeof(buffer), 0,
+                             reinterpret_cast<sockaddr*>(&from), &from_size);
+  if (rresult == -1) {
+    CloseSockets_();
+    return false;
+  }
+  return HandlePacket_(sd, buffer, static_cast<size_t>(rresult), &from,
+                       from_size);
+}
+
+#if BA_ENABLE_SOCKET_MMSG
+auto NetworkReader::ReadPackets_(int sd) -> bool {
+  // Set up our buffers the first time through; we reuse them from then on.
+  if (recv_buffers_.empty()) {
+    recv_buffers_.resize(kRecvBatchSize * kRecvBufferSize);
+    recv_iovecs_.resize(kRecvBatchSize);
+    recv_msgs_.resize(kRecvBatchSize);
+    recv_addrs_.resize(kRecvBatchSize);
+  }
+  for (int i = 0; i < kRecvBatchSize; ++i) {
+    recv_iovecs_[i].iov_base = recv_buffers_.data() + i * kRecvBufferSize;
+    recv_iovecs_[i].iov_len = kRecvBufferSize;
+    memset(&recv_msgs_[i], 0, sizeof(recv_msgs_[i]));
+    recv_msgs_[i].msg_hdr.msg_name = &recv_addrs_[i];
+    recv_msgs_[i].msg_hdr.msg_namelen = sizeof(recv_addrs_[i]);
+    recv_msgs_[i].msg_hdr.msg_iov = &recv_iovecs_[i];
+    recv_msgs_[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // Our sockets are non-blocking so this grabs however many datagrams are
+  // waiting (up to our batch size) and returns immediately.
+  int count =
+      recvmmsg(sd, recv_msgs_.data(), kRecvBatchSize, MSG_DONTWAIT, nullptr);
+  if (count == -1) {
+    // Poll told us there was something to read, so we shouldn't see this,
+    // but it's harmless if we do.
+    int err = g_core->platform->GetSocketError();
+    if (err == EAGAIN || err == EWOULDBLOCK || err == EINTR) {
+      return true;
+    }
+    CloseSockets_();
+    return false;
+  }
+  for (int i = 0; i < count; ++i) {
+    if (!HandlePacket_(sd, recv_buffers_.data() + i * kRecvBufferSize,
+                       recv_msgs_[i].msg_len, &recv_addrs_[i],
+                       recv_msgs_[i].msg_hdr.msg_namelen)) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif  // BA_ENABLE_SOCKET_MMSG
+
+void NetworkReader::CloseSockets_() {
+  // This needs to be locked during any sd changes/writes.
+  std::scoped_lock lock(sd_mutex_);
+
+  // If either of our sockets goes down lets close *both* of them.
+  if (sd4_ != -1) {
+    g_core->platform->CloseSocket(sd4_);
+    sd4_ = -1;
+  }
+  if (sd6_ != -1) {
+    g_core->platform->CloseSocket(sd6_);
+    sd6_ = -1;
+  }
+}
+
+auto NetworkReader::HandlePacket_(int sd, char* buffer, size_t size,
+                                  sockaddr_storage* from, socklen_t from_size)
+    -> bool {
+  if (size == 0) {
+    // Note: have gotten reports of server attacks with this log message
+    // repeating. So now only logging this once to eliminate repeated log
+    // overhead and hopefully make the attack less effective.
+    BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kError,
+                "NetworkReader Recv got length 0; this shouldn't "
+                "happen");
+    return true;
+  }
+
+  // If we get *any* data while paused, kill both our sockets (we ping
+  // ourself for this purpose).
+  if (paused_) {
+    CloseSockets_();
+    return false;
+  }
+
+  switch (buffer[0]) {
+    case BA_PACKET_POKE:
+      break;
+    case BA_PACKET_SIMPLE_PING: {
+      // This needs to be locked during any sd changes/writes.
+      std::scoped_lock lock(sd_mutex_);
+      char msg[1] = {BA_PACKET_SIMPLE_PONG};
+      sendto(sd, msg, 1, 0, reinterpret_cast<sockaddr*>(from), from_size);
+      break;
+    }
+    case BA_PACKET_JSON_PING: {
+      if (size > 1) {
+        std::string response = g_base->app_mode()->HandleJSONPing(
+            std::string(buffer + 1, size - 1));
+        if (!response.empty()) {
+          std::vector<char> msg(1 + response.size());
+          msg[0] = BA_PACKET_JSON_PONG;
+          memcpy(msg.data() + 1, response.c_str(), response.size());
+          std::scoped_lock lock(sd_mutex_);
+          sendto(sd, msg.data(),
+                 static_cast_check_fit<socket_send_length_t>(msg.size()), 0,
+                 reinterpret_cast<sockaddr*>(from), from_size);
+        }
+      }
+      break;
+    }
+    case BA_PACKET_JSON_PONG: {
+      if (size > 1) {
+        std::vector<char> s_buffer(size);
+        memcpy(s_buffer.data(), buffer + 1, size - 1);
+        s_buffer[size - 1] = 0;  // terminate string
+        cJSON* data = cJSON_Parse(s_buffer.data());
+        if (data != nullptr) {
+          cJSON_Delete(data);
+        }
+      }
+      break;
+    }
+    case BA_PACKET_REMOTE_PING:
+    case BA_PACKET_REMOTE_PONG:
+    case BA_PACKET_REMOTE_ID_REQUEST:
+    case BA_PACKET_REMOTE_ID_RESPONSE:
+    case BA_PACKET_REMOTE_DISCONNECT:
+    case BA_PACKET_REMOTE_STATE:
+    case BA_PACKET_REMOTE_STATE2:
+    case BA_PACKET_REMOTE_STATE_ACK:
+    case BA_PACKET_REMOTE_DISCONNECT_ACK:
+    case BA_PACKET_REMOTE_GAME_QUERY:
+    case BA_PACKET_REMOTE_GAME_RESPONSE:
+      // These packets are associated with the remote app; let the remote
+      // server handle them.
+      if (remote_server_) {
+        remote_server_->HandleData(sd, reinterpret_cast<uint8_t*>(buffer),
+                                   size, reinterpret_cast<sockaddr*>(from),
+                                   static_cast<size_t>(from_size));
+      }
+      break;
+
+    case BA_PACKET_CLIENT_REQUEST:
+    case BA_PACKET_CLIENT_ACCEPT:
+    case BA_PACKET_CLIENT_DENY:
+    case BA_PACKET_CLIENT_DENY_ALREADY_IN_PARTY:
+    case BA_PACKET_CLIENT_DENY_VERSION_MISMATCH:
+    case BA_PACKET_CLIENT_DENY_PARTY_FULL:
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_REQUEST:
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_ACK:
+    case BA_PACKET_DISCONNECT_FROM_HOST_REQUEST:
+    case BA_PACKET_DISCONNECT_FROM_HOST_ACK:
+    case BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED:
+    case BA_PACKET_HOST_GAMEPACKET_COMPRESSED: {
+      // These messages are associated with udp host/client connections..
+      // queue them up to pass to the logic thread to wrangle (once we've
+      // made sure they're not junk or part of a flood).
+      if (!packet_filter_.Filter(reinterpret_cast<uint8_t*>(buffer), size,
+                                 *from)) {
+        if (packet_filter_.stats().rate_limited > 0) {
+          BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
+                      "Rate-limiting udp-connection packets from one or more "
+                      "addresses; (could this be a flood attack?).");
+        }
+        break;
+      }
+      std::vector<uint8_t> data(buffer, buffer + size);
+      SockAddr addr(*from);
+
+      // (Unless we're simulating network conditions and they say to drop
+      // or hold it)
+      auto& conditioner = g_base->network_writer->conditioner();
+      if (conditioner.active() && !conditioner.Condition(false, data, addr)) {
+        break;
+      }
+      if (!pending_udp_packets_) {
+        pending_udp_packets_ = new std::vector<IncomingUDPPacket_>();
+      }
+      pending_udp_packets_->push_back({std::move(data), addr});
+      break;
+    }
+
+    case BA_PACKET_HOST_QUERY: {
+      g_base->app_mode()->HandleGameQuery(buffer, size, from);
+      break;
+    }
+
+    default:
+      break;
+  }
+  return true;
+}
+
+void NetworkReader::PushIncomingUDPPacketsCall_() {
+  if (!pending_udp_packets_) {
+    return;
+  }
+
+  // We hand off ownership of this list to the logic thread.
+  auto* packets = pending_udp_packets_;
+  pending_udp_packets_ = nullptr;
+
   // Avoid buffer-full errors if something is causing us to write too often;
   // these are unreliable messages so its ok to just drop them.
   if (!g_base->logic->event_loop()->CheckPushSafety()) {
@@ -397,11 +574,15 @@ void NetworkReader::PushIncomingUDPPacketCall_(const std::vector<uint8_t>& data,
         LogName::kBaNetworking, LogLevel::kError,
         "Ignoring excessive udp-connection input packets; (could this be a "
         "flood attack?).");
+    delete packets;
     return;
   }
 
-  g_base->logic->event_loop()->PushCall([data, addr] {
-    g_base->app_mode()->HandleIncomingUDPPacket(data, addr);
+  g_base->logic->event_loop()->PushCall([packets] {
+    for (auto&& packet : *packets) {
+      g_base->app_mode()->HandleIncomingUDPPacket(packet.data, packet.addr);
+    }
+    delete packets;
   });
 }
 
@@ -428,6 +609,11 @@ void NetworkReader::OpenSockets_() {
                     + g_core->platform->GetSocketErrorString());
   } else {
     g_core->platform->SetSocketNonBlocking(sd4_);
+    if (reader_count_ > 1 && !SetReusePort_(sd4_)) {
+      g_core->Log(LogName::kBaNetworking, LogLevel::kWarning,
+                  "SO_REUSEPORT unavailable; using a single network reader.");
+      reader_count_ = 1;
+    }
 
     // Bind to local server port.
     struct sockaddr_in serv_addr{};
@@ -492,6 +678,9 @@ void NetworkReader::OpenSockets_() {
     }
 
     g_core->platform->SetSocketNonBlocking(sd6_);
+    if (reader_count_ > 1) {
+      SetReusePort_(sd6_);
+    }
     struct sockaddr_in6 serv_addr{};
     memset(&serv_addr, 0, sizeof(serv_addr));
     serv_addr.sin6_family = AF_INET6;
@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/networking/packet_filter.h"
+#include "ballistica/shared/networking/sockaddr.h"
 
 namespace ballistica::base {
 
@@ -20,9 +22,16 @@ namespace ballistica::base {
 // messages (it generally sits blocked in a select() call). Writing to these
 // sockets takes place in other threads; just make sure to lock the mutex and
 // ensure the sockets exist before doing the actual write.
+//
+// Headless servers can also spread receive work across several threads by
+// setting the BA_NETWORK_READER_THREADS env var. Each extra thread gets its
+// own SO_REUSEPORT sockets on our port and the OS divides incoming traffic
+// between them by source address. All writes still go through our own
+// primary sockets.
 class NetworkReader {
  public:
   NetworkReader();
+  ~NetworkReader();
   void SetPort(int port);
   void OnAppSuspend();
   void OnAppUnsuspend();
@@ -36,10 +45,37 @@ class NetworkReader {
   void DoSelect_(bool* can_read_4, bool* can_read_6);
   void DoPoll_(bool* can_read_4, bool* can_read_6);
   void OpenSockets_();
+  void OpenHelperSockets_();
+  void StartHelpers_();
+
+  /// Open a non-blocking udp socket bound to exactly the given port with
+  /// SO_REUSEPORT set. Returns -1 on failure.
+  static auto OpenReusePortSocket_(int family, int port) -> int;
+
+  /// Set SO_REUSEPORT on a socket; returns false if that's not possible.
+  static auto SetReusePort_(int sd) -> bool;
   void PokeSelf_();
   auto RunThread_() -> int;
-  void PushIncomingUDPPacketCall_(const std::vector<uint8_t>& data,
-                                  const SockAddr& addr);
+
+  /// Read a single packet from the socket. Returns false if we should stop
+  /// reading for now.
+  auto ReadPacket_(int sd) -> bool;
+
+#if BA_ENABLE_SOCKET_MMSG
+  /// Read all available packets (up to kRecvBatchSize) from the socket in a
+  /// single syscall. Returns false if we should stop reading for now.
+  auto ReadPackets_(int sd) -> bool;
+#endif
+
+  /// Handle a single packet. Returns false if we should stop reading for
+  /// now.
+  auto HandlePacket_(int sd, char* buffer, size_t size, sockaddr_storage* from,
+                     socklen_t from_size) -> bool;
+  void CloseSockets_();
+
+  /// Pass any queued up connection packets to the logic thread in a single
+  /// call.
+  void PushIncomingUDPPacketsCall_();
   static auto RunThreadStatic_(void* self) -> int {
     return static_cast<NetworkReader*>(self)->RunThread_();
   }
@@ -54,10 +90,33 @@ class NetworkReader {
   int sd4_{-1};
   int sd6_{-1};
   bool paused_{};
+
+  // Whether we're an extra reader spun up by the primary one.
+  bool helper_{};
+  int reader_count_{1};
+  std::vector<std::unique_ptr<NetworkReader>> helpers_;
   std::thread* thread_{};
   std::mutex paused_mutex_;
   std::condition_variable paused_cv_;
   std::unique_ptr<RemoteAppServer> remote_server_;
+  PacketFilter packet_filter_;
+
+  struct IncomingUDPPacket_ {
+    std::vector<uint8_t> data;
+    SockAddr addr;
+  };
+
+  // Packets bound for the logic thread that we've read but not yet sent.
+  std::vector<IncomingUDPPacket_>* pending_udp_packets_{};
+
+  static constexpr int kRecvBufferSize = 10000;
+#if BA_ENABLE_SOCKET_MMSG
+  static constexpr int kRecvBatchSize = 32;
+  std::vector<char> recv_buffers_;
+  std::vector<iovec> recv_iovecs_;
+  std::vector<mmsghdr> recv_msgs_;
+  std::vector<sockaddr_storage> recv_addrs_;
+#endif
 };
 
 }  // namespace ballistica::base
@@ -2,10 +2,14 @@
 
 #include "ballistica/base/networking/network_writer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/base.h"
 #include "ballistica/base/networking/networking.h"
+#include "ballistica/base/support/huffman.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/networking/sockaddr.h"
 
@@ -21,6 +25,12 @@ void NetworkWriter::OnMainThreadStartApp() {
 
 void NetworkWriter::PushSendToCall(const std::vector<uint8_t>& msg,
                                    const SockAddr& addr) {
+  // If a batch is open, just tack this on to it.
+  if (send_batch_depth_ > 0 && g_base->InLogicThread()) {
+    send_batch_.emplace_back(msg, addr);
+    return;
+  }
+
   // Avoid buffer-full errors if something is causing us to write too often;
   // these are unreliable messages so its ok to just drop them.
   if (!event_loop()->CheckPushSafety()) {
@@ -28,10 +38,136 @@ void NetworkWriter::PushSendToCall(const std::vector<uint8_t>& msg,
                 "Excessive send-to calls in net-write-module.");
     return;
   }
-  event_loop()->PushCall([msg, addr] {
+  event_loop()->PushCall([this, msg, addr] {
     assert(g_base->network_reader);
+    if (conditioner_.active() && !conditioner_.Condition(true, msg, addr)) {
+      return;
+    }
     Networking::SendTo(msg, addr);
   });
 }
 
+void NetworkWriter::PushSendToBatchCall(
+    std::vector<std::pair<std::vector<uint8_t>, SockAddr>> packets) {
+  PushBatchCall_(std::move(packets), {});
+}
+
+void NetworkWriter::PushCompressAndSendToCall(
+    const std::vector<uint8_t>& header, const std::vector<uint8_t>& packet,
+    const SockAddr& addr, std::atomic<int64_t>* compressed_bytes) {
+  assert(!packet.empty());
+
+  // Jobs go out as single-entry batches (or as part of an open one) so the
+  // writer thread does the compression in order with everything else.
+  std::vector<uint8_t> data(header.size() + packet.size());
+  if (!header.empty()) {
+    memcpy(data.data(), header.data(), header.size());
+  }
+  memcpy(data.data() + header.size(), packet.data(), packet.size());
+
+  if (send_batch_depth_ > 0 && g_base->InLogicThread()) {
+    send_batch_compress_jobs_.push_back(
+        {send_batch_.size(), header.size(), compressed_bytes});
+    send_batch_.emplace_back(std::move(data), addr);
+    return;
+  }
+  std::vector<std::pair<std::vector<uint8_t>, SockAddr>> packets;
+  packets.emplace_back(std::move(data), addr);
+  PushBatchCall_(std::move(packets), {{0, header.size(), compressed_bytes}});
+}
+
+void NetworkWriter::ConditionPackets_(
+    std::vector<std::pair<std::vector<uint8_t>, SockAddr>>* packets) {
+  if (!conditioner_.active()) {
+    return;
+  }
+  packets->erase(std::remove_if(packets->begin(), packets->end(),
+                                [this](const auto& packet) {
+                                  return !conditioner_.Condition(
+                                      true, packet.first, packet.second);
+                                }),
+                 packets->end());
+}
+
+void NetworkWriter::RunCompressJobs_(
+    std::vector<std::pair<std::vector<uint8_t>, SockAddr>>* packets,
+    const std::vector<CompressJob_>& jobs) {
+  std::vector<uint8_t> compressed;
+  for (auto&& job : jobs) {
+    auto& data = (*packets)[job.index].first;
+    assert(data.size() > job.header_size);
+    g_base->huffman->compress(data.data() + job.header_size,
+                              data.size() - job.header_size, &compressed);
+    data.resize(job.header_size + compressed.size());
+    memcpy(data.data() + job.header_size, compressed.data(),
+           compressed.size());
+    if (job.compressed_bytes) {
+      *job.compressed_bytes += static_cast<int64_t>(compressed.size());
+    }
+  }
+}
+
+void NetworkWriter::PushBatchCall_(
+    std::vector<std::pair<std::vector<uint8_t>, SockAddr>> packets,
+    std::vector<CompressJob_> compress_jobs) {
+  if (packets.empty()) {
+    return;
+  }
+
+  // Avoid buffer-full errors if something is causing us to write too often;
+  // these are unreliable messages so its ok to just drop them.
+  if (!event_loop()->CheckPushSafety()) {
+    BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kError,
+                "Excessive send-to calls in net-write-module.");
+    return;
+  }
+
+  // Hand ownership of the list over to our thread.
+  auto* packets_ptr =
+      new std::vector<std::pair<std::vector<uint8_t>, SockAddr>>(
+          std::move(packets));
+  if (compress_jobs.empty()) {
+    event_loop()->PushCall([this, packets_ptr] {
+      assert(g_base->network_reader);
+      ConditionPackets_(packets_ptr);
+      Networking::SendToBatch(*packets_ptr);
+      delete packets_ptr;
+    });
+    return;
+  }
+  auto* jobs_ptr = new std::vector<CompressJob_>(std::move(compress_jobs));
+  event_loop()->PushCall([this, packets_ptr, jobs_ptr] {
+    assert(g_base->network_reader);
+    RunCompressJobs_(packets_ptr, *jobs_ptr);
+    ConditionPackets_(packets_ptr);
+    Networking::SendToBatch(*packets_ptr);
+    delete jobs_ptr;
+    delete packets_ptr;
+  });
+}
+
+void NetworkWriter::BeginSendBatch() {
+  assert(g_base->InLogicThread());
+  send_batch_depth_++;
+}
+
+void NetworkWriter::EndSendBatch() {
+  assert(g_base->InLogicThread());
+  assert(send_batch_depth_ > 0);
+  send_batch_depth_--;
+  if (send_batch_depth_ == 0 && !send_batch_.empty()) {
+    PushBatchCall_(std::move(send_batch_), std::move(send_batch_compress_jobs_));
+    send_batch_.clear();
+    send_batch_compress_jobs_.clear();
+  }
+}
+
+NetworkWriter::ScopedSendBatch::ScopedSendBatch() {
+  g_base->network_writer->BeginSendBatch();
+}
+
+NetworkWriter::ScopedSendBatch::~ScopedSendBatch() {
+  g_base->network_writer->EndSendBatch();
+}
+
 }  // namespace ballistica::base
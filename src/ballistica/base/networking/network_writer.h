@@ -3,9 +3,13 @@
 #ifndef BALLISTICA_BASE_NETWORKING_NETWORK_WRITER_H_
 #define BALLISTICA_BASE_NETWORKING_NETWORK_WRITER_H_
 
+#include <atomic>
+#include <utility>
 #include <vector>
 
+#include "ballistica/base/networking/network_conditioner.h"
 #include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/networking/sockaddr.h"
 
 namespace ballistica::base {
 
@@ -16,10 +20,76 @@ class NetworkWriter {
   void OnMainThreadStartApp();
 
   void PushSendToCall(const std::vector<uint8_t>& msg, const SockAddr& addr);
+
+  /// Send a set of packets using a single call into the writer thread
+  /// (and as few syscalls as the platform allows).
+  void PushSendToBatchCall(
+      std::vector<std::pair<std::vector<uint8_t>, SockAddr>> packets);
+
+  /// Open/close a send batch (logic thread only). While a batch is open,
+  /// PushSendToCall() calls made from the logic thread accumulate and go
+  /// out together via PushSendToBatchCall() when the outermost batch
+  /// closes. Generally ScopedSendBatch should be used instead of calling
+  /// these directly.
+  void BeginSendBatch();
+  void EndSendBatch();
+
+  /// Huffman-compress a packet in the writer thread and send it with the
+  /// provided (uncompressed) header bytes in front. This is ordered
+  /// relative to all other sends (including batched ones). If a counter
+  /// is passed, the compressed size (not including the header) is added to
+  /// it once known; it must stay valid until calls already pushed to our
+  /// event-loop have run.
+  void PushCompressAndSendToCall(const std::vector<uint8_t>& header,
+                                 const std::vector<uint8_t>& packet,
+                                 const SockAddr& addr,
+                                 std::atomic<int64_t>* compressed_bytes);
+
+  /// Whether connections should hand their game packets to us to compress
+  /// instead of compressing them in the logic thread.
+  auto offload_compression() const { return offload_compression_; }
+  void set_offload_compression(bool val) { offload_compression_ = val; }
+
   auto event_loop() const -> EventLoop* { return event_loop_; }
 
+  /// Simulated network conditions applied to connection traffic (for
+  /// testing). Safe to use from any thread.
+  auto conditioner() -> NetworkConditioner& { return conditioner_; }
+
+  /// Use this to batch all sends made within a scope.
+  class ScopedSendBatch {
+   public:
+    ScopedSendBatch();
+    ~ScopedSendBatch();
+
+   private:
+    BA_DISALLOW_CLASS_COPIES(ScopedSendBatch);
+  };
+
  private:
+  // A batch entry whose data still needs compressing before sending.
+  struct CompressJob_ {
+    size_t index;
+    size_t header_size;
+    std::atomic<int64_t>* compressed_bytes;
+  };
+
+  /// Pull out any packets the conditioner is dropping or holding.
+  void ConditionPackets_(
+      std::vector<std::pair<std::vector<uint8_t>, SockAddr>>* packets);
+  static void RunCompressJobs_(
+      std::vector<std::pair<std::vector<uint8_t>, SockAddr>>* packets,
+      const std::vector<CompressJob_>& jobs);
+  void PushBatchCall_(
+      std::vector<std::pair<std::vector<uint8_t>, SockAddr>> packets,
+      std::vector<CompressJob_> compress_jobs);
+
   EventLoop* event_loop_{};
+  NetworkConditioner conditioner_;
+  int send_batch_depth_{};
+  bool offload_compression_{};
+  std::vector<std::pair<std::vector<uint8_t>, SockAddr>> send_batch_;
+  std::vector<CompressJob_> send_batch_compress_jobs_;
 };
 
 }  // namespace ballistica::base
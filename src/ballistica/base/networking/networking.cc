@@ -2,6 +2,7 @@
 
 #include "ballistica/base/networking/networking.h"
 
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
@@ -56,4 +57,78 @@ void Networking::SendTo(const std::vector<uint8_t>& buffer,
   }
 }
 
+void Networking::SendToBatch(
+    const std::vector<std::pair<std::vector<uint8_t>, SockAddr>>& packets) {
+  assert(g_base->network_reader);
+
+  // This needs to be locked during any sd changes/writes.
+  std::scoped_lock lock(g_base->network_reader->sd_mutex());
+
+#if BA_ENABLE_SOCKET_MMSG
+  // Most we'll hand to a single sendmmsg() call.
+  const size_t kBatchSize = 64;
+  mmsghdr msgs[kBatchSize];
+  iovec iovecs[kBatchSize];
+
+  // sendmmsg() works on a single socket, so do one pass for each of our
+  // ipv4 and ipv6 sockets. (We don't guarantee ordering between v4 and v6
+  // destinations but order is preserved for any single address.)
+  for (bool v6 : {false, true}) {
+    int sd = v6 ? g_base->network_reader->sd6()
+                : g_base->network_reader->sd4();
+
+    // Only send if the relevant socket is currently up; silently ignore
+    // otherwise.
+    if (sd == -1) {
+      continue;
+    }
+    size_t index = 0;
+    while (index < packets.size()) {
+      // Gather up to a batch of packets for this socket.
+      size_t count = 0;
+      for (; index < packets.size() && count < kBatchSize; ++index) {
+        auto& packet = packets[index];
+        assert(!packet.first.empty());
+        if (packet.second.IsV6() != v6) {
+          continue;
+        }
+        iovecs[count].iov_base = const_cast<uint8_t*>(packet.first.data());
+        iovecs[count].iov_len = packet.first.size();
+        memset(&msgs[count], 0, sizeof(msgs[count]));
+        msgs[count].msg_hdr.msg_name =
+            const_cast<sockaddr*>(packet.second.AsSockAddr());
+        msgs[count].msg_hdr.msg_namelen = packet.second.GetSockAddrLen();
+        msgs[count].msg_hdr.msg_iov = &iovecs[count];
+        msgs[count].msg_hdr.msg_iovlen = 1;
+        count++;
+      }
+
+      // Ship them. sendmmsg() can send fewer than we asked for, and, like
+      // SendTo(), we silently skip any individual packet that errors.
+      size_t sent = 0;
+      while (sent < count) {
+        int result = sendmmsg(sd, msgs + sent,
+                              static_cast<unsigned int>(count - sent), 0);
+        if (result <= 0) {
+          sent++;
+        } else {
+          sent += static_cast<size_t>(result);
+        }
+      }
+    }
+  }
+#else
+  for (auto&& packet : packets) {
+    assert(!packet.first.empty());
+    int sd = packet.second.IsV6() ? g_base->network_reader->sd6()
+                                  : g_base->network_reader->sd4();
+    if (sd != -1) {
+      sendto(sd, (const char*)packet.first.data(),
+             static_cast_check_fit<socket_send_length_t>(packet.first.size()),
+             0, packet.second.AsSockAddr(), packet.second.GetSockAddrLen());
+    }
+  }
+#endif  // BA_ENABLE_SOCKET_MMSG
+}
+
 }  // namespace ballistica::base
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_NETWORKING_NETWORKING_H_
 #define BALLISTICA_BASE_NETWORKING_NETWORKING_H_
 
+#include <utility>
 #include <vector>
 
 #include "ballistica/shared/ballistica.h"
@@ -101,6 +102,20 @@ namespace ballistica::base {
 #define BA_MESSAGE_JMESSAGE 20
 #define BA_MESSAGE_CLIENT_PLAYER_PROFILES_JSON 21
 
+// Replay-only; never sent to clients. Contains an int64 base-time and a
+// uint32 message count, followed by that many (uint32 size, data)
+// messages which bring a fresh session to the state at that time.
+#define BA_MESSAGE_REPLAY_KEYFRAME 22
+
+// Same contents as BA_MESSAGE_SESSION_COMMANDS but in SessionCommandCodec's
+// compact form. Only sent to clients that ask for it in their handshake.
+#define BA_MESSAGE_SESSION_COMMANDS_COMPACT 23
+
+// Changes to the party roster in GameRosterCodec's binary form. Only sent
+// to clients that ask for it in their handshake and that have already
+// been sent a full BA_MESSAGE_PARTY_ROSTER.
+#define BA_MESSAGE_PARTY_ROSTER_DELTA 24
+
 #define BA_JMESSAGE_SCREEN_MESSAGE 0
 
 // Enable huffman compression for all net packets?
@@ -123,6 +138,11 @@ class Networking {
   // be more efficient to send a SendToMessage to the NetworkWrite thread which
   // will do this there.
   static void SendTo(const std::vector<uint8_t>& buffer, const SockAddr& addr);
+
+  // Send a set of messages. Where supported this uses sendmmsg() to ship
+  // many packets per syscall. Like SendTo(), this may block briefly.
+  static void SendToBatch(
+      const std::vector<std::pair<std::vector<uint8_t>, SockAddr>>& packets);
   Networking();
 
   // Called on mobile platforms when going into the background, etc
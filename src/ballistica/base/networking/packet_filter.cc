@@ -0,0 +1,136 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/networking/packet_filter.h"
+
+#include <algorithm>
+#include <string>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// Sustained packets per second (and burst size) allowed from a single
+// address. Clients send well under this, but several of them can share
+// an address behind a NAT.
+const float kPacketFilterRate{500.0f};
+const float kPacketFilterBurst{1000.0f};
+
+// Same for connection requests. Clients resend these a few times a second
+// at most while waiting to get in.
+const float kPacketFilterRequestRate{10.0f};
+const float kPacketFilterRequestBurst{20.0f};
+
+auto PacketFilter::SizeIsValid_(const uint8_t* data, size_t size) -> bool {
+  // These mirror what ConnectionSet::HandleIncomingUDPPacket accepts;
+  // anything else it would just ignore anyway.
+  switch (data[0]) {
+    case BA_PACKET_CLIENT_REQUEST:
+      return size > 4;
+    case BA_PACKET_CLIENT_ACCEPT:
+      return size == 3;
+    case BA_PACKET_CLIENT_DENY:
+    case BA_PACKET_CLIENT_DENY_ALREADY_IN_PARTY:
+    case BA_PACKET_CLIENT_DENY_VERSION_MISMATCH:
+    case BA_PACKET_CLIENT_DENY_PARTY_FULL:
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_REQUEST:
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_ACK:
+    case BA_PACKET_DISCONNECT_FROM_HOST_REQUEST:
+      return size == 2;
+    case BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED:
+    case BA_PACKET_HOST_GAMEPACKET_COMPRESSED:
+      return size > 2;
+    default:
+      return false;
+  }
+}
+
+auto PacketFilter::Take_(Bucket_* bucket, microsecs_t now, float rate,
+                         float burst) -> bool {
+  auto elapsed = static_cast<float>(now - bucket->time) / 1000000.0f;
+  bucket->tokens = std::min(burst, bucket->tokens + elapsed * rate);
+  bucket->time = now;
+  if (bucket->tokens < 1.0f) {
+    return false;
+  }
+  bucket->tokens -= 1.0f;
+  return true;
+}
+
+auto PacketFilter::GetAddress_(const sockaddr_storage& from, microsecs_t now)
+    -> Address_* {
+  // Key on raw address bytes; much cheaper than building address strings.
+  std::string key;
+  if (from.ss_family == AF_INET) {
+    auto* addr = reinterpret_cast<const sockaddr_in*>(&from);
+    key.assign(reinterpret_cast<const char*>(&addr->sin_addr),
+               sizeof(addr->sin_addr));
+  } else if (from.ss_family == AF_INET6) {
+    auto* addr = reinterpret_cast<const sockaddr_in6*>(&from);
+    key.assign(reinterpret_cast<const char*>(&addr->sin6_addr),
+               sizeof(addr->sin6_addr));
+  } else {
+    return nullptr;
+  }
+  auto i = addresses_.find(key);
+  if (i != addresses_.end()) {
+    return &i->second;
+  }
+  if (addresses_.size() >= kPacketFilterMaxAddresses) {
+    Prune_(now);
+    if (addresses_.size() >= kPacketFilterMaxAddresses) {
+      return nullptr;
+    }
+  }
+  auto& address = addresses_[key];
+  address.packets = {kPacketFilterBurst, now};
+  address.requests = {kPacketFilterRequestBurst, now};
+  return &address;
+}
+
+void PacketFilter::Prune_(microsecs_t now) {
+  // Don't let a flood from lots of addresses turn this into a full scan
+  // per packet.
+  if (now - last_prune_time_ < 1000000) {
+    return;
+  }
+  last_prune_time_ = now;
+
+  // Anyone who's been quiet long enough to fill both buckets back up
+  // behaves identically to a fresh entry, so we can forget them.
+  auto idle_time = static_cast<microsecs_t>(
+      std::max(kPacketFilterBurst / kPacketFilterRate,
+               kPacketFilterRequestBurst / kPacketFilterRequestRate)
+      * 1000000.0f);
+  for (auto i = addresses_.begin(); i != addresses_.end();) {
+    if (now - std::max(i->second.packets.time, i->second.requests.time)
+        >= idle_time) {
+      i = addresses_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+auto PacketFilter::Filter(const uint8_t* data, size_t size,
+                          const sockaddr_storage& from) -> bool {
+  assert(size > 0);
+  if (!SizeIsValid_(data, size)) {
+    stats_.malformed++;
+    return false;
+  }
+  microsecs_t now = core::CorePlatform::TimeMonotonicMicrosecs();
+  auto* address = GetAddress_(from, now);
+  if (address == nullptr
+      || !Take_(&address->packets, now, kPacketFilterRate, kPacketFilterBurst)
+      || (data[0] == BA_PACKET_CLIENT_REQUEST
+          && !Take_(&address->requests, now, kPacketFilterRequestRate,
+                    kPacketFilterRequestBurst))) {
+    stats_.rate_limited++;
+    return false;
+  }
+  stats_.passed++;
+  return true;
+}
+
+}  // namespace ballistica::base
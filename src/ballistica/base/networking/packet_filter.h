@@ -0,0 +1,65 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_NETWORKING_PACKET_FILTER_H_
+#define BALLISTICA_BASE_NETWORKING_PACKET_FILTER_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/networking/networking_sys.h"
+
+namespace ballistica::base {
+
+/// Most source addresses we track rate limits for at once. Past this we
+/// prune idle ones, and if that doesn't free anything up we turn away
+/// packets from new addresses until it does.
+const size_t kPacketFilterMaxAddresses{4096};
+
+/// Cheap checks run on udp-connection packets in the network-reader
+/// thread before they get copied and queued for the logic thread, so junk
+/// and floods get thrown out without costing the logic thread anything.
+/// Checks that packet sizes match what their types call for and applies
+/// per-source-address (ip only; any port) token-bucket rate limits, with
+/// a separate much tighter limit on connection requests.
+///
+/// Network-reader thread only.
+class PacketFilter {
+ public:
+  struct Stats {
+    int64_t passed{};
+    int64_t malformed{};
+    int64_t rate_limited{};
+  };
+
+  /// Returns true if the packet should go on to the logic thread.
+  auto Filter(const uint8_t* data, size_t size, const sockaddr_storage& from)
+      -> bool;
+
+  auto stats() const -> const Stats& { return stats_; }
+
+ private:
+  struct Bucket_ {
+    float tokens{};
+    microsecs_t time{};
+  };
+
+  struct Address_ {
+    Bucket_ packets;
+    Bucket_ requests;
+  };
+
+  static auto SizeIsValid_(const uint8_t* data, size_t size) -> bool;
+  static auto Take_(Bucket_* bucket, microsecs_t now, float rate, float burst)
+      -> bool;
+  auto GetAddress_(const sockaddr_storage& from, microsecs_t now) -> Address_*;
+  void Prune_(microsecs_t now);
+
+  std::unordered_map<std::string, Address_> addresses_;
+  microsecs_t last_prune_time_{};
+  Stats stats_;
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_NETWORKING_PACKET_FILTER_H_
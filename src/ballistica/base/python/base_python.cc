@@ -6,6 +6,8 @@
 #include <vector>
 
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/base/logic/logic_profiler.h"
 #include "ballistica/base/python/class/python_class_app_timer.h"
 #include "ballistica/base/python/class/python_class_context_call.h"
 #include "ballistica/base/python/class/python_class_context_ref.h"
@@ -17,6 +19,7 @@
 #include "ballistica/base/python/methods/python_methods_base_1.h"
 #include "ballistica/base/python/methods/python_methods_base_2.h"
 #include "ballistica/base/python/methods/python_methods_base_3.h"
+#include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/python/python_command.h"  // IWYU pragma: keep.
 #include "ballistica/shared/python/python_module_builder.h"
 
@@ -187,6 +190,39 @@ void BasePython::OnScreenSizeChange() {
 
 void BasePython::StepDisplayTime() { assert(g_base->InLogicThread()); }
 
+void BasePython::RunIdleGarbageCollection(microsecs_t step_start_time) {
+  assert(g_base->InLogicThread());
+  if (!idle_garbage_collection_enabled_) {
+    return;
+  }
+
+  // Only go for it if the step used less than half of its slot.
+  microsecs_t elapsed =
+      core::CorePlatform::TimeMonotonicMicrosecs() - step_start_time;
+  if (elapsed > g_base->logic->display_time_increment_microsecs() / 2) {
+    return;
+  }
+  if (!gc_collect_call_.exists()) {
+    auto gc = PythonRef::Stolen(PyImport_ImportModule("gc"));
+    gc_collect_call_ = gc.GetAttr("collect");
+    gc_get_count_call_ = gc.GetAttr("get_count");
+  }
+  auto count = gc_get_count_call_.Call();
+  if (!count.exists() || !PyTuple_Check(count.get())
+      || PyTuple_GET_SIZE(count.get()) < 1
+      || PyLong_AsLong(PyTuple_GET_ITEM(count.get(), 0))
+             < kIdleGarbageCollectThreshold) {
+    return;
+  }
+  idle_garbage_collect_passes_++;
+  int generation =
+      idle_garbage_collect_passes_ % kIdleGarbageCollectGen1Interval == 0 ? 1
+                                                                          : 0;
+  LogicProfiler::Scope profile_scope("gc");
+  PythonRef args(Py_BuildValue("(i)", generation), PythonRef::kSteal);
+  gc_collect_call_.Call(args);
+}
+
 void BasePython::EnsureContextAllowsDefaultTimerTypes() {
   auto& cref = g_base->CurrentContext();
   if (auto* context = cref.Get()) {
@@ -12,6 +12,13 @@
 
 namespace ballistica::base {
 
+/// Young objects piling up in generation 0 before an idle collection pass
+/// is considered (matches Python's default automatic threshold).
+const int kIdleGarbageCollectThreshold{700};
+
+/// Every this-many idle generation-0 passes also sweeps generation 1.
+const int kIdleGarbageCollectGen1Interval{10};
+
 /// General Python support class for the base feature-set.
 class BasePython {
  public:
@@ -27,6 +34,16 @@ class BasePython {
   void OnScreenSizeChange();
   void StepDisplayTime();
 
+  /// Run a young-generation garbage collection pass if enough has piled
+  /// up and the display-time step begun at the provided time left enough
+  /// slack for one. Automatic collection is disabled at startup and full
+  /// collections happen at session transitions; this keeps reference
+  /// loops from piling up in between without hitching mid-step.
+  void RunIdleGarbageCollection(microsecs_t step_start_time);
+  void set_idle_garbage_collection_enabled(bool val) {
+    idle_garbage_collection_enabled_ = val;
+  }
+
   void OnAppActiveChanged();
 
   void Reset();
@@ -184,6 +201,10 @@ class BasePython {
  private:
   std::set<std::string> do_once_locations_;
   PythonObjectSet<ObjID> objs_;
+  PythonRef gc_collect_call_;
+  PythonRef gc_get_count_call_;
+  bool idle_garbage_collection_enabled_{true};
+  int idle_garbage_collect_passes_{};
   float last_screen_res_x_{-1.0f};
   float last_screen_res_y_{-1.0f};
 };
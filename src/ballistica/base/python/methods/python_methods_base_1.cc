@@ -9,11 +9,13 @@
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/app_mode/empty_app_mode.h"
+#include "ballistica/base/assets/assets.h"
 #include "ballistica/base/audio/audio_server.h"
 #include "ballistica/base/graphics/graphics_server.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/python/support/python_context_call_runnable.h"
+#include "ballistica/base/support/app_config.h"
 #include "ballistica/base/ui/dev_console.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/core/platform/core_platform.h"
@@ -591,54 +593,8 @@ static auto PyCommitConfig(PyObject* self, PyObject* args, PyObject* keywds)
   if (config_obj == nullptr || !g_base->python->IsPyLString(config_obj)) {
     throw Exception("ERROR ON JSON DUMP");
   }
-  std::string final_str = g_base->python->GetPyLString(config_obj);
-  std::string path = g_core->platform->GetConfigFilePath();
-  std::string path_temp = path + ".tmp";
-  std::string path_prev = path + ".prev";
-  if (explicit_bool(true)) {
-    FILE* f_out = g_core->platform->FOpen(path_temp.c_str(), "wb");
-    if (f_out == nullptr) {
-      throw Exception("Error opening config file for writing: '" + path_temp
-                      + "': " + g_core->platform->GetErrnoString());
-    }
-
-    // Write to temp file.
-    size_t result = fwrite(&final_str[0], final_str.size(), 1, f_out);
-    if (result != 1) {
-      fclose(f_out);
-      throw Exception("Error writing config file to '" + path_temp
-                      + "': " + g_core->platform->GetErrnoString());
-    }
-    fclose(f_out);
-
-    // Now move any existing config to .prev.
-    if (g_core->platform->FilePathExists(path)) {
-      // On windows, rename doesn't overwrite existing files.. need to kill
-      // the old explicitly.
-      // (hmm; should we just do this everywhere for consistency?)
-      if (g_buildconfig.ostype_windows()) {
-        if (g_core->platform->FilePathExists(path_prev)) {
-          int result2 = g_core->platform->Remove(path_prev.c_str());
-          if (result2 != 0) {
-            throw Exception("Error removing prev config file '" + path_prev
-                            + "': " + g_core->platform->GetErrnoString());
-          }
-        }
-      }
-      int result2 = g_core->platform->Rename(path.c_str(), path_prev.c_str());
-      if (result2 != 0) {
-        throw Exception("Error backing up config file to '" + path_prev
-                        + "': " + g_core->platform->GetErrnoString());
-      }
-    }
-
-    // Now move temp into place.
-    int result2 = g_core->platform->Rename(path_temp.c_str(), path.c_str());
-    if (result2 != 0) {
-      throw Exception("Error renaming temp config file to final '" + path
-                      + "': " + g_core->platform->GetErrnoString());
-    }
-  }
+  g_base->app_config->CommitFileContents(
+      g_base->python->GetPyLString(config_obj));
   Py_RETURN_NONE;
   BA_PYTHON_CATCH;
 }
@@ -1594,6 +1550,50 @@ static PyMethodDef PyAudioShutdownIsCompleteDef = {
     "(internal)\n",
 };
 
+// ----------------------------- get_audio_stats -------------------------------
+
+static auto PyGetAudioStats(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  auto stats = g_base->audio_server->GetStats(static_cast<bool>(reset));
+  auto as_ll = [](int64_t val) {
+    return static_cast<long long>(val);  // NOLINT
+  };
+  return Py_BuildValue(
+      "{sLsLsLsisisisisLsLsLsLsL}", "process_count",
+      as_ll(stats.process_count), "process_time_total_us",
+      as_ll(stats.process_time_total), "process_time_max_us",
+      as_ll(stats.process_time_max), "sources", stats.source_count,
+      "active_sources", stats.active_source_count, "streaming_sources",
+      stats.streaming_source_count, "pending_loads",
+      g_base->assets->GetSoundPendingLoadCount(), "stream_underruns",
+      as_ll(stats.stream_underruns), "stream_decode_misses",
+      as_ll(stats.stream_decode_misses), "al_errors", as_ll(stats.al_errors),
+      "culled_voices", as_ll(stats.culled_voices), "stolen_voices",
+      as_ll(stats.stolen_voices));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetAudioStatsDef = {
+    "get_audio_stats",             // name
+    (PyCFunction)PyGetAudioStats,  // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "get_audio_stats(reset: bool = False) -> dict[str, int]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return audio-thread counters. Totals are since the last reset;\n"
+    "source and pending-load counts are current.",
+};
+
 // ----------------------- graphics_shutdown_begin -----------------------------
 
 static auto PyGraphicsShutdownBegin(PyObject* self) -> PyObject* {
@@ -1720,6 +1720,7 @@ auto PythonMethodsBase1::GetMethods() -> std::vector<PyMethodDef> {
       PyDevConsoleInputAdapterFinishDef,
       PyAudioShutdownBeginDef,
       PyAudioShutdownIsCompleteDef,
+      PyGetAudioStatsDef,
       PyGraphicsShutdownBeginDef,
       PyGraphicsShutdownIsCompleteDef,
       PyInvokeMainMenuDef,
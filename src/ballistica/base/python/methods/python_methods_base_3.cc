@@ -9,9 +9,13 @@
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/app_mode/app_mode.h"
+#include "ballistica/base/assets/assets.h"
 #include "ballistica/base/assets/sound_asset.h"  // IWYU pragma: keep.
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/input/input.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/base/logic/logic_profiler.h"
+#include "ballistica/base/networking/network_writer.h"
 #include "ballistica/base/platform/base_platform.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/python/class/python_class_simple_sound.h"
@@ -19,7 +23,11 @@
 #include "ballistica/base/ui/dev_console.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/thread_trace.h"
+#include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/foundation/macros.h"
+#include "ballistica/shared/foundation/memory_accounting.h"
+#include "ballistica/shared/foundation/object_census.h"
 #include "ballistica/shared/generic/native_stack_trace.h"  // IWYU pragma: keep.
 #include "ballistica/shared/generic/utils.h"
 
@@ -1928,6 +1936,39 @@ static PyMethodDef PyOpenFileExternallyDef = {
     "Open the provided file in the default external app.",
 };
 
+// --------------------------- write_render_profile ----------------------------
+
+static auto PyWriteRenderProfile(PyObject* self, PyObject* args,
+                                 PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+
+  BA_PRECONDITION(g_base->InLogicThread());
+  char* path = nullptr;
+  static const char* kwlist[] = {"path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &path)) {
+    return nullptr;
+  }
+  g_base->graphics->WriteRenderProfile(path);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyWriteRenderProfileDef = {
+    "write_render_profile",             // name
+    (PyCFunction)PyWriteRenderProfile,  // method
+    METH_VARARGS | METH_KEYWORDS,       // flags
+
+    "write_render_profile(path: str) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Write recent per-frame render timings to a CSV file.\n"
+    "\n"
+    "Timings are only recorded while the 'Show Render Profile' config\n"
+    "value is enabled.",
+};
+
 // --------------------------- get_input_idle_time -----------------------------
 
 static auto PyGetInputIdleTime(PyObject* self) -> PyObject* {
@@ -2090,6 +2131,828 @@ static PyMethodDef PyUpdateInternalLoggerLevelsDef = {
     "logger levels are changed at runtime, call this method after to\n"
     "instruct the native layer to regenerate its cache so the change\n"
     "is properly reflected in logs originating from the native layer."};
+
+// --------------------- set_event_loop_metrics_enabled ------------------------
+
+static auto PySetEventLoopMetricsEnabled(PyObject* self, PyObject* args,
+                                         PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int enabled;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enabled)) {
+    return nullptr;
+  }
+  EventLoop::SetMetricsEnabled(static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetEventLoopMetricsEnabledDef = {
+    "set_event_loop_metrics_enabled",           // name
+    (PyCFunction)PySetEventLoopMetricsEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,               // flags
+
+    "set_event_loop_metrics_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Turn gathering of event-loop latency/queue metrics on or off.",
+};
+
+// --------------------- get_event_loop_metrics_enabled ------------------------
+
+static auto PyGetEventLoopMetricsEnabled(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  if (EventLoop::metrics_enabled()) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetEventLoopMetricsEnabledDef = {
+    "get_event_loop_metrics_enabled",           // name
+    (PyCFunction)PyGetEventLoopMetricsEnabled,  // method
+    METH_NOARGS,                                // flags
+
+    "get_event_loop_metrics_enabled() -> bool\n"
+    "\n"
+    "(internal)",
+};
+
+// ------------------------- get_event_loop_metrics ----------------------------
+
+static auto PyGetEventLoopMetrics(PyObject* self, PyObject* args,
+                                  PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  auto result = PythonRef::Stolen(PyDict_New());
+  for (auto* event_loop : EventLoop::GetAllEventLoops()) {
+    auto metrics = event_loop->GetMetrics(static_cast<bool>(reset));
+    auto histogram = PythonRef::Stolen(PyList_New(0));
+    for (int i = 0; i < kEventLoopLatencyBucketCount; ++i) {
+      auto count = PythonRef::Stolen(
+          PyLong_FromLongLong(metrics.latency_counts[i]));  // NOLINT
+      PyList_Append(histogram.get(), count.get());
+    }
+    auto sources = PythonRef::Stolen(PyDict_New());
+    for (auto&& i : metrics.sources) {
+      auto count = static_cast<long long>(i.second.count);         // NOLINT
+      auto total_time = static_cast<long long>(i.second.total_time);  // NOLINT
+      auto max_time = static_cast<long long>(i.second.max_time);      // NOLINT
+      auto source = PythonRef::Stolen(
+          Py_BuildValue("{sLsLsL}", "count", count, "total_us", total_time,
+                        "max_us", max_time));
+      PyDict_SetItemString(
+          sources.get(), g_core->platform->DemangleCXXSymbol(i.first).c_str(),
+          source.get());
+    }
+    auto entry = PythonRef::Stolen(Py_BuildValue(
+        "{sLsLsLsLsLsOsO}", "calls",
+        static_cast<long long>(metrics.call_count),  // NOLINT
+        "latency_total_us",
+        static_cast<long long>(metrics.latency_total),  // NOLINT
+        "latency_max_us",
+        static_cast<long long>(metrics.latency_max),  // NOLINT
+        "queue_depth",
+        static_cast<long long>(event_loop->GetQueueDepth()),  // NOLINT
+        "queue_depth_max",
+        static_cast<long long>(metrics.queue_depth_max),  // NOLINT
+        "latency_histogram", histogram.get(), "sources", sources.get()));
+    PyDict_SetItemString(result.get(), event_loop->name().c_str(),
+                         entry.get());
+  }
+  return result.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetEventLoopMetricsDef = {
+    "get_event_loop_metrics",            // name
+    (PyCFunction)PyGetEventLoopMetrics,  // method
+    METH_VARARGS | METH_KEYWORDS,        // flags
+
+    "get_event_loop_metrics(reset: bool = False)"
+    " -> dict[str, dict[str, Any]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return metrics gathered for each event-loop (keyed by loop name)\n"
+    "while set_event_loop_metrics_enabled() is on. 'latency_histogram'\n"
+    "counts calls by time from push to run, with bucket upper bounds\n"
+    "given by get_event_loop_latency_bucket_bounds(); 'sources' gives\n"
+    "run time per callable type.",
+};
+
+// ------------------ get_event_loop_latency_bucket_bounds ---------------------
+
+static auto PyGetEventLoopLatencyBucketBounds(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  auto result = PythonRef::Stolen(PyList_New(0));
+  for (auto bound : kEventLoopLatencyBucketBounds) {
+    auto val = PythonRef::Stolen(PyLong_FromLongLong(bound));  // NOLINT
+    PyList_Append(result.get(), val.get());
+  }
+  return result.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetEventLoopLatencyBucketBoundsDef = {
+    "get_event_loop_latency_bucket_bounds",          // name
+    (PyCFunction)PyGetEventLoopLatencyBucketBounds,  // method
+    METH_NOARGS,                                     // flags
+
+    "get_event_loop_latency_bucket_bounds() -> list[int]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return upper bounds in microseconds for event-loop latency buckets.\n"
+    "The final bucket (not included here) holds everything beyond them.",
+};
+
+// --------------------- set_logic_profiling_enabled ---------------------------
+
+static auto PySetLogicProfilingEnabled(PyObject* self, PyObject* args,
+                                       PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int enabled;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enabled)) {
+    return nullptr;
+  }
+  g_base->logic->profiler().SetEnabled(static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetLogicProfilingEnabledDef = {
+    "set_logic_profiling_enabled",            // name
+    (PyCFunction)PySetLogicProfilingEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,             // flags
+
+    "set_logic_profiling_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Start a new logic-thread profile capture (discarding any previous\n"
+    "one) or stop the current one.",
+};
+
+// ------------------------- write_logic_profile -------------------------------
+
+static auto PyWriteLogicProfile(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  const char* path;
+  static const char* kwlist[] = {"path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &path)) {
+    return nullptr;
+  }
+  auto count = g_base->logic->profiler().WriteChromeTrace(path);
+  return PyLong_FromSize_t(count);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyWriteLogicProfileDef = {
+    "write_logic_profile",             // name
+    (PyCFunction)PyWriteLogicProfile,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "write_logic_profile(path: str) -> int\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Write the current logic-thread profile capture to a file as Chrome\n"
+    "trace-event json (for chrome://tracing or Perfetto) and return the\n"
+    "number of events written. Python calls are named by where they were\n"
+    "created and carry the 'python' category.",
+};
+
+// ------------------------- start_logic_sampling ------------------------------
+
+static auto PyStartLogicSampling(PyObject* self, PyObject* args,
+                                 PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  const char* path;
+  double duration{30.0};
+  double interval{0.001};
+  static const char* kwlist[] = {"path", "duration", "interval", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s|dd",
+                                   const_cast<char**>(kwlist), &path,
+                                   &duration, &interval)) {
+    return nullptr;
+  }
+  g_base->logic->profiler().StartSampling(
+      path, duration, static_cast<microsecs_t>(interval * 1000000.0));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartLogicSamplingDef = {
+    "start_logic_sampling",             // name
+    (PyCFunction)PyStartLogicSampling,  // method
+    METH_VARARGS | METH_KEYWORDS,       // flags
+
+    "start_logic_sampling(path: str, duration: float = 30.0,\n"
+    "  interval: float = 0.001) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Sample what the logic thread is up to every interval seconds for\n"
+    "duration seconds and then write the results to a file as folded\n"
+    "stacks (for flamegraph.pl, speedscope, etc.). Python calls show up\n"
+    "under where they were created. Cheap enough for live servers.",
+};
+
+// -------------------------- stop_logic_sampling ------------------------------
+
+static auto PyStopLogicSampling(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  return PyLong_FromLongLong(g_base->logic->profiler().StopSampling());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStopLogicSamplingDef = {
+    "stop_logic_sampling",             // name
+    (PyCFunction)PyStopLogicSampling,  // method
+    METH_NOARGS,                       // flags
+
+    "stop_logic_sampling() -> int\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Stop logic sampling early (if it is running), write results, and\n"
+    "return the number of samples written.",
+};
+
+// ----------------------- set_memory_accounting_enabled -----------------------
+
+static auto PySetMemoryAccountingEnabled(PyObject* self, PyObject* args,
+                                         PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int enabled;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enabled)) {
+    return nullptr;
+  }
+  MemoryAccounting::SetEnabled(static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetMemoryAccountingEnabledDef = {
+    "set_memory_accounting_enabled",            // name
+    (PyCFunction)PySetMemoryAccountingEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,               // flags
+
+    "set_memory_accounting_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Start tallying native allocations by subsystem (discarding any\n"
+    "previous tallies) or stop.",
+};
+
+// ----------------------- get_memory_accounting_enabled -----------------------
+
+static auto PyGetMemoryAccountingEnabled(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  if (MemoryAccounting::enabled()) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetMemoryAccountingEnabledDef = {
+    "get_memory_accounting_enabled",            // name
+    (PyCFunction)PyGetMemoryAccountingEnabled,  // method
+    METH_NOARGS,                                // flags
+
+    "get_memory_accounting_enabled() -> bool\n"
+    "\n"
+    "(internal)",
+};
+
+// --------------------------- get_memory_accounting ---------------------------
+
+static auto PyGetMemoryAccounting(PyObject* self, PyObject* args,
+                                  PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  auto report = MemoryAccounting::GetReport(static_cast<bool>(reset));
+  auto tags = PythonRef::Stolen(PyDict_New());
+  for (auto&& entry : report.entries) {
+    auto tag = PythonRef::Stolen(Py_BuildValue(
+        "{sLsLsLsLsL}", "live_bytes",
+        static_cast<long long>(entry.live_bytes),  // NOLINT
+        "live_count",
+        static_cast<long long>(entry.live_count),  // NOLINT
+        "alloc_bytes",
+        static_cast<long long>(entry.alloc_bytes),  // NOLINT
+        "alloc_count",
+        static_cast<long long>(entry.alloc_count),  // NOLINT
+        "free_count",
+        static_cast<long long>(entry.free_count)));  // NOLINT
+    PyDict_SetItemString(tags.get(), entry.tag.c_str(), tag.get());
+  }
+
+  // Assets hold their memory in ways the above can't see, so we report
+  // their own estimates alongside.
+  auto assets = PythonRef::Stolen(PyDict_New());
+  for (auto&& usage : g_base->assets->GetMemoryUsage()) {
+    auto asset = PythonRef::Stolen(Py_BuildValue(
+        "{sLsL}", "count", static_cast<long long>(usage.count),  // NOLINT
+        "bytes", static_cast<long long>(usage.bytes)));          // NOLINT
+    PyDict_SetItemString(assets.get(), usage.name, asset.get());
+  }
+  return Py_BuildValue("{sdsOsO}", "duration", report.duration, "tags",
+                       tags.get(), "assets", assets.get());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetMemoryAccountingDef = {
+    "get_memory_accounting",             // name
+    (PyCFunction)PyGetMemoryAccounting,  // method
+    METH_VARARGS | METH_KEYWORDS,        // flags
+
+    "get_memory_accounting(reset: bool = False) -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return native memory tallies gathered while\n"
+    "set_memory_accounting_enabled() is on. 'tags' gives live and\n"
+    "allocated bytes/counts by subsystem tag (Object types are tagged by\n"
+    "type name) with alloc/free tallies covering 'duration' seconds;\n"
+    "'assets' gives current estimates for each asset type. Resetting\n"
+    "restarts the alloc/free tallies.",
+};
+
+// ---------------------------- mark_startup_phase -----------------------------
+
+static auto PyMarkStartupPhase(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* name;
+  static const char* kwlist[] = {"name", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &name)) {
+    return nullptr;
+  }
+  g_core->MarkStartupPhase(name);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyMarkStartupPhaseDef = {
+    "mark_startup_phase",             // name
+    (PyCFunction)PyMarkStartupPhase,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "mark_startup_phase(name: str) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Note that a startup phase has just completed. These are logged\n"
+    "together with their durations once the app is running.",
+};
+
+// ---------------------------- get_startup_phases -----------------------------
+
+static auto PyGetStartupPhases(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  auto phases = g_core->GetStartupPhases();
+  auto list = PythonRef::Stolen(PyList_New(0));
+  for (auto&& phase : phases) {
+    auto entry = PythonRef::Stolen(
+        Py_BuildValue("(sd)", phase.first.c_str(), phase.second));
+    PyList_Append(list.get(), entry.get());
+  }
+  return list.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetStartupPhasesDef = {
+    "get_startup_phases",             // name
+    (PyCFunction)PyGetStartupPhases,  // method
+    METH_NOARGS,                      // flags
+
+    "get_startup_phases() -> list[tuple[str, float]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return startup phases marked so far and when each completed (in\n"
+    "seconds since the engine core was created).",
+};
+
+// -------------------------- set_network_conditions ---------------------------
+
+static auto PySetNetworkConditions(PyObject* self, PyObject* args,
+                                   PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* address{};
+  double latency{};
+  double jitter{};
+  float loss{};
+  float duplicate{};
+  long long bandwidth{};  // NOLINT
+  static const char* kwlist[] = {"address",   "latency",   "jitter", "loss",
+                                 "duplicate", "bandwidth", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "|zddffL", const_cast<char**>(kwlist), &address,
+          &latency, &jitter, &loss, &duplicate, &bandwidth)) {
+    return nullptr;
+  }
+  if (latency < 0.0 || jitter < 0.0 || bandwidth < 0) {
+    throw Exception("latency, jitter and bandwidth must be >= 0.",
+                    PyExcType::kValue);
+  }
+  if (loss < 0.0f || loss > 1.0f || duplicate < 0.0f || duplicate > 1.0f) {
+    throw Exception("loss and duplicate must be between 0 and 1.",
+                    PyExcType::kValue);
+  }
+  base::NetworkConditioner::Conditions conditions;
+  conditions.latency = static_cast<microsecs_t>(latency * 1000000.0);
+  conditions.jitter = static_cast<microsecs_t>(jitter * 1000000.0);
+  conditions.loss = loss;
+  conditions.duplicate = duplicate;
+  conditions.bandwidth = bandwidth;
+  g_base->network_writer->conditioner().SetConditions(address ? address : "",
+                                                      conditions);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetNetworkConditionsDef = {
+    "set_network_conditions",             // name
+    (PyCFunction)PySetNetworkConditions,  // method
+    METH_VARARGS | METH_KEYWORDS,         // flags
+
+    "set_network_conditions(address: str | None = None,\n"
+    "  latency: float = 0.0,\n"
+    "  jitter: float = 0.0,\n"
+    "  loss: float = 0.0,\n"
+    "  duplicate: float = 0.0,\n"
+    "  bandwidth: int = 0)\n"
+    "  -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Simulate a bad network for connection traffic (for testing).\n"
+    "\n"
+    "Applies to packets to and from the given ip address, or to all\n"
+    "addresses without their own conditions if address is None. Latency\n"
+    "and jitter are in seconds and apply to each direction separately,\n"
+    "loss and duplicate are chances from 0 to 1, and bandwidth is bytes\n"
+    "per second (0 for unlimited). Conditions stay in effect until\n"
+    "clear_network_conditions() is called.",
+};
+
+// ------------------------- clear_network_conditions --------------------------
+
+static auto PyClearNetworkConditions(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  g_base->network_writer->conditioner().Clear();
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyClearNetworkConditionsDef = {
+    "clear_network_conditions",             // name
+    (PyCFunction)PyClearNetworkConditions,  // method
+    METH_NOARGS,                            // flags
+
+    "clear_network_conditions() -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Remove all simulated network conditions. Any packets being held\n"
+    "back are delivered immediately.",
+};
+
+// ----------------------- get_network_conditions_stats ------------------------
+
+static auto PyGetNetworkConditionsStats(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  auto stats = g_base->network_writer->conditioner().GetStats();
+  return Py_BuildValue(
+      "{sLsLsLsLsL}", "conditioned",
+      static_cast<long long>(stats.conditioned),  // NOLINT
+      "dropped",
+      static_cast<long long>(stats.dropped),  // NOLINT
+      "duplicated",
+      static_cast<long long>(stats.duplicated),  // NOLINT
+      "overflowed",
+      static_cast<long long>(stats.overflowed),  // NOLINT
+      "held",
+      static_cast<long long>(stats.held));  // NOLINT
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNetworkConditionsStatsDef = {
+    "get_network_conditions_stats",            // name
+    (PyCFunction)PyGetNetworkConditionsStats,  // method
+    METH_NOARGS,                               // flags
+
+    "get_network_conditions_stats() -> dict[str, int]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return packet counts from simulated network conditions since they\n"
+    "were last cleared: 'conditioned' (packets that had conditions\n"
+    "applied), 'dropped' (by simulated loss), 'duplicated',\n"
+    "'overflowed' (dropped by a full bandwidth-capped link) and 'held'\n"
+    "(currently waiting to be delivered).",
+};
+
+// ------------------------- set_object_census_enabled -------------------------
+
+static auto PySetObjectCensusEnabled(PyObject* self, PyObject* args,
+                                     PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int enabled;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enabled)) {
+    return nullptr;
+  }
+  ObjectCensus::SetEnabled(static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetObjectCensusEnabledDef = {
+    "set_object_census_enabled",            // name
+    (PyCFunction)PySetObjectCensusEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,           // flags
+
+    "set_object_census_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Turn counting of native Objects by type on or off. Objects created\n"
+    "while on are counted until they die, even if it is turned off.",
+};
+
+// ----------------------------- get_object_census -----------------------------
+
+static auto PyGetObjectCensus(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  auto report = ObjectCensus::GetReport(static_cast<bool>(reset));
+  auto types = PythonRef::Stolen(PyDict_New());
+  for (auto&& entry : report.entries) {
+    auto type = PythonRef::Stolen(Py_BuildValue(
+        "{sLsLsLsL}", "live",
+        static_cast<long long>(entry.live),  // NOLINT
+        "peak",
+        static_cast<long long>(entry.peak),  // NOLINT
+        "created",
+        static_cast<long long>(entry.created),  // NOLINT
+        "destroyed",
+        static_cast<long long>(entry.destroyed)));  // NOLINT
+    PyDict_SetItemString(types.get(), entry.type_name.c_str(), type.get());
+  }
+  return Py_BuildValue("{sdsO}", "duration", report.duration, "types",
+                       types.get());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetObjectCensusDef = {
+    "get_object_census",             // name
+    (PyCFunction)PyGetObjectCensus,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "get_object_census(reset: bool = False) -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return native Object counts by type name. 'live' and 'peak' cover\n"
+    "objects created while the census was enabled; 'created' and\n"
+    "'destroyed' cover the last 'duration' seconds. Resetting restarts\n"
+    "those tallies and brings peaks down to current live counts.",
+};
+
+// ------------------------- set_thread_trace_enabled --------------------------
+
+static auto PySetThreadTraceEnabled(PyObject* self, PyObject* args,
+                                    PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int enabled;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enabled)) {
+    return nullptr;
+  }
+  core::ThreadTrace::SetEnabled(static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetThreadTraceEnabledDef = {
+    "set_thread_trace_enabled",            // name
+    (PyCFunction)PySetThreadTraceEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,          // flags
+
+    "set_thread_trace_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Start a new cross-thread trace capture (discarding any previous one)\n"
+    "or stop the current one.",
+};
+
+// ---------------------------- write_thread_trace -----------------------------
+
+static auto PyWriteThreadTrace(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* path;
+  static const char* kwlist[] = {"path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &path)) {
+    return nullptr;
+  }
+  auto count = core::ThreadTrace::WriteChromeTrace(path);
+  return PyLong_FromSize_t(count);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyWriteThreadTraceDef = {
+    "write_thread_trace",             // name
+    (PyCFunction)PyWriteThreadTrace,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "write_thread_trace(path: str) -> int\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Write the current cross-thread trace capture to a file as Chrome\n"
+    "trace-event json (for chrome://tracing or Perfetto) with one track\n"
+    "per engine thread, and return the number of events written.",
+};
+
+// ------------------------- set_timing_lanes_visible --------------------------
+
+static auto PySetTimingLanesVisible(PyObject* self, PyObject* args,
+                                    PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int visible;
+  static const char* kwlist[] = {"visible", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &visible)) {
+    return nullptr;
+  }
+  if (g_core->HeadlessMode()) {
+    throw Exception("Timing lanes need graphics.");
+  }
+  g_base->graphics->SetTimingLanesVisible(static_cast<bool>(visible));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetTimingLanesVisibleDef = {
+    "set_timing_lanes_visible",            // name
+    (PyCFunction)PySetTimingLanesVisible,  // method
+    METH_VARARGS | METH_KEYWORDS,          // flags
+
+    "set_timing_lanes_visible(visible: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Show or hide live graphs of logic update, bg-dynamics step, render\n"
+    "cpu/gpu times, connection packet rates and client jitter-buffer\n"
+    "depth, all sampled together once per frame.",
+};
+
+// -------------------- set_idle_garbage_collection_enabled --------------------
+
+static auto PySetIdleGarbageCollectionEnabled(PyObject* self, PyObject* args,
+                                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int enabled;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enabled)) {
+    return nullptr;
+  }
+  g_base->python->set_idle_garbage_collection_enabled(
+      static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetIdleGarbageCollectionEnabledDef = {
+    "set_idle_garbage_collection_enabled",            // name
+    (PyCFunction)PySetIdleGarbageCollectionEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,                    // flags
+
+    "set_idle_garbage_collection_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Set whether young-generation garbage collection passes run in the\n"
+    "slack left after display-time steps (on by default). Full collections\n"
+    "still happen at session transitions either way.",
+};
+
+// ------------------------------- record_input --------------------------------
+
+static auto PyRecordInput(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  const char* path;
+  unsigned long long seed{};  // NOLINT
+  static const char* kwlist[] = {"path", "seed", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "z|K",
+                                   const_cast<char**>(kwlist), &path, &seed)) {
+    return nullptr;
+  }
+  if (path) {
+    g_base->input->recorder().StartRecording(path, seed);
+  } else {
+    g_base->input->recorder().StopRecording();
+  }
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRecordInputDef = {
+    "record_input",                // name
+    (PyCFunction)PyRecordInput,    // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "record_input(path: str | None, seed: int = 0) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Start recording local input to be written to a file at path, or stop\n"
+    "and write it out if path is None. Random number generators get seeded\n"
+    "with seed as recording starts, and again as it gets played back.",
+};
+
+// -------------------------------- play_input ---------------------------------
+
+static auto PyPlayInput(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  const char* path;
+  static const char* kwlist[] = {"path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "z",
+                                   const_cast<char**>(kwlist), &path)) {
+    return nullptr;
+  }
+  if (path) {
+    g_base->input->recorder().StartPlayback(path);
+  } else {
+    g_base->input->recorder().StopPlayback();
+  }
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyPlayInputDef = {
+    "play_input",                  // name
+    (PyCFunction)PyPlayInput,      // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "play_input(path: str | None) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Play back an input recording made with record_input() through\n"
+    "stand-in devices, or stop any playback in progress if path is None.\n"
+    "Playback stops on its own once the recording runs out.",
+};
+
 // -----------------------------------------------------------------------------
 
 auto PythonMoethodsBase3::GetMethods() -> std::vector<PyMethodDef> {
@@ -2161,6 +3024,7 @@ auto PythonMoethodsBase3::GetMethods() -> std::vector<PyMethodDef> {
       PyNativeReviewRequestDef,
       PyTempTestingDef,
       PyOpenFileExternallyDef,
+      PyWriteRenderProfileDef,
       PyGetInputIdleTimeDef,
       PyPushBackPressDef,
       PyGetDrawVirtualSafeAreaBoundsDef,
@@ -2168,6 +3032,30 @@ auto PythonMoethodsBase3::GetMethods() -> std::vector<PyMethodDef> {
       PyGetInitialAppConfigDef,
       PySetAppConfigDef,
       PyUpdateInternalLoggerLevelsDef,
+      PySetEventLoopMetricsEnabledDef,
+      PyGetEventLoopMetricsEnabledDef,
+      PyGetEventLoopMetricsDef,
+      PyGetEventLoopLatencyBucketBoundsDef,
+      PySetLogicProfilingEnabledDef,
+      PyWriteLogicProfileDef,
+      PyStartLogicSamplingDef,
+      PyStopLogicSamplingDef,
+      PySetMemoryAccountingEnabledDef,
+      PyGetMemoryAccountingEnabledDef,
+      PyGetMemoryAccountingDef,
+      PyMarkStartupPhaseDef,
+      PyGetStartupPhasesDef,
+      PySetNetworkConditionsDef,
+      PyClearNetworkConditionsDef,
+      PyGetNetworkConditionsStatsDef,
+      PySetObjectCensusEnabledDef,
+      PyGetObjectCensusDef,
+      PySetThreadTraceEnabledDef,
+      PyWriteThreadTraceDef,
+      PySetTimingLanesVisibleDef,
+      PySetIdleGarbageCollectionEnabledDef,
+      PyRecordInputDef,
+      PyPlayInputDef,
   };
 }
 
@@ -5,8 +5,8 @@
 #include <string>
 
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/logic/logic_profiler.h"
 #include "ballistica/base/ui/ui.h"
-#include "ballistica/core/python/core_python.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/python/python.h"
@@ -15,6 +15,7 @@
 namespace ballistica::base {
 
 PythonContextCall* PythonContextCall::current_call_{};
+ScopedPythonContextCallBatch* PythonContextCall::current_batch_{};
 
 PythonContextCall::PythonContextCall(PyObject* obj_in) {
   assert(g_base->InLogicThread());
@@ -67,17 +68,43 @@ void PythonContextCall::MarkDead() {
 }
 
 void PythonContextCall::Run(PyObject* args) {
+  if (args) {
+    Run_(args, nullptr, 0);
+  } else {
+    // No args; go through vectorcall so we skip the tuple entirely.
+    PyObject* argv[] = {nullptr};
+    Run_(nullptr, argv, 0);
+  }
+}
+
+void PythonContextCall::Run_(PyObject* args, PyObject** argv, size_t nargs) {
   assert(this);
 
   // We implicitly use core globals; don't normally do this.
   assert(g_core);
+  assert(!Python::ScopedNativeSection::active());
 
   if (dead_ || context_state_.IsExpired()) {
     return;
   }
 
-  // Restore the context from when we were made.
-  base::ScopedSetContext ssc(context_state_);
+  // Restore the context from when we were made. Within a batch we skip
+  // the save/restore and just leave our context set for the next call;
+  // nested calls always get the full treatment.
+  if (current_batch_ && current_call_ == nullptr) {
+    if (!(*g_base->context_ref == context_state_)) {
+      *g_base->context_ref = context_state_;
+    }
+    RunInCurrentContext_(args, argv, nargs);
+  } else {
+    base::ScopedSetContext ssc(context_state_);
+    RunInCurrentContext_(args, argv, nargs);
+  }
+}
+
+void PythonContextCall::RunInCurrentContext_(PyObject* args, PyObject** argv,
+                                             size_t nargs) {
+  LogicProfiler::Scope profile_scope("python", file_loc_);
 
   // Hold a ref to this call throughout this process
   // so we know it'll still exist if we need to report
@@ -87,13 +114,8 @@ void PythonContextCall::Run(PyObject* args) {
   PythonContextCall* prev_call = current_call_;
   current_call_ = this;
   assert(Python::HaveGIL());
-  PyObject* o =
-      PyObject_Call(object_.get(),
-                    args ? args
-                         : g_core->python->objs()
-                               .Get(core::CorePython::ObjID::kEmptyTuple)
-                               .get(),
-                    nullptr);
+  PyObject* o = args ? PyObject_Call(object_.get(), args, nullptr)
+                     : PythonRef::Vectorcall(object_.get(), argv, nargs);
   current_call_ = prev_call;
 
   if (o) {
@@ -114,6 +136,19 @@ void PythonContextCall::Run(PyObject* args) {
   }
 }
 
+ScopedPythonContextCallBatch::ScopedPythonContextCallBatch()
+    : prev_batch_(PythonContextCall::current_batch_) {
+  assert(g_base->InLogicThread());
+  PythonContextCall::current_batch_ = this;
+}
+
+ScopedPythonContextCallBatch::~ScopedPythonContextCallBatch() {
+  assert(g_base->InLogicThread());
+  assert(PythonContextCall::current_batch_ == this);
+  PythonContextCall::current_batch_ = prev_batch_;
+  *g_base->context_ref = context_prev_;
+}
+
 void PythonContextCall::PrintContext() {
   assert(g_base->InLogicThread());
   std::string s = std::string("  root call: ") + object().Str() + "\n";
@@ -175,10 +210,10 @@ void PythonContextCall::ScheduleInUIOperation() {
   Object::Ref<PythonContextCall> ref(this);
   assert(base::g_base);
 
-  g_base->ui->PushUIOperationRunnable(NewLambdaRunnableUnmanaged([ref] {
+  g_base->ui->PushUIOperationCall([ref] {
     assert(ref.exists());
     ref->Run();
-  }));
+  });
 }
 
 void PythonContextCall::ScheduleInUIOperation(const PythonRef& args) {
@@ -187,10 +222,10 @@ void PythonContextCall::ScheduleInUIOperation(const PythonRef& args) {
   Object::Ref<PythonContextCall> ref(this);
   assert(base::g_base);
 
-  g_base->ui->PushUIOperationRunnable(NewLambdaRunnableUnmanaged([ref, args] {
+  g_base->ui->PushUIOperationCall([ref, args] {
     assert(ref.exists());
     ref->Run(args);
-  }));
+  });
 }
 
 }  // namespace ballistica::base
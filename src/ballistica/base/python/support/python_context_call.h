@@ -7,6 +7,7 @@
 
 #include "ballistica/base/support/context.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/foundation/object_pool.h"
 #include "ballistica/shared/python/python_ref.h"
 
 namespace ballistica::base {
@@ -17,6 +18,9 @@ namespace ballistica::base {
 // context info on exceptions.
 class PythonContextCall : public Object {
  public:
+  // These get created constantly for UI ops, death actions, etc.
+  BA_OBJECT_POOLED(PythonContextCall);
+
   static auto current_call() -> PythonContextCall* { return current_call_; }
   PythonContextCall() = default;
   ~PythonContextCall() override;
@@ -30,11 +34,22 @@ class PythonContextCall : public Object {
 
   void Run(PyObject* args = nullptr);
   void Run(const PythonRef& args) { Run(args.get()); }
+
+  /// Run with positional args (borrowed refs) passed via vectorcall, so no
+  /// args tuple gets built. Prefer this in hot paths.
+  template <typename... Ts>
+  void RunArgs(Ts... args) {
+    PyObject* argv[] = {nullptr, args...};
+    Run_(nullptr, argv, sizeof...(args));
+  }
   auto exists() const -> bool { return object_.exists(); }
   auto GetObjectDescription() const -> std::string override;
   void MarkDead();
   auto object() const -> const PythonRef& { return object_; }
   auto file_loc() const -> const std::string& { return file_loc_; }
+  auto context_state() const -> const base::ContextRef& {
+    return context_state_;
+  }
   void PrintContext();
 
   /// Run in an upcoming cycle of the logic thread. Must be called from the
@@ -81,7 +96,12 @@ class PythonContextCall : public Object {
   void ScheduleInUIOperation(const PythonRef& args);
 
  private:
+  friend class ScopedPythonContextCallBatch;
   void GetTrace();  // we try to grab basic trace info
+  // Runs with args if provided and otherwise with argv/nargs as described
+  // for PythonRef::Vectorcall().
+  void Run_(PyObject* args, PyObject** argv, size_t nargs);
+  void RunInCurrentContext_(PyObject* args, PyObject** argv, size_t nargs);
 
   int line_{};
   bool dead_{};
@@ -89,6 +109,24 @@ class PythonContextCall : public Object {
   PythonRef object_;
   base::ContextRef context_state_;
   static PythonContextCall* current_call_;
+  static ScopedPythonContextCallBatch* current_batch_;
+};
+
+/// While one of these exists, top-level PythonContextCall runs leave their
+/// context set when they finish, so a following call in the same context
+/// can skip setting it up again. The context from before the batch is
+/// restored when it goes away. Wrap this around spots that fire lots of
+/// calls back to back, such as a TimerList::Run() pass.
+class ScopedPythonContextCallBatch {
+ public:
+  ScopedPythonContextCallBatch();
+  ~ScopedPythonContextCallBatch();
+
+ private:
+  friend class PythonContextCall;
+  BA_DISALLOW_CLASS_COPIES(ScopedPythonContextCallBatch);
+  ScopedPythonContextCallBatch* prev_batch_{};
+  ContextRef context_prev_;
 };
 
 }  // namespace ballistica::base
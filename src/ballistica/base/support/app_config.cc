@@ -2,6 +2,7 @@
 
 #include "ballistica/base/support/app_config.h"
 
+#include <cstdio>
 #include <string>
 #include <utility>
 
@@ -9,6 +10,7 @@
 #include "ballistica/core/core.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/foundation/event_loop.h"
 
 namespace ballistica::base {
 
@@ -142,6 +144,108 @@ class AppConfig::BoolEntry : public AppConfig::Entry {
 
 AppConfig::AppConfig() { SetupEntries(); }
 
+void AppConfig::CommitFileContents(const std::string& contents) {
+  {
+    std::scoped_lock lock(commit_mutex_);
+    pending_file_contents_ = contents;
+    if (write_scheduled_) {
+      // The write already queued will pick up these contents.
+      return;
+    }
+
+    // Hold off shutdown until we've written. If shutdown is already
+    // underway we can't count on our thread getting to it; write here.
+    if (g_base->ShutdownSuppressBegin()) {
+      if (writer_event_loop_ == nullptr) {
+        writer_event_loop_ = new EventLoop(EventLoopID::kFileOut);
+      }
+      write_scheduled_ = true;
+      writer_event_loop_->PushCall([this] {
+        WritePendingFileContents_();
+        g_base->ShutdownSuppressEnd();
+      });
+      return;
+    }
+  }
+  WritePendingFileContents_();
+}
+
+void AppConfig::WritePendingFileContents_() {
+  // Only one write happens at a time; grabbing the contents and clearing
+  // the scheduled flag together means a commit arriving mid-write simply
+  // schedules another.
+  std::scoped_lock write_lock(write_mutex_);
+  std::string contents;
+  {
+    std::scoped_lock lock(commit_mutex_);
+    write_scheduled_ = false;
+    if (!pending_file_contents_.has_value()) {
+      return;
+    }
+    contents = std::move(*pending_file_contents_);
+    pending_file_contents_.reset();
+    if (contents == last_file_contents_) {
+      return;
+    }
+  }
+  try {
+    WriteFile_(contents);
+    std::scoped_lock lock(commit_mutex_);
+    last_file_contents_ = std::move(contents);
+  } catch (const std::exception& exc) {
+    g_core->Log(LogName::kBa, LogLevel::kError,
+                std::string("Error writing config file: ") + exc.what());
+  }
+}
+
+void AppConfig::WriteFile_(const std::string& contents) {
+  std::string path = g_core->platform->GetConfigFilePath();
+  std::string path_temp = path + ".tmp";
+  std::string path_prev = path + ".prev";
+  FILE* f_out = g_core->platform->FOpen(path_temp.c_str(), "wb");
+  if (f_out == nullptr) {
+    throw Exception("Error opening config file for writing: '" + path_temp
+                    + "': " + g_core->platform->GetErrnoString());
+  }
+
+  // Write to temp file.
+  size_t result = fwrite(contents.data(), contents.size(), 1, f_out);
+  if (result != 1) {
+    fclose(f_out);
+    throw Exception("Error writing config file to '" + path_temp
+                    + "': " + g_core->platform->GetErrnoString());
+  }
+  fclose(f_out);
+
+  // Now move any existing config to .prev.
+  if (g_core->platform->FilePathExists(path)) {
+    // On windows, rename doesn't overwrite existing files.. need to kill
+    // the old explicitly.
+    // (hmm; should we just do this everywhere for consistency?)
+    if (g_buildconfig.ostype_windows()) {
+      if (g_core->platform->FilePathExists(path_prev)) {
+        int result2 = g_core->platform->Remove(path_prev.c_str());
+        if (result2 != 0) {
+          throw Exception("Error removing prev config file '" + path_prev
+                          + "': " + g_core->platform->GetErrnoString());
+        }
+      }
+    }
+    int result2 = g_core->platform->Rename(path.c_str(), path_prev.c_str());
+    if (result2 != 0) {
+      throw Exception("Error backing up config file to '" + path_prev
+                      + "': " + g_core->platform->GetErrnoString());
+    }
+  }
+
+  // Now move temp into place.
+  int result2 = g_core->platform->Rename(path_temp.c_str(), path.c_str());
+  if (result2 != 0) {
+    throw Exception("Error renaming temp config file to final '" + path
+                    + "': " + g_core->platform->GetErrnoString());
+  }
+}
+
 // Clion think all calls of this are unreachable.
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "UnreachableCallsOfFunction"
@@ -186,6 +290,12 @@ void AppConfig::SetupEntries() {
   float gvrrts_default = g_core->platform->IsRunningOnDaydream() ? 1.0F : 0.5F;
   float_entries_[FloatID::kGoogleVRRenderTargetScale] =
       FloatEntry("GVR Render Target Scale", gvrrts_default);
+  float_entries_[FloatID::kBGDynamicsTargetStepMS] =
+      FloatEntry("BG Dynamics Target Step MS", 4.0F);
+  float_entries_[FloatID::kDynamicResolutionTargetFPS] =
+      FloatEntry("Dynamic Resolution Target FPS", 0.0F);
+  float_entries_[FloatID::kDynamicResolutionMinScale] =
+      FloatEntry("Dynamic Resolution Min Scale", 0.5F);
 
   optional_float_entries_[OptionalFloatID::kIdleExitMinutes] =
       OptionalFloatEntry("Idle Exit Minutes", std::optional<float>());
@@ -211,6 +321,22 @@ void AppConfig::SetupEntries() {
   int_entries_[IntID::kMaxFPS] = IntEntry("Max FPS", 60);
   int_entries_[IntID::kSceneV1HostProtocol] =
       IntEntry("SceneV1 Host Protocol", 33);
+  int_entries_[IntID::kGraphicsLoadBudgetKB] =
+      IntEntry("Graphics Load Budget KB", 4096);
+  int_entries_[IntID::kTextureResidencyBudgetMB] =
+      IntEntry("Texture Residency Budget MB", 256);
+  int_entries_[IntID::kTextureCacheBudgetMB] =
+      IntEntry("Texture Cache Budget MB", 512);
+  int_entries_[IntID::kMeshCacheBudgetMB] =
+      IntEntry("Mesh Cache Budget MB", 128);
+  int_entries_[IntID::kCollisionMeshCacheBudgetMB] =
+      IntEntry("Collision Mesh Cache Budget MB", 64);
+  int_entries_[IntID::kGeneratedTextureCacheBudgetMB] =
+      IntEntry("Generated Texture Cache Budget MB", 16);
+  int_entries_[IntID::kAudioVoiceBudget] = IntEntry("Audio Voice Budget", 24);
+  int_entries_[IntID::kFramesInFlight] = IntEntry("Frames In Flight", 2);
+  int_entries_[IntID::kSceneMaxCatchUpSteps] =
+      IntEntry("Scene Max Catch Up Steps", 8);
 
   bool_entries_[BoolID::kTouchControlsSwipeHidden] =
       BoolEntry("Touch Controls Swipe Hidden", false);
@@ -243,6 +369,22 @@ void AppConfig::SetupEntries() {
       BoolEntry("Show Demos When Idle", false);
   bool_entries_[BoolID::kShowDeprecatedLoginTypes] =
       BoolEntry("Show Deprecated Login Types", false);
+  bool_entries_[BoolID::kParallelDrawPrep] =
+      BoolEntry("Parallel Draw Prep", true);
+  bool_entries_[BoolID::kDrawCulling] = BoolEntry("Draw Culling", true);
+  bool_entries_[BoolID::kSortOpaqueDraws] =
+      BoolEntry("Sort Opaque Draws", true);
+  bool_entries_[BoolID::kShowRenderProfile] =
+      BoolEntry("Show Render Profile", false);
+  bool_entries_[BoolID::kGPUParticles] = BoolEntry("GPU Particles", true);
+  bool_entries_[BoolID::kTextTextureDiskCache] =
+      BoolEntry("Text Texture Disk Cache", true);
+  bool_entries_[BoolID::kSceneOverloadSlowdown] =
+      BoolEntry("Scene Overload Slowdown", true);
+  bool_entries_[BoolID::kHeadlessIdleSleep] =
+      BoolEntry("Headless Idle Sleep", false);
+  bool_entries_[BoolID::kFastPostProcess] =
+      BoolEntry("Fast Post Process", false);
 
   // Now add everything to our name map and make sure all is kosher.
   CompleteMap(float_entries_);
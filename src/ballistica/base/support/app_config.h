@@ -5,10 +5,13 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include "ballistica/base/base.h"
+
 // FIXME: this system is old and dumb. It was built to make C++ stuff
 //  type-safe but does not handle the Python side at all. We should come up
 //  with something Python-centric using dataclasses/etc. where a C++
@@ -32,6 +35,9 @@ class AppConfig {
     kSoundVolume,
     kMusicVolume,
     kGoogleVRRenderTargetScale,
+    kBGDynamicsTargetStepMS,
+    kDynamicResolutionTargetFPS,
+    kDynamicResolutionMinScale,
     kLast  // Sentinel.
   };
 
@@ -56,6 +62,15 @@ class AppConfig {
     kPort,
     kMaxFPS,
     kSceneV1HostProtocol,
+    kGraphicsLoadBudgetKB,
+    kTextureResidencyBudgetMB,
+    kTextureCacheBudgetMB,
+    kMeshCacheBudgetMB,
+    kCollisionMeshCacheBudgetMB,
+    kGeneratedTextureCacheBudgetMB,
+    kAudioVoiceBudget,
+    kSceneMaxCatchUpSteps,
+    kFramesInFlight,
     kLast  // Sentinel.
   };
 
@@ -77,6 +92,15 @@ class AppConfig {
     kDisableCameraGyro,
     kShowDemosWhenIdle,
     kShowDeprecatedLoginTypes,
+    kParallelDrawPrep,
+    kDrawCulling,
+    kSortOpaqueDraws,
+    kShowRenderProfile,
+    kGPUParticles,
+    kTextTextureDiskCache,
+    kSceneOverloadSlowdown,
+    kHeadlessIdleSleep,
+    kFastPostProcess,
     kLast  // Sentinel.
   };
 
@@ -126,6 +150,14 @@ class AppConfig {
     return entries_by_name_;
   }
 
+  /// Write new contents for the config file. The write happens in a
+  /// background thread so it never hitches the logic thread; commits that
+  /// arrive while one is pending replace it so only the latest gets
+  /// written, and contents matching the last write are skipped entirely.
+  /// App shutdown waits for any pending write. Can be called from any
+  /// thread.
+  void CommitFileContents(const std::string& contents);
+
  private:
   class StringEntry;
   class FloatEntry;
@@ -135,6 +167,14 @@ class AppConfig {
   template <typename T>
   void CompleteMap(const T& entry_map);
   void SetupEntries();
+  void WritePendingFileContents_();
+  static void WriteFile_(const std::string& contents);
+  std::mutex commit_mutex_;
+  std::mutex write_mutex_;
+  std::optional<std::string> pending_file_contents_;
+  std::string last_file_contents_;
+  EventLoop* writer_event_loop_{};
+  bool write_scheduled_{};
   std::map<std::string, const Entry*> entries_by_name_;
   std::map<FloatID, FloatEntry> float_entries_;
   std::map<OptionalFloatID, OptionalFloatEntry> optional_float_entries_;
@@ -2,6 +2,7 @@
 
 #include "ballistica/base/support/huffman.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -58,10 +59,18 @@ Huffman::~Huffman() = default;
 
 auto Huffman::compress(const std::vector<uint8_t>& src)
     -> std::vector<uint8_t> {
+  std::vector<uint8_t> out;
+  compress(src.data(), src.size(), &out);
+  return out;
+}
+
+void Huffman::compress(const uint8_t* src, size_t src_size,
+                       std::vector<uint8_t>* out) {
+  assert(out);
 #if BA_HUFFMAN_NET_COMPRESSION
 
-  auto length = static_cast<uint32_t>(src.size());
-  const char* data = (const char*)src.data();
+  auto length = static_cast<uint32_t>(src_size);
+  const char* data = reinterpret_cast<const char*>(src);
 
   // IMPORTANT:
   // our uncompressed packets have a type byte at the beginning
@@ -88,12 +97,14 @@ auto Huffman::compress(const std::vector<uint8_t>& src)
   // if compressed is bigger than uncompressed, go with uncompressed - just
   // return the data they provided
   if ((length_out >= length)) {
-    return src;
+    out->assign(src, src + src_size);
   } else {
-    std::vector<uint8_t> out(length_out, 0);
+    // Note to self: assign() rather than resize() so we zero any existing
+    // contents; DoWriteBits() ORs bits in.
+    out->assign(length_out, 0);
 
     // first byte gives our number of empty trailing bits
-    char* ptr = reinterpret_cast<char*>(out.data());
+    char* ptr = reinterpret_cast<char*>(out->data());
     int bit = 0;
 
     *ptr = static_cast<char>(8 - bit_count % 8);
@@ -108,29 +119,232 @@ auto Huffman::compress(const std::vector<uint8_t>& src)
     }
     // make sure we're either at the end of our allotted buffer or we're one
     // from the end and the bitcount takes care of the rest
-    assert(ptr - reinterpret_cast<char*>(out.data()) == length_out
-           || (ptr - reinterpret_cast<char*>(out.data()) == length_out - 1
+    assert(ptr - reinterpret_cast<char*>(out->data()) == length_out
+           || (ptr - reinterpret_cast<char*>(out->data()) == length_out - 1
                && bit_count != 0));
     assert(bit == bit_count % 8);
 
     // mark it as compressed
-    out[0] |= (0x01 << 7);
-    return out;
+    (*out)[0] |= (0x01 << 7);
   }
 #else
 
 #if HUFFMAN_TRAINING_MODE
-  train(data, length);
+  train(reinterpret_cast<const char*>(src), static_cast<int>(src_size));
 #endif
 
-  data_out = data;
-  length_out = length;
+  out->assign(src, src + src_size);
 #endif
 }
 
+auto Huffman::encode_bits(const uint8_t* src, size_t src_size,
+                          std::vector<uint8_t>* out) -> uint32_t {
+  assert(out);
+  uint32_t bit_count = encoded_bit_count(src, src_size);
+  out->assign(bit_count / 8 + (bit_count % 8 ? 1 : 0), 0);
+  char* ptr = reinterpret_cast<char*>(out->data());
+  int bit = 0;
+  for (size_t i = 0; i < src_size; i++) {
+    DoWriteBits(&ptr, &bit, nodes_[src[i]].val, nodes_[src[i]].bits);
+  }
+  return bit_count;
+}
+
+auto Huffman::encoded_bit_count(const uint8_t* src, size_t src_size) const
+    -> uint32_t {
+  uint32_t bit_count = 0;
+  for (size_t i = 0; i < src_size; i++) {
+    bit_count += nodes_[src[i]].bits;
+  }
+  return bit_count;
+}
+
+void Huffman::compress_with_prefix(const uint8_t* prefix, size_t prefix_size,
+                                   const uint8_t* payload, size_t payload_size,
+                                   const uint8_t* payload_bits,
+                                   uint32_t payload_bit_count,
+                                   std::vector<uint8_t>* out) {
+  assert(out);
+  assert(prefix_size > 0);
+#if BA_HUFFMAN_NET_COMPRESSION
+
+  // Same deal as compress(); we need the top bit free to flag compression.
+  BA_PRECONDITION(prefix[0] >> 7 == 0);
+
+  auto length = static_cast<uint32_t>(prefix_size + payload_size);
+  uint32_t bit_count = payload_bit_count;
+  for (size_t i = 0; i < prefix_size; i++) {
+    bit_count += nodes_[prefix[i]].bits;
+  }
+
+  // Round up to next byte and add our one-byte header.
+  uint32_t length_out = bit_count / 8 + 1;
+  if (bit_count % 8) {
+    length_out++;
+  }
+
+  // If compressed is bigger than uncompressed, go with uncompressed.
+  if (length_out >= length) {
+    out->resize(length);
+    memcpy(out->data(), prefix, prefix_size);
+    if (payload_size) {
+      memcpy(out->data() + prefix_size, payload, payload_size);
+    }
+    return;
+  }
+
+  out->assign(length_out, 0);
+  char* ptr = reinterpret_cast<char*>(out->data());
+  int bit = 0;
+
+  // First byte gives our number of empty trailing bits.
+  *ptr = static_cast<char>(8 - bit_count % 8);
+  if (*ptr == 8) {
+    *ptr = 0;
+  }
+  ptr++;
+
+  // Encode our prefix normally.
+  for (size_t i = 0; i < prefix_size; i++) {
+    DoWriteBits(&ptr, &bit, nodes_[prefix[i]].val, nodes_[prefix[i]].bits);
+  }
+
+  // Since each value is encoded independently, the payload's bits are the
+  // same wherever they land; we just need to shift them into place behind
+  // the prefix.
+  auto* out_bytes = reinterpret_cast<uint8_t*>(ptr);
+  size_t out_remaining = out->data() + out->size() - out_bytes;
+  size_t payload_bytes = payload_bit_count / 8 + (payload_bit_count % 8 ? 1 : 0);
+  if (bit == 0) {
+    assert(payload_bytes <= out_remaining);
+    memcpy(out_bytes, payload_bits, payload_bytes);
+  } else {
+    for (size_t i = 0; i < payload_bytes; i++) {
+      out_bytes[i] |= static_cast<uint8_t>(payload_bits[i] << bit);
+      if (i + 1 < out_remaining) {
+        out_bytes[i + 1] |= static_cast<uint8_t>(payload_bits[i] >> (8 - bit));
+      }
+    }
+  }
+
+  // Mark it as compressed.
+  (*out)[0] |= (0x01 << 7);
+
+#else
+  out->resize(prefix_size + payload_size);
+  memcpy(out->data(), prefix, prefix_size);
+  if (payload_size) {
+    memcpy(out->data() + prefix_size, payload, payload_size);
+  }
+#endif
+}
+
+auto Huffman::decompress(const std::vector<uint8_t>& src)
+    -> std::vector<uint8_t> {
+  if (use_decode_table_) {
+    std::vector<uint8_t> out;
+    DecompressTable_(src.data(), src.size(), &out);
+    return out;
+  }
+  return decompress_bitwise(src);
+}
+
+void Huffman::decompress(const uint8_t* src, size_t src_size,
+                         std::vector<uint8_t>* out) {
+  assert(out);
+  if (use_decode_table_) {
+    DecompressTable_(src, src_size, out);
+    return;
+  }
+  *out = decompress_bitwise(std::vector<uint8_t>(src, src + src_size));
+}
+
+void Huffman::DecompressTable_(const uint8_t* src, size_t src_size,
+                               std::vector<uint8_t>* out) {
+#if BA_HUFFMAN_NET_COMPRESSION
+
+  auto length = static_cast<uint32_t>(src_size);
+  BA_PRECONDITION(length > 0);
+
+  auto remainder = static_cast<uint8_t>(src[0] & 0x0F);
+  bool compressed = src[0] >> 7;
+
+  if (!compressed) {
+    // Uncompressed - just provide it as is.
+    out->assign(src, src + src_size);
+    return;
+  }
+
+  uint32_t byte_length = length - 1;
+  uint32_t bit_length = byte_length * 8;
+  if (remainder > bit_length) {
+    throw Exception("invalid huffman data");
+  }
+  bit_length -= remainder;
+  const uint8_t* ptr = src + 1;
+  uint32_t bit = 0;
+
+  // Every code is at least 2 bits (flag bit plus at least one tree bit),
+  // which gives us an upper bound on output size. This lets us write
+  // directly into the buffer instead of growing it incrementally.
+  out->resize(bit_length / 2);
+  uint8_t* out_ptr = out->data();
+
+  while (bit < bit_length) {
+    // The most we ever need for a lookup is 9 bits starting 7 bits into a
+    // byte, so two bytes always covers it. Anything past the end of the
+    // buffer reads as zeros; the length check below catches codes that
+    // actually run off the end.
+    uint32_t byte = bit / 8;
+    uint32_t window = ptr[byte];
+    if (byte + 1 < byte_length) {
+      window |= static_cast<uint32_t>(ptr[byte + 1]) << 8;
+    }
+    window >>= bit % 8;
+
+    uint16_t entry = decode_table_[window & (kDecodeTableSize - 1)];
+    auto entry_bits = static_cast<uint32_t>(entry >> 8);
+    if (entry_bits == 0) {
+      // Code runs deeper than our table; skip the flag bit and walk it.
+      bit++;
+      *out_ptr++ = WalkTree_(ptr, &bit, bit_length);
+    } else {
+      bit += entry_bits;
+      if (bit > bit_length) {
+        throw Exception("huffman decompress got bit > bitlength");
+      }
+      *out_ptr++ = static_cast<uint8_t>(entry & 0xFF);
+    }
+  }
+  assert(out_ptr - out->data() <= static_cast<ptrdiff_t>(out->size()));
+  out->resize(out_ptr - out->data());
+
+#else
+  out->assign(src, src + src_size);
+#endif
+}
+
+auto Huffman::WalkTree_(const uint8_t* ptr, uint32_t* bit,
+                        uint32_t bit_length) const -> uint8_t {
+  // Everything above 255 is an interior node with both children; everything
+  // at or below it is a leaf.
+  int n = 510;
+  while (n > 255) {
+    if (*bit >= bit_length) {
+      throw Exception("huffman decompress got bit > bitlength");
+    }
+    bool bitval = (ptr[*bit / 8] >> (*bit % 8)) & 0x01;
+
+    // 1 for right, 0 for left.
+    n = bitval ? nodes_[n].right_child : nodes_[n].left_child;
+    (*bit)++;
+  }
+  return static_cast<uint8_t>(n);
+}
+
 // hmmm - I saw a crash logged in this function; need to make sure this is
 // bulletproof since untrusted data is coming through here..
-auto Huffman::decompress(const std::vector<uint8_t>& src)
+auto Huffman::decompress_bitwise(const std::vector<uint8_t>& src)
     -> std::vector<uint8_t> {
 #if BA_HUFFMAN_NET_COMPRESSION
 
@@ -583,9 +797,38 @@ void Huffman::build() {
     nodes_[i].bits += 1;
   }
 
+  BuildDecodeTable_();
+
   built = true;
 }
 
+void Huffman::BuildDecodeTable_() {
+  // Bits are consumed lowest-first, so the low bit of each index is the
+  // flag bit and subsequent bits are the ones following it in the stream.
+  for (int i = 0; i < kDecodeTableSize; i++) {
+    if (!(i & 0x01)) {
+      // A 0 flag bit means the next 8 bits are the raw value.
+      decode_table_[i] = static_cast<uint16_t>(((i >> 1) & 0xFF)
+                                               | (kDecodeTableBits << 8));
+      continue;
+    }
+
+    // Otherwise walk the tree as far as our bits will take us.
+    int n = 510;
+    int bits = 1;
+    while (n > 255 && bits < kDecodeTableBits) {
+      n = ((i >> bits) & 0x01) ? nodes_[n].right_child : nodes_[n].left_child;
+      bits++;
+    }
+    if (n > 255) {
+      // Ran out of bits before hitting a leaf.
+      decode_table_[i] = 0;
+    } else {
+      decode_table_[i] = static_cast<uint16_t>(n | (bits << 8));
+    }
+  }
+}
+
 #pragma clang diagnostic pop
 
 }  // namespace ballistica::base
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_SUPPORT_HUFFMAN_H_
 #define BALLISTICA_BASE_SUPPORT_HUFFMAN_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "ballistica/shared/foundation/object.h"
@@ -24,6 +25,46 @@ class Huffman {
   // (see details in implementation).
   auto compress(const std::vector<uint8_t>& src) -> std::vector<uint8_t>;
   auto decompress(const std::vector<uint8_t>& src) -> std::vector<uint8_t>;
+
+  /// Compress/decompress into a caller-provided buffer. The buffer is
+  /// resized to fit the output but its capacity is never released, so
+  /// reusing one buffer across calls avoids heap allocations once it has
+  /// grown large enough.
+  void compress(const uint8_t* src, size_t src_size, std::vector<uint8_t>* out);
+  void decompress(const uint8_t* src, size_t src_size,
+                  std::vector<uint8_t>* out);
+
+  /// Huffman-encode data as a raw bit stream (no header byte) for later
+  /// use with compress_with_prefix(). Returns the number of bits written.
+  auto encode_bits(const uint8_t* src, size_t src_size,
+                   std::vector<uint8_t>* out) -> uint32_t;
+
+  /// Number of bits encode_bits() would produce for some data. Handy for
+  /// attributing compressed sizes to individual parts of a message.
+  auto encoded_bit_count(const uint8_t* src, size_t src_size) const
+      -> uint32_t;
+
+  /// Produces the same output as compress() on the concatenation of
+  /// prefix and payload, but takes payload bits previously generated by
+  /// encode_bits(). This allows a payload to be encoded once and then sent
+  /// behind any number of different (small) headers.
+  void compress_with_prefix(const uint8_t* prefix, size_t prefix_size,
+                            const uint8_t* payload, size_t payload_size,
+                            const uint8_t* payload_bits,
+                            uint32_t payload_bit_count,
+                            std::vector<uint8_t>* out);
+
+  /// The original decoder which walks the tree one bit at a time. Output
+  /// is identical to decompress(); this is kept around mainly so the two
+  /// can be compared/benchmarked against each other.
+  auto decompress_bitwise(const std::vector<uint8_t>& src)
+      -> std::vector<uint8_t>;
+
+  /// Whether decompress() uses the table-driven decoder (the default) or
+  /// falls back to decompress_bitwise().
+  void set_use_decode_table(bool val) { use_decode_table_ = val; }
+  auto use_decode_table() const -> bool { return use_decode_table_; }
+
   auto get_built() const -> bool { return built; }
 
  private:
@@ -53,7 +94,30 @@ class Huffman {
     int frequency = 0;
   };
 
+  // Number of bits we look at per decode-table lookup. Our longest
+  // real code is 8 bits (flag bit plus up to 7 tree bits) and escaped
+  // values are 9 (flag bit plus 8 raw bits) so 9 covers everything we
+  // ever emit in a single lookup.
+  static constexpr int kDecodeTableBits = 9;
+  static constexpr int kDecodeTableSize = 1 << kDecodeTableBits;
+
+  void BuildDecodeTable_();
+  void DecompressTable_(const uint8_t* src, size_t src_size,
+                        std::vector<uint8_t>* out);
+
+  // Walks the tree bit by bit from the root to decode a single value;
+  // used by the table decoder for codes deeper than the table covers.
+  auto WalkTree_(const uint8_t* ptr, uint32_t* bit, uint32_t bit_length) const
+      -> uint8_t;
+
   Node nodes_[511];
+
+  // Each entry gives a decoded value in its low byte and the number of
+  // bits consumed in its high byte. A bit count of 0 means the code runs
+  // deeper than the table covers (which we never emit ourselves) and we
+  // need to walk the tree to decode it.
+  uint16_t decode_table_[kDecodeTableSize]{};
+  bool use_decode_table_{true};
 };
 
 }  // namespace ballistica::base
@@ -32,7 +32,7 @@ namespace ballistica::base {
 // How much of the screen the console covers when it is at full size.
 const float kDevConsoleFullSizeCoverage{0.9f};
 const float kDevConsoleMiniSize{100.0f};
-const int kDevConsoleLineLimit{80};
+const int kDevConsoleEntryLimit{80};
 const int kDevConsoleStringBreakUpSize{1950};
 const float kDevConsoleTabButtonCornerRadius{16.0f};
 
@@ -568,16 +568,8 @@ class DevConsole::TabButton_ : public DevConsole::Widget_ {
 
 class DevConsole::OutputLine_ {
  public:
-  OutputLine_(std::string s_in, double creation_time, float scale,
-              Vector4f color)
-      : creation_time(creation_time),
-        s(std::move(s_in)),
-        scale(scale),
-        color(color) {}
+  explicit OutputLine_(std::string s_in) : s(std::move(s_in)) {}
   std::string s;
-  double creation_time;
-  float scale;
-  Vector4f color;
   auto GetText() -> TextGroup& {
     if (!s_mesh_.exists()) {
       s_mesh_ = Object::New<TextGroup>();
@@ -590,6 +582,36 @@ class DevConsole::OutputLine_ {
   Object::Ref<TextGroup> s_mesh_;
 };
 
+/// A single print as it came in. We only break it into lines (and build
+/// meshes for those) once it gets drawn, so bursts of prints that scroll
+/// by unseen cost little more than a string copy.
+class DevConsole::OutputEntry_ {
+ public:
+  OutputEntry_(std::string s_in, float scale, Vector4f color)
+      : s(std::move(s_in)), scale(scale), color(color) {}
+  std::string s;
+  float scale;
+  Vector4f color;
+  auto GetLines() -> std::vector<OutputLine_>& {
+    if (!wrapped_) {
+      std::vector<std::string> broken_up;
+      g_base->text_graphics->BreakUpString(
+          Utils::GetValidUTF8(s.c_str(), "cspr").c_str(),
+          kDevConsoleStringBreakUpSize / scale, &broken_up);
+      lines_.reserve(broken_up.size());
+      for (auto&& line : broken_up) {
+        lines_.emplace_back(std::move(line));
+      }
+      wrapped_ = true;
+    }
+    return lines_;
+  }
+
+ private:
+  std::vector<OutputLine_> lines_;
+  bool wrapped_{};
+};
+
 DevConsole::DevConsole() {
   assert(g_base->InLogicThread());
   std::string title = std::string("BallisticaKit ") + kEngineVersion + " ("
@@ -1223,7 +1245,8 @@ void DevConsole::Exec() {
   }
   input_history_position_ = 0;
   if (input_string_ == "clear") {
-    output_lines_.clear();
+    output_entries_.clear();
+    output_entry_next_ = 0;
   } else {
     SubmitPythonCommand_(input_string_);
   }
@@ -1312,18 +1335,13 @@ void DevConsole::ToggleState() {
 
 void DevConsole::Print(const std::string& s_in, float scale, Vector4f color) {
   assert(g_base->InLogicThread());
-  std::string s = Utils::GetValidUTF8(s_in.c_str(), "cspr");
-  std::vector<std::string> broken_up;
-  g_base->text_graphics->BreakUpString(
-      s.c_str(), kDevConsoleStringBreakUpSize / scale, &broken_up);
-
-  // Spit out all lines.
-  for (size_t i = 0; i < broken_up.size(); i++) {
-    output_lines_.emplace_back(broken_up[i], g_base->logic->display_time(),
-                               scale, color);
-    if (output_lines_.size() > kDevConsoleLineLimit) {
-      output_lines_.pop_front();
-    }
+
+  // Fill up to our limit and then start overwriting the oldest entry.
+  if (output_entries_.size() < static_cast<size_t>(kDevConsoleEntryLimit)) {
+    output_entries_.emplace_back(s_in, scale, color);
+  } else {
+    output_entries_[output_entry_next_] = OutputEntry_(s_in, scale, color);
+    output_entry_next_ = (output_entry_next_ + 1) % output_entries_.size();
   }
 }
 
@@ -1566,21 +1584,31 @@ void DevConsole::Draw(FrameDef* frame_def) {
                 * (g_base->graphics->screen_virtual_width()
                    - (kDevConsoleStringBreakUpSize * draw_scale));
       float v = bottom + 32.0f * bs;
-      for (auto i = output_lines_.rbegin(); i != output_lines_.rend(); i++) {
-        int elem_count = i->GetText().GetElementCount();
-        for (int e = 0; e < elem_count; e++) {
-          c.SetColor(i->color.x, i->color.y, i->color.z, i->color.a);
-          c.SetTexture(i->GetText().GetElementTexture(e));
-          {
-            auto xf = c.ScopedTransform();
-            c.Translate(h, v + 2, kDevConsoleZDepth);
-            c.Scale(draw_scale * i->scale, draw_scale * i->scale);
-            c.DrawMesh(i->GetText().GetElementMesh(e));
+      auto entry_count = output_entries_.size();
+      bool full{};
+      for (size_t k = 0; k < entry_count && !full; ++k) {
+        auto& entry{output_entries_[(output_entry_next_ + entry_count - 1 - k)
+                                    % entry_count]};
+        auto& lines{entry.GetLines()};
+        for (auto i = lines.rbegin(); i != lines.rend(); i++) {
+          auto& text{i->GetText()};
+          int elem_count = text.GetElementCount();
+          for (int e = 0; e < elem_count; e++) {
+            c.SetColor(entry.color.x, entry.color.y, entry.color.z,
+                       entry.color.a);
+            c.SetTexture(text.GetElementTexture(e));
+            {
+              auto xf = c.ScopedTransform();
+              c.Translate(h, v + 2, kDevConsoleZDepth);
+              c.Scale(draw_scale * entry.scale, draw_scale * entry.scale);
+              c.DrawMesh(text.GetElementMesh(e));
+            }
+          }
+          v += v_inc * entry.scale;
+          if (v > pass->virtual_height() + v_inc) {
+            full = true;
+            break;
           }
-        }
-        v += v_inc * i->scale;
-        if (v > pass->virtual_height() + v_inc) {
-          break;
         }
       }
     }
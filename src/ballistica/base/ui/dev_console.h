@@ -81,6 +81,7 @@ class DevConsole {
   class ToggleButton_;
   class TabButton_;
   class OutputLine_;
+  class OutputEntry_;
   enum class State_ : uint8_t { kInactive, kMini, kFull };
 
   auto CaratCharValid_() -> bool;
@@ -122,7 +123,10 @@ class DevConsole {
   std::string active_tab_;
   PythonRef string_edit_adapter_;
   std::list<std::string> input_history_;
-  std::list<OutputLine_> output_lines_;
+  // Ring of our most recent prints; output_entry_next_ is the oldest (and
+  // next to be overwritten) once we're full.
+  std::vector<OutputEntry_> output_entries_;
+  size_t output_entry_next_{};
   std::unique_ptr<Widget_> close_button_;
   std::vector<std::unique_ptr<Widget_> > widgets_;
   std::vector<std::unique_ptr<Widget_> > tab_buttons_;
@@ -3,7 +3,9 @@
 #include "ballistica/base/ui/ui.h"
 
 #include <exception>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
@@ -56,7 +58,7 @@ UI::OperationContext::~OperationContext() {
     // If a context was set when we came into existence, it should
     // still be that same context when we go out of existence.
     assert(g_base->ui->operation_context_ == parent_);
-    assert(runnables_.empty());
+    assert(calls_.empty());
   }
 
   // Complain if our Finish() call was never run (unless it seems we're being
@@ -66,20 +68,15 @@ UI::OperationContext::~OperationContext() {
         "UI::InteractionContext_ being torn down without Finish() called.");
   }
 
-  // Our runnables are raw unmanaged pointers; need to explicitly kill them.
-  // Finish generally clears these out as it goes, but there might be some
-  // left in the case of exceptions or infinite loop breakouts.
-  for (auto* ptr : runnables_) {
-    delete ptr;
-  }
+  // Any calls left over in the case of exceptions or infinite loop
+  // breakouts get cleaned up along with calls_.
 }
 
-void UI::OperationContext::AddRunnable(Runnable* runnable) {
+void UI::OperationContext::AddCall(InlineCall&& call) {
   // This should only be getting called when we installed ourself as top
   // level context.
   assert(parent_ == nullptr);
-  assert(Object::IsValidUnmanagedObject(runnable));
-  runnables_.push_back(runnable);
+  calls_.push_back(std::move(call));
 }
 
 /// Should be explicitly called at the end of the operation.
@@ -92,20 +89,17 @@ void UI::OperationContext::Finish() {
   // scheduled here will itself schedule something here, so we need to do
   // this in a loop (and watch for infinite ones).
   int cycle_count{};
-  auto initial_runnable_count(runnables_.size());
-  while (!runnables_.empty()) {
-    std::vector<Runnable*> runnables;
-    runnables.swap(runnables_);
-    for (auto* runnable : runnables) {
-      runnable->RunAndLogErrors();
-      // Our runnables are raw unmanaged pointers; need to explicitly kill
-      // them.
-      delete runnable;
+  auto initial_runnable_count(calls_.size());
+  while (!calls_.empty()) {
+    std::vector<InlineCall> calls;
+    calls.swap(calls_);
+    for (auto&& call : calls) {
+      call.RunAndLogErrors();
     }
     cycle_count += 1;
     auto max_count = 10;
     if (cycle_count >= max_count) {
-      auto current_runnable_count(runnables_.size());
+      auto current_runnable_count(calls_.size());
       BA_LOG_ERROR_NATIVE_TRACE(
           "UIOperationCount cycle-count hit max " + std::to_string(max_count)
           + " (initial " + std::to_string(initial_runnable_count) + ", current "
@@ -673,6 +667,29 @@ void UI::PushDevConsolePrintCall(const std::string& msg, float scale,
   dev_console_startup_messages_.emplace_back(msg, scale, color);
 }
 
+void UI::PushDevConsoleLogCall(const std::string& prefix,
+                               Vector4f prefix_color, const std::string& msg,
+                               Vector4f color) {
+  // Completely ignore this stuff in headless mode.
+  if (g_core->HeadlessMode()) {
+    return;
+  }
+  if (auto* event_loop = g_base->logic->event_loop()) {
+    if (dev_console_ != nullptr) {
+      event_loop->PushCall([this, prefix, prefix_color, msg, color] {
+        dev_console_->Print("", 0.3f, kVector4f1);
+        dev_console_->Print(prefix, 0.75f, prefix_color);
+        dev_console_->Print(msg, 1.0f, color);
+      });
+      return;
+    }
+  }
+  // Didn't send a print; store for later.
+  dev_console_startup_messages_.emplace_back("", 0.3f, kVector4f1);
+  dev_console_startup_messages_.emplace_back(prefix, 0.75f, prefix_color);
+  dev_console_startup_messages_.emplace_back(msg, 1.0f, color);
+}
+
 void UI::OnAssetsAvailable() {
   assert(g_base->InLogicThread());
 
@@ -693,6 +710,17 @@ void UI::OnAssetsAvailable() {
 }
 
 void UI::PushUIOperationRunnable(Runnable* runnable) {
+  assert(Object::IsValidUnmanagedObject(runnable));
+
+  // Hand ownership to the call; it goes down with it whether or not it
+  // gets run.
+  PushUIOperationCall_(
+      InlineCall([runnable = std::unique_ptr<Runnable>(runnable)] {
+        runnable->Run();
+      }));
+}
+
+void UI::PushUIOperationCall_(InlineCall&& call) {
   assert(g_base->InLogicThread());
 
   if (operation_context_ != nullptr) {
@@ -706,16 +734,16 @@ void UI::PushUIOperationRunnable(Runnable* runnable) {
     // if (operation_context_->ran_finish()) {
     //   auto trace = g_core->platform->GetNativeStackTrace();
     //   BA_LOG_ERROR_NATIVE_TRACE(
-    //       "UI::PushUIOperationRunnable() called during UI operation
+    //       "UI::PushUIOperationCall() called during UI operation
     //       finish.");
     //   return;
     // }
 
-    operation_context_->AddRunnable(runnable);
+    operation_context_->AddCall(std::move(call));
     return;
   } else {
     BA_LOG_ERROR_NATIVE_TRACE(
-        "UI::PushUIOperationRunnable() called outside of UI operation.");
+        "UI::PushUIOperationCall() called outside of UI operation.");
   }
 }
 
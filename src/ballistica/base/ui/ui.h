@@ -9,6 +9,7 @@
 
 #include "ballistica/base/graphics/support/frame_def.h"
 #include "ballistica/base/ui/widget_message.h"
+#include "ballistica/shared/generic/inline_call.h"
 #include "ballistica/shared/math/vector4f.h"
 
 // Predeclare a few things from ui_v1.
@@ -87,6 +88,14 @@ class UI {
   /// point. Must be called from the logic thread.
   void PushUIOperationRunnable(Runnable* runnable);
 
+  /// Add a lambda to be run as part of the currently-being-processed UI
+  /// operation. Small lambdas are stored inline, so this generally does
+  /// not allocate. Must be called from the logic thread.
+  template <typename F>
+  void PushUIOperationCall(const F& lambda) {
+    PushUIOperationCall_(InlineCall(lambda));
+  }
+
   auto InUIOperation() -> bool;
 
   /// Return the widget an input-device should send commands to, if any.
@@ -134,6 +143,11 @@ class UI {
   void PushDevConsolePrintCall(const std::string& msg, float scale,
                                Vector4f color);
 
+  /// Print a log entry (a spacer line, a small prefix line, and the
+  /// message itself) to the dev console with a single push.
+  void PushDevConsoleLogCall(const std::string& prefix, Vector4f prefix_color,
+                             const std::string& msg, Vector4f color);
+
   auto* delegate() const { return delegate_; }
 
   class OperationContext {
@@ -143,16 +157,17 @@ class UI {
     /// Should be called before returning from the high level event handling
     /// call.
     void Finish();
-    void AddRunnable(Runnable* runnable);
+    void AddCall(InlineCall&& call);
     auto ran_finish() const { return ran_finish_; }
 
    private:
-    std::vector<Runnable*> runnables_;
+    std::vector<InlineCall> calls_;
     OperationContext* parent_{};
     bool ran_finish_{};
   };
 
  private:
+  void PushUIOperationCall_(InlineCall&& call);
   void MainMenuPress_(InputDevice* device);
   auto DevConsoleButtonSize_() const -> float;
   auto InDevConsoleButton_(float x, float y) const -> bool;
@@ -6,7 +6,12 @@
 #include <vector>
 
 #include "ballistica/classic/python/classic_python.h"
+#include "ballistica/classic/support/admin_channel.h"
+#include "ballistica/classic/support/load_generator.h"
+#include "ballistica/classic/support/replay_benchmark.h"
+#include "ballistica/classic/support/scripted_benchmark.h"
 #include "ballistica/classic/support/stress_test.h"
+#include "ballistica/classic/support/telemetry.h"
 #include "ballistica/classic/support/v1_account.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/scene_v1/python/scene_v1_python.h"
@@ -60,12 +65,18 @@ void ClassicFeatureSet::OnModuleExec(PyObject* module) {
   g_ui_v1 = ui_v1::UIV1FeatureSet::Import();
 
   g_core->Log(LogName::kBaLifecycle, LogLevel::kInfo, "_baclassic exec end");
+  g_core->MarkStartupPhase("baclassic_exec");
 }
 
 ClassicFeatureSet::ClassicFeatureSet()
     : python{new ClassicPython()},
       v1_account{new V1Account()},
-      stress_test_{new StressTest()} {
+      stress_test_{new StressTest()},
+      telemetry_{new Telemetry()},
+      admin_channel_{new AdminChannel()},
+      load_generator_{new LoadGenerator()},
+      scripted_benchmark_{new ScriptedBenchmark()},
+      replay_benchmark_{new ReplayBenchmark()} {
   // We're a singleton. If there's already one of us, something's wrong.
   assert(g_classic == nullptr);
 }
@@ -32,10 +32,15 @@ class UIV1FeatureSet;
 namespace ballistica::classic {
 
 // Predeclared types our feature-set provides.
+class AdminChannel;
 class ClassicAppMode;
 class ClassicFeatureSet;
 class ClassicPython;
+class LoadGenerator;
+class ReplayBenchmark;
+class ScriptedBenchmark;
 class StressTest;
+class Telemetry;
 class V1Account;
 
 enum class V1AccountType {
@@ -120,11 +125,21 @@ class ClassicFeatureSet : public FeatureSetNativeComponent,
   void PlayMusic(const std::string& music_type, bool continuous) override;
 
   auto* stress_test() const { return stress_test_; }
+  auto* telemetry() const { return telemetry_; }
+  auto* admin_channel() const { return admin_channel_; }
+  auto* load_generator() const { return load_generator_; }
+  auto* scripted_benchmark() const { return scripted_benchmark_; }
+  auto* replay_benchmark() const { return replay_benchmark_; }
 
  private:
   ClassicFeatureSet();
   V1AccountType v1_account_type_{V1AccountType::kInvalid};
   StressTest* stress_test_;
+  Telemetry* telemetry_;
+  AdminChannel* admin_channel_;
+  LoadGenerator* load_generator_;
+  ScriptedBenchmark* scripted_benchmark_;
+  ReplayBenchmark* replay_benchmark_;
 };
 
 }  // namespace ballistica::classic
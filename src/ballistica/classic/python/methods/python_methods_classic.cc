@@ -4,17 +4,26 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/support/camera.h"
 #include "ballistica/base/input/input.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_writer.h"
+#include "ballistica/classic/support/admin_channel.h"
 #include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/classic/support/load_generator.h"
+#include "ballistica/classic/support/replay_benchmark.h"
+#include "ballistica/classic/support/scripted_benchmark.h"
 #include "ballistica/classic/support/stress_test.h"
+#include "ballistica/classic/support/telemetry.h"
+#include "ballistica/classic/support/tick_monitor.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/python/python.h"
 #include "ballistica/shared/python/python_command.h"
+#include "ballistica/shared/python/python_ref.h"
 #include "ballistica/shared/python/python_sys.h"
 
 namespace ballistica::classic {
@@ -89,6 +98,42 @@ static auto PyValueTest(PyObject* self, PyObject* args, PyObject* keywds)
     }
     appmode->set_dynamics_sync_time(std::max(0, appmode->dynamics_sync_time()));
     return_val = appmode->dynamics_sync_time();
+  } else if (!strcmp(arg, "coalesceNodeAttrs")) {
+    auto* appmode = ClassicAppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_coalesce_node_attrs(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_coalesce_node_attrs(false);
+    }
+    if (have_absolute) {
+      appmode->set_coalesce_node_attrs(static_cast<bool>(absolute));
+    }
+    return_val = appmode->coalesce_node_attrs();
+  } else if (!strcmp(arg, "clientInputPrediction")) {
+    auto* appmode = ClassicAppMode::GetSingleton();
+    if (have_change && change > 0.5f) {
+      appmode->set_client_input_prediction(true);
+    }
+    if (have_change && change < -0.5f) {
+      appmode->set_client_input_prediction(false);
+    }
+    if (have_absolute) {
+      appmode->set_client_input_prediction(static_cast<bool>(absolute));
+    }
+    return_val = appmode->client_input_prediction();
+  } else if (!strcmp(arg, "offloadPacketCompression")) {
+    auto* writer = g_base->network_writer;
+    if (have_change && change > 0.5f) {
+      writer->set_offload_compression(true);
+    }
+    if (have_change && change < -0.5f) {
+      writer->set_offload_compression(false);
+    }
+    if (have_absolute) {
+      writer->set_offload_compression(static_cast<bool>(absolute));
+    }
+    return_val = writer->offload_compression();
   } else if (!strcmp(arg, "showNetInfo")) {
     if (have_change && change > 0.5f) {
       g_base->graphics->set_show_net_info(true);
@@ -184,6 +229,432 @@ static PyMethodDef PySetStressTestingDef = {
     "(internal)",
 };
 
+// ------------------------------ set_telemetry --------------------------------
+
+static auto PySetTelemetry(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* address_obj;
+  int port{};
+  double interval{1.0};
+  static const char* kwlist[] = {"address", "port", "interval", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|id",
+                                   const_cast<char**>(kwlist), &address_obj,
+                                   &port, &interval)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  std::string address;
+  if (address_obj != Py_None) {
+    address = Python::GetPyString(address_obj);
+  }
+  g_classic->telemetry()->Set(address, port, interval);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetTelemetryDef = {
+    "set_telemetry",               // name
+    (PyCFunction)PySetTelemetry,   // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "set_telemetry(address: str | None, port: int = 0,\n"
+    "  interval: float = 1.0) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Periodically send binary state snapshots over UDP to the given\n"
+    "address and port (see classic/support/telemetry.h for the layout).\n"
+    "Pass None to stop.",
+};
+
+// ---------------------------- set_admin_channel ------------------------------
+
+static auto PySetAdminChannel(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* path_obj;
+  static const char* kwlist[] = {"path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist), &path_obj)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  std::string path;
+  if (path_obj != Py_None) {
+    path = Python::GetPyString(path_obj);
+  }
+  g_classic->admin_channel()->Set(path);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetAdminChannelDef = {
+    "set_admin_channel",             // name
+    (PyCFunction)PySetAdminChannel,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "set_admin_channel(path: str | None) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Serve framed json admin requests on a unix domain socket at the\n"
+    "given path (see classic/support/admin_channel.h for the protocol).\n"
+    "Pass None to stop.",
+};
+
+// ---------------------------- set_load_generator -----------------------------
+
+static auto PySetLoadGenerator(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* address_obj;
+  int port{kDefaultPort};
+  int client_count{8};
+  float join_rate{2.0f};
+  unsigned int seed{};
+  static const char* kwlist[] = {"address",   "port", "client_count",
+                                 "join_rate", "seed", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|iifI",
+                                   const_cast<char**>(kwlist), &address_obj,
+                                   &port, &client_count, &join_rate, &seed)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  std::string address;
+  if (address_obj != Py_None) {
+    address = Python::GetPyString(address_obj);
+  }
+  g_classic->load_generator()->Set(address, port, client_count, join_rate,
+                                   seed);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetLoadGeneratorDef = {
+    "set_load_generator",             // name
+    (PyCFunction)PySetLoadGenerator,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "set_load_generator(address: str | None, port: int = 43210,\n"
+    "  client_count: int = 8, join_rate: float = 2.0, seed: int = 0)\n"
+    "  -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Connect synthetic headless clients to the given host to measure\n"
+    "how it holds up (see classic/support/load_generator.h).\n"
+    "Pass None to disconnect them.",
+};
+
+// ------------------------ get_load_generator_report --------------------------
+
+static auto PyGetLoadGeneratorReport(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  return PyUnicode_FromString(
+      g_classic->load_generator()->GetReport().c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetLoadGeneratorReportDef = {
+    "get_load_generator_report",            // name
+    (PyCFunction)PyGetLoadGeneratorReport,  // method
+    METH_NOARGS,                            // flags
+
+    "get_load_generator_report() -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return a json summary of the current or most recent load-generator\n"
+    "run: join times, per-client bandwidth and host step timing.",
+};
+
+// ----------------------------- set_tick_monitor ------------------------------
+
+static auto PySetTickMonitor(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  int enabled;
+  PyObject* tiers_obj{Py_None};
+  auto* appmode = ClassicAppMode::GetActiveOrThrow();
+  auto* monitor = appmode->tick_monitor();
+  TickMonitor::Config config = monitor->config();
+  static const char* kwlist[] = {"enabled",         "high_load",
+                                 "low_load",        "escalate_windows",
+                                 "recover_windows", "tiers",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "p|ffiiO", const_cast<char**>(kwlist), &enabled,
+          &config.high_load, &config.low_load, &config.escalate_windows,
+          &config.recover_windows, &tiers_obj)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  if (config.low_load > config.high_load) {
+    throw Exception("low_load must not be greater than high_load.",
+                    PyExcType::kValue);
+  }
+  if (config.escalate_windows < 1 || config.recover_windows < 1) {
+    throw Exception("Window counts must be at least 1.", PyExcType::kValue);
+  }
+  if (tiers_obj != Py_None) {
+    if (!PySequence_Check(tiers_obj)) {
+      throw Exception("Expected a sequence for tiers.", PyExcType::kType);
+    }
+    config.tiers.clear();
+    PythonRef tiers(PySequence_Fast(tiers_obj, "expected a sequence"),
+                    PythonRef::kSteal);
+    Py_ssize_t tier_count = PySequence_Fast_GET_SIZE(tiers.get());
+    PyObject** tier_objs = PySequence_Fast_ITEMS(tiers.get());
+    for (Py_ssize_t i = 0; i < tier_count; ++i) {
+      if (!PyDict_Check(tier_objs[i])) {
+        throw Exception("Expected a dict for each tier.", PyExcType::kType);
+      }
+      PyObject* tier_obj = tier_objs[i];
+      TickMonitor::Tier tier;
+      if (auto* val = PyDict_GetItemString(tier_obj, "dynamics_sync_time")) {
+        tier.min_dynamics_sync_time =
+            static_cast<int>(Python::GetPyInt64(val));
+      }
+      if (auto* val = PyDict_GetItemString(tier_obj, "buffer_time")) {
+        tier.min_buffer_time = static_cast<int>(Python::GetPyInt64(val));
+      }
+      if (auto* val = PyDict_GetItemString(tier_obj, "bg_dynamics")) {
+        tier.forward_bg_dynamics = Python::GetPyBool(val);
+      }
+      if (auto* val = PyDict_GetItemString(tier_obj, "joins")) {
+        tier.accept_joins = Python::GetPyBool(val);
+      }
+      config.tiers.push_back(tier);
+    }
+  }
+  monitor->SetConfig(config);
+  monitor->SetEnabled(static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetTickMonitorDef = {
+    "set_tick_monitor",             // name
+    (PyCFunction)PySetTickMonitor,  // method
+    METH_VARARGS | METH_KEYWORDS,   // flags
+
+    "set_tick_monitor(enabled: bool, high_load: float = 0.8,\n"
+    "  low_load: float = 0.5, escalate_windows: int = 3,\n"
+    "  recover_windows: int = 10,\n"
+    "  tiers: Sequence[dict[str, Any]] | None = None) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Degrade service in steps when host scene steps take up too much of\n"
+    "realtime. Load is measured each second as the fraction of time spent\n"
+    "stepping; escalate_windows seconds in a row over high_load move us\n"
+    "down one tier and recover_windows seconds under low_load move us\n"
+    "back up one. Each tier dict can set 'dynamics_sync_time' and\n"
+    "'buffer_time' minimums in milliseconds and turn off 'bg_dynamics'\n"
+    "forwarding or new 'joins'. Omitted values keep their current\n"
+    "setting.",
+};
+
+// -------------------------- get_tick_monitor_state ---------------------------
+
+static auto PyGetTickMonitorState(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  auto* monitor = ClassicAppMode::GetActiveOrThrow()->tick_monitor();
+  return Py_BuildValue("{sOsisfsi}", "enabled",
+                       monitor->enabled() ? Py_True : Py_False, "tier",
+                       monitor->tier(), "load", monitor->last_load(), "steps",
+                       monitor->last_step_count());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetTickMonitorStateDef = {
+    "get_tick_monitor_state",            // name
+    (PyCFunction)PyGetTickMonitorState,  // method
+    METH_NOARGS,                         // flags
+
+    "get_tick_monitor_state() -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return whether the tick monitor is enabled, its current degradation\n"
+    "tier (0 is normal), and the load and step count it measured over the\n"
+    "last second.",
+};
+
+// ------------------------- start_scripted_benchmark --------------------------
+
+static auto PyStartScriptedBenchmark(PyObject* self, PyObject* args,
+                                     PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* camera_path_obj;
+  PyObject* info_obj{Py_None};
+  static const char* kwlist[] = {"camera_path", "info", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|O",
+                                   const_cast<char**>(kwlist),
+                                   &camera_path_obj, &info_obj)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  if (!PySequence_Check(camera_path_obj)) {
+    throw Exception("Expected a sequence for camera_path.",
+                    PyExcType::kType);
+  }
+  std::vector<ScriptedBenchmark::CameraKey> path;
+  PythonRef keys(PySequence_Fast(camera_path_obj, "expected a sequence"),
+                 PythonRef::kSteal);
+  Py_ssize_t key_count = PySequence_Fast_GET_SIZE(keys.get());
+  PyObject** key_objs = PySequence_Fast_ITEMS(keys.get());
+  for (Py_ssize_t i = 0; i < key_count; ++i) {
+    // (time, x, y, z, target_x, target_y, target_z)
+    std::vector<float> vals = Python::GetPyFloats(key_objs[i]);
+    if (vals.size() != 7) {
+      throw Exception("Camera keys must contain 7 values.",
+                      PyExcType::kValue);
+    }
+    ScriptedBenchmark::CameraKey key;
+    key.time = vals[0];
+    key.position = {vals[1], vals[2], vals[3]};
+    key.target = {vals[4], vals[5], vals[6]};
+    path.push_back(key);
+  }
+  std::vector<std::pair<std::string, std::string>> info;
+  if (info_obj != Py_None) {
+    if (!PyDict_Check(info_obj)) {
+      throw Exception("Expected a dict for info.", PyExcType::kType);
+    }
+    PyObject* key;
+    PyObject* value;
+    Py_ssize_t pos{};
+    while (PyDict_Next(info_obj, &pos, &key, &value)) {
+      info.emplace_back(Python::GetPyString(key), Python::GetPyString(value));
+    }
+  }
+  g_classic->scripted_benchmark()->Start(std::move(path), std::move(info));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartScriptedBenchmarkDef = {
+    "start_scripted_benchmark",             // name
+    (PyCFunction)PyStartScriptedBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,           // flags
+
+    "start_scripted_benchmark(camera_path: Sequence[Sequence[float]],\n"
+    "  info: dict[str, str] | None = None) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Fly the camera along camera_path (keys of time, position and target)\n"
+    "and capture per-frame timings until stop_scripted_benchmark().",
+};
+
+// ------------------------- stop_scripted_benchmark ---------------------------
+
+static auto PyStopScriptedBenchmark(PyObject* self, PyObject* args,
+                                    PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* results_path_obj{Py_None};
+  static const char* kwlist[] = {"results_path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|O",
+                                   const_cast<char**>(kwlist),
+                                   &results_path_obj)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  std::string results_path;
+  if (results_path_obj != Py_None) {
+    results_path = Python::GetPyString(results_path_obj);
+  }
+  return PyUnicode_FromString(
+      g_classic->scripted_benchmark()->Stop(results_path).c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStopScriptedBenchmarkDef = {
+    "stop_scripted_benchmark",             // name
+    (PyCFunction)PyStopScriptedBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,          // flags
+
+    "stop_scripted_benchmark(results_path: str | None = None) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Stop the running scripted benchmark and return its results as json\n"
+    "(p50/p95/p99 frame, logic and render times), optionally also\n"
+    "writing them to results_path.",
+};
+
+// -------------------------- start_replay_benchmark ---------------------------
+
+static auto PyStartReplayBenchmark(PyObject* self, PyObject* args,
+                                   PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* file_name_obj;
+  double step{1.0 / 60.0};
+  PyObject* results_path_obj{Py_None};
+  PyObject* call_obj{Py_None};
+  static const char* kwlist[] = {"file_name", "step", "results_path", "call",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|dOO",
+                                   const_cast<char**>(kwlist), &file_name_obj,
+                                   &step, &results_path_obj, &call_obj)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  std::string results_path;
+  if (results_path_obj != Py_None) {
+    results_path = Python::GetPyString(results_path_obj);
+  }
+  g_classic->replay_benchmark()->Start(
+      Python::GetPyString(file_name_obj),
+      static_cast<microsecs_t>(step * 1000000.0), results_path, call_obj);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartReplayBenchmarkDef = {
+    "start_replay_benchmark",             // name
+    (PyCFunction)PyStartReplayBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,         // flags
+
+    "start_replay_benchmark(file_name: str, step: float = 1.0 / 60.0,\n"
+    "  results_path: str | None = None,\n"
+    "  call: Callable[[str], None] | None = None) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Play a replay through once, advancing display-time by exactly step\n"
+    "seconds per update, and capture session-update, scene-draw and\n"
+    "frame timings. The results json is written to results_path and\n"
+    "passed to call when the replay finishes.",
+};
+
+// --------------------------- stop_replay_benchmark ---------------------------
+
+static auto PyStopReplayBenchmark(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  g_classic->replay_benchmark()->Stop();
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStopReplayBenchmarkDef = {
+    "stop_replay_benchmark",             // name
+    (PyCFunction)PyStopReplayBenchmark,  // method
+    METH_NOARGS,                         // flags
+
+    "stop_replay_benchmark() -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "End the running replay benchmark early; results are delivered as\n"
+    "if it had finished.",
+};
+
 // --------------- classic_app_mode_handle_app_intent_exec ---------------------
 
 static auto PyClassicAppModeHandleAppIntentExec(PyObject* self, PyObject* args,
@@ -445,6 +916,16 @@ auto PythonMethodsClassic::GetMethods() -> std::vector<PyMethodDef> {
   return {
       PyValueTestDef,
       PySetStressTestingDef,
+      PySetTelemetryDef,
+      PySetAdminChannelDef,
+      PySetLoadGeneratorDef,
+      PyGetLoadGeneratorReportDef,
+      PySetTickMonitorDef,
+      PyGetTickMonitorStateDef,
+      PyStartScriptedBenchmarkDef,
+      PyStopScriptedBenchmarkDef,
+      PyStartReplayBenchmarkDef,
+      PyStopReplayBenchmarkDef,
       PyClassicAppModeHandleAppIntentExecDef,
       PyClassicAppModeHandleAppIntentDefaultDef,
       PyClassicAppModeActivateDef,
@@ -0,0 +1,513 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/classic/support/admin_channel.h"
+
+#if !BA_OSTYPE_WINDOWS
+#include <fcntl.h>
+#include <sys/un.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/assets/assets.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/base/support/context.h"
+#include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/scene_v1/connection/connection_set.h"
+#include "ballistica/scene_v1/connection/connection_to_client.h"
+#include "ballistica/scene_v1/connection/connection_to_host.h"
+#include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_stream.h"
+#include "ballistica/shared/networking/networking_sys.h"
+#include "ballistica/shared/python/python_command.h"
+#include "ballistica/shared/python/python_sys.h"
+
+namespace ballistica::classic {
+
+#if !BA_OSTYPE_WINDOWS
+
+// Clients going away mid-write shouldn't take us down with a SIGPIPE.
+#ifdef MSG_NOSIGNAL
+const int kAdminChannelSendFlags{MSG_NOSIGNAL};
+#else
+const int kAdminChannelSendFlags{};
+#endif
+
+static void SetNonBlocking_(int fd) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+#endif  // !BA_OSTYPE_WINDOWS
+
+static void WriteConnectionJson_(JsonWriter* writer, int client_id,
+                                 const scene_v1::Connection& c) {
+  writer->BeginObject();
+  writer->Key("client_id");
+  writer->Number(client_id);
+  writer->Key("ping");
+  writer->Number(c.current_ping());
+  writer->Key("bytes_in_per_sec");
+  writer->Number(static_cast<double>(c.GetBytesInPerSecond()));
+  writer->Key("bytes_out_per_sec");
+  writer->Number(static_cast<double>(c.GetBytesOutPerSecond()));
+  writer->Key("bytes_resent_per_sec");
+  writer->Number(static_cast<double>(c.GetBytesResentPerSecond()));
+  writer->EndObject();
+}
+
+AdminChannel::AdminChannel() = default;
+
+AdminChannel::~AdminChannel() { Stop_(); }
+
+void AdminChannel::Set(const std::string& path) {
+  assert(g_base->InLogicThread());
+  Stop_();
+  if (path.empty()) {
+    return;
+  }
+#if BA_OSTYPE_WINDOWS
+  throw Exception("Admin channels are not supported on this platform.");
+#else
+  sockaddr_un addr{};
+  if (path.size() >= sizeof(addr.sun_path)) {
+    throw Exception("Admin channel path too long: '" + path + "'.",
+                    PyExcType::kValue);
+  }
+  addr.sun_family = AF_UNIX;
+  memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+  // Clear out any stale socket from a previous run.
+  unlink(path.c_str());
+  int sd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sd < 0) {
+    throw Exception("Unable to create admin channel socket: "
+                    + g_core->platform->GetSocketErrorString());
+  }
+  if (bind(sd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+      || listen(sd, 8) != 0) {
+    std::string error = g_core->platform->GetSocketErrorString();
+    close(sd);
+    throw Exception("Unable to listen at '" + path + "': " + error);
+  }
+  if (pipe(wake_sds_) != 0) {
+    close(sd);
+    unlink(path.c_str());
+    throw Exception("Unable to create admin channel wake pipe.");
+  }
+  SetNonBlocking_(sd);
+  SetNonBlocking_(wake_sds_[0]);
+  SetNonBlocking_(wake_sds_[1]);
+  listen_sd_ = sd;
+  path_ = path;
+  {
+    std::scoped_lock lock(outbox_mutex_);
+    stopping_ = false;
+    outbox_.clear();
+  }
+  running_ = true;
+  thread_ = std::thread([this] { RunThread_(); });
+#endif  // BA_OSTYPE_WINDOWS
+}
+
+void AdminChannel::Stop_() {
+  if (!running_) {
+    return;
+  }
+#if !BA_OSTYPE_WINDOWS
+  {
+    std::scoped_lock lock(outbox_mutex_);
+    stopping_ = true;
+    outbox_.clear();
+  }
+  Wake_();
+  thread_.join();
+  close(listen_sd_);
+  close(wake_sds_[0]);
+  close(wake_sds_[1]);
+  listen_sd_ = wake_sds_[0] = wake_sds_[1] = -1;
+  unlink(path_.c_str());
+  path_.clear();
+#endif  // !BA_OSTYPE_WINDOWS
+  running_ = false;
+}
+
+void AdminChannel::Wake_() {
+#if !BA_OSTYPE_WINDOWS
+  if (wake_sds_[1] >= 0) {
+    char val{};
+    // If the pipe is full a wake is already pending anyway.
+    [[maybe_unused]] auto result = write(wake_sds_[1], &val, 1);
+  }
+#endif
+}
+
+void AdminChannel::RunThread_() {
+#if !BA_OSTYPE_WINDOWS
+  std::vector<pollfd> fds;
+  std::vector<int64_t> ids;
+  std::vector<Request_> requests;
+  while (true) {
+    fds.clear();
+    ids.clear();
+    fds.push_back({wake_sds_[0], POLLIN, 0});
+    fds.push_back({listen_sd_, POLLIN, 0});
+    for (auto&& i : connections_) {
+      auto events = static_cast<short>(  // NOLINT(runtime/int)
+          POLLIN | (i.second.out.empty() ? 0 : POLLOUT));
+      fds.push_back({i.second.sd, events, 0});
+      ids.push_back(i.first);
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    // Pick up any responses the logic thread has for us.
+    if (fds[0].revents) {
+      char buffer[64];
+      while (read(wake_sds_[0], buffer, sizeof(buffer)) > 0) {
+      }
+      std::scoped_lock lock(outbox_mutex_);
+      if (stopping_) {
+        break;
+      }
+      for (auto&& response : outbox_) {
+        auto i = connections_.find(response.first);
+        if (i == connections_.end()) {
+          continue;
+        }
+        auto size = static_cast<uint32_t>(response.second.size());
+        i->second.out.append(reinterpret_cast<const char*>(&size),
+                             sizeof(size));
+        i->second.out += response.second;
+      }
+      outbox_.clear();
+    }
+    if (fds[1].revents & POLLIN) {
+      Accept_();
+    }
+    for (size_t i = 0; i < ids.size(); ++i) {
+      auto revents = fds[i + 2].revents;
+      auto c = connections_.find(ids[i]);
+      assert(c != connections_.end());
+      bool ok{true};
+      if (revents & (POLLIN | POLLHUP | POLLERR)) {
+        ok = Read_(ids[i], &c->second, &requests);
+      }
+      if (ok && !c->second.out.empty()) {
+        ok = Write_(&c->second);
+      }
+      if (!ok) {
+        close(c->second.sd);
+        connections_.erase(c);
+      }
+    }
+
+    // Everything we read this time around goes over in one call.
+    if (!requests.empty()) {
+      auto* logic_loop = g_base->logic->event_loop();
+      if (!logic_loop->CheckPushSafety()) {
+        BA_LOG_ONCE(LogName::kBa, LogLevel::kWarning,
+                    "Rejecting admin channel requests; logic thread is "
+                    "backed up.");
+        for (auto&& request : requests) {
+          auto c = connections_.find(request.connection);
+          if (c == connections_.end()) {
+            continue;
+          }
+          std::string response = "{\"id\":" + request.id + ",\"error\":";
+          JsonWriter::AppendString(&response, "Logic thread is backed up.");
+          response += "}";
+          auto size = static_cast<uint32_t>(response.size());
+          c->second.out.append(reinterpret_cast<const char*>(&size),
+                               sizeof(size));
+          c->second.out += response;
+        }
+        requests.clear();
+        continue;
+      }
+      auto* batch = new std::vector<Request_>(std::move(requests));
+      requests.clear();
+      logic_loop->PushCall([this, batch] {
+        HandleRequests_(*batch);
+        delete batch;
+      });
+    }
+  }
+  for (auto&& i : connections_) {
+    close(i.second.sd);
+  }
+  connections_.clear();
+#endif  // !BA_OSTYPE_WINDOWS
+}
+
+void AdminChannel::Accept_() {
+#if !BA_OSTYPE_WINDOWS
+  while (true) {
+    int sd = accept(listen_sd_, nullptr, nullptr);
+    if (sd < 0) {
+      break;
+    }
+    if (static_cast<int>(connections_.size())
+        >= kAdminChannelMaxConnections) {
+      close(sd);
+      continue;
+    }
+    SetNonBlocking_(sd);
+#ifdef SO_NOSIGPIPE
+    int val{1};
+    setsockopt(sd, SOL_SOCKET, SO_NOSIGPIPE, &val, sizeof(val));
+#endif
+    connections_[next_connection_id_++].sd = sd;
+  }
+#endif  // !BA_OSTYPE_WINDOWS
+}
+
+auto AdminChannel::Read_(int64_t id, Connection_* c,
+                         std::vector<Request_>* requests) -> bool {
+#if BA_OSTYPE_WINDOWS
+  return false;
+#else
+  // Cap how much we take per pass so a chatty connection can't starve
+  // the others.
+  uint8_t buffer[16384];
+  for (int i = 0; i < 8; ++i) {
+    auto amt = recv(c->sd, buffer, sizeof(buffer), 0);
+    if (amt == 0) {
+      return false;
+    }
+    if (amt < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      return false;
+    }
+    c->in.insert(c->in.end(), buffer, buffer + amt);
+  }
+  size_t offset{};
+  while (c->in.size() - offset >= sizeof(uint32_t)) {
+    uint32_t size;
+    memcpy(&size, c->in.data() + offset, sizeof(size));
+    if (size > kAdminChannelMaxFrameSize) {
+      return false;
+    }
+    if (c->in.size() - offset - sizeof(size) < size) {
+      break;
+    }
+    requests->push_back(
+        ParseRequest_(id, c->in.data() + offset + sizeof(size), size));
+    offset += sizeof(size) + size;
+  }
+  c->in.erase(c->in.begin(), c->in.begin() + static_cast<ptrdiff_t>(offset));
+  return true;
+#endif  // BA_OSTYPE_WINDOWS
+}
+
+auto AdminChannel::Write_(Connection_* c) -> bool {
+#if BA_OSTYPE_WINDOWS
+  return false;
+#else
+  size_t sent{};
+  while (sent < c->out.size()) {
+    auto amt = send(c->sd, c->out.data() + sent, c->out.size() - sent,
+                    kAdminChannelSendFlags);
+    if (amt < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      return false;
+    }
+    sent += static_cast<size_t>(amt);
+  }
+  c->out.erase(0, sent);
+  return true;
+#endif  // BA_OSTYPE_WINDOWS
+}
+
+auto AdminChannel::ParseRequest_(int64_t connection, const uint8_t* data,
+                                 size_t size) -> Request_ {
+  Request_ request;
+  request.connection = connection;
+  request.id = "null";
+  std::string_view json(reinterpret_cast<const char*>(data), size);
+  bool valid = JsonReader::ForEachMember(
+      json, [&request](std::string_view key, const JsonReader::Value& value) {
+        if (key == "id") {
+          request.id.clear();
+          if (value.IsString()) {
+            JsonWriter::AppendString(&request.id, value.string);
+          } else if (value.IsNumber()) {
+            JsonWriter::AppendNumber(&request.id, value.number);
+          } else {
+            request.id = "null";
+          }
+        } else if (key == "cmd" && value.IsString()) {
+          request.cmd = value.string;
+        } else if (key == "code" && value.IsString()) {
+          request.code = value.string;
+        }
+      });
+  if (!valid) {
+    request.error = "Request is not a json object.";
+  } else if (request.cmd.empty()) {
+    request.error = "Request has no cmd.";
+  }
+  return request;
+}
+
+void AdminChannel::HandleRequests_(const std::vector<Request_>& requests) {
+  assert(g_base->InLogicThread());
+  std::vector<std::pair<int64_t, std::string> > responses;
+  responses.reserve(requests.size());
+  for (auto&& request : requests) {
+    responses.emplace_back(request.connection, HandleRequest_(request));
+  }
+  {
+    std::scoped_lock lock(outbox_mutex_);
+    if (stopping_ || !running_) {
+      return;
+    }
+    for (auto&& response : responses) {
+      outbox_.push_back(std::move(response));
+    }
+  }
+  Wake_();
+}
+
+auto AdminChannel::HandleRequest_(const Request_& request) -> std::string {
+  std::string result;
+  std::string error = request.error;
+  if (error.empty()) {
+    try {
+      auto* appmode = ClassicAppMode::GetActive();
+      if (request.cmd == "ping") {
+        result = "true";
+      } else if (request.cmd == "players") {
+        if (!appmode) {
+          throw Exception("Classic app mode is not active.");
+        }
+        if (cJSON* roster = appmode->game_roster()) {
+          char* s = cJSON_PrintUnformatted(roster);
+          result = s;
+          free(s);
+        } else {
+          result = "[]";
+        }
+      } else if (request.cmd == "stats") {
+        result = GetStats_();
+      } else if (request.cmd == "exec") {
+        // Same deal as commands from the stdin console.
+        base::ScopedSetContext ssc(
+            g_base->app_mode()->GetForegroundContext());
+        PythonCommand cmd(request.code, "<admin>");
+        g_core->user_ran_commands = true;
+        result = "null";
+        if (cmd.CanEval()) {
+          auto obj = cmd.Eval(true, nullptr, nullptr);
+          if (!obj.exists()) {
+            throw Exception("Error evaluating code; see log.");
+          }
+          if (obj.get() != Py_None) {
+            result.clear();
+            JsonWriter::AppendString(&result, obj.Repr());
+          }
+        } else if (!cmd.Exec(true, nullptr, nullptr)) {
+          throw Exception("Error executing code; see log.");
+        }
+      } else {
+        throw Exception("Unknown cmd '" + request.cmd + "'.");
+      }
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+  }
+  std::string response = "{\"id\":" + request.id;
+  if (error.empty()) {
+    response += ",\"result\":";
+    response += result;
+  } else {
+    response += ",\"error\":";
+    JsonWriter::AppendString(&response, error);
+  }
+  response += "}";
+  return response;
+}
+
+auto AdminChannel::GetStats_() -> std::string {
+  JsonWriter writer(512);
+  auto* appmode = ClassicAppMode::GetActive();
+  writer.BeginObject();
+  writer.Key("app_time");
+  writer.Number(g_core->AppTimeSeconds());
+
+  size_t node_count{};
+  if (appmode) {
+    if (auto* scene = appmode->GetForegroundScene()) {
+      node_count = scene->nodes().size();
+    }
+  }
+  writer.Key("nodes");
+  writer.Number(static_cast<double>(node_count));
+
+  auto* assets = g_base->assets;
+  writer.Key("assets");
+  writer.BeginObject();
+  writer.Key("meshes");
+  writer.Number(assets->total_mesh_count());
+  writer.Key("textures");
+  writer.Number(assets->total_texture_count());
+  writer.Key("sounds");
+  writer.Number(assets->total_sound_count());
+  writer.Key("collision_meshes");
+  writer.Number(assets->total_collision_mesh_count());
+  writer.Key("pending_loads");
+  writer.Number(static_cast<double>(assets->GetPendingLoadCount()));
+  writer.EndObject();
+
+  writer.Key("event_loops");
+  writer.BeginArray();
+  for (auto* event_loop : EventLoop::GetAllEventLoops()) {
+    writer.BeginObject();
+    writer.Key("id");
+    writer.Number(static_cast<int>(event_loop->identifier()));
+    writer.Key("queue_depth");
+    writer.Number(static_cast<double>(event_loop->GetQueueDepth()));
+    writer.EndObject();
+  }
+  writer.EndArray();
+
+  // Our host connection (if any) first with client id -1, then clients.
+  writer.Key("connections");
+  writer.BeginArray();
+  if (appmode) {
+    auto* connections = appmode->connections();
+    if (auto* host = connections->connection_to_host()) {
+      WriteConnectionJson_(&writer, -1, *host);
+    }
+    for (auto&& i : connections->connections_to_clients()) {
+      if (auto* client = i.second.get()) {
+        WriteConnectionJson_(&writer, client->id(), *client);
+      }
+    }
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return writer.TakeString();
+}
+
+}  // namespace ballistica::classic
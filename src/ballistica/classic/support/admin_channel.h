@@ -0,0 +1,102 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CLASSIC_SUPPORT_ADMIN_CHANNEL_H_
+#define BALLISTICA_CLASSIC_SUPPORT_ADMIN_CHANNEL_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ballistica/classic/classic.h"
+
+namespace ballistica::classic {
+
+/// Largest request frame we accept; connections sending bigger get
+/// dropped.
+const uint32_t kAdminChannelMaxFrameSize{1024 * 1024};
+
+/// Most connections we service at once.
+const int kAdminChannelMaxConnections{32};
+
+/// A local control socket for server wrappers and fleet managers; a
+/// lighter-weight alternative to feeding Python to the stdin console.
+/// Its own thread accepts connections on a unix domain socket, reads and
+/// parses framed json requests, and writes responses. Only the work of
+/// answering requests happens in the logic thread, and everything read
+/// from a connection in one go is handed over in a single call.
+///
+/// Frames are a u32 little-endian byte count followed by that much utf-8
+/// json. Requests are objects with a "cmd" string and optional "id"
+/// (echoed back in the response). Requests may be pipelined; responses
+/// come back in order on each connection as {"id": ..., "result": ...} or
+/// {"id": ..., "error": str} (the one exception being requests turned away
+/// on the spot because the logic thread is backed up).
+///
+/// Commands:
+///   "ping": result true (handy for gauging logic thread latency).
+///   "players": the current party roster (as sent to clients).
+///   "stats": node and asset counts, event loop queue depths, and ping
+///     and traffic for each connection.
+///   "exec": run the "code" string in the foreground context as the stdin
+///     console would; result is the repr of its value if it evaluates.
+///
+/// Unix-like platforms only.
+class AdminChannel {
+ public:
+  AdminChannel();
+  ~AdminChannel();
+
+  /// Start listening at a socket path (replacing any existing socket file
+  /// there) or stop if it is empty. Logic thread only.
+  void Set(const std::string& path);
+
+ private:
+  struct Request_ {
+    int64_t connection{};
+    std::string id;  // Json for the request's id ("null" if none).
+    std::string cmd;
+    std::string code;
+    std::string error;  // Set if the request came in malformed.
+  };
+
+  struct Connection_ {
+    int sd{-1};
+    std::vector<uint8_t> in;
+    std::string out;
+  };
+
+  void Stop_();
+  void RunThread_();
+  void Accept_();
+  auto Read_(int64_t id, Connection_* c, std::vector<Request_>* requests)
+      -> bool;
+  auto Write_(Connection_* c) -> bool;
+  void Wake_();
+  auto ParseRequest_(int64_t connection, const uint8_t* data, size_t size)
+      -> Request_;
+  void HandleRequests_(const std::vector<Request_>& requests);
+  auto HandleRequest_(const Request_& request) -> std::string;
+  auto GetStats_() -> std::string;
+
+  std::string path_;
+  int listen_sd_{-1};
+  int wake_sds_[2]{-1, -1};
+  bool running_{};
+  std::thread thread_;
+
+  // Only touched in our thread.
+  std::map<int64_t, Connection_> connections_;
+  int64_t next_connection_id_{};
+
+  // Responses from the logic thread waiting to be picked up by ours.
+  std::mutex outbox_mutex_;
+  std::vector<std::pair<int64_t, std::string> > outbox_;
+  bool stopping_{};
+};
+
+}  // namespace ballistica::classic
+
+#endif  // BALLISTICA_CLASSIC_SUPPORT_ADMIN_CHANNEL_H_
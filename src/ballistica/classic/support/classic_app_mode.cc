@@ -4,7 +4,9 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/audio/audio.h"
@@ -12,14 +14,19 @@
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/support/frame_def.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/logic/logic_profiler.h"
 #include "ballistica/base/networking/network_writer.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/support/app_config.h"
 #include "ballistica/base/support/plus_soft.h"
+#include "ballistica/classic/support/game_roster_codec.h"
+#include "ballistica/classic/support/load_generator.h"
+#include "ballistica/classic/support/replay_benchmark.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/scene_v1/connection/connection_set.h"
 #include "ballistica/scene_v1/connection/connection_to_client.h"
 #include "ballistica/scene_v1/connection/connection_to_host.h"
+#include "ballistica/scene_v1/connection/shared_message.h"
 #include "ballistica/scene_v1/node/globals_node.h"
 #include "ballistica/scene_v1/python/scene_v1_python.h"
 #include "ballistica/scene_v1/support/client_input_device.h"
@@ -30,6 +37,7 @@
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/foundation/macros.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_stream.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/networking/sockaddr.h"
 #include "ballistica/ui_v1/ui_v1.h"
@@ -54,13 +62,6 @@ const int kKickVoteFailRetryDelayInitiatorExtra = 120000;
 // to kick).
 const int kKickVoteMinimumClients = (g_buildconfig.headless_build() ? 3 : 4);
 
-struct ClassicAppMode::ScanResultsEntryPriv_ {
-  scene_v1::PlayerSpec player_spec;
-  std::string address;
-  uint32_t last_query_id{};
-  millisecs_t last_contact_time{};
-};
-
 base::InputDeviceDelegate* ClassicAppMode::CreateInputDeviceDelegate(
     base::InputDevice* device) {
   // We create a special delegate for our special ClientInputDevice types;
@@ -173,109 +174,138 @@ void ClassicAppMode::Reset_() {
   g_base->graphics->FadeScreen(true, 250, nullptr);
 }
 
-// Note: for now we're making our host-scan network calls directly from the
-// logic thread. This is generally not a good idea since it appears that even
-// in non-blocking mode they're still blocking for 3-4ms sometimes. But for
-// now since this is only used minimally and only while in the UI I guess it's
-// ok.
+// How often we check for scan responses while scanning.
+const millisecs_t kHostScanPollInterval{100};
+
+// How long a host can go without answering before we drop it.
+const millisecs_t kHostScanResultExpiry{3000};
+
 void ClassicAppMode::HostScanCycle() {
   assert(g_base->InLogicThread());
 
-  // We need to create a scanner socket - an ipv4 socket we can send out
-  // broadcast messages from.
-  if (scan_socket_ == -1) {
-    scan_socket_ = socket(AF_INET, SOCK_DGRAM, 0);
-
-    if (scan_socket_ == -1) {
-      g_core->Log(LogName::kBaNetworking, LogLevel::kError,
-                  "Error opening scan socket: "
-                      + g_core->platform->GetSocketErrorString() + ".");
+  // Socket calls can block for a few milliseconds even in non-blocking
+  // mode, so we keep them all in the network-write thread.
+  g_base->network_writer->event_loop()->PushCall([this] {
+    if (scan_socket_ == -1 && !OpenScanSocket_()) {
       return;
     }
 
-    // Since this guy lives in the logic-thread we need it to not block.
-    if (!g_core->platform->SetSocketNonBlocking(scan_socket_)) {
-      g_core->Log(LogName::kBaNetworking, LogLevel::kError,
-                  "Error setting socket non-blocking.");
-      g_core->platform->CloseSocket(scan_socket_);
-      scan_socket_ = -1;
-      return;
+    // Ok we've got a valid scanner socket. Now lets send out broadcast
+    // pings on all available networks.
+    std::vector<uint32_t> addrs = g_core->platform->GetBroadcastAddrs();
+    for (auto&& i : addrs) {
+      sockaddr_in addr{};
+      addr.sin_family = AF_INET;
+      addr.sin_port = htons(kDefaultPort);  // NOLINT
+      addr.sin_addr.s_addr = htonl(i);      // NOLINT
+
+      // Include our query id (so we can sort out which responses come back
+      // quickest).
+      uint8_t data[5];
+      data[0] = BA_PACKET_HOST_QUERY;
+      memcpy(data + 1, &next_scan_query_id_, 4);
+      ssize_t result =
+          sendto(scan_socket_, reinterpret_cast<socket_send_data_t*>(data),
+                 sizeof(data), 0, reinterpret_cast<sockaddr*>(&addr),
+                 sizeof(addr));
+      if (result == -1) {
+        int err = g_core->platform->GetSocketError();
+        switch (err) {  // NOLINT(hicpp-multiway-paths-covered)
+          case ENETUNREACH:
+            break;
+          default:
+            g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                        "Error on scan-socket sendto: "
+                            + g_core->platform->GetSocketErrorString());
+        }
+      }
     }
+    next_scan_query_id_++;
+  });
+}
 
-    // Bind to whatever.
-    struct sockaddr_in serv_addr{};
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);  // NOLINT
-    serv_addr.sin_port = 0;                         // any
-    int result =
-        ::bind(scan_socket_, (struct sockaddr*)&serv_addr, sizeof(serv_addr));
-    if (result == 1) {
-      g_core->Log(LogName::kBaNetworking, LogLevel::kError,
-                  "Error binding socket: "
-                      + g_core->platform->GetSocketErrorString() + ".");
-      g_core->platform->CloseSocket(scan_socket_);
-      scan_socket_ = -1;
-      return;
-    }
+auto ClassicAppMode::OpenScanSocket_() -> bool {
+  assert(g_base->network_writer->event_loop()->ThreadIsCurrent());
+  assert(scan_socket_ == -1);
 
-    // Enable broadcast on the socket.
-    BA_SOCKET_SETSOCKOPT_VAL_TYPE op_val{1};
-    result = setsockopt(scan_socket_, SOL_SOCKET, SO_BROADCAST, &op_val,
-                        sizeof(op_val));
-
-    if (result != 0) {
-      g_core->Log(LogName::kBaNetworking, LogLevel::kError,
-                  "Error enabling broadcast for scan-socket: "
-                      + g_core->platform->GetSocketErrorString() + ".");
-      g_core->platform->CloseSocket(scan_socket_);
-      scan_socket_ = -1;
-      return;
-    }
-  }
+  // We need to create a scanner socket - an ipv4 socket we can send out
+  // broadcast messages from.
+  scan_socket_ = socket(AF_INET, SOCK_DGRAM, 0);
 
-  // Ok we've got a valid scanner socket. Now lets send out broadcast pings on
-  // all available networks.
-  std::vector<uint32_t> addrs = g_core->platform->GetBroadcastAddrs();
-  for (auto&& i : addrs) {
-    sockaddr_in addr{};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(kDefaultPort);  // NOLINT
-    addr.sin_addr.s_addr = htonl(i);      // NOLINT
-
-    // Include our query id (so we can sort out which responses come back
-    // quickest).
-    uint8_t data[5];
-    data[0] = BA_PACKET_HOST_QUERY;
-    memcpy(data + 1, &next_scan_query_id_, 4);
-    BA_DEBUG_TIME_CHECK_BEGIN(sendto);
-    ssize_t result = sendto(
-        scan_socket_, reinterpret_cast<socket_send_data_t*>(data), sizeof(data),
-        0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
-    BA_DEBUG_TIME_CHECK_END(sendto, 10);
-    if (result == -1) {
-      int err = g_core->platform->GetSocketError();
-      switch (err) {  // NOLINT(hicpp-multiway-paths-covered)
-        case ENETUNREACH:
-          break;
-        default:
-          g_core->Log(LogName::kBaNetworking, LogLevel::kError,
-                      "Error on scan-socket sendto: "
-                          + g_core->platform->GetSocketErrorString());
-      }
-    }
+  if (scan_socket_ == -1) {
+    g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                "Error opening scan socket: "
+                    + g_core->platform->GetSocketErrorString() + ".");
+    return false;
+  }
+
+  // We poll this guy from a timer so we need it to not block.
+  if (!g_core->platform->SetSocketNonBlocking(scan_socket_)) {
+    g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                "Error setting socket non-blocking.");
+    CloseScanSocket_();
+    return false;
+  }
+
+  // Bind to whatever.
+  struct sockaddr_in serv_addr{};
+  memset(&serv_addr, 0, sizeof(serv_addr));
+  serv_addr.sin_family = AF_INET;
+  serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);  // NOLINT
+  serv_addr.sin_port = 0;                         // any
+  int result =
+      ::bind(scan_socket_, (struct sockaddr*)&serv_addr, sizeof(serv_addr));
+  if (result == 1) {
+    g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                "Error binding socket: "
+                    + g_core->platform->GetSocketErrorString() + ".");
+    CloseScanSocket_();
+    return false;
+  }
+
+  // Enable broadcast on the socket.
+  BA_SOCKET_SETSOCKOPT_VAL_TYPE op_val{1};
+  result = setsockopt(scan_socket_, SOL_SOCKET, SO_BROADCAST, &op_val,
+                      sizeof(op_val));
+
+  if (result != 0) {
+    g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                "Error enabling broadcast for scan-socket: "
+                    + g_core->platform->GetSocketErrorString() + ".");
+    CloseScanSocket_();
+    return false;
+  }
+
+  // Pick up responses as they arrive instead of waiting for our next cycle.
+  scan_timer_ = g_base->network_writer->event_loop()->NewTimer(
+      kHostScanPollInterval * 1000, true,
+      NewLambdaRunnable([this] { ReadScanResponses_(); }).get());
+  return true;
+}
+
+void ClassicAppMode::CloseScanSocket_() {
+  assert(g_base->network_writer->event_loop()->ThreadIsCurrent());
+  if (scan_timer_) {
+    g_base->network_writer->event_loop()->DeleteTimer(scan_timer_->id());
+    scan_timer_ = nullptr;
+  }
+  if (scan_socket_ != -1) {
+    g_core->platform->CloseSocket(scan_socket_);
+    scan_socket_ = -1;
   }
-  next_scan_query_id_++;
+}
 
-  // ..and see if any responses came in from previous sends.
+void ClassicAppMode::ReadScanResponses_() {
+  assert(g_base->network_writer->event_loop()->ThreadIsCurrent());
+  if (scan_socket_ == -1) {
+    return;
+  }
   char buffer[256];
   sockaddr_storage from{};
   socklen_t from_size = sizeof(from);
   while (true) {
-    BA_DEBUG_TIME_CHECK_BEGIN(recvfrom);
     ssize_t result = recvfrom(scan_socket_, buffer, sizeof(buffer), 0,
                               reinterpret_cast<sockaddr*>(&from), &from_size);
-    BA_DEBUG_TIME_CHECK_END(recvfrom, 10);
 
     if (result == -1) {
       int err = g_core->platform->GetSocketError();
@@ -307,39 +337,25 @@ void ClassicAppMode::HostScanCycle() {
         if (id_len > 0 && id_len <= 100 && player_spec_len > 0
             && player_spec_len <= 255
             && (11 + id_len + player_spec_len == result)) {
-          char id[101];
-          char player_spec_str[256];
-          memcpy(id, buffer + 11, id_len);
-          memcpy(player_spec_str, buffer + 11 + id_len, player_spec_len);
+          std::string id(buffer + 11, id_len);
 
-          id[id_len] = 0;
-          player_spec_str[player_spec_len] = 0;
+          // Ignore if it looks like its us.
+          if (id == g_base->GetAppInstanceUUID()) {
+            continue;
+          }
 
           // Add or modify an entry for this.
-          {
-            std::scoped_lock lock(scan_results_mutex_);
-
-            // Ignore if it looks like its us.
-            if (id != g_base->GetAppInstanceUUID()) {
-              std::string key = id;
-              auto i = scan_results_.find(key);
-
-              // Make a new entry if its not there.
-              bool do_update_entry = (i == scan_results_.end()
-                                      || i->second.last_query_id != query_id);
-              if (do_update_entry) {
-                ScanResultsEntryPriv_& entry(scan_results_[key]);
-                entry.player_spec = scene_v1::PlayerSpec(player_spec_str);
-                char buffer2[256];
-                entry.address = inet_ntop(
-                    AF_INET,
-                    &((reinterpret_cast<sockaddr_in*>(&from))->sin_addr),
-                    buffer2, sizeof(buffer2));
-                entry.last_query_id = query_id;
-                entry.last_contact_time = g_core->AppTimeMillisecs();
-              }
-            }
-            PruneScanResults_();
+          std::scoped_lock lock(scan_results_mutex_);
+          auto i = scan_results_.find(id);
+          if (i == scan_results_.end() || i->second.last_query_id != query_id) {
+            ScanResultsEntryPriv_& entry(scan_results_[id]);
+            entry.player_spec.assign(buffer + 11 + id_len, player_spec_len);
+            char buffer2[256];
+            entry.address = inet_ntop(
+                AF_INET, &((reinterpret_cast<sockaddr_in*>(&from))->sin_addr),
+                buffer2, sizeof(buffer2));
+            entry.last_query_id = query_id;
+            entry.last_contact_time = g_core->AppTimeMillisecs();
           }
         } else {
           g_core->Log(LogName::kBaNetworking, LogLevel::kError,
@@ -351,43 +367,38 @@ void ClassicAppMode::HostScanCycle() {
       }
     }
   }
+  std::scoped_lock lock(scan_results_mutex_);
+  PruneScanResults_();
 }
 
 void ClassicAppMode::EndHostScanning() {
-  if (scan_socket_ != -1) {
-    g_core->platform->CloseSocket(scan_socket_);
-    scan_socket_ = -1;
-  }
+  g_base->network_writer->event_loop()->PushCall(
+      [this] { CloseScanSocket_(); });
 }
 
 void ClassicAppMode::PruneScanResults_() {
   millisecs_t t = g_core->AppTimeMillisecs();
-  auto i = scan_results_.begin();
-  while (i != scan_results_.end()) {
-    auto i_next = i;
-    i_next++;
-    if (t - i->second.last_contact_time > 3000) {
-      scan_results_.erase(i);
+  for (auto i = scan_results_.begin(); i != scan_results_.end();) {
+    if (t - i->second.last_contact_time > kHostScanResultExpiry) {
+      i = scan_results_.erase(i);
+    } else {
+      ++i;
     }
-    i = i_next;
   }
 }
 
 auto ClassicAppMode::GetScanResults()
     -> std::vector<ClassicAppMode::ScanResultsEntry> {
   std::vector<ScanResultsEntry> results;
-  results.resize(scan_results_.size());
   {
     std::scoped_lock lock(scan_results_mutex_);
-    int out_num = 0;
+    PruneScanResults_();
+    results.reserve(scan_results_.size());
     for (auto&& i : scan_results_) {
-      ScanResultsEntryPriv_& in(i.second);
-      ScanResultsEntry& out(results[out_num]);
-      out.display_string = in.player_spec.GetDisplayString();
-      out.address = in.address;
-      out_num++;
+      results.push_back(
+          {scene_v1::PlayerSpec(i.second.player_spec).GetDisplayString(),
+           i.second.address});
     }
-    PruneScanResults_();
   }
   return results;
 }
@@ -453,29 +464,42 @@ auto ClassicAppMode::GetSingleton() -> ClassicAppMode* {
 
 ClassicAppMode::ClassicAppMode()
     : game_roster_(cJSON_CreateArray()),
-      connections_(std::make_unique<scene_v1::ConnectionSet>()) {}
+      connections_(std::make_unique<scene_v1::ConnectionSet>()) {
+  UpdateJSONPingResponse_();
+}
 
 void ClassicAppMode::HandleIncomingUDPPacket(const std::vector<uint8_t>& data,
                                              const SockAddr& addr) {
-  // Just forward it along to our connection-set to handle.
+  // Packets for any synthetic load-generator clients get claimed first;
+  // everything else goes along to our connection-set to handle.
+  if (g_classic->load_generator()->HandleIncomingUDPPacket(data, addr)) {
+    return;
+  }
   connections()->HandleIncomingUDPPacket(data, addr);
 }
 
 auto ClassicAppMode::HandleJSONPing(const std::string& data_str)
     -> std::string {
-  // Note to self - this is called in a non-logic thread.
-  cJSON* data = cJSON_Parse(data_str.c_str());
-  if (data == nullptr) {
+  // Note to self - this is called in a non-logic thread. We don't look at
+  // anything in the ping currently; just make sure it's valid json.
+  if (!JsonReader::Validate(data_str)) {
     return "";
   }
-  cJSON_Delete(data);
 
+  // Server browsers ping constantly, so we just hand out a response built
+  // ahead of time whenever its contents change.
+  std::scoped_lock lock(json_ping_response_mutex_);
+  return json_ping_response_;
+}
+
+void ClassicAppMode::UpdateJSONPingResponse_() {
   // Ok lets include some basic info that might be pertinent to someone
   // pinging us. Currently that includes our current/max connection count.
   char buffer[256];
   snprintf(buffer, sizeof(buffer), R"({"b":%d,"ps":%d,"psmx":%d})",
-           kEngineBuildNumber, public_party_size(), public_party_max_size());
-  return buffer;
+           kEngineBuildNumber, public_party_size_, public_party_max_size_);
+  std::scoped_lock lock(json_ping_response_mutex_);
+  json_ping_response_ = buffer;
 }
 
 void ClassicAppMode::SetGameRoster(cJSON* r) {
@@ -499,6 +523,10 @@ auto ClassicAppMode::GetPartySize() const -> int {
 }
 
 auto ClassicAppMode::GetHeadlessNextDisplayTimeStep() -> microsecs_t {
+  // Sessions are frozen while we're idle, so their timers don't count.
+  if (IsHeadlessIdle()) {
+    return base::kHeadlessIdleMaxDisplayTimeStep;
+  }
   std::optional<microsecs_t> min_time_to_next;
   for (auto&& i : sessions_) {
     if (!i.exists()) {
@@ -521,6 +549,7 @@ void ClassicAppMode::StepDisplayTime() {
   assert(g_base->InLogicThread());
 
   auto startms{core::CorePlatform::TimeMonotonicMillisecs()};
+  auto start_microsecs{core::CorePlatform::TimeMonotonicMicrosecs()};
   millisecs_t app_time = g_core->AppTimeMillisecs();
   g_core->platform->SetDebugKey("LastUpdateTime", std::to_string(startms));
   in_update_ = true;
@@ -556,6 +585,20 @@ void ClassicAppMode::StepDisplayTime() {
     legacy_display_time_millisecs_inc = milliseconds_inc_max;
   }
 
+  // When idling on a headless server, our sessions sit frozen until
+  // someone shows up; they then pick up where they left off rather than
+  // getting the whole idle period dumped on them at once.
+  bool headless_idle = IsHeadlessIdle();
+  double session_time_advance = g_base->logic->display_time_increment();
+  if (was_headless_idle_ && !headless_idle) {
+    legacy_display_time_millisecs_inc =
+        std::min(legacy_display_time_millisecs_inc,
+                 static_cast<millisecs_t>(scene_v1::kGameStepMilliseconds));
+    session_time_advance =
+        static_cast<double>(legacy_display_time_millisecs_inc) / 1000.0;
+  }
+  was_headless_idle_ = headless_idle;
+
   UpdateKickVote_();
 
   HandleQuitOnIdle_();
@@ -563,36 +606,72 @@ void ClassicAppMode::StepDisplayTime() {
   // Send the game roster to our clients if it's changed recently.
   if (game_roster_dirty_) {
     if (app_time > last_game_roster_send_time_ + 2500) {
-      // Now send it to all connected clients.
-      std::vector<uint8_t> msg = GetGameRosterMessage_();
-      for (auto&& c : connections()->GetConnectionsToClients()) {
-        c->SendReliableMessage(msg);
-      }
+      SendGameRoster_();
       game_roster_dirty_ = false;
       last_game_roster_send_time_ = app_time;
     }
   }
 
-  connections_->Update();
+  {
+    base::LogicProfiler::Scope s("connections");
+    connections_->Update();
+  }
+  if (g_base->graphics->timing_lanes_visible()) {
+    int64_t packets_in{}, packets_out{};
+    for (auto&& c : connections()->GetConnectionsToClients()) {
+      packets_in += c->GetMessagesInPerSecond();
+      packets_out += c->GetMessagesOutPerSecond();
+    }
+    if (auto* host = connections()->connection_to_host()) {
+      packets_in += host->GetMessagesInPerSecond();
+      packets_out += host->GetMessagesOutPerSecond();
+    }
+    g_base->graphics->SetTimingLaneValue(base::TimingLane::kPacketsIn,
+                                         static_cast<float>(packets_in));
+    g_base->graphics->SetTimingLaneValue(base::TimingLane::kPacketsOut,
+                                         static_cast<float>(packets_out));
+  }
 
   // Update all of our sessions.
+  auto* capture = g_base->graphics->frame_timing_capture();
+  auto session_start_microsecs{
+      capture ? core::CorePlatform::TimeMonotonicMicrosecs() : 0};
   for (auto&& i : sessions_) {
-    if (!i.exists()) {
+    if (!i.exists() || headless_idle) {
       continue;
     }
+    base::LogicProfiler::Scope s("session_update");
     // Pass our old int milliseconds time vals for legacy purposes
     // along with the newer exact ones for anyone who wants to use them.
     // (ideally at some point we can pass neither of these and anyone who
     // needs this can just use g_logic->display_time() directly).
     i->Update(static_cast<int>(legacy_display_time_millisecs_inc),
-              g_base->logic->display_time_increment());
+              session_time_advance);
+  }
+  if (capture) {
+    capture->AddSessionUpdate(core::CorePlatform::TimeMonotonicMicrosecs()
+                              - session_start_microsecs);
   }
 
   // Go ahead and prune dead ones.
   PruneSessions_();
 
+  tick_monitor_.Update();
+
   in_update_ = false;
 
+  auto update_microsecs{core::CorePlatform::TimeMonotonicMicrosecs()
+                        - start_microsecs};
+  update_time_stats_.count++;
+  update_time_stats_.total += update_microsecs;
+  update_time_stats_.max = std::max(update_time_stats_.max, update_microsecs);
+  if (capture) {
+    capture->AddLogicUpdate(update_microsecs);
+  }
+  g_base->graphics->SetTimingLaneValue(
+      base::TimingLane::kLogicUpdate,
+      static_cast<float>(update_microsecs) / 1000.0f);
+
   // Report excessively long updates.
   if (g_core->core_config().debug_timing
       && app_time >= next_long_update_report_time_) {
@@ -623,6 +702,43 @@ auto ClassicAppMode::GetGameRosterMessage_() -> std::vector<uint8_t> {
   return msg;
 }
 
+void ClassicAppMode::SendGameRoster_() {
+  // Clients that can take deltas get just what changed since the last send
+  // (once they've had one full roster to start from); everyone else gets
+  // the full json roster.
+  auto entries = GameRosterCodec::EncodeEntries(game_roster_);
+  Object::Ref<scene_v1::SharedMessage> full_msg;
+  Object::Ref<scene_v1::SharedMessage> delta_msg;
+  bool built_delta{};
+  for (auto&& c : connections()->GetConnectionsToClients()) {
+    if (c->game_roster_deltas() && c->got_game_roster()) {
+      if (!built_delta) {
+        auto delta = GameRosterCodec::BuildDelta(sent_game_roster_entries_,
+                                                 entries);
+        if (!delta.empty()) {
+          delta_msg = Object::New<scene_v1::SharedMessage>(delta);
+        }
+        built_delta = true;
+      }
+      if (delta_msg.exists()) {
+        c->SendReliableMessage(delta_msg);
+      }
+      continue;
+    }
+    if (!full_msg.exists()) {
+      full_msg = Object::New<scene_v1::SharedMessage>(GetGameRosterMessage_());
+    }
+    c->SendReliableMessage(full_msg);
+    c->set_got_game_roster(true);
+  }
+  sent_game_roster_entries_ = std::move(entries);
+}
+
+void ClassicAppMode::ApplyGameRosterDelta(const std::vector<uint8_t>& message) {
+  assert(g_base->InLogicThread());
+  SetGameRoster(GameRosterCodec::ApplyDelta(game_roster_, message));
+}
+
 base::ContextRef ClassicAppMode::GetForegroundContext() {
   scene_v1::Session* s = GetForegroundSession();
   if (s) {
@@ -1246,6 +1362,26 @@ void ClassicAppMode::DoApplyAppConfig() {
 
   idle_exit_minutes_ = g_base->app_config->Resolve(
       base::AppConfig::OptionalFloatID::kIdleExitMinutes);
+
+  auto& step_settings{g_scene_v1->step_scheduler_settings()};
+  step_settings.max_catch_up_steps = g_base->app_config->Resolve(
+      base::AppConfig::IntID::kSceneMaxCatchUpSteps);
+  step_settings.overload_slowdown = g_base->app_config->Resolve(
+      base::AppConfig::BoolID::kSceneOverloadSlowdown);
+
+  headless_idle_sleep_ =
+      g_base->app_config->Resolve(base::AppConfig::BoolID::kHeadlessIdleSleep);
+  g_base->logic->WakeHeadlessDisplayTime();
+}
+
+auto ClassicAppMode::IsHeadlessIdle() -> bool {
+  // We're idle when serving with nobody connected; nothing we do matters
+  // until a client arrives. (Replay benchmarks need to keep stepping
+  // though).
+  return headless_idle_sleep_ && g_core->HeadlessMode() && connections_
+         && !connections_->has_connection_to_host()
+         && connections_->connections_to_clients().empty()
+         && !g_classic->replay_benchmark()->running();
 }
 
 void ClassicAppMode::PruneSessions_() {
@@ -1316,6 +1452,7 @@ void ClassicAppMode::SetPublicPartySize(int count) {
     return;
   }
   public_party_size_ = count;
+  UpdateJSONPingResponse_();
 
   // Push our new state to the server *ONLY* if public-party is turned on
   // (wasteful otherwise).
@@ -1344,6 +1481,7 @@ void ClassicAppMode::SetPublicPartyMaxSize(int count) {
     return;
   }
   public_party_max_size_ = count;
+  UpdateJSONPingResponse_();
 
   // Push our new state to the server *ONLY* if public-party is turned on
   // (wasteful otherwise).
@@ -1403,7 +1541,14 @@ auto ClassicAppMode::DoesWorldFillScreen() -> bool {
 
 void ClassicAppMode::DrawWorld(base::FrameDef* frame_def) {
   if (auto* session = GetForegroundSession()) {
+    auto* capture = g_base->graphics->frame_timing_capture();
+    auto start_microsecs{
+        capture ? core::CorePlatform::TimeMonotonicMicrosecs() : 0};
     session->Draw(frame_def);
+    if (capture) {
+      capture->AddSceneDraw(core::CorePlatform::TimeMonotonicMicrosecs()
+                            - start_microsecs);
+    }
     frame_def->set_benchmark_type(session->benchmark_type());
   }
 }
@@ -10,11 +10,13 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/base/app_mode/app_mode.h"
 #include "ballistica/base/base.h"
 #include "ballistica/classic/classic.h"
+#include "ballistica/classic/support/tick_monitor.h"
 #include "ballistica/scene_v1/scene_v1.h"
 #include "ballistica/shared/foundation/object.h"
 #include "ballistica/ui_v1/ui_v1.h"
@@ -57,6 +59,10 @@ class ClassicAppMode : public base::AppMode {
   void UpdateGameRoster();
   void MarkGameRosterDirty() { game_roster_dirty_ = true; }
   void SetGameRoster(cJSON* r);
+
+  /// Apply a BA_MESSAGE_PARTY_ROSTER_DELTA from our host to our roster.
+  /// Throws an Exception on malformed data.
+  void ApplyGameRosterDelta(const std::vector<uint8_t>& message);
   auto GetPartySize() const -> int override;
   auto kick_vote_in_progress() const -> bool { return kick_vote_in_progress_; }
   void StartKickVote(scene_v1::ConnectionToClient* starter,
@@ -169,7 +175,9 @@ class ClassicAppMode : public base::AppMode {
                         bool loop = true);
 
   // Run a cycle of host scanning (basically sending out a broadcast packet
-  // to see who's out there).
+  // to see who's out there). The actual sending and receiving happens in
+  // the network-write thread; responses are collected there as they come
+  // in and GetScanResults() returns a snapshot of them.
   void HostScanCycle();
   void EndHostScanning();
 
@@ -191,8 +199,33 @@ class ClassicAppMode : public base::AppMode {
   void set_delay_bucket_samples(int val) { delay_bucket_samples_ = val; }
   auto buffer_time() const { return buffer_time_; }
   void set_buffer_time(int val) { buffer_time_ = val; }
+  auto coalesce_node_attrs() const { return coalesce_node_attrs_; }
+
+  /// Tracks host step load and how much we're currently degrading our
+  /// service because of it.
+  auto tick_monitor() -> TickMonitor* { return &tick_monitor_; }
+  void set_coalesce_node_attrs(bool val) { coalesce_node_attrs_ = val; }
+  auto client_input_prediction() const { return client_input_prediction_; }
+  void set_client_input_prediction(bool val) {
+    client_input_prediction_ = val;
+  }
   void OnActivate() override;
   auto GetHeadlessNextDisplayTimeStep() -> microsecs_t override;
+  auto IsHeadlessIdle() -> bool override;
+
+  /// How long our StepDisplayTime() calls have been taking.
+  struct UpdateTimeStats {
+    int64_t count{};
+    microsecs_t total{};
+    microsecs_t max{};
+  };
+
+  /// Return update time stats gathered since the last call and reset them.
+  auto TakeUpdateTimeStats() -> UpdateTimeStats {
+    auto stats{update_time_stats_};
+    update_time_stats_ = {};
+    return stats;
+  }
 
   auto host_protocol_version() const {
     assert(host_protocol_version_ != -1);
@@ -238,19 +271,36 @@ class ClassicAppMode : public base::AppMode {
  private:
   ClassicAppMode();
   void OnGameRosterChanged_();
+  void UpdateJSONPingResponse_();
   void PruneScanResults_();
   void UpdateKickVote_();
   auto GetGameRosterMessage_() -> std::vector<uint8_t>;
+  void SendGameRoster_();
   void Reset_();
   void PruneSessions_();
   void HandleQuitOnIdle_();
 
-  struct ScanResultsEntryPriv_;
+  struct ScanResultsEntryPriv_ {
+    std::string player_spec;
+    std::string address;
+    uint32_t last_query_id{};
+    millisecs_t last_contact_time{};
+  };
+
+  // These run in the network-write thread.
+  auto OpenScanSocket_() -> bool;
+  void CloseScanSocket_();
+  void ReadScanResponses_();
 
-  // Note: would use an unordered_map here but gcc doesn't seem to allow
-  // forward declarations of their template params.
-  std::map<std::string, ScanResultsEntryPriv_> scan_results_;
+  // Results keyed by host app-instance id; filled in by the network-write
+  // thread and read by the logic thread.
+  std::unordered_map<std::string, ScanResultsEntryPriv_> scan_results_;
   std::mutex scan_results_mutex_;
+
+  // What we answer json pings with; rebuilt in the logic thread when
+  // anything in it changes and read from the network-reader thread.
+  std::string json_ping_response_;
+  std::mutex json_ping_response_mutex_;
   std::string root_ui_chest_0_appearance_;
   std::string root_ui_chest_1_appearance_;
   std::string root_ui_chest_2_appearance_;
@@ -264,8 +314,10 @@ class ClassicAppMode : public base::AppMode {
   seconds_t root_ui_chest_2_ad_allow_time_;
   seconds_t root_ui_chest_3_ad_allow_time_;
 
+  // Only touched in the network-write thread.
   uint32_t next_scan_query_id_{};
   int scan_socket_{-1};
+  Timer* scan_timer_{};
   int host_protocol_version_{-1};
 
   std::list<std::string> chat_messages_;
@@ -275,6 +327,8 @@ class ClassicAppMode : public base::AppMode {
   Object::WeakRef<scene_v1::Session> foreground_session_;
 
   bool chat_muted_{};
+  bool headless_idle_sleep_{};
+  bool was_headless_idle_{};
   bool in_update_{};
   bool kick_idle_players_{};
   bool public_party_enabled_{};
@@ -291,6 +345,9 @@ class ClassicAppMode : public base::AppMode {
   ui_v1::UIV1FeatureSet* uiv1_{};
   cJSON* game_roster_{};
   millisecs_t last_game_roster_send_time_{};
+
+  // Encoded entries of the roster we last sent out, which deltas go from.
+  std::map<int, std::string> sent_game_roster_entries_;
   std::unique_ptr<scene_v1::ConnectionSet> connections_;
   Object::WeakRef<scene_v1::ConnectionToClient> kick_vote_starter_;
   Object::WeakRef<scene_v1::ConnectionToClient> kick_vote_target_;
@@ -308,7 +365,17 @@ class ClassicAppMode : public base::AppMode {
   // it over the network.
   int buffer_time_{};
 
+  // Whether host session-streams coalesce node-attr writes between sim
+  // steps (last-write-wins) instead of sending each one.
+  bool coalesce_node_attrs_{};
+
+  // Whether, as a client, we apply our own movement input to our spaz
+  // immediately instead of waiting for the host to echo it back.
+  bool client_input_prediction_{};
+
   millisecs_t next_long_update_report_time_{};
+  UpdateTimeStats update_time_stats_;
+  TickMonitor tick_monitor_;
   int debug_speed_exponent_{};
   int replay_speed_exponent_{};
   int public_party_size_{1};  // Always count ourself (is that what we want?).
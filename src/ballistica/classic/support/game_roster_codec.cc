@@ -0,0 +1,199 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/classic/support/game_roster_codec.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/shared/foundation/exception.h"
+#include "ballistica/shared/generic/json.h"
+
+namespace ballistica::classic {
+
+static void WriteVarint(uint32_t val, std::string* out) {
+  while (val >= 0x80) {
+    out->push_back(static_cast<char>(val | 0x80));
+    val >>= 7;
+  }
+  out->push_back(static_cast<char>(val));
+}
+
+static void WriteInt(int val, std::string* out) {
+  auto v = static_cast<uint32_t>(val);
+  WriteVarint((v << 1) ^ (0 - (v >> 31)), out);
+}
+
+static void WriteString(const char* val, std::string* out) {
+  std::string s = val ? val : "";
+  WriteVarint(static_cast<uint32_t>(s.size()), out);
+  out->append(s);
+}
+
+static auto ReadVarint(const uint8_t** ptr, const uint8_t* end) -> uint32_t {
+  uint32_t val = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (*ptr >= end) {
+      throw Exception("truncated varint");
+    }
+    uint8_t byte = *((*ptr)++);
+    val |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return val;
+    }
+  }
+  throw Exception("invalid varint");
+}
+
+static auto ReadInt(const uint8_t** ptr, const uint8_t* end) -> int {
+  uint32_t v = ReadVarint(ptr, end);
+  return static_cast<int>((v >> 1) ^ (0 - (v & 1)));
+}
+
+static auto ReadString(const uint8_t** ptr, const uint8_t* end)
+    -> std::string {
+  uint32_t size = ReadVarint(ptr, end);
+  if (size > static_cast<size_t>(end - *ptr)) {
+    throw Exception("truncated string");
+  }
+  std::string s(reinterpret_cast<const char*>(*ptr), size);
+  *ptr += size;
+  return s;
+}
+
+static auto GetInt(cJSON* obj, const char* name) -> int {
+  cJSON* item = cJSON_GetObjectItem(obj, name);
+  return cJSON_IsNumber(item) ? item->valueint : 0;
+}
+
+static auto GetString(cJSON* obj, const char* name) -> const char* {
+  cJSON* item = cJSON_GetObjectItem(obj, name);
+  return cJSON_IsString(item) ? item->valuestring : "";
+}
+
+auto GameRosterCodec::EncodeEntries(cJSON* roster)
+    -> std::map<int, std::string> {
+  std::map<int, std::string> entries;
+  int count = cJSON_GetArraySize(roster);
+  for (int i = 0; i < count; ++i) {
+    cJSON* client = cJSON_GetArrayItem(roster, i);
+    int client_id = GetInt(client, "i");
+    std::string entry;
+    WriteInt(client_id, &entry);
+    WriteString(GetString(client, "spec"), &entry);
+    cJSON* players = cJSON_GetObjectItem(client, "p");
+    int player_count = cJSON_IsArray(players) ? cJSON_GetArraySize(players) : 0;
+    WriteVarint(static_cast<uint32_t>(player_count), &entry);
+    for (int j = 0; j < player_count; ++j) {
+      cJSON* player = cJSON_GetArrayItem(players, j);
+      WriteString(GetString(player, "n"), &entry);
+      WriteString(GetString(player, "nf"), &entry);
+      WriteInt(GetInt(player, "i"), &entry);
+    }
+    entries[client_id] = std::move(entry);
+  }
+  return entries;
+}
+
+auto GameRosterCodec::BuildDelta(const std::map<int, std::string>& old_entries,
+                                 const std::map<int, std::string>& new_entries)
+    -> std::vector<uint8_t> {
+  std::string removed;
+  uint32_t removed_count{};
+  for (auto&& i : old_entries) {
+    if (new_entries.find(i.first) == new_entries.end()) {
+      WriteInt(i.first, &removed);
+      removed_count++;
+    }
+  }
+  std::string changed;
+  uint32_t changed_count{};
+  for (auto&& i : new_entries) {
+    auto old = old_entries.find(i.first);
+    if (old == old_entries.end() || old->second != i.second) {
+      changed.append(i.second);
+      changed_count++;
+    }
+  }
+  if (removed_count == 0 && changed_count == 0) {
+    return {};
+  }
+  std::string out(1, static_cast<char>(BA_MESSAGE_PARTY_ROSTER_DELTA));
+  WriteVarint(removed_count, &out);
+  out.append(removed);
+  WriteVarint(changed_count, &out);
+  out.append(changed);
+  return {out.begin(), out.end()};
+}
+
+auto GameRosterCodec::ApplyDelta(cJSON* roster,
+                                 const std::vector<uint8_t>& message)
+    -> cJSON* {
+  if (message.empty() || message[0] != BA_MESSAGE_PARTY_ROSTER_DELTA) {
+    throw Exception("invalid roster delta");
+  }
+  const uint8_t* ptr = message.data() + 1;
+  const uint8_t* end = message.data() + message.size();
+
+  cJSON* new_roster = cJSON_Duplicate(roster, true);
+  try {
+    uint32_t removed_count = ReadVarint(&ptr, end);
+    for (uint32_t i = 0; i < removed_count; ++i) {
+      int client_id = ReadInt(&ptr, end);
+      int count = cJSON_GetArraySize(new_roster);
+      for (int j = 0; j < count; ++j) {
+        if (GetInt(cJSON_GetArrayItem(new_roster, j), "i") == client_id) {
+          cJSON_DeleteItemFromArray(new_roster, j);
+          break;
+        }
+      }
+    }
+    uint32_t changed_count = ReadVarint(&ptr, end);
+    for (uint32_t i = 0; i < changed_count; ++i) {
+      int client_id = ReadInt(&ptr, end);
+      cJSON* client = cJSON_CreateObject();
+      cJSON_AddItemToObject(
+          client, "spec", cJSON_CreateString(ReadString(&ptr, end).c_str()));
+      cJSON* players = cJSON_CreateArray();
+      cJSON_AddItemToObject(client, "p", players);
+      cJSON_AddItemToObject(client, "i", cJSON_CreateNumber(client_id));
+      uint32_t player_count = ReadVarint(&ptr, end);
+      for (uint32_t j = 0; j < player_count; ++j) {
+        cJSON* player = cJSON_CreateObject();
+        cJSON_AddItemToArray(players, player);
+        cJSON_AddItemToObject(
+            player, "n", cJSON_CreateString(ReadString(&ptr, end).c_str()));
+        cJSON_AddItemToObject(
+            player, "nf", cJSON_CreateString(ReadString(&ptr, end).c_str()));
+        cJSON_AddItemToObject(player, "i",
+                              cJSON_CreateNumber(ReadInt(&ptr, end)));
+      }
+
+      // Changed entries replace their old selves in place; new ones go on
+      // the end.
+      int count = cJSON_GetArraySize(new_roster);
+      int index{-1};
+      for (int j = 0; j < count; ++j) {
+        if (GetInt(cJSON_GetArrayItem(new_roster, j), "i") == client_id) {
+          index = j;
+          break;
+        }
+      }
+      if (index == -1) {
+        cJSON_AddItemToArray(new_roster, client);
+      } else {
+        cJSON_ReplaceItemInArray(new_roster, index, client);
+      }
+    }
+    if (ptr != end) {
+      throw Exception("trailing data in roster delta");
+    }
+  } catch (...) {
+    cJSON_Delete(new_roster);
+    throw;
+  }
+  return new_roster;
+}
+
+}  // namespace ballistica::classic
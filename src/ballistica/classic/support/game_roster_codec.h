@@ -0,0 +1,43 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CLASSIC_SUPPORT_GAME_ROSTER_CODEC_H_
+#define BALLISTICA_CLASSIC_SUPPORT_GAME_ROSTER_CODEC_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ballistica/classic/classic.h"
+
+namespace ballistica::classic {
+
+/// Builds and applies BA_MESSAGE_PARTY_ROSTER_DELTA messages for clients
+/// that advertise support for them, so roster churn on busy servers
+/// doesn't mean resending the whole roster as json to everyone.
+///
+/// Entries are keyed by client id (-1 for the host). A delta is a type
+/// byte, a varint count of removed client ids (each a zigzag varint), then
+/// a varint count of added-or-changed entries. Each entry is its zigzag
+/// client id, its spec string, then a varint player count followed by
+/// each player's name, full name and zigzag id. Strings are a varint
+/// length plus utf8 bytes.
+class GameRosterCodec {
+ public:
+  /// Binary-encode each entry of a json roster, keyed by client id.
+  static auto EncodeEntries(cJSON* roster) -> std::map<int, std::string>;
+
+  /// Build a delta message taking a client from one set of encoded entries
+  /// to another. Returns an empty vector if there are no changes.
+  static auto BuildDelta(const std::map<int, std::string>& old_entries,
+                         const std::map<int, std::string>& new_entries)
+      -> std::vector<uint8_t>;
+
+  /// Return a new json roster with a delta message applied to an existing
+  /// one (which is left untouched). Throws an Exception on malformed data.
+  static auto ApplyDelta(cJSON* roster, const std::vector<uint8_t>& message)
+      -> cJSON*;
+};
+
+}  // namespace ballistica::classic
+
+#endif  // BALLISTICA_CLASSIC_SUPPORT_GAME_ROSTER_CODEC_H_
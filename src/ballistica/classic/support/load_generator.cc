@@ -0,0 +1,587 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/classic/support/load_generator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/networking/network_writer.h"
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/scene_v1/support/player_spec.h"
+#include "ballistica/shared/generic/json_stream.h"
+#include "ballistica/shared/math/random.h"
+
+namespace ballistica::classic {
+
+// How often we pester the host for a client-id (same as ConnectionToHostUDP).
+const millisecs_t kLoadGeneratorRequestInterval{500};
+
+// How long a client can go without hearing from the host before we count
+// it as failed.
+const millisecs_t kLoadGeneratorTimeout{10000};
+
+// Keep each client's step-gap samples bounded on long runs.
+const size_t kLoadGeneratorMaxStepSamples{20000};
+
+LoadGeneratorClient::LoadGeneratorClient(const SockAddr& addr, int index,
+                                         uint8_t request_id,
+                                         std::string instance_uuid)
+    : addr_(addr),
+      instance_uuid_(std::move(instance_uuid)),
+      index_(index),
+      protocol_version_(
+          ClassicAppMode::GetSingleton()->host_protocol_version()),
+      request_id_(request_id) {
+  start_time_ = last_host_packet_time_ = g_core->AppTimeMillisecs();
+  SendClientRequest_();
+}
+
+LoadGeneratorClient::~LoadGeneratorClient() { set_connection_dying(true); }
+
+void LoadGeneratorClient::SendClientRequest_() {
+  // Same layout as ConnectionToHostUDP's: protocol version (2 bytes),
+  // request id (1 byte) and our instance uuid for the remainder.
+  last_request_time_ = g_core->AppTimeMillisecs();
+  std::vector<uint8_t> msg(4 + instance_uuid_.size());
+  msg[0] = BA_PACKET_CLIENT_REQUEST;
+  auto p_version = static_cast<uint16_t>(protocol_version_);
+  memcpy(&(msg[1]), &p_version, 2);
+  msg[3] = request_id_;
+  memcpy(&(msg[4]), instance_uuid_.c_str(), instance_uuid_.size());
+  total_bytes_out_ += static_cast<int64_t>(msg.size());
+  g_base->network_writer->PushSendToCall(msg, addr_);
+}
+
+void LoadGeneratorClient::SendDisconnectRequest_() {
+  if (client_id_ != -1) {
+    total_bytes_out_ += 2;
+    g_base->network_writer->PushSendToCall(
+        {BA_PACKET_DISCONNECT_FROM_CLIENT_REQUEST,
+         static_cast_check_fit<uint8_t>(client_id_)},
+        addr_);
+  }
+}
+
+void LoadGeneratorClient::Finish_(State state) {
+  if (state_ == State::kFailed || state_ == State::kLeft) {
+    return;
+  }
+  state_ = state;
+  end_time_ = g_core->AppTimeMillisecs();
+  set_connection_dying(true);
+}
+
+void LoadGeneratorClient::Update() {
+  if (state_ == State::kFailed || state_ == State::kLeft) {
+    return;
+  }
+  millisecs_t real_time = g_core->AppTimeMillisecs();
+  if (real_time - last_host_packet_time_ > kLoadGeneratorTimeout) {
+    SendDisconnectRequest_();
+    Finish_(State::kFailed);
+    return;
+  }
+  if (state_ == State::kRequesting) {
+    if (real_time - last_request_time_ > kLoadGeneratorRequestInterval) {
+      SendClientRequest_();
+    }
+    return;
+  }
+
+  // Null messages keep pings measured and the host aware of us, as
+  // ConnectionToHost does.
+  if (can_communicate() && real_time - last_ping_send_time_ > 2000) {
+    SendReliableMessage(std::vector<uint8_t>{BA_MESSAGE_NULL});
+    last_ping_send_time_ = real_time;
+  }
+  Connection::Update();
+}
+
+void LoadGeneratorClient::HandleAccept(uint8_t client_id) {
+  last_host_packet_time_ = g_core->AppTimeMillisecs();
+  if (state_ == State::kRequesting) {
+    client_id_ = client_id;
+    state_ = State::kAccepted;
+  }
+}
+
+void LoadGeneratorClient::HandleDeny() { Finish_(State::kFailed); }
+
+void LoadGeneratorClient::HandleHostDisconnect() { Finish_(State::kLeft); }
+
+void LoadGeneratorClient::AddBytesIn(size_t bytes) {
+  total_bytes_in_ += static_cast<int64_t>(bytes);
+  last_host_packet_time_ = g_core->AppTimeMillisecs();
+}
+
+void LoadGeneratorClient::HandleGamePacket(const std::vector<uint8_t>& data) {
+  if (state_ == State::kFailed || state_ == State::kLeft || data.empty()) {
+    return;
+  }
+  switch (data[0]) {
+    case BA_SCENEPACKET_HANDSHAKE: {
+      // Protocol version in bytes 1 and 2; host info beyond that.
+      if (data.size() <= 3) {
+        break;
+      }
+      uint16_t their_protocol_version;
+      memcpy(&their_protocol_version, data.data() + 1,
+             sizeof(their_protocol_version));
+      if (their_protocol_version < scene_v1::kProtocolVersionClientMin
+          || their_protocol_version > scene_v1::kProtocolVersionMax) {
+        Error("");
+        return;
+      }
+      protocol_version_ = their_protocol_version;
+
+      // Respond with a dummy spec and a device id unique to this client.
+      // We don't claim compact session-commands so the host sends plain
+      // ones which we can pick steps out of cheaply.
+      std::string name = "LoadGen " + std::to_string(index_);
+      JsonWriter writer(256);
+      writer.BeginObject();
+      writer.Key("s");
+      writer.String(
+          scene_v1::PlayerSpec::GetDummyPlayerSpec(name).GetSpecString());
+      writer.Key("d");
+      writer.String(instance_uuid_);
+      writer.EndObject();
+      const std::string& out = writer.str();
+      std::vector<uint8_t> response(3 + out.size());
+      response[0] = BA_SCENEPACKET_HANDSHAKE_RESPONSE;
+      memcpy(response.data() + 1, &their_protocol_version,
+             sizeof(their_protocol_version));
+      memcpy(response.data() + 3, out.c_str(), out.size());
+      SendGamePacket(response);
+
+      if (!can_communicate()) {
+        set_can_communicate(true);
+        state_ = State::kConnected;
+
+        // An empty token tells the host not to bother looking us up.
+        JsonWriter info(64);
+        info.BeginObject();
+        info.Key("b");
+        info.Number(kEngineBuildNumber);
+        info.Key("tk");
+        info.String("");
+        info.EndObject();
+        std::vector<uint8_t> msg(info.str().size() + 1);
+        msg[0] = BA_MESSAGE_CLIENT_INFO;
+        memcpy(&(msg[1]), info.str().c_str(), info.str().size());
+        SendReliableMessage(msg);
+      }
+      break;
+    }
+    case BA_SCENEPACKET_DISCONNECT: {
+      Finish_(State::kLeft);
+      break;
+    }
+    default:
+      if (can_communicate()) {
+        Connection::HandleGamePacket(data);
+      }
+      break;
+  }
+}
+
+void LoadGeneratorClient::HandleMessagePacket(
+    const std::vector<uint8_t>& buffer) {
+  if (buffer.empty()) {
+    return;
+  }
+  switch (buffer[0]) {
+    case BA_MESSAGE_SESSION_RESET:
+    case BA_MESSAGE_SESSION_COMMANDS:
+    case BA_MESSAGE_SESSION_COMMANDS_COMPACT: {
+      // The host streaming its session to us is what joined means.
+      if (state_ == State::kConnected) {
+        state_ = State::kJoined;
+        join_time_ = g_core->AppTimeMillisecs();
+      }
+      if (buffer[0] == BA_MESSAGE_SESSION_COMMANDS) {
+        HandleSessionCommands_(buffer);
+      }
+      break;
+    }
+    default:
+      Connection::HandleMessagePacket(buffer);
+      break;
+  }
+}
+
+void LoadGeneratorClient::HandleSessionCommands_(
+    const std::vector<uint8_t>& buffer) {
+  // 16 bit length followed by command, repeated (see ClientSession).
+  const auto kStepCommand =
+      static_cast<uint8_t>(scene_v1::SessionCommand::kBaseTimeStep);
+  int64_t stepped{};
+  bool got_step{};
+  size_t offset{1};
+  while (offset + 2 <= buffer.size()) {
+    uint16_t size;
+    memcpy(&size, &(buffer[offset]), 2);
+    offset += 2;
+    if (offset + size > buffer.size()) {
+      break;
+    }
+    if (size >= 2 && buffer[offset] == kStepCommand) {
+      stepped += buffer[offset + 1];
+      got_step = true;
+    }
+    offset += size;
+  }
+  if (!got_step) {
+    return;
+  }
+  millisecs_t real_time = g_core->AppTimeMillisecs();
+  if (first_step_time_ == -1) {
+    first_step_time_ = real_time;
+  } else {
+    base_time_received_ += stepped;
+    if (step_gaps_.size() < kLoadGeneratorMaxStepSamples) {
+      step_gaps_.push_back(static_cast<float>(real_time - last_step_time_));
+    }
+  }
+  last_step_time_ = real_time;
+}
+
+auto LoadGeneratorClient::GetHostTimeRate() const -> float {
+  if (first_step_time_ == -1 || last_step_time_ <= first_step_time_) {
+    return 0.0f;
+  }
+  return static_cast<float>(base_time_received_)
+         / static_cast<float>(last_step_time_ - first_step_time_);
+}
+
+void LoadGeneratorClient::RequestDisconnect() {
+  if (state_ == State::kFailed || state_ == State::kLeft) {
+    return;
+  }
+  SendDisconnectRequest_();
+  Finish_(State::kLeft);
+}
+
+void LoadGeneratorClient::Error(const std::string& error_msg) {
+  // Our own failures are reported in the summary; nothing goes on screen.
+  Connection::Error("");
+  SendDisconnectRequest_();
+  Finish_(State::kFailed);
+}
+
+void LoadGeneratorClient::SendGamePacketCompressed(
+    const std::vector<uint8_t>& data) {
+  assert(!data.empty());
+  if (client_id_ == -1) {
+    return;
+  }
+  std::vector<uint8_t> data_full(data.size() + 2);
+  memcpy(&(data_full[2]), &data[0], data.size());
+  data_full[0] = BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED;
+  data_full[1] = static_cast_check_fit<uint8_t>(client_id_);
+  total_bytes_out_ += static_cast<int64_t>(data_full.size());
+  g_base->network_writer->PushSendToCall(data_full, addr_);
+}
+
+void LoadGenerator::Set(const std::string& address, int port,
+                        int client_count, float join_rate, uint32_t seed) {
+  assert(g_base->InLogicThread());
+  Stop_();
+  if (address.empty()) {
+    return;
+  }
+  if (port <= 0 || port > 65535) {
+    throw Exception("Invalid port: " + std::to_string(port) + ".",
+                    PyExcType::kValue);
+  }
+  if (client_count < 1 || client_count > kLoadGeneratorMaxClients) {
+    throw Exception("client_count must be between 1 and "
+                        + std::to_string(kLoadGeneratorMaxClients) + ".",
+                    PyExcType::kValue);
+  }
+  if (join_rate <= 0.0f) {
+    throw Exception("join_rate must be positive.", PyExcType::kValue);
+  }
+  if (!g_base->network_writer) {
+    throw Exception("Networking is not available.");
+  }
+  target_ = SockAddr(address, port);
+  clients_.clear();
+  client_count_ = client_count;
+  join_rate_ = join_rate;
+  seed_ = seed;
+  first_request_id_ = static_cast<uint8_t>(RandomStream(seed).NextUInt32());
+  start_time_ = g_core->AppTimeMillisecs();
+  stop_time_ = -1;
+  timer_ = base::AppTimer::New(1.0 / 30.0, true, [this] { Update_(); });
+  Update_();
+}
+
+void LoadGenerator::Stop_() {
+  if (!timer_.exists()) {
+    return;
+  }
+  timer_.Clear();
+  stop_time_ = g_core->AppTimeMillisecs();
+  for (auto&& client : clients_) {
+    client->RequestDisconnect();
+  }
+}
+
+void LoadGenerator::Update_() {
+  assert(g_base->InLogicThread());
+  millisecs_t real_time = g_core->AppTimeMillisecs();
+
+  // Clients join on a fixed schedule so runs are comparable.
+  while (static_cast<int>(clients_.size()) < client_count_
+         && static_cast<float>(real_time - start_time_)
+                >= static_cast<float>(clients_.size()) * 1000.0f
+                       / join_rate_) {
+    auto index = static_cast<int>(clients_.size());
+    RandomStream random(seed_, static_cast<uint64_t>(index) + 1);
+    char uuid[64];
+    snprintf(uuid, sizeof(uuid), "loadgen-%08x-%08x", random.NextUInt32(),
+             random.NextUInt32());
+    clients_.push_back(Object::New<LoadGeneratorClient>(
+        *target_, index, static_cast<uint8_t>(first_request_id_ + index),
+        uuid));
+  }
+  for (auto&& client : clients_) {
+    client->Update();
+  }
+}
+
+auto LoadGenerator::ClientForRequestID_(uint8_t request_id)
+    -> LoadGeneratorClient* {
+  auto index = static_cast<uint8_t>(request_id - first_request_id_);
+  if (index < clients_.size()) {
+    return clients_[index].get();
+  }
+  return nullptr;
+}
+
+auto LoadGenerator::ClientForClientID_(uint8_t client_id)
+    -> LoadGeneratorClient* {
+  for (auto&& client : clients_) {
+    if (client->client_id() == client_id) {
+      return client.get();
+    }
+  }
+  return nullptr;
+}
+
+auto LoadGenerator::HandleIncomingUDPPacket(const std::vector<uint8_t>& data,
+                                            const SockAddr& addr) -> bool {
+  assert(g_base->InLogicThread());
+  if (clients_.empty() || !target_.has_value() || !(addr == *target_)
+      || data.size() < 2) {
+    return false;
+  }
+  switch (data[0]) {
+    case BA_PACKET_CLIENT_ACCEPT: {
+      if (data.size() != 3) {
+        return false;
+      }
+      if (auto* client = ClientForRequestID_(data[2])) {
+        client->HandleAccept(data[1]);
+        return true;
+      }
+      return false;
+    }
+    case BA_PACKET_CLIENT_DENY:
+    case BA_PACKET_CLIENT_DENY_PARTY_FULL:
+    case BA_PACKET_CLIENT_DENY_ALREADY_IN_PARTY:
+    case BA_PACKET_CLIENT_DENY_VERSION_MISMATCH: {
+      if (auto* client = ClientForRequestID_(data[1])) {
+        client->HandleDeny();
+        return true;
+      }
+      return false;
+    }
+    case BA_PACKET_HOST_GAMEPACKET_COMPRESSED: {
+      if (data.size() <= 2) {
+        return false;
+      }
+      if (auto* client = ClientForRequestID_(data[1])) {
+        client->AddBytesIn(data.size());
+        std::vector<uint8_t> data2(data.begin() + 2, data.end());
+        client->HandleGamePacketCompressed(data2);
+        return true;
+      }
+      return false;
+    }
+    case BA_PACKET_DISCONNECT_FROM_HOST_REQUEST: {
+      if (auto* client = ClientForClientID_(data[1])) {
+        client->HandleHostDisconnect();
+        g_base->network_writer->PushSendToCall(
+            {BA_PACKET_DISCONNECT_FROM_HOST_ACK, data[1]}, addr);
+        return true;
+      }
+      return false;
+    }
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_ACK: {
+      return ClientForClientID_(data[1]) != nullptr;
+    }
+    default:
+      return false;
+  }
+}
+
+// Writes count, mean and a few percentiles of values (which get sorted).
+static void WriteDistribution_(JsonWriter* writer, const char* key,
+                               std::vector<float>* values) {
+  writer->Key(key);
+  writer->BeginObject();
+  writer->Key("count");
+  writer->Number(static_cast<double>(values->size()));
+  if (!values->empty()) {
+    std::sort(values->begin(), values->end());
+    double total{};
+    for (auto value : *values) {
+      total += value;
+    }
+    auto at = [values](double fraction) {
+      auto i = static_cast<size_t>(fraction
+                                   * static_cast<double>(values->size() - 1));
+      return (*values)[i];
+    };
+    writer->Key("mean");
+    writer->Number(total / static_cast<double>(values->size()));
+    writer->Key("min");
+    writer->Number(values->front());
+    writer->Key("p50");
+    writer->Number(at(0.5));
+    writer->Key("p90");
+    writer->Number(at(0.9));
+    writer->Key("p99");
+    writer->Number(at(0.99));
+    writer->Key("max");
+    writer->Number(values->back());
+  }
+  writer->EndObject();
+}
+
+static auto StateName_(LoadGeneratorClient::State state) -> const char* {
+  switch (state) {
+    case LoadGeneratorClient::State::kRequesting:
+      return "requesting";
+    case LoadGeneratorClient::State::kAccepted:
+      return "accepted";
+    case LoadGeneratorClient::State::kConnected:
+      return "connected";
+    case LoadGeneratorClient::State::kJoined:
+      return "joined";
+    case LoadGeneratorClient::State::kFailed:
+      return "failed";
+    case LoadGeneratorClient::State::kLeft:
+      return "left";
+  }
+  return "unknown";
+}
+
+auto LoadGenerator::GetReport() const -> std::string {
+  assert(g_base->InLogicThread());
+  millisecs_t now =
+      stop_time_ == -1 ? g_core->AppTimeMillisecs() : stop_time_;
+
+  std::vector<float> join_times;
+  std::vector<float> step_gaps;
+  std::vector<float> bytes_in_per_sec;
+  std::vector<float> bytes_out_per_sec;
+  std::vector<float> host_time_rates;
+  int joined{};
+  int failed{};
+
+  JsonWriter writer(1024);
+  writer.BeginObject();
+  if (target_.has_value()) {
+    writer.Key("target");
+    writer.String(target_->AddressString() + ":"
+                  + std::to_string(target_->Port()));
+  }
+  writer.Key("seed");
+  writer.Number(seed_);
+  writer.Key("join_rate");
+  writer.Number(join_rate_);
+  writer.Key("duration_ms");
+  writer.Number(static_cast<double>(clients_.empty() ? 0 : now - start_time_));
+  writer.Key("clients");
+  writer.BeginArray();
+  for (auto&& client : clients_) {
+    // Rates cover each client's whole life, starting from its first
+    // request.
+    millisecs_t end = client->end_time() == -1 ? now : client->end_time();
+    auto seconds =
+        static_cast<float>(std::max(end - client->start_time(), millisecs_t{1}))
+        / 1000.0f;
+    float in_rate = static_cast<float>(client->total_bytes_in()) / seconds;
+    float out_rate = static_cast<float>(client->total_bytes_out()) / seconds;
+    bytes_in_per_sec.push_back(in_rate);
+    bytes_out_per_sec.push_back(out_rate);
+    if (client->join_time() != -1) {
+      joined++;
+      join_times.push_back(
+          static_cast<float>(client->join_time() - client->start_time()));
+      if (float rate = client->GetHostTimeRate(); rate > 0.0f) {
+        host_time_rates.push_back(rate);
+      }
+    }
+    if (client->state() == LoadGeneratorClient::State::kFailed) {
+      failed++;
+    }
+    step_gaps.insert(step_gaps.end(), client->step_gaps().begin(),
+                     client->step_gaps().end());
+
+    writer.BeginObject();
+    writer.Key("index");
+    writer.Number(client->index());
+    writer.Key("state");
+    writer.String(StateName_(client->state()));
+    writer.Key("join_ms");
+    if (client->join_time() != -1) {
+      writer.Number(
+          static_cast<double>(client->join_time() - client->start_time()));
+    } else {
+      writer.Null();
+    }
+    writer.Key("ping_ms");
+    writer.Number(client->current_ping());
+    writer.Key("bytes_in");
+    writer.Number(static_cast<double>(client->total_bytes_in()));
+    writer.Key("bytes_out");
+    writer.Number(static_cast<double>(client->total_bytes_out()));
+    writer.Key("bytes_in_per_sec");
+    writer.Number(in_rate);
+    writer.Key("bytes_out_per_sec");
+    writer.Number(out_rate);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.Key("clients_spawned");
+  writer.Number(static_cast<double>(clients_.size()));
+  writer.Key("clients_joined");
+  writer.Number(joined);
+  writer.Key("clients_failed");
+  writer.Number(failed);
+  WriteDistribution_(&writer, "join_ms", &join_times);
+
+  // Gaps between steps arriving approximate the host's tick times (plus
+  // whatever jitter the network adds); host_time_rate dropping below 1
+  // means the host can't keep up with realtime.
+  WriteDistribution_(&writer, "step_gap_ms", &step_gaps);
+  WriteDistribution_(&writer, "host_time_rate", &host_time_rates);
+  WriteDistribution_(&writer, "bytes_in_per_client_per_sec",
+                     &bytes_in_per_sec);
+  WriteDistribution_(&writer, "bytes_out_per_client_per_sec",
+                     &bytes_out_per_sec);
+  writer.EndObject();
+  return writer.TakeString();
+}
+
+}  // namespace ballistica::classic
@@ -0,0 +1,143 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CLASSIC_SUPPORT_LOAD_GENERATOR_H_
+#define BALLISTICA_CLASSIC_SUPPORT_LOAD_GENERATOR_H_
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/support/app_timer.h"
+#include "ballistica/scene_v1/connection/connection.h"
+#include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/networking/sockaddr.h"
+
+namespace ballistica::classic {
+
+// Request ids are a single byte and hosts hand out at most 255 client ids,
+// so this is as many synthetic clients as we can tell apart.
+const int kLoadGeneratorMaxClients{250};
+
+/// A synthetic client driven by LoadGenerator. Speaks the same UDP protocol
+/// as ConnectionToHostUDP (request/accept, handshake, client-info,
+/// reliable messages and acks) but has no session, input or rendering
+/// behind it; it just tallies what the host sends.
+class LoadGeneratorClient : public scene_v1::Connection {
+ public:
+  enum class State {
+    kRequesting,
+    kAccepted,
+    kConnected,
+    kJoined,
+    kFailed,
+    kLeft,
+  };
+
+  LoadGeneratorClient(const SockAddr& addr, int index, uint8_t request_id,
+                      std::string instance_uuid);
+  ~LoadGeneratorClient() override;
+
+  void Update() override;
+  void HandleGamePacket(const std::vector<uint8_t>& data) override;
+  void HandleMessagePacket(const std::vector<uint8_t>& buffer) override;
+  void RequestDisconnect() override;
+
+  /// Called by LoadGenerator for connection-level packets from the host.
+  void HandleAccept(uint8_t client_id);
+  void HandleDeny();
+  void HandleHostDisconnect();
+
+  /// Raw wire bytes arriving for us (counted before decompression).
+  void AddBytesIn(size_t bytes);
+
+  auto index() const { return index_; }
+  auto request_id() const { return request_id_; }
+  auto client_id() const { return client_id_; }
+  auto state() const { return state_; }
+  auto start_time() const { return start_time_; }
+  auto join_time() const { return join_time_; }
+  auto end_time() const { return end_time_; }
+  auto total_bytes_in() const { return total_bytes_in_; }
+  auto total_bytes_out() const { return total_bytes_out_; }
+  auto base_time_received() const { return base_time_received_; }
+
+  /// Host time received per unit of wall time since steps began arriving;
+  /// below 1 means the host is falling behind realtime (or 0 if unknown).
+  auto GetHostTimeRate() const -> float;
+
+  /// Gaps between consecutive host steps arriving, in milliseconds.
+  auto step_gaps() const -> const std::vector<float>& { return step_gaps_; }
+
+ protected:
+  void SendGamePacketCompressed(const std::vector<uint8_t>& data) override;
+  void Error(const std::string& error_msg) override;
+
+ private:
+  void SendClientRequest_();
+  void SendDisconnectRequest_();
+  void HandleSessionCommands_(const std::vector<uint8_t>& buffer);
+  void Finish_(State state);
+
+  SockAddr addr_;
+  std::string instance_uuid_;
+  int index_{};
+  int client_id_{-1};
+  int protocol_version_{};
+  uint8_t request_id_{};
+  State state_{State::kRequesting};
+  millisecs_t start_time_{};
+  millisecs_t join_time_{-1};
+  millisecs_t end_time_{-1};
+  millisecs_t last_request_time_{};
+  millisecs_t last_host_packet_time_{};
+  millisecs_t last_ping_send_time_{};
+  millisecs_t first_step_time_{-1};
+  millisecs_t last_step_time_{-1};
+  int64_t total_bytes_in_{};
+  int64_t total_bytes_out_{};
+  int64_t base_time_received_{};
+  std::vector<float> step_gaps_;
+};
+
+/// Headless load generator: spawns a deterministic schedule of synthetic
+/// UDP clients against a target host and reports join times, per-client
+/// bandwidth and how steadily the host's steps arrive, for capacity
+/// planning. Complements StressTest, which exercises local inputs within
+/// a single session. Logic thread only.
+class LoadGenerator {
+ public:
+  /// Start connecting client_count clients to the given host at join_rate
+  /// clients per second, or disconnect everything if address is empty.
+  /// The same seed always produces the same client identities and schedule.
+  void Set(const std::string& address, int port, int client_count,
+           float join_rate, uint32_t seed);
+
+  /// Claim any packet from our target meant for one of our clients.
+  /// Returns true if the packet was handled.
+  auto HandleIncomingUDPPacket(const std::vector<uint8_t>& data,
+                               const SockAddr& addr) -> bool;
+
+  /// Json summary of the current (or most recent) run.
+  auto GetReport() const -> std::string;
+
+ private:
+  void Update_();
+  void Stop_();
+  auto ClientForRequestID_(uint8_t request_id) -> LoadGeneratorClient*;
+  auto ClientForClientID_(uint8_t client_id) -> LoadGeneratorClient*;
+
+  std::optional<SockAddr> target_;
+  std::vector<Object::Ref<LoadGeneratorClient>> clients_;
+  Object::Ref<base::AppTimer> timer_;
+  millisecs_t start_time_{};
+  millisecs_t stop_time_{-1};
+  int client_count_{};
+  float join_rate_{};
+  uint32_t seed_{};
+  uint8_t first_request_id_{};
+};
+
+}  // namespace ballistica::classic
+
+#endif  // BALLISTICA_CLASSIC_SUPPORT_LOAD_GENERATOR_H_
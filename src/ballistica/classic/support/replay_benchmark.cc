@@ -0,0 +1,147 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/classic/support/replay_benchmark.h"
+
+#include <cstdio>
+#include <string>
+
+#include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/support/frame_timing_capture.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/classic/classic.h"
+#include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/classic/support/scripted_benchmark.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/scene_v1/support/client_session_replay.h"
+#include "ballistica/shared/generic/json_stream.h"
+#include "ballistica/shared/python/python.h"
+
+namespace ballistica::classic {
+
+void ReplayBenchmark::Start(const std::string& file_name, microsecs_t step,
+                            const std::string& results_path, PyObject* call) {
+  assert(g_base->InLogicThread());
+  if (running_) {
+    throw Exception("A replay benchmark is already running.");
+  }
+  if (step <= 0) {
+    throw Exception("Benchmark step must be positive.", PyExcType::kValue);
+  }
+  auto* appmode = ClassicAppMode::GetActiveOrThrow();
+  appmode->LaunchReplaySession(file_name);
+  auto* session = dynamic_cast<scene_v1::ClientSessionReplay*>(
+      appmode->GetForegroundSession());
+  if (!session) {
+    throw Exception("Unable to launch replay '" + file_name + "'.");
+  }
+
+  // Play at normal speed regardless of what the user last watched at.
+  appmode->SetReplaySpeedExponent(0);
+  appmode->ResumeReplay();
+
+  session_ = session;
+  file_name_ = file_name;
+  results_path_ = results_path;
+  step_ = step;
+  steps_ = 0;
+  replay_time_ = 0;
+  start_app_time_ = g_core->AppTimeMillisecs();
+  call_.Clear();
+  if (call != Py_None) {
+    call_ = Object::New<base::PythonContextCall>(call);
+  }
+  running_ = true;
+
+  prev_fixed_step_ = g_base->logic->fixed_display_time_step();
+  g_base->logic->SetFixedDisplayTimeStep(step_);
+  g_base->graphics->StartFrameTimingCapture();
+
+  // The timer is shorter than any step so this fires once per step.
+  timer_ = base::DisplayTimer::New(0.001, true, [this] { Update_(); });
+}
+
+void ReplayBenchmark::Stop() {
+  assert(g_base->InLogicThread());
+  if (!running_) {
+    throw Exception("No replay benchmark is running.");
+  }
+  Finish_(false);
+}
+
+void ReplayBenchmark::Update_() {
+  steps_++;
+
+  // Replays rewind when they hit their end, so that's our cue. If the
+  // session died or errored out instead we stop with what we've got.
+  auto* session = session_.get();
+  if (!session || session->shutting_down()) {
+    Finish_(false);
+  } else if (session->end_of_file_count() > 0) {
+    Finish_(true);
+  } else {
+    replay_time_ = session->base_time();
+  }
+}
+
+void ReplayBenchmark::Finish_(bool completed) {
+  running_ = false;
+  timer_.Clear();
+  g_base->logic->SetFixedDisplayTimeStep(prev_fixed_step_);
+
+  std::string results = BuildResults_(completed);
+  if (!results_path_.empty()) {
+    if (FILE* f = g_core->platform->FOpen(results_path_.c_str(), "wb")) {
+      fprintf(f, "%s\n", results.c_str());
+      fclose(f);
+    } else {
+      g_core->Log(LogName::kBa, LogLevel::kError,
+                  "Unable to write replay benchmark results to '"
+                      + results_path_ + "'.");
+    }
+  }
+  if (call_.exists()) {
+    call_->Schedule(
+        PythonRef(Py_BuildValue("(s)", results.c_str()), PythonRef::kSteal));
+    call_.Clear();
+  } else {
+    g_core->Log(LogName::kBa, LogLevel::kInfo,
+                "Replay benchmark results: " + results);
+  }
+
+  // Head back to the main menu, just as if the user had left the replay.
+  if (auto* session = session_.get()) {
+    session->End();
+  }
+  session_.Clear();
+}
+
+auto ReplayBenchmark::BuildResults_(bool completed) -> std::string {
+  auto capture = g_base->graphics->StopFrameTimingCapture();
+
+  JsonWriter writer(1024);
+  writer.BeginObject();
+  ScriptedBenchmark::WriteEnvironment(&writer);
+  writer.Key("replay");
+  writer.String(file_name_);
+  writer.Key("completed");
+  writer.Bool(completed);
+  writer.Key("step_ms");
+  writer.Number(static_cast<double>(step_) / 1000.0);
+  writer.Key("steps");
+  writer.Number(steps_);
+  writer.Key("replay_time_s");
+  writer.Number(static_cast<double>(replay_time_) / 1000.0);
+  writer.Key("wall_time_s");
+  writer.Number(
+      static_cast<double>(g_core->AppTimeMillisecs() - start_app_time_)
+      / 1000.0);
+  if (capture) {
+    writer.Key("frames");
+    writer.Number(static_cast<double>(capture->frame_count()));
+    capture->WriteSummary(&writer);
+  }
+  writer.EndObject();
+  return writer.TakeString();
+}
+
+}  // namespace ballistica::classic
@@ -0,0 +1,56 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CLASSIC_SUPPORT_REPLAY_BENCHMARK_H_
+#define BALLISTICA_CLASSIC_SUPPORT_REPLAY_BENCHMARK_H_
+
+#include <string>
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/python/support/python_context_call.h"
+#include "ballistica/base/support/display_timer.h"
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/shared/foundation/object.h"
+
+namespace ballistica::classic {
+
+/// Plays a replay through once at a fixed display-time step so every run
+/// pushes exactly the same steps and frames through the engine, capturing
+/// the cost of session updates, scene draws and frame-def builds along the
+/// way. This makes recorded games usable as rendering and simulation
+/// regression benchmarks. Headless builds step as fast as they can (and
+/// of course build no frames). Logic thread only.
+class ReplayBenchmark {
+ public:
+  /// Launch a replay session for file_name and advance display-time by
+  /// step for each update until it reaches its end. The results json is
+  /// written to results_path (unless empty) and passed to call (if not
+  /// None) when done.
+  void Start(const std::string& file_name, microsecs_t step,
+             const std::string& results_path, PyObject* call);
+
+  /// Finish now regardless of how far the replay got.
+  void Stop();
+
+  auto running() const { return running_; }
+
+ private:
+  void Update_();
+  void Finish_(bool completed);
+  auto BuildResults_(bool completed) -> std::string;
+
+  Object::WeakRef<scene_v1::ClientSessionReplay> session_;
+  Object::Ref<base::DisplayTimer> timer_;
+  Object::Ref<base::PythonContextCall> call_;
+  std::string file_name_;
+  std::string results_path_;
+  microsecs_t step_{};
+  microsecs_t prev_fixed_step_{};
+  millisecs_t start_app_time_{};
+  millisecs_t replay_time_{};
+  int steps_{};
+  bool running_{};
+};
+
+}  // namespace ballistica::classic
+
+#endif  // BALLISTICA_CLASSIC_SUPPORT_REPLAY_BENCHMARK_H_
@@ -0,0 +1,150 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/classic/support/scripted_benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/support/camera.h"
+#include "ballistica/base/graphics/support/frame_timing_capture.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/classic/classic.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/generic/json_stream.h"
+
+namespace ballistica::classic {
+
+void ScriptedBenchmark::Start(
+    std::vector<CameraKey> path,
+    std::vector<std::pair<std::string, std::string>> info) {
+  assert(g_base->InLogicThread());
+  if (g_core->HeadlessMode()) {
+    throw Exception("Scripted benchmarks need graphics.");
+  }
+  if (running_) {
+    throw Exception("A scripted benchmark is already running.");
+  }
+  if (path.empty()) {
+    throw Exception("Benchmark camera path must not be empty.",
+                    PyExcType::kValue);
+  }
+  std::stable_sort(path.begin(), path.end(),
+                   [](const CameraKey& a, const CameraKey& b) {
+                     return a.time < b.time;
+                   });
+  camera_path_ = std::move(path);
+  info_ = std::move(info);
+  start_time_ = g_base->logic->display_time();
+  duration_ = 0.0;
+  running_ = true;
+
+  g_base->graphics->camera()->SetManual(true);
+  UpdateCamera_();
+
+  // Keep the camera moving every display step; the timer is shorter than
+  // any frame we'd expect so this fires once per step.
+  camera_timer_ =
+      base::DisplayTimer::New(0.001, true, [this] { UpdateCamera_(); });
+  g_base->graphics->StartFrameTimingCapture();
+}
+
+void ScriptedBenchmark::UpdateCamera_() {
+  assert(!camera_path_.empty());
+  seconds_t t = g_base->logic->display_time() - start_time_;
+
+  // Find the keys we're between and ease from one to the other.
+  auto next = std::find_if(camera_path_.begin(), camera_path_.end(),
+                           [t](const CameraKey& key) { return key.time > t; });
+  Vector3f position, target;
+  if (next == camera_path_.begin()) {
+    position = next->position;
+    target = next->target;
+  } else if (next == camera_path_.end()) {
+    position = camera_path_.back().position;
+    target = camera_path_.back().target;
+  } else {
+    auto& prev = *(next - 1);
+    auto span = static_cast<float>(next->time - prev.time);
+    float blend = span > 0.0f ? static_cast<float>(t - prev.time) / span : 1.0f;
+    blend = blend * blend * (3.0f - 2.0f * blend);
+    position = prev.position + (next->position - prev.position) * blend;
+    target = prev.target + (next->target - prev.target) * blend;
+  }
+  auto* camera = g_base->graphics->camera();
+  camera->SetPosition(position.x, position.y, position.z);
+  camera->SetTarget(target.x, target.y, target.z);
+}
+
+auto ScriptedBenchmark::Stop(const std::string& results_path) -> std::string {
+  assert(g_base->InLogicThread());
+  if (!running_) {
+    throw Exception("No scripted benchmark is running.");
+  }
+  duration_ = g_base->logic->display_time() - start_time_;
+  running_ = false;
+  camera_timer_.Clear();
+  g_base->graphics->camera()->SetManual(false);
+
+  std::string results = BuildResults_();
+  if (!results_path.empty()) {
+    FILE* f = g_core->platform->FOpen(results_path.c_str(), "wb");
+    if (!f) {
+      throw Exception("Unable to open '" + results_path + "' for writing.");
+    }
+    fprintf(f, "%s\n", results.c_str());
+    fclose(f);
+  }
+  return results;
+}
+
+void ScriptedBenchmark::WriteEnvironment(JsonWriter* writer) {
+  writer->Key("engine_version");
+  writer->String(kEngineVersion);
+  writer->Key("engine_build_number");
+  writer->Number(kEngineBuildNumber);
+  writer->Key("debug_build");
+  writer->Bool(g_buildconfig.debug_build());
+  writer->Key("headless");
+  writer->Bool(g_core->HeadlessMode());
+  writer->Key("platform");
+  writer->String(g_core->platform->GetPlatformName());
+  writer->Key("os_version");
+  writer->String(g_core->platform->GetOSVersionString());
+  writer->Key("device");
+  writer->String(g_core->platform->GetDeviceDescription());
+  writer->Key("resolution");
+  writer->BeginArray();
+  writer->Number(g_base->graphics->screen_pixel_width());
+  writer->Number(g_base->graphics->screen_pixel_height());
+  writer->EndArray();
+}
+
+auto ScriptedBenchmark::BuildResults_() -> std::string {
+  auto capture = g_base->graphics->StopFrameTimingCapture();
+
+  JsonWriter writer(1024);
+  writer.BeginObject();
+  WriteEnvironment(&writer);
+  writer.Key("info");
+  writer.BeginObject();
+  for (auto&& entry : info_) {
+    writer.Key(entry.first);
+    writer.String(entry.second);
+  }
+  writer.EndObject();
+  writer.Key("duration_s");
+  writer.Number(duration_);
+  if (capture) {
+    writer.Key("frames");
+    writer.Number(static_cast<double>(capture->frame_count()));
+    capture->WriteSummary(&writer);
+  }
+  writer.EndObject();
+  return writer.TakeString();
+}
+
+}  // namespace ballistica::classic
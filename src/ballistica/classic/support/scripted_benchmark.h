@@ -0,0 +1,64 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CLASSIC_SUPPORT_SCRIPTED_BENCHMARK_H_
+#define BALLISTICA_CLASSIC_SUPPORT_SCRIPTED_BENCHMARK_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/support/display_timer.h"
+#include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/math/vector3f.h"
+
+namespace ballistica {
+class JsonWriter;
+}
+
+namespace ballistica::classic {
+
+/// Native side of the scripted benchmark (see baclassic._benchmark). The
+/// scenario itself (map, characters, effects) is built in Python on a
+/// fixed schedule; while it runs we fly the camera along a fixed path
+/// and capture per-frame timings, then summarize them as json so devices
+/// and builds can be compared. Logic thread only.
+class ScriptedBenchmark {
+ public:
+  struct CameraKey {
+    seconds_t time{};
+    Vector3f position{0.0f, 0.0f, 0.0f};
+    Vector3f target{0.0f, 0.0f, 0.0f};
+  };
+
+  /// Begin capturing and flying the camera along path (sorted by time;
+  /// the camera holds at the last key once it passes it). Info entries are
+  /// included verbatim in the results.
+  void Start(std::vector<CameraKey> path,
+             std::vector<std::pair<std::string, std::string>> info);
+
+  /// Finish up and return results as json. Results are also written to
+  /// results_path unless it is empty.
+  auto Stop(const std::string& results_path) -> std::string;
+
+  auto running() const { return running_; }
+
+  /// Write engine, platform and display details as members of the current
+  /// json object so results from different runs can be told apart.
+  static void WriteEnvironment(JsonWriter* writer);
+
+ private:
+  void UpdateCamera_();
+  auto BuildResults_() -> std::string;
+
+  std::vector<CameraKey> camera_path_;
+  std::vector<std::pair<std::string, std::string>> info_;
+  Object::Ref<base::DisplayTimer> camera_timer_;
+  seconds_t start_time_{};
+  seconds_t duration_{};
+  bool running_{};
+};
+
+}  // namespace ballistica::classic
+
+#endif  // BALLISTICA_CLASSIC_SUPPORT_SCRIPTED_BENCHMARK_H_
@@ -0,0 +1,141 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/classic/support/telemetry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/assets/assets.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_writer.h"
+#include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/scene_v1/connection/connection_set.h"
+#include "ballistica/scene_v1/connection/connection_to_client.h"
+#include "ballistica/scene_v1/connection/connection_to_host.h"
+#include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/shared/foundation/event_loop.h"
+
+namespace ballistica::classic {
+
+// Values go in native order, which is little-endian on everything we run
+// on (same as the rest of our binary formats).
+template <typename T>
+static void Put_(std::vector<uint8_t>* buffer, T val) {
+  size_t offset = buffer->size();
+  buffer->resize(offset + sizeof(T));
+  memcpy(buffer->data() + offset, &val, sizeof(T));
+}
+
+static void PutConnection_(std::vector<uint8_t>* buffer, int32_t client_id,
+                           const scene_v1::Connection& c) {
+  Put_<int32_t>(buffer, client_id);
+  Put_<float>(buffer, c.current_ping());
+  Put_<uint32_t>(buffer, static_cast<uint32_t>(c.GetBytesInPerSecond()));
+  Put_<uint32_t>(buffer, static_cast<uint32_t>(c.GetBytesOutPerSecond()));
+  Put_<uint32_t>(buffer, static_cast<uint32_t>(c.GetBytesResentPerSecond()));
+}
+
+void Telemetry::Set(const std::string& address, int port,
+                    seconds_t interval) {
+  assert(g_base->InLogicThread());
+  if (address.empty()) {
+    target_.reset();
+    timer_.Clear();
+    return;
+  }
+  if (port <= 0 || port > 65535) {
+    throw Exception("Invalid port: " + std::to_string(port) + ".",
+                    PyExcType::kValue);
+  }
+  if (interval < 0.1) {
+    throw Exception("Telemetry interval must be at least 0.1 seconds.",
+                    PyExcType::kValue);
+  }
+  target_ = SockAddr(address, port);
+  timer_ = base::AppTimer::New(interval, true, [this] { Send_(); });
+}
+
+void Telemetry::Send_() {
+  assert(g_base->InLogicThread());
+  if (!target_.has_value() || !g_base->network_writer) {
+    return;
+  }
+  g_base->network_writer->PushSendToCall(BuildSnapshot_(), *target_);
+}
+
+auto Telemetry::BuildSnapshot_() -> std::vector<uint8_t> {
+  std::vector<uint8_t> buffer;
+  buffer.reserve(256);
+  Put_<uint32_t>(&buffer, kTelemetryMagic);
+  Put_<uint16_t>(&buffer, kTelemetryVersion);
+  Put_<uint16_t>(&buffer, 0);
+  Put_<uint32_t>(&buffer, sequence_++);
+  Put_<double>(&buffer, g_core->AppTimeSeconds());
+
+  auto* appmode = ClassicAppMode::GetActive();
+
+  // Update timing since our last snapshot.
+  ClassicAppMode::UpdateTimeStats update_stats;
+  if (appmode) {
+    update_stats = appmode->TakeUpdateTimeStats();
+  }
+  Put_<uint32_t>(&buffer, static_cast<uint32_t>(update_stats.count));
+  Put_<float>(&buffer,
+              update_stats.count > 0
+                  ? static_cast<float>(update_stats.total)
+                        / static_cast<float>(update_stats.count) / 1000.0f
+                  : 0.0f);
+  Put_<float>(&buffer, static_cast<float>(update_stats.max) / 1000.0f);
+
+  uint32_t node_count{};
+  if (appmode) {
+    if (auto* scene = appmode->GetForegroundScene()) {
+      node_count = static_cast<uint32_t>(scene->nodes().size());
+    }
+  }
+  Put_<uint32_t>(&buffer, node_count);
+
+  auto* assets = g_base->assets;
+  Put_<uint32_t>(&buffer, assets->total_mesh_count());
+  Put_<uint32_t>(&buffer, assets->total_texture_count());
+  Put_<uint32_t>(&buffer, assets->total_sound_count());
+  Put_<uint32_t>(&buffer, assets->total_collision_mesh_count());
+  Put_<uint32_t>(&buffer,
+                 static_cast<uint32_t>(assets->GetPendingLoadCount()));
+
+  auto event_loops = EventLoop::GetAllEventLoops();
+  auto loop_count = std::min(event_loops.size(), size_t{255});
+  Put_<uint8_t>(&buffer, static_cast<uint8_t>(loop_count));
+  for (size_t i = 0; i < loop_count; ++i) {
+    Put_<uint8_t>(&buffer, static_cast<uint8_t>(event_loops[i]->identifier()));
+    Put_<uint32_t>(&buffer,
+                   static_cast<uint32_t>(event_loops[i]->GetQueueDepth()));
+  }
+
+  // Connections; our host connection (if any) first and then clients.
+  size_t count_offset = buffer.size();
+  Put_<uint8_t>(&buffer, 0);
+  int connection_count{};
+  if (appmode) {
+    auto* connections = appmode->connections();
+    if (auto* host = connections->connection_to_host()) {
+      PutConnection_(&buffer, -1, *host);
+      connection_count++;
+    }
+    for (auto&& i : connections->connections_to_clients()) {
+      if (connection_count >= kTelemetryMaxConnections) {
+        break;
+      }
+      if (auto* client = i.second.get()) {
+        PutConnection_(&buffer, client->id(), *client);
+        connection_count++;
+      }
+    }
+  }
+  buffer[count_offset] = static_cast<uint8_t>(connection_count);
+  return buffer;
+}
+
+}  // namespace ballistica::classic
@@ -0,0 +1,56 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CLASSIC_SUPPORT_TELEMETRY_H_
+#define BALLISTICA_CLASSIC_SUPPORT_TELEMETRY_H_
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/support/app_timer.h"
+#include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/networking/sockaddr.h"
+
+namespace ballistica::classic {
+
+const uint32_t kTelemetryMagic{0x4D544142};  // 'BATM'
+const uint16_t kTelemetryVersion{1};
+
+// Keeps a snapshot within a single unfragmented datagram.
+const int kTelemetryMaxConnections{48};
+
+/// Periodically sends a compact binary snapshot of server state (update
+/// times, node/asset counts, event loop queue depths and per-connection
+/// traffic) as a UDP datagram to a local collector, so fleets can be
+/// monitored without running Python timers. Logic thread only.
+///
+/// Layout (all values little-endian):
+///   u32 magic ('BATM'), u16 version, u16 reserved, u32 sequence,
+///   f64 app time (seconds),
+///   u32 update count, f32 update avg ms, f32 update max ms,
+///   u32 foreground node count,
+///   u32 mesh, texture, sound and collision-mesh counts,
+///   u32 pending asset loads,
+///   u8 event loop count, then per loop: u8 EventLoopID, u32 queue depth,
+///   u8 connection count, then per connection: i32 client id (-1 for our
+///     host connection), f32 ping ms, u32 bytes in/sec, u32 bytes out/sec,
+///     u32 bytes resent/sec.
+class Telemetry {
+ public:
+  /// Start sending snapshots to the given address every interval seconds,
+  /// or stop if address is empty.
+  void Set(const std::string& address, int port, seconds_t interval);
+
+ private:
+  void Send_();
+  auto BuildSnapshot_() -> std::vector<uint8_t>;
+
+  std::optional<SockAddr> target_;
+  Object::Ref<base::AppTimer> timer_;
+  uint32_t sequence_{};
+};
+
+}  // namespace ballistica::classic
+
+#endif  // BALLISTICA_CLASSIC_SUPPORT_TELEMETRY_H_
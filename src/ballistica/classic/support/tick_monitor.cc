@@ -0,0 +1,107 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/classic/support/tick_monitor.h"
+
+#include <cstdio>
+#include <string>
+
+#include "ballistica/classic/classic.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::classic {
+
+TickMonitor::TickMonitor() {
+  // Default ladder: correct less often, then batch up more of our output,
+  // then stop sending eye candy, then stop taking on more clients.
+  config_.tiers = {
+      {1000, 0, true, true},
+      {1000, 100, true, true},
+      {1000, 100, false, true},
+      {2000, 150, false, false},
+  };
+}
+
+void TickMonitor::SetEnabled(bool enabled) {
+  assert(g_base->InLogicThread());
+  if (enabled == enabled_) {
+    return;
+  }
+  enabled_ = enabled;
+  step_time_ = 0;
+  step_count_ = 0;
+  overloaded_windows_ = 0;
+  healthy_windows_ = 0;
+  window_start_time_ = core::CorePlatform::TimeMonotonicMillisecs();
+  if (!enabled && tier_ != 0) {
+    SetTier_(0, 0.0f);
+  }
+}
+
+void TickMonitor::SetConfig(const Config& config) {
+  assert(g_base->InLogicThread());
+  config_ = config;
+  overloaded_windows_ = 0;
+  healthy_windows_ = 0;
+  if (tier_ > static_cast<int>(config_.tiers.size())) {
+    SetTier_(0, last_load_);
+  }
+}
+
+void TickMonitor::Update() {
+  if (!enabled_) {
+    return;
+  }
+  millisecs_t now = core::CorePlatform::TimeMonotonicMillisecs();
+  millisecs_t elapsed = now - window_start_time_;
+  if (elapsed < kTickMonitorWindow) {
+    return;
+  }
+  float load = static_cast<float>(step_time_)
+               / (static_cast<float>(elapsed) * 1000.0f);
+  last_load_ = load;
+  last_step_count_ = step_count_;
+  step_time_ = 0;
+  step_count_ = 0;
+  window_start_time_ = now;
+
+  // Windows in between our thresholds don't move us either way but do
+  // break up any streak in progress.
+  if (load > config_.high_load) {
+    overloaded_windows_++;
+    healthy_windows_ = 0;
+  } else if (load < config_.low_load) {
+    healthy_windows_++;
+    overloaded_windows_ = 0;
+  } else {
+    overloaded_windows_ = 0;
+    healthy_windows_ = 0;
+  }
+  if (overloaded_windows_ >= config_.escalate_windows
+      && tier_ < static_cast<int>(config_.tiers.size())) {
+    overloaded_windows_ = 0;
+    SetTier_(tier_ + 1, load);
+  } else if (healthy_windows_ >= config_.recover_windows && tier_ > 0) {
+    healthy_windows_ = 0;
+    SetTier_(tier_ - 1, load);
+  }
+}
+
+void TickMonitor::SetTier_(int tier, float load) {
+  assert(tier >= 0 && tier <= static_cast<int>(config_.tiers.size()));
+  int old_tier = tier_;
+  tier_ = tier;
+  auto& t = current();
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Tick load %.0f%%; %s from degradation tier %d to %d"
+           " (dynamics_sync_time>=%d, buffer_time>=%d, bg_dynamics=%s,"
+           " joins=%s).",
+           load * 100.0f, tier > old_tier ? "escalating" : "recovering",
+           old_tier, tier, t.min_dynamics_sync_time, t.min_buffer_time,
+           t.forward_bg_dynamics ? "on" : "off",
+           t.accept_joins ? "on" : "off");
+  g_core->Log(LogName::kBa,
+              tier > old_tier ? LogLevel::kWarning : LogLevel::kInfo, buffer);
+}
+
+}  // namespace ballistica::classic
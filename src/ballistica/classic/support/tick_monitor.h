@@ -0,0 +1,100 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CLASSIC_SUPPORT_TICK_MONITOR_H_
+#define BALLISTICA_CLASSIC_SUPPORT_TICK_MONITOR_H_
+
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::classic {
+
+/// How much wall time each tick-load measurement covers.
+const millisecs_t kTickMonitorWindow{1000};
+
+/// Watches how long host scene steps take (including shipping session
+/// commands out to clients, which happens within them) and, when they eat
+/// up too much of realtime for too long, steps through a ladder of
+/// degradation tiers so an overloaded server sheds work predictably
+/// instead of lagging for everyone. Recovers a tier at a time once load
+/// falls back down. Off by default. Logic thread only.
+class TickMonitor {
+ public:
+  /// What a tier changes. Tier 0 is always normal operation; a configured
+  /// ladder supplies tiers 1 and up.
+  struct Tier {
+    /// Minimum time between physics-correction packets (milliseconds;
+    /// 0 leaves it as configured).
+    int min_dynamics_sync_time{};
+    /// Minimum time session commands are buffered before being sent
+    /// (milliseconds; 0 leaves it as configured).
+    int min_buffer_time{};
+    /// Whether bg-dynamics emissions (sparks, debris, etc.) still go out
+    /// to clients and replays.
+    bool forward_bg_dynamics{true};
+    /// Whether new clients may join.
+    bool accept_joins{true};
+  };
+
+  struct Config {
+    /// Fraction of wall time spent stepping above which a window counts
+    /// as overloaded, and below which it counts as healthy.
+    float high_load{0.8f};
+    float low_load{0.5f};
+    /// Consecutive overloaded/healthy windows needed to move down/up the
+    /// ladder one tier.
+    int escalate_windows{3};
+    int recover_windows{10};
+    std::vector<Tier> tiers;
+  };
+
+  TickMonitor();
+
+  void SetEnabled(bool enabled);
+  auto enabled() const { return enabled_; }
+
+  /// Replace the config. Drops back to tier 0 if the new ladder is
+  /// shorter than our current tier.
+  void SetConfig(const Config& config);
+  auto config() const -> const Config& { return config_; }
+
+  /// Called with the duration of each host scene step.
+  void AddStep(microsecs_t duration) {
+    if (enabled_) {
+      step_time_ += duration;
+      step_count_++;
+    }
+  }
+
+  /// Called once per logic update to close out measurement windows.
+  void Update();
+
+  /// Current tier (0 being normal operation).
+  auto tier() const { return tier_; }
+  auto current() const -> const Tier& {
+    return tier_ == 0 ? normal_tier_ : config_.tiers[tier_ - 1];
+  }
+
+  /// Load (fraction of wall time spent stepping) in the last full window.
+  auto last_load() const { return last_load_; }
+  auto last_step_count() const { return last_step_count_; }
+
+ private:
+  void SetTier_(int tier, float load);
+
+  Config config_;
+  Tier normal_tier_;
+  bool enabled_{};
+  int tier_{};
+  int overloaded_windows_{};
+  int healthy_windows_{};
+  millisecs_t window_start_time_{};
+  microsecs_t step_time_{};
+  int step_count_{};
+  float last_load_{};
+  int last_step_count_{};
+};
+
+}  // namespace ballistica::classic
+
+#endif  // BALLISTICA_CLASSIC_SUPPORT_TICK_MONITOR_H_
@@ -11,6 +11,7 @@
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/core/python/core_python.h"
 #include "ballistica/shared/foundation/inline.h"
+#include "ballistica/shared/foundation/job_system.h"
 #include "ballistica/shared/foundation/logging.h"
 #include "ballistica/shared/foundation/macros.h"
 #include "ballistica/shared/foundation/types.h"
@@ -80,6 +81,7 @@ void CoreFeatureSet::DoImport_(const CoreConfig& config) {
 
   // We can't report core import begin since core didn't exist at that point.
   g_core->Log(LogName::kBaLifecycle, LogLevel::kInfo, "core import end");
+  g_core->MarkStartupPhase("core_import");
 }
 
 CoreFeatureSet::CoreFeatureSet(CoreConfig config)
@@ -88,7 +90,8 @@ CoreFeatureSet::CoreFeatureSet(CoreConfig config)
       platform{CorePlatform::Create()},
       core_config_{std::move(config)},
       last_app_time_measure_microsecs_{CorePlatform::TimeMonotonicMicrosecs()},
-      vr_mode_{config.vr_mode} {
+      vr_mode_{config.vr_mode},
+      startup_phase_start_time_{last_app_time_measure_microsecs_} {
   // We're a singleton. If there's already one of us, something's wrong.
   assert(g_core == nullptr);
 }
@@ -104,6 +107,8 @@ void CoreFeatureSet::PostInit_() {
 
   build_src_dir_ = CalcBuildSrcDir_();
 
+  job_system = new JobSystem();
+
   // On monolithic builds we need to bring up Python itself.
   if (g_buildconfig.monolithic_build()) {
     python->InitPython();
@@ -301,6 +306,38 @@ auto CoreFeatureSet::SoftImportBase() -> BaseSoftInterface* {
   return g_base_soft;
 }
 
+void CoreFeatureSet::MarkStartupPhase(const std::string& name) {
+  auto time = static_cast<seconds_t>(CorePlatform::TimeMonotonicMicrosecs()
+                                     - startup_phase_start_time_)
+              / 1000000.0;
+  std::scoped_lock lock(startup_phases_mutex_);
+  startup_phases_.emplace_back(name, time);
+}
+
+auto CoreFeatureSet::GetStartupPhases()
+    -> std::vector<std::pair<std::string, seconds_t>> {
+  std::scoped_lock lock(startup_phases_mutex_);
+  return startup_phases_;
+}
+
+void CoreFeatureSet::LogStartupPhases() {
+  auto phases = GetStartupPhases();
+  if (phases.empty()) {
+    return;
+  }
+  std::string msg = "Startup phases (seconds; total "
+                    + std::to_string(phases.back().second) + "):";
+  seconds_t prev_time{};
+  for (auto&& phase : phases) {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "\n  %-32s %8.3f (+%.3f)",
+             phase.first.c_str(), phase.second, phase.second - prev_time);
+    msg += buffer;
+    prev_time = phase.second;
+  }
+  Log(LogName::kBaLifecycle, LogLevel::kInfo, msg);
+}
+
 // void CoreFeatureSet::LifecycleLog(const char* msg, double offset_seconds) {
 //   // Early out to avoid work if we won't show anyway.
 //   if (!LogLevelEnabled(LogName::kBaLifecycle, LogLevel::kDebug)) {
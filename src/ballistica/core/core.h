@@ -7,6 +7,7 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "ballistica/core/support/core_config.h"
@@ -96,6 +97,19 @@ class CoreFeatureSet {
     return std::this_thread::get_id() == main_thread_id();
   }
 
+  /// Note that a startup phase has just completed. Phases are timed from
+  /// when core was created and get logged together once the app is
+  /// running, so cold-start costs can be tracked down. Safe to call from
+  /// any thread.
+  void MarkStartupPhase(const std::string& name);
+
+  /// Return startup phases marked so far along with the time (in seconds
+  /// since core was created) when each completed.
+  auto GetStartupPhases() -> std::vector<std::pair<std::string, seconds_t>>;
+
+  /// Log all startup phases marked so far with their durations.
+  void LogStartupPhases();
+
   /// Log a boot-related message (only if core_config.lifecycle_log is true).
   // void LifecycleLog(const char* msg, double offset_seconds = 0.0);
 
@@ -160,6 +174,9 @@ class CoreFeatureSet {
   CorePython* const python;
   CorePlatform* const platform;
 
+  /// Worker pool for data-parallel work; sized to the core count.
+  JobSystem* job_system{};
+
   // The following are misc values that should be migrated to applicable
   // subsystem classes or private vars.
   bool workspaces_in_use{};
@@ -260,6 +277,9 @@ class CoreFeatureSet {
   double ba_env_launch_timestamp_{-1.0};
   std::mutex thread_info_map_mutex_;
   std::unordered_map<std::thread::id, std::string> thread_info_map_;
+  microsecs_t startup_phase_start_time_;
+  std::mutex startup_phases_mutex_;
+  std::vector<std::pair<std::string, seconds_t>> startup_phases_;
 };
 
 }  // namespace ballistica::core
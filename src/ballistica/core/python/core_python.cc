@@ -9,6 +9,7 @@
 
 #include "ballistica/core/mgen/python_modules_monolithic.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/foundation/macros.h"
 #include "ballistica/shared/python/python.h"
 #include "ballistica/shared/python/python_command.h"
@@ -204,13 +205,16 @@ void CorePython::EnablePythonLoggingCalls() {
   assert(objs().Exists(ObjID::kLoggerBaNetworking));
   assert(objs().Exists(ObjID::kLoggerBaNetworkingLogCall));
 
+  // Spin up the thread that forwards our log calls to Python.
+  log_event_loop_ = new EventLoop(EventLoopID::kLog);
+
   // Push any early log calls we've been holding on to along to Python.
   {
     std::scoped_lock lock(early_log_lock_);
     python_logging_calls_enabled_ = true;
     for (auto&& entry : early_logs_) {
-      LoggingCall(std::get<0>(entry), std::get<1>(entry),
-                  "[HELD] " + std::get<2>(entry));
+      LoggingCallImmediate_(std::get<0>(entry), std::get<1>(entry),
+                            "[HELD] " + std::get<2>(entry));
     }
     early_logs_.clear();
   }
@@ -394,6 +398,7 @@ void CorePython::MonolithicModeBaEnvConfigure() {
     FatalError("Environment setup failed:\n" + result.ValueAsString());
   }
   g_core->Log(LogName::kBaLifecycle, LogLevel::kInfo, "baenv.configure() end");
+  g_core->MarkStartupPhase("baenv_configure");
 }
 
 void CorePython::LoggingCall(LogName logname, LogLevel loglevel,
@@ -424,6 +429,51 @@ void CorePython::LoggingCall(LogName logname, LogLevel loglevel,
     return;
   }
 
+  if (loglevel == LogLevel::kCritical) {
+    LoggingCallImmediate_(logname, loglevel, msg);
+    return;
+  }
+
+  if (!pending_logs_.TryPush(PendingLog_{logname, loglevel, msg})) {
+    dropped_log_count_++;
+  }
+
+  // Kick off a drain unless one is already on its way. The drain clears
+  // this flag before it starts popping, so anything we pushed above is
+  // either picked up by it or by the one we schedule here.
+  if (!pending_logs_drain_scheduled_.exchange(true)) {
+    log_event_loop_->PushCall([this] { DrainPendingLogs_(); });
+  }
+}
+
+void CorePython::DrainPendingLogs_() {
+  assert(log_event_loop_->ThreadIsCurrent());
+  pending_logs_drain_scheduled_ = false;
+
+  // Grab the GIL once for the whole batch. We cap the batch size so a
+  // steady stream of logs can't keep us holding the GIL indefinitely;
+  // if we hit the cap we come back around for the rest.
+  Python::ScopedInterpreterLock lock;
+  PendingLog_ entry;
+  size_t count{};
+  while (pending_logs_.TryPop(&entry)) {
+    LoggingCallImmediate_(entry.name, entry.level, entry.msg);
+    if (++count == kPendingLogRingSize) {
+      if (!pending_logs_drain_scheduled_.exchange(true)) {
+        log_event_loop_->PushCall([this] { DrainPendingLogs_(); });
+      }
+      break;
+    }
+  }
+  if (int dropped = dropped_log_count_.exchange(0)) {
+    LoggingCallImmediate_(LogName::kBa, LogLevel::kWarning,
+                          "Dropped " + std::to_string(dropped)
+                              + " log message(s); log queue was full.");
+  }
+}
+
+void CorePython::LoggingCallImmediate_(LogName logname, LogLevel loglevel,
+                                       const std::string& msg) {
   // Make sure we're good to go from any thread.
   Python::ScopedInterpreterLock lock;
 
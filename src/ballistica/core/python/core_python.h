@@ -3,16 +3,22 @@
 #ifndef BALLISTICA_CORE_PYTHON_CORE_PYTHON_H_
 #define BALLISTICA_CORE_PYTHON_CORE_PYTHON_H_
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "ballistica/core/core.h"
+#include "ballistica/shared/generic/mpsc_ring.h"
 #include "ballistica/shared/python/python_object_set.h"
 
 namespace ballistica::core {
 
+/// Log calls that haven't been handed to Python yet beyond this many get
+/// dropped (and counted) instead of stalling whoever is logging.
+const size_t kPendingLogRingSize{4096};
+
 /// General Python support class for our feature-set.
 class CorePython {
  public:
@@ -70,6 +76,11 @@ class CorePython {
   /// Can be called from any thread at any time. If called before Python
   /// logging is available, logs locally using Logging::EmitPlatformLog()
   /// (with an added warning).
+  ///
+  /// Calls are queued and forwarded to Python in batches by a dedicated
+  /// log thread, so this never takes the GIL or runs Python code on the
+  /// calling thread. Critical messages are the exception; they go through
+  /// immediately since we may be on our way down.
   void LoggingCall(LogName logname, LogLevel loglevel, const std::string& msg);
   void ImportPythonObjs();
   void VerifyPythonEnvironment();
@@ -86,7 +97,21 @@ class CorePython {
   const auto& objs() { return objs_; }
 
  private:
+  struct PendingLog_ {
+    LogName name{};
+    LogLevel level{};
+    std::string msg;
+  };
+
+  void LoggingCallImmediate_(LogName logname, LogLevel loglevel,
+                             const std::string& msg);
+  void DrainPendingLogs_();
+
   PythonObjectSet<ObjID> objs_;
+  EventLoop* log_event_loop_{};
+  MPSCRing<PendingLog_, kPendingLogRingSize> pending_logs_;
+  std::atomic<bool> pending_logs_drain_scheduled_{};
+  std::atomic<int> dropped_log_count_{};
 
   // Log calls we make before we're set up to ship logs through Python
   // go here. They all get shipped at once as soon as it is possible.
@@ -35,6 +35,10 @@ class BaseSoftInterface {
   virtual void DoV1CloudLog(const std::string& msg) = 0;
   virtual void PushDevConsolePrintCall(const std::string& msg, float scale,
                                        Vector4f color) = 0;
+  virtual void PushDevConsoleLogCall(const std::string& prefix,
+                                     Vector4f prefix_color,
+                                     const std::string& msg,
+                                     Vector4f color) = 0;
   virtual auto GetPyExceptionType(PyExcType exctype) -> PyObject* = 0;
   virtual auto PrintPythonStackTrace() -> bool = 0;
   virtual auto GetPyLString(PyObject* obj) -> std::string = 0;
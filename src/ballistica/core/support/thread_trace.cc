@@ -0,0 +1,162 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/core/support/thread_trace.h"
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/generic/utils.h"
+
+namespace ballistica::core {
+
+struct ThreadTrace::ThreadBuffer_ {
+  struct Event {
+    const char* name{};
+    const char* detail{};
+    microsecs_t start{};
+    microsecs_t duration{};
+  };
+
+  // Only ever contended while a trace is being written or restarted.
+  std::mutex mutex;
+  std::string thread_name;
+  std::vector<Event> events;
+  int64_t dropped_events{};
+  int id{};
+};
+
+std::atomic<bool> ThreadTrace::active_{};
+std::atomic<microsecs_t> ThreadTrace::start_time_{};
+
+// Thread buffers live for the life of the process (threads come and go
+// but there are never many of them); these are leaked on purpose so
+// threads still running during static teardown can't trip over them.
+std::mutex* ThreadTrace::buffers_mutex_{new std::mutex()};
+std::vector<std::unique_ptr<ThreadTrace::ThreadBuffer_>>*
+    ThreadTrace::buffers_{
+        new std::vector<std::unique_ptr<ThreadTrace::ThreadBuffer_>>()};
+thread_local ThreadTrace::ThreadBuffer_* ThreadTrace::thread_buffer_{};
+
+auto ThreadTrace::Now_() -> microsecs_t {
+  return CorePlatform::TimeMonotonicMicrosecs();
+}
+
+auto ThreadTrace::GetThreadBuffer_() -> ThreadBuffer_* {
+  if (thread_buffer_ == nullptr) {
+    auto buffer = std::make_unique<ThreadBuffer_>();
+    buffer->thread_name = CoreFeatureSet::CurrentThreadName();
+    std::scoped_lock lock(*buffers_mutex_);
+    buffer->id = static_cast<int>(buffers_->size()) + 1;
+    thread_buffer_ = buffer.get();
+    buffers_->push_back(std::move(buffer));
+  }
+  return thread_buffer_;
+}
+
+void ThreadTrace::Record_(const char* name, const char* detail,
+                          microsecs_t start) {
+  auto end = Now_();
+  auto* buffer = GetThreadBuffer_();
+  std::scoped_lock lock(buffer->mutex);
+
+  // Spans that began before a restart belong to no capture.
+  if (start < start_time_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (buffer->events.size() >= kThreadTraceMaxEventsPerThread) {
+    buffer->dropped_events++;
+    return;
+  }
+  buffer->events.push_back({name, detail, start, end - start});
+}
+
+void ThreadTrace::SetEnabled(bool enabled) {
+  std::scoped_lock lock(*buffers_mutex_);
+  if (enabled) {
+    start_time_.store(Now_(), std::memory_order_relaxed);
+    for (auto&& buffer : *buffers_) {
+      std::scoped_lock buffer_lock(buffer->mutex);
+      buffer->events.clear();
+      buffer->dropped_events = 0;
+    }
+  }
+  active_.store(enabled, std::memory_order_relaxed);
+}
+
+auto ThreadTrace::WriteChromeTrace(const std::string& path) -> size_t {
+  FILE* f = g_core->platform->FOpen(path.c_str(), "wb");
+  if (!f) {
+    throw Exception("Unable to open '" + path + "' for writing.");
+  }
+  fputs("{\"traceEvents\":[", f);
+
+  // Escape (and demangle) each distinct string just once.
+  std::unordered_map<const char*, std::string> names;
+  std::unordered_map<const char*, std::string> details;
+  auto get_name = [&names](const char* name) {
+    auto i = names.find(name);
+    if (i == names.end()) {
+      i = names.emplace(name, Utils::GetJSONString(name)).first;
+    }
+    return i->second.c_str();
+  };
+  auto get_detail = [&details](const char* detail) {
+    auto i = details.find(detail);
+    if (i == details.end()) {
+      auto demangled = g_core->platform->DemangleCXXSymbol(detail);
+      i = details.emplace(detail, Utils::GetJSONString(demangled.c_str()))
+              .first;
+    }
+    return i->second.c_str();
+  };
+
+  // (Collected and logged after we let go of our locks).
+  std::vector<std::string> warnings;
+
+  std::unique_lock lock(*buffers_mutex_);
+  auto start_time = start_time_.load(std::memory_order_relaxed);
+  size_t count{};
+  bool first{true};
+  for (auto&& buffer : *buffers_) {
+    std::scoped_lock buffer_lock(buffer->mutex);
+    fprintf(f,
+            "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":%s}}",
+            first ? "" : ",", buffer->id,
+            Utils::GetJSONString(buffer->thread_name.c_str()).c_str());
+    first = false;
+    if (buffer->dropped_events > 0) {
+      warnings.push_back("Thread trace for '" + buffer->thread_name
+                         + "' dropped " + std::to_string(buffer->dropped_events)
+                         + " events.");
+    }
+    for (auto&& event : buffer->events) {
+      fprintf(f,
+              ",\n{\"name\":%s,\"cat\":\"native\",\"ph\":\"X\",\"pid\":1,"
+              "\"tid\":%d,\"ts\":%lld,\"dur\":%lld",
+              get_name(event.name), buffer->id,
+              static_cast<long long>(event.start - start_time),  // NOLINT
+              static_cast<long long>(event.duration));           // NOLINT
+      if (event.detail) {
+        fprintf(f, ",\"args\":{\"call\":%s}", get_detail(event.detail));
+      }
+      fputs("}", f);
+      count++;
+    }
+  }
+  lock.unlock();
+  fputs("\n]}\n", f);
+  fclose(f);
+  for (auto&& warning : warnings) {
+    g_core->Log(LogName::kBa, LogLevel::kWarning, warning);
+  }
+  return count;
+}
+
+}  // namespace ballistica::core
@@ -0,0 +1,104 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CORE_SUPPORT_THREAD_TRACE_H_
+#define BALLISTICA_CORE_SUPPORT_THREAD_TRACE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica::core {
+
+/// Most events a single thread will record in one capture; anything past
+/// this is counted but not recorded.
+const size_t kThreadTraceMaxEventsPerThread{250000};
+
+/// Scoped spans recorded from any thread and written out together as a
+/// Chrome trace (viewable in chrome://tracing or Perfetto), one track per
+/// thread. This is what shows how threads interact: logic waiting on
+/// frame-defs, bg-dynamics lagging behind, audio or asset loads hogging a
+/// core, etc. Use BA_TRACE_SCOPE() rather than Scope directly so traces
+/// compile away entirely with BA_ENABLE_THREAD_TRACE=0; when compiled in
+/// but not capturing, a scope costs one relaxed atomic load.
+class ThreadTrace {
+ public:
+  class Scope {
+   public:
+    /// Name (and detail, which gets demangled as a C++ type name when
+    /// written) must be string literals or otherwise outlive the capture.
+    explicit Scope(const char* name, const char* detail = nullptr) {
+      if (active_.load(std::memory_order_relaxed)) {
+        name_ = name;
+        detail_ = detail;
+        start_ = Now_();
+      }
+    }
+
+    ~Scope() {
+      if (name_) {
+        Record_(name_, detail_, start_);
+      }
+    }
+
+   private:
+    BA_DISALLOW_CLASS_COPIES(Scope);
+    const char* name_{};
+    const char* detail_{};
+    microsecs_t start_{};
+  };
+
+  /// Start a new capture (discarding any previous one) or stop the current
+  /// one. A stopped capture is kept around until written or restarted.
+  /// Can be called from any thread.
+  static void SetEnabled(bool enabled);
+  static auto enabled() -> bool {
+    return active_.load(std::memory_order_relaxed);
+  }
+
+  /// Write the current capture as Chrome trace-event json. Returns the
+  /// number of events written. Can be called from any thread, including
+  /// while capturing.
+  static auto WriteChromeTrace(const std::string& path) -> size_t;
+
+ private:
+  struct ThreadBuffer_;
+  static auto Now_() -> microsecs_t;
+  static void Record_(const char* name, const char* detail, microsecs_t start);
+  static auto GetThreadBuffer_() -> ThreadBuffer_*;
+
+  static std::atomic<bool> active_;
+  static std::atomic<microsecs_t> start_time_;
+  static std::mutex* buffers_mutex_;
+  static std::vector<std::unique_ptr<ThreadBuffer_>>* buffers_;
+  static thread_local ThreadBuffer_* thread_buffer_;
+};
+
+}  // namespace ballistica::core
+
+#if BA_ENABLE_THREAD_TRACE
+#define BA_TRACE_SCOPE_CAT2_(a, b) a##b
+#define BA_TRACE_SCOPE_CAT_(a, b) BA_TRACE_SCOPE_CAT2_(a, b)
+
+/// Record the enclosing block as a span named name (a string literal) in
+/// any running thread trace.
+#define BA_TRACE_SCOPE(name)             \
+  ::ballistica::core::ThreadTrace::Scope \
+      BA_TRACE_SCOPE_CAT_(ba_trace_scope_, __LINE__)(name)
+
+/// Like BA_TRACE_SCOPE but also records a C++ type name (such as from
+/// typeid) that shows up demangled in the span's args. Detail is only
+/// evaluated while capturing.
+#define BA_TRACE_SCOPE_DETAIL(name, detail)                           \
+  ::ballistica::core::ThreadTrace::Scope BA_TRACE_SCOPE_CAT_(         \
+      ba_trace_scope_, __LINE__)(                                     \
+      name, ::ballistica::core::ThreadTrace::enabled() ? (detail) : nullptr)
+#else
+#define BA_TRACE_SCOPE(name) ((void)0)
+#define BA_TRACE_SCOPE_DETAIL(name, detail) ((void)0)
+#endif
+
+#endif  // BALLISTICA_CORE_SUPPORT_THREAD_TRACE_H_
@@ -0,0 +1,70 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/bench/bench.h"
+
+#if BA_BENCH_BUILD
+
+#include <cstring>
+#include <vector>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/scene_v1/support/session_command_codec.h"
+#include "ballistica/shared/math/random.h"
+
+namespace ballistica::scene_v1 {
+
+// A session-commands message resembling a busy step: mostly node attr
+// sets (a type byte, node/attr ids and a float or two) with a few bigger
+// commands mixed in.
+static auto MakeCommandsMessage_() -> std::vector<uint8_t> {
+  RandomStream random(3);
+  std::vector<uint8_t> message{BA_MESSAGE_SESSION_COMMANDS};
+  for (int i = 0; i < 200; ++i) {
+    int word_count = (i % 10 == 0) ? 12 : 3;
+    std::vector<uint8_t> command(1 + word_count * 4);
+    command[0] = static_cast<uint8_t>(SessionCommand::kSetNodeAttrFloat);
+    for (int w = 0; w < word_count; ++w) {
+      uint32_t word;
+      if (w < 2) {
+        word = random.NextUInt32() % 300;
+      } else {
+        float value = random.NextFloat(-10.0f, 10.0f);
+        memcpy(&word, &value, sizeof(word));
+      }
+      memcpy(command.data() + 1 + w * 4, &word, sizeof(word));
+    }
+    auto size = static_cast<uint16_t>(command.size());
+    size_t offset = message.size();
+    message.resize(offset + sizeof(size));
+    memcpy(message.data() + offset, &size, sizeof(size));
+    message.insert(message.end(), command.begin(), command.end());
+  }
+  return message;
+}
+
+BA_BENCHMARK(session_commands_compact) {
+  auto message = MakeCommandsMessage_();
+  std::vector<uint8_t> out;
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    SessionCommandCodec::Compact(message, &out);
+    BenchmarkKeep(out);
+  }
+  state->bytes_processed =
+      state->iterations * static_cast<int64_t>(message.size());
+}
+
+BA_BENCHMARK(session_commands_expand) {
+  std::vector<uint8_t> compact;
+  SessionCommandCodec::Compact(MakeCommandsMessage_(), &compact);
+  std::vector<uint8_t> out;
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    SessionCommandCodec::Expand(compact, &out);
+    BenchmarkKeep(out);
+  }
+  state->bytes_processed =
+      state->iterations * static_cast<int64_t>(out.size());
+}
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BA_BENCH_BUILD
@@ -2,16 +2,21 @@
 
 #include "ballistica/scene_v1/connection/connection.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/networking/network_writer.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/support/huffman.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/scene_v1/connection/shared_message.h"
 #include "ballistica/scene_v1/scene_v1.h"
-#include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/math/vector3f.h"
 
 namespace ballistica::scene_v1 {
@@ -21,8 +26,19 @@ namespace ballistica::scene_v1 {
 const int kKeepaliveDelay = 100;  // 1000/15
 
 // How long before an individual packet is re-sent if we haven't gotten an ack.
+// This is used until we have round-trip measurements, and as the lower bound
+// for the measurement-derived timeout afterwards.
 const int kPacketResendTime = 100;
 
+// Upper bound for resend timeouts (including backoff).
+const int kMaxPacketResendTime = 2000;
+
+// Initial size of our out-message ring buffer (grows as needed).
+const size_t kOutMessageWindowInitialSize = 64;
+
+// Longest we'll hold session-commands for a fully congested link.
+const int kMaxSessionCommandsHoldTime = 250;
+
 // How old a packet must be before we prune it.
 const int kPacketPruneTime = 10000;
 
@@ -32,9 +48,114 @@ const int kPacketPruneInterval = 1000;
 // How long to go between updating our ping measurement.
 const int kPingMeasureInterval = 2000;
 
-Connection::Connection() {
+Connection::Connection() : resend_timeout_{kPacketResendTime} {
   // NOLINTNEXTLINE(cppcoreguidelines-prefer-member-initializer)
   creation_time_ = last_average_update_time_ = g_core->AppTimeMillisecs();
+  out_messages_.resize(kOutMessageWindowInitialSize);
+}
+
+Connection::~Connection() {
+  // Any offloaded compression already queued in the writer thread may
+  // still touch our counter, so let that thread delete it once it gets
+  // past those calls.
+  if (offloaded_compressed_bytes_) {
+    auto* counter = offloaded_compressed_bytes_;
+    if (g_base->network_writer && g_base->network_writer->event_loop()) {
+      g_base->network_writer->event_loop()->PushCall(
+          [counter] { delete counter; });
+    } else {
+      delete counter;
+    }
+  }
+}
+
+auto Connection::offloaded_compressed_bytes() -> std::atomic<int64_t>* {
+  if (!offloaded_compressed_bytes_) {
+    offloaded_compressed_bytes_ = new std::atomic<int64_t>{};
+  }
+  return offloaded_compressed_bytes_;
+}
+
+auto Connection::OutMessage_(uint16_t num) -> ReliableMessageOut* {
+  auto oldest = static_cast<uint16_t>(
+      next_out_message_num_ - static_cast<uint16_t>(out_messages_count_));
+  auto offset = static_cast<uint16_t>(num - oldest);
+  if (offset >= out_messages_count_) {
+    return nullptr;
+  }
+  return &out_messages_[(out_messages_head_ + offset)
+                        & (out_messages_.size() - 1)];
+}
+
+auto Connection::PushOutMessage_() -> ReliableMessageOut& {
+  // Grow (keeping things in order) if we're full. Size stays a power of 2
+  // so we can mask our indices.
+  if (out_messages_count_ == out_messages_.size()) {
+    std::vector<ReliableMessageOut> messages(out_messages_.size() * 2);
+    for (size_t i = 0; i < out_messages_count_; i++) {
+      messages[i] = std::move(
+          out_messages_[(out_messages_head_ + i) & (out_messages_.size() - 1)]);
+    }
+    out_messages_.swap(messages);
+    out_messages_head_ = 0;
+  }
+  auto& msg = out_messages_[(out_messages_head_ + out_messages_count_)
+                            & (out_messages_.size() - 1)];
+  out_messages_count_++;
+  return msg;
+}
+
+void Connection::PopOutMessage_() {
+  assert(out_messages_count_ > 0);
+  out_messages_[out_messages_head_].message.Clear();
+  out_messages_head_ = (out_messages_head_ + 1) & (out_messages_.size() - 1);
+  out_messages_count_--;
+}
+
+void Connection::UpdateCongestion_() {
+  // Called once per second with last-second stats in place. We consider
+  // both the fraction of reliable messages we had to re-send and how much
+  // of what we sent didn't get acked; a little of either is normal.
+  float target{};
+  if (last_reliable_message_count_out_ > 0) {
+    auto resend_ratio = static_cast<float>(last_resend_packet_count_)
+                        / static_cast<float>(last_reliable_message_count_out_);
+    target = std::max(target, (resend_ratio - 0.05f) / 0.25f);
+  }
+  if (last_reliable_bytes_out_ > 4096) {
+    auto unacked_ratio = 1.0f
+                         - static_cast<float>(last_bytes_acked_)
+                               / static_cast<float>(last_reliable_bytes_out_);
+    target = std::max(target, (unacked_ratio - 0.2f) / 0.4f);
+  }
+  target = std::clamp(target, 0.0f, 1.0f);
+
+  // Ramp up quickly but back off gradually so we don't oscillate.
+  if (target > congestion_) {
+    congestion_ = 0.5f * congestion_ + 0.5f * target;
+  } else {
+    congestion_ = 0.8f * congestion_ + 0.2f * target;
+  }
+  if (congestion_ < 0.01f) {
+    congestion_ = 0.0f;
+  }
+}
+
+void Connection::UpdateResendTimeout_(millisecs_t rtt_sample) {
+  // Standard smoothed-rtt/variance estimator (as in RFC 6298).
+  auto sample = static_cast<float>(rtt_sample);
+  if (!have_rtt_sample_) {
+    srtt_ = sample;
+    rtt_var_ = sample * 0.5f;
+    have_rtt_sample_ = true;
+  } else {
+    rtt_var_ = 0.75f * rtt_var_ + 0.25f * std::abs(srtt_ - sample);
+    srtt_ = 0.875f * srtt_ + 0.125f * sample;
+  }
+  auto timeout = static_cast<millisecs_t>(srtt_ + 4.0f * rtt_var_);
+  resend_timeout_ =
+      std::clamp(timeout, static_cast<millisecs_t>(kPacketResendTime),
+                 static_cast<millisecs_t>(kMaxPacketResendTime));
 }
 
 void Connection::ProcessWaitingMessages() {
@@ -85,19 +206,57 @@ void Connection::HandleResends(millisecs_t real_time,
   // (prevents some un-necessary re-sending)
   uint8_t extra_bits = data[offset + 2];
 
+  // Acks can arrive out of order; if this one is older than what we've
+  // already seen acked there's nothing new to learn from it.
+  auto behind = static_cast<uint16_t>(their_next_in_acked_ - their_next_in);
+  if (behind != 0 && behind < 32768) {
+    return;
+  }
+
+  // If they want something we've already pruned (or haven't sent yet),
+  // abort the connection.
+  auto oldest = static_cast<uint16_t>(
+      next_out_message_num_ - static_cast<uint16_t>(out_messages_count_));
+  auto acked_count = static_cast<uint16_t>(their_next_in - oldest);
+  if (acked_count > out_messages_count_) {
+    Error("");
+    return;
+  }
+  their_next_in_acked_ = their_next_in;
+
   // Ack packets and take the opportunity to measure ping.
   auto test_num = static_cast<uint16_t>(their_next_in - 1u);
-  auto j = out_messages_.find(test_num);
-  if (j != out_messages_.end()) {
-    ReliableMessageOut& msg(j->second);
-    if (!msg.acked) {
+  if (ReliableMessageOut* msg = acked_count > 0 ? OutMessage_(test_num)
+                                                : nullptr) {
+    if (!msg->acked) {
       // Periodically use this opportunity to measure ping.
       if (real_time - last_ping_measure_time_ > kPingMeasureInterval) {
-        current_ping_ = static_cast<float>(real_time - msg.first_send_time);
+        current_ping_ = static_cast<float>(real_time - msg->first_send_time);
         last_ping_measure_time_ = real_time;
       }
     }
-    msg.acked = true;
+  }
+
+  // Everything before their next-wanted has been received, so it can
+  // leave our window. Feed the newest into our rtt estimate, but only if
+  // nothing in that range was re-sent (otherwise we can't tell which send
+  // the ack is for, or the ack was held up behind a lost message).
+  if (acked_count > 0) {
+    bool any_resent{};
+    bool newest_acked{};
+    millisecs_t newest_send_time{};
+    for (uint16_t i = 0; i < acked_count; i++) {
+      ReliableMessageOut& msg(out_messages_[out_messages_head_]);
+      any_resent |= msg.resent;
+      bytes_acked_ += static_cast<int64_t>(msg.message->data().size())
+                      + kMessagePacketHeaderSize;
+      newest_acked = msg.acked;
+      newest_send_time = msg.last_send_time;
+      PopOutMessage_();
+    }
+    if (!any_resent && !newest_acked) {
+      UpdateResendTimeout_(real_time - newest_send_time);
+    }
   }
 
   // Re-send up to 9 un-acked packets if it's been long enough.
@@ -118,12 +277,12 @@ void Connection::HandleResends(millisecs_t real_time,
 
     // If we have no record for this out-packet, it's too old; abort the
     // connection.
-    auto j2 = out_messages_.find(num);
-    if (j2 == out_messages_.end()) {
+    ReliableMessageOut* msg_ptr = OutMessage_(num);
+    if (msg_ptr == nullptr) {
       Error("");
       return;
     }
-    ReliableMessageOut& msg(j2->second);
+    ReliableMessageOut& msg(*msg_ptr);
 
     // Check with the actual packet for ack state (it may have been acked by
     // another packet but not this one).
@@ -133,28 +292,31 @@ void Connection::HandleResends(millisecs_t real_time,
 
     // If its un-acked and older than our threshold, re-send.
     if (!msg.acked && real_time - msg.last_send_time > msg.resend_time) {
-      msg.resend_time *= 2;  // wait twice as long with each resend..
+      // If we're out of upstream budget, leave the rest for the next ack
+      // that comes in; it will still be due then.
+      if (OverSendBudget_()) {
+        break;
+      }
+
+      // Wait twice as long with each resend..
+      msg.resend_time =
+          std::min(msg.resend_time * 2,
+                   static_cast<millisecs_t>(kMaxPacketResendTime));
       msg.last_send_time = real_time;
+      msg.resent = true;
 
-      // Add our header/acks and go ahead and send this one out.
-      // 1 byte for type, 2 for packet-num, 3 for acks
-      std::vector<uint8_t> data_out(msg.data.size() + kMessagePacketHeaderSize);
-      data_out[0] = BA_SCENEPACKET_MESSAGE;
-      memcpy(data_out.data() + 1, &num, sizeof(num));
-      EmbedAcks(real_time, &data_out, 3);
-      memcpy(&(data_out[6]), &(msg.data[0]), msg.data.size());
-      SendGamePacket(data_out);
+      SendReliableMessagePacket_(num, real_time, *msg.message);
       resend_packet_count_++;
-      resend_bytes_out_ += data_out.size();
+      resend_bytes_out_ +=
+          msg.message->data().size() + kMessagePacketHeaderSize;
     }
     num++;
   }
 }
 
 void Connection::HandleGamePacketCompressed(const std::vector<uint8_t>& data) {
-  std::vector<uint8_t> data_decompressed;
   try {
-    data_decompressed = g_base->huffman->decompress(data);
+    g_base->huffman->decompress(data.data(), data.size(), &decompress_buffer_);
   } catch (const std::exception& e) {
     g_core->Log(
         LogName::kBaNetworking, LogLevel::kError,
@@ -165,9 +327,9 @@ void Connection::HandleGamePacketCompressed(const std::vector<uint8_t>& data) {
     return;
   }
   bytes_in_compressed_ += data.size();
-  HandleGamePacket(data_decompressed);
+  bytes_in_ += decompress_buffer_.size();
   packet_count_in_++;
-  bytes_in_ += data_decompressed.size();
+  HandleGamePacket(decompress_buffer_);
 }
 
 void Connection::HandleGamePacket(const std::vector<uint8_t>& data) {
@@ -270,60 +432,113 @@ void Connection::SendReliableMessage(const std::vector<uint8_t>& data) {
   if (connection_dying_) {
     return;
   }
+  SendReliableMessage(Object::New<SharedMessage>(data));
+}
 
-  // To allow sending messages of any size, we transparently break large
-  // messages up into BA_MESSAGE_MULTIPART messages which are transparently
-  // re-assembled on the other end.
-  if (data.size() > 480) {
-    auto data_size = static_cast<uint32_t>(data.size());
-    uint32_t part_start = 0;
-    uint32_t part_size = 479;
-    while (true) {
-      // If this takes us to the end of the message, send a multipart-end.
-      if ((part_start + part_size) >= data_size) {
-        part_size = data_size - part_start;
-        assert(part_size > 0);
-        // 1 byte type plus data
-        std::vector<uint8_t> part_message(1 + part_size);
-        part_message[0] = BA_MESSAGE_MULTIPART_END;
-        memcpy(&(part_message[1]), &(data[part_start]), part_size);
-        SendReliableMessage(part_message);
-        return;
-      } else {
-        std::vector<uint8_t> part_message(1 + part_size);
-        part_message[0] = BA_MESSAGE_MULTIPART;
-        memcpy(&(part_message[1]), &(data[part_start]), part_size);
-        SendReliableMessage(part_message);
-      }
-      part_start += part_size;
+void Connection::SendReliableMessage(
+    const Object::Ref<SharedMessage>& message) {
+  assert(message.exists());
+
+  // If our connection is going down, silently ignore this.
+  if (connection_dying_) {
+    return;
+  }
+
+  // Anything we've been holding needs to go out ahead of this.
+  if (!held_session_commands_.empty()) {
+    FlushHeldSessionCommands_();
+  }
+
+  // Large messages come pre-split into multipart messages; send those
+  // instead.
+  if (!message->parts().empty()) {
+    for (auto&& part : message->parts()) {
+      SendReliableMessage(part);
     }
+    return;
   }
 
+  // Add an entry for it.
+  ReliableMessageOut& msg(PushOutMessage_());
   uint16_t num = next_out_message_num_++;
 
   // By incrementing reliable-message-num we reset the unreliable num.
   next_out_unreliable_message_num_ = 0;
 
-  // Add an entry for it.
-  assert(out_messages_.find(num) == out_messages_.end());
-  ReliableMessageOut& msg(out_messages_[num]);
-
   millisecs_t real_time = g_core->AppTimeMillisecs();
 
-  msg.data = data;
+  msg.message = message;
   msg.first_send_time = msg.last_send_time = real_time;
-  msg.resend_time = kPacketResendTime;
+  msg.resend_time = resend_timeout_;
   msg.acked = false;
+  msg.resent = false;
+  reliable_message_count_out_++;
+  reliable_bytes_out_ +=
+      static_cast<int64_t>(message->data().size()) + kMessagePacketHeaderSize;
+
+  SendReliableMessagePacket_(num, real_time, *message);
+}
+
+void Connection::SendSessionCommandsMessage(
+    const Object::Ref<SharedMessage>& message) {
+  assert(message.exists());
+  auto& data{message->data()};
+  assert(!data.empty()
+         && (data[0] == BA_MESSAGE_SESSION_COMMANDS
+             || data[0] == BA_MESSAGE_SESSION_COMMANDS_COMPACT));
+
+  if (connection_dying_) {
+    return;
+  }
+
+  // Healthy links just get the shared message as-is.
+  if (congestion_ == 0.0f && held_session_commands_.empty()
+      && !OverSendBudget_()) {
+    SendReliableMessage(message);
+    return;
+  }
+
+  // Otherwise tack these commands onto our held ones. Session-commands
+  // messages are just a type byte followed by length-prefixed commands, so
+  // merging is simple concatenation.
+  millisecs_t real_time = g_core->AppTimeMillisecs();
+  if (held_session_commands_.empty()) {
+    held_session_commands_ = data;
+    held_session_commands_time_ = real_time;
+  } else {
+    held_session_commands_.insert(held_session_commands_.end(),
+                                  data.begin() + 1, data.end());
+  }
+  if (real_time - held_session_commands_time_
+      >= static_cast<millisecs_t>(kMaxSessionCommandsHoldTime
+                                  * SessionCommandsHoldFactor_())) {
+    FlushHeldSessionCommands_();
+  }
+}
+
+auto Connection::SessionCommandsHoldFactor_() const -> float {
+  // Being out of upstream budget counts as fully congested; it's the same
+  // problem from our end of the link.
+  return OverSendBudget_() ? 1.0f : congestion_;
+}
+
+void Connection::FlushHeldSessionCommands_() {
+  assert(!held_session_commands_.empty());
+  std::vector<uint8_t> data;
+  data.swap(held_session_commands_);
+  SendReliableMessage(Object::New<SharedMessage>(data));
+}
 
+void Connection::SendReliableMessagePacket_(uint16_t num,
+                                            millisecs_t real_time,
+                                            const SharedMessage& message) {
   // Add our header/acks and go ahead and send this one out.
   // 1 byte for type, 2 for packet-num, 3 for acks
-  std::vector<uint8_t> data_out(data.size() + kMessagePacketHeaderSize);
-
-  data_out[0] = BA_SCENEPACKET_MESSAGE;
-  memcpy(data_out.data() + 1, &num, sizeof(num));
-  EmbedAcks(real_time, &data_out, 3);
-  memcpy(&(data_out[6]), &(data[0]), data.size());
-  SendGamePacket(data_out);
+  message_header_buffer_.resize(kMessagePacketHeaderSize);
+  message_header_buffer_[0] = BA_SCENEPACKET_MESSAGE;
+  memcpy(message_header_buffer_.data() + 1, &num, sizeof(num));
+  EmbedAcks(real_time, &message_header_buffer_, 3);
+  SendGamePacket(message_header_buffer_, message);
 }
 
 void Connection::SendUnreliableMessage(const std::vector<uint8_t>& data) {
@@ -335,8 +550,9 @@ void Connection::SendUnreliableMessage(const std::vector<uint8_t>& data) {
     return;
   }
 
-  // If our connection is going down, silently ignore this.
-  if (connection_dying_) {
+  // If our connection is going down, silently ignore this. Same if we're
+  // out of upstream budget; these are droppable by definition.
+  if (connection_dying_ || OverSendBudget_()) {
     return;
   }
 
@@ -356,19 +572,26 @@ void Connection::SendUnreliableMessage(const std::vector<uint8_t>& data) {
   SendGamePacket(data_out);
 }
 
-void Connection::SendJMessage(cJSON* val) {
-  char* s = cJSON_PrintUnformatted(val);
-  auto s_len = static_cast<size_t>(strlen(s));
-  std::vector<uint8_t> msg(1u + s_len + 1u);
+auto Connection::MakeJMessage(const std::string& json)
+    -> std::vector<uint8_t> {
+  std::vector<uint8_t> msg(1u + json.size() + 1u);
   msg[0] = BA_MESSAGE_JMESSAGE;
-  memcpy(msg.data() + 1u, s, s_len + 1u);
-  free(s);
-  SendReliableMessage(msg);
+  memcpy(msg.data() + 1u, json.c_str(), json.size() + 1u);
+  return msg;
+}
+
+void Connection::SendJMessage(const std::string& json) {
+  SendReliableMessage(MakeJMessage(json));
 }
 
 void Connection::Update() {
   millisecs_t real_time = g_core->AppTimeMillisecs();
 
+  // Pick up stats from any compression done in the writer thread.
+  if (offloaded_compressed_bytes_) {
+    bytes_out_compressed_ += offloaded_compressed_bytes_->exchange(0);
+  }
+
   // Update our averages once per second.
   while (real_time - last_average_update_time_ > 1000) {
     last_average_update_time_ += 1000;  // Don't want this to drift.
@@ -383,6 +606,19 @@ void Connection::Update() {
     bytes_out_ = packet_count_out_ = bytes_out_compressed_ = 0;
     bytes_in_ = bytes_in_compressed_ = packet_count_in_ = 0;
     resend_packet_count_ = resend_bytes_out_ = 0;
+    last_bytes_acked_ = bytes_acked_;
+    last_reliable_message_count_out_ = reliable_message_count_out_;
+    last_reliable_bytes_out_ = reliable_bytes_out_;
+    bytes_acked_ = reliable_message_count_out_ = reliable_bytes_out_ = 0;
+    UpdateCongestion_();
+  }
+
+  // Ship held session-commands once they've waited long enough.
+  if (!held_session_commands_.empty()
+      && real_time - held_session_commands_time_
+             >= static_cast<millisecs_t>(kMaxSessionCommandsHoldTime
+                                         * SessionCommandsHoldFactor_())) {
+    FlushHeldSessionCommands_();
   }
 
   if (can_communicate() && real_time - last_ack_send_time_ > kKeepaliveDelay) {
@@ -399,19 +635,12 @@ void Connection::Update() {
   // Occasionally prune our in and out messages.
   if (real_time - last_prune_time_ > kPacketPruneInterval) {
     last_prune_time_ = real_time;
-    {
-      int prune_count = 0;
-      for (auto i = out_messages_.begin(); i != out_messages_.end();) {
-        if (real_time - i->second.first_send_time > kPacketPruneTime) {
-          auto i_next = i;
-          i_next++;
-          out_messages_.erase(i);
-          prune_count++;
-          i = i_next;
-        } else {
-          i++;
-        }
-      }
+    // Out-messages are stored in send order, so we just trim from the
+    // front.
+    while (out_messages_count_ > 0
+           && real_time - out_messages_[out_messages_head_].first_send_time
+                  > kPacketPruneTime) {
+      PopOutMessage_();
     }
     {
       int prune_count = 0;
@@ -476,44 +705,90 @@ void Connection::SendGamePacket(const std::vector<uint8_t>& data) {
 
   assert(!data.empty());
 
+  if (!CanSendGamePacket_(data[0])) {
+    return;
+  }
+
+  packet_count_out_++;
+  bytes_out_ += data.size();
+  if (send_budgeted_) {
+    send_allowance_ -= static_cast<float>(data.size());
+  }
+
+#if kTestPacketDrops
+  if (rand() % 100 < kTestPacketDropPercent) {  // NOLINT
+    return;
+  }
+#endif
+
+  SendGamePacketUncompressed(data);
+}
+
+void Connection::SendGamePacketUncompressed(const std::vector<uint8_t>& data) {
+  // We huffman-compress gamepackets on their way out.
+  g_base->huffman->compress(data.data(), data.size(), &compress_buffer_);
+  bytes_out_compressed_ += compress_buffer_.size();
+  SendGamePacketCompressed(compress_buffer_);
+}
+
+void Connection::SendGamePacket(const std::vector<uint8_t>& header,
+                                const SharedMessage& payload) {
+  assert(!header.empty());
+
+  if (!CanSendGamePacket_(header[0])) {
+    return;
+  }
+
+  auto& payload_data = payload.data();
+  packet_count_out_++;
+  bytes_out_ += header.size() + payload_data.size();
+  if (send_budgeted_) {
+    send_allowance_ -= static_cast<float>(header.size() + payload_data.size());
+  }
+
+  // The payload was huffman-encoded up front; we just need to stitch our
+  // header on.
+  g_base->huffman->compress_with_prefix(
+      header.data(), header.size(), payload_data.data(), payload_data.size(),
+      payload.encoded_bits().data(), payload.encoded_bit_count(),
+      &compress_buffer_);
+
+#if kTestPacketDrops
+  if (rand() % 100 < kTestPacketDropPercent) {  // NOLINT
+    return;
+  }
+#endif
+
+  bytes_out_compressed_ += compress_buffer_.size();
+  SendGamePacketCompressed(compress_buffer_);
+}
+
+auto Connection::CanSendGamePacket_(uint8_t packet_type) -> bool {
   // Normally we withhold all packets until we know we speak the
   // same language.  However, DISCONNECT is a special case.
   // (if we don't speak the same language we still need to be
   // able to tell them to buzz off)
   bool can_send = can_communicate();
-  if (data[0] == BA_SCENEPACKET_DISCONNECT) {
+  if (packet_type == BA_SCENEPACKET_DISCONNECT) {
     can_send = true;
   }
 
   // We aren't allowed to send anything out except handshakes until
   // we've established that we can speak their language.
   // If something does come through, just ignore it.
-  if (!can_send && data[0] != BA_SCENEPACKET_HANDSHAKE
-      && data[0] != BA_SCENEPACKET_HANDSHAKE_RESPONSE) {
+  if (!can_send && packet_type != BA_SCENEPACKET_HANDSHAKE
+      && packet_type != BA_SCENEPACKET_HANDSHAKE_RESPONSE) {
     if (explicit_bool(false)) {
       BA_LOG_ONCE(
           LogName::kBaNetworking, LogLevel::kError,
           "SendGamePacket() called before can_communicate set ("
               + g_core->platform->DemangleCXXSymbol(typeid(*this).name())
-              + " ptype " + std::to_string(static_cast<int>(data[0])) + ")");
+              + " ptype " + std::to_string(static_cast<int>(packet_type))
+              + ")");
     }
-    return;
-  }
-
-  packet_count_out_++;
-  bytes_out_ += data.size();
-
-  // We huffman-compress gamepackets on their way out.
-  std::vector<uint8_t> data_compressed = g_base->huffman->compress(data);
-
-#if kTestPacketDrops
-  if (rand() % 100 < kTestPacketDropPercent) {  // NOLINT
-    return;
+    return false;
   }
-#endif
-
-  bytes_out_compressed_ += data_compressed.size();
-  SendGamePacketCompressed(data_compressed);
+  return true;
 }
 
 }  // namespace ballistica::scene_v1
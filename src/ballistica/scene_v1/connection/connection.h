@@ -3,10 +3,12 @@
 #ifndef BALLISTICA_SCENE_V1_CONNECTION_CONNECTION_H_
 #define BALLISTICA_SCENE_V1_CONNECTION_CONNECTION_H_
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "ballistica/scene_v1/connection/shared_message.h"
 #include "ballistica/scene_v1/support/player_spec.h"
 #include "ballistica/shared/foundation/object.h"
 #include "ballistica/shared/python/python_ref.h"
@@ -20,18 +22,34 @@ const int kFirstConnectionStateNum = 65520;
 class Connection : public Object {
  public:
   Connection();
+  ~Connection() override;
 
   // Send a reliable message to the client
   // these will always be delivered in the order sent
   void SendReliableMessage(const std::vector<uint8_t>& data);
 
+  // Send a reliable message using a shared message buffer. When sending
+  // the same data to multiple connections this is more efficient, as the
+  // data is stored and huffman-encoded only once.
+  void SendReliableMessage(const Object::Ref<SharedMessage>& message);
+
+  // Send a BA_MESSAGE_SESSION_COMMANDS message reliably. When our link
+  // looks congested these get held briefly and merged with the ones that
+  // follow, so a struggling peer gets fewer, larger messages. Sending any
+  // other reliable message first flushes whatever is being held so overall
+  // ordering is preserved.
+  void SendSessionCommandsMessage(const Object::Ref<SharedMessage>& message);
+
   // Send an unreliable message to the client; these are not guaranteed
   // to be delivered, but when they are, they're delivered properly in order
   // between other unreliable/reliable messages.
   void SendUnreliableMessage(const std::vector<uint8_t>& data);
 
-  // Send a json-based reliable message.
-  void SendJMessage(cJSON* val);
+  // Send a json-based reliable message (see JsonWriter).
+  void SendJMessage(const std::string& json);
+
+  /// Wrap json up the way SendJMessage() does.
+  static auto MakeJMessage(const std::string& json) -> std::vector<uint8_t>;
   virtual void Update();
 
   // Called with raw packets as they come in from the network.
@@ -64,6 +82,30 @@ class Connection : public Object {
     return last_resend_bytes_out_;
   }
   auto current_ping() const -> float { return current_ping_; }
+
+  /// The timeout we currently apply to fresh reliable messages before
+  /// re-sending them; derived from measured round-trip times.
+  auto resend_timeout() const -> millisecs_t { return resend_timeout_; }
+
+  /// Our estimate of how congested the link to our peer is; 0 when things
+  /// look healthy, up to 1 when we're badly overrunning it. Derived from
+  /// resend rates and how far acked reliable bytes lag behind sent ones.
+  auto congestion() const -> float { return congestion_; }
+  auto GetBytesAckedPerSecond() const -> int64_t { return last_bytes_acked_; }
+
+  /// Put us under (or release us from) a server-wide upstream budget; see
+  /// ConnectionSet::SetUpstreamLimit(). While budgeted, everything we send
+  /// is charged against our allowance, and while that is used up we hold
+  /// session commands as if congested and put off re-sends.
+  void set_send_budgeted(bool val) {
+    send_budgeted_ = val;
+    send_allowance_ = 0.0f;
+  }
+  auto send_budgeted() const { return send_budgeted_; }
+
+  /// Bytes we may still send under our budget (negative if in debt).
+  auto send_allowance() const { return send_allowance_; }
+  void set_send_allowance(float val) { send_allowance_ = val; }
   auto can_communicate() const -> bool { return can_communicate_; }
   auto peer_spec() const -> const PlayerSpec& { return peer_spec_; }
   void HandleGamePacketCompressed(const std::vector<uint8_t>& data);
@@ -75,7 +117,22 @@ class Connection : public Object {
 
  protected:
   void SendGamePacket(const std::vector<uint8_t>& data);
+
+  // Send a game packet consisting of a header followed by a shared
+  // message's payload (using the message's pre-encoded bits).
+  void SendGamePacket(const std::vector<uint8_t>& header,
+                      const SharedMessage& payload);
+
+  // Takes a fully-formed game packet and gets it on its way. By default
+  // this huffman-compresses it here and passes the result to
+  // SendGamePacketCompressed(); transports that can hand the compression
+  // off to the network-writer thread may override this to do so.
+  virtual void SendGamePacketUncompressed(const std::vector<uint8_t>& data);
   virtual void SendGamePacketCompressed(const std::vector<uint8_t>& data) = 0;
+
+  // Counter for transports to pass along with offloaded compression so
+  // our compressed-bytes stats stay accurate.
+  auto offloaded_compressed_bytes() -> std::atomic<int64_t>*;
   void ErrorSilent() { Error(""); }
   virtual void Error(const std::string& error_msg);
   void set_peer_spec(const PlayerSpec& spec) { peer_spec_ = spec; }
@@ -84,25 +141,45 @@ class Connection : public Object {
   void set_errored(bool val) { errored_ = val; }
 
  private:
-  void ProcessWaitingMessages();
-  void HandleResends(millisecs_t real_time, const std::vector<uint8_t>& data,
-                     int offset);
-  void EmbedAcks(millisecs_t real_time, std::vector<uint8_t>* data, int offset);
-  std::vector<uint8_t> multipart_buffer_;
-
   struct ReliableMessageIn {
     std::vector<uint8_t> data;
     millisecs_t arrival_time;
   };
 
   struct ReliableMessageOut {
-    std::vector<uint8_t> data;
+    Object::Ref<SharedMessage> message;
     millisecs_t first_send_time;
     millisecs_t last_send_time;
     millisecs_t resend_time;
     bool acked;
+    bool resent;
   };
 
+  void ProcessWaitingMessages();
+  void HandleResends(millisecs_t real_time, const std::vector<uint8_t>& data,
+                     int offset);
+  void EmbedAcks(millisecs_t real_time, std::vector<uint8_t>* data, int offset);
+  void SendReliableMessagePacket_(uint16_t num, millisecs_t real_time,
+                                  const SharedMessage& message);
+  auto CanSendGamePacket_(uint8_t packet_type) -> bool;
+  void UpdateResendTimeout_(millisecs_t rtt_sample);
+  auto OutMessage_(uint16_t num) -> ReliableMessageOut*;
+  auto PushOutMessage_() -> ReliableMessageOut&;
+  void PopOutMessage_();
+  void UpdateCongestion_();
+  void FlushHeldSessionCommands_();
+  auto OverSendBudget_() const -> bool {
+    return send_budgeted_ && send_allowance_ <= 0.0f;
+  }
+  auto SessionCommandsHoldFactor_() const -> float;
+  std::vector<uint8_t> multipart_buffer_;
+
+  // Scratch buffers reused for each packet's huffman work so we don't
+  // allocate per packet.
+  std::vector<uint8_t> compress_buffer_;
+  std::vector<uint8_t> decompress_buffer_;
+  std::vector<uint8_t> message_header_buffer_;
+
   // Leaf classes should set this when they start dying.
   // This prevents any SendGamePacketCompressed() calls from happening.
   bool connection_dying_{};
@@ -127,7 +204,44 @@ class Connection : public Object {
   millisecs_t creation_time_{};
   PlayerSpec peer_spec_;  // Name of the account/device on the other end.
   std::unordered_map<uint16_t, ReliableMessageIn> in_messages_;
-  std::unordered_map<uint16_t, ReliableMessageOut> out_messages_;
+
+  // Our send window: a ring buffer of un-pruned out-messages in send order.
+  // The oldest entry is always number
+  // (next_out_message_num_ - out_messages_count_).
+  std::vector<ReliableMessageOut> out_messages_;
+  size_t out_messages_head_{};
+  size_t out_messages_count_{};
+
+  // The most recent next-wanted message number our peer has told us.
+  uint16_t their_next_in_acked_ = kFirstConnectionStateNum;
+
+  // Smoothed round-trip-time estimates used to derive resend_timeout_.
+  float srtt_{};
+  float rtt_var_{};
+  bool have_rtt_sample_{};
+  millisecs_t resend_timeout_{};
+
+  // Link congestion estimate and the stats feeding it.
+  float congestion_{};
+  int64_t bytes_acked_{};
+  int64_t last_bytes_acked_{};
+  int64_t reliable_message_count_out_{};
+  int64_t last_reliable_message_count_out_{};
+  int64_t reliable_bytes_out_{};
+  int64_t last_reliable_bytes_out_{};
+
+  // Session-commands being held back while congested (see
+  // SendSessionCommandsMessage()).
+  std::vector<uint8_t> held_session_commands_;
+  millisecs_t held_session_commands_time_{};
+
+  // Server-wide upstream budgeting (see set_send_budgeted()).
+  bool send_budgeted_{};
+  float send_allowance_{};
+
+  // Written from the network-writer thread; see
+  // offloaded_compressed_bytes().
+  std::atomic<int64_t>* offloaded_compressed_bytes_{};
   bool can_communicate_{};
   bool errored_{};
   millisecs_t last_prune_time_{};
@@ -4,6 +4,7 @@
 
 #include <Python.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -21,6 +22,18 @@
 
 namespace ballistica::scene_v1 {
 
+// Server-wide chat messages per second we'll relay from clients (and how
+// many can come in a burst).
+const float kChatFanOutRate{8.0f};
+const float kChatFanOutBurst{16.0f};
+
+// How much of a second's upstream budget can pile up unused (and so how
+// much any one connection can send in a burst).
+const float kUpstreamBurstFraction{0.1f};
+
+// Always let a budgeted connection save up at least a packet's worth.
+const float kMinUpstreamAllowance{static_cast<float>(kMaxPacketSize)};
+
 ConnectionSet::ConnectionSet() = default;
 
 auto ConnectionSet::GetConnectionToHostUDP() -> ConnectionToHostUDP* {
@@ -54,6 +67,13 @@ void ConnectionSet::RegisterClientController(ClientControllerInterface* c) {
 }
 
 void ConnectionSet::Update() {
+  // Resends/keepalives/etc. from all connections go out together.
+  base::NetworkWriter::ScopedSendBatch batch;
+
+  if (upstream_limit_ > 0) {
+    UpdateUpstreamBudget_();
+  }
+
   // First do housekeeping on our client/host connections.
   for (auto&& i : connections_to_clients_) {
     BA_IFDEBUG(Object::WeakRef<ConnectionToClient> test_ref(i.second));
@@ -68,6 +88,65 @@ void ConnectionSet::Update() {
   }
 }
 
+void ConnectionSet::SetUpstreamLimit(int64_t bytes_per_second) {
+  assert(g_base->InLogicThread());
+  bytes_per_second = std::max(bytes_per_second, int64_t{0});
+  if (bytes_per_second == upstream_limit_) {
+    return;
+  }
+  bool was_limited = upstream_limit_ > 0;
+  upstream_limit_ = bytes_per_second;
+  if (upstream_limit_ > 0 && !was_limited) {
+    upstream_pool_ = 0.0f;
+    upstream_time_ = g_core->AppTimeMillisecs();
+  } else if (upstream_limit_ == 0) {
+    for (auto&& i : connections_to_clients_) {
+      i.second->set_send_budgeted(false);
+    }
+  }
+}
+
+void ConnectionSet::UpdateUpstreamBudget_() {
+  assert(upstream_limit_ > 0);
+  millisecs_t real_time = g_core->AppTimeMillisecs();
+  auto limit = static_cast<float>(upstream_limit_);
+  float burst = limit * kUpstreamBurstFraction;
+
+  // Don't let a long hitch hand out a flood all at once.
+  upstream_pool_ = std::min(
+      burst, upstream_pool_
+                 + limit * static_cast<float>(real_time - upstream_time_)
+                       / 1000.0f);
+  upstream_time_ = real_time;
+
+  budgeted_connections_.clear();
+  for (auto&& i : connections_to_clients_) {
+    if (!i.second->send_budgeted()) {
+      i.second->set_send_budgeted(true);
+    }
+    budgeted_connections_.push_back(i.second.get());
+  }
+  if (budgeted_connections_.empty()) {
+    return;
+  }
+
+  // Hand out even shares, starting with a different connection each time
+  // so nobody is always first or last in line. Connections already sitting
+  // on a full allowance leave their share in the pool for the rest, and
+  // connections in debt (from sends that can't wait) pay it off first.
+  auto count = budgeted_connections_.size();
+  float cap = std::max(kMinUpstreamAllowance,
+                       burst / static_cast<float>(count));
+  auto start = upstream_rotation_++ % count;
+  for (size_t i = 0; i < count; ++i) {
+    auto* connection = budgeted_connections_[(start + i) % count];
+    float share = upstream_pool_ / static_cast<float>(count - i);
+    float give = std::clamp(cap - connection->send_allowance(), 0.0f, share);
+    connection->set_send_allowance(connection->send_allowance() + give);
+    upstream_pool_ -= give;
+  }
+}
+
 auto ConnectionSet::GetConnectedClientCount() const -> int {
   assert(g_base->InLogicThread());
   int count = 0;
@@ -180,24 +259,7 @@ void ConnectionSet::SendChatMessage(const std::string& message,
     // Ok we're the host.
 
     // Send to all (or at least some) connected clients.
-    for (auto&& i : connections_to_clients_) {
-      // Skip if its going to specific ones and this one doesn't match.
-      if (clients != nullptr) {
-        auto found = false;
-        for (auto&& c : *clients) {
-          if (c == i.second->id()) {
-            found = true;
-          }
-        }
-        if (!found) {
-          continue;
-        }
-      }
-
-      if (i.second->can_communicate()) {
-        i.second->SendReliableMessage(msg_out);
-      }
-    }
+    SendChatToClients(msg_out, clients);
 
     // And display locally if the message is addressed to all.
     if (clients == nullptr) {
@@ -233,29 +295,80 @@ void ConnectionSet::Shutdown() {
   }
 }
 
-void ConnectionSet::SendScreenMessageToClients(const std::string& s, float r,
-                                               float g, float b) {
+void ConnectionSet::SendChatToClients(const std::vector<uint8_t>& message,
+                                      const std::vector<int>* clients) {
+  Object::Ref<SharedMessage> shared_message;
   for (auto&& i : connections_to_clients_) {
-    if (i.second.exists() && i.second->can_communicate()) {
-      i.second->SendScreenMessage(s, r, g, b);
+    auto* client = i.second.get();
+    if (!client || !client->can_communicate()) {
+      continue;
+    }
+
+    // Skip if its going to specific ones and this one doesn't match.
+    if (clients != nullptr
+        && std::find(clients->begin(), clients->end(), client->id())
+               == clients->end()) {
+      continue;
+    }
+    if (!shared_message.exists()) {
+      shared_message = Object::New<SharedMessage>(message);
     }
+    client->SendReliableMessage(shared_message);
   }
 }
 
-void ConnectionSet::SendScreenMessageToSpecificClients(
-    const std::string& s, float r, float g, float b,
-    const std::vector<int>& clients) {
+auto ConnectionSet::AllowClientChatFanOut() -> bool {
+  millisecs_t now = g_core->AppTimeMillisecs();
+  chat_fan_out_tokens_ =
+      std::min(kChatFanOutBurst,
+               chat_fan_out_tokens_
+                   + static_cast<float>(now - chat_fan_out_time_) * 0.001f
+                         * kChatFanOutRate);
+  chat_fan_out_time_ = now;
+  if (chat_fan_out_tokens_ < 1.0f) {
+    BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
+                "Dropping client chat messages; server-wide chat rate "
+                "exceeded.");
+    return false;
+  }
+  chat_fan_out_tokens_ -= 1.0f;
+  return true;
+}
+
+void ConnectionSet::SendScreenMessage_(const std::string& s, float r, float g,
+                                       float b,
+                                       const std::vector<int>* clients) {
+  // Build each form of the message at most once no matter how many
+  // clients get it.
+  Object::Ref<SharedMessage> messages[2];
   for (auto&& i : connections_to_clients_) {
-    if (i.second.exists() && i.second->can_communicate()) {
-      // Only send if this client is in our list.
-      for (auto c : clients) {
-        if (c == i.second->id()) {
-          i.second->SendScreenMessage(s, r, g, b);
-          break;
-        }
-      }
+    auto* client = i.second.get();
+    if (!client || !client->can_communicate()) {
+      continue;
+    }
+    if (clients != nullptr
+        && std::find(clients->begin(), clients->end(), client->id())
+               == clients->end()) {
+      continue;
     }
+    bool legacy = !client->SupportsScreenMessages();
+    auto& message = messages[legacy];
+    if (!message.exists()) {
+      message = ConnectionToClient::MakeScreenMessage(s, r, g, b, legacy);
+    }
+    client->SendReliableMessage(message);
   }
+}
+
+void ConnectionSet::SendScreenMessageToClients(const std::string& s, float r,
+                                               float g, float b) {
+  SendScreenMessage_(s, r, g, b, nullptr);
+}
+
+void ConnectionSet::SendScreenMessageToSpecificClients(
+    const std::string& s, float r, float g, float b,
+    const std::vector<int>& clients) {
+  SendScreenMessage_(s, r, g, b, &clients);
 
   // Now print locally only if -1 is in our list.
   for (auto c : clients) {
@@ -626,9 +739,10 @@ void ConnectionSet::HandleIncomingUDPPacket(const std::vector<uint8_t>& data_in,
         std::string client_instance_uuid = &(client_instance_buffer[0]);
 
         if (static_cast<int>(connections_to_clients_.size() + 1)
-            >= appmode->public_party_max_size()) {
+                >= appmode->public_party_max_size()
+            || !appmode->tick_monitor()->current().accept_joins) {
           // If we've reached our party size limit (including ourself in that
-          // count), reject.
+          // count) or are too overloaded to take on anyone else, reject.
 
           // Newer version have a specific party-full message; send that first
           // but also follow up with a generic deny message for older clients.
@@ -638,8 +752,9 @@ void ConnectionSet::HandleIncomingUDPPacket(const std::vector<uint8_t>& data_in,
           g_base->network_writer->PushSendToCall(
               {BA_PACKET_CLIENT_DENY, request_id}, addr);
 
-        } else if (connection_to_host_.exists()) {
-          // If we're connected to someone else, we can't have clients.
+        } else if (connection_to_host_.exists() && !spectator_relay_enabled_) {
+          // If we're connected to someone else, we can't have clients
+          // (unless we're relaying to spectators).
           g_base->network_writer->PushSendToCall(
               {BA_PACKET_CLIENT_DENY_ALREADY_IN_PARTY, request_id}, addr);
         } else {
@@ -685,6 +800,9 @@ void ConnectionSet::HandleIncomingUDPPacket(const std::vector<uint8_t>& data_in,
             connection_to_client = Object::New<ConnectionToClientUDP>(
                 addr, client_instance_uuid, request_id, client_id);
             connections_to_clients_[client_id] = connection_to_client;
+
+            // We may be sleeping through an idle stretch; get moving.
+            g_base->logic->WakeHeadlessDisplayTime();
           }
 
           // If we got to this point, regardless of whether
@@ -50,6 +50,24 @@ class ConnectionSet {
   }
 
   void Update();
+
+  /// Cap on total bytes per second sent out to clients (0 for no cap).
+  /// Each update, what the cap allows is split evenly between client
+  /// connections as send allowances (with any one connection's unused
+  /// share going to the others), so on a capped uplink everyone degrades
+  /// together instead of whoever happens to lose the most packets.
+  void SetUpstreamLimit(int64_t bytes_per_second);
+  auto upstream_limit() const { return upstream_limit_; }
+
+  /// When enabled, we accept client connections even while connected to a
+  /// host ourself and pass the host's session stream along to them, so
+  /// any number of spectators cost the host just our one connection.
+  /// Takes effect for the next connection to a host.
+  void set_spectator_relay_enabled(bool val) {
+    spectator_relay_enabled_ = val;
+  }
+  auto spectator_relay_enabled() const { return spectator_relay_enabled_; }
+
   void Shutdown();
   void PrepareForLaunchHostSession();
   void HandleClientDisconnected(int id);
@@ -81,6 +99,16 @@ class ConnectionSet {
                        const std::vector<int>* clients = nullptr,
                        const std::string* sender_override = nullptr);
 
+  /// Send an assembled chat message to all connected clients (or just the
+  /// ones with the given ids). The message is encoded once and shared.
+  void SendChatToClients(const std::vector<uint8_t>& message,
+                         const std::vector<int>* clients);
+
+  /// Server-wide limit on relaying chat from clients, on top of each
+  /// client's own limit, so lots of chatty clients can't add up to a flood.
+  /// Returns false if a chat message should be dropped.
+  auto AllowClientChatFanOut() -> bool;
+
   // Send a screen message to all connected clients AND print it on the host.
   void SendScreenMessageToAll(const std::string& s, float r, float g, float b);
 
@@ -100,6 +128,9 @@ class ConnectionSet {
 
  private:
   auto VerifyClientAddr(uint8_t client_id, const SockAddr& addr) -> bool;
+  void SendScreenMessage_(const std::string& s, float r, float g, float b,
+                          const std::vector<int>* clients);
+  void UpdateUpstreamBudget_();
 
   // Try to minimize the chance a garbage packet will have this id.
   int next_connection_to_client_id_{113};
@@ -114,6 +145,16 @@ class ConnectionSet {
 
   // Prevents us from printing multiple 'you got disconnected' messages.
   bool printed_host_disconnect_{};
+
+  float chat_fan_out_tokens_{};
+  millisecs_t chat_fan_out_time_{};
+
+  int64_t upstream_limit_{};
+  bool spectator_relay_enabled_{};
+  float upstream_pool_{};
+  millisecs_t upstream_time_{};
+  size_t upstream_rotation_{};
+  std::vector<ConnectionToClient*> budgeted_connections_;
 };
 
 }  // namespace ballistica::scene_v1
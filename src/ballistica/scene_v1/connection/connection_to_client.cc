@@ -20,7 +20,7 @@
 #include "ballistica/scene_v1/support/client_input_device.h"
 #include "ballistica/scene_v1/support/client_input_device_delegate.h"
 #include "ballistica/scene_v1/support/host_session.h"
-#include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_stream.h"
 #include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::scene_v1 {
@@ -105,13 +105,18 @@ void ConnectionToClient::Update() {
     // easily in the future.
     if (explicit_bool(protocol_version() >= 33)) {
       // Construct a json dict with our player-spec-string as one element.
-      JsonDict dict;
-      dict.AddString("s", our_handshake_player_spec_str_);
+      JsonWriter writer(our_handshake_player_spec_str_.size()
+                        + our_handshake_salt_.size() + 32);
+      writer.BeginObject();
+      writer.Key("s");
+      writer.String(our_handshake_player_spec_str_);
 
       // We also add our random salt for hashing.
-      dict.AddString("l", our_handshake_salt_);
+      writer.Key("l");
+      writer.String(our_handshake_salt_);
+      writer.EndObject();
 
-      std::string out = dict.PrintUnformatted();
+      const std::string& out = writer.str();
       std::vector<uint8_t> data(3 + out.size());
       data[0] = BA_SCENEPACKET_HANDSHAKE;
       uint16_t val = protocol_version();
@@ -166,22 +171,26 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
       // In newer builds we expect to be sent a json dict here;
       // pull client's spec from that.
       if (protocol_version() >= 33) {
-        std::vector<char> string_buffer(data.size() - 3 + 1);
-        memcpy(&(string_buffer[0]), &(data[3]), data.size() - 3);
-        string_buffer[string_buffer.size() - 1] = 0;
-        cJSON* handshake = cJSON_Parse(string_buffer.data());
-        if (handshake) {
-          if (cJSON* pspec = cJSON_GetObjectItem(handshake, "s")) {
-            set_peer_spec(PlayerSpec(pspec->valuestring));
-          }
-
-          // Newer builds also send their public-device-id; servers
-          // can use this to combat simple spam attacks.
-          if (cJSON* pubdeviceid = cJSON_GetObjectItem(handshake, "d")) {
-            public_device_id_ = pubdeviceid->valuestring;
-          }
-          cJSON_Delete(handshake);
-        }
+        std::string_view handshake(
+            reinterpret_cast<const char*>(data.data() + 3), data.size() - 3);
+        JsonReader::ForEachMember(
+            handshake,
+            [this](std::string_view key, const JsonReader::Value& value) {
+              if (key == "s" && value.IsString()) {
+                set_peer_spec(PlayerSpec(std::string(value.string)));
+              } else if (key == "d" && value.IsString()) {
+                // Newer builds also send their public-device-id; servers
+                // can use this to combat simple spam attacks.
+                public_device_id_ = value.string;
+              } else if (key == "c") {
+                // Newer builds can also take compact session-commands.
+                compact_session_commands_ =
+                    value.IsNumber() && value.AsInt() >= 1;
+              } else if (key == "r") {
+                // ...as well as roster deltas.
+                game_roster_deltas_ = value.IsNumber() && value.AsInt() >= 1;
+              }
+            });
       } else {
         // (KILL THIS WHEN kProtocolVersionClientMin >= 33)
         // older versions only contained the client spec
@@ -272,18 +281,18 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
         // message they get; if something else shows up first they'll assume
         // we're an old build and not sending this.
         {
-          cJSON* info_dict = cJSON_CreateObject();
-          cJSON_AddItemToObject(info_dict, "b",
-                                cJSON_CreateNumber(kEngineBuildNumber));
+          JsonWriter writer;
+          writer.BeginObject();
+          writer.Key("b");
+          writer.Number(kEngineBuildNumber);
 
           // Add a name entry if we've got a public party name set.
           if (!appmode->public_party_name().empty()) {
-            cJSON_AddItemToObject(
-                info_dict, "n",
-                cJSON_CreateString(appmode->public_party_name().c_str()));
+            writer.Key("n");
+            writer.String(appmode->public_party_name());
           }
-          std::string info = cJSON_PrintUnformatted(info_dict);
-          cJSON_Delete(info_dict);
+          writer.EndObject();
+          const std::string& info = writer.str();
 
           std::vector<uint8_t> info_msg(info.size() + 1);
           info_msg[0] = BA_MESSAGE_HOST_INFO;
@@ -335,9 +344,16 @@ void ConnectionToClient::Error(const std::string& msg) {
 
 void ConnectionToClient::SendScreenMessage(const std::string& s, float r,
                                            float g, float b) {
+  SendReliableMessage(
+      MakeScreenMessage(s, r, g, b, !SupportsScreenMessages()));
+}
+
+auto ConnectionToClient::MakeScreenMessage(const std::string& s, float r,
+                                           float g, float b, bool legacy)
+    -> Object::Ref<SharedMessage> {
   // Older clients don't support the screen-message message, so in that case
   // we just send it as a chat-message from <HOST>.
-  if (build_number() < 14248) {
+  if (legacy) {
     std::string value = g_base->assets->CompileResourceString(s);
     std::string our_spec_string =
         PlayerSpec::GetDummyPlayerSpec("<HOST>").GetSpecString();
@@ -349,16 +365,22 @@ void ConnectionToClient::SendScreenMessage(const std::string& s, float r,
     memcpy(&(msg_out[2]), our_spec_string.c_str(),
            static_cast<size_t>(spec_size));
     memcpy(&(msg_out[2 + spec_size]), value.c_str(), value.size());
-    SendReliableMessage(msg_out);
+    return Object::New<SharedMessage>(msg_out);
   } else {
-    cJSON* msg = cJSON_CreateObject();
-    cJSON_AddNumberToObject(msg, "t", BA_JMESSAGE_SCREEN_MESSAGE);
-    cJSON_AddStringToObject(msg, "m", s.c_str());
-    cJSON_AddNumberToObject(msg, "r", r);
-    cJSON_AddNumberToObject(msg, "g", g);
-    cJSON_AddNumberToObject(msg, "b", b);
-    SendJMessage(msg);
-    cJSON_Delete(msg);
+    JsonWriter writer(s.size() + 64);
+    writer.BeginObject();
+    writer.Key("t");
+    writer.Number(BA_JMESSAGE_SCREEN_MESSAGE);
+    writer.Key("m");
+    writer.String(s);
+    writer.Key("r");
+    writer.Number(r);
+    writer.Key("g");
+    writer.Number(g);
+    writer.Key("b");
+    writer.Number(b);
+    writer.EndObject();
+    return Object::New<SharedMessage>(MakeJMessage(writer.str()));
   }
 }
 
@@ -385,11 +407,11 @@ void ConnectionToClient::HandleMessagePacket(
   switch (buffer[0]) {
     case BA_MESSAGE_JMESSAGE: {
       if (buffer.size() >= 3 && buffer[buffer.size() - 1] == 0) {
-        cJSON* msg =
-            cJSON_Parse(reinterpret_cast<const char*>(buffer.data() + 1));
-        if (msg) {
-          cJSON_Delete(msg);
-        }
+        // We don't currently handle any of these from clients; just make
+        // sure they're valid.
+        JsonReader::Validate(std::string_view(
+            reinterpret_cast<const char*>(buffer.data() + 1),
+            buffer.size() - 1));
       }
       break;
     }
@@ -414,33 +436,35 @@ void ConnectionToClient::HandleMessagePacket(
         memcpy(str_buffer.data(), buffer.data() + 1, buffer.size() - 1);
         str_buffer[str_buffer.size() - 1] = 0;
 
-        cJSON* info = cJSON_Parse(str_buffer.data());
-        if (info) {
-          cJSON* b = cJSON_GetObjectItem(info, "b");
-          if (b) {
-            build_number_ = b->valueint;
-          } else {
+        bool got_build_number{};
+        bool got_token{};
+        bool valid = JsonReader::ForEachMember(
+            std::string_view(str_buffer.data(), str_buffer.size() - 1),
+            [&](std::string_view key, const JsonReader::Value& value) {
+              if (key == "b" && value.IsNumber()) {
+                build_number_ = value.AsInt();
+                got_build_number = true;
+              } else if (key == "tk" && value.IsString()) {
+                // Grab their token (we use this to ask the
+                // server for their v1 account info).
+                token_ = value.string;
+                got_token = true;
+              } else if (key == "ph" && value.IsString()) {
+                // Newer clients also pass a peer-hash, which
+                // we can include with the token to allow the
+                // v1 server to better verify the client's identity.
+                peer_hash_ = value.string;
+              }
+            });
+        if (valid) {
+          if (!got_build_number) {
             g_core->Log(LogName::kBaNetworking, LogLevel::kError,
                         "No buildnumber in clientinfo msg.");
           }
-
-          // Grab their token (we use this to ask the
-          // server for their v1 account info).
-          cJSON* t = cJSON_GetObjectItem(info, "tk");
-          if (t) {
-            token_ = t->valuestring;
-          } else {
+          if (!got_token) {
             g_core->Log(LogName::kBaNetworking, LogLevel::kError,
                         "No token in clientinfo msg.");
           }
-
-          // Newer clients also pass a peer-hash, which
-          // we can include with the token to allow the
-          // v1 server to better verify the client's identity.
-          cJSON* ph = cJSON_GetObjectItem(info, "ph");
-          if (ph) {
-            peer_hash_ = ph->valuestring;
-          }
           if (!token_.empty()) {
             // Kick off a query to the master-server for this client's info.
             // FIXME: we need to add retries for this in case of failure.
@@ -448,7 +472,6 @@ void ConnectionToClient::HandleMessagePacket(
                 token_, our_handshake_player_spec_str_ + our_handshake_salt_,
                 peer_hash_, build_number_);
           }
-          cJSON_Delete(info);
         } else {
           g_core->Log(
               LogName::kBaNetworking, LogLevel::kError,
@@ -595,16 +618,12 @@ void ConnectionToClient::HandleMessagePacket(
                 memcpy(&(msg_out[2 + spec_size]), message.c_str(),
                        message.size());
 
-                // Send it out to all clients.
-                for (auto&& i :
-                     appmode->connections()->connections_to_clients()) {
-                  if (i.second->can_communicate()) {
-                    i.second->SendReliableMessage(msg_out);
-                  }
+                // Send it out to all clients (as long as the server as a
+                // whole isn't getting flooded) and display it locally.
+                if (appmode->connections()->AllowClientChatFanOut()) {
+                  appmode->connections()->SendChatToClients(msg_out, nullptr);
+                  appmode->LocalDisplayChatMessage(msg_out);
                 }
-
-                // Display it locally.
-                appmode->LocalDisplayChatMessage(msg_out);
               }
             }
           }
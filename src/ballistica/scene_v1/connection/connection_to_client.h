@@ -29,6 +29,16 @@ class ConnectionToClient : public Connection {
   auto build_number() const -> int { return build_number_; }
   void SendScreenMessage(const std::string& s, float r = 1.0f, float g = 1.0f,
                          float b = 1.0f);
+
+  /// Build what SendScreenMessage() sends, so one copy can be shared among
+  /// many clients. Legacy is for clients too old to support screen
+  /// messages (they get a chat message instead).
+  static auto MakeScreenMessage(const std::string& s, float r, float g,
+                                float b, bool legacy)
+      -> Object::Ref<SharedMessage>;
+  auto SupportsScreenMessages() const -> bool {
+    return build_number_ >= 14248;
+  }
   auto token() const -> const std::string& { return token_; }
   void HandleMasterServerClientInfo(PyObject* info_obj);
 
@@ -50,7 +60,23 @@ class ConnectionToClient : public Connection {
     next_kick_vote_allow_time_ = val;
   }
   auto next_kick_vote_allow_time() const { return next_kick_vote_allow_time_; }
+  auto last_physics_correction_time() const {
+    return last_physics_correction_time_;
+  }
+  void set_last_physics_correction_time(millisecs_t val) {
+    last_physics_correction_time_ = val;
+  }
   auto public_device_id() const { return public_device_id_; }
+
+  /// Whether the client can take BA_MESSAGE_SESSION_COMMANDS_COMPACT.
+  auto compact_session_commands() const { return compact_session_commands_; }
+
+  /// Whether the client can take BA_MESSAGE_PARTY_ROSTER_DELTA.
+  auto game_roster_deltas() const { return game_roster_deltas_; }
+
+  /// Whether the client has been sent a full roster to apply deltas to.
+  auto got_game_roster() const { return got_game_roster_; }
+  void set_got_game_roster(bool val) { got_game_roster_ = val; }
   // Returns a spec for this client that incorporates their player names
   // or their peer name if they have no players.
   auto GetCombinedSpec() -> PlayerSpec;
@@ -76,6 +102,9 @@ class ConnectionToClient : public Connection {
   int id_{-1};
   int build_number_{};
   bool got_client_info_{};
+  bool compact_session_commands_{};
+  bool game_roster_deltas_{};
+  bool got_game_roster_{};
   bool kick_voted_{};
   bool kick_vote_choice_{};
   std::string token_;
@@ -86,6 +115,7 @@ class ConnectionToClient : public Connection {
   millisecs_t next_kick_vote_allow_time_{};
   millisecs_t chat_block_time_{};
   millisecs_t last_remove_player_time_{-99999};
+  millisecs_t last_physics_correction_time_{};
   int next_chat_block_seconds_{10};
 };
 
@@ -30,6 +30,20 @@ ConnectionToClientUDP::~ConnectionToClientUDP() {
   set_connection_dying(true);
 }
 
+void ConnectionToClientUDP::SendGamePacketUncompressed(
+    const std::vector<uint8_t>& data) {
+  // Optionally let the net-out thread do the compression for us. It builds
+  // the same packet SendGamePacketCompressed() would.
+  assert(g_base->network_writer);
+  if (!g_base->network_writer->offload_compression()) {
+    Connection::SendGamePacketUncompressed(data);
+    return;
+  }
+  std::vector<uint8_t> header{BA_PACKET_HOST_GAMEPACKET_COMPRESSED, request_id_};
+  g_base->network_writer->PushCompressAndSendToCall(
+      header, data, *addr_, offloaded_compressed_bytes());
+}
+
 void ConnectionToClientUDP::SendGamePacketCompressed(
     const std::vector<uint8_t>& data) {
   // Ok, we've got a random chunk of (possibly) compressed data to send over
@@ -26,6 +26,7 @@ class ConnectionToClientUDP : public ConnectionToClient {
   void RequestDisconnect() override;
   void Die();
   void SendDisconnectRequest();
+  void SendGamePacketUncompressed(const std::vector<uint8_t>& data) override;
   void SendGamePacketCompressed(const std::vector<uint8_t>& data) override;
   auto addr() { return *addr_; }
 
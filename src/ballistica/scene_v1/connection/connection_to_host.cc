@@ -18,7 +18,9 @@
 #include "ballistica/core/python/core_python.h"
 #include "ballistica/scene_v1/support/client_session_net.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
+#include "ballistica/scene_v1/support/session_command_codec.h"
 #include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_stream.h"
 #include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::scene_v1 {
@@ -125,14 +127,26 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
       // For server-protocol 33+ we provide json info dict.
       if (their_protocol_version >= 33) {
         // Construct a json dict with our player-spec-string as one element
-        JsonDict dict;
-        dict.AddString("s", PlayerSpec::GetAccountPlayerSpec().GetSpecString());
+        JsonWriter writer(384);
+        writer.BeginObject();
+        writer.Key("s");
+        writer.String(PlayerSpec::GetAccountPlayerSpec().GetSpecString());
 
         // Also add our public device id. Servers can
         // use this to combat spammers.
-        dict.AddString("d", g_base->platform->GetPublicDeviceUUID());
+        writer.Key("d");
+        writer.String(g_base->platform->GetPublicDeviceUUID());
 
-        std::string out = dict.PrintUnformatted();
+        // Let them know we can take compact session-commands.
+        writer.Key("c");
+        writer.Number(1);
+
+        // ...and binary roster deltas.
+        writer.Key("r");
+        writer.Number(1);
+        writer.EndObject();
+
+        const std::string& out = writer.str();
 
         std::vector<uint8_t> data2(3 + out.size());
         data2[0] = BA_SCENEPACKET_HANDSHAKE_RESPONSE;
@@ -169,23 +183,24 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
         if (their_protocol_version >= 33) {
           // In newer protocols, handshake contains a json dict
           // so we can evolve it going forward.
-          std::vector<char> string_buffer(data.size() - 3 + 1);
-          memcpy(&(string_buffer[0]), &(data[3]), data.size() - 3);
-          string_buffer[string_buffer.size() - 1] = 0;
-          cJSON* handshake = cJSON_Parse(string_buffer.data());
-          if (handshake) {
+          std::string_view handshake(
+              reinterpret_cast<const char*>(data.data() + 3), data.size() - 3);
+          std::string pspec;
+          std::string salt;
+          if (JsonReader::ForEachMember(
+                  handshake,
+                  [&](std::string_view key, const JsonReader::Value& value) {
+                    if (key == "s" && value.IsString()) {
+                      pspec = value.string;
+                    } else if (key == "l" && value.IsString()) {
+                      salt = value.string;
+                    }
+                  })) {
             // We hash this to prove that we're us; keep it around.
-            peer_hash_input_ = "";
-            cJSON* pspec = cJSON_GetObjectItem(handshake, "s");
-            if (pspec) {
-              peer_hash_input_ += pspec->valuestring;
-              set_peer_spec(PlayerSpec(pspec->valuestring));
-            }
-            cJSON* salt = cJSON_GetObjectItem(handshake, "l");
-            if (salt) {
-              peer_hash_input_ += salt->valuestring;
+            peer_hash_input_ = pspec + salt;
+            if (!pspec.empty()) {
+              set_peer_spec(PlayerSpec(pspec));
             }
-            cJSON_Delete(handshake);
           }
         } else {
           // (KILL THIS WHEN kProtocolVersionClientMin >= 33)
@@ -327,25 +342,26 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
   switch (buffer[0]) {
     case BA_MESSAGE_HOST_INFO: {
       if (buffer.size() > 1) {
-        std::vector<char> str_buffer(buffer.size());
-        memcpy(&(str_buffer[0]), &(buffer[1]), buffer.size() - 1);
-        str_buffer[str_buffer.size() - 1] = 0;
-        cJSON* info = cJSON_Parse(reinterpret_cast<const char*>(&(buffer[1])));
-        if (info) {
-          // Build number.
-          cJSON* b = cJSON_GetObjectItem(info, "b");
-          if (b) {
-            build_number_ = b->valueint;
-          } else {
+        bool got_build_number{};
+        if (JsonReader::ForEachMember(
+                std::string_view(
+                    reinterpret_cast<const char*>(buffer.data() + 1),
+                    buffer.size() - 1),
+                [&](std::string_view key, const JsonReader::Value& value) {
+                  if (key == "b" && value.IsNumber()) {
+                    // Build number.
+                    build_number_ = value.AsInt();
+                    got_build_number = true;
+                  } else if (key == "n" && value.IsString()) {
+                    // Party name.
+                    party_name_ = Utils::GetValidUTF8(
+                        std::string(value.string).c_str(), "bsmhi");
+                  }
+                })) {
+          if (!got_build_number) {
             g_core->Log(LogName::kBaNetworking, LogLevel::kError,
                         "no buildnumber in hostinfo msg");
           }
-          // Party name.
-          cJSON* n = cJSON_GetObjectItem(info, "n");
-          if (n != nullptr) {
-            party_name_ = Utils::GetValidUTF8(n->valuestring, "bsmhi");
-          }
-          cJSON_Delete(info);
         } else {
           g_core->Log(LogName::kBaNetworking, LogLevel::kError,
                       "got invalid json in hostinfo message");
@@ -370,41 +386,60 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
       break;
     }
 
+    case BA_MESSAGE_PARTY_ROSTER_DELTA: {
+      if (auto* appmode = classic::ClassicAppMode::GetActive()) {
+        try {
+          appmode->ApplyGameRosterDelta(buffer);
+        } catch (const Exception& e) {
+          g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                      std::string("Error applying roster delta: ") + e.what());
+        }
+      }
+      break;
+    }
+
     case BA_MESSAGE_JMESSAGE: {
       // High level json messages (nice and easy to expand on but not
       // especially efficient).
       if (buffer.size() >= 3 && buffer[buffer.size() - 1] == 0) {
-        cJSON* msg =
-            cJSON_Parse(reinterpret_cast<const char*>(buffer.data() + 1));
-        if (msg) {
-          cJSON* type = cJSON_GetObjectItem(msg, "t");
-          if (type != nullptr) {
-            switch (type->valueint) {
-              case BA_JMESSAGE_SCREEN_MESSAGE: {
-                std::string m;
-                float r = 1.0f;
-                float g = 1.0f;
-                float b = 1.0f;
-                if (cJSON* r_obj = cJSON_GetObjectItem(msg, "r")) {
-                  r = static_cast<float>(r_obj->valuedouble);
-                }
-                if (cJSON* g_obj = cJSON_GetObjectItem(msg, "g")) {
-                  g = static_cast<float>(g_obj->valuedouble);
-                }
-                if (cJSON* b_obj = cJSON_GetObjectItem(msg, "b")) {
-                  b = static_cast<float>(b_obj->valuedouble);
-                }
-                if (cJSON* m_obj = cJSON_GetObjectItem(msg, "m")) {
-                  m = m_obj->valuestring;
-                  ScreenMessage(m, {r, g, b});
-                }
-                break;
+        // Members can come in any order, so gather up everything we
+        // understand and then act on it.
+        int type{-1};
+        std::string m;
+        bool got_m{};
+        float r = 1.0f;
+        float g = 1.0f;
+        float b = 1.0f;
+        if (JsonReader::ForEachMember(
+                std::string_view(
+                    reinterpret_cast<const char*>(buffer.data() + 1),
+                    buffer.size() - 1),
+                [&](std::string_view key, const JsonReader::Value& value) {
+                  if (key == "t" && value.IsNumber()) {
+                    type = value.AsInt();
+                  } else if (key == "m" && value.IsString()) {
+                    m = value.string;
+                    got_m = true;
+                  } else if (value.IsNumber()) {
+                    if (key == "r") {
+                      r = static_cast<float>(value.number);
+                    } else if (key == "g") {
+                      g = static_cast<float>(value.number);
+                    } else if (key == "b") {
+                      b = static_cast<float>(value.number);
+                    }
+                  }
+                })) {
+          switch (type) {
+            case BA_JMESSAGE_SCREEN_MESSAGE: {
+              if (got_m) {
+                ScreenMessage(m, {r, g, b});
               }
-              default:
-                break;
+              break;
             }
+            default:
+              break;
           }
-          cJSON_Delete(msg);
         }
       }
       break;
@@ -552,6 +587,15 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
       break;
     }
 
+    case BA_MESSAGE_SESSION_COMMANDS_COMPACT: {
+      // Expand back to the regular form and feed that to the session.
+      if (client_session_.exists()) {
+        SessionCommandCodec::Expand(buffer, &expand_buffer_);
+        client_session_->HandleSessionMessage(expand_buffer_);
+      }
+      break;
+    }
+
     case BA_MESSAGE_SESSION_COMMANDS:
     case BA_MESSAGE_SESSION_RESET:
     case BA_MESSAGE_SESSION_DYNAMICS_CORRECTION: {
@@ -40,6 +40,7 @@ class ConnectionToHost : public Connection {
   int protocol_version_{-1};
   int build_number_{};
   millisecs_t last_ping_send_time_{};
+  std::vector<uint8_t> expand_buffer_;
   // the client-session that we're driving
   Object::WeakRef<ClientSession> client_session_;
 };
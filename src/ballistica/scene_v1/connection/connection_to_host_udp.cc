@@ -159,6 +159,20 @@ void ConnectionToHostUDP::HandleGamePacket(const std::vector<uint8_t>& buffer) {
   ConnectionToHost::HandleGamePacket(buffer);
 }
 
+void ConnectionToHostUDP::SendGamePacketUncompressed(
+    const std::vector<uint8_t>& data) {
+  // Optionally let the net-out thread do the compression for us. It builds
+  // the same packet SendGamePacketCompressed() would.
+  assert(g_base->network_writer);
+  if (!g_base->network_writer->offload_compression()) {
+    Connection::SendGamePacketUncompressed(data);
+    return;
+  }
+  std::vector<uint8_t> header{BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED, static_cast_check_fit<uint8_t>(client_id_)};
+  g_base->network_writer->PushCompressAndSendToCall(
+      header, data, *addr_, offloaded_compressed_bytes());
+}
+
 void ConnectionToHostUDP::SendGamePacketCompressed(
     const std::vector<uint8_t>& data) {
   assert(!data.empty());
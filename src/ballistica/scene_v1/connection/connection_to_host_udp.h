@@ -28,6 +28,7 @@ class ConnectionToHostUDP : public ConnectionToHost {
   auto SwitchProtocol() -> bool;
   void RequestDisconnect() override;
 
+  void SendGamePacketUncompressed(const std::vector<uint8_t>& data) override;
   void SendGamePacketCompressed(const std::vector<uint8_t>& data) override;
   void Error(const std::string& error_msg) override;
   void Die();
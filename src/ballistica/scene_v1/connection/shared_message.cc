@@ -0,0 +1,55 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/connection/shared_message.h"
+
+#include <optional>
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/base/support/huffman.h"
+#include "ballistica/shared/python/python.h"
+
+namespace ballistica::scene_v1 {
+
+SharedMessage::SharedMessage(const std::vector<uint8_t>& data) : data_(data) {
+  assert(!data_.empty());
+
+  // Splitting and encoding big messages is all C++; don't hog the GIL.
+  std::optional<Python::ScopedNativeSection> native_section;
+  if (data_.size() > kMaxSinglePacketSize) {
+    native_section.emplace();
+  }
+
+  // To allow sending messages of any size, we transparently break large
+  // messages up into BA_MESSAGE_MULTIPART messages which are transparently
+  // re-assembled on the other end.
+  if (data_.size() > kMaxSinglePacketSize) {
+    auto data_size = static_cast<uint32_t>(data_.size());
+    uint32_t part_start = 0;
+    uint32_t part_size = kMaxSinglePacketSize - 1;
+    while (true) {
+      // If this takes us to the end of the message, send a multipart-end.
+      bool last = (part_start + part_size) >= data_size;
+      if (last) {
+        part_size = data_size - part_start;
+        assert(part_size > 0);
+      }
+
+      // 1 byte type plus data
+      std::vector<uint8_t> part_message(1 + part_size);
+      part_message[0] = last ? BA_MESSAGE_MULTIPART_END : BA_MESSAGE_MULTIPART;
+      memcpy(&(part_message[1]), &(data_[part_start]), part_size);
+      parts_.push_back(Object::New<SharedMessage>(part_message));
+      if (last) {
+        return;
+      }
+      part_start += part_size;
+    }
+  }
+
+  encoded_bit_count_ = g_base->huffman->encode_bits(data_.data(), data_.size(),
+                                                    &encoded_bits_);
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,51 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_CONNECTION_SHARED_MESSAGE_H_
+#define BALLISTICA_SCENE_V1_CONNECTION_SHARED_MESSAGE_H_
+
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/shared/foundation/object.h"
+
+namespace ballistica::scene_v1 {
+
+/// An immutable, reference-counted reliable-message payload which can be
+/// shared between any number of connections. Its huffman-encoded form is
+/// computed once at creation and reused by every packet that carries it
+/// (including resends), so fanning a message out to many clients costs a
+/// single encode and a single copy of the data.
+class SharedMessage : public Object {
+ public:
+  /// Most payload we send in a single reliable-message packet; anything
+  /// larger gets transparently split into multipart messages.
+  static const size_t kMaxSinglePacketSize = 480;
+
+  explicit SharedMessage(const std::vector<uint8_t>& data);
+
+  auto data() const -> const std::vector<uint8_t>& { return data_; }
+
+  /// Huffman bit-stream for our data (see Huffman::encode_bits()). Empty
+  /// for messages that were split into parts.
+  auto encoded_bits() const -> const std::vector<uint8_t>& {
+    return encoded_bits_;
+  }
+  auto encoded_bit_count() const -> uint32_t { return encoded_bit_count_; }
+
+  /// For messages too large to send as a single packet, this contains the
+  /// BA_MESSAGE_MULTIPART / BA_MESSAGE_MULTIPART_END messages to send in
+  /// its place. Empty otherwise.
+  auto parts() const -> const std::vector<Object::Ref<SharedMessage>>& {
+    return parts_;
+  }
+
+ private:
+  std::vector<uint8_t> data_;
+  std::vector<uint8_t> encoded_bits_;
+  uint32_t encoded_bit_count_{};
+  std::vector<Object::Ref<SharedMessage>> parts_;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_CONNECTION_SHARED_MESSAGE_H_
@@ -8,6 +8,7 @@
 #include "ballistica/scene_v1/dynamics/material/material_context.h"
 #include "ballistica/shared/ballistica.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/foundation/object_pool.h"
 #include "ode/ode.h"
 
 namespace ballistica::scene_v1 {
@@ -21,6 +22,10 @@ namespace ballistica::scene_v1 {
 class Collision : public Object {
  public:
   explicit Collision(Scene* scene) : src_context(scene), dst_context(scene) {}
+
+  // These come and go constantly as things touch.
+  BA_OBJECT_POOLED(Collision);
+
   int claim_count{};  // Used when checking for out-of-date-ness.
   bool collide{true};
   int contact_count{};  // Current number of contacts.
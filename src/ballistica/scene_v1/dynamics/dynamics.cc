@@ -2,21 +2,37 @@
 
 #include "ballistica/scene_v1/dynamics/dynamics.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <cfenv>
+#include <optional>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/audio/audio_source.h"
 #include "ballistica/base/dynamics/collision_cache.h"
+#include "ballistica/base/python/support/python_context_call.h"
 #include "ballistica/core/core.h"
+#include "ballistica/core/support/thread_trace.h"
 #include "ballistica/scene_v1/assets/scene_sound.h"
 #include "ballistica/scene_v1/dynamics/collision.h"
 #include "ballistica/scene_v1/dynamics/material/material_action.h"
 #include "ballistica/scene_v1/dynamics/part.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/python/scene_v1_python.h"
 #include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/shared/foundation/job_system.h"
+#include "ballistica/shared/python/python.h"
 #include "ode/ode_collision_kernel.h"
 #include "ode/ode_collision_util.h"
 
+#if defined(__SSE__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define BA_DYNAMICS_HAVE_SSE 1
+#endif
+
 namespace ballistica::scene_v1 {
 
 // Max contacts for rigid body collisions.
@@ -66,6 +82,42 @@ void do_dBodyGetLocalFeedback(dBodyID b, dReal px, dReal py, dReal pz,
   dCROSS(result, +=, avel, p);
 }
 
+// Pins floating point state to ODE-friendly defaults for a deterministic
+// step (round-to-nearest, denormals handled normally) so results don't
+// depend on whatever mode the thread was left in; restores it after.
+class ScopedDeterministicFloatEnv {
+ public:
+  ScopedDeterministicFloatEnv() {
+    fegetenv(&saved_env_);
+    fesetround(FE_TONEAREST);
+#if BA_DYNAMICS_HAVE_SSE
+    saved_csr_ = _mm_getcsr();
+    // Clear flush-to-zero and denormals-are-zero.
+    _mm_setcsr(saved_csr_ & ~(_MM_FLUSH_ZERO_MASK | 0x0040u));
+#endif
+  }
+  ~ScopedDeterministicFloatEnv() {
+#if BA_DYNAMICS_HAVE_SSE
+    _mm_setcsr(saved_csr_);
+#endif
+    fesetenv(&saved_env_);
+  }
+
+ private:
+  std::fenv_t saved_env_{};
+#if BA_DYNAMICS_HAVE_SSE
+  unsigned int saved_csr_{};
+#endif
+};
+
+// Ordering key for a geom that depends only on scene state (unlike its
+// address or position in a space).
+static auto GeomSortKey(dGeomID g) -> std::tuple<int64_t, int, int> {
+  auto* r = static_cast<RigidBody*>(dGeomGetData(g));
+  assert(r && r->part());
+  return {r->part()->node()->id(), r->part()->id(), r->id()};
+}
+
 // Stores info about a collision needing a reset
 // (used when parts change materials).
 class Dynamics::CollisionReset_ {
@@ -93,44 +145,177 @@ class Dynamics::CollisionEvent_ {
         collision(collision_in) {}
 };
 
-class Dynamics::SrcPartCollideMap_ {
- public:
-  std::unordered_map<int, Object::Ref<Collision> > dst_part_collisions;
-};
-
-class Dynamics::DstNodeCollideMap_ {
- public:
-  std::unordered_map<int, SrcPartCollideMap_> src_parts;
-  int collideDisabled;
-  DstNodeCollideMap_() : collideDisabled(0) {}
-  ~DstNodeCollideMap_() = default;
-};
-
-class Dynamics::SrcNodeCollideMap_ {
- public:
-  std::unordered_map<int64_t, DstNodeCollideMap_> dst_nodes;
-};
+// Scrambles bits so that similar keys land in different hash slots.
+static inline auto MixBits(uint64_t val) -> uint64_t {
+  val ^= val >> 30;
+  val *= 0xbf58476d1ce4e5b9ULL;
+  val ^= val >> 27;
+  val *= 0x94d049bb133111ebULL;
+  val ^= val >> 31;
+  return val;
+}
 
 class Dynamics::Impl_ {
  public:
   explicit Impl_(Dynamics* dynamics) : dynamics_(dynamics) {}
 
-  // NOTE: we need to implement this here in an Impl class because
-  // gcc currently chokes on unordered_maps with forward-declared types,
-  // so we can't have this in our header without pushing all our map/collision
-  // types there too.
-  void HandleDisconnect(
-      const std::unordered_map<int64_t, Dynamics::SrcNodeCollideMap_>::iterator&
-          i,
-      const std::unordered_map<int64_t, Dynamics::DstNodeCollideMap_>::iterator&
-          j,
-      const std::unordered_map<int, SrcPartCollideMap_>::iterator& k,
-      const std::unordered_map<int, Object::Ref<Collision> >::iterator& l);
+  /// Identifies a collision between two parts. Always built in store
+  /// order (see IsInStoreOrder()).
+  struct CollisionKey {
+    int64_t node1;
+    int64_t node2;
+    int part1;
+    int part2;
+    auto operator==(const CollisionKey& other) const -> bool {
+      return node1 == other.node1 && node2 == other.node2
+             && part1 == other.part1 && part2 == other.part2;
+    }
+    auto Hash() const -> uint64_t {
+      return MixBits(MixBits(static_cast<uint64_t>(node1)
+                             ^ (static_cast<uint64_t>(node2) << 32))
+                     ^ (static_cast<uint32_t>(part1)
+                        | (static_cast<uint64_t>(part2) << 32)));
+    }
+  };
+
+  struct NodePairKey {
+    int64_t node1;
+    int64_t node2;
+    auto operator==(const NodePairKey& other) const -> bool {
+      return node1 == other.node1 && node2 == other.node2;
+    }
+    auto Hash() const -> uint64_t {
+      return MixBits(static_cast<uint64_t>(node1)
+                     ^ (static_cast<uint64_t>(node2) << 32));
+    }
+  };
+
+  /// State shared by all collisions between parts of the same two nodes.
+  /// Lives as long as any such collisions exist.
+  struct NodePair {
+    int collision_count{};
+    bool collide_disabled{};
+  };
+
+  /// A flat open-addressing hash table. Uses linear probing and leaves
+  /// tombstones on erase, so entries can safely be erased while
+  /// iterating. Tombstones are cleared out when the table gets rebuilt.
+  template <typename K, typename V>
+  class FlatMap {
+   public:
+    enum class SlotState : uint8_t { kEmpty, kUsed, kErased };
+    struct Slot {
+      K key{};
+      V value{};
+      SlotState state{SlotState::kEmpty};
+    };
+
+    auto size() const -> size_t { return size_; }
+
+    auto Find(const K& key) -> Slot* {
+      if (slots_.empty()) {
+        return nullptr;
+      }
+      size_t mask{slots_.size() - 1};
+      for (size_t i = key.Hash() & mask;; i = (i + 1) & mask) {
+        Slot& slot{slots_[i]};
+        if (slot.state == SlotState::kEmpty) {
+          return nullptr;
+        }
+        if (slot.state == SlotState::kUsed && slot.key == key) {
+          return &slot;
+        }
+      }
+    }
+
+    /// Return the slot for a key, adding a default value if need be. Note
+    /// that adding can rebuild the table, invalidating existing slots.
+    auto FindOrInsert(const K& key, bool* inserted) -> Slot* {
+      assert(inserted);
+      if (Slot* slot = Find(key)) {
+        *inserted = false;
+        return slot;
+      }
+      if ((size_ + erased_ + 1) * 4 > slots_.size() * 3) {
+        Rebuild_();
+      }
+      Slot* slot{FreeSlot_(key)};
+      if (slot->state == SlotState::kErased) {
+        erased_--;
+      }
+      slot->key = key;
+      slot->value = V();
+      slot->state = SlotState::kUsed;
+      size_++;
+      *inserted = true;
+      return slot;
+    }
+
+    /// Remove a slot's entry. Safe to call on the current slot from
+    /// within ForEach().
+    void Erase(Slot* slot) {
+      assert(slot && slot->state == SlotState::kUsed);
+      slot->value = V();
+      slot->state = SlotState::kErased;
+      size_--;
+      erased_++;
+    }
+
+    /// Call call(slot) for each entry. Entries must not be added while
+    /// this runs.
+    template <typename F>
+    void ForEach(const F& call) {
+      for (auto&& slot : slots_) {
+        if (slot.state == SlotState::kUsed) {
+          call(&slot);
+        }
+      }
+    }
+
+   private:
+    auto FreeSlot_(const K& key) -> Slot* {
+      size_t mask{slots_.size() - 1};
+      for (size_t i = key.Hash() & mask;; i = (i + 1) & mask) {
+        if (slots_[i].state != SlotState::kUsed) {
+          return &slots_[i];
+        }
+      }
+    }
+
+    void Rebuild_() {
+      size_t capacity{slots_.empty() ? size_t{64} : slots_.size()};
+      while ((size_ + 1) * 2 > capacity) {
+        capacity *= 2;
+      }
+      std::vector<Slot> old_slots(capacity);
+      old_slots.swap(slots_);
+      erased_ = 0;
+      for (auto&& old_slot : old_slots) {
+        if (old_slot.state == SlotState::kUsed) {
+          Slot* slot{FreeSlot_(old_slot.key)};
+          slot->key = old_slot.key;
+          slot->value = std::move(old_slot.value);
+          slot->state = SlotState::kUsed;
+        }
+      }
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_{};
+    size_t erased_{};
+  };
+
+  using CollisionMap = FlatMap<CollisionKey, Object::Ref<Collision> >;
+
+  // Queue disconnect events for a collision, tell its parts they're no
+  // longer touching, and remove it.
+  void HandleDisconnect(CollisionMap::Slot* slot);
 
  private:
   Dynamics* dynamics_{};
   // Contains in-progress collisions for current nodes.
-  std::unordered_map<int64_t, SrcNodeCollideMap_> node_collisions_;
+  CollisionMap collisions_;
+  FlatMap<NodePairKey, NodePair> node_pairs_;
   friend class Dynamics;
 };
 
@@ -197,8 +382,10 @@ void Dynamics::RemoveTrimesh(dGeomID g) {
     if ((*i) == g) {
       trimeshes_.erase(i);
 
-      // Update our collision cache.
-      collision_cache_->SetGeoms(trimeshes_);
+      // Update our collision cache (no point if it's all going away).
+      if (!scene_->tearing_down()) {
+        collision_cache_->SetGeoms(trimeshes_);
+      }
       return;
     }
   }
@@ -217,20 +404,9 @@ auto Dynamics::AreColliding_(const Part& p1_in, const Part& p2_in) -> bool {
     p2 = &p1_in;
   }
 
-  // Go down the hierarchy until we either find a missing level or
-  // find the collision.
-  auto i = impl_->node_collisions_.find(p1->node()->id());
-  if (i != impl_->node_collisions_.end()) {
-    auto j = i->second.dst_nodes.find(p2->node()->id());
-    if (j != i->second.dst_nodes.end()) {
-      auto k = j->second.src_parts.find(p1->id());
-      if (k != j->second.src_parts.end()) {
-        auto l = k->second.dst_part_collisions.find(p2->id());
-        if (l != k->second.dst_part_collisions.end()) return true;
-      }
-    }
-  }
-  return false;
+  return impl_->collisions_.Find(
+             {p1->node()->id(), p2->node()->id(), p1->id(), p2->id()})
+         != nullptr;
 }
 
 auto Dynamics::GetCollision(Part* p1_in, Part* p2_in, MaterialContext** cc1,
@@ -247,25 +423,23 @@ auto Dynamics::GetCollision(Part* p1_in, Part* p2_in, MaterialContext** cc1,
     p2 = p1_in;
   }
 
-  std::pair<std::unordered_map<int, Object::Ref<Collision> >::iterator, bool>
-      i = impl_->node_collisions_[p1->node()->id()]
-              .dst_nodes[p2->node()->id()]
-              .src_parts[p1->id()]
-              .dst_part_collisions.insert(
-                  std::make_pair(p2->id(), Object::Ref<Collision>()));
+  bool inserted{};
+  auto* slot = impl_->collisions_.FindOrInsert(
+      {p1->node()->id(), p2->node()->id(), p1->id(), p2->id()}, &inserted);
 
   Collision* new_collision;
 
   // If it didnt exist, go ahead and set up the collision.
-  if (i.second) {
-    i.first->second = Object::New<Collision>(scene_);
-    new_collision = i.first->second.get();
+  if (inserted) {
+    slot->value = Object::New<Collision>(scene_);
+    new_collision = slot->value.get();
   } else {
     new_collision = nullptr;
   }
+  Collision* collision = slot->value.get();
 
-  (*cc1) = &i.first->second->src_context;
-  (*cc2) = &i.first->second->dst_context;
+  (*cc1) = &collision->src_context;
+  (*cc2) = &collision->dst_context;
 
   // Continue setting it up.
   if (new_collision) {
@@ -281,10 +455,15 @@ auto Dynamics::GetCollision(Part* p1_in, Part* p2_in, MaterialContext** cc1,
     p2->ApplyMaterials(*cc2, p2, p1);
 
     // If either disabled collisions between these two nodes, store that.
-    DstNodeCollideMap_* dncm =
-        &impl_->node_collisions_[p1->node()->id()].dst_nodes[p2->node()->id()];
+    bool pair_inserted{};
+    Impl_::NodePair* node_pair =
+        &impl_->node_pairs_
+             .FindOrInsert({p1->node()->id(), p2->node()->id()},
+                           &pair_inserted)
+             ->value;
+    node_pair->collision_count++;
     if (!(*cc1)->node_collide || !(*cc2)->node_collide) {
-      dncm->collideDisabled = true;
+      node_pair->collide_disabled = true;
     }
 
     // Don't collide if either context doesnt want us to or if the nodes
@@ -292,7 +471,7 @@ auto Dynamics::GetCollision(Part* p1_in, Part* p2_in, MaterialContext** cc1,
     // collision status).
     new_collision->collide =
         ((*cc1)->collide && (*cc2)->collide
-         && (!dncm->collideDisabled || !(*cc1)->use_node_collide
+         && (!node_pair->collide_disabled || !(*cc1)->use_node_collide
              || !(*cc2)->use_node_collide));
 
     // If theres a physical collision involved, inform the parts
@@ -316,59 +495,59 @@ auto Dynamics::GetCollision(Part* p1_in, Part* p2_in, MaterialContext** cc1,
   }
 
   // Regardless, set it as claimed so we know its current.
-  i.first->second->claim_count++;
+  collision->claim_count++;
 
-  return &(*(i.first->second));
+  return collision;
 }
 
-void Dynamics::Impl_::HandleDisconnect(
-    const std::unordered_map<int64_t, Dynamics::SrcNodeCollideMap_>::iterator&
-        i,
-    const std::unordered_map<int64_t, Dynamics::DstNodeCollideMap_>::iterator&
-        j,
-    const std::unordered_map<int, SrcPartCollideMap_>::iterator& k,
-    const std::unordered_map<int, Object::Ref<Collision> >::iterator& l) {
+void Dynamics::Impl_::HandleDisconnect(CollisionMap::Slot* slot) {
+  const CollisionKey& key{slot->key};
+  const Object::Ref<Collision>& collision{slot->value};
+
   // Handle disconnect equivalents if they were colliding.
-  if (l->second->collide) {
+  if (collision->collide) {
     // Add the contexts' disconnect commands to be executed.
-    for (auto m = l->second->src_context.disconnect_actions.begin();
-         m != l->second->src_context.disconnect_actions.end(); m++) {
-      Part* src_part = l->second->src_part.get();
-      Part* dst_part = l->second->dst_part.get();
+    for (auto m = collision->src_context.disconnect_actions.begin();
+         m != collision->src_context.disconnect_actions.end(); m++) {
+      Part* src_part = collision->src_part.get();
+      Part* dst_part = collision->dst_part.get();
       dynamics_->collision_events_.emplace_back(
           src_part ? src_part->node() : nullptr,
-          dst_part ? dst_part->node() : nullptr, *m, l->second);
+          dst_part ? dst_part->node() : nullptr, *m, collision);
     }
 
-    for (auto m = l->second->dst_context.disconnect_actions.begin();
-         m != l->second->dst_context.disconnect_actions.end(); m++) {
-      Part* src_part = l->second->src_part.get();
-      Part* dst_part = l->second->dst_part.get();
+    for (auto m = collision->dst_context.disconnect_actions.begin();
+         m != collision->dst_context.disconnect_actions.end(); m++) {
+      Part* src_part = collision->src_part.get();
+      Part* dst_part = collision->dst_part.get();
       dynamics_->collision_events_.emplace_back(
           dst_part ? dst_part->node() : nullptr,
-          src_part ? src_part->node() : nullptr, *m, l->second);
+          src_part ? src_part->node() : nullptr, *m, collision);
     }
 
     // Now see if either of the two parts involved still exist and if they do,
     // tell them they're no longer colliding with the other.
     bool physical =
-        l->second->src_context.physical && l->second->dst_context.physical;
-    Part* p1 = l->second->dst_part.get();
-    Part* p2 = l->second->src_part.get();
+        collision->src_context.physical && collision->dst_context.physical;
+    Part* p1 = collision->dst_part.get();
+    Part* p2 = collision->src_part.get();
     if (p1) {
-      assert(p1 == l->second->dst_part.get());
-      p1->SetCollidingWith(i->first, k->first, false, physical);  // NOLINT
-    }
-    if (p2) {
-      assert(p2 == l->second->src_part.get());
+      p1->SetCollidingWith(key.node1, key.part1, false, physical);
     }
     if (p2 && (p2 != p1)) {
-      p2->SetCollidingWith(j->first, l->first, false, physical);  // NOLINT
+      p2->SetCollidingWith(key.node2, key.part2, false, physical);
+    }
+  }
+
+  // Release this collision's hold on its node pair.
+  if (auto* node_pair = node_pairs_.Find({key.node1, key.node2})) {
+    if (--node_pair->value.collision_count <= 0) {
+      node_pairs_.Erase(node_pair);
     }
   }
 
   // Remove this particular collision.
-  k->second.dst_part_collisions.erase(l);
+  collisions_.Erase(slot);
 }
 
 void Dynamics::ProcessCollision_() {
@@ -397,34 +576,16 @@ void Dynamics::ProcessCollision_() {
         p2 = collision_reset.part1;
       }
 
-      // Go down the hierarchy until we either find a missing level or
-      // find the collision to reset.
-      {
-        auto i = impl_->node_collisions_.find(n1);
-        if (i != impl_->node_collisions_.end()) {
-          auto j = i->second.dst_nodes.find(n2);
-          if (j != i->second.dst_nodes.end()) {
-            auto k = j->second.src_parts.find(p1);
-            if (k != j->second.src_parts.end()) {
-              auto l = k->second.dst_part_collisions.find(p2);
-              if (l != k->second.dst_part_collisions.end()) {
-                // They were colliding - separate them.
-                impl_->HandleDisconnect(i, j, k, l);
-              }
-
-              // Erase if none left.
-              if (k->second.dst_part_collisions.empty()) {
-                j->second.src_parts.erase(k);
-              }
-            }
-
-            // Erase if none left.
-            if (j->second.src_parts.empty()) i->second.dst_nodes.erase(j);
-          }
-
-          // Erase if none left.
-          if (i->second.dst_nodes.empty()) impl_->node_collisions_.erase(i);
+      // If they were colliding, separate them. Make sure both sides are
+      // awake so they get tested against each other again.
+      if (auto* slot = impl_->collisions_.Find({n1, n2, p1, p2})) {
+        if (Part* part = slot->value->src_part.get()) {
+          part->Wake();
+        }
+        if (Part* part = slot->value->dst_part.get()) {
+          part->Wake();
         }
+        impl_->HandleDisconnect(slot);
       }
     }
     collision_resets_.clear();
@@ -432,23 +593,34 @@ void Dynamics::ProcessCollision_() {
 
   // Reset our claim counts. When we run collision tests, claim counts
   // will be incremented for things that are still in contact.
-  for (auto& node_collision : impl_->node_collisions_) {
-    for (auto& dst_node : node_collision.second.dst_nodes) {
-      for (auto& src_part : dst_node.second.src_parts) {
-        for (auto& dst_part_collision : src_part.second.dst_part_collisions) {
-          dst_part_collision.second->claim_count = 0;
-        }
-      }
-    }
+  impl_->collisions_.ForEach(
+      [](Impl_::CollisionMap::Slot* slot) { slot->value->claim_count = 0; });
+
+  // When profiling, near-callback time gets added up as we go; whatever
+  // is left over we count as broadphase.
+  profiling_ = g_scene_v1->step_profiling_enabled();
+  microsecs_t collide_start_time{profiling_ ? g_core->AppTimeMicrosecs() : 0};
+  microsecs_t near_callback_start{
+      profiling_ ? g_scene_v1->step_profile().near_callback : 0};
+
+  if (deterministic_) {
+    CollideSorted_();
+  } else {
+    // Process all standard collisions. This will trigger our callback
+    // which do the real work (add collisions to list, store commands to
+    // be called, etc).
+    dSpaceCollide(ode_space_, this, &DoCollideCallback_);
+
+    // Collide our trimeshes against everything.
+    collision_cache_->CollideAgainstSpace(ode_space_, this,
+                                          &DoCollideCallback_);
   }
 
-  // Process all standard collisions. This will trigger our callback which
-  // do the real work (add collisions to list, store commands to be
-  // called, etc).
-  dSpaceCollide(ode_space_, this, &DoCollideCallback_);
-
-  // Collide our trimeshes against everything.
-  collision_cache_->CollideAgainstSpace(ode_space_, this, &DoCollideCallback_);
+  if (profiling_) {
+    auto& profile{g_scene_v1->step_profile()};
+    profile.broadphase += g_core->AppTimeMicrosecs() - collide_start_time
+                          - (profile.near_callback - near_callback_start);
+  }
 
   // Do a bit of precalc each cycle.
   collision_cache_->Precalc();
@@ -457,43 +629,32 @@ void Dynamics::ProcessCollision_() {
   // setting parts' currently-colliding-with lists
   // based on current info,
   // removing unclaimed collisions and empty groups.
-  std::unordered_map<int64_t, SrcNodeCollideMap_>::iterator i_next;
-  std::unordered_map<int64_t, DstNodeCollideMap_>::iterator j_next;
-  std::unordered_map<int, SrcPartCollideMap_>::iterator k_next;
-  std::unordered_map<int, Object::Ref<Collision> >::iterator l_next;
-  for (auto i = impl_->node_collisions_.begin();
-       i != impl_->node_collisions_.end(); i = i_next) {
-    i_next = i;
-    i_next++;
-    for (auto j = i->second.dst_nodes.begin(); j != i->second.dst_nodes.end();
-         j = j_next) {
-      j_next = j;
-      j_next++;
-      for (auto k = j->second.src_parts.begin(); k != j->second.src_parts.end();
-           k = k_next) {
-        k_next = k;
-        k_next++;
-        for (auto l = k->second.dst_part_collisions.begin();
-             l != k->second.dst_part_collisions.end(); l = l_next) {
-          l_next = l;
-          l_next++;
-
-          // Not claimed; separating.
-          if (!l->second->claim_count) {
-            impl_->HandleDisconnect(i, j, k, l);
+  if (deterministic_) {
+    // Table order depends on insertion history; go by key instead.
+    std::vector<Impl_::CollisionMap::Slot*> separating;
+    impl_->collisions_.ForEach(
+        [&separating](Impl_::CollisionMap::Slot* slot) {
+          if (!slot->value->claim_count) {
+            separating.push_back(slot);
           }
-        }
-        if (k->second.dst_part_collisions.empty()) {
-          j->second.src_parts.erase(k);
-        }
-      }
-      if (j->second.src_parts.empty()) {
-        i->second.dst_nodes.erase(j);
-      }
-    }
-    if (i->second.dst_nodes.empty()) {
-      impl_->node_collisions_.erase(i);
+        });
+    std::sort(separating.begin(), separating.end(),
+              [](Impl_::CollisionMap::Slot* a, Impl_::CollisionMap::Slot* b) {
+                return std::tie(a->key.node1, a->key.part1, a->key.node2,
+                                a->key.part2)
+                       < std::tie(b->key.node1, b->key.part1, b->key.node2,
+                                  b->key.part2);
+              });
+    for (auto* slot : separating) {
+      impl_->HandleDisconnect(slot);
     }
+  } else {
+    impl_->collisions_.ForEach([this](Impl_::CollisionMap::Slot* slot) {
+      // Not claimed; separating.
+      if (!slot->value->claim_count) {
+        impl_->HandleDisconnect(slot);
+      }
+    });
   }
 
   // We're now done processing collisions - its now safe to reset
@@ -501,28 +662,307 @@ void Dynamics::ProcessCollision_() {
   processing_collisions_ = false;
 
   // Execute all events that we built up due to collisions.
+  if (profiling_) {
+    ExecuteCollisionEventsProfiled_();
+  } else {
+    for (auto&& i : collision_events_) {
+      active_collision_ = i.collision.get();
+      active_collide_src_node_ = i.node1;
+      active_collide_dst_node_ = i.node2;
+      i.action->Execute(i.node1.get(), i.node2.get(), scene_);
+    }
+  }
+  active_collision_ = nullptr;
+  collision_events_.clear();
+  sent_collide_messages_.clear();
+
+  if (!queued_python_calls_.empty()) {
+    microsecs_t dispatch_start_time{profiling_ ? g_core->AppTimeMicrosecs()
+                                               : 0};
+    DispatchQueuedPythonCalls_();
+    if (profiling_) {
+      // The actions themselves already got counted; just add the time.
+      auto& profile{g_scene_v1->step_profile()};
+      auto type{static_cast<size_t>(MaterialAction::Type::SCRIPT_CALL)};
+      if (type >= profile.material_action_types.size()) {
+        profile.material_action_types.resize(type + 1);
+      }
+      microsecs_t duration{g_core->AppTimeMicrosecs() - dispatch_start_time};
+      profile.material_action_types[type].microsecs += duration;
+      profile.material_actions += duration;
+    }
+  }
+}
+
+void Dynamics::QueuePythonCall(base::PythonContextCall* call) {
+  assert(call);
+  assert(active_collision_ && in_collide_message_);
+  Collision* c{active_collision_};
+  auto node_obj = [](Node* node) -> PyObject* {
+    if (node) {
+      return node->NewPyRef();
+    }
+    Py_RETURN_NONE;
+  };
+  auto info{PythonRef::Stolen(Py_BuildValue(
+      "((fff)NNi)", c->x, c->y, c->z, node_obj(GetActiveCollideSrcNode()),
+      node_obj(GetActiveCollideDstNode()),
+      collide_message_reverse_order_ ? c->body_id_2 : c->body_id_1))};
+  queued_python_calls_.emplace_back(call, info);
+}
+
+auto Dynamics::ClaimCollideMessage(Node* target_node, Node* opposing_node,
+                                   PyObject* message) -> bool {
+  assert(target_node && opposing_node);
+  return sent_collide_messages_
+      .emplace(target_node->id(), opposing_node->id(), message)
+      .second;
+}
+
+void Dynamics::DispatchQueuedPythonCalls_() {
+  assert(g_base->InLogicThread());
+  auto calls{std::move(queued_python_calls_)};
+  queued_python_calls_.clear();
+  const PythonRef& dispatch_call{g_scene_v1->python->objs().Get(
+      SceneV1Python::ObjID::kDispatchCollisionBatchCall)};
+
+  // Consecutive calls sharing a context go out together (generally that
+  // is all of them, since they come from the same scene).
+  size_t begin{};
+  while (begin < calls.size()) {
+    const base::ContextRef& context{calls[begin].first->context_state()};
+    size_t end{begin + 1};
+    while (end < calls.size() && calls[end].first->context_state() == context) {
+      ++end;
+    }
+    if (!context.IsExpired()) {
+      auto events{PythonRef::Stolen(PyList_New(0))};
+      for (size_t i = begin; i < end; ++i) {
+        // Calls get cleared out when their context dies.
+        auto& call{calls[i].first};
+        if (!call->exists()) {
+          continue;
+        }
+        auto event{PythonRef::Stolen(Py_BuildValue(
+            "(OO)", call->object().get(), calls[i].second.get()))};
+        PyList_Append(events.get(), event.get());
+      }
+      base::ScopedSetContext ssc(context);
+      dispatch_call.Call(
+          PythonRef::Stolen(Py_BuildValue("(O)", events.get())));
+    }
+    begin = end;
+  }
+}
+
+void Dynamics::ExecuteCollisionEventsProfiled_() {
+  auto& profile{g_scene_v1->step_profile()};
+  microsecs_t start_time{g_core->AppTimeMicrosecs()};
+  microsecs_t last_time{start_time};
   for (auto&& i : collision_events_) {
     active_collision_ = i.collision.get();
     active_collide_src_node_ = i.node1;
     active_collide_dst_node_ = i.node2;
     i.action->Execute(i.node1.get(), i.node2.get(), scene_);
+    microsecs_t now{g_core->AppTimeMicrosecs()};
+    auto type{static_cast<size_t>(i.action->GetType())};
+    if (type >= profile.material_action_types.size()) {
+      profile.material_action_types.resize(type + 1);
+    }
+    profile.material_action_types[type].count++;
+    profile.material_action_types[type].microsecs += now - last_time;
+    last_time = now;
   }
-  active_collision_ = nullptr;
-  collision_events_.clear();
+  profile.material_actions += last_time - start_time;
+}
+
+// Island runner for dWorldQuickStepParallel(); islands are independent
+// so we just spread them across the job system.
+static void RunODEIslands(void* runner_data, int island_count,
+                          void (*step_island)(void* context, int island),
+                          void* context) {
+  g_core->job_system->ParallelFor(
+      static_cast<size_t>(island_count), 1,
+      [step_island, context](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          step_island(context, static_cast<int>(i));
+        }
+      });
 }
 
 void Dynamics::Process() {
+  BA_TRACE_SCOPE("Dynamics::Process");
   in_process_ = true;
+  microsecs_t start_time = g_core->AppTimeMicrosecs();
   // Update this once so we can recycle results.
-  real_time_ = g_core->AppTimeMillisecs();
+  real_time_ = start_time / 1000;
+
+  std::optional<ScopedDeterministicFloatEnv> float_env;
+  if (deterministic_) {
+    float_env.emplace();
+
+    // Quickstep's constraint shuffling starts from the global seed; don't
+    // let anything else that touched it leak into our results.
+    dRandSetSeed(5432);
+  }
+  if (scene_->render_interpolation()) {
+    StoreRenderStates_();
+  }
   ProcessCollision_();
-  dWorldQuickStep(ode_world_, kGameStepSeconds);
-  dJointGroupEmpty(ode_contact_group_);
+  microsecs_t step_start_time{profiling_ ? g_core->AppTimeMicrosecs() : 0};
+
+  // The solve itself is pure ODE; let other Python threads run meanwhile.
+  // (Collision processing above can call into Python so it stays out.)
+  {
+    Python::ScopedNativeSection native_section;
+
+    // Worker threads wouldn't share our pinned float state, so
+    // deterministic stepping always solves islands serially.
+    if (parallel_islands_ && !deterministic_ && g_core->job_system) {
+      dWorldQuickStepParallel(ode_world_, kGameStepSeconds, RunODEIslands,
+                              nullptr);
+    } else {
+      dWorldQuickStep(ode_world_, kGameStepSeconds);
+    }
+    dJointGroupEmpty(ode_contact_group_);
+  }
+  microsecs_t end_time{g_core->AppTimeMicrosecs()};
+  if (profiling_) {
+    g_scene_v1->step_profile().world_step += end_time - step_start_time;
+  }
+  process_time_microsecs_ += end_time - start_time;
   in_process_ = false;
 }
 
+void Dynamics::StoreRenderStates_() {
+  // Each body's first geom stands in for the body.
+  int count = dSpaceGetNumGeoms(ode_space_);
+  for (int i = 0; i < count; ++i) {
+    dGeomID geom = dSpaceGetGeom(ode_space_, i);
+    auto* body = static_cast<RigidBody*>(dGeomGetData(geom));
+    if (body && body->type() == RigidBody::Type::kBody
+        && body->geom() == geom) {
+      body->StoreRenderState();
+    }
+  }
+}
+
+void Dynamics::SetBroadphase(Broadphase val) {
+  BA_PRECONDITION(!in_process_);
+  dSpaceID new_space = CreateSpace_(val);
+  assert(new_space);
+
+  // Move everything over from our old space. Grab the list first since
+  // removing shuffles indices.
+  if (ode_space_) {
+    std::vector<dGeomID> geoms(
+        static_cast<size_t>(dSpaceGetNumGeoms(ode_space_)));
+    for (size_t i = 0; i < geoms.size(); ++i) {
+      geoms[i] = dSpaceGetGeom(ode_space_, static_cast<int>(i));
+    }
+    for (auto&& geom : geoms) {
+      dSpaceRemove(ode_space_, geom);
+      dSpaceAdd(new_space, geom);
+    }
+    dSpaceDestroy(ode_space_);
+  }
+  ode_space_ = new_space;
+  broadphase_ = val;
+}
+
+auto Dynamics::CreateSpace_(Broadphase broadphase) -> dSpaceID {
+  switch (broadphase) {
+    case Broadphase::kHash:
+      return dHashSpaceCreate(nullptr);
+    case Broadphase::kSimple:
+      return dSimpleSpaceCreate(nullptr);
+    case Broadphase::kQuadTree: {
+      // Note that ODE's quad-tree always splits on x and y.
+      const float* bounds_min = scene_->bounds_min();
+      const float* bounds_max = scene_->bounds_max();
+      dVector3 center;
+      dVector3 extents;
+      for (int i = 0; i < 3; ++i) {
+        center[i] = (bounds_min[i] + bounds_max[i]) * 0.5f;
+        extents[i] = (bounds_max[i] - bounds_min[i]) * 0.5f;
+      }
+      center[3] = extents[3] = 0.0f;
+      return dQuadTreeSpaceCreate(nullptr, center, extents, 5);
+    }
+    case Broadphase::kSweepAndPrune:
+      // Our arenas are mostly flat, so sort on x and z before y.
+      return dSweepAndPruneSpaceCreate(nullptr, dSAP_AXES_XZY);
+  }
+  throw Exception();
+}
+
+auto Dynamics::BroadphaseFromString(const std::string& val) -> Broadphase {
+  if (val == "hash") {
+    return Broadphase::kHash;
+  } else if (val == "simple") {
+    return Broadphase::kSimple;
+  } else if (val == "quadtree") {
+    return Broadphase::kQuadTree;
+  } else if (val == "sap") {
+    return Broadphase::kSweepAndPrune;
+  }
+  throw Exception("Invalid broadphase: '" + val
+                  + R"('; expected "hash", "simple", "quadtree", or "sap")");
+}
+
+auto Dynamics::BroadphaseToString(Broadphase val) -> std::string {
+  switch (val) {
+    case Broadphase::kHash:
+      return "hash";
+    case Broadphase::kSimple:
+      return "simple";
+    case Broadphase::kQuadTree:
+      return "quadtree";
+    case Broadphase::kSweepAndPrune:
+      return "sap";
+  }
+  throw Exception();
+}
+
+void Dynamics::DoCollectCollidePair_(void* data, dGeomID o1, dGeomID o2) {
+  auto* d = static_cast<Dynamics*>(data);
+  if (GeomSortKey(o2) < GeomSortKey(o1)) {
+    std::swap(o1, o2);
+  }
+  d->collide_pairs_.emplace_back(o1, o2);
+}
+
+void Dynamics::CollideSorted_() {
+  // Gather all potentially-colliding pairs first and then run them in an
+  // order based purely on scene state, since contact creation order feeds
+  // into the solver.
+  collide_pairs_.clear();
+  dSpaceCollide(ode_space_, this, &DoCollectCollidePair_);
+  collision_cache_->CollideAgainstSpace(ode_space_, this,
+                                        &DoCollectCollidePair_);
+  std::sort(collide_pairs_.begin(), collide_pairs_.end(),
+            [](const std::pair<dGeomID, dGeomID>& a,
+               const std::pair<dGeomID, dGeomID>& b) {
+              return std::make_pair(GeomSortKey(a.first),
+                                    GeomSortKey(a.second))
+                     < std::make_pair(GeomSortKey(b.first),
+                                      GeomSortKey(b.second));
+            });
+  for (auto&& pair : collide_pairs_) {
+    DoCollideCallback_(this, pair.first, pair.second);
+  }
+  collide_pairs_.clear();
+}
+
 void Dynamics::DoCollideCallback_(void* data, dGeomID o1, dGeomID o2) {
   auto* d = static_cast<Dynamics*>(data);
+  if (d->profiling_) {
+    microsecs_t start_time{g_core->AppTimeMicrosecs()};
+    d->CollideCallback_(o1, o2);
+    g_scene_v1->step_profile().near_callback +=
+        g_core->AppTimeMicrosecs() - start_time;
+    return;
+  }
   d->CollideCallback_(o1, o2);
 }
 
@@ -539,9 +979,12 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
   assert(r1 && r2);
 
   // If both of these guys are either terrain (a trimesh) or an inactive body,
-  // we can skip actually testing for a collision.
-  if ((dGeomGetClass(o1) == dTriMeshClass && b2 && !dBodyIsEnabled(b2))
-      || (dGeomGetClass(o2) == dTriMeshClass && b1 && !dBodyIsEnabled(b1))) {
+  // we can skip actually testing for a collision. Sleeping bodies don't
+  // move, so nothing about their contact can have changed; anything that
+  // does move them (forces, teleports, material changes) wakes them.
+  bool resting1{b1 ? !dBodyIsEnabled(b1) : dGeomGetClass(o1) == dTriMeshClass};
+  bool resting2{b2 ? !dBodyIsEnabled(b2) : dGeomGetClass(o2) == dTriMeshClass};
+  if (resting1 && resting2) {
     // We do, however, need to poke any existing collision so a disconnect event
     // doesn't occur if we were colliding.
     Part* p1_in = r1->part();
@@ -558,21 +1001,9 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
       p1 = p2_in;
       p2 = p1_in;
     }
-    auto i = impl_->node_collisions_.find(p1->node()->id());
-    if (i != impl_->node_collisions_.end()) {
-      auto j = i->second.dst_nodes.find(p2->node()->id());
-      if (j != i->second.dst_nodes.end()) {
-        auto k = j->second.src_parts.find(p1->id());
-        if (k != j->second.src_parts.end()) {
-          auto l = k->second.dst_part_collisions.find(p2->id());
-          if (l != k->second.dst_part_collisions.end()) {
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "UnusedValue"
-            l->second->claim_count++;
-#pragma clang diagnostic pop
-          }
-        }
-      }
+    if (auto* slot = impl_->collisions_.Find(
+            {p1->node()->id(), p2->node()->id(), p1->id(), p2->id()})) {
+      slot->value->claim_count++;
     }
     return;
   }
@@ -1135,7 +1566,7 @@ void Dynamics::ResetODE_() {
   dWorldSetAutoDisableSteps(ode_world_, 10);
   dWorldSetAutoDisableTime(ode_world_, 0);
   dWorldSetQuickStepNumIterations(ode_world_, 10);
-  ode_space_ = dHashSpaceCreate(nullptr);
+  ode_space_ = CreateSpace_(broadphase_);
   assert(ode_space_);
   ode_contact_group_ = dJointGroupCreate(0);
   assert(ode_contact_group_);
@@ -4,17 +4,25 @@
 #define BALLISTICA_SCENE_V1_DYNAMICS_DYNAMICS_H_
 
 #include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/base.h"
 #include "ballistica/scene_v1/scene_v1.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/python/python_ref.h"
 #include "ode/ode.h"
 
 namespace ballistica::scene_v1 {
 
 class Dynamics : public Object {
  public:
+  /// Broadphase schemes available for our ODE space.
+  enum class Broadphase { kHash, kSimple, kQuadTree, kSweepAndPrune };
+
   explicit Dynamics(Scene* scene);
   ~Dynamics() override;
   void Draw(base::FrameDef* frame_def);  // Draw any debug stuff, etc.
@@ -69,6 +77,59 @@ class Dynamics : public Object {
   void AddTrimesh(dGeomID g);
   void RemoveTrimesh(dGeomID g);
 
+  /// Switch our ODE space to a different broadphase, moving all existing
+  /// geoms over to it. The quad-tree broadphase is built from the scene's
+  /// current map bounds, so this can also be called to rebuild it after
+  /// those change.
+  void SetBroadphase(Broadphase val);
+  auto broadphase() const { return broadphase_; }
+  static auto BroadphaseFromString(const std::string& val) -> Broadphase;
+  static auto BroadphaseToString(Broadphase val) -> std::string;
+
+  /// When enabled, independent contact islands are solved in parallel on
+  /// the job system. Results are identical to serial stepping.
+  auto parallel_islands() const { return parallel_islands_; }
+  void set_parallel_islands(bool val) { parallel_islands_ = val; }
+
+  /// When enabled, Python material callbacks are queued as collision
+  /// events run and then handed to Python in a single call at the end of
+  /// collision processing, in the same order and contexts they would
+  /// otherwise have run in.
+  auto batch_python_calls() const { return batch_python_calls_; }
+  void set_batch_python_calls(bool val) { batch_python_calls_ = val; }
+
+  /// Add a call to the current batch along with a snapshot of the active
+  /// collision; bascenev1.getcollision() reports that snapshot while the
+  /// call runs.
+  void QueuePythonCall(base::PythonContextCall* call);
+
+  /// When enabled, a material user-message sent to the same node on
+  /// behalf of the same opposing node more than once in a step (such as
+  /// a blast touching several parts of a character) is only delivered the
+  /// first time. Only appropriate when message handlers don't care how
+  /// many parts are touching, which is the case for damage-style hits.
+  auto coalesce_collide_messages() const { return coalesce_collide_messages_; }
+  void set_coalesce_collide_messages(bool val) {
+    coalesce_collide_messages_ = val;
+  }
+
+  /// Returns true if a message should go out under the above rules (and
+  /// notes that it has been sent this step).
+  auto ClaimCollideMessage(Node* target_node, Node* opposing_node,
+                           PyObject* message) -> bool;
+
+  /// When enabled, stepping avoids everything that could make results
+  /// depend on more than the simulation state itself and its inputs:
+  /// floating point modes are pinned for the step, islands are solved
+  /// serially, and collision pairs and disconnects are handled in sorted
+  /// order instead of broadphase/hash-table order. Costs a bit of speed;
+  /// intended as groundwork for input-only lockstep or rollback play.
+  auto deterministic() const { return deterministic_; }
+  void set_deterministic(bool val) { deterministic_ = val; }
+
+  /// Total time spent in Process() over our lifetime.
+  auto process_time_microsecs() const { return process_time_microsecs_; }
+
   auto collision_count() const { return collision_count_; }
   auto process_real_time() const { return real_time_; }
   auto last_impact_sound_time() const { return last_impact_sound_time_; }
@@ -76,9 +137,6 @@ class Dynamics : public Object {
 
  private:
   auto AreColliding_(const Part& p1, const Part& p2) -> bool;
-  class SrcNodeCollideMap_;
-  class DstNodeCollideMap_;
-  class SrcPartCollideMap_;
   class CollisionEvent_;
   class CollisionReset_;
   class Impl_;
@@ -90,11 +148,20 @@ class Dynamics : public Object {
                     MaterialContext** cc2) -> Collision*;
 
   std::vector<CollisionEvent_> collision_events_;
+  std::vector<std::pair<Object::Ref<base::PythonContextCall>, PythonRef>>
+      queued_python_calls_;
+  std::set<std::tuple<int64_t, int64_t, PyObject*>> sent_collide_messages_;
   void ResetODE_();
+  auto CreateSpace_(Broadphase broadphase) -> dSpaceID;
   void ShutdownODE_();
   static void DoCollideCallback_(void* data, dGeomID o1, dGeomID o2);
+  static void DoCollectCollidePair_(void* data, dGeomID o1, dGeomID o2);
+  void CollideSorted_();
   void CollideCallback_(dGeomID o1, dGeomID o2);
   void ProcessCollision_();
+  void StoreRenderStates_();
+  void ExecuteCollisionEventsProfiled_();
+  void DispatchQueuedPythonCalls_();
 
   int skid_sound_count_{};
   int roll_sound_count_{};
@@ -103,16 +170,24 @@ class Dynamics : public Object {
   bool in_collide_message_{};
   bool collide_message_reverse_order_{};
   bool processing_collisions_{};
+  bool parallel_islands_{};
+  bool batch_python_calls_{};
+  bool coalesce_collide_messages_{};
+  bool deterministic_{};
+  bool profiling_{};
   dWorldID ode_world_{};
   dJointGroupID ode_contact_group_{};
   dSpaceID ode_space_{};
+  Broadphase broadphase_{Broadphase::kHash};
   millisecs_t real_time_{};
+  microsecs_t process_time_microsecs_{};
   millisecs_t last_impact_sound_time_{};
   Scene* scene_{};
   Collision* active_collision_{};
   Object::WeakRef<Node> active_collide_src_node_;
   Object::WeakRef<Node> active_collide_dst_node_;
   std::vector<dGeomID> trimeshes_;
+  std::vector<std::pair<dGeomID, dGeomID>> collide_pairs_;
   std::unique_ptr<Impl_> impl_;
   std::unique_ptr<base::CollisionCache> collision_cache_;
 };
@@ -6,15 +6,25 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "ballistica/scene_v1/dynamics/material/material_component.h"
+#include "ballistica/scene_v1/dynamics/part.h"
 #include "ballistica/scene_v1/support/scene.h"
 #include "ballistica/scene_v1/support/session_stream.h"
 
 namespace ballistica::scene_v1 {
 
+// Cap on cached static condition results per material; these are cheap to
+// rebuild so we just start over if this gets hit.
+const size_t kMaxMaterialStaticResults{256};
+
+static int64_t g_next_material_uid{};
+
 Material::Material(std::string name_in, Scene* scene)
-    : label_(std::move(name_in)), scene_(scene) {
+    : label_(std::move(name_in)),
+      scene_(scene),
+      uid_(g_next_material_uid++) {
   // If we're being made in a scene with an output stream,
   // write ourself to it.
   assert(scene);
@@ -28,6 +38,8 @@ void Material::MarkDead() {
     return;
   }
   components_.clear();
+  static_results_.clear();
+  has_static_components_ = false;
 
   // If we're in a scene with an output-stream, inform them of our demise.
   Scene* scene = scene_.get();
@@ -53,21 +65,69 @@ Material::~Material() { MarkDead(); }
 
 void Material::Apply(MaterialContext* s, const Part* src_part,
                      const Part* dst_part) {
+  // Components with static conditions depend only on the opposing part's
+  // materials, so we look those results up instead of evaluating them.
+  const StaticResults_* static_results{};
+  if (has_static_components_) {
+    static_results = &GetStaticResults_(*s, src_part, dst_part);
+  }
+
   // Apply all applicable components to the context.
-  for (auto& component : components_) {
-    if (component->eval_conditions(component->conditions, *this, src_part,
-                                   dst_part, *s)) {
+  for (size_t i = 0; i < components_.size(); ++i) {
+    auto& component{components_[i]};
+    bool passes = component->conditions_static()
+                      ? (*static_results)[i] != 0
+                      : component->EvalConditions(*this, src_part, dst_part,
+                                                  *s);
+    if (passes) {
       component->Apply(s, src_part, dst_part);
     }
   }
 }
 
+auto Material::GetStaticResults_(const MaterialContext& s,
+                                 const Part* src_part, const Part* dst_part)
+    -> const StaticResults_& {
+  const std::vector<int64_t>& key{dst_part->material_uids()};
+  auto i = static_results_.find(key);
+  if (i != static_results_.end()) {
+    return i->second;
+  }
+  if (static_results_.size() >= kMaxMaterialStaticResults) {
+    static_results_.clear();
+  }
+  StaticResults_ results(components_.size());
+  for (size_t j = 0; j < components_.size(); ++j) {
+    if (components_[j]->conditions_static()) {
+      results[j] =
+          components_[j]->EvalConditions(*this, src_part, dst_part, s);
+    }
+  }
+  return static_results_[key] = std::move(results);
+}
+
+auto Material::MaterialSetHash_::operator()(
+    const std::vector<int64_t>& vals) const -> size_t {
+  size_t hash{vals.size()};
+  for (auto&& val : vals) {
+    hash ^= std::hash<int64_t>()(val) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
 void Material::AddComponent(const Object::Ref<MaterialComponent>& c) {
   // If there's an output stream, push this to that first
   if (SessionStream* output_stream = scene()->GetSceneStream()) {
     output_stream->AddMaterialComponent(this, c.get());
   }
+  c->CompileConditions();
   components_.push_back(c);
+
+  // Cached results no longer cover all our components.
+  static_results_.clear();
+  if (c->conditions_static()) {
+    has_static_components_ = true;
+  }
 }
 
 void Material::DumpComponents(SessionStream* out) {
@@ -4,6 +4,7 @@
 #define BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_MATERIAL_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/scene_v1/scene_v1.h"
@@ -27,6 +28,10 @@ class Material : public Object {
   /// Apply the material to a context_ref.
   void Apply(MaterialContext* s, const Part* src_part, const Part* dst_part);
   auto label() const -> const std::string& { return label_; }
+
+  /// A process-wide unique id for this material. Unlike pointers, these
+  /// are never reused.
+  auto uid() const -> int64_t { return uid_; }
   auto NewPyRef() -> PyObject* { return GetPyRef(true); }
   auto BorrowPyRef() -> PyObject* { return GetPyRef(false); }
   void MarkDead();
@@ -50,9 +55,22 @@ class Material : public Object {
   int64_t stream_id_{-1};
   Object::WeakRef<Scene> scene_;
   PyObject* py_object_{};
+  struct MaterialSetHash_ {
+    auto operator()(const std::vector<int64_t>& vals) const -> size_t;
+  };
+  using StaticResults_ = std::vector<uint8_t>;
   auto GetPyRef(bool new_ref = true) -> PyObject*;
+  auto GetStaticResults_(const MaterialContext& s, const Part* src_part,
+                         const Part* dst_part) -> const StaticResults_&;
+  int64_t uid_{};
+  bool has_static_components_{};
   std::string label_;
   std::vector<Object::Ref<MaterialComponent> > components_;
+
+  // Results for our components with static conditions, keyed by opposing
+  // parts' material uids.
+  std::unordered_map<std::vector<int64_t>, StaticResults_, MaterialSetHash_>
+      static_results_;
   friend class ClientSession;
 };
 
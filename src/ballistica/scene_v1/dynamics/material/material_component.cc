@@ -2,6 +2,7 @@
 
 #include "ballistica/scene_v1/dynamics/material/material_component.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "ballistica/scene_v1/dynamics/material/impact_sound_material_action.h"
@@ -28,97 +29,169 @@ MaterialComponent::MaterialComponent(
 
 MaterialComponent::~MaterialComponent() {}
 
-auto MaterialComponent::eval_conditions(
-    const Object::Ref<MaterialConditionNode>& condition, const Material& c,
-    const Part* part, const Part* opposing_part, const MaterialContext& s)
-    -> bool {
-  // If there's no condition, succeed.
-  if (!condition.exists()) {
-    return true;
+void MaterialComponent::CompileConditions() {
+  condition_ops_.clear();
+  conditions_static_ = true;
+  size_t max_depth{};
+  if (conditions.exists()) {
+    CompileCondition_(*conditions, 0, &max_depth);
   }
+  eval_stack_.resize(max_depth);
+  conditions_compiled_ = true;
+}
 
-  // If we're a leaf node, evaluate.
-  if (condition->opmode == MaterialConditionNode::OpMode::LEAF_NODE) {
-    switch (condition->cond) {
+void MaterialComponent::CompileCondition_(const MaterialConditionNode& node,
+                                          size_t depth, size_t* max_depth) {
+  if (node.opmode == MaterialConditionNode::OpMode::LEAF_NODE) {
+    ConditionOp_ op;
+    op.opmode = node.opmode;
+    op.cond = node.cond;
+    op.val1 = node.val1;
+    op.val1_material = node.val1_material.get();
+    condition_ops_.push_back(op);
+    *max_depth = std::max(*max_depth, depth + 1);
+    switch (node.cond) {
       case MaterialCondition::kTrue:
-        return true;
       case MaterialCondition::kFalse:
-        return false;
       case MaterialCondition::kDstIsMaterial:
-        return (
-            (opposing_part->ContainsMaterial(condition->val1_material.get())));
       case MaterialCondition::kDstNotMaterial:
-        return (
-            !(opposing_part->ContainsMaterial(condition->val1_material.get())));
-      case MaterialCondition::kDstIsPart:
-        return ((opposing_part->id() == condition->val1));
-      case MaterialCondition::kDstNotPart:
-        return opposing_part->id() != condition->val1;
       case MaterialCondition::kSrcDstSameMaterial:
-        return ((opposing_part->ContainsMaterial(&c)));
       case MaterialCondition::kSrcDstDiffMaterial:
-        return (!(opposing_part->ContainsMaterial(&c)));
-      case MaterialCondition::kSrcDstSameNode:
-        return ((opposing_part->node() == part->node()));
-      case MaterialCondition::kSrcDstDiffNode:
-        return opposing_part->node() != part->node();
-      case MaterialCondition::kSrcYoungerThan:
-        return part->GetAge() < condition->val1;
-      case MaterialCondition::kSrcOlderThan:
-        return ((part->GetAge() >= condition->val1));
-      case MaterialCondition::kDstYoungerThan:
-        return opposing_part->GetAge() < condition->val1;
-      case MaterialCondition::kDstOlderThan:
-        return ((opposing_part->GetAge() >= condition->val1));
-      case MaterialCondition::kCollidingDstNode:
-        return (part->IsCollidingWith(opposing_part->node()->id()));
-      case MaterialCondition::kNotCollidingDstNode:
-        return (!(part->IsCollidingWith(opposing_part->node()->id())));
-      case MaterialCondition::kEvalColliding:
-        return s.collide && s.node_collide;
-      case MaterialCondition::kEvalNotColliding:
-        return (!s.collide || !s.node_collide);
-      default:
-        throw Exception();
-    }
-  } else {
-    // A trunk node; eval our left and right children and return
-    // the boolean operation between them.
-    assert(condition->left_child.exists());
-    assert(condition->right_child.exists());
-
-    bool left_result =
-        eval_conditions(condition->left_child, c, part, opposing_part, s);
-
-    // In some cases we don't even need to calc the right result.
-    switch (condition->opmode) {
-      case MaterialConditionNode::OpMode::AND_OPERATOR:
-        // AND can't succeed if left is false.
-        if (!left_result) return false;
-        break;
-      case MaterialConditionNode::OpMode::OR_OPERATOR:
-        // OR has succeeded if we've got a true.
-        if (left_result) return true;
         break;
       default:
+        conditions_static_ = false;
         break;
     }
+    return;
+  }
+
+  assert(node.left_child.exists());
+  assert(node.right_child.exists());
+  switch (node.opmode) {
+    case MaterialConditionNode::OpMode::AND_OPERATOR:
+    case MaterialConditionNode::OpMode::OR_OPERATOR: {
+      // The left result gets either kept as the answer or discarded
+      // before the right side runs, so the right side starts at our
+      // depth too.
+      CompileCondition_(*node.left_child, depth, max_depth);
+      size_t op_index{condition_ops_.size()};
+      ConditionOp_ op;
+      op.opmode = node.opmode;
+      condition_ops_.push_back(op);
+      CompileCondition_(*node.right_child, depth, max_depth);
+      condition_ops_[op_index].skip =
+          static_cast<uint32_t>(condition_ops_.size() - op_index - 1);
+      break;
+    }
+    case MaterialConditionNode::OpMode::XOR_OPERATOR: {
+      CompileCondition_(*node.left_child, depth, max_depth);
+      CompileCondition_(*node.right_child, depth + 1, max_depth);
+      ConditionOp_ op;
+      op.opmode = node.opmode;
+      condition_ops_.push_back(op);
+      break;
+    }
+    default:
+      throw Exception();
+  }
+}
+
+auto MaterialComponent::EvalConditions(const Material& c, const Part* part,
+                                       const Part* opposing_part,
+                                       const MaterialContext& s) -> bool {
+  if (!conditions_compiled_) {
+    CompileConditions();
+  }
 
-    bool right_result =
-        eval_conditions(condition->right_child, c, part, opposing_part, s);
+  // If there's no condition, succeed.
+  if (condition_ops_.empty()) {
+    return true;
+  }
 
-    switch (condition->opmode) {
+  uint8_t* stack{eval_stack_.data()};
+  size_t top{};
+  size_t op_count{condition_ops_.size()};
+  for (size_t i = 0; i < op_count; ++i) {
+    const ConditionOp_& op{condition_ops_[i]};
+    switch (op.opmode) {
+      case MaterialConditionNode::OpMode::LEAF_NODE:
+        assert(top < eval_stack_.size());
+        stack[top++] = EvalLeaf_(op, c, part, opposing_part, s);
+        break;
       case MaterialConditionNode::OpMode::AND_OPERATOR:
-        return left_result && right_result;
+        // AND can't succeed if left is false; otherwise right decides.
+        assert(top > 0);
+        if (!stack[top - 1]) {
+          i += op.skip;
+        } else {
+          top--;
+        }
+        break;
       case MaterialConditionNode::OpMode::OR_OPERATOR:
-        return left_result || right_result;
+        // OR has succeeded if we've got a true; otherwise right decides.
+        assert(top > 0);
+        if (stack[top - 1]) {
+          i += op.skip;
+        } else {
+          top--;
+        }
+        break;
       case MaterialConditionNode::OpMode::XOR_OPERATOR:
-        return ((left_result && !right_result)
-                || (!left_result && right_result));
+        assert(top > 1);
+        top--;
+        stack[top - 1] = (stack[top - 1] != stack[top]);
+        break;
       default:
         throw Exception();
     }
   }
+  assert(top == 1);
+  return stack[0] != 0;
+}
+
+auto MaterialComponent::EvalLeaf_(const ConditionOp_& op, const Material& c,
+                                  const Part* part, const Part* opposing_part,
+                                  const MaterialContext& s) -> bool {
+  switch (op.cond) {
+    case MaterialCondition::kTrue:
+      return true;
+    case MaterialCondition::kFalse:
+      return false;
+    case MaterialCondition::kDstIsMaterial:
+      return opposing_part->ContainsMaterial(op.val1_material);
+    case MaterialCondition::kDstNotMaterial:
+      return !opposing_part->ContainsMaterial(op.val1_material);
+    case MaterialCondition::kDstIsPart:
+      return opposing_part->id() == op.val1;
+    case MaterialCondition::kDstNotPart:
+      return opposing_part->id() != op.val1;
+    case MaterialCondition::kSrcDstSameMaterial:
+      return opposing_part->ContainsMaterial(&c);
+    case MaterialCondition::kSrcDstDiffMaterial:
+      return !opposing_part->ContainsMaterial(&c);
+    case MaterialCondition::kSrcDstSameNode:
+      return opposing_part->node() == part->node();
+    case MaterialCondition::kSrcDstDiffNode:
+      return opposing_part->node() != part->node();
+    case MaterialCondition::kSrcYoungerThan:
+      return part->GetAge() < op.val1;
+    case MaterialCondition::kSrcOlderThan:
+      return part->GetAge() >= op.val1;
+    case MaterialCondition::kDstYoungerThan:
+      return opposing_part->GetAge() < op.val1;
+    case MaterialCondition::kDstOlderThan:
+      return opposing_part->GetAge() >= op.val1;
+    case MaterialCondition::kCollidingDstNode:
+      return part->IsCollidingWith(opposing_part->node()->id());
+    case MaterialCondition::kNotCollidingDstNode:
+      return !part->IsCollidingWith(opposing_part->node()->id());
+    case MaterialCondition::kEvalColliding:
+      return s.collide && s.node_collide;
+    case MaterialCondition::kEvalNotColliding:
+      return !s.collide || !s.node_collide;
+    default:
+      throw Exception();
+  }
 }
 
 auto MaterialComponent::GetFlattenedSize() -> size_t {
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "ballistica/scene_v1/dynamics/material/material_action.h"
+#include "ballistica/scene_v1/dynamics/material/material_condition_node.h"
 #include "ballistica/scene_v1/scene_v1.h"
 #include "ballistica/shared/foundation/object.h"
 
@@ -27,11 +28,20 @@ class MaterialComponent : public Object {
   // in case the component is deleted before they are run.
   std::vector<Object::Ref<MaterialAction> > actions;
   Object::Ref<MaterialConditionNode> conditions;
-  auto eval_conditions(const Object::Ref<MaterialConditionNode>& condition,
-                       const Material& c, const Part* part,
-                       const Part* opposing_part, const MaterialContext& s)
+
+  /// Flatten our condition tree into the form used by EvalConditions().
+  /// Should be called whenever conditions changes.
+  void CompileConditions();
+
+  /// Evaluate our conditions for a part colliding with an opposing part.
+  auto EvalConditions(const Material& c, const Part* part,
+                      const Part* opposing_part, const MaterialContext& s)
       -> bool;
 
+  /// Whether our conditions depend only on the materials involved (and
+  /// so their results can be reused for any parts with those materials).
+  auto conditions_static() const -> bool { return conditions_static_; }
+
   // Apply the component to a context.
   void Apply(MaterialContext* c, const Part* src_part, const Part* dst_part);
   MaterialComponent();
@@ -39,6 +49,29 @@ class MaterialComponent : public Object {
       const Object::Ref<MaterialConditionNode>& conditions_in,
       const std::vector<Object::Ref<MaterialAction> >& actions_in);
   ~MaterialComponent();
+
+ private:
+  // A single step in our flattened condition tree. Trees are stored with
+  // each operator between its two operands so AND and OR can skip their
+  // right side when the left decides things.
+  struct ConditionOp_ {
+    MaterialConditionNode::OpMode opmode{};
+    MaterialCondition cond{};
+    int val1{};
+    const Material* val1_material{};
+    // For AND/OR: how many ops make up the right side.
+    uint32_t skip{};
+  };
+  void CompileCondition_(const MaterialConditionNode& node, size_t depth,
+                         size_t* max_depth);
+  static auto EvalLeaf_(const ConditionOp_& op, const Material& c,
+                        const Part* part, const Part* opposing_part,
+                        const MaterialContext& s) -> bool;
+
+  std::vector<ConditionOp_> condition_ops_;
+  std::vector<uint8_t> eval_stack_;
+  bool conditions_compiled_{};
+  bool conditions_static_{};
 };
 
 }  // namespace ballistica::scene_v1
@@ -39,6 +39,12 @@ void NodeUserMessageMaterialAction::Execute(Node* node1, Node* node2,
     if (!node1 || !node2) {
       return;
     }
+    Node* opposing_node = target_other ? node1 : node2;
+    if (scene->dynamics()->coalesce_collide_messages()
+        && !scene->dynamics()->ClaimCollideMessage(
+            target_node, opposing_node, user_message_obj.get())) {
+      return;
+    }
   } else {
     // Deliver 'disconnect' messages if the target node still exists
     // even if the opposing one doesn't. Nodes should always know when
@@ -25,24 +25,24 @@ void PythonCallMaterialAction::Apply(MaterialContext* context,
 }
 
 void PythonCallMaterialAction::Execute(Node* node1, Node* node2, Scene* scene) {
-  scene->dynamics()->set_collide_message_state(true, false);
+  Dynamics* dynamics = scene->dynamics();
+  dynamics->set_collide_message_state(true, false);
 
   // Only run connect commands if both nodes still exist.
   // This way most collision commands can assume both
   // members of the collision exist.
-  if (!at_disconnect) {
-    if (node1 && node2) {
-      call->Run();
-    }
-  } else {
-    // Its a disconnect. Run it if the src node still exists
-    // (nodes should know if they've disconnected from others even if
-    // it was through death)
-    if (node1) {
+  // For disconnects, run if the src node still exists
+  // (nodes should know if they've disconnected from others even if
+  // it was through death)
+  bool should_run = at_disconnect ? (node1 != nullptr) : (node1 && node2);
+  if (should_run) {
+    if (dynamics->batch_python_calls()) {
+      dynamics->QueuePythonCall(call.get());
+    } else {
       call->Run();
     }
   }
-  scene->dynamics()->set_collide_message_state(false);
+  dynamics->set_collide_message_state(false);
 }
 
 }  // namespace ballistica::scene_v1
@@ -2,6 +2,7 @@
 
 #include "ballistica/scene_v1/dynamics/part.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "ballistica/scene_v1/dynamics/dynamics.h"
@@ -45,6 +46,14 @@ void Part::SetMaterials(const std::vector<Material*>& vals) {
 
   // Hold strong refs to the materials passed.
   materials_ = PointersToRefs(vals);
+  material_uids_.clear();
+  for (auto&& material : vals) {
+    material_uids_.push_back(material->uid());
+  }
+  std::sort(material_uids_.begin(), material_uids_.end());
+  material_uids_.erase(
+      std::unique(material_uids_.begin(), material_uids_.end()),
+      material_uids_.end());
 
   // Wake us up in case our new materials make us stop colliding or whatnot.
   // (we may be asleep resting on something we suddenly no longer hit)
@@ -55,6 +55,11 @@ class Part : public Object {
   void SetMaterials(const std::vector<Material*>& vals);
   auto GetMaterials() const -> std::vector<Material*>;
 
+  /// Sorted uids of our materials; identifies our material set.
+  auto material_uids() const -> const std::vector<int64_t>& {
+    return material_uids_;
+  }
+
   // Apply this part's materials to a context.
   void ApplyMaterials(MaterialContext* s, const Part* src_part,
                       const Part* dst_part);
@@ -126,6 +131,7 @@ class Part : public Object {
   int our_id_;
   Object::WeakRef<Node> node_;
   std::vector<Object::Ref<Material> > materials_;
+  std::vector<int64_t> material_uids_;
   std::vector<RigidBody*> rigid_bodies_;
 
   // Last time this part played a collide sound (used by the audio system).
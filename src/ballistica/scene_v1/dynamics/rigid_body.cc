@@ -10,6 +10,8 @@
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/math/random.h"
 #include "ode/ode_collision_util.h"
+#include "ode/ode_math.h"
+#include "ode/ode_rotation.h"
 
 namespace ballistica::scene_v1 {
 
@@ -128,8 +130,14 @@ RigidBody::RigidBody(int id_in, Part* part_in, Type type_in, Shape shape_in,
       throw Exception();
   }
 
+  // Our collide type and mask never change, so let ODE's broadphase drop
+  // pairs that can't match before they ever reach our near callback. ODE
+  // accepts a pair if either side wants the other (we require both), so
+  // the callback still does the full check; this just thins things out.
   for (auto&& i : geoms_) {
     dGeomSetData(i, this);
+    dGeomSetCategoryBits(i, collide_type_);
+    dGeomSetCollideBits(i, collide_mask_);
   }
 
   if (type_ == Type::kBody) {
@@ -166,12 +174,42 @@ void RigidBody::ApplyToRenderComponent(base::RenderComponent* c) {
   for (int x = 0; x < 3; x++) {
     pos[x] = pos_in[x];
   }
-  pos[0] += blend_offset().x;
-  pos[1] += blend_offset().y;
-  pos[2] += blend_offset().z;
   for (int x = 0; x < 12; x++) {
     r[x] = r_in[x];
   }
+
+  // Where we have our state from before the last step, draw partway
+  // between that and where we are now.
+  Scene* scene = part()->node()->scene();
+  if (type() == Type::kBody && scene->render_blend() < 1.0f
+      && render_prev_stepnum_ == scene->stepnum() - 1) {
+    float blend = scene->render_blend();
+    for (int x = 0; x < 3; x++) {
+      pos[x] = render_prev_pos_[x] + (pos[x] - render_prev_pos_[x]) * blend;
+    }
+
+    // Normalized lerp is plenty for a single step's worth of rotation;
+    // just make sure we go the short way around.
+    const dReal* q_in = dBodyGetQuaternion(body_);
+    float dot{};
+    for (int x = 0; x < 4; x++) {
+      dot += render_prev_quat_[x] * q_in[x];
+    }
+    float sign = dot < 0.0f ? -1.0f : 1.0f;
+    dQuaternion q;
+    for (int x = 0; x < 4; x++) {
+      q[x] = render_prev_quat_[x] * (1.0f - blend) + sign * q_in[x] * blend;
+    }
+    dNormalize4(q);
+    dMatrix3 rotation;
+    dRfromQ(rotation, q);
+    for (int x = 0; x < 12; x++) {
+      r[x] = rotation[x];
+    }
+  }
+  pos[0] += blend_offset().x;
+  pos[1] += blend_offset().y;
+  pos[2] += blend_offset().z;
   float matrix[16];
   matrix[0] = r[0];
   matrix[1] = r[4];
@@ -192,6 +230,19 @@ void RigidBody::ApplyToRenderComponent(base::RenderComponent* c) {
   c->MultMatrix(matrix);
 }
 
+void RigidBody::StoreRenderState() {
+  assert(type_ == Type::kBody);
+  const dReal* p = dBodyGetPosition(body_);
+  const dReal* q = dBodyGetQuaternion(body_);
+  for (int i = 0; i < 3; i++) {
+    render_prev_pos_[i] = p[i];
+  }
+  for (int i = 0; i < 4; i++) {
+    render_prev_quat_[i] = q[i];
+  }
+  render_prev_stepnum_ = part()->node()->scene()->stepnum();
+}
+
 void RigidBody::Check() {
   if (type_ == Type::kBody) {
     const dReal* p = dBodyGetPosition(body_);
@@ -718,17 +769,4 @@ void RigidBody::AddBlendOffset(float x, float y, float z) {
   //  blend_offset_.z += z;
 }
 
-void RigidBody::UpdateBlending() {
-  // FIXME - this seems broken. We never update blend_time_ currently
-  //  and its also set to time whereas we're comparing it with steps.
-  //  Should revisit.
-  //  millisecs_t diff = part()->node()->scene()->stepnum() - blend_time_;
-  //  diff = std::min(millisecs_t{10}, diff);
-  //  for (millisecs_t i = 0; i < diff; i++) {
-  //    blend_offset_.x *= 0.995f;
-  //    blend_offset_.y *= 0.995f;
-  //    blend_offset_.z *= 0.995f;
-  //  }
-}
-
 }  // namespace ballistica::scene_v1
@@ -177,12 +177,30 @@ class RigidBody : public Object {
   // Applies to spheres.
   auto radius() const -> float { return dimensions_[0]; }
   auto GetTransform() -> Matrix44f;
-  void UpdateBlending();
+
+  // FIXME - this seems broken. We never update blend_time_ currently
+  //  and its also set to time whereas we're comparing it with steps.
+  //  Should revisit. (Inline and empty in the meantime so the per-step
+  //  calls on every body cost nothing.)
+  void UpdateBlending() {
+    //  millisecs_t diff = part()->node()->scene()->stepnum() - blend_time_;
+    //  diff = std::min(millisecs_t{10}, diff);
+    //  for (millisecs_t i = 0; i < diff; i++) {
+    //    blend_offset_.x *= 0.995f;
+    //    blend_offset_.y *= 0.995f;
+    //    blend_offset_.z *= 0.995f;
+    //  }
+  }
   void AddBlendOffset(float x, float y, float z);
   auto blend_offset() const -> const Vector3f& { return blend_offset_; }
 
   void ApplyToRenderComponent(base::RenderComponent* c);
 
+  /// Remember our current position and orientation so rendering can blend
+  /// from them to wherever the coming step leaves us (see
+  /// Scene::render_blend()). Bodies only.
+  void StoreRenderState();
+
  private:
   Vector3f blend_offset_{0.0f, 0.0f, 0.0f};
   millisecs_t blend_time_{};
@@ -192,6 +210,9 @@ class RigidBody : public Object {
   float prev_a_vel_[3]{};
 #endif
   millisecs_t creation_time_{};
+  float render_prev_pos_[3]{};
+  float render_prev_quat_[4]{};
+  int64_t render_prev_stepnum_{-1};
   bool can_cause_impact_damage_{};
   Dynamics* dynamics_{};
   uint32_t collide_type_{};
@@ -61,6 +61,10 @@ auto AnimCurveNode::GetOut() -> float {
       }
       keyframes_.emplace_back(times_[i], values_[i]);
     }
+    keys_sorted_ = std::is_sorted(
+        keyframes_.begin(), keyframes_.end(),
+        [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+    segment_ = 0;
     keys_dirty_ = false;
     out_dirty_ = true;
   }
@@ -92,24 +96,10 @@ auto AnimCurveNode::GetOut() -> float {
           }
         }
         if (!got) {
-          // out_ = keyframes_[0].value;
-
           // Ok we know we've got at least 2 keyframes.
-          auto i1 = keyframes_.begin();
-          auto i2 = keyframes_.begin();
-          auto i = keyframes_.begin();
-          while (true) {
-            if (i == keyframes_.end()) {
-              break;
-            }
-            if (static_cast<float>(i->time) < in_val) {
-              i++;
-              i1 = i2;
-              i2 = i;
-            } else {
-              break;
-            }
-          }
+          size_t seg = FindSegment_(in_val);
+          auto* i2 = &keyframes_[seg];
+          auto* i1 = seg > 0 ? &keyframes_[seg - 1] : i2;
           if (i2->time - i1->time == 0) {
             out_ = i1->value;
           } else {
@@ -134,4 +124,38 @@ auto AnimCurveNode::GetOut() -> float {
   return out_;
 }
 
+auto AnimCurveNode::FindSegment_(float in_val) -> size_t {
+  // We want the first keyframe at or past our input (or the last one if
+  // there is none, though callers keep us within range).
+  auto num = keyframes_.size();
+  assert(num >= 2);
+  auto before = [this, in_val](size_t i) {
+    return static_cast<float>(keyframes_[i].time) < in_val;
+  };
+
+  // With keys out of order, stick to the straight scan we've always done
+  // so results don't change.
+  if (!keys_sorted_) {
+    size_t i = 0;
+    while (i < num - 1 && before(i)) {
+      i++;
+    }
+    return i;
+  }
+
+  // Try our last segment and the one after it before searching.
+  for (size_t i = segment_; i < std::min(segment_ + 2, num); i++) {
+    if (!before(i) && (i == 0 || before(i - 1))) {
+      segment_ = i;
+      return i;
+    }
+  }
+  auto it = std::lower_bound(keyframes_.begin(), keyframes_.end(), in_val,
+                             [](const Keyframe& k, float v) {
+                               return static_cast<float>(k.time) < v;
+                             });
+  segment_ = std::min(static_cast<size_t>(it - keyframes_.begin()), num - 1);
+  return segment_;
+}
+
 }  // namespace ballistica::scene_v1
@@ -57,6 +57,8 @@ class AnimCurveNode : public Node {
     float value;
   };
 
+  auto FindSegment_(float in_val) -> size_t;
+
   float in_ = 0.0f;
   std::vector<millisecs_t> times_;
   std::vector<float> values_;
@@ -65,6 +67,11 @@ class AnimCurveNode : public Node {
   float out_ = 0.0f;
   bool loop_ = true;
   std::vector<Keyframe> keyframes_;
+  bool keys_sorted_ = true;
+
+  // Index of the keyframe ending the segment we last evaluated in; inputs
+  // generally creep along so this is usually still (or next) the one.
+  size_t segment_ = 0;
   float input_start_ = 0.0f;
   float input_end_ = 0.0f;
   float offset_ = 0.0f;
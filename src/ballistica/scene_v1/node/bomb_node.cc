@@ -2,6 +2,8 @@
 
 #include "ballistica/scene_v1/node/bomb_node.h"
 
+#include <algorithm>
+
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/scene_v1/support/scene.h"
 #include "ode/ode_collision.h"
@@ -65,6 +67,17 @@ void BombNode::Step() {
   }
 }
 
+auto BombNode::GetDrawBounds(Vector3f* top, float* bottom_y, float* radius)
+    -> bool {
+  if (!PropNode::GetDrawBounds(top, bottom_y, radius)) {
+    return false;
+  }
+
+  // Leave room for our glow.
+  *radius = std::max(*radius, 10.0f);
+  return true;
+}
+
 void BombNode::Draw(base::FrameDef* frame_def) {
 #if !BA_HEADLESS_BUILD
   PropNode::Draw(frame_def);
@@ -14,6 +14,8 @@ class BombNode : public PropNode {
   explicit BombNode(Scene* scene);
   void Step() override;
   void Draw(base::FrameDef* frame_def) override;
+  auto GetDrawBounds(Vector3f* top, float* bottom_y, float* radius)
+      -> bool override;
   void OnCreate() override;
   auto fuse_length() const -> float { return fuse_length_; }
   void set_fuse_length(float val) { fuse_length_ = val; }
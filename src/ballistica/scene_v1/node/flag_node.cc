@@ -165,6 +165,7 @@ void FlagNode::SetPosition(const std::vector<float>& vals) {
   }
   dQuaternion iq;
   dQFromAxisAndAngle(iq, 1, 0, 0, -90 * (kPi / 180.0f));
+  body_->Wake();
   dBodySetPosition(body_->body(), vals[0], vals[1], vals[2]);
   dBodySetQuaternion(body_->body(), iq);
   dBodySetLinearVel(body_->body(), 0, 0, 0);
@@ -258,6 +259,41 @@ void FlagNode::HandleMessage(const char* data_in) {
   if (!handled) Node::HandleMessage(data_in);
 }
 
+void FlagNode::PrepareDraw(base::FrameDef* frame_def) {
+  // Pack our cloth points into vertices; Draw() just ships these.
+  // Normals are only needed for drawing so we calc them here (once per
+  // drawn frame instead of once per step). Each cell's normal is
+  // computed once; verts along the far edges share their neighbor
+  // cell's.
+  Vector3f cell_normals[kFlagSizeX - 1][kFlagSizeY - 1];
+  for (int y = 0; y < kFlagSizeY - 1; y++) {
+    for (int x = 0; x < kFlagSizeX - 1; x++) {
+      int i = kFlagSizeX * y + x;
+      cell_normals[x][y] =
+          Vector3f::Cross(flag_points_[i + 1] - flag_points_[i],
+                          flag_points_[i + kFlagSizeX] - flag_points_[i])
+              .Normalized();
+    }
+  }
+  base::VertexObjectSplitDynamic* vd = flag_vertices_;
+  for (int y = 0; y < kFlagSizeY; y++) {
+    for (int x = 0; x < kFlagSizeX; x++) {
+      int i = kFlagSizeX * y + x;
+      const Vector3f& normal{cell_normals[std::min(x, kFlagSizeX - 2)]
+                                         [std::min(y, kFlagSizeY - 2)]};
+      vd[i].position[0] = flag_points_[i].x;
+      vd[i].position[1] = flag_points_[i].y;
+      vd[i].position[2] = flag_points_[i].z;
+      vd[i].normal[0] = static_cast_check_fit<int16_t>(std::max(
+          -32767, std::min(32767, static_cast<int>(normal.x * 32767.0f))));
+      vd[i].normal[1] = static_cast_check_fit<int16_t>(std::max(
+          -32767, std::min(32767, static_cast<int>(normal.y * 32767.0f))));
+      vd[i].normal[2] = static_cast_check_fit<int16_t>(std::max(
+          -32767, std::min(32767, static_cast<int>(normal.z * 32767.0f))));
+    }
+  }
+}
+
 void FlagNode::Draw(base::FrameDef* frame_def) {
   if (graphics_quality_ != frame_def->quality()) {
     graphics_quality_ = frame_def->quality();
@@ -266,27 +302,11 @@ void FlagNode::Draw(base::FrameDef* frame_def) {
 
   // Flag cloth.
   {
-    // Update the dynamic portion of our mesh data.
+    // Update the dynamic portion of our mesh data (packed in PrepareDraw).
     // FIXME - should move this all to BG dynamics thread
-    auto v_dynamic(
-        Object::New<base::MeshBuffer<base::VertexObjectSplitDynamic>>(25));
-
-    base::VertexObjectSplitDynamic* vd = &v_dynamic->elements[0];
-    for (int i = 0; i < 25; i++) {
-      vd[i].position[0] = flag_points_[i].x;
-      vd[i].position[1] = flag_points_[i].y;
-      vd[i].position[2] = flag_points_[i].z;
-      vd[i].normal[0] = static_cast_check_fit<int16_t>(std::max(
-          -32767,
-          std::min(32767, static_cast<int>(flag_normals_[i].x * 32767.0f))));
-      vd[i].normal[1] = static_cast_check_fit<int16_t>(std::max(
-          -32767,
-          std::min(32767, static_cast<int>(flag_normals_[i].y * 32767.0f))));
-      vd[i].normal[2] = static_cast_check_fit<int16_t>(std::max(
-          -32767,
-          std::min(32767, static_cast<int>(flag_normals_[i].z * 32767.0f))));
-    }
-    mesh_.SetDynamicData(v_dynamic);
+    mesh_.SetDynamicData(
+        Object::New<base::MeshBuffer<base::VertexObjectSplitDynamic>>(
+            25, flag_vertices_));
 
     // Render a subtle sharp shadow in higher quality modes.
     if (frame_def->quality() > base::GraphicsQuality::kLow) {
@@ -493,7 +513,11 @@ void FlagNode::Step() {
       }
     }
   }
+
+  // The cloth is purely visual.
+#if !BA_HEADLESS_BUILD
   UpdateFlagMesh();
+#endif
 }
 
 auto FlagNode::GetRigidBody(int id) -> RigidBody* { return body_.get(); }
@@ -632,26 +656,9 @@ void FlagNode::UpdateFlagMesh() {
 
   flag_impulse_add_x_ = flag_impulse_add_y_ = flag_impulse_add_z_ = 0;
 
-  // Now update positions (except pole points).
-  for (int y = 0; y < kFlagSizeY; y++) {
-    for (int x = 0; x < kFlagSizeX; x++) {
-      int i = kFlagSizeX * y + x;
-      flag_points_[i] += flag_velocities_[i];
-    }
-  }
-
-  // Now calc normals.
-  for (int y = 0; y < kFlagSizeY; y++) {
-    for (int x = 0; x < kFlagSizeX; x++) {
-      // Calc the normal for this vert.
-      int xclamped = std::min(x, kFlagSizeX - 2);
-      int yclamped = std::min(y, kFlagSizeY - 2);
-      int i = kFlagSizeX * yclamped + xclamped;
-      flag_normals_[i] =
-          Vector3f::Cross(flag_points_[i + 1] - flag_points_[i],
-                          flag_points_[i + kFlagSizeX] - flag_points_[i])
-              .Normalized();
-    }
+  // Now update positions (pole points get reset next step).
+  for (int i = 0; i < kFlagSizeX * kFlagSizeY; i++) {
+    flag_points_[i] += flag_velocities_[i];
   }
 }
 
@@ -17,6 +17,7 @@ class FlagNode : public Node {
   explicit FlagNode(Scene* scene);
   ~FlagNode() override;
   void HandleMessage(const char* data) override;
+  void PrepareDraw(base::FrameDef* frame_def) override;
   void Draw(base::FrameDef* frame_def) override;
   void Step() override;
   auto GetRigidBody(int id) -> RigidBody* override;
@@ -67,7 +68,7 @@ class FlagNode : public Node {
   float flag_impulse_add_y_{};
   float flag_impulse_add_z_{};
   Vector3f flag_points_[25]{};
-  Vector3f flag_normals_[25]{};
+  base::VertexObjectSplitDynamic flag_vertices_[25]{};
   Vector3f flag_velocities_[25]{};
 };
 
@@ -11,6 +11,7 @@
 #include "ballistica/base/graphics/support/camera.h"
 #include "ballistica/base/support/classic_soft.h"
 #include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/scene_v1/dynamics/dynamics.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/support/host_activity.h"
@@ -59,6 +60,18 @@ class GlobalsNodeType : public NodeType {
   BA_BOOL_ATTR(music_continuous, music_continuous, set_music_continuous);
   BA_STRING_ATTR(music, music, set_music);
   BA_INT_ATTR(music_count, music_count, SetMusicCount);
+  BA_STRING_ATTR(physics_broadphase, GetPhysicsBroadphase,
+                 SetPhysicsBroadphase);
+  BA_INT64_ATTR_READONLY(physics_process_microsecs,
+                         GetPhysicsProcessMicrosecs);
+  BA_BOOL_ATTR(physics_parallel_islands, GetPhysicsParallelIslands,
+               SetPhysicsParallelIslands);
+  BA_BOOL_ATTR(batch_collision_callbacks, GetBatchCollisionCallbacks,
+               SetBatchCollisionCallbacks);
+  BA_BOOL_ATTR(physics_deterministic, GetPhysicsDeterministic,
+               SetPhysicsDeterministic);
+  BA_BOOL_ATTR(coalesce_collision_messages, GetCoalesceCollisionMessages,
+               SetCoalesceCollisionMessages);
 #undef BA_NODE_TYPE_CLASS
 
   GlobalsNodeType()
@@ -90,7 +103,13 @@ class GlobalsNodeType : public NodeType {
         vr_near_clip(this),
         music_continuous(this),
         music(this),
-        music_count(this) {}
+        music_count(this),
+        physics_broadphase(this),
+        physics_process_microsecs(this),
+        physics_parallel_islands(this),
+        batch_collision_callbacks(this),
+        physics_deterministic(this),
+        coalesce_collision_messages(this) {}
 };
 
 static NodeType* node_type{};
@@ -394,6 +413,53 @@ void GlobalsNode::SetVignetteInner(const std::vector<float>& vals) {
   }
 }
 
+auto GlobalsNode::GetPhysicsBroadphase() const -> std::string {
+  return Dynamics::BroadphaseToString(scene()->dynamics()->broadphase());
+}
+
+void GlobalsNode::SetPhysicsBroadphase(const std::string& val) {
+  auto broadphase = Dynamics::BroadphaseFromString(val);
+  if (broadphase != scene()->dynamics()->broadphase()) {
+    scene()->dynamics()->SetBroadphase(broadphase);
+  }
+}
+
+auto GlobalsNode::GetPhysicsProcessMicrosecs() -> int64_t {
+  return scene()->dynamics()->process_time_microsecs();
+}
+
+auto GlobalsNode::GetPhysicsParallelIslands() const -> bool {
+  return scene()->dynamics()->parallel_islands();
+}
+
+void GlobalsNode::SetPhysicsParallelIslands(bool val) {
+  scene()->dynamics()->set_parallel_islands(val);
+}
+
+auto GlobalsNode::GetBatchCollisionCallbacks() const -> bool {
+  return scene()->dynamics()->batch_python_calls();
+}
+
+void GlobalsNode::SetBatchCollisionCallbacks(bool val) {
+  scene()->dynamics()->set_batch_python_calls(val);
+}
+
+auto GlobalsNode::GetCoalesceCollisionMessages() const -> bool {
+  return scene()->dynamics()->coalesce_collide_messages();
+}
+
+void GlobalsNode::SetCoalesceCollisionMessages(bool val) {
+  scene()->dynamics()->set_coalesce_collide_messages(val);
+}
+
+auto GlobalsNode::GetPhysicsDeterministic() const -> bool {
+  return scene()->dynamics()->deterministic();
+}
+
+void GlobalsNode::SetPhysicsDeterministic(bool val) {
+  scene()->dynamics()->set_deterministic(val);
+}
+
 auto GlobalsNode::GetCameraMode() const -> std::string {
   switch (camera_mode_) {
     case base::CameraMode::kOrbit:
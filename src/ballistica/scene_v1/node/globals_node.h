@@ -26,6 +26,17 @@ class GlobalsNode : public Node {
   void SetFloorReflection(bool val);
   auto debris_kill_height() const -> float { return debris_kill_height_; }
   void SetDebrisKillHeight(float val);
+  auto GetPhysicsBroadphase() const -> std::string;
+  void SetPhysicsBroadphase(const std::string& val);
+  auto GetPhysicsProcessMicrosecs() -> int64_t;
+  auto GetPhysicsParallelIslands() const -> bool;
+  void SetPhysicsParallelIslands(bool val);
+  auto GetBatchCollisionCallbacks() const -> bool;
+  void SetBatchCollisionCallbacks(bool val);
+  auto GetPhysicsDeterministic() const -> bool;
+  void SetPhysicsDeterministic(bool val);
+  auto GetCoalesceCollisionMessages() const -> bool;
+  void SetCoalesceCollisionMessages(bool val);
   auto GetCameraMode() const -> std::string;
   void SetCameraMode(const std::string& val);
   void SetHappyThoughtsMode(bool val);
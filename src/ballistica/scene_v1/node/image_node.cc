@@ -359,6 +359,29 @@ void ImageNode::Draw(base::FrameDef* frame_def) {
     }
   }
 
+  // Plain images (default mesh, no tinting or masking) go through the
+  // overlay quad batcher so runs of them sharing a texture and color
+  // become a single draw.
+  bool batch = !mesh_opaque_.exists() && !mesh_transparent_.exists()
+               && !fill_screen_ && !tint_texture_.exists()
+               && !mask_texture_.exists();
+  if (batch) {
+    base::OverlayQuadBatcher::State state;
+    state.pass = &pass;
+    state.texture = texture_.exists() ? texture_->texture_data() : nullptr;
+    state.color[0] = red_;
+    state.color[1] = green_;
+    state.color[2] = blue_;
+    state.color[3] = alpha;
+    state.transparent = mesh_transparent_used || alpha < 0.999f;
+    state.premultiplied = premultiplied_;
+    g_base->graphics->overlay_quads()->AddQuad(
+        state, fin_center_x, fin_center_y,
+        vr ? vr_depth_ : g_base->graphics->overlay_node_z_depth(), fin_width,
+        fin_height, rotate_);
+    return;
+  }
+
   // Draw opaque portion either opaque or transparent depending on our
   // global opacity.
   if (mesh_opaque_used) {
@@ -9,6 +9,7 @@
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/scene_v1/support/scene.h"
 
 namespace ballistica::scene_v1 {
 
@@ -139,6 +140,12 @@ void LightNode::Draw(base::FrameDef* frame_def) {
 
   float brightness = s_density * 0.65f * intensity_;
 
+  // Faded-out lights are common (bomb glows, powerup flashes, etc.) and
+  // would otherwise still cost us their full fill.
+  if (brightness <= 0.0f) {
+    return;
+  }
+
   // draw our light on both terrain and objects
   g_base->graphics->DrawBlotchSoft(
       Vector3f(&position_[0]), 20.0f * radius_ * s_scale,
@@ -152,4 +159,15 @@ void LightNode::Draw(base::FrameDef* frame_def) {
 #endif  // BA_HEADLESS_BUILD
 }
 
+auto LightNode::GetDrawBounds(Vector3f* top, float* bottom_y, float* radius)
+    -> bool {
+  *top = Vector3f(&position_[0]);
+  *bottom_y = scene()->bounds_min()[1];
+
+  // Our blotches are 20 * radius * shadow-scale across, and our shadow
+  // scale stays under 1.5, so this covers even their corners.
+  *radius = 20.0f * radius_;
+  return true;
+}
+
 }  // namespace ballistica::scene_v1
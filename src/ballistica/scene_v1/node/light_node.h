@@ -16,6 +16,8 @@ class LightNode : public Node {
   static auto InitType() -> NodeType*;
   explicit LightNode(Scene* scene);
   void Draw(base::FrameDef* frame_def) override;
+  auto GetDrawBounds(Vector3f* top, float* bottom_y, float* radius)
+      -> bool override;
   void Step() override;
   auto position() const -> std::vector<float> { return position_; }
   void SetPosition(const std::vector<float>& val);
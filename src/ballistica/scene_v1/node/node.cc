@@ -31,16 +31,19 @@ void Node::AddToScene(Scene* scene) {
   assert(scene_ == scene);
   assert(id_ == 0);
 
-  scene->AddNode(this, &id_, &iterator_);
-  // id_ = scene->next_node_id_++;
-  // our_iterator_ =
-  //     scene->nodes_.insert(scene->nodes_.end(), Object::Ref<Node>(this));
+  scene->AddNode(this, &id_, &handle_);
   if (SessionStream* os = scene->GetSceneStream()) {
     os->AddNode(this);
   }
 }
 
 Node::~Node() {
+  assert(scene());
+  if (scene()->tearing_down()) {
+    TearDown_();
+    return;
+  }
+
   // Kill any incoming/outgoing attr connections.
   for (auto& i : attribute_connections_incoming_) {
     NodeAttributeConnection* a = i.second.get();
@@ -75,12 +78,122 @@ Node::~Node() {
   }
 
   // If we were going to an output stream, inform them of our demise.
-  assert(scene());
   if (SessionStream* output_stream = scene()->GetSceneStream()) {
     output_stream->RemoveNode(this);
   }
 }
 
+void Node::TearDown_() {
+  // Our whole scene is going down with us, so connections to other nodes
+  // in it can simply be dropped; only ones leading outside of it (which
+  // shouldn't generally exist) need unlinking from the far end.
+  for (auto& i : attribute_connections_incoming_) {
+    NodeAttributeConnection* a = i.second.get();
+    if (a->src_node.exists() && a->src_node->scene() != scene()) {
+      a->src_node->attribute_connections_.erase(a->src_iterator);
+    }
+  }
+  attribute_connections_incoming_.clear();
+  for (auto& i : attribute_connections_) {
+    NodeAttributeConnection* a = i.get();
+    if (a->dst_node.exists() && a->dst_node->scene() != scene()) {
+      a->dst_node->attribute_connections_incoming_.erase(a->dst_attr_index);
+    }
+  }
+  attribute_connections_.clear();
+
+  if (py_ref_) {
+    Py_DECREF(py_ref_);
+  }
+
+  // The scene's removal command covers us; we just give back our id.
+  if (SessionStream* output_stream = scene()->GetSceneStream()) {
+    output_stream->ReleaseNode(this);
+  }
+}
+
+auto NodeList::Add(Node* node) -> NodeHandle {
+  assert(node);
+  uint32_t slot_index;
+  if (free_slots_.empty()) {
+    slot_index = static_cast<uint32_t>(slots_.size());
+    BA_PRECONDITION(slot_index != NodeHandle::kInvalidIndex);
+    slots_.emplace_back();
+  } else {
+    slot_index = free_slots_.back();
+    free_slots_.pop_back();
+  }
+  Slot_& slot{slots_[slot_index]};
+  slot.node_index = static_cast<uint32_t>(nodes_.size());
+  nodes_.emplace_back(node);
+  node_slots_.push_back(slot_index);
+  return {slot_index, slot.generation};
+}
+
+void NodeList::Remove(const NodeHandle& handle) {
+  assert(Get(handle));
+  if (handle.index >= slots_.size()
+      || slots_[handle.index].generation != handle.generation) {
+    return;
+  }
+  Slot_& slot{slots_[handle.index]};
+
+  // Bump the generation so outstanding handles go stale, and empty the
+  // entry before releasing our ref so the node never sees itself in the
+  // list while dying.
+  slot.generation++;
+  free_slots_.push_back(handle.index);
+  Object::Ref<Node> node{nodes_[slot.node_index]};
+  nodes_[slot.node_index].Clear();
+  empty_count_++;
+}
+
+auto NodeList::Get(const NodeHandle& handle) const -> Node* {
+  if (handle.index >= slots_.size()) {
+    return nullptr;
+  }
+  const Slot_& slot{slots_[handle.index]};
+  if (slot.generation != handle.generation) {
+    return nullptr;
+  }
+  return nodes_[slot.node_index].get();
+}
+
+void NodeList::Compact() {
+  if (empty_count_ == 0) {
+    return;
+  }
+  size_t out_index{};
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (!nodes_[i].exists()) {
+      continue;
+    }
+    if (out_index != i) {
+      nodes_[out_index] = nodes_[i];
+      nodes_[i].Clear();
+      node_slots_[out_index] = node_slots_[i];
+      slots_[node_slots_[out_index]].node_index =
+          static_cast<uint32_t>(out_index);
+    }
+    out_index++;
+  }
+  nodes_.resize(out_index);
+  node_slots_.resize(out_index);
+  empty_count_ = 0;
+}
+
+void NodeList::Clear() {
+  // Swap everything out first so nodes dying as a result don't see a
+  // half-cleared list.
+  std::vector<Object::Ref<Node> > nodes;
+  nodes.swap(nodes_);
+  node_slots_.clear();
+  slots_.clear();
+  free_slots_.clear();
+  empty_count_ = 0;
+  nodes.clear();
+}
+
 auto Node::GetResyncDataSize() -> int { return 0; }
 auto Node::GetResyncData() -> std::vector<uint8_t> { return {}; }
 
@@ -180,6 +293,7 @@ void Node::ConnectAttribute(NodeAttributeUnbound* src_attr, Node* dst_node,
   a->src_attr_index = src_attr->index();
   a->dst_node = dst_node;
   a->dst_attr_index = dst_attr->index();
+  a->Resolve();
   a->Update();
 }
 
@@ -272,13 +386,12 @@ void Node::DispatchOutOfBoundsMessage() {
 
 void Node::DispatchPickUpMessage(Node* node) {
   assert(node);
-  PythonRef args(Py_BuildValue("(O)", node->BorrowPyRef()), PythonRef::kSteal);
   PythonRef instance;
   {
     Python::ScopedCallLabel label("PickUpMessage instantiation");
     instance = g_scene_v1->python->objs()
                    .Get(SceneV1Python::ObjID::kPickUpMessageClass)
-                   .Call(args);
+                   .CallArgs(node->BorrowPyRef());
   }
   if (instance.exists()) {
     DispatchUserMessage(instance.get(), "Node PickUpMessage dispatch");
@@ -304,14 +417,12 @@ void Node::DispatchDropMessage() {
 
 void Node::DispatchPickedUpMessage(Node* by_node) {
   assert(by_node);
-  PythonRef args(Py_BuildValue("(O)", by_node->BorrowPyRef()),
-                 PythonRef::kSteal);
   PythonRef instance;
   {
     Python::ScopedCallLabel label("PickedUpMessage instantiation");
     instance = g_scene_v1->python->objs()
                    .Get(SceneV1Python::ObjID::kPickedUpMessageClass)
-                   .Call(args);
+                   .CallArgs(by_node->BorrowPyRef());
   }
   if (instance.exists()) {
     DispatchUserMessage(instance.get(), "Node PickedUpMessage dispatch");
@@ -323,14 +434,12 @@ void Node::DispatchPickedUpMessage(Node* by_node) {
 
 void Node::DispatchDroppedMessage(Node* by_node) {
   assert(by_node);
-  PythonRef args(Py_BuildValue("(O)", by_node->BorrowPyRef()),
-                 PythonRef::kSteal);
   PythonRef instance;
   {
     Python::ScopedCallLabel label("DroppedMessage instantiation");
     instance = g_scene_v1->python->objs()
                    .Get(SceneV1Python::ObjID::kDroppedMessageClass)
-                   .Call(args);
+                   .CallArgs(by_node->BorrowPyRef());
   }
   if (instance.exists()) {
     DispatchUserMessage(instance.get(), "Node DroppedMessage dispatch");
@@ -357,13 +466,13 @@ void Node::DispatchShouldShatterMessage() {
 }
 
 void Node::DispatchImpactDamageMessage(float intensity) {
-  PythonRef args(Py_BuildValue("(f)", intensity), PythonRef::kSteal);
+  auto intensity_obj = PythonRef::Stolen(PyFloat_FromDouble(intensity));
   PythonRef instance;
   {
     Python::ScopedCallLabel label("ImpactDamageMessage instantiation");
     instance = g_scene_v1->python->objs()
                    .Get(SceneV1Python::ObjID::kImpactDamageMessageClass)
-                   .Call(args);
+                   .CallArgs(intensity_obj.get());
   }
   if (instance.exists()) {
     DispatchUserMessage(instance.get(), "Node ImpactDamageMessage dispatch");
@@ -394,7 +503,7 @@ void Node::DispatchUserMessage(PyObject* obj, const char* label) {
       PythonRef c(handlemessage_obj, PythonRef::kSteal);
       {
         Python::ScopedCallLabel lscope(label);
-        c.Call(PythonRef(Py_BuildValue("(O)", obj), PythonRef::kSteal));
+        c.CallArgs(obj);
       }
     } catch (const std::exception& e) {
       g_core->Log(LogName::kBa, LogLevel::kError,
@@ -428,6 +537,32 @@ auto NodeType::GetAttributeNames() const -> std::vector<std::string> {
   return names;
 }
 
+auto NodeType::GetAttributeForPyName(PyObject* name)
+    -> NodeAttributeUnbound* {
+  assert(Python::HaveGIL());
+  assert(PyUnicode_Check(name));
+  auto i = attributes_by_py_name_.find(name);
+  if (i != attributes_by_py_name_.end()) {
+    return i->second;
+  }
+  const char* name_str = PyUnicode_AsUTF8(name);
+  if (!name_str) {
+    throw Exception("Invalid attribute name.");
+  }
+  auto* attr = GetAttribute(name_str, false);
+
+  // Only interned strs are worth keying by pointer; others are generally
+  // built on the fly and would never hit again. We hold a ref to each key
+  // so its address can't get recycled, and cap the size in case something
+  // is interning names programmatically.
+  if (PyUnicode_CHECK_INTERNED(name)
+      && attributes_by_py_name_.size() < kMaxNodeTypePyNameCacheSize) {
+    Py_INCREF(name);
+    attributes_by_py_name_[name] = attr;
+  }
+  return attr;
+}
+
 void Node::ListAttributes(std::list<std::string>* attrs) {
   attrs->clear();
 
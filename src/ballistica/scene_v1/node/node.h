@@ -21,7 +21,13 @@ namespace ballistica::scene_v1 {
     return Object::NewDeferred<BA_NODE_TYPE_CLASS>(sg); \
   }
 
-typedef std::list<Object::Ref<Node> > NodeList;
+/// Identifies a node's slot in its scene's NodeList. The generation
+/// changes each time a slot is reused, so stale handles can be detected.
+struct NodeHandle {
+  static constexpr uint32_t kInvalidIndex{0xFFFFFFFF};
+  uint32_t index{kInvalidIndex};
+  uint32_t generation{};
+};
 
 // Base node class.
 class Node : public Object {
@@ -32,8 +38,16 @@ class Node : public Object {
   /// Return the node's id in its scene.
   auto id() const -> int64_t { return id_; }
 
-  /// Called for each step of the sim.
-  virtual void Step() {}
+  /// Called for each step of the sim while needs_step() is set. Types
+  /// that don't override this have nothing to do, so they drop out of
+  /// stepping after the first call and cost the scene nothing after that.
+  virtual void Step() { needs_step_ = false; }
+
+  /// Whether the scene should call Step() on us. A node going idle can
+  /// clear this and set it again when something (say, an attr setter)
+  /// gives it work to do. Attr connections are updated either way.
+  auto needs_step() const -> bool { return needs_step_; }
+  void set_needs_step(bool val) { needs_step_ = val; }
 
   /// Called when screen size changes.
   virtual void OnScreenSizeChange() {}
@@ -115,6 +129,24 @@ class Node : public Object {
                                            float* hand_offset_1,
                                            float* hand_offset_2);
 
+  /// Called for each Node before any Draw() calls for a frame. This may
+  /// run on a worker thread concurrently with other nodes' PrepareDraw(),
+  /// so it must only do self-contained work on the node's own plain data;
+  /// no Objects, refs, Python, or other shared state. Nodes can do
+  /// expensive per-frame math here and leave Draw() to just submit it.
+  virtual void PrepareDraw(base::FrameDef* frame_def) {}
+
+  /// Nodes can opt in to draw culling by returning true and filling out a
+  /// vertical column that everything they draw falls within: a sphere of
+  /// radius around top, swept down to bottom_y (so blotches and shadows
+  /// cast onto whatever is below get included). Draw() is then skipped in
+  /// frames where the column can't be seen, so nodes should only opt in if
+  /// their Draw() has no side effects beyond submitting rendering.
+  virtual auto GetDrawBounds(Vector3f* top, float* bottom_y, float* radius)
+      -> bool {
+    return false;
+  }
+
   /// Called for each Node when it should render itself.
   virtual void Draw(base::FrameDef* frame_def);
 
@@ -131,6 +163,12 @@ class Node : public Object {
   virtual auto GetResyncDataSize() -> int;
   virtual auto GetResyncData() -> std::vector<uint8_t>;
   virtual void ApplyResyncData(const std::vector<uint8_t>& data);
+
+  /// How many periodic physics corrections in a row this node's bodies
+  /// have all been asleep for (see Scene::GetCorrectionMessage).
+  auto correction_rest_count() const { return correction_rest_count_; }
+  void set_correction_rest_count(int val) { correction_rest_count_ = val; }
+
   auto context_ref() const -> const ContextRefSceneV1& { return context_ref_; }
 
   /// Node labels are purely for local debugging - they aren't unique or
@@ -146,7 +184,7 @@ class Node : public Object {
   auto HasAttribute(const std::string& name) const -> bool;
   auto HasPyRef() -> bool { return (py_ref_ != nullptr); }
   void UpdateConnections();
-  auto iterator() -> NodeList::iterator { return iterator_; }
+  auto handle() const -> const NodeHandle& { return handle_; }
 
   void CheckBodies();
 
@@ -200,6 +238,9 @@ class Node : public Object {
   virtual void HandleMessage(const char* buffer);
 
  private:
+  /// Destructor path for when our whole scene is going down at once.
+  void TearDown_();
+
   int64_t stream_id_{-1};
   NodeType* node_type_ = nullptr;
 
@@ -213,7 +254,9 @@ class Node : public Object {
   std::vector<Object::WeakRef<Node> > dependent_nodes_;
   std::vector<Part*> parts_;
   int64_t id_{};
-  NodeList::iterator iterator_;
+  NodeHandle handle_;
+  bool needs_step_{true};
+  int correction_rest_count_{};
 
   // Put this stuff at the bottom so it gets killed first
   PythonRef delegate_;
@@ -229,6 +272,89 @@ class Node : public Object {
   friend class NodeAttributeUnbound;
 };
 
+/// Holds strong refs to a scene's nodes in creation order.
+///
+/// Nodes live contiguously in a vector so stepping and drawing them walks
+/// memory linearly, and are looked up through generation-checked handles.
+/// Removing a node simply clears its entry; entries are squeezed out in
+/// Compact(), which must not be called during iteration. This means nodes
+/// can be both added and removed while iterating: added nodes will be
+/// visited and removed ones will be skipped.
+class NodeList {
+ public:
+  class Iterator {
+   public:
+    Iterator(const NodeList* list, size_t index) : list_(list), index_(index) {
+      SkipEmpty_();
+    }
+    auto operator*() const -> Node* { return list_->nodes_[index_].get(); }
+    auto operator++() -> Iterator& {
+      ++index_;
+      SkipEmpty_();
+      return *this;
+    }
+
+    // We check against the list's live size instead of an index captured
+    // up front so that nodes added during iteration get visited.
+    auto operator!=(const Iterator& other) const -> bool {
+      bool at_end = index_ >= list_->nodes_.size();
+      bool other_at_end = other.index_ >= other.list_->nodes_.size();
+      return at_end != other_at_end || (!at_end && index_ != other.index_);
+    }
+
+   private:
+    void SkipEmpty_() {
+      while (index_ < list_->nodes_.size() && !list_->nodes_[index_].exists()) {
+        ++index_;
+      }
+    }
+    const NodeList* list_;
+    size_t index_;
+  };
+
+  NodeList() = default;
+  NodeList(const NodeList&) = delete;
+  auto operator=(const NodeList&) -> NodeList& = delete;
+
+  /// Add a node to the end of the list, returning its handle.
+  auto Add(Node* node) -> NodeHandle;
+
+  /// Remove a node. Its entry is emptied in place so any iteration in
+  /// progress is unaffected.
+  void Remove(const NodeHandle& handle);
+
+  /// Return the node for a handle, or nullptr if it has been removed.
+  auto Get(const NodeHandle& handle) const -> Node*;
+
+  /// Squeeze out entries for removed nodes. Must not be called while
+  /// iterating.
+  void Compact();
+
+  /// Remove all nodes.
+  void Clear();
+
+  auto size() const -> size_t { return nodes_.size() - empty_count_; }
+
+  /// Raw entry access for splitting up work by index. Entries for removed
+  /// nodes (until the next Compact()) are nullptr.
+  auto entry_count() const -> size_t { return nodes_.size(); }
+  auto GetEntry(size_t index) const -> Node* { return nodes_[index].get(); }
+  auto begin() const -> Iterator { return {this, 0}; }
+  auto end() const -> Iterator { return {this, nodes_.size()}; }
+
+ private:
+  struct Slot_ {
+    uint32_t node_index{};
+    uint32_t generation{};
+  };
+
+  std::vector<Object::Ref<Node> > nodes_;
+  std::vector<uint32_t> node_slots_;
+  std::vector<Slot_> slots_;
+  std::vector<uint32_t> free_slots_;
+  size_t empty_count_{};
+};
+
 }  // namespace ballistica::scene_v1
 
 #endif  // BALLISTICA_SCENE_V1_NODE_NODE_H_
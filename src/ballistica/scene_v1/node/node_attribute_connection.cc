@@ -3,6 +3,7 @@
 #include "ballistica/scene_v1/node/node_attribute_connection.h"
 
 #include <string>
+#include <vector>
 
 #include "ballistica/scene_v1/node/node.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
@@ -10,9 +11,89 @@
 
 namespace ballistica::scene_v1 {
 
+// Pulls data from the src attr as the dst attr's native type and sets it.
+template <typename T, T (NodeAttributeUnbound::*Get)(Node*)>
+static void CopyAttr(NodeAttributeUnbound* src_attr, Node* src_node,
+                     NodeAttributeUnbound* dst_attr, Node* dst_node) {
+  dst_attr->Set(dst_node, (src_attr->*Get)(src_node));
+}
+
+void NodeAttributeConnection::Resolve() {
+  assert(src_node.exists() && dst_node.exists());
+
+  // Attrs live statically in node types, so we can hold on to these for
+  // our lifetime instead of looking them up each update.
+  src_attr_ = src_node->type()->GetAttribute(src_attr_index);
+  assert(src_attr_);
+  dst_attr_ = dst_node->type()->GetAttribute(dst_attr_index);
+  assert(dst_attr_);
+  using U = NodeAttributeUnbound;
+  switch (dst_attr_->type()) {
+    case NodeAttributeType::kFloat:
+      copy_call_ = CopyAttr<float, &U::GetAsFloat>;
+      break;
+    case NodeAttributeType::kInt:
+      copy_call_ = CopyAttr<int64_t, &U::GetAsInt>;
+      break;
+    case NodeAttributeType::kBool:
+      copy_call_ = CopyAttr<bool, &U::GetAsBool>;
+      break;
+    case NodeAttributeType::kString:
+      copy_call_ = CopyAttr<std::string, &U::GetAsString>;
+      break;
+    case NodeAttributeType::kIntArray:
+      copy_call_ = CopyAttr<std::vector<int64_t>, &U::GetAsInts>;
+      break;
+    case NodeAttributeType::kFloatArray:
+      copy_call_ = CopyAttr<std::vector<float>, &U::GetAsFloats>;
+      break;
+    case NodeAttributeType::kNode:
+      copy_call_ = CopyAttr<Node*, &U::GetAsNode>;
+      break;
+    case NodeAttributeType::kNodeArray:
+      copy_call_ = CopyAttr<std::vector<Node*>, &U::GetAsNodes>;
+      break;
+    case NodeAttributeType::kPlayer:
+      copy_call_ = CopyAttr<Player*, &U::GetAsPlayer>;
+      break;
+    case NodeAttributeType::kMaterialArray:
+      copy_call_ = CopyAttr<std::vector<Material*>, &U::GetAsMaterials>;
+      break;
+    case NodeAttributeType::kTexture:
+      copy_call_ = CopyAttr<SceneTexture*, &U::GetAsTexture>;
+      break;
+    case NodeAttributeType::kTextureArray:
+      copy_call_ = CopyAttr<std::vector<SceneTexture*>, &U::GetAsTextures>;
+      break;
+    case NodeAttributeType::kSound:
+      copy_call_ = CopyAttr<SceneSound*, &U::GetAsSound>;
+      break;
+    case NodeAttributeType::kSoundArray:
+      copy_call_ = CopyAttr<std::vector<SceneSound*>, &U::GetAsSounds>;
+      break;
+    case NodeAttributeType::kMesh:
+      copy_call_ = CopyAttr<SceneMesh*, &U::GetAsMesh>;
+      break;
+    case NodeAttributeType::kMeshArray:
+      copy_call_ = CopyAttr<std::vector<SceneMesh*>, &U::GetAsMeshes>;
+      break;
+    case NodeAttributeType::kCollisionMesh:
+      copy_call_ = CopyAttr<SceneCollisionMesh*, &U::GetAsCollisionMesh>;
+      break;
+    case NodeAttributeType::kCollisionMeshArray:
+      copy_call_ = CopyAttr<std::vector<SceneCollisionMesh*>,
+                            &U::GetAsCollisionMeshes>;
+      break;
+    default:
+      // Leave this unset; Update() will report it.
+      copy_call_ = nullptr;
+      break;
+  }
+}
+
 void NodeAttributeConnection::Update() {
   assert(src_node.exists() && dst_node.exists());
-  auto* src_node_p{src_node.get()};
+  assert(src_attr_ && dst_attr_);
 
   // We no longer update after errors now.
   // (the constant stream of exceptions slows things down too much)
@@ -21,91 +102,30 @@ void NodeAttributeConnection::Update() {
   }
 
   try {
-    // Pull data from the src to match the dst type.
-    NodeAttributeUnbound* src_attr =
-        src_node->type()->GetAttribute(src_attr_index);
-    assert(src_attr);
-    NodeAttributeUnbound* dst_attr =
-        dst_node->type()->GetAttribute(dst_attr_index);
-    assert(dst_attr);
-    switch (dst_attr->type()) {
-      case NodeAttributeType::kFloat:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsFloat(src_node_p));
-        break;
-      case NodeAttributeType::kInt:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsInt(src_node_p));
-        break;
-      case NodeAttributeType::kBool:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsBool(src_node_p));
-        break;
-      case NodeAttributeType::kString:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsString(src_node_p));
-        break;
-      case NodeAttributeType::kIntArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsInts(src_node_p));
-        break;
-      case NodeAttributeType::kFloatArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsFloats(src_node_p));
-        break;
-      case NodeAttributeType::kNode:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsNode(src_node_p));
-        break;
-      case NodeAttributeType::kNodeArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsNodes(src_node_p));
-        break;
-      case NodeAttributeType::kPlayer:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsPlayer(src_node_p));
-        break;
-      case NodeAttributeType::kMaterialArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsMaterials(src_node_p));
-        break;
-      case NodeAttributeType::kTexture:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsTexture(src_node_p));
-        break;
-      case NodeAttributeType::kTextureArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsTextures(src_node_p));
-        break;
-      case NodeAttributeType::kSound:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsSound(src_node_p));
-        break;
-      case NodeAttributeType::kSoundArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsSounds(src_node_p));
-        break;
-      case NodeAttributeType::kMesh:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsMesh(src_node_p));
-        break;
-      case NodeAttributeType::kMeshArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsMeshes(src_node_p));
-        break;
-      case NodeAttributeType::kCollisionMesh:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsCollisionMesh(src_node_p));
-        break;
-      case NodeAttributeType::kCollisionMeshArray:
-        dst_attr->Set(dst_node.get(),
-                      src_attr->GetAsCollisionMeshes(src_node_p));
-        break;
-      default:
-        throw Exception("FIXME: unimplemented for attr type: '"
-                        + dst_attr->GetTypeName() + "'");
+    if (!copy_call_) {
+      throw Exception("FIXME: unimplemented for attr type: '"
+                      + dst_attr_->GetTypeName() + "'");
     }
+    copy_call_(src_attr_, src_node.get(), dst_attr_, dst_node.get());
   } catch (const std::exception& e) {
-    // Print errors only once per connection to avoid overwhelming the logs.
-    // (though we now stop updating after an error so this is redundant).
-    if (!have_error) {
-      have_error = true;
-      NodeAttributeUnbound* src_attr =
-          src_node->type()->GetAttribute(src_attr_index);
-      NodeAttributeUnbound* dst_attr =
-          dst_node->type()->GetAttribute(dst_attr_index);
-      g_core->Log(LogName::kBa, LogLevel::kError,
-                  "Attribute connection update: " + std::string(e.what())
-                      + "; srcAttr='" + src_attr->name() + "', src_node='"
-                      + src_node->type()->name() + "', srcNodeName='"
-                      + src_node->label() + "', dstAttr='" + dst_attr->name()
-                      + "', dstNode='" + dst_node->type()->name()
-                      + "', dstNodeName='" + dst_node->label() + "'");
-    }
+    LogError_(e);
+  }
+}
+
+void NodeAttributeConnection::LogError_(const std::exception& e) {
+  // Print errors only once per connection to avoid overwhelming the logs.
+  // (though we now stop updating after an error so this is redundant).
+  if (have_error) {
+    return;
   }
+  have_error = true;
+  g_core->Log(LogName::kBa, LogLevel::kError,
+              "Attribute connection update: " + std::string(e.what())
+                  + "; srcAttr='" + src_attr_->name() + "', src_node='"
+                  + src_node->type()->name() + "', srcNodeName='"
+                  + src_node->label() + "', dstAttr='" + dst_attr_->name()
+                  + "', dstNode='" + dst_node->type()->name()
+                  + "', dstNodeName='" + dst_node->label() + "'");
 }
 
 }  // namespace ballistica::scene_v1
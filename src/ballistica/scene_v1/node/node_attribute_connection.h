@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_SCENE_V1_NODE_NODE_ATTRIBUTE_CONNECTION_H_
 #define BALLISTICA_SCENE_V1_NODE_NODE_ATTRIBUTE_CONNECTION_H_
 
+#include <exception>
 #include <list>
 
 #include "ballistica/scene_v1/scene_v1.h"
@@ -13,6 +14,10 @@ namespace ballistica::scene_v1 {
 class NodeAttributeConnection : public Object {
  public:
   NodeAttributeConnection() = default;
+
+  /// Look up our attrs and pick the copy routine for their types. Must be
+  /// called once the node/index fields are set and before any Update().
+  void Resolve();
   void Update();
   Object::WeakRef<Node> src_node;
   int src_attr_index{};
@@ -20,6 +25,14 @@ class NodeAttributeConnection : public Object {
   int dst_attr_index{};
   bool have_error{};
   std::list<Object::Ref<NodeAttributeConnection> >::iterator src_iterator;
+
+ private:
+  using CopyCall = void (*)(NodeAttributeUnbound* src_attr, Node* src_node,
+                            NodeAttributeUnbound* dst_attr, Node* dst_node);
+  void LogError_(const std::exception& e);
+  NodeAttributeUnbound* src_attr_{};
+  NodeAttributeUnbound* dst_attr_{};
+  CopyCall copy_call_{};
 };
 
 }  // namespace ballistica::scene_v1
@@ -51,6 +51,13 @@ class NodeType {
 
   auto GetAttributeNames() const -> std::vector<std::string>;
 
+  /// Like GetAttribute(name, false) but for a Python str. Results for
+  /// interned strs (which attribute names in Python source always are) are
+  /// cached by pointer, so repeat lookups skip building and hashing a
+  /// std::string. Misses are cached too since method lookups such as
+  /// node.exists() come through here as well. Requires the GIL.
+  auto GetAttributeForPyName(PyObject* name) -> NodeAttributeUnbound*;
+
   auto Create(Scene* sg) -> Node* {
     assert(create_call_);
     return create_call_(sg);
@@ -73,6 +80,7 @@ class NodeType {
   std::string name_;
   std::unordered_map<std::string, NodeAttributeUnbound*> attributes_by_name_;
   std::vector<NodeAttributeUnbound*> attributes_by_index_;
+  std::unordered_map<PyObject*, NodeAttributeUnbound*> attributes_by_py_name_;
   friend class NodeAttributeUnbound;
 };
 
@@ -216,6 +216,21 @@ void PropNode::Draw(base::FrameDef* frame_def) {
 #endif  // !BA_HEADLESS_BUILD
 }
 
+auto PropNode::GetDrawBounds(Vector3f* top, float* bottom_y, float* radius)
+    -> bool {
+  if (!body_.exists()) {
+    return false;
+  }
+  const dReal* pos_raw = dGeomGetPosition(body_->geom());
+  *top = Vector3f(pos_raw[0], pos_raw[1], pos_raw[2]) + body_->blend_offset();
+  *bottom_y = scene()->bounds_min()[1];
+
+  // Our meshes are roughly unit-sized; shadow blotches can grow to a bit
+  // over twice their shadow size across.
+  *radius = (2.0f + 5.0f * shadow_size_) * mesh_scale_ * extra_mesh_scale_;
+  return true;
+}
+
 auto PropNode::GetBody() const -> std::string {
   switch (body_type_) {
     case BodyType::UNSET:
@@ -392,6 +407,7 @@ void PropNode::SetVelocity(const std::vector<float>& vals) {
   }
   // if we've got a body, apply the velocity to that
   if (body_.exists()) {
+    body_->Wake();
     dBodySetLinearVel(body_->body(), vals[0], vals[1], vals[2]);
   } else {
     // otherwise just store it in our internal vector in
@@ -424,6 +440,8 @@ void PropNode::SetPosition(const std::vector<float>& vals) {
   }
   // if we've got a body, apply the position to that
   if (body_.exists()) {
+    // Wake up; otherwise we could be left hanging in mid-air.
+    body_->Wake();
     dBodySetPosition(body_->body(), vals[0], vals[1], vals[2]);
   } else {
     // otherwise just store it in our internal vector
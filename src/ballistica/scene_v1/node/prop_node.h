@@ -23,6 +23,8 @@ class PropNode : public Node {
   ~PropNode() override;
   void HandleMessage(const char* data) override;
   void Draw(base::FrameDef* frame_def) override;
+  auto GetDrawBounds(Vector3f* top, float* bottom_y, float* radius)
+      -> bool override;
   void Step() override;
   auto GetRigidBody(int id) -> RigidBody* override;
   auto is_area_of_interest() const -> bool {
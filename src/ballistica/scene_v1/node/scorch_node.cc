@@ -2,12 +2,14 @@
 
 #include "ballistica/scene_v1/node/scorch_node.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/graphics/component/simple_component.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/scene_v1/support/scene.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/math/random.h"
 
@@ -40,6 +42,7 @@ auto ScorchNode::InitType() -> NodeType* {
 }
 
 ScorchNode::ScorchNode(Scene* scene) : Node(scene, node_type) {
+  scene->AddScorchNode(this);
   rand_size_[0] = 0.7f + RandomFloat() * 0.6f;
   rand_size_[1] = 0.7f + RandomFloat() * 0.6f;
   rand_size_[2] = 0.7f + RandomFloat() * 0.6f;
@@ -63,26 +66,59 @@ void ScorchNode::SetPosition(const std::vector<float>& vals) {
   position_ = vals;
 }
 
-void ScorchNode::Draw(base::FrameDef* frame_def) {
+void ScorchNode::DrawScorches(
+    base::FrameDef* frame_def,
+    std::vector<Object::WeakRef<ScorchNode> >* nodes) {
+  nodes->erase(std::remove_if(nodes->begin(), nodes->end(),
+                              [](const Object::WeakRef<ScorchNode>& n) {
+                                return !n.exists();
+                              }),
+               nodes->end());
+  auto count = static_cast<int>(nodes->size());
+  int first = std::max(0, count - kMaxScorchMarks);
+
+  // Marks only differ by color/transform within a texture so each texture
+  // gets a single component with inline color changes.
+  for (bool big : {false, true}) {
+    auto uses_texture = [big](const Object::WeakRef<ScorchNode>& n) {
+      return n->big_ == big;
+    };
+    if (std::none_of(nodes->begin() + first, nodes->end(), uses_texture)) {
+      continue;
+    }
+    base::SimpleComponent c(frame_def->light_shadow_pass());
+    c.SetTransparent(true);
+    c.SetTexture(g_base->assets->SysTexture(
+        big ? base::SysTextureID::kScorchBig : base::SysTextureID::kScorch));
+    for (int i = first; i < count; ++i) {
+      auto* node = (*nodes)[i].get();
+      if (node->big_ != big) {
+        continue;
+      }
+      float fade{1.0f};
+      if (count > kMaxScorchMarks && i - first < kScorchFadeCount) {
+        fade = static_cast<float>(i - first + 1)
+               / static_cast<float>(kScorchFadeCount + 1);
+      }
+      node->DrawInto_(&c, fade);
+    }
+    c.Submit();
+  }
+}
+
+void ScorchNode::DrawInto_(base::SimpleComponent* c, float fade) {
   float o = presence_;
   // modulate opacity by local shadow density
   o *= g_base->graphics->GetShadowDensity(position_[0], position_[1],
                                           position_[2]);
-  base::SimpleComponent c(frame_def->light_shadow_pass());
-  c.SetTransparent(true);
-  c.SetColor(color_[0], color_[1], color_[2], o * 0.35f);
-  c.SetTexture(g_base->assets->SysTexture(big_ ? base::SysTextureID::kScorchBig
-                                               : base::SysTextureID::kScorch));
-  {
-    auto xf = c.ScopedTransform();
-    c.Translate(position_[0], position_[1], position_[2]);
-    c.Scale(o * size_ * rand_size_[0], o * size_ * rand_size_[1],
-            o * size_ * rand_size_[2]);
-    c.Rotate(Utils::precalc_rand_1(id() % kPrecalcRandsCount) * 360.0f, 0, 1,
-             0);
-    c.DrawMeshAsset(g_base->assets->SysMesh(base::SysMeshID::kScorch));
-  }
-  c.Submit();
+  c->SetColor(color_[0], color_[1], color_[2], o * fade * 0.35f);
+  auto xf = c->ScopedTransform();
+  c->Translate(position_[0], position_[1], position_[2]);
+  c->Scale(o * size_ * rand_size_[0], o * size_ * rand_size_[1],
+           o * size_ * rand_size_[2]);
+  c->Rotate(Utils::precalc_rand_1(id() % kPrecalcRandsCount) * 360.0f, 0, 1,
+            0);
+  c->DrawMeshAsset(g_base->assets->SysMesh(base::SysMeshID::kScorch));
 }
 
 }  // namespace ballistica::scene_v1
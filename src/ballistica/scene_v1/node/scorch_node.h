@@ -9,12 +9,23 @@
 
 namespace ballistica::scene_v1 {
 
+/// Most scorch marks a scene will draw at once.
+const int kMaxScorchMarks{64};
+
+/// How many of the oldest drawn scorch marks are faded out.
+const int kScorchFadeCount{16};
+
 class ScorchNode : public Node {
  public:
   static auto InitType() -> NodeType*;
   explicit ScorchNode(Scene* scene);
   ~ScorchNode() override;
-  void Draw(base::FrameDef* frame_def) override;
+
+  /// Draw a scene's scorch marks (oldest first; dead ones get pruned) in
+  /// one component per texture. Past kMaxScorchMarks the oldest drop out,
+  /// fading over the kScorchFadeCount before that.
+  static void DrawScorches(base::FrameDef* frame_def,
+                           std::vector<Object::WeakRef<ScorchNode> >* nodes);
   auto position() const -> std::vector<float> { return position_; }
   void SetPosition(const std::vector<float>& vals);
   auto presence() const -> float { return presence_; }
@@ -32,6 +43,7 @@ class ScorchNode : public Node {
   float presence_{1.0f};
   float size_{1.0f};
   bool big_{};
+  void DrawInto_(base::SimpleComponent* c, float fade);
   float rand_size_[3]{};
 };
 
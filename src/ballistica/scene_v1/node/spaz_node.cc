@@ -952,6 +952,75 @@ void SpazNode::SetHoldPositionPressed(bool val) {
 }
 
 void SpazNode::SetMoveLeftRight(float val) {
+  host_move_left_right_ = val;
+  ApplyMoveLeftRight_(Reconcile_(&predicted_left_right_, val));
+}
+
+void SpazNode::SetMoveUpDown(float val) {
+  host_move_up_down_ = val;
+  ApplyMoveUpDown_(Reconcile_(&predicted_up_down_, val));
+}
+
+void SpazNode::PredictMoveLeftRight(float val) {
+  Predict_(&predicted_left_right_, val);
+  ApplyMoveLeftRight_(val);
+}
+
+void SpazNode::PredictMoveUpDown(float val) {
+  Predict_(&predicted_up_down_, val);
+  ApplyMoveUpDown_(val);
+}
+
+// Hosts never echo more than a round trip's worth of these back at us; if
+// we're past that, something on the host is overriding our input.
+const size_t kSpazMaxPredictedMoves{32};
+const millisecs_t kSpazMovePredictionTimeout{1000};
+
+void SpazNode::Predict_(std::deque<PredictedMove_>* pending, float val) {
+  if (!pending->empty() && pending->back().value == val) {
+    return;
+  }
+  if (pending->size() >= kSpazMaxPredictedMoves) {
+    pending->pop_front();
+  }
+  pending->push_back({val, scene()->time()});
+}
+
+auto SpazNode::Reconcile_(std::deque<PredictedMove_>* pending, float host_val)
+    -> float {
+  if (pending->empty()) {
+    return host_val;
+  }
+
+  // The host has now applied everything up to this value; the rest is
+  // still in flight so keep showing the newest of it.
+  for (auto i = pending->begin(); i != pending->end(); ++i) {
+    if (i->value == host_val) {
+      pending->erase(pending->begin(), i + 1);
+      return pending->empty() ? host_val : pending->back().value;
+    }
+  }
+
+  // The host set something we never asked for; it wins.
+  pending->clear();
+  return host_val;
+}
+
+void SpazNode::ExpirePredictions_() {
+  millisecs_t cutoff = scene()->time() - kSpazMovePredictionTimeout;
+  if (!predicted_left_right_.empty()
+      && predicted_left_right_.front().time < cutoff) {
+    predicted_left_right_.clear();
+    ApplyMoveLeftRight_(host_move_left_right_);
+  }
+  if (!predicted_up_down_.empty()
+      && predicted_up_down_.front().time < cutoff) {
+    predicted_up_down_.clear();
+    ApplyMoveUpDown_(host_move_up_down_);
+  }
+}
+
+void SpazNode::ApplyMoveLeftRight_(float val) {
   if (val == move_left_right_) {
     return;
   }
@@ -960,7 +1029,7 @@ void SpazNode::SetMoveLeftRight(float val) {
       std::max(-127, std::min(127, static_cast<int>(127.0f * val))));
 }
 
-void SpazNode::SetMoveUpDown(float val) {
+void SpazNode::ApplyMoveUpDown_(float val) {
   if (val == move_up_down_) {
     return;
   }
@@ -1245,12 +1314,19 @@ void SpazNode::UpdateJoints() {
 }
 
 void SpazNode::UpdateBodiesForStyle() {
-  // Create hair bodies/joints if need be.
+  // Create hair bodies/joints if need be. Hair is cosmetic (it is nearly
+  // massless, collides softly, and sits right against the head which
+  // makes the same contacts), so headless builds skip the extra bodies
+  // and joints entirely.
+#if BA_HEADLESS_BUILD
+  DestroyHair();
+#else
   if (female_hair_) {
     CreateHair();
   } else {
     DestroyHair();
   }
+#endif  // BA_HEADLESS_BUILD
 
   // Adjust torso size.
   body_torso_->SetDimensions(torso_radius_, 0, 0, 0.2f, 0, 0, 3.0f);
@@ -1824,6 +1900,10 @@ void SpazNode::DoFlyPress() {
 void SpazNode::Step() {
   BA_DEBUG_CHECK_BODIES();
 
+  if (!predicted_left_right_.empty() || !predicted_up_down_.empty()) {
+    ExpirePredictions_();
+  }
+
   // Update our body blending values.
   {
     Object::Ref<RigidBody>* bodies[] = {&body_head_,
@@ -1859,7 +1939,7 @@ void SpazNode::Step() {
   const dReal* p_head = dGeomGetPosition(body_head_->geom());
   const dReal* p_torso = dGeomGetPosition(body_torso_->geom());
 
-  bool running_fast = false;
+  [[maybe_unused]] bool running_fast = false;
 
   // If we're associated with a player, let the game know where that player
   // is.
@@ -2079,7 +2159,8 @@ void SpazNode::Step() {
     }
   }
 
-  // Update wings if we've got 'em.
+  // Update wings if we've got 'em. (Purely visual; no need on servers).
+#if !BA_HEADLESS_BUILD
   if (wings_) {
     float maxDist = 0.8f;
     Vector3f p_wing_l = {0.0f, 0.0f, 0.0f};
@@ -2121,6 +2202,7 @@ void SpazNode::Step() {
     wing_vel_right_ *= 0.95f;
     wing_pos_right_ += wing_vel_right_;
   }
+#endif  // !BA_HEADLESS_BUILD
 
   // Toggle angular components of some joints off and on for increased
   // efficiency 93 to 123.
@@ -2309,7 +2391,7 @@ void SpazNode::Step() {
     }
   }
 
-  bool head_turning = false;
+  [[maybe_unused]] bool head_turning = false;
 
   // If we're punching.
   millisecs_t scenetime = scene()->time();
@@ -3060,7 +3142,9 @@ void SpazNode::Step() {
     }
   }
 
-  // flap wings every now and then
+  // flap wings every now and then and update eyes. All of this is
+  // purely visual so servers skip it.
+#if !BA_HEADLESS_BUILD
   if (wings_) {
     if (scene()->stepnum() % 21 == 0 && RandomFloat() > 0.9f) {
       flapping_ = true;
@@ -3133,6 +3217,7 @@ void SpazNode::Step() {
       eye_lid_angle_ = smooth * eye_lid_angle_ + (1.0f - smooth) * this_angle;
     }
   }
+#endif  // !BA_HEADLESS_BUILD
 
   // if we're dead, fall over
   if (dead_ && (knockout_ == 0)) {
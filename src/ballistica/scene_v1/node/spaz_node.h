@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_SCENE_V1_NODE_SPAZ_NODE_H_
 #define BALLISTICA_SCENE_V1_NODE_SPAZ_NODE_H_
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -233,6 +234,12 @@ class SpazNode : public Node {
   auto move_up_down() const -> float { return move_up_down_; }
   void SetMoveUpDown(float val);
 
+  /// Client-side prediction: apply our own not-yet-echoed movement input
+  /// immediately. The host's values still win; as they arrive they retire
+  /// matching predictions, and anything it never echoes times out.
+  void PredictMoveLeftRight(float val);
+  void PredictMoveUpDown(float val);
+
   // Preserve some old behavior so we dont have to re-code the demo.
   auto demo_mode() const -> bool { return demo_mode_; }
   void set_demo_mode(bool val) { demo_mode_ = val; }
@@ -261,6 +268,16 @@ class SpazNode : public Node {
                     bool shading, float death_fade, float death_scale,
                     float* add_color);
   void DoFlyPress();
+  struct PredictedMove_ {
+    float value;
+    millisecs_t time;
+  };
+  void Predict_(std::deque<PredictedMove_>* pending, float val);
+  auto Reconcile_(std::deque<PredictedMove_>* pending, float host_val)
+      -> float;
+  void ApplyMoveLeftRight_(float val);
+  void ApplyMoveUpDown_(float val);
+  void ExpirePredictions_();
 
   // Create a fixed joint between two bodies.
   // The anchor is by default at the center of the first body.
@@ -410,6 +427,10 @@ class SpazNode : public Node {
   float run_{};
   float move_left_right_{};
   float move_up_down_{};
+  float host_move_left_right_{};
+  float host_move_up_down_{};
+  std::deque<PredictedMove_> predicted_left_right_;
+  std::deque<PredictedMove_> predicted_up_down_;
   millisecs_t last_jump_time_{};
   RigidBody::Joint pickup_joint_;
   float eyes_lr_{};
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/graphics/component/simple_component.h"
@@ -135,6 +136,9 @@ void TextNode::SetText(const std::string& val) {
 }
 
 void TextNode::SetBig(bool val) {
+  if (val == big_) {
+    return;
+  }
   big_ = val;
   text_group_dirty_ = true;
   text_width_dirty_ = true;
@@ -159,16 +163,20 @@ auto TextNode::GetHAlign() const -> std::string {
 }
 
 void TextNode::SetHAlign(const std::string& val) {
-  text_group_dirty_ = true;
+  HAlign h_align;
   if (val == "left") {
-    h_align_ = HAlign::kLeft;
+    h_align = HAlign::kLeft;
   } else if (val == "right") {
-    h_align_ = HAlign::kRight;
+    h_align = HAlign::kRight;
   } else if (val == "center") {
-    h_align_ = HAlign::kCenter;
+    h_align = HAlign::kCenter;
   } else {
     throw Exception("Invalid h_align for text node: " + val);
   }
+  if (h_align != h_align_) {
+    h_align_ = h_align;
+    text_group_dirty_ = true;
+  }
 }
 
 auto TextNode::GetVAlign() const -> std::string {
@@ -192,18 +200,22 @@ auto TextNode::GetVAlign() const -> std::string {
 }
 
 void TextNode::SetVAlign(const std::string& val) {
-  text_group_dirty_ = true;
+  VAlign v_align;
   if (val == "top") {
-    v_align_ = VAlign::kTop;
+    v_align = VAlign::kTop;
   } else if (val == "bottom") {
-    v_align_ = VAlign::kBottom;
+    v_align = VAlign::kBottom;
   } else if (val == "center") {
-    v_align_ = VAlign::kCenter;
+    v_align = VAlign::kCenter;
   } else if (val == "none") {
-    v_align_ = VAlign::kNone;
+    v_align = VAlign::kNone;
   } else {
     throw Exception("Invalid v_align for text node: " + val);
   }
+  if (v_align != v_align_) {
+    v_align_ = v_align;
+    text_group_dirty_ = true;
+  }
 }
 
 auto TextNode::GetHAttach() const -> std::string {
@@ -352,11 +364,17 @@ void TextNode::Draw(base::FrameDef* frame_def) {
   }
 
   // Apply subs/resources to get our actual text if need be.
+  // (A changed raw value doesn't always mean changed final text, such as
+  // equivalent resource-string json, so only rebuild if it actually did.)
   if (text_translation_dirty_) {
-    text_translated_ = g_base->assets->CompileResourceString(text_raw_);
+    std::string text_translated =
+        g_base->assets->CompileResourceString(text_raw_);
     text_translation_dirty_ = false;
-    text_group_dirty_ = true;
-    text_width_dirty_ = true;
+    if (text_translated != text_translated_) {
+      text_translated_ = std::move(text_translated);
+      text_group_dirty_ = true;
+      text_width_dirty_ = true;
+    }
   }
 
   if (text_translated_.empty()) {
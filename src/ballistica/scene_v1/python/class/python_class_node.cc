@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/python/scene_v1_python.h"
 #include "ballistica/scene_v1/support/scene.h"
 #include "ballistica/scene_v1/support/session_stream.h"
@@ -154,12 +155,12 @@ auto PythonClassNode::tp_getattro(PythonClassNode* self, PyObject* attr)
   // If our node exists and has this attr, return it.
   // Otherwise do default python path.
   Node* node = self->node_->get();
-  const char* attr_name = PyUnicode_AsUTF8(attr);
-  if (node && node->HasAttribute(attr_name)) {
-    return SceneV1Python::GetNodeAttr(node, attr_name);
-  } else {
-    return PyObject_GenericGetAttr(reinterpret_cast<PyObject*>(self), attr);
+  if (node) {
+    if (auto* node_attr = node->type()->GetAttributeForPyName(attr)) {
+      return SceneV1Python::GetNodeAttr(NodeAttribute(node, node_attr));
+    }
   }
+  return PyObject_GenericGetAttr(reinterpret_cast<PyObject*>(self), attr);
   BA_PYTHON_CATCH;
 }
 
@@ -392,11 +393,85 @@ auto PythonClassNode::tp_setattro(PythonClassNode* self, PyObject* attr,
   if (!n) {
     throw Exception(PyExcType::kNodeNotFound);
   }
-  SceneV1Python::SetNodeAttr(n, PyUnicode_AsUTF8(attr), val);
+  SceneV1Python::SetNodeAttr(LookUpAttr_(n, attr), val);
   return 0;
   BA_PYTHON_INT_CATCH;
 }
 
+auto PythonClassNode::LookUpAttr_(Node* node, PyObject* name)
+    -> NodeAttribute {
+  assert(node);
+  if (!PyUnicode_Check(name)) {
+    throw Exception("Attribute names must be strings; got "
+                        + Python::ObjToString(name) + ".",
+                    PyExcType::kType);
+  }
+  auto* attr = node->type()->GetAttributeForPyName(name);
+  if (!attr) {
+    throw Exception("Attribute not found: '" + Python::ObjToString(name) + "'",
+                    PyExcType::kAttribute);
+  }
+  return {node, attr};
+}
+
+auto PythonClassNode::GetAttrs(PythonClassNode* self, PyObject* names)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Node* node = self->node_->get();
+  if (!node) {
+    throw Exception(PyExcType::kNodeNotFound);
+  }
+  PythonRef seq(PySequence_Fast(names, "Expected a sequence of str."),
+                PythonRef::kSteal);
+  if (!seq.exists()) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(seq.get());
+  PyObject** items = PySequence_Fast_ITEMS(seq.get());
+
+  // Look everything up before fetching anything so a bad name doesn't
+  // leave us with a partially built list.
+  std::vector<NodeAttribute> attrs;
+  attrs.reserve(count);
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    attrs.push_back(LookUpAttr_(node, items[i]));
+  }
+  PythonRef list(PyList_New(count), PythonRef::kSteal);
+  if (!list.exists()) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    PyObject* value = SceneV1Python::GetNodeAttr(attrs[i]);
+    if (!value) {
+      return nullptr;
+    }
+    PyList_SET_ITEM(list.get(), i, value);
+  }
+  return list.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+auto PythonClassNode::SetAttrs(PythonClassNode* self, PyObject* attrs)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Node* node = self->node_->get();
+  if (!node) {
+    throw Exception(PyExcType::kNodeNotFound);
+  }
+  if (!PyDict_Check(attrs)) {
+    throw Exception("Expected a dict; got " + Python::ObjToString(attrs) + ".",
+                    PyExcType::kType);
+  }
+  PyObject* key;
+  PyObject* value;
+  Py_ssize_t pos{};
+  while (PyDict_Next(attrs, &pos, &key, &value)) {
+    SceneV1Python::SetNodeAttr(LookUpAttr_(node, key), value);
+  }
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
 PyMethodDef PythonClassNode::tp_methods[] = {
     {"exists", (PyCFunction)Exists, METH_NOARGS,
      "exists() -> bool\n"
@@ -468,6 +543,28 @@ PyMethodDef PythonClassNode::tp_methods[] = {
      ">>> light = bascenev1.newnode('light')\n"
      "... loc = bascenev1.newnode('locator', attrs={'position': (0, 10, 0)})\n"
      "... loc.connectattr('position', light, 'position')\n"},
+    {"getattrs", (PyCFunction)GetAttrs, METH_O,
+     "getattrs(names: Sequence[str]) -> list[Any]\n"
+     "\n"
+     "Return the values of several node attributes at once.\n"
+     "\n"
+     "Equivalent to fetching each attribute individually, but cheaper when\n"
+     "polling many attributes per step. Unlike regular attribute access,\n"
+     "this only looks at node attributes; an AttributeError is raised for\n"
+     "any name that isn't one.\n"
+     "\n"
+     "##### Example\n"
+     ">>> pos, vel = node.getattrs(('position', 'velocity'))\n"},
+    {"setattrs", (PyCFunction)SetAttrs, METH_O,
+     "setattrs(attrs: dict[str, Any]) -> None\n"
+     "\n"
+     "Set several node attributes at once.\n"
+     "\n"
+     "Attributes are set in dict order, exactly as if each had been\n"
+     "assigned individually.\n"
+     "\n"
+     "##### Example\n"
+     ">>> node.setattrs({'color': (1, 0, 0), 'scale': 2.0})\n"},
     {"__dir__", (PyCFunction)Dir, METH_NOARGS,
      "allows inclusion of our custom attrs in standard python dir()"},
     {nullptr}};
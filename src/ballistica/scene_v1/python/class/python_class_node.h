@@ -39,8 +39,11 @@ class PythonClassNode : public PythonClass {
   static auto AddDeathAction(PythonClassNode* self, PyObject* args)
       -> PyObject*;
   static auto ConnectAttr(PythonClassNode* self, PyObject* args) -> PyObject*;
+  static auto GetAttrs(PythonClassNode* self, PyObject* names) -> PyObject*;
+  static auto SetAttrs(PythonClassNode* self, PyObject* attrs) -> PyObject*;
   static auto Dir(PythonClassNode* self) -> PyObject*;
   static auto nb_bool(PythonClassNode* self) -> int;
+  static auto LookUpAttr_(Node* node, PyObject* name) -> NodeAttribute;
   static bool s_create_empty_;
   static PyMethodDef tp_methods[];
   Object::WeakRef<Node>* node_;
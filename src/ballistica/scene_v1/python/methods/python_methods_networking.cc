@@ -26,6 +26,155 @@ namespace ballistica::scene_v1 {
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "hicpp-signed-bitwise"
 
+// -------------------- set_session_command_stats_enabled ----------------------
+
+static auto PySetSessionCommandStatsEnabled(PyObject* self, PyObject* args,
+                                            PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int enable;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enable)) {
+    return nullptr;
+  }
+  g_scene_v1->set_session_command_stats_enabled(static_cast<bool>(enable));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetSessionCommandStatsEnabledDef = {
+    "set_session_command_stats_enabled",           // name
+    (PyCFunction)PySetSessionCommandStatsEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,                  // flags
+
+    "set_session_command_stats_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Turn gathering of per-session-command stats on or off.",
+};
+
+// ----------------------- get_session_command_stats ---------------------------
+
+static auto PyGetSessionCommandStats(PyObject* self, PyObject* args,
+                                     PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  auto result = PythonRef::Stolen(PyDict_New());
+  auto& stats = g_scene_v1->session_command_stats();
+  for (size_t i = 0; i < stats.size(); ++i) {
+    if (stats[i].count == 0) {
+      continue;
+    }
+    auto count = static_cast<long long>(stats[i].count);  // NOLINT
+    auto bytes = static_cast<long long>(stats[i].bytes);  // NOLINT
+    auto compressed_bytes =
+        static_cast<long long>((stats[i].compressed_bits + 7) / 8);  // NOLINT
+    auto entry = PythonRef::Stolen(
+        Py_BuildValue("{sLsLsL}", "count", count, "bytes", bytes,
+                      "compressed_bytes", compressed_bytes));
+    PyDict_SetItemString(result.get(),
+                         SceneV1FeatureSet::GetSessionCommandName(
+                             static_cast<SessionCommand>(i)),
+                         entry.get());
+  }
+  if (reset) {
+    stats.clear();
+  }
+  return result.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetSessionCommandStatsDef = {
+    "get_session_command_stats",            // name
+    (PyCFunction)PyGetSessionCommandStats,  // method
+    METH_VARARGS | METH_KEYWORDS,           // flags
+
+    "get_session_command_stats(reset: bool = False)"
+    " -> dict[str, dict[str, int]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return counts, raw bytes, and (estimated) compressed bytes for each\n"
+    "session command type sent out by host sessions. Corrections are\n"
+    "reported as 'dynamics_correction'. Totals are per session stream;\n"
+    "not per client.",
+};
+
+// ------------------------ set_upstream_bandwidth_limit -----------------------
+
+static auto PySetUpstreamBandwidthLimit(PyObject* self, PyObject* args,
+                                        PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  long long bytes_per_second;  // NOLINT
+  static const char* kwlist[] = {"bytes_per_second", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "L",
+                                   const_cast<char**>(kwlist),
+                                   &bytes_per_second)) {
+    return nullptr;
+  }
+  auto* appmode = classic::ClassicAppMode::GetActiveOrThrow();
+  appmode->connections()->SetUpstreamLimit(
+      static_cast<int64_t>(bytes_per_second));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetUpstreamBandwidthLimitDef = {
+    "set_upstream_bandwidth_limit",            // name
+    (PyCFunction)PySetUpstreamBandwidthLimit,  // method
+    METH_VARARGS | METH_KEYWORDS,              // flags
+
+    "set_upstream_bandwidth_limit(bytes_per_second: int) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Cap total bytes per second sent to clients (0 for no cap). The cap is\n"
+    "shared evenly between clients; ones out of budget have re-sends put\n"
+    "off and game updates batched up.",
+};
+
+// ----------------------- set_spectator_relay_enabled -------------------------
+
+static auto PySetSpectatorRelayEnabled(PyObject* self, PyObject* args,
+                                       PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int enabled;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enabled)) {
+    return nullptr;
+  }
+  auto* appmode = classic::ClassicAppMode::GetActiveOrThrow();
+  appmode->connections()->set_spectator_relay_enabled(
+      static_cast<bool>(enabled));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetSpectatorRelayEnabledDef = {
+    "set_spectator_relay_enabled",            // name
+    (PyCFunction)PySetSpectatorRelayEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,             // flags
+
+    "set_spectator_relay_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "When enabled, clients may connect to us while we're connected to a\n"
+    "host and are fed the host's session stream as spectators. Takes\n"
+    "effect for the next connection to a host.",
+};
+
 // ----------------------- get_public_party_enabled  ---------------------------
 
 static auto PyGetPublicPartyEnabled(PyObject* self, PyObject* args,
@@ -920,6 +1069,10 @@ auto PythonMethodsNetworking::GetMethods() -> std::vector<PyMethodDef> {
       PyGetPublicPartyEnabledDef,
       PyChatMessageDef,
       PyGetChatMessagesDef,
+      PySetSessionCommandStatsEnabledDef,
+      PyGetSessionCommandStatsDef,
+      PySetUpstreamBandwidthLimitDef,
+      PySetSpectatorRelayEnabledDef,
   };
 }
 
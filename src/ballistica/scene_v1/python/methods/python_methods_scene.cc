@@ -4,6 +4,7 @@
 
 #include <cstdio>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -21,6 +22,7 @@
 #include "ballistica/scene_v1/connection/connection_to_client.h"
 #include "ballistica/scene_v1/dynamics/collision.h"
 #include "ballistica/scene_v1/dynamics/dynamics.h"
+#include "ballistica/scene_v1/dynamics/material/material_action.h"
 #include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/python/class/python_class_activity_data.h"
 #include "ballistica/scene_v1/python/class/python_class_session_data.h"
@@ -28,6 +30,7 @@
 #include "ballistica/scene_v1/support/client_session_replay.h"
 #include "ballistica/scene_v1/support/host_activity.h"
 #include "ballistica/scene_v1/support/host_session.h"
+#include "ballistica/scene_v1/support/replay_analyzer.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 #include "ballistica/scene_v1/support/session_stream.h"
 #include "ballistica/shared/generic/json.h"
@@ -375,6 +378,83 @@ static PyMethodDef PyNewReplaySessionDef = {
     "(internal)",
 };
 
+// ----------------------------- analyze_replay --------------------------------
+
+static auto PyAnalyzeReplay(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* file_name_obj;
+  static const char* kwlist[] = {"file_name", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "O", const_cast<char**>(kwlist), &file_name_obj)) {
+    return nullptr;
+  }
+  std::string file_name = Python::GetPyString(file_name_obj);
+
+  // This doesn't touch any session state, so let other Python threads
+  // (possibly analyzing other replays) run while we chew through it.
+  std::unique_ptr<ReplayAnalyzer> analyzer;
+  {
+    Python::ScopedInterpreterLockRelease gil_release;
+    analyzer = std::make_unique<ReplayAnalyzer>(file_name);
+    analyzer->Run();
+  }
+
+  auto set_int = [](PyObject* dict, const char* key, int64_t val) {
+    auto val_obj = PythonRef::Stolen(PyLong_FromLongLong(val));
+    PyDict_SetItemString(dict, key, val_obj.get());
+  };
+  auto commands = PythonRef::Stolen(PyDict_New());
+  const auto& command_stats = analyzer->command_stats();
+  for (size_t i = 0; i < command_stats.size(); ++i) {
+    if (command_stats[i].count == 0) {
+      continue;
+    }
+    auto entry = PythonRef::Stolen(PyDict_New());
+    set_int(entry.get(), "count", command_stats[i].count);
+    set_int(entry.get(), "bytes", command_stats[i].bytes);
+    PyDict_SetItemString(commands.get(),
+                         SceneV1FeatureSet::GetSessionCommandName(
+                             static_cast<SessionCommand>(i)),
+                         entry.get());
+  }
+  auto node_types = PythonRef::Stolen(PyDict_New());
+  for (auto&& i : analyzer->node_type_counts()) {
+    set_int(node_types.get(), i.first.c_str(), i.second);
+  }
+
+  auto result = PythonRef::Stolen(PyDict_New());
+  set_int(result.get(), "protocol_version",
+          analyzer->reader().protocol_version());
+  set_int(result.get(), "duration", analyzer->duration());
+  set_int(result.get(), "messages", analyzer->message_count());
+  set_int(result.get(), "compressed_bytes", analyzer->compressed_bytes());
+  set_int(result.get(), "uncompressed_bytes", analyzer->uncompressed_bytes());
+  set_int(result.get(), "session_resets", analyzer->session_reset_count());
+  set_int(result.get(), "corrections", analyzer->correction_count());
+  set_int(result.get(), "keyframes", analyzer->keyframe_count());
+  set_int(result.get(), "nodes_created", analyzer->nodes_created());
+  set_int(result.get(), "peak_nodes", analyzer->peak_node_count());
+  PyDict_SetItemString(result.get(), "commands", commands.get());
+  PyDict_SetItemString(result.get(), "node_types", node_types.get());
+  return result.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyAnalyzeReplayDef = {
+    "analyze_replay",              // name
+    (PyCFunction)PyAnalyzeReplay,  // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "analyze_replay(file_name: str) -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Gather stats from a replay file without playing it. This does not\n"
+    "need the logic thread and releases the GIL while working, so it can\n"
+    "be called from multiple threads to process many replays in parallel.",
+};
+
 // ------------------------------ is_in_replay ---------------------------------
 
 static auto PyIsInReplay(PyObject* self, PyObject* args, PyObject* keywds)
@@ -845,6 +925,43 @@ static PyMethodDef PyNewNodeDef = {
     "object dies. 'owner' can be another node or a bascenev1.Actor",
 };
 
+// ------------------------------- newnodes ------------------------------------
+
+static auto PyNewNodes(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* specs_obj;
+  static const char* kwlist[] = {"specs", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist), &specs_obj)) {
+    return nullptr;
+  }
+  return SceneV1Python::DoNewNodes(specs_obj);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyNewNodesDef = {
+    "newnodes",                    // name
+    (PyCFunction)PyNewNodes,       // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "newnodes(specs: Sequence[dict[str, Any]]) -> list[bascenev1.Node]\n"
+    "\n"
+    "Add a batch of nodes to the game.\n"
+    "\n"
+    "Category: **Gameplay Functions**\n"
+    "\n"
+    "Each spec is a dict with the same keys as the arguments to\n"
+    "bascenev1.newnode() ('type' is required; 'owner', 'attrs', 'name'\n"
+    "and 'delegate' are optional). All specs are validated before any\n"
+    "nodes are created, so an invalid type or attr name raises without\n"
+    "leaving a partial set of nodes behind. Nodes are created in order\n"
+    "and returned as a list.\n"
+    "\n"
+    "This is cheaper than calling newnode() many times when setting up\n"
+    "levels.",
+};
+
 // ----------------------------- printnodes ------------------------------------
 
 static auto PyPrintNodes(PyObject* self, PyObject* args) -> PyObject* {
@@ -1672,8 +1789,9 @@ static PyMethodDef PyLsObjectsDef = {
     "\n"
     "Category: **General Utility Functions**\n"
     "\n"
-    "This call only functions in debug builds of the game.\n"
-    "It prints various info about the current object count, etc.",
+    "It prints various info about the current object count, etc.\n"
+    "Release builds need the object census enabled for this to work\n"
+    "(see _babase.set_object_census_enabled()).",
 };
 
 // --------------------------- ls_input_devices --------------------------------
@@ -1759,11 +1877,184 @@ static PyMethodDef PyProtocolVersionDef = {
     "(internal)\n",
 };
 
+// ------------------------ set_step_profiling_enabled -------------------------
+
+static auto PySetStepProfilingEnabled(PyObject* self, PyObject* args,
+                                      PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int enable;
+  static const char* kwlist[] = {"enabled", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "p",
+                                   const_cast<char**>(kwlist), &enable)) {
+    return nullptr;
+  }
+  g_scene_v1->set_step_profiling_enabled(static_cast<bool>(enable));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetStepProfilingEnabledDef = {
+    "set_step_profiling_enabled",            // name
+    (PyCFunction)PySetStepProfilingEnabled,  // method
+    METH_VARARGS | METH_KEYWORDS,            // flags
+
+    "set_step_profiling_enabled(enabled: bool) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Turn gathering of scene step timings on or off.",
+};
+
+// ----------------------------- get_step_profile ------------------------------
+
+static auto GetMaterialActionTypeName(MaterialAction::Type type)
+    -> const char* {
+  switch (type) {
+    case MaterialAction::Type::NODE_MESSAGE:
+      return "node_message";
+    case MaterialAction::Type::SCRIPT_COMMAND:
+      return "script_command";
+    case MaterialAction::Type::SCRIPT_CALL:
+      return "python_call";
+    case MaterialAction::Type::SOUND:
+      return "sound";
+    case MaterialAction::Type::IMPACT_SOUND:
+      return "impact_sound";
+    case MaterialAction::Type::SKID_SOUND:
+      return "skid_sound";
+    case MaterialAction::Type::ROLL_SOUND:
+      return "roll_sound";
+    case MaterialAction::Type::NODE_MOD:
+      return "node_mod";
+    case MaterialAction::Type::PART_MOD:
+      return "part_mod";
+    case MaterialAction::Type::NODE_USER_MESSAGE:
+      return "node_user_message";
+  }
+  return "unknown";
+}
+
+static auto PyGetStepProfile(PyObject* self, PyObject* args,
+                             PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  auto& profile{g_scene_v1->step_profile()};
+  auto ms = [](microsecs_t val) { return static_cast<double>(val) / 1000.0; };
+  auto timing_dict = [&ms](const SceneV1FeatureSet::StepTiming& timing) {
+    return PythonRef::Stolen(
+        Py_BuildValue("{sLsd}", "count",
+                      static_cast<long long>(timing.count),  // NOLINT
+                      "ms", ms(timing.microsecs)));
+  };
+  auto node_types = PythonRef::Stolen(PyDict_New());
+  const auto& node_types_by_id{g_scene_v1->node_types_by_id()};
+  for (size_t i = 0; i < profile.node_types.size(); ++i) {
+    auto type = node_types_by_id.find(static_cast<int>(i));
+    if (profile.node_types[i].count == 0 || type == node_types_by_id.end()) {
+      continue;
+    }
+    PyDict_SetItemString(node_types.get(), type->second->name().c_str(),
+                         timing_dict(profile.node_types[i]).get());
+  }
+  auto action_types = PythonRef::Stolen(PyDict_New());
+  for (size_t i = 0; i < profile.material_action_types.size(); ++i) {
+    if (profile.material_action_types[i].count == 0) {
+      continue;
+    }
+    PyDict_SetItemString(
+        action_types.get(),
+        GetMaterialActionTypeName(static_cast<MaterialAction::Type>(i)),
+        timing_dict(profile.material_action_types[i]).get());
+  }
+  auto result = PythonRef::Stolen(Py_BuildValue(
+      "{sLs{sdsdsdsdsd}sOsO}", "steps",
+      static_cast<long long>(profile.steps),  // NOLINT
+      "phases", "node_step", ms(profile.node_step), "broadphase",
+      ms(profile.broadphase), "near_callback", ms(profile.near_callback),
+      "material_actions", ms(profile.material_actions), "world_step",
+      ms(profile.world_step), "node_types", node_types.get(),
+      "material_actions", action_types.get()));
+  if (reset) {
+    profile = SceneV1FeatureSet::StepProfile();
+  }
+  return result.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetStepProfileDef = {
+    "get_step_profile",             // name
+    (PyCFunction)PyGetStepProfile,  // method
+    METH_VARARGS | METH_KEYWORDS,   // flags
+
+    "get_step_profile(reset: bool = False) -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return accumulated scene step timings (in milliseconds) since the\n"
+    "last reset. Includes the step count, a 'phases' dict (node_step,\n"
+    "broadphase, near_callback, material_actions, world_step), and\n"
+    "'node_types' and 'material_actions' dicts mapping names to\n"
+    "{'count': int, 'ms': float}.",
+};
+
+// ------------------------- get_step_scheduler_stats --------------------------
+
+static auto PyGetStepSchedulerStats(PyObject* self, PyObject* args,
+                                    PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  auto& stats{g_scene_v1->step_scheduler_stats()};
+  auto result = PythonRef::Stolen(Py_BuildValue(
+      "{sLsLsLsisLsL}", "updates",
+      static_cast<long long>(stats.updates),  // NOLINT
+      "steps", static_cast<long long>(stats.steps),  // NOLINT
+      "overloaded_updates",
+      static_cast<long long>(stats.overloaded_updates),  // NOLINT
+      "max_steps_per_update", stats.max_steps_per_update, "dropped_ms",
+      static_cast<long long>(stats.dropped_millisecs),  // NOLINT
+      "max_debt_ms",
+      static_cast<long long>(stats.max_debt_millisecs)));  // NOLINT
+  if (reset) {
+    stats = SceneV1FeatureSet::StepSchedulerStats();
+  }
+  return result.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetStepSchedulerStatsDef = {
+    "get_step_scheduler_stats",            // name
+    (PyCFunction)PyGetStepSchedulerStats,  // method
+    METH_VARARGS | METH_KEYWORDS,          // flags
+
+    "get_step_scheduler_stats(reset: bool = False) -> dict[str, int]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return host-session stepping totals since the last reset: updates,\n"
+    "steps, overloaded_updates (updates that hit the catch-up or time\n"
+    "limit), max_steps_per_update, dropped_ms (time let go to slow the\n"
+    "game down) and max_debt_ms (most time carried over to catch up on).",
+};
+
 // -----------------------------------------------------------------------------
 
 auto PythonMethodsScene::GetMethods() -> std::vector<PyMethodDef> {
   return {
       PyNewReplaySessionDef,
+      PyAnalyzeReplayDef,
       PyNewHostSessionDef,
       PyGetSessionDef,
       PyGetActivityDef,
@@ -1792,6 +2083,7 @@ auto PythonMethodsScene::GetMethods() -> std::vector<PyMethodDef> {
       PySetInternalMusicDef,
       PyPrintNodesDef,
       PyNewNodeDef,
+      PyNewNodesDef,
       PyLsObjectsDef,
       PyTimeDef,
       PyTimerDef,
@@ -1799,6 +2091,9 @@ auto PythonMethodsScene::GetMethods() -> std::vector<PyMethodDef> {
       PyBaseTimerDef,
       PyLsInputDevicesDef,
       PyProtocolVersionDef,
+      PySetStepProfilingEnabledDef,
+      PyGetStepSchedulerStatsDef,
+      PyGetStepProfileDef,
   };
 }
 
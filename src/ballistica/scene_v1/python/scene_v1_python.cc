@@ -94,8 +94,12 @@ void SceneV1Python::Reset() {
 void SceneV1Python::SetNodeAttr(Node* node, const char* attr_name,
                                 PyObject* value_obj) {
   assert(node);
-  SessionStream* out_stream = node->scene()->GetSceneStream();
-  NodeAttribute attr = node->GetAttribute(attr_name);
+  SetNodeAttr(node->GetAttribute(attr_name), value_obj);
+}
+
+void SceneV1Python::SetNodeAttr(NodeAttribute attr, PyObject* value_obj) {
+  assert(attr.node);
+  SessionStream* out_stream = attr.node->scene()->GetSceneStream();
   switch (attr.type()) {
     case NodeAttributeType::kFloat: {
       float val = Python::GetPyFloat(value_obj);
@@ -346,6 +350,7 @@ auto SceneV1Python::DoNewNode(PyObject* args, PyObject* keywds) -> Node* {
   Node* node = scene->NewNode(type, name, delegate_obj);
 
   // Handle attr values fed in.
+  std::list<std::pair<NodeAttributeUnbound*, PyObject*>> attr_vals;
   if (dict) {
     if (!PyDict_Check(dict)) {
       throw Exception("Expected dict for arg 2.", PyExcType::kType);
@@ -355,9 +360,6 @@ auto SceneV1Python::DoNewNode(PyObject* args, PyObject* keywds) -> Node* {
     PyObject* value{};
     Py_ssize_t pos{};
 
-    // We want to set initial attrs in order based on their attr indices.
-    std::list<std::pair<NodeAttributeUnbound*, PyObject*>> attr_vals;
-
     // Grab all initial attr/values and add them to a list.
     while (PyDict_Next(dict, &pos, &key, &value)) {
       if (!PyUnicode_Check(key)) {
@@ -373,17 +375,26 @@ auto SceneV1Python::DoNewNode(PyObject* args, PyObject* keywds) -> Node* {
                         + " node '" + name + "'");
       }
     }
+  }
+  InitNewNode(node, &attr_vals, owner_obj);
+  return node;
+}
 
-    // Run the sets in the order of attr indices.
-    attr_vals.sort(CompareAttrIndices);
-    for (auto&& i : attr_vals) {
-      try {
-        SetNodeAttr(node, i.first->name().c_str(), i.second);
-      } catch (const std::exception& e) {
-        g_core->Log(LogName::kBa, LogLevel::kError,
-                    "Exception in initial attr set for attr '" + i.first->name()
-                        + "' on " + type + " node '" + name + "':" + e.what());
-      }
+void SceneV1Python::InitNewNode(
+    Node* node, std::list<std::pair<NodeAttributeUnbound*, PyObject*>>* attrs,
+    PyObject* owner_obj) {
+  assert(node && attrs && owner_obj);
+
+  // Run initial attr sets in the order of attr indices.
+  attrs->sort(CompareAttrIndices);
+  for (auto&& i : *attrs) {
+    try {
+      SetNodeAttr(NodeAttribute(node, i.first), i.second);
+    } catch (const std::exception& e) {
+      g_core->Log(LogName::kBa, LogLevel::kError,
+                  "Exception in initial attr set for attr '" + i.first->name()
+                      + "' on " + node->type()->name() + " node '"
+                      + node->label() + "':" + e.what());
     }
   }
 
@@ -415,7 +426,7 @@ auto SceneV1Python::DoNewNode(PyObject* args, PyObject* keywds) -> Node* {
   // do.
   try {
     // Tell clients to do the same.
-    if (SessionStream* output_stream = scene->GetSceneStream()) {
+    if (SessionStream* output_stream = node->scene()->GetSceneStream()) {
       output_stream->NodeOnCreate(node);
     }
     node->OnCreate();
@@ -424,8 +435,125 @@ auto SceneV1Python::DoNewNode(PyObject* args, PyObject* keywds) -> Node* {
                 "Exception in OnCreate() for node "
                     + ballistica::ObjToString(node) + "':" + e.what());
   }
+}
 
-  return node;
+auto SceneV1Python::DoNewNodes(PyObject* specs_obj) -> PyObject* {
+  BA_PRECONDITION(g_base->InLogicThread());
+  Scene* scene = ContextRefSceneV1::FromCurrent().GetMutableScene();
+  if (!scene) {
+    throw Exception("Can't create nodes in this context_ref.",
+                    PyExcType::kContext);
+  }
+  PythonRef specs_seq(
+      PySequence_Fast(specs_obj, "Expected a sequence of node spec dicts."),
+      PythonRef::kSteal);
+  if (!specs_seq.exists()) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(specs_seq.get());
+  PyObject** items = PySequence_Fast_ITEMS(specs_seq.get());
+
+  struct Spec {
+    NodeType* type{};
+    std::string name;
+    PyObject* owner{Py_None};
+    PyObject* delegate{Py_None};
+    std::list<std::pair<NodeAttributeUnbound*, PyObject*>> attrs;
+  };
+
+  // Validate everything up front so a bad spec can't leave us with half
+  // a map; nothing gets created until all specs check out.
+  std::vector<Spec> specs(count);
+  std::string default_location;
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    PyObject* spec_obj = items[i];
+    Spec& spec{specs[i]};
+    std::string where = "node spec " + std::to_string(i);
+    if (!PyDict_Check(spec_obj)) {
+      throw Exception("Expected a dict for " + where + "; got "
+                          + Python::ObjToString(spec_obj) + ".",
+                      PyExcType::kType);
+    }
+    PyObject* type_obj = PyDict_GetItemString(spec_obj, "type");
+    if (!type_obj || !PyUnicode_Check(type_obj)) {
+      throw Exception("Expected a str 'type' in " + where + ".",
+                      PyExcType::kType);
+    }
+    std::string type_name = PyUnicode_AsUTF8(type_obj);
+    auto type = g_scene_v1->node_types().find(type_name);
+    if (type == g_scene_v1->node_types().end()) {
+      throw Exception("Invalid node type: '" + type_name + "' in " + where
+                          + ".",
+                      PyExcType::kValue);
+    }
+    spec.type = type->second;
+    Py_ssize_t known_keys{};
+    for (auto&& key : {"type", "owner", "attrs", "name", "delegate"}) {
+      if (PyDict_GetItemString(spec_obj, key)) {
+        known_keys++;
+      }
+    }
+    if (known_keys != PyDict_Size(spec_obj)) {
+      throw Exception("Unexpected key in " + where + ": "
+                          + Python::ObjToString(spec_obj) + ".",
+                      PyExcType::kValue);
+    }
+    if (PyObject* name_obj = PyDict_GetItemString(spec_obj, "name");
+        name_obj && name_obj != Py_None) {
+      spec.name = Python::GetPyString(name_obj);
+    } else {
+      if (default_location.empty()) {
+        default_location = Python::GetPythonFileLocation();
+      }
+      spec.name = type_name + "@" + default_location;
+    }
+    if (PyObject* owner_obj = PyDict_GetItemString(spec_obj, "owner")) {
+      if (owner_obj != Py_None && !PythonClassNode::Check(owner_obj)) {
+        throw Exception("Invalid node owner in " + where + ": "
+                            + Python::ObjToString(owner_obj) + ".",
+                        PyExcType::kType);
+      }
+      spec.owner = owner_obj;
+    }
+    if (PyObject* delegate_obj = PyDict_GetItemString(spec_obj, "delegate")) {
+      spec.delegate = delegate_obj;
+    }
+    if (PyObject* attrs_obj = PyDict_GetItemString(spec_obj, "attrs");
+        attrs_obj && attrs_obj != Py_None) {
+      if (!PyDict_Check(attrs_obj)) {
+        throw Exception("Expected a dict for 'attrs' in " + where + ".",
+                        PyExcType::kType);
+      }
+      PyObject* key{};
+      PyObject* value{};
+      Py_ssize_t pos{};
+      while (PyDict_Next(attrs_obj, &pos, &key, &value)) {
+        if (!PyUnicode_Check(key)) {
+          throw Exception("Expected string key in attr dict in " + where + ".",
+                          PyExcType::kType);
+        }
+        auto* attr = spec.type->GetAttributeForPyName(key);
+        if (!attr) {
+          throw Exception("Attr not found: '" + Python::ObjToString(key)
+                              + "' on " + type_name + " node in " + where
+                              + ".",
+                          PyExcType::kAttribute);
+        }
+        spec.attrs.emplace_back(attr, value);
+      }
+    }
+  }
+
+  // Now create them all in one go.
+  PythonRef nodes(PyList_New(count), PythonRef::kSteal);
+  BA_PRECONDITION(nodes.exists());
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    Spec& spec{specs[i]};
+    Node* node = scene->NewNode(spec.type->name(), spec.name, spec.delegate);
+    InitNewNode(node, &spec.attrs, spec.owner);
+    PyList_SET_ITEM(nodes.get(), i, node->NewPyRef());
+  }
+  return nodes.NewRef();
 }
 
 // Return the node attr as a PyObject, or nullptr if the node doesn't have that
@@ -433,7 +561,11 @@ auto SceneV1Python::DoNewNode(PyObject* args, PyObject* keywds) -> Node* {
 auto SceneV1Python::GetNodeAttr(Node* node, const char* attr_name)
     -> PyObject* {
   assert(node);
-  NodeAttribute attr = node->GetAttribute(attr_name);
+  return GetNodeAttr(node->GetAttribute(attr_name));
+}
+
+auto SceneV1Python::GetNodeAttr(const NodeAttribute& attr) -> PyObject* {
+  assert(attr.node);
   switch (attr.type()) {
     case NodeAttributeType::kFloat:
       return PyFloat_FromDouble(attr.GetAsFloat());
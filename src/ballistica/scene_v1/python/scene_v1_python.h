@@ -3,7 +3,9 @@
 #ifndef BALLISTICA_SCENE_V1_PYTHON_SCENE_V1_PYTHON_H_
 #define BALLISTICA_SCENE_V1_PYTHON_SCENE_V1_PYTHON_H_
 
+#include <list>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -20,8 +22,15 @@ class SceneV1Python {
 
   static void SetNodeAttr(Node* node, const char* attr_name,
                           PyObject* value_obj);
+  static void SetNodeAttr(NodeAttribute attr, PyObject* value_obj);
   static auto DoNewNode(PyObject* args, PyObject* keywds) -> Node*;
+
+  /// Create nodes for a sequence of spec dicts (with the same keys as
+  /// newnode() args) in one pass, returning a list of them. All specs are
+  /// validated before anything is created.
+  static auto DoNewNodes(PyObject* specs_obj) -> PyObject*;
   static auto GetNodeAttr(Node* node, const char* attr_name) -> PyObject*;
+  static auto GetNodeAttr(const NodeAttribute& attr) -> PyObject*;
   static auto GetPyHostActivity(PyObject* o) -> HostActivity*;
   static auto IsPyHostActivity(PyObject* o) -> bool;
   static auto GetPyNode(PyObject* o, bool allow_empty_ref = false,
@@ -95,6 +104,7 @@ class SceneV1Python {
     kFilterChatMessageCall,
     kHandleLocalChatMessageCall,
     kHostInfoClass,
+    kDispatchCollisionBatchCall,
     kLast  // Sentinel; must be at end.
   };
 
@@ -114,6 +124,10 @@ class SceneV1Python {
       -> bool;
   auto HandleCapturedKeyPress(const SDL_Keysym& keysym) -> bool;
   auto HandleCapturedKeyRelease(const SDL_Keysym& keysym) -> bool;
+  static void InitNewNode(
+      Node* node,
+      std::list<std::pair<NodeAttributeUnbound*, PyObject*>>* attrs,
+      PyObject* owner_obj);
 
   PythonObjectSet<ObjID> objs_;
   PythonRef joystick_capture_call_;
@@ -69,6 +69,7 @@ void SceneV1FeatureSet::OnModuleExec(PyObject* module) {
   g_base = base::BaseFeatureSet::Import();
 
   g_core->Log(LogName::kBaLifecycle, LogLevel::kInfo, "_bascenev1 exec end");
+  g_core->MarkStartupPhase("bascenev1_exec");
 }
 
 SceneV1FeatureSet::SceneV1FeatureSet() : python{new SceneV1Python()} {
@@ -143,6 +144,123 @@ void SceneV1FeatureSet::ResetRandomNames() {
   random_name_registry_->clear();
 }
 
+auto SceneV1FeatureSet::GetSessionCommandName(SessionCommand cmd)
+    -> const char* {
+  switch (cmd) {
+    case SessionCommand::kBaseTimeStep:
+      return "base_time_step";
+    case SessionCommand::kStepSceneGraph:
+      return "step_scene_graph";
+    case SessionCommand::kAddSceneGraph:
+      return "add_scene_graph";
+    case SessionCommand::kRemoveSceneGraph:
+      return "remove_scene_graph";
+    case SessionCommand::kAddNode:
+      return "add_node";
+    case SessionCommand::kNodeOnCreate:
+      return "node_on_create";
+    case SessionCommand::kSetForegroundScene:
+      return "set_foreground_scene";
+    case SessionCommand::kRemoveNode:
+      return "remove_node";
+    case SessionCommand::kAddMaterial:
+      return "add_material";
+    case SessionCommand::kRemoveMaterial:
+      return "remove_material";
+    case SessionCommand::kAddMaterialComponent:
+      return "add_material_component";
+    case SessionCommand::kAddTexture:
+      return "add_texture";
+    case SessionCommand::kRemoveTexture:
+      return "remove_texture";
+    case SessionCommand::kAddMesh:
+      return "add_mesh";
+    case SessionCommand::kRemoveMesh:
+      return "remove_mesh";
+    case SessionCommand::kAddSound:
+      return "add_sound";
+    case SessionCommand::kRemoveSound:
+      return "remove_sound";
+    case SessionCommand::kAddCollisionMesh:
+      return "add_collision_mesh";
+    case SessionCommand::kRemoveCollisionMesh:
+      return "remove_collision_mesh";
+    case SessionCommand::kConnectNodeAttribute:
+      return "connect_node_attribute";
+    case SessionCommand::kNodeMessage:
+      return "node_message";
+    case SessionCommand::kSetNodeAttrFloat:
+      return "set_node_attr_float";
+    case SessionCommand::kSetNodeAttrInt32:
+      return "set_node_attr_int32";
+    case SessionCommand::kSetNodeAttrBool:
+      return "set_node_attr_bool";
+    case SessionCommand::kSetNodeAttrFloats:
+      return "set_node_attr_floats";
+    case SessionCommand::kSetNodeAttrInt32s:
+      return "set_node_attr_int32s";
+    case SessionCommand::kSetNodeAttrString:
+      return "set_node_attr_string";
+    case SessionCommand::kSetNodeAttrNode:
+      return "set_node_attr_node";
+    case SessionCommand::kSetNodeAttrNodeNull:
+      return "set_node_attr_node_null";
+    case SessionCommand::kSetNodeAttrNodes:
+      return "set_node_attr_nodes";
+    case SessionCommand::kSetNodeAttrPlayer:
+      return "set_node_attr_player";
+    case SessionCommand::kSetNodeAttrPlayerNull:
+      return "set_node_attr_player_null";
+    case SessionCommand::kSetNodeAttrMaterials:
+      return "set_node_attr_materials";
+    case SessionCommand::kSetNodeAttrTexture:
+      return "set_node_attr_texture";
+    case SessionCommand::kSetNodeAttrTextureNull:
+      return "set_node_attr_texture_null";
+    case SessionCommand::kSetNodeAttrTextures:
+      return "set_node_attr_textures";
+    case SessionCommand::kSetNodeAttrSound:
+      return "set_node_attr_sound";
+    case SessionCommand::kSetNodeAttrSoundNull:
+      return "set_node_attr_sound_null";
+    case SessionCommand::kSetNodeAttrSounds:
+      return "set_node_attr_sounds";
+    case SessionCommand::kSetNodeAttrMesh:
+      return "set_node_attr_mesh";
+    case SessionCommand::kSetNodeAttrMeshNull:
+      return "set_node_attr_mesh_null";
+    case SessionCommand::kSetNodeAttrMeshes:
+      return "set_node_attr_meshes";
+    case SessionCommand::kSetNodeAttrCollisionMesh:
+      return "set_node_attr_collision_mesh";
+    case SessionCommand::kSetNodeAttrCollisionMeshNull:
+      return "set_node_attr_collision_mesh_null";
+    case SessionCommand::kSetNodeAttrCollisionMeshes:
+      return "set_node_attr_collision_meshes";
+    case SessionCommand::kPlaySoundAtPosition:
+      return "play_sound_at_position";
+    case SessionCommand::kPlaySound:
+      return "play_sound";
+    case SessionCommand::kEmitBGDynamics:
+      return "emit_bg_dynamics";
+    case SessionCommand::kEndOfFile:
+      return "end_of_file";
+    case SessionCommand::kDynamicsCorrection:
+      return "dynamics_correction";
+    case SessionCommand::kScreenMessageBottom:
+      return "screen_message_bottom";
+    case SessionCommand::kScreenMessageTop:
+      return "screen_message_top";
+    case SessionCommand::kAddData:
+      return "add_data";
+    case SessionCommand::kRemoveData:
+      return "remove_data";
+    case SessionCommand::kCameraShake:
+      return "camera_shake";
+  }
+  return "unknown";
+}
+
 auto SceneV1FeatureSet::GetRandomName(const std::string& full_name)
     -> std::string {
   assert(g_base->InLogicThread());
@@ -78,6 +78,13 @@ const int kProtocolVersionMax = 35;
 // Sim step size in milliseconds.
 const int kGameStepMilliseconds = 8;
 
+// Most time a host session will carry over to catch up on later when it
+// falls behind and overload slowdown is off.
+const int kMaxHostSessionTimeDebtMillisecs = 1000;
+
+// Most Python attribute names a single node type will cache lookups for.
+const size_t kMaxNodeTypePyNameCacheSize = 1024;
+
 // Sim step size in seconds.
 const float kGameStepSeconds =
     (static_cast<float>(kGameStepMilliseconds) / 1000.0f);
@@ -131,10 +138,12 @@ class PythonClassSceneTexture;
 class SceneV1Python;
 class ClientSessionReplay;
 class RigidBody;
+class ScorchNode;
 class SessionStream;
 class Scene;
 class SceneV1FeatureSet;
 class Session;
+class SharedMessage;
 class SceneSound;
 class SceneTexture;
 typedef Node* NodeCreateFunc(Scene* sg);
@@ -398,6 +407,77 @@ class SceneV1FeatureSet : public FeatureSetNativeComponent {
   // random name for it.
   auto GetRandomName(const std::string& full_name) -> std::string;
 
+  /// Return a short human readable name for a session command (for stats
+  /// and debugging output).
+  static auto GetSessionCommandName(SessionCommand cmd) -> const char*;
+
+  struct SessionCommandStats {
+    int64_t count{};
+    int64_t bytes{};
+    int64_t compressed_bits{};
+  };
+
+  /// Totals for session commands sent out by host-session streams, indexed
+  /// by SessionCommand value. These are counted once per stream (not per
+  /// client) and are only gathered while enabled.
+  auto session_command_stats() -> std::vector<SessionCommandStats>& {
+    return session_command_stats_;
+  }
+  auto session_command_stats_enabled() const {
+    return session_command_stats_enabled_;
+  }
+  void set_session_command_stats_enabled(bool val) {
+    session_command_stats_enabled_ = val;
+  }
+
+  struct StepTiming {
+    int64_t count{};
+    microsecs_t microsecs{};
+  };
+
+  /// Where scene step time goes. Node step timings are indexed by node
+  /// type id and material action timings by MaterialAction::Type. Totals
+  /// cover all scenes and are only gathered while enabled.
+  struct StepProfile {
+    int64_t steps{};
+    microsecs_t node_step{};
+    microsecs_t broadphase{};
+    microsecs_t near_callback{};
+    microsecs_t material_actions{};
+    microsecs_t world_step{};
+    std::vector<StepTiming> node_types;
+    std::vector<StepTiming> material_action_types;
+  };
+  auto step_profile() -> StepProfile& { return step_profile_; }
+  auto step_profiling_enabled() const { return step_profiling_enabled_; }
+  void set_step_profiling_enabled(bool val) { step_profiling_enabled_ = val; }
+
+  /// How host sessions cope with falling behind. Each update runs at most
+  /// max_catch_up_steps fixed scene steps (<= 0 means no limit) and also
+  /// stops early if it runs too long. With overload_slowdown the leftover
+  /// time is dropped, so the game just runs slower; otherwise it is carried
+  /// into following updates (up to kMaxHostSessionTimeDebtMillisecs).
+  struct StepSchedulerSettings {
+    int max_catch_up_steps{8};
+    bool overload_slowdown{true};
+  };
+  auto step_scheduler_settings() -> StepSchedulerSettings& {
+    return step_scheduler_settings_;
+  }
+
+  /// Totals across all host sessions since the last reset.
+  struct StepSchedulerStats {
+    int64_t updates{};
+    int64_t steps{};
+    int64_t overloaded_updates{};
+    int max_steps_per_update{};
+    millisecs_t dropped_millisecs{};
+    millisecs_t max_debt_millisecs{};
+  };
+  auto step_scheduler_stats() -> StepSchedulerStats& {
+    return step_scheduler_stats_;
+  }
+
   const auto& node_types_by_id() const { return node_types_by_id_; }
   const auto& node_message_types() const { return node_message_types_; }
   const auto& node_message_formats() const { return node_message_formats_; }
@@ -421,6 +501,12 @@ class SceneV1FeatureSet : public FeatureSetNativeComponent {
   std::vector<std::string> node_message_formats_;
   std::unordered_map<std::string, std::string>* random_name_registry_{};
   std::list<std::string> default_names_;
+  std::vector<SessionCommandStats> session_command_stats_;
+  bool session_command_stats_enabled_{};
+  StepProfile step_profile_;
+  bool step_profiling_enabled_{};
+  StepSchedulerSettings step_scheduler_settings_;
+  StepSchedulerStats step_scheduler_stats_;
 };
 
 }  // namespace ballistica::scene_v1
@@ -2,7 +2,9 @@
 
 #include "ballistica/scene_v1/support/client_session.h"
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/audio/audio.h"
@@ -47,8 +49,9 @@ void ClientSession::ClearSessionObjs() {
   sounds_.clear();
   collision_meshes_.clear();
   materials_.clear();
-  commands_pending_.clear();
   commands_.clear();
+  commands_read_ = commands_ready_end_ = 0;
+  current_cmd_start_ = current_cmd_pos_ = current_cmd_end_ = 0;
   base_time_buffered_ = 0;
 }
 
@@ -77,100 +80,82 @@ void ClientSession::Draw(base::FrameDef* f) {
 }
 
 auto ClientSession::ReadByte() -> uint8_t {
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - 1) {
-    throw Exception("state read error");
-  }
-  return *(current_cmd_ptr_++);
+  CheckRead_(1);
+  return commands_[current_cmd_pos_++];
 }
 
 auto ClientSession::ReadInt32() -> int32_t {
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - 4) {
-    throw Exception("state read error");
-  }
+  CheckRead_(4);
   int32_t val;
-  memcpy(&val, current_cmd_ptr_, sizeof(val));
-  current_cmd_ptr_ += 4;
+  memcpy(&val, CurrentCmdData_(), sizeof(val));
+  current_cmd_pos_ += 4;
   return val;
 }
 
 auto ClientSession::ReadFloat() -> float {
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - 4) {
-    throw Exception("state read error");
-  }
+  CheckRead_(4);
   float val;
-  memcpy(&val, current_cmd_ptr_, 4);
-  current_cmd_ptr_ += 4;
+  memcpy(&val, CurrentCmdData_(), 4);
+  current_cmd_pos_ += 4;
   return val;
 }
 
 void ClientSession::ReadFloats(int count, float* vals) {
-  int size = 4 * count;
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - size) {
-    throw Exception("state read error");
-  }
-  memcpy(vals, current_cmd_ptr_, static_cast<size_t>(size));
-  current_cmd_ptr_ += size;
+  auto size = static_cast<size_t>(4 * count);
+  CheckRead_(size);
+  memcpy(vals, CurrentCmdData_(), size);
+  current_cmd_pos_ += size;
 }
 
 void ClientSession::ReadInt32s(int count, int32_t* vals) {
-  int size = 4 * count;
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - size) {
-    throw Exception("state read error");
-  }
-  memcpy(vals, current_cmd_ptr_, static_cast<size_t>(size));
-  current_cmd_ptr_ += size;
+  auto size = static_cast<size_t>(4 * count);
+  CheckRead_(size);
+  memcpy(vals, CurrentCmdData_(), size);
+  current_cmd_pos_ += size;
 }
 
 void ClientSession::ReadChars(int count, char* vals) {
-  int size = count;
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - size) {
-    throw Exception("state read error");
-  }
-  memcpy(vals, current_cmd_ptr_, static_cast<size_t>(size));
-  current_cmd_ptr_ += size;
+  auto size = static_cast<size_t>(count);
+  CheckRead_(size);
+  memcpy(vals, CurrentCmdData_(), size);
+  current_cmd_pos_ += size;
 }
 
 void ClientSession::ReadInt32_3(int32_t* vals) {
   size_t size = 3 * 4;
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - size) {
-    throw Exception("state read error");
-  }
-  memcpy(vals, current_cmd_ptr_, size);
-  current_cmd_ptr_ += size;
+  CheckRead_(size);
+  memcpy(vals, CurrentCmdData_(), size);
+  current_cmd_pos_ += size;
 }
 
 void ClientSession::ReadInt32_4(int32_t* vals) {
   size_t size = 4 * 4;
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - size) {
-    throw Exception("state read error");
-  }
-  memcpy(vals, current_cmd_ptr_, size);
-  current_cmd_ptr_ += size;
+  CheckRead_(size);
+  memcpy(vals, CurrentCmdData_(), size);
+  current_cmd_pos_ += size;
 }
 
 void ClientSession::ReadInt32_2(int32_t* vals) {
   size_t size = 2 * 4;
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - size) {
-    throw Exception("state read error");
-  }
-  memcpy(vals, current_cmd_ptr_, size);
-  current_cmd_ptr_ += size;
+  CheckRead_(size);
+  memcpy(vals, CurrentCmdData_(), size);
+  current_cmd_pos_ += size;
 }
 
 auto ClientSession::ReadString() -> std::string {
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - 4) {
-    throw Exception("state read error");
-  }
+  CheckRead_(4);
   int32_t size;
-  memcpy(&size, current_cmd_ptr_, sizeof(size));
-  current_cmd_ptr_ += 4;
-  std::vector<char> buffer(static_cast<size_t>(size + 1));
-  if (current_cmd_ptr_ > &(current_cmd_[0]) + current_cmd_.size() - size) {
+  memcpy(&size, CurrentCmdData_(), sizeof(size));
+  current_cmd_pos_ += 4;
+  if (size < 0) {
     throw Exception("state read error");
   }
-  memcpy(&(buffer[0]), current_cmd_ptr_, static_cast<size_t>(size));
-  current_cmd_ptr_ += size;
-  return &(buffer[0]);
+  CheckRead_(static_cast<size_t>(size));
+
+  // Stop at any embedded null, same as a c string would.
+  auto* data = reinterpret_cast<const char*>(CurrentCmdData_());
+  current_cmd_pos_ += static_cast<size_t>(size);
+  return {data, std::find(data, data + size, 0)};
 }
 
 void ClientSession::Update(int time_advance_millisecs, double time_advance) {
@@ -194,31 +179,35 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
       FetchMessages();
 
       // If we've got another command on the list, pull it and run it.
-      if (!commands_.empty()) {
-        // Debugging: if this was previously pointed at a buffer, make sure we
+      if (has_commands()) {
+        // Debugging: if we were previously running a command, make sure we
         // went exactly to the end.
         if (g_buildconfig.debug_build()) {
-          if (current_cmd_ptr_ != nullptr) {
-            if (current_cmd_ptr_ != &(current_cmd_[0]) + current_cmd_.size()) {
-              g_core->Log(
-                  LogName::kBaNetworking, LogLevel::kError,
-                  "SIZE ERROR FOR CMD "
-                      + std::to_string(static_cast<int>(current_cmd_[0]))
-                      + " expected " + std::to_string(current_cmd_.size())
-                      + " got "
-                      + std::to_string(current_cmd_ptr_ - &(current_cmd_[0])));
-            }
+          if (current_cmd_pos_ != current_cmd_end_) {
+            g_core->Log(
+                LogName::kBaNetworking, LogLevel::kError,
+                "SIZE ERROR FOR CMD "
+                    + std::to_string(
+                        static_cast<int>(commands_[current_cmd_start_]))
+                    + " expected "
+                    + std::to_string(current_cmd_end_ - current_cmd_start_)
+                    + " got "
+                    + std::to_string(current_cmd_pos_ - current_cmd_start_));
           }
-          assert(current_cmd_ptr_ == current_cmd_.data() + current_cmd_.size());
+          assert(current_cmd_pos_ == current_cmd_end_);
         }
-        current_cmd_ = commands_.front();
-        commands_.pop_front();
-        current_cmd_ptr_ = &(current_cmd_[0]);
+        CompactCommands_();
+        uint32_t size;
+        memcpy(&size, commands_.data() + commands_read_, sizeof(size));
+        current_cmd_start_ = current_cmd_pos_ = commands_read_ + sizeof(size);
+        current_cmd_end_ = current_cmd_start_ + size;
+        commands_read_ = current_cmd_end_;
       } else {
         // Let the subclass know this happened. Replays may want to pause
         // playback until more data comes in but things like net-play may want
         // to just soldier on and skip ahead once data comes in.
         OnCommandBufferUnderrun();
+        UpdateRenderBlend_();
         return;
       }
 
@@ -238,26 +227,31 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
           break;
         }
         case SessionCommand::kDynamicsCorrection: {
-          bool blend = current_cmd_[1];
+          const uint8_t* cmd_data = commands_.data() + current_cmd_start_;
+          size_t cmd_size = current_cmd_end_ - current_cmd_start_;
+          if (cmd_size < 4) {
+            throw Exception("invalid rbd correction data");
+          }
+          bool blend = cmd_data[1];
           uint32_t offset = 2;
           uint16_t node_count;
-          memcpy(&node_count, current_cmd_.data() + offset, sizeof(node_count));
+          memcpy(&node_count, cmd_data + offset, sizeof(node_count));
           offset += 2;
           for (int i = 0; i < node_count; i++) {
             uint32_t node_id;
-            memcpy(&node_id, current_cmd_.data() + offset, sizeof(node_id));
+            memcpy(&node_id, cmd_data + offset, sizeof(node_id));
             offset += 4;
-            int body_count = current_cmd_[offset++];
+            int body_count = cmd_data[offset++];
             Node* n =
                 (node_id < nodes_.size()) ? nodes_[node_id].get() : nullptr;
             for (int j = 0; j < body_count; j++) {
-              int bodyid = current_cmd_[offset++];
+              int bodyid = cmd_data[offset++];
               uint16_t body_data_len;
-              memcpy(&body_data_len, current_cmd_.data() + offset,
+              memcpy(&body_data_len, cmd_data + offset,
                      sizeof(body_data_len));
               RigidBody* b = n ? n->GetRigidBody(bodyid) : nullptr;
               offset += 2;
-              const char* p1 = reinterpret_cast<char*>(&(current_cmd_[offset]));
+              const char* p1 = reinterpret_cast<const char*>(cmd_data + offset);
               const char* p2 = p1;
               if (b) {
                 dBodyID body = b->body();
@@ -273,38 +267,39 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
                 }
               }
               offset += body_data_len;
-              if (offset > current_cmd_.size()) {
+              if (offset > cmd_size) {
                 throw Exception("Invalid rbd correction data");
               }
             }
-            if (offset > current_cmd_.size())
+            if (offset > cmd_size)
               throw Exception("Invalid rbd correction data");
 
             // Extract custom per-node data.
             uint16_t custom_data_len;
-            memcpy(&custom_data_len, current_cmd_.data() + offset,
+            memcpy(&custom_data_len, cmd_data + offset,
                    sizeof(custom_data_len));
             offset += 2;
             if (custom_data_len != 0) {
               std::vector<uint8_t> data(custom_data_len);
-              memcpy(&(data[0]), &(current_cmd_[offset]), custom_data_len);
+              memcpy(&(data[0]), cmd_data + offset, custom_data_len);
               if (n) n->ApplyResyncData(data);
               offset += custom_data_len;
             }
-            if (offset > current_cmd_.size()) {
+            if (offset > cmd_size) {
               throw Exception("Invalid rbd correction data");
             }
           }
-          if (offset != current_cmd_.size()) {
+          if (offset != cmd_size) {
             throw Exception("invalid rbd correction data");
           }
-          current_cmd_ptr_ = &(current_cmd_[0]) + offset;
+          current_cmd_pos_ = current_cmd_start_ + offset;
 
           break;
         }
         case SessionCommand::kEndOfFile: {
           // EOF can happen anytime if they run out of disk space/etc.
           // We should expect any state.
+          end_of_file_count_++;
           Reset(true);
           break;
         }
@@ -322,6 +317,7 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
           assert(!scenes_[id].exists());
           scenes_[id] = Object::New<Scene>(starttime);
           scenes_[id]->set_stream_id(id);
+          scenes_[id]->set_render_interpolation(true);
           break;
         }
         case SessionCommand::kRemoveSceneGraph: {
@@ -873,11 +869,29 @@ void ClientSession::Update(int time_advance_millisecs, double time_advance) {
                           + std::to_string(static_cast<int>(cmd)));
       }
     }
+    UpdateRenderBlend_();
   } catch (const std::exception& e) {
     Error(e.what());
   }
 }  // NOLINT  (yes this is too long)
 
+void ClientSession::UpdateRenderBlend_() {
+  // Steps arrive in bunches as base-time steps come in, so we've generally
+  // run a bit past our target time. Have rendering show where things were
+  // at the target by blending back toward the step before. (If we're
+  // starved and short of our target, just show the latest.)
+  auto overshoot = static_cast<double>(base_time_millisecs_)
+                   - target_base_time_millisecs_;
+  auto blend = static_cast<float>(
+      1.0 - overshoot / static_cast<double>(kGameStepMilliseconds));
+  blend = std::clamp(blend, 0.0f, 1.0f);
+  for (auto&& i : scenes_) {
+    if (Scene* sg = i.get()) {
+      sg->set_render_blend(blend);
+    }
+  }
+}
+
 ClientSession::~ClientSession() = default;
 
 void ClientSession::OnScreenSizeChange() {
@@ -999,17 +1013,18 @@ void ClientSession::HandleSessionMessage(const std::vector<uint8_t>& buffer) {
       // This is simply 16 bit length followed by command up to the end of the
       // packet. Break it apart and feed each command to the client session.
       uint32_t offset = 1;
-      std::vector<uint8_t> sub_buffer;
       while (true) {
         uint16_t size;
+        if (offset + 2 > buffer.size()) {
+          Error("invalid state message");
+          return;
+        }
         memcpy(&size, &(buffer[offset]), 2);
-        if (offset + size > buffer.size()) {
+        if (offset + 2 + size > buffer.size()) {
           Error("invalid state message");
           return;
         }
-        sub_buffer.resize(size);
-        memcpy(&(sub_buffer[0]), &(buffer[offset + 2]), sub_buffer.size());
-        AddCommand(sub_buffer);
+        AddCommand(buffer.data() + offset + 2, size);
         offset += 2 + size;  // move to next command
         if (offset == buffer.size()) {
           // let's also use this opportunity to graph our command-buffer size
@@ -1029,7 +1044,7 @@ void ClientSession::HandleSessionMessage(const std::vector<uint8_t>& buffer) {
       // state-ID to a command-ID.
       std::vector<uint8_t> buffer_out = buffer;
       buffer_out[0] = static_cast<uint8_t>(SessionCommand::kDynamicsCorrection);
-      AddCommand(buffer_out);
+      AddCommand(buffer_out.data(), buffer_out.size());
       break;
     }
 
@@ -1042,28 +1057,92 @@ void ClientSession::HandleSessionMessage(const std::vector<uint8_t>& buffer) {
   }
 }
 
+void ClientSession::AppendCommand_(const uint8_t* data, size_t size) {
+  auto size32 = static_cast_check_fit<uint32_t>(size);
+  auto* size_bytes = reinterpret_cast<const uint8_t*>(&size32);
+  commands_.insert(commands_.end(), size_bytes, size_bytes + sizeof(size32));
+  commands_.insert(commands_.end(), data, data + size);
+}
+
 // Add a single command in.
-void ClientSession::AddCommand(const std::vector<uint8_t>& command) {
-  // If this is a time-step command, we can dump everything we've been building
-  // up onto the list to be chewed through by the interpreter (we don't want to
-  // add things until we have the *entire* step, so we don't wind up rendering
-  // things halfway through some change, etc.).
-  commands_pending_.push_back(command);
-  if (!command.empty()) {
-    if (command[0] == static_cast<uint8_t>(SessionCommand::kBaseTimeStep)) {
-      // Keep a tally of how much stepped time we've built up.
-      base_time_buffered_ += command[1];
-
-      // Let subclasses know we just received a step in case they'd like
-      // to factor it in for rate adjustments/etc.
-      OnBaseTimeStepAdded(command[1]);
-
-      for (auto&& i : commands_pending_) {
-        commands_.push_back(i);
-      }
-      commands_pending_.clear();
+void ClientSession::AddCommand(const uint8_t* data, size_t size) {
+  // If this is a time-step command, we can mark everything we've been
+  // building up as ready to be chewed through by the interpreter (we don't
+  // want to run things until we have the *entire* step, so we don't wind up
+  // rendering things halfway through some change, etc.).
+  AppendCommand_(data, size);
+  if (size > 1
+      && data[0] == static_cast<uint8_t>(SessionCommand::kBaseTimeStep)) {
+    // Keep a tally of how much stepped time we've built up.
+    base_time_buffered_ += data[1];
+
+    // Let subclasses know we just received a step in case they'd like
+    // to factor it in for rate adjustments/etc.
+    OnBaseTimeStepAdded(data[1]);
+
+    commands_ready_end_ = commands_.size();
+  }
+}
+
+void ClientSession::GetPendingCommandMessages(
+    std::vector<std::vector<uint8_t> >* messages) {
+  assert(messages);
+  std::vector<uint8_t> commands(1, BA_MESSAGE_SESSION_COMMANDS);
+  auto flush = [messages, &commands] {
+    if (commands.size() > 1) {
+      messages->push_back(std::move(commands));
+      commands.assign(1, BA_MESSAGE_SESSION_COMMANDS);
+    }
+  };
+  size_t pos = commands_read_;
+  while (pos + sizeof(uint32_t) <= commands_.size()) {
+    uint32_t size;
+    memcpy(&size, commands_.data() + pos, sizeof(size));
+    const uint8_t* data = commands_.data() + pos + sizeof(size);
+    pos += sizeof(size) + size;
+    if (size == 0) {
+      continue;
     }
+
+    // Corrections came in as messages of their own; send them that way.
+    if (data[0] == static_cast<uint8_t>(SessionCommand::kDynamicsCorrection)) {
+      flush();
+      std::vector<uint8_t> correction(data, data + size);
+      correction[0] = BA_MESSAGE_SESSION_DYNAMICS_CORRECTION;
+      messages->push_back(std::move(correction));
+      continue;
+    }
+
+    // Everything else arrived with a 16 bit size so should go back out
+    // with one.
+    assert(size <= 0xFFFF);
+    auto size16 = static_cast<uint16_t>(size);
+    auto* size_bytes = reinterpret_cast<const uint8_t*>(&size16);
+    commands.insert(commands.end(), size_bytes, size_bytes + sizeof(size16));
+    commands.insert(commands.end(), data, data + size);
+  }
+  flush();
+}
+
+void ClientSession::AddEndOfFileCommand() {
+  // Anything from an unfinished time step would never get run anyway.
+  commands_.resize(commands_ready_end_);
+  auto cmd = static_cast<uint8_t>(SessionCommand::kEndOfFile);
+  AppendCommand_(&cmd, 1);
+  commands_ready_end_ = commands_.size();
+}
+
+void ClientSession::CompactCommands_() {
+  // Shift the unread part of the buffer down once at least half of it has
+  // been consumed; this keeps the cost per byte constant and lets the
+  // buffer's capacity settle at around twice the amount of buffered data.
+  if (commands_read_ == 0 || commands_read_ * 2 < commands_.size()) {
+    return;
   }
+  commands_.erase(commands_.begin(),
+                  commands_.begin() + static_cast<ptrdiff_t>(commands_read_));
+  commands_ready_end_ -= commands_read_;
+  commands_read_ = 0;
 }
 
 auto ClientSession::GetForegroundContext() -> base::ContextRef {
@@ -3,7 +3,6 @@
 #ifndef BALLISTICA_SCENE_V1_SUPPORT_CLIENT_SESSION_H_
 #define BALLISTICA_SCENE_V1_SUPPORT_CLIENT_SESSION_H_
 
-#include <list>
 #include <string>
 #include <vector>
 
@@ -54,10 +53,14 @@ class ClientSession : public Session {
   auto base_time() const { return base_time_millisecs_; }
   auto shutting_down() const { return shutting_down_; }
 
+  /// How many times we've hit the end of our command stream (replays
+  /// rewind and loop when this happens).
+  auto end_of_file_count() const { return end_of_file_count_; }
+
   auto scenes() const -> const std::vector<Object::Ref<Scene> >& {
     return scenes_;
   }
-  auto nodes() const -> const std::vector<Object::WeakRef<Node> >& {
+  auto nodes() const -> const std::vector<Object::Handle<Node> >& {
     return nodes_;
   }
   auto textures() const -> const std::vector<Object::Ref<SceneTexture> >& {
@@ -76,18 +79,20 @@ class ClientSession : public Session {
   auto materials() const -> const std::vector<Object::Ref<Material> >& {
     return materials_;
   }
-  auto commands() const -> const std::list<std::vector<uint8_t> >& {
-    return commands_;
-  }
-  auto add_end_of_file_command() {
-    commands_.emplace_back(1, static_cast<uint8_t>(SessionCommand::kEndOfFile));
-  }
+  /// Whether we have any complete time steps of commands ready to run.
+  auto has_commands() const { return commands_read_ < commands_ready_end_; }
+  void AddEndOfFileCommand();
   virtual void OnReset(bool rewind);
   virtual void FetchMessages() {}
   virtual void Error(const std::string& description);
   void End();
   void DumpFullState(SessionStream* out) override;
 
+  /// Build messages re-sending everything we've received but not yet run.
+  /// Along with a DumpFullState() this catches up a connection joining
+  /// partway through our stream.
+  void GetPendingCommandMessages(std::vector<std::vector<uint8_t> >* messages);
+
   /// Reset target base time to equal current. This can be used during command
   /// buffer underruns to cause playback to pause momentarily instead of
   /// skipping ahead to catch up. Generally desired for replays but not for
@@ -104,7 +109,18 @@ class ClientSession : public Session {
 
  private:
   void ClearSessionObjs();
-  void AddCommand(const std::vector<uint8_t>& command);
+  void AddCommand(const uint8_t* data, size_t size);
+  void AppendCommand_(const uint8_t* data, size_t size);
+  void CompactCommands_();
+  void UpdateRenderBlend_();
+  void CheckRead_(size_t size) const {
+    if (size > current_cmd_end_ - current_cmd_pos_) {
+      throw Exception("state read error");
+    }
+  }
+  auto CurrentCmdData_() const -> const uint8_t* {
+    return commands_.data() + current_cmd_pos_;
+  }
 
   auto ReadByte() -> uint8_t;
   auto ReadInt32() -> int32_t;
@@ -117,15 +133,22 @@ class ClientSession : public Session {
   void ReadInt32s(int count, int32_t* vals);
   void ReadChars(int count, char* vals);
 
-  // Ready-to-go commands.
-  std::list<std::vector<uint8_t> > commands_;
-
-  // Commands being built up for the next time step (we need to ship timesteps
-  // as a whole).
-  std::list<std::vector<uint8_t> > commands_pending_;
-  std::vector<uint8_t> current_cmd_;
-  uint8_t* current_cmd_ptr_{};
+  // Received commands, each stored as a 32 bit size followed by its data.
+  // Everything before commands_ready_end_ is complete time steps ready to
+  // run; anything after is still being built up (we need to run timesteps
+  // as a whole). We read through this in place and shift the unread part
+  // down once enough has been consumed, so steady playback doesn't
+  // allocate.
+  std::vector<uint8_t> commands_;
+  size_t commands_read_{};
+  size_t commands_ready_end_{};
+
+  // Bounds of the command being run (offsets into commands_).
+  size_t current_cmd_start_{};
+  size_t current_cmd_pos_{};
+  size_t current_cmd_end_{};
   int base_time_buffered_{};
+  int end_of_file_count_{};
   bool shutting_down_{};
 
   millisecs_t base_time_millisecs_{};
@@ -133,7 +156,7 @@ class ClientSession : public Session {
   float consume_rate_{1.0f};
 
   std::vector<Object::Ref<Scene> > scenes_;
-  std::vector<Object::WeakRef<Node> > nodes_;
+  std::vector<Object::Handle<Node> > nodes_;
   std::vector<Object::Ref<SceneTexture> > textures_;
   std::vector<Object::Ref<SceneMesh> > meshes_;
   std::vector<Object::Ref<SceneSound> > sounds_;
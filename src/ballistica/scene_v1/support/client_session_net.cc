@@ -3,30 +3,54 @@
 #include "ballistica/scene_v1/support/client_session_net.h"
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
-#include "ballistica/base/assets/assets_server.h"
+#include "ballistica/base/assets/replay_writer.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/support/net_graph.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/scene_v1/connection/connection_set.h"
+#include "ballistica/scene_v1/connection/connection_to_client.h"
 #include "ballistica/scene_v1/connection/connection_to_host.h"
+#include "ballistica/scene_v1/connection/shared_message.h"
+#include "ballistica/scene_v1/support/session_stream.h"
 
 namespace ballistica::scene_v1 {
 
-ClientSessionNet::ClientSessionNet() {
+// Weight given to each new delay sample in our running estimates.
+const float kJitterSampleWeight{1.0f / 16.0f};
+
+// Deviations of headroom we keep on a well behaved link, and the most we
+// will grow to on a bad one.
+const float kJitterMinDeviations{2.0f};
+const float kJitterMaxDeviations{6.0f};
+
+// Most the consume rate can move per update, so speed changes stay smooth.
+const float kMaxConsumeRateChange{0.02f};
+
+ClientSessionNet::ClientSessionNet()
+    : jitter_deviations_{kJitterMinDeviations} {
   // Sanity check: we should only ever be writing one replay at once.
   if (g_scene_v1->replay_open) {
     g_core->Log(LogName::kBaNetworking, LogLevel::kError,
                 "g_scene_v1->replay_open true at netclient start;"
                 " shouldn't happen.");
   }
-  assert(g_base->assets_server);
+  assert(g_base->replay_writer);
 
   // We always write replays as the highest protocol version we support.
-  g_base->assets_server->PushBeginWriteReplayCall(kProtocolVersionMax);
+  g_base->replay_writer->PushBeginWriteReplayCall(kProtocolVersionMax);
   writing_replay_ = true;
   g_scene_v1->replay_open = true;
+
+  // Take responsibility for feeding our own clients if we're a relay.
+  auto* appmode = classic::ClassicAppMode::GetActiveOrThrow();
+  if (appmode->connections()->spectator_relay_enabled()) {
+    appmode->connections()->RegisterClientController(this);
+    relaying_ = true;
+  }
 }
 
 ClientSessionNet::~ClientSessionNet() {
@@ -38,10 +62,52 @@ ClientSessionNet::~ClientSessionNet() {
                   " shouldn't happen.");
     }
     g_scene_v1->replay_open = false;
-    assert(g_base->assets_server);
-    g_base->assets_server->PushEndWriteReplayCall();
+    assert(g_base->replay_writer);
+    g_base->replay_writer->PushEndWriteReplayCall();
     writing_replay_ = false;
   }
+  if (relaying_) {
+    if (auto* appmode = classic::ClassicAppMode::GetActive()) {
+      appmode->connections()->UnregisterClientController(this);
+    }
+  }
+}
+
+void ClientSessionNet::OnClientConnected(ConnectionToClient* c) {
+  if (std::find(spectators_.begin(), spectators_.end(), c)
+      != spectators_.end()) {
+    g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                "ClientSessionNet::OnClientConnected()"
+                " got duplicate connection");
+    return;
+  }
+  spectators_.push_back(c);
+
+  // Catch them up: our state as of now, our dynamics as of now, and then
+  // anything we've received but not gotten to running yet.
+  SessionStream out(nullptr, false);
+  DumpFullState(&out);
+  std::vector<uint8_t> out_message = out.GetOutMessage();
+  if (!out_message.empty()) {
+    c->SendReliableMessage(out_message);
+  }
+  std::vector<std::vector<uint8_t> > messages;
+  GetCorrectionMessages(false, &messages);
+  GetPendingCommandMessages(&messages);
+  for (auto&& message : messages) {
+    c->SendReliableMessage(message);
+  }
+}
+
+void ClientSessionNet::OnClientDisconnected(ConnectionToClient* c) {
+  auto i = std::find(spectators_.begin(), spectators_.end(), c);
+  if (i == spectators_.end()) {
+    g_core->Log(LogName::kBaNetworking, LogLevel::kError,
+                "ClientSessionNet::OnClientDisconnected()"
+                " called for connection not on list");
+    return;
+  }
+  spectators_.erase(i);
 }
 
 void ClientSessionNet::SetConnectionToHost(ConnectionToHost* c) {
@@ -49,11 +115,27 @@ void ClientSessionNet::SetConnectionToHost(ConnectionToHost* c) {
 }
 
 void ClientSessionNet::OnCommandBufferUnderrun() {
-  // We currently don't do anything here; we want to just power
-  // through hitches and keep aiming for our target time.
-  // (though perhaps we could take note here for analytics purposes).
-  // printf("Underrun at %d\n", AppTimeMillisecs());
-  // fflush(stdout);
+  // We want to just power through hitches and keep aiming for our target
+  // time, but running dry means our headroom was too small for this link,
+  // so widen it. This can fire every update while we're starved; only
+  // count it once per hitch.
+  auto now = g_core->AppTimeMillisecs();
+  if (now - last_underrun_time_ > 250) {
+    jitter_deviations_ =
+        std::min(kJitterMaxDeviations, jitter_deviations_ + 0.5f);
+  }
+  last_underrun_time_ = now;
+}
+
+void ClientSessionNet::AddDelaySample(float delay) {
+  float diff = delay - delay_mean_;
+  delay_mean_ += kJitterSampleWeight * diff;
+  delay_variance_ = (1.0f - kJitterSampleWeight)
+                    * (delay_variance_ + kJitterSampleWeight * diff * diff);
+}
+
+auto ClientSessionNet::GetJitterTargetDelay() const -> float {
+  return delay_mean_ + jitter_deviations_ * std::sqrt(delay_variance_);
 }
 
 void ClientSessionNet::Update(int time_advance_millisecs, double time_advance) {
@@ -103,26 +185,38 @@ void ClientSessionNet::UpdateBuffering() {
     auto now = g_core->AppTimeMillisecs();
 
     // We want target-base-time to wind up at our projected time minus some
-    // safety offset to account for buffering fluctuations.
-
-    // We might want to consider exposing this value or calculate it in a smart
-    // way based on conditions. 0.0 gives us lowest latency possible but makes
-    // lag spikes very noticeable. 1.0 should avoid most lag spikes. Higher
-    // values even moreso at the price of latency;
-    float safety_amt{1.0};
+    // safety offset to account for buffering fluctuations. We size that
+    // from the measured delay variance so good links run with almost no
+    // buffering and jittery ones get enough to avoid stutter. Headroom we
+    // gained from underruns slowly relaxes back (roughly a minute to go
+    // from max to min at typical update rates).
+    jitter_deviations_ =
+        std::max(kJitterMinDeviations, jitter_deviations_ - 0.0005f);
+    float target_delay = GetJitterTargetDelay();
 
     float to_ideal_offset =
         static_cast<float>(ProjectedBaseTime(now) - target_base_time())
-        - safety_amt * max_delay_smoothed_;
+        - target_delay;
 
     // How aggressively we throttle the game speed up or down to accommodate lag
     // spikes.
     float speed_change_aggression{0.004f};
-    float new_consume_rate = std::min(
+    float ideal_consume_rate = std::min(
         10.0f,
         std::max(0.5f, 1.0f + speed_change_aggression * to_ideal_offset));
+
+    // Ease towards that instead of jumping so speed changes aren't jarring.
+    float new_consume_rate =
+        consume_rate()
+        + std::min(kMaxConsumeRateChange,
+                   std::max(-kMaxConsumeRateChange,
+                            ideal_consume_rate - consume_rate()));
     set_consume_rate(new_consume_rate);
 
+    g_base->graphics->SetTimingLaneValue(
+        base::TimingLane::kJitterBuffer,
+        static_cast<float>(base_time_buffered()));
+
     if (g_base->graphics->network_debug_info_display_enabled()) {
       // Plug display time into these graphs to get smoother looking updates.
       auto now_d = g_base->logic->display_time() * 1000.0;
@@ -146,6 +240,10 @@ void ClientSessionNet::UpdateBuffering() {
               g_base->graphics->GetDebugGraph("5: time buffered", true)) {
         graph->AddSample(now_d, base_time_buffered());
       }
+      if (auto* graph =
+              g_base->graphics->GetDebugGraph("6: jitter target", false)) {
+        graph->AddSample(now_d, target_delay);
+      }
     }
   }
 }
@@ -156,6 +254,9 @@ void ClientSessionNet::OnReset(bool rewind) {
   last_base_time_receive_time_ = 0;
   leading_base_time_received_ = 0;
   leading_base_time_receive_time_ = 0;
+  delay_mean_ = 0.0f;
+  delay_variance_ = 0.0f;
+  jitter_deviations_ = kJitterMinDeviations;
   ClientSession::OnReset(rewind);
 }
 
@@ -190,6 +291,7 @@ void ClientSessionNet::OnBaseTimeStepAdded(int step) {
     } else {
       current_delay_ = 0.0f;
     }
+    AddDelaySample(current_delay_);
   }
 
   base_time_received_ = new_base_time_received;
@@ -208,8 +310,17 @@ void ClientSessionNet::HandleSessionMessage(
   ClientSession::HandleSessionMessage(message);
 
   if (writing_replay_) {
-    assert(g_base->assets_server);
-    g_base->assets_server->PushAddMessageToReplayCall(message);
+    assert(g_base->replay_writer);
+    g_base->replay_writer->PushAddMessageToReplayCall(message);
+  }
+
+  // Pass it along to any spectators. Like replays, we send everything
+  // reliably so they see the stream intact.
+  if (!spectators_.empty()) {
+    auto shared = Object::New<SharedMessage>(message);
+    for (auto&& i : spectators_) {
+      i->SendReliableMessage(shared);
+    }
   }
 }
 
@@ -5,12 +5,15 @@
 
 #include <vector>
 
+#include "ballistica/scene_v1/support/client_controller_interface.h"
 #include "ballistica/scene_v1/support/client_session.h"
 
 namespace ballistica::scene_v1 {
 
-// A client-session fed by a connection to a host.
-class ClientSessionNet : public ClientSession {
+// A client-session fed by a connection to a host. When spectator relaying
+// is enabled, also passes everything it gets along to our own clients.
+class ClientSessionNet : public ClientSession,
+                         public ClientControllerInterface {
  public:
   ClientSessionNet();
   ~ClientSessionNet() override;
@@ -24,6 +27,10 @@ class ClientSessionNet : public ClientSession {
   void OnReset(bool rewind) override;
   void OnBaseTimeStepAdded(int step) override;
 
+  // Our ClientControllerInterface implementation (for relaying).
+  void OnClientConnected(ConnectionToClient* c) override;
+  void OnClientDisconnected(ConnectionToClient* c) override;
+
  private:
   struct SampleBucket {
     int max_delay_from_projection{};
@@ -35,12 +42,26 @@ class ClientSessionNet : public ClientSession {
   }
   void UpdateBuffering();
   auto GetBucketNum() -> int;
+  void AddDelaySample(float delay);
+
+  /// How far behind our projected time we currently aim to run.
+  auto GetJitterTargetDelay() const -> float;
 
   bool writing_replay_{};
+  bool relaying_{};
+  std::vector<ConnectionToClient*> spectators_;
   int delay_sample_counter_{};
   float max_delay_smoothed_{};
   float last_bucket_max_delay_{};
   float current_delay_{};
+
+  // Running estimates of how late steps arrive compared to projection
+  // (exponentially weighted, RFC 3550 style) and how many deviations of
+  // headroom we keep; that grows on underruns and relaxes back over time.
+  float delay_mean_{};
+  float delay_variance_{};
+  float jitter_deviations_{};
+  millisecs_t last_underrun_time_{};
   millisecs_t base_time_received_{};
   millisecs_t last_base_time_receive_time_{};
   millisecs_t leading_base_time_received_{};
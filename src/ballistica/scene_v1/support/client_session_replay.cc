@@ -3,7 +3,8 @@
 #include "ballistica/scene_v1/support/client_session_replay.h"
 
 #include <algorithm>
-#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -12,9 +13,9 @@
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/support/huffman.h"
 #include "ballistica/classic/support/classic_app_mode.h"
-#include "ballistica/core/platform/core_platform.h"
 #include "ballistica/scene_v1/connection/connection_set.h"
 #include "ballistica/scene_v1/connection/connection_to_client.h"
+#include "ballistica/scene_v1/connection/shared_message.h"
 #include "ballistica/scene_v1/support/session_stream.h"
 #include "ballistica/shared/math/vector3f.h"
 
@@ -57,10 +58,6 @@ ClientSessionReplay::~ClientSessionReplay() {
   // we no longer are responsible for feeding clients to this device..
   appmode->connections()->UnregisterClientController(this);
   appmode->ResumeReplay();
-  if (file_) {
-    fclose(file_);
-    file_ = nullptr;
-  }
 }
 
 void ClientSessionReplay::OnCommandBufferUnderrun() { ResetTargetBaseTime(); }
@@ -145,16 +142,18 @@ void ClientSessionReplay::OnClientDisconnected(ConnectionToClient* c) {
 }
 
 void ClientSessionReplay::FetchMessages() {
-  if (!file_ || shutting_down()) {
+  if (!reader_ || shutting_down()) {
     return;
   }
 
   // If we have no messages left, read from the file until we get some.
-  while (commands().empty()) {
+  while (!has_commands()) {
     // Before we read next message, let's save our current state
-    // if we didn't that for too long.
-    if (base_time() >= (states_.empty() ? 0 : states_.back().base_time_)
-                           + kReplayStateDumpIntervalMillisecs) {
+    // if we didn't that for too long. (Indexed replays don't need this;
+    // we seek using their keyframes instead).
+    if (keyframes_.empty()
+        && base_time() >= (states_.empty() ? 0 : states_.back().base_time_)
+                              + kReplayStateDumpIntervalMillisecs) {
       SessionStream out(nullptr, false);
       DumpFullState(&out);
 
@@ -162,69 +161,20 @@ void ClientSessionReplay::FetchMessages() {
       current_state_.correction_messages_.clear();
       GetCorrectionMessages(false, &current_state_.correction_messages_);
 
-      fflush(file_);
-      current_state_.file_position_ = ftell(file_);
+      current_state_.file_position_ = reader_->position();
       current_state_.message_ = out.GetOutMessage();
       states_.push_back(current_state_);
     }
 
-    std::vector<uint8_t> buffer;
-    uint8_t len8;
-    uint32_t len32;
-
-    // Read the size of the message.
-    // the first byte represents the actual size if the value is < 254
-    // if it is 254, the 2 bytes after it represent size
-    // if it is 255, the 4 bytes after it represent size
-    if (fread(&len8, 1, 1, file_) != 1) {
-      // So they know to be done when they reach the end of the command list
-      // (instead of just waiting for more commands)
-      add_end_of_file_command();
-      fclose(file_);
-      file_ = nullptr;
+    if (!ReadMessage_()) {
       return;
     }
-    if (len8 < 254) {
-      len32 = len8;
-    } else {
-      // Pull 16 bit len.
-      if (len8 == 254) {
-        uint16_t len16;
-        if (fread(&len16, 2, 1, file_) != 1) {
-          // so they know to be done when they reach the end of the command
-          // list (instead of just waiting for more commands)
-          add_end_of_file_command();
-          fclose(file_);
-          file_ = nullptr;
-          return;
-        }
-        assert(len16 >= 254);
-        len32 = len16;
-      } else {
-        // Pull 32 bit len.
-        if (fread(&len32, 4, 1, file_) != 1) {
-          // so they know to be done when they reach the end of the command
-          // list (instead of just waiting for more commands)
-          add_end_of_file_command();
-          fclose(file_);
-          file_ = nullptr;
-          return;
-        }
-        assert(len32 > 65535);
-      }
-    }
+    const std::vector<uint8_t>& data_decompressed = decompress_buffer_;
 
-    // Read and decompress the actual message.
-    BA_PRECONDITION(len32 > 0);
-    buffer.resize(len32);
-    if (fread(&(buffer[0]), len32, 1, file_) != 1) {
-      add_end_of_file_command();
-      fclose(file_);
-      file_ = nullptr;
-      return;
+    // Keyframes are just for seeking; skip them during normal playback.
+    if (data_decompressed[0] == BA_MESSAGE_REPLAY_KEYFRAME) {
+      continue;
     }
-    std::vector<uint8_t> data_decompressed =
-        g_base->huffman->decompress(buffer);
     HandleSessionMessage(data_decompressed);
 
     // Also send it to all client-connections we're attached to.
@@ -232,21 +182,33 @@ void ClientSessionReplay::FetchMessages() {
     // unreliable for certain type of messages. Though perhaps when passing
     // around replays maybe its best to keep everything intact.
     have_sent_client_message_ = true;
-    for (auto&& i : connections_to_clients_) {
-      i->SendReliableMessage(data_decompressed);
+    if (!connections_to_clients_.empty()) {
+      auto message = Object::New<SharedMessage>(data_decompressed);
+      for (auto&& i : connections_to_clients_) {
+        i->SendReliableMessage(message);
+      }
     }
   }
 }
 
+auto ClientSessionReplay::ReadMessage_() -> bool {
+  assert(reader_);
+  if (!reader_->ReadNext(&decompress_buffer_)) {
+    // So they know to be done when they reach the end of the command list
+    // (instead of just waiting for more commands)
+    AddEndOfFileCommand();
+    reader_.reset();
+    return false;
+  }
+  return true;
+}
+
 void ClientSessionReplay::Error(const std::string& description) {
   // Close the replay, announce something went wrong with it, and then do
   // standard error response..
   ScreenMessage(g_base->assets->GetResourceString("replayReadErrorText"),
                 {1, 0, 0});
-  if (file_) {
-    fclose(file_);
-    file_ = nullptr;
-  }
+  reader_.reset();
   ClientSession::Error(description);
 }
 
@@ -263,47 +225,105 @@ void ClientSessionReplay::OnReset(bool rewind) {
     i->SendReliableMessage(std::vector<uint8_t>(1, BA_MESSAGE_SESSION_RESET));
   }
 
-  // If rewinding, pop back to the start of our file.
+  // If rewinding, pop back to the start of our file (we hang on to an
+  // open reader so this is just a seek).
   if (rewind) {
-    if (file_) {
-      fclose(file_);
-      file_ = nullptr;
-    }
-
-    file_ = g_core->platform->FOpen(file_name_.c_str(), "rb");
-    if (!file_) {
-      Error("can't open file for reading");
+    if (reader_) {
+      reader_->Rewind();
       return;
     }
-
-    // Read file ID and version to make sure we support this file.
-    uint32_t file_id;
-    if ((fread(&file_id, sizeof(file_id), 1, file_) != 1)) {
-      Error("error reading file_id");
-      return;
-    }
-    if (file_id != kBrpFileID) {
-      Error("incorrect file_id");
+    try {
+      reader_ = std::make_unique<ReplayReader>(file_name_);
+    } catch (const Exception& e) {
+      Error(e.what());
       return;
     }
 
     // Make sure its a compatible protocol version.
-    uint16_t version;
-    if (fread(&version, sizeof(version), 1, file_) != 1) {
-      Error("error reading version");
-      return;
-    }
+    uint16_t version = reader_->protocol_version();
     if (version > kProtocolVersionMax || version < kProtocolVersionClientMin) {
       ScreenMessage(g_base->assets->GetResourceString("replayVersionErrorText"),
                     {1, 0, 0});
       End();
       return;
     }
+
+    // Indexed replays tell us where their keyframes are.
+    keyframes_ = reader_->keyframes();
+  }
+}
+
+void ClientSessionReplay::ApplyKeyframe_(const std::vector<uint8_t>& message) {
+  // Type, base-time, and message count, then the messages themselves.
+  BA_PRECONDITION(message.size() >= 1 + sizeof(int64_t) + sizeof(uint32_t)
+                  && message[0] == BA_MESSAGE_REPLAY_KEYFRAME);
+  const uint8_t* ptr = message.data() + 1;
+  const uint8_t* end = message.data() + message.size();
+  int64_t keyframe_base_time;
+  memcpy(&keyframe_base_time, ptr, sizeof(keyframe_base_time));
+  ptr += sizeof(keyframe_base_time);
+  uint32_t count;
+  memcpy(&count, ptr, sizeof(count));
+  ptr += sizeof(count);
+
+  SetBaseTime(static_cast<millisecs_t>(keyframe_base_time));
+  std::vector<uint8_t> sub_message;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t size;
+    BA_PRECONDITION(end - ptr >= static_cast<ptrdiff_t>(sizeof(size)));
+    memcpy(&size, ptr, sizeof(size));
+    ptr += sizeof(size);
+    BA_PRECONDITION(size > 0 && end - ptr >= static_cast<ptrdiff_t>(size));
+    sub_message.assign(ptr, ptr + size);
+    ptr += size;
+    HandleSessionMessage(sub_message);
+  }
+}
+
+void ClientSessionReplay::SeekToKeyframe_(millisecs_t to_base_time) {
+  assert(!keyframes_.empty());
+
+  // Find the last keyframe at or before our target.
+  auto it = std::upper_bound(
+      keyframes_.begin(), keyframes_.end(), to_base_time,
+      [](millisecs_t time, const ReplayReader::Keyframe& keyframe) -> bool {
+        return time < keyframe.base_time;
+      });
+  const ReplayReader::Keyframe* keyframe =
+      it == keyframes_.begin() ? nullptr : &*(it - 1);
+
+  // If we're already between that keyframe and the target, just keep
+  // playing from here.
+  if (to_base_time >= base_time()
+      && (keyframe == nullptr || keyframe->base_time <= base_time())) {
+    is_fast_forwarding_ = true;
+    fast_forward_base_time_ = to_base_time;
+    return;
+  }
+
+  // FIXME: calling reset here causes background music to start over
+  Reset(true);
+  if (keyframe != nullptr && reader_) {
+    reader_->Seek(keyframe->file_position);
+    if (!ReadMessage_()) {
+      return;
+    }
+    ApplyKeyframe_(decompress_buffer_);
+  }
+
+  // And then fast-forward the rest of the way.
+  if (to_base_time > base_time()) {
+    is_fast_forwarding_ = true;
+    fast_forward_base_time_ = to_base_time;
   }
 }
 
 void ClientSessionReplay::SeekTo(millisecs_t to_base_time) {
   is_fast_forwarding_ = false;
+  if (!keyframes_.empty()) {
+    SeekToKeyframe_(to_base_time);
+    return;
+  }
   if (to_base_time < base_time()) {
     auto it = std::lower_bound(
         states_.rbegin(), states_.rend(), to_base_time,
@@ -341,7 +361,9 @@ void ClientSessionReplay::SeekTo(millisecs_t to_base_time) {
 void ClientSessionReplay::RestoreFromCurrentState() {
   // FIXME: calling reset here causes background music to start over
   Reset(true);
-  fseek(file_, current_state_.file_position_, SEEK_SET);
+  if (reader_) {
+    reader_->Seek(current_state_.file_position_);
+  }
 
   SetBaseTime(current_state_.base_time_);
   HandleSessionMessage(current_state_.message_);
@@ -3,12 +3,13 @@
 #ifndef BALLISTICA_SCENE_V1_SUPPORT_CLIENT_SESSION_REPLAY_H_
 #define BALLISTICA_SCENE_V1_SUPPORT_CLIENT_SESSION_REPLAY_H_
 
-#include <cstdio>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "ballistica/scene_v1/support/client_controller_interface.h"
 #include "ballistica/scene_v1/support/client_session.h"
+#include "ballistica/scene_v1/support/replay_reader.h"
 
 namespace ballistica::scene_v1 {
 
@@ -45,6 +46,9 @@ class ClientSessionReplay : public ClientSession,
   };
 
   void RestoreFromCurrentState();
+  auto ReadMessage_() -> bool;
+  void SeekToKeyframe_(millisecs_t to_base_time);
+  void ApplyKeyframe_(const std::vector<uint8_t>& message);
 
   // List of passed states which we can rewind to.
   std::vector<IntermediateState> states_;
@@ -57,7 +61,14 @@ class ClientSessionReplay : public ClientSession,
   std::vector<ConnectionToClient*> connections_to_clients_;
   std::vector<ConnectionToClient*> connections_to_clients_ignored_;
   std::string file_name_;
-  FILE* file_{};
+  std::unique_ptr<ReplayReader> reader_;
+
+  // Keyframes from the file's index (for indexed replays). When we have
+  // these we seek using them and don't keep states_ in memory.
+  std::vector<ReplayReader::Keyframe> keyframes_;
+
+  // Reused across messages so we don't allocate for each one we read.
+  std::vector<uint8_t> decompress_buffer_;
 };
 
 }  // namespace ballistica::scene_v1
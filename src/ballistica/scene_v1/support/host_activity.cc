@@ -5,11 +5,17 @@
 #include <Python.h>
 
 #include <algorithm>
+#include <cctype>
 #include <string>
 #include <vector>
 
+#include "ballistica/base/assets/assets.h"
+#include "ballistica/base/assets/assets_server.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/base/logic/logic_profiler.h"
 #include "ballistica/base/python/support/python_context_call.h"
 #include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/core/platform/core_platform.h"
 #include "ballistica/scene_v1/assets/scene_collision_mesh.h"
 #include "ballistica/scene_v1/assets/scene_data_asset.h"
 #include "ballistica/scene_v1/assets/scene_mesh.h"
@@ -22,6 +28,7 @@
 #include "ballistica/scene_v1/support/player.h"
 #include "ballistica/scene_v1/support/session_stream.h"
 #include "ballistica/shared/generic/lambda_runnable.h"
+#include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::scene_v1 {
@@ -44,6 +51,10 @@ HostActivity::HostActivity(HostSession* host_session) {
 HostActivity::~HostActivity() {
   shutting_down_ = true;
 
+  // Remember what we used for next time.
+  SaveAssetManifest();
+  prefetched_assets_.clear();
+
   // Put the scene in shut-down mode before we start killing stuff.
   // (this generates warnings, suppresses messages, etc)
   scene_->set_shutting_down(true);
@@ -124,6 +135,11 @@ auto HostActivity::GetSceneStream() const -> SessionStream* {
 void HostActivity::SetGlobalsNode(GlobalsNode* node) { globals_node_ = node; }
 
 void HostActivity::StepScene() {
+  auto* tick_monitor = classic::ClassicAppMode::GetSingleton()->tick_monitor();
+  microsecs_t start_time{};
+  if (tick_monitor->enabled()) {
+    start_time = core::CorePlatform::TimeMonotonicMicrosecs();
+  }
   int cycle_count = 1;
   if (host_session_->benchmark_type() == base::BenchmarkType::kCPU) {
     cycle_count = 100;
@@ -141,13 +157,22 @@ void HostActivity::StepScene() {
     }
 
     // Run our sim-time timers.
-    scene_timers_.Run(scene()->time());
+    {
+      base::LogicProfiler::Scope s("scene_timers");
+      base::ScopedPythonContextCallBatch batch;
+      scene_timers_.Run(scene()->time());
+    }
 
     // Send die-messages/etc to out-of-bounds stuff.
     HandleOutOfBoundsNodes();
 
+    base::LogicProfiler::Scope s("scene_step");
     scene()->Step();
   }
+  if (tick_monitor->enabled()) {
+    tick_monitor->AddStep(core::CorePlatform::TimeMonotonicMicrosecs()
+                          - start_time);
+  }
 }
 
 void HostActivity::RegisterContextCall(base::PythonContextCall* call) {
@@ -329,6 +354,151 @@ void HostActivity::RegisterPyActivity(PyObject* pyActivityObj) {
 
   // Store a python weak-ref to this activity.
   py_activity_weak_ref_.Steal(PyWeakref_NewRef(pyActivityObj, nullptr));
+
+  PythonRef type_obj(reinterpret_cast<PyObject*>(Py_TYPE(pyActivityObj)),
+                     PythonRef::kAcquire);
+  activity_type_name_ = type_obj.GetAttr("__module__").Str() + "."
+                        + type_obj.GetAttr("__qualname__").Str();
+  LoadAssetManifest();
+}
+
+// Manifests are just lines of '<type-char> <asset-name>'.
+
+auto HostActivity::AssetManifestPath(const std::string& type_name)
+    -> std::string {
+  std::string file_name = type_name;
+  for (char& c : file_name) {
+    if (!isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '_') {
+      c = '_';
+    }
+  }
+  return g_core->platform->GetVolatileDataDirectory() + BA_DIRSLASH
+         + "activitymanifests" + BA_DIRSLASH + file_name + ".txt";
+}
+
+void HostActivity::LoadAssetManifest() {
+  assert(g_base->InLogicThread());
+  if (activity_type_name_.empty() || !g_base->assets_server->event_loop()) {
+    return;
+  }
+
+  // Read it in the assets thread and then hop back here to kick off
+  // loads.
+  std::string path = AssetManifestPath(activity_type_name_);
+  Object::WeakRef<HostActivity> weak_self(this);
+  g_base->assets_server->event_loop()->PushCall([path, weak_self] {
+    if (!g_core->platform->FilePathExists(path)) {
+      return;
+    }
+    std::vector<std::string> entries;
+    try {
+      std::string contents = Utils::FileToString(path);
+      size_t pos{};
+      while (pos < contents.size()) {
+        size_t end = contents.find('\n', pos);
+        if (end == std::string::npos) {
+          end = contents.size();
+        }
+        if (end - pos > 2 && contents[pos + 1] == ' ') {
+          entries.push_back(contents.substr(pos, end - pos));
+        }
+        pos = end + 1;
+      }
+    } catch (const std::exception& e) {
+      g_core->Log(LogName::kBaAssets, LogLevel::kWarning,
+                  "Error reading activity asset manifest '" + path
+                      + "': " + e.what());
+      return;
+    }
+    if (entries.empty()) {
+      return;
+    }
+    g_base->logic->event_loop()->PushCall([weak_self, entries] {
+      if (auto* activity = weak_self.get()) {
+        activity->PrefetchAssets(entries);
+      }
+    });
+  });
+}
+
+void HostActivity::PrefetchAssets(const std::vector<std::string>& entries) {
+  assert(g_base->InLogicThread());
+  if (shutting_down_ || !g_base->assets->asset_loads_allowed()) {
+    return;
+  }
+  base::Assets::AssetListLock lock;
+  for (auto&& entry : entries) {
+    std::string name = entry.substr(2);
+    try {
+      switch (entry[0]) {
+        case 't':
+          prefetched_assets_.emplace_back(
+              g_base->assets->GetTexture(name).get());
+          break;
+        case 'm':
+          prefetched_assets_.emplace_back(g_base->assets->GetMesh(name).get());
+          break;
+        case 's':
+          prefetched_assets_.emplace_back(
+              g_base->assets->GetSound(name).get());
+          break;
+        case 'c':
+          prefetched_assets_.emplace_back(
+              g_base->assets->GetCollisionMesh(name).get());
+          break;
+        case 'd':
+          prefetched_assets_.emplace_back(
+              g_base->assets->GetDataAsset(name).get());
+          break;
+        default:
+          break;
+      }
+    } catch (const std::exception& e) {
+      // Assets can come and go between runs; not a big deal.
+      g_core->Log(LogName::kBaAssets, LogLevel::kDebug,
+                  "Unable to prefetch '" + name + "': " + e.what());
+    }
+  }
+}
+
+void HostActivity::SaveAssetManifest() {
+  assert(g_base->InLogicThread());
+  if (activity_type_name_.empty() || !g_base->assets_server->event_loop()) {
+    return;
+  }
+  std::string contents;
+  auto add = [&contents](char kind, const auto& assets) {
+    for (auto&& i : assets) {
+      contents += kind;
+      contents += ' ';
+      contents += i.first;
+      contents += '\n';
+    }
+  };
+  add('t', textures_);
+  add('m', meshes_);
+  add('s', sounds_);
+  add('c', collision_meshes_);
+  add('d', datas_);
+  if (contents.empty()) {
+    return;
+  }
+  std::string path = AssetManifestPath(activity_type_name_);
+  g_base->assets_server->event_loop()->PushCall([path, contents] {
+    static bool made_dir{};
+    if (!made_dir) {
+      g_core->platform->MakeDir(
+          g_core->platform->GetVolatileDataDirectory() + BA_DIRSLASH
+          + "activitymanifests");
+      made_dir = true;
+    }
+    FILE* f = g_core->platform->FOpen(path.c_str(), "wb");
+    if (!f) {
+      return;
+    }
+    fwrite(contents.data(), contents.size(), 1, f);
+    fclose(f);
+  });
 }
 
 auto HostActivity::GetPyActivity() const -> PyObject* {
@@ -75,7 +75,21 @@ class HostActivity : public SceneV1Context {
   void SetIsForeground(bool val);
   void RegisterPyActivity(PyObject* pyActivity);
 
+  /// The Python activity class ('module.QualName'); empty until our
+  /// Python activity is registered.
+  auto activity_type_name() const -> const std::string& {
+    return activity_type_name_;
+  }
+
  private:
+  // We record the assets each activity type uses in a small manifest
+  // on disk, and when a new activity of that type comes along (generally
+  // a round ahead of when it runs) we start loading them all right away.
+  static auto AssetManifestPath(const std::string& type_name) -> std::string;
+  void LoadAssetManifest();
+  void SaveAssetManifest();
+  void PrefetchAssets(const std::vector<std::string>& entries);
+
   void HandleOutOfBoundsNodes();
   auto NewSimTimer(millisecs_t length, bool repeat, Runnable* runnable) -> int;
   void DeleteSimTimer(int timer_id);
@@ -113,6 +127,10 @@ class HostActivity : public SceneV1Context {
   Object::WeakRef<HostSession> host_session_;
   PythonRef py_activity_weak_ref_;
   TimerList scene_timers_;
+  std::string activity_type_name_;
+
+  // Keeps prefetched assets alive until we get around to using them.
+  std::vector<Object::Ref<base::Asset> > prefetched_assets_;
 };
 
 }  // namespace ballistica::scene_v1
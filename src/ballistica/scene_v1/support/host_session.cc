@@ -4,11 +4,13 @@
 
 #include <Python.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <string>
 #include <vector>
 
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/logic/logic_profiler.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/python/support/python_context_call.h"
 #include "ballistica/classic/support/classic_app_mode.h"
@@ -477,10 +479,17 @@ void HostSession::ProcessPlayerTimeOuts() {
 }
 
 void HostSession::StepScene() {
+  steps_this_update_++;
+
   // Run up our game-time timers.
-  sim_timers_.Run(scene()->time());
+  {
+    base::LogicProfiler::Scope s("session_sim_timers");
+    base::ScopedPythonContextCallBatch batch;
+    sim_timers_.Run(scene()->time());
+  }
 
   // And step.
+  base::LogicProfiler::Scope s("session_scene_step");
   scene()->Step();
 }
 
@@ -527,11 +536,14 @@ void HostSession::Update(int time_advance_millisecs, double time_advance) {
 
   SessionStream* output_stream = GetSceneStream();
   auto too_slow{false};
+  auto& settings{g_scene_v1->step_scheduler_settings()};
+  steps_this_update_ = 0;
 
-  // Try to advance our base time by the provided amount, firing all timers
-  // along the way.
+  // Try to advance our base time by the provided amount (plus anything we
+  // still owe from earlier), firing all timers along the way.
   millisecs_t target_base_time_millisecs =
-      base_time_millisecs_ + time_advance_millisecs;
+      base_time_millisecs_ + time_advance_millisecs + base_time_debt_millisecs_;
+  base_time_debt_millisecs_ = 0;
   while (!base_timers_.Empty()
          && (base_time_millisecs_
                  + base_timers_.TimeToNextExpire(base_time_millisecs_)
@@ -540,25 +552,51 @@ void HostSession::Update(int time_advance_millisecs, double time_advance) {
     if (output_stream) {
       output_stream->SetTime(base_time_millisecs_);
     }
-    base_timers_.Run(base_time_millisecs_);
+    {
+      base::LogicProfiler::Scope s("session_base_timers");
+      base::ScopedPythonContextCallBatch batch;
+      base_timers_.Run(base_time_millisecs_);
+    }
 
     // After each time we step time, abort if we're taking too long. This way we
     // slow down if we're overloaded and have a better chance at maintaining
     // a reasonable frame-rate/etc.
+    // Same if we've run as many steps as we're allowed to catch up on.
     auto elapsed =
         core::CorePlatform::TimeMonotonicMillisecs() - update_time_start;
-    if (elapsed >= 1000 / 30) {
+    if (elapsed >= 1000 / 30
+        || (settings.max_catch_up_steps > 0
+            && steps_this_update_ >= settings.max_catch_up_steps)) {
       too_slow = true;
       break;
     }
   }
 
+  auto& stats{g_scene_v1->step_scheduler_stats()};
+  stats.updates++;
+  stats.steps += steps_this_update_;
+  stats.max_steps_per_update =
+      std::max(stats.max_steps_per_update, steps_this_update_);
+
   // If we didn't abort, set our time to where we were aiming for.
+  // Otherwise either let the time we didn't get to go (slowing the game
+  // down) or hold on to it to catch up on in later updates.
   if (!too_slow) {
     base_time_millisecs_ = target_base_time_millisecs;
     if (output_stream) {
       output_stream->SetTime(base_time_millisecs_);
     }
+  } else {
+    stats.overloaded_updates++;
+    millisecs_t behind = target_base_time_millisecs - base_time_millisecs_;
+    if (!settings.overload_slowdown) {
+      base_time_debt_millisecs_ =
+          std::min(behind, static_cast<millisecs_t>(
+                               kMaxHostSessionTimeDebtMillisecs));
+      stats.max_debt_millisecs =
+          std::max(stats.max_debt_millisecs, base_time_debt_millisecs_);
+    }
+    stats.dropped_millisecs += behind - base_time_debt_millisecs_;
   }
   assert(test_ref.exists());
 
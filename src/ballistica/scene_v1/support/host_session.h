@@ -114,6 +114,10 @@ class HostSession : public Session {
   Object::Ref<SessionStream> output_stream_;
   Timer* step_scene_timer_;
   millisecs_t base_time_millisecs_{};
+
+  // Time we fell behind by and still owe (when not slowing down instead).
+  millisecs_t base_time_debt_millisecs_{};
+  int steps_this_update_{};
   TimerList sim_timers_;
   TimerList base_timers_;
   Object::Ref<Scene> scene_;
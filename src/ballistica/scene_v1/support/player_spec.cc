@@ -7,7 +7,7 @@
 #include "ballistica/base/support/classic_soft.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/core/platform/core_platform.h"
-#include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_stream.h"
 #include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::scene_v1 {
@@ -15,32 +15,45 @@ namespace ballistica::scene_v1 {
 PlayerSpec::PlayerSpec() = default;
 
 PlayerSpec::PlayerSpec(const std::string& s) {
-  cJSON* root_obj = cJSON_Parse(s.c_str());
-  bool success = false;
-  if (root_obj) {
-    if (cJSON_IsObject(root_obj)) {
-      cJSON* name_obj = cJSON_GetObjectItem(root_obj, "n");
-      cJSON* short_name_obj = cJSON_GetObjectItem(root_obj, "sn");
-      cJSON* account_obj = cJSON_GetObjectItem(root_obj, "a");
-      if (name_obj && short_name_obj && account_obj && cJSON_IsString(name_obj)
-          && cJSON_IsString(short_name_obj) && cJSON_IsString(account_obj)) {
-        name_ = Utils::GetValidUTF8(name_obj->valuestring, "psps");
-        short_name_ = Utils::GetValidUTF8(short_name_obj->valuestring, "psps2");
-
-        // Account type may technically be something we don't recognize,
-        // but that's ok.. it'll just be 'invalid' to us in that case
-        if (g_base->HaveClassic()) {
-          v1_account_type_ = g_base->classic()->GetV1AccountTypeFromString(
-              account_obj->valuestring);
-        } else {
-          v1_account_type_ = 0;  // kInvalid.
-        }
-        success = true;
-      }
+  // These get parsed for every handshake and party-member message, so we
+  // stream through the json instead of building a tree.
+  std::string name;
+  std::string short_name;
+  std::string account;
+  bool got_name{};
+  bool got_short_name{};
+  bool got_account{};
+  bool success =
+      JsonReader::ForEachMember(
+          s, [&](std::string_view key, const JsonReader::Value& value) {
+            if (!value.IsString()) {
+              return;
+            }
+            if (key == "n") {
+              name = value.string;
+              got_name = true;
+            } else if (key == "sn") {
+              short_name = value.string;
+              got_short_name = true;
+            } else if (key == "a") {
+              account = value.string;
+              got_account = true;
+            }
+          })
+      && got_name && got_short_name && got_account;
+  if (success) {
+    name_ = Utils::GetValidUTF8(name.c_str(), "psps");
+    short_name_ = Utils::GetValidUTF8(short_name.c_str(), "psps2");
+
+    // Account type may technically be something we don't recognize,
+    // but that's ok.. it'll just be 'invalid' to us in that case
+    if (g_base->HaveClassic()) {
+      v1_account_type_ =
+          g_base->classic()->GetV1AccountTypeFromString(account.c_str());
+    } else {
+      v1_account_type_ = 0;  // kInvalid.
     }
-    cJSON_Delete(root_obj);
-  }
-  if (!success) {
+  } else {
     valid_ = false;
 
     // Only log this once in case it is used as an attack.
@@ -74,19 +87,18 @@ auto PlayerSpec::operator==(const PlayerSpec& spec) const -> bool {
 }
 
 auto PlayerSpec::GetSpecString() const -> std::string {
-  cJSON* root;
-  root = cJSON_CreateObject();
-  cJSON_AddStringToObject(root, "n", name_.c_str());
-  cJSON_AddStringToObject(
-      root, "a",
-      g_base->HaveClassic()
-          ? g_base->classic()->V1AccountTypeToString(v1_account_type_).c_str()
-          : "");
-  cJSON_AddStringToObject(root, "sn", short_name_.c_str());
-  char* out = cJSON_PrintUnformatted(root);
-  std::string out_s = out;
-  free(out);
-  cJSON_Delete(root);
+  JsonWriter writer(name_.size() + short_name_.size() + 48);
+  writer.BeginObject();
+  writer.Key("n");
+  writer.String(name_);
+  writer.Key("a");
+  writer.String(g_base->HaveClassic()
+                    ? g_base->classic()->V1AccountTypeToString(v1_account_type_)
+                    : std::string());
+  writer.Key("sn");
+  writer.String(short_name_);
+  writer.EndObject();
+  std::string out_s = writer.TakeString();
 
   // We should never allow ourself to have all this add up to more than 256.
   assert(out_s.size() < 256);
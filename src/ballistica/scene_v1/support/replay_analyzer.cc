@@ -0,0 +1,119 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/replay_analyzer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/shared/foundation/exception.h"
+
+namespace ballistica::scene_v1 {
+
+ReplayAnalyzer::ReplayAnalyzer(const std::string& path) : reader_(path) {}
+
+void ReplayAnalyzer::Run() {
+  reader_.Rewind();
+  size_t position = static_cast<size_t>(reader_.position());
+  while (reader_.ReadNext(&buffer_)) {
+    auto new_position = static_cast<size_t>(reader_.position());
+    message_count_++;
+    compressed_bytes_ += static_cast<int64_t>(new_position - position);
+    uncompressed_bytes_ += static_cast<int64_t>(buffer_.size());
+    position = new_position;
+    HandleMessage_(buffer_);
+  }
+}
+
+void ReplayAnalyzer::HandleMessage_(const std::vector<uint8_t>& message) {
+  assert(!message.empty());
+  switch (message[0]) {
+    case BA_MESSAGE_SESSION_RESET:
+      session_reset_count_++;
+      node_count_ = 0;
+      break;
+
+    case BA_MESSAGE_SESSION_COMMANDS: {
+      // 16 bit length followed by command, up to the end of the message.
+      size_t offset = 1;
+      while (offset < message.size()) {
+        uint16_t size;
+        if (offset + sizeof(size) > message.size()) {
+          throw Exception("invalid session commands message");
+        }
+        memcpy(&size, message.data() + offset, sizeof(size));
+        offset += sizeof(size);
+        if (size == 0 || offset + size > message.size()) {
+          throw Exception("invalid session commands message");
+        }
+        HandleCommand_(message.data() + offset, size);
+        offset += size;
+      }
+      break;
+    }
+
+    case BA_MESSAGE_SESSION_DYNAMICS_CORRECTION:
+      // These get fed to clients as commands; count them that way too.
+      correction_count_++;
+      AddCommandStats_(
+          static_cast<uint8_t>(SessionCommand::kDynamicsCorrection),
+          message.size());
+      break;
+
+    case BA_MESSAGE_REPLAY_KEYFRAME:
+      // Just a seek point; its contents duplicate what came before it.
+      keyframe_count_++;
+      break;
+
+    default:
+      throw Exception("unrecognized replay message type "
+                      + std::to_string(static_cast<int>(message[0])));
+  }
+}
+
+void ReplayAnalyzer::AddCommandStats_(uint8_t type, size_t size) {
+  if (command_stats_.size() <= type) {
+    command_stats_.resize(static_cast<size_t>(type) + 1);
+  }
+  command_stats_[type].count++;
+  command_stats_[type].bytes += static_cast<int64_t>(size);
+}
+
+void ReplayAnalyzer::HandleCommand_(const uint8_t* data, size_t size) {
+  assert(size > 0);
+  AddCommandStats_(data[0], size);
+
+  // Everything we look into past the type is int32 values.
+  int32_t vals[3];
+  auto cmd = static_cast<SessionCommand>(data[0]);
+  switch (cmd) {
+    case SessionCommand::kBaseTimeStep:
+      if (size >= 1 + sizeof(int32_t)) {
+        memcpy(vals, data + 1, sizeof(int32_t));
+        duration_ += vals[0];
+      }
+      break;
+    case SessionCommand::kAddNode:
+      if (size >= 1 + sizeof(vals)) {
+        memcpy(vals, data + 1, sizeof(vals));  // scene, nodetype, node
+        nodes_created_++;
+        node_count_++;
+        peak_node_count_ = std::max(peak_node_count_, node_count_);
+        auto i = g_scene_v1->node_types_by_id().find(vals[1]);
+        if (i != g_scene_v1->node_types_by_id().end()) {
+          node_type_counts_[i->second->name()]++;
+        }
+      }
+      break;
+    case SessionCommand::kRemoveNode:
+      node_count_ = std::max(int64_t{0}, node_count_ - 1);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace ballistica::scene_v1
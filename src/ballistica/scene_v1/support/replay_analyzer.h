@@ -0,0 +1,80 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_REPLAY_ANALYZER_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_REPLAY_ANALYZER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/scene_v1/support/replay_reader.h"
+
+namespace ballistica::scene_v1 {
+
+/// Gathers stats from a replay file by walking its messages and session
+/// commands directly, without building any scene or session state.
+///
+/// Nothing here touches the logic thread or Python, so this runs as fast
+/// as the file can be decoded and any number of these can run at once on
+/// different threads.
+class ReplayAnalyzer {
+ public:
+  struct CommandStats {
+    int64_t count{};
+    int64_t bytes{};
+  };
+
+  /// Open the replay at the provided path. Throws an Exception if it can't
+  /// be read.
+  explicit ReplayAnalyzer(const std::string& path);
+
+  /// Go through the entire replay. Throws an Exception if it contains
+  /// malformed data.
+  void Run();
+
+  auto reader() const -> const ReplayReader& { return reader_; }
+  auto duration() const -> millisecs_t { return duration_; }
+  auto message_count() const { return message_count_; }
+  auto compressed_bytes() const { return compressed_bytes_; }
+  auto uncompressed_bytes() const { return uncompressed_bytes_; }
+  auto session_reset_count() const { return session_reset_count_; }
+  auto correction_count() const { return correction_count_; }
+  auto keyframe_count() const { return keyframe_count_; }
+  auto nodes_created() const { return nodes_created_; }
+  auto peak_node_count() const { return peak_node_count_; }
+
+  /// Stats per session-command type (indexed by SessionCommand value).
+  auto command_stats() const -> const std::vector<CommandStats>& {
+    return command_stats_;
+  }
+
+  /// Number of nodes created per node-type name.
+  auto node_type_counts() const
+      -> const std::unordered_map<std::string, int64_t>& {
+    return node_type_counts_;
+  }
+
+ private:
+  void HandleMessage_(const std::vector<uint8_t>& message);
+  void HandleCommand_(const uint8_t* data, size_t size);
+  void AddCommandStats_(uint8_t type, size_t size);
+
+  ReplayReader reader_;
+  std::vector<uint8_t> buffer_;
+  std::vector<CommandStats> command_stats_;
+  std::unordered_map<std::string, int64_t> node_type_counts_;
+  millisecs_t duration_{};
+  int64_t message_count_{};
+  int64_t compressed_bytes_{};
+  int64_t uncompressed_bytes_{};
+  int64_t session_reset_count_{};
+  int64_t correction_count_{};
+  int64_t keyframe_count_{};
+  int64_t nodes_created_{};
+  int64_t node_count_{};
+  int64_t peak_node_count_{};
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_REPLAY_ANALYZER_H_
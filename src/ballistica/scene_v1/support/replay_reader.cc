@@ -0,0 +1,189 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/replay_reader.h"
+
+#if !BA_OSTYPE_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/base/support/huffman.h"
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/foundation/exception.h"
+
+namespace ballistica::scene_v1 {
+
+ReplayReader::ReplayReader(const std::string& path) {
+#if BA_OSTYPE_WINDOWS
+  // No mapping here; just pull the whole thing in with one read.
+  FILE* file = g_core->platform->FOpen(path.c_str(), "rb");
+  if (!file) {
+    throw Exception("can't open file for reading");
+  }
+  fseek(file, 0, SEEK_END);
+  long file_size = ftell(file);  // NOLINT(runtime/int)
+  fseek(file, 0, SEEK_SET);
+  if (file_size > 0) {
+    buffer_.resize(static_cast<size_t>(file_size));
+    if (fread(buffer_.data(), buffer_.size(), 1, file) != 1) {
+      buffer_.clear();
+    }
+  }
+  fclose(file);
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw Exception("can't open file for reading");
+  }
+  struct stat st {};
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      data_ = static_cast<const uint8_t*>(mapping);
+      size_ = static_cast<size_t>(st.st_size);
+
+      // We generally stream through these start to finish.
+      madvise(mapping, size_, MADV_SEQUENTIAL);
+    }
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+#endif
+
+  // Read file ID and version to make sure we support this file.
+  if (size_ < sizeof(file_id_)) {
+    throw Exception("error reading file_id");
+  }
+  memcpy(&file_id_, data_, sizeof(file_id_));
+  if (file_id_ != kBrpFileID && file_id_ != kBrpFileIDIndexed) {
+    throw Exception("incorrect file_id");
+  }
+  if (size_ < sizeof(file_id_) + sizeof(protocol_version_)) {
+    throw Exception("error reading version");
+  }
+  memcpy(&protocol_version_, data_ + sizeof(file_id_),
+         sizeof(protocol_version_));
+  messages_start_ = sizeof(file_id_) + sizeof(protocol_version_);
+  position_ = messages_start_;
+
+  if (indexed()) {
+    LoadKeyframeIndex_();
+  }
+}
+
+ReplayReader::~ReplayReader() {
+#if !BA_OSTYPE_WINDOWS
+  if (data_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+#endif
+}
+
+void ReplayReader::LoadKeyframeIndex_() {
+  // The file ends with the index offset and footer id. If they're missing
+  // (the replay wasn't finished cleanly) we just go without.
+  int64_t index_offset;
+  uint32_t footer_id;
+  uint32_t count;
+  size_t tail_size = sizeof(index_offset) + sizeof(footer_id);
+  if (size_ < static_cast<size_t>(messages_start_) + tail_size) {
+    return;
+  }
+  const uint8_t* tail = data_ + size_ - tail_size;
+  memcpy(&index_offset, tail, sizeof(index_offset));
+  memcpy(&footer_id, tail + sizeof(index_offset), sizeof(footer_id));
+  if (footer_id != kBrpIndexFooterID || index_offset < messages_start_
+      || static_cast<size_t>(index_offset) + sizeof(count)
+             > size_ - tail_size) {
+    return;
+  }
+  const uint8_t* ptr = data_ + index_offset;
+  memcpy(&count, ptr, sizeof(count));
+  ptr += sizeof(count);
+  if (static_cast<size_t>(tail - ptr) / (sizeof(int64_t) * 2) < count) {
+    return;
+  }
+  keyframes_.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    int64_t vals[2];
+    memcpy(vals, ptr, sizeof(vals));
+    ptr += sizeof(vals);
+    keyframes_.push_back({static_cast<millisecs_t>(vals[0]), vals[1]});
+  }
+}
+
+void ReplayReader::Seek(int64_t position) {
+  BA_PRECONDITION(position >= messages_start_
+                  && static_cast<size_t>(position) <= size_);
+  position_ = position;
+}
+
+auto ReplayReader::NextRaw(const uint8_t** data, size_t* size) -> bool {
+  assert(data && size);
+  auto remaining = static_cast<size_t>(size_ - position_);
+  const uint8_t* ptr = data_ + position_;
+
+  // The first byte represents the actual size if the value is < 254;
+  // if it is 254, the 2 bytes after it represent size; if it is 255, the 4
+  // bytes after it represent size (indexed replays mark the end of their
+  // messages with a 0).
+  if (remaining < 1 || ptr[0] == 0) {
+    return false;
+  }
+  uint32_t len32;
+  size_t header_size;
+  if (ptr[0] < 254) {
+    len32 = ptr[0];
+    header_size = 1;
+  } else if (ptr[0] == 254) {
+    uint16_t len16;
+    if (remaining < 1 + sizeof(len16)) {
+      return false;
+    }
+    memcpy(&len16, ptr + 1, sizeof(len16));
+    assert(len16 >= 254);
+    len32 = len16;
+    header_size = 1 + sizeof(len16);
+  } else {
+    if (remaining < 1 + sizeof(len32)) {
+      return false;
+    }
+    memcpy(&len32, ptr + 1, sizeof(len32));
+    assert(len32 > 65535);
+    header_size = 1 + sizeof(len32);
+  }
+  if (remaining - header_size < len32) {
+    return false;
+  }
+  *data = ptr + header_size;
+  *size = len32;
+  position_ += static_cast<int64_t>(header_size + len32);
+  return true;
+}
+
+auto ReplayReader::ReadNext(std::vector<uint8_t>* out) -> bool {
+  assert(out);
+  const uint8_t* data;
+  size_t size;
+  if (!NextRaw(&data, &size)) {
+    return false;
+  }
+  g_base->huffman->decompress(data, size, out);
+  BA_PRECONDITION(!out->empty());
+  return true;
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,82 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_REPLAY_READER_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_REPLAY_READER_H_
+
+#include <string>
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/shared/foundation/macros.h"
+
+namespace ballistica::scene_v1 {
+
+/// Random-access reader for replay (.brp) files.
+///
+/// The file is memory-mapped where the platform allows it (and read into a
+/// single buffer otherwise), so scanning through messages involves no
+/// per-message reads or copies; each message's compressed bytes are
+/// decoded straight out of the mapping.
+class ReplayReader {
+ public:
+  struct Keyframe {
+    millisecs_t base_time;
+    int64_t file_position;
+  };
+
+  /// Open the replay at the provided path. Throws an Exception if it can't
+  /// be read or isn't a replay file.
+  explicit ReplayReader(const std::string& path);
+  ~ReplayReader();
+
+  auto file_id() const -> uint32_t { return file_id_; }
+  auto protocol_version() const -> uint16_t { return protocol_version_; }
+  auto indexed() const -> bool { return file_id_ == kBrpFileIDIndexed; }
+
+  /// Keyframes listed in an indexed replay's index, sorted by base-time.
+  /// Empty for non-indexed replays or ones that weren't closed out
+  /// cleanly.
+  auto keyframes() const -> const std::vector<Keyframe>& { return keyframes_; }
+
+  /// The file offset of the next message to be read.
+  auto position() const -> int64_t { return position_; }
+
+  /// Jump to an offset previously returned by position() (or listed in the
+  /// keyframe index).
+  void Seek(int64_t position);
+
+  /// Jump back to the first message.
+  void Rewind() { position_ = messages_start_; }
+
+  /// Locate the next message without decoding it, pointing data at its
+  /// compressed bytes within the file. Returns false when there are no
+  /// more messages (or the last one is truncated).
+  auto NextRaw(const uint8_t** data, size_t* size) -> bool;
+
+  /// Read and decode the next message into the provided buffer. Returns
+  /// false when there are no more messages.
+  auto ReadNext(std::vector<uint8_t>* out) -> bool;
+
+  /// The full raw file contents.
+  auto data() const -> const uint8_t* { return data_; }
+  auto size() const -> size_t { return size_; }
+
+ private:
+  void LoadKeyframeIndex_();
+
+  const uint8_t* data_{};
+  size_t size_{};
+  int64_t position_{};
+  int64_t messages_start_{};
+  uint32_t file_id_{};
+  uint16_t protocol_version_{};
+  std::vector<Keyframe> keyframes_;
+#if BA_OSTYPE_WINDOWS
+  std::vector<uint8_t> buffer_;
+#endif
+  BA_DISALLOW_CLASS_COPIES(ReplayReader);
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_REPLAY_READER_H_
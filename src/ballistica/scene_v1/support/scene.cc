@@ -2,12 +2,15 @@
 
 #include "ballistica/scene_v1/support/scene.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics.h"
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/renderer/render_pass.h"
+#include "ballistica/base/graphics/support/frame_def.h"
 #include "ballistica/base/graphics/support/camera.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/python/support/python_context_call.h"
@@ -19,10 +22,21 @@
 #include "ballistica/scene_v1/node/node_attribute_connection.h"
 #include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/node/player_node.h"
+#include "ballistica/scene_v1/node/scorch_node.h"
 #include "ballistica/scene_v1/support/session_stream.h"
+#include "ballistica/shared/foundation/job_system.h"
 
 namespace ballistica::scene_v1 {
 
+// Don't bother farming out draw prep to workers in batches smaller than
+// this.
+const size_t kParallelDrawPrepMinChunk{32};
+
+// Periodic physics corrections a node keeps getting after its bodies fall
+// asleep, and how often (in corrections) it gets refreshed after that.
+const int kCorrectionRestSends{3};
+const int kCorrectionRestRefresh{10};
+
 auto Scene::GetSceneStream() const -> SessionStream* {
   return output_stream_.get();
 }
@@ -35,6 +49,11 @@ void Scene::SetMapBounds(float xmin, float ymin, float zmin, float xmax,
   bounds_max_[0] = xmax;
   bounds_max_[1] = ymax;
   bounds_max_[2] = zmax;
+
+  // Quad-tree broadphase is built on our bounds, so it needs a rebuild.
+  if (dynamics_->broadphase() == Dynamics::Broadphase::kQuadTree) {
+    dynamics_->SetBroadphase(Dynamics::Broadphase::kQuadTree);
+  }
 }
 
 Scene::Scene(millisecs_t start_time)
@@ -57,9 +76,16 @@ Scene::~Scene() {
   // make sure it is at this point.
   shutting_down_ = true;
 
+  // Everything goes down together from here, so nodes and bodies can skip
+  // the bookkeeping that only matters when they die individually (sending
+  // stream removals, unlinking connections to each other, rebuilding
+  // collision caches, etc). Our RemoveScene below takes them all out on
+  // the other end of the stream.
+  tearing_down_ = true;
+
   // Manually kill our nodes so they can remove all their own dynamics stuff
   // before dynamics goes down.
-  nodes_.clear();
+  nodes_.Clear();
 
   dynamics_.Clear();
 
@@ -96,14 +122,50 @@ auto Scene::IsOutOfBounds(float x, float y, float z) -> bool {
           || std::isnan(z) || std::isinf(x) || std::isinf(y) || std::isinf(z));
 }
 
+void Scene::AddScorchNode(ScorchNode* n) { scorch_nodes_.emplace_back(n); }
+
 void Scene::Draw(base::FrameDef* frame_def) {
-  // Draw our nodes.
-  for (auto&& i : nodes_) {
+  // Let nodes do their self-contained prep work first. We can spread this
+  // across worker threads; actual drawing touches all sorts of shared
+  // state so that stays on this thread.
+  auto prepare = [this, frame_def](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      if (Node* node = nodes_.GetEntry(i)) {
+        node->PrepareDraw(frame_def);
+      }
+    }
+  };
+  if (g_base->graphics->parallel_draw_prep() && g_core->job_system) {
+    g_core->job_system->ParallelFor(nodes_.entry_count(),
+                                    kParallelDrawPrepMinChunk, prepare);
+  } else {
+    prepare(0, nodes_.entry_count());
+  }
+
+  // Draw our nodes, skipping any that have opted in to culling and are
+  // out of view. VR frames get drawn from multiple viewpoints so we don't
+  // cull there.
+  base::RenderPass* cull_pass{};
+  if (g_base->graphics->draw_culling() && !g_core->vr_mode()) {
+    cull_pass = frame_def->beauty_pass();
+  }
+  Vector3f bounds_top;
+  float bounds_bottom_y, bounds_radius;
+  for (Node* node : nodes_) {
+    if (cull_pass
+        && node->GetDrawBounds(&bounds_top, &bounds_bottom_y, &bounds_radius)
+        && !cull_pass->IsColumnVisible(bounds_top, bounds_bottom_y,
+                                       bounds_radius)) {
+      continue;
+    }
     g_base->graphics->PreNodeDraw();
-    i->Draw(frame_def);
+    node->Draw(frame_def);
     g_base->graphics->PostNodeDraw();
   }
 
+  // Scorch marks pile up over a match so they all go out together.
+  ScorchNode::DrawScorches(frame_def, &scorch_nodes_);
+
   // Draw any dynamics debugging extras.
   dynamics_->Draw(frame_def);
 }
@@ -142,16 +204,26 @@ void Scene::Step() {
 
   auto* appmode = classic::ClassicAppMode::GetActiveOrFatal();
 
+  // Squeeze out any nodes that died since last step; we can't do this
+  // while iterating.
+  nodes_.Compact();
+
   // Step all our nodes.
   {
     in_step_ = true;
     last_step_real_time_ = g_core->AppTimeMillisecs();
-    for (auto&& i : nodes_) {
-      Node* node = i.get();
-      node->Step();
+    if (g_scene_v1->step_profiling_enabled()) {
+      StepNodesProfiled_();
+    } else {
+      for (Node* node : nodes_) {
+        if (node->needs_step()) {
+          node->Step();
+        }
 
-      // Now that it's stepped, pump new values to any nodes it's connected to.
-      node->UpdateConnections();
+        // Now that it's stepped, pump new values to any nodes it's
+        // connected to.
+        node->UpdateConnections();
+      }
     }
     in_step_ = false;
   }
@@ -179,6 +251,28 @@ void Scene::Step() {
   stepnum_++;
 }
 
+void Scene::StepNodesProfiled_() {
+  auto& profile{g_scene_v1->step_profile()};
+  profile.steps++;
+  microsecs_t start_time{g_core->AppTimeMicrosecs()};
+  microsecs_t last_time{start_time};
+  for (Node* node : nodes_) {
+    if (node->needs_step()) {
+      node->Step();
+    }
+    node->UpdateConnections();
+    microsecs_t now{g_core->AppTimeMicrosecs()};
+    auto type_id{static_cast<size_t>(node->type()->id())};
+    if (type_id >= profile.node_types.size()) {
+      profile.node_types.resize(type_id + 1);
+    }
+    profile.node_types[type_id].count++;
+    profile.node_types[type_id].microsecs += now - last_time;
+    last_time = now;
+  }
+  profile.node_step += last_time - start_time;
+}
+
 void Scene::DeleteNode(Node* node) {
   assert(node);
 
@@ -209,7 +303,7 @@ void Scene::DeleteNode(Node* node) {
   // Copy a strong ref to this node to keep it alive until we've wiped it from
   // the list. (so in its destructor it won't see itself on the list).
   Object::Ref<Node> temp_ref(node);
-  nodes_.erase(node->iterator());
+  nodes_.Remove(node->handle());
 
   temp_ref.Clear();
 
@@ -237,15 +331,15 @@ void Scene::DeleteNode(Node* node) {
 
 void Scene::OnScreenSizeChange() {
   assert(g_base->InLogicThread());
-  for (auto&& i : nodes_) {
-    i->OnScreenSizeChange();  // New.
+  for (Node* node : nodes_) {
+    node->OnScreenSizeChange();  // New.
   }
 }
 
 void Scene::LanguageChanged() {
   assert(g_base->InLogicThread());
-  for (auto&& i : nodes_) {
-    i->OnLanguageChange();  // New.
+  for (Node* node : nodes_) {
+    node->OnLanguageChange();  // New.
   }
 }
 
@@ -305,8 +399,7 @@ void Scene::DumpNodes(SessionStream* out) {
   // First we go through and create all nodes.
   // We have to do this all at once before setting attrs since any node
   // can refer to any other in an attr set.
-  for (auto&& i : nodes_) {
-    Node* node = i.get();
+  for (Node* node : nodes_) {
     assert(node);
 
     // Add the node.
@@ -316,8 +409,7 @@ void Scene::DumpNodes(SessionStream* out) {
   std::vector<std::pair<NodeAttribute, Node*> > node_attr_sets;
 
   // Now go through and set *most* node attr values.
-  for (auto&& i1 : nodes_) {
-    Node* node = i1.get();
+  for (Node* node : nodes_) {
     assert(node);
 
     // Now we need to set *all* of its attrs in order.
@@ -412,8 +504,7 @@ void Scene::DumpNodes(SessionStream* out) {
 
   // Now run through all nodes once more and add an OnCreate() call
   // so they can do any post-create setup they need to.
-  for (auto&& i : nodes_) {
-    Node* node = i.get();
+  for (Node* node : nodes_) {
     assert(node);
     out->NodeOnCreate(node);
   }
@@ -424,8 +515,7 @@ void Scene::DumpNodes(SessionStream* out) {
   }
 
   // And lastly re-establish node attribute-connections.
-  for (auto&& i : nodes_) {
-    Node* node = i.get();
+  for (Node* node : nodes_) {
     assert(node);
     for (auto&& j : node->attribute_connections()) {
       assert(j.exists());
@@ -456,8 +546,7 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
 
   std::vector<RigidBody*> dynamic_bodies;
 
-  for (auto&& i : nodes_) {
-    Node* n = i.get();
+  for (Node* n : nodes_) {
     assert(n);
     if (n && !n->parts().empty()) {
       dynamic_bodies.clear();
@@ -470,6 +559,11 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
           }
         }
       }
+      // Periodic corrections can skip anything that's been sitting still.
+      if (blended && !dynamic_bodies.empty()
+          && !NeedsCorrection_(n, dynamic_bodies)) {
+        continue;
+      }
       if (!dynamic_bodies.empty()) {
         int node_embed_size = 5;  // 4 byte node-ID and 1 byte body-count
         int body_count = 0;
@@ -540,12 +634,33 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
   return message;
 }
 
+auto Scene::NeedsCorrection_(Node* node,
+                             const std::vector<RigidBody*>& bodies) -> bool {
+  // Bodies that have gone to sleep stay exactly where they are, so once
+  // clients have been sent their resting state there's nothing left to
+  // correct until they wake up. We send it a few times in case a client
+  // skipped a correction, and refresh occasionally after that just in
+  // case. Nodes with custom resync data always go out since that can
+  // change with bodies at rest.
+  bool asleep = node->GetResyncDataSize() == 0
+                && std::none_of(bodies.begin(), bodies.end(), [](auto* b) {
+                     return dBodyIsEnabled(b->body());
+                   });
+  if (!asleep) {
+    node->set_correction_rest_count(0);
+    return true;
+  }
+  int count = node->correction_rest_count() + 1;
+  node->set_correction_rest_count(count);
+  return count <= kCorrectionRestSends || count % kCorrectionRestRefresh == 0;
+}
+
 void Scene::SetOutputStream(SessionStream* val) { output_stream_ = val; }
 
-void Scene::AddNode(Node* node, int64_t* node_id, NodeList::iterator* i) {
-  assert(node && node_id && i);
+void Scene::AddNode(Node* node, int64_t* node_id, NodeHandle* handle) {
+  assert(node && node_id && handle);
   *node_id = next_node_id_++;
-  *i = nodes_.insert(nodes_.end(), Object::Ref<Node>(node));
+  *handle = nodes_.Add(node);
 }
 
 }  // namespace ballistica::scene_v1
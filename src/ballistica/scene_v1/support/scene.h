@@ -31,8 +31,9 @@ class Scene : public Object {
   auto time() const -> millisecs_t { return time_; }
   auto stepnum() const -> int64_t { return stepnum_; }
   auto nodes() const -> const NodeList& { return nodes_; }
-  void AddNode(Node*, int64_t* node_id, NodeList::iterator* i);
+  void AddNode(Node*, int64_t* node_id, NodeHandle* handle);
   void AddOutOfBoundsNode(Node* n) { out_of_bounds_nodes_.emplace_back(n); }
+  void AddScorchNode(ScorchNode* n);
   auto IsOutOfBounds(float x, float y, float z) -> bool;
   auto dynamics() const -> Dynamics* {
     assert(dynamics_.exists());
@@ -40,6 +41,8 @@ class Scene : public Object {
   }
   auto in_step() const -> bool { return in_step_; }
   void SetMapBounds(float x, float y, float z, float X, float Y, float Z);
+  auto bounds_min() const -> const float* { return bounds_min_; }
+  auto bounds_max() const -> const float* { return bounds_max_; }
   void OnScreenSizeChange();
   void LanguageChanged();
   auto out_of_bounds_nodes() -> const std::vector<Object::WeakRef<Node> >& {
@@ -48,6 +51,10 @@ class Scene : public Object {
   void DeleteNode(Node* node);
   auto shutting_down() const -> bool { return shutting_down_; }
   void set_shutting_down(bool val) { shutting_down_ = val; }
+
+  /// True while the scene is being destroyed and taking all of its nodes
+  /// and bodies down with it in one go.
+  auto tearing_down() const -> bool { return tearing_down_; }
   auto GetSceneStream() const -> SessionStream*;
   void SetPlayerNode(int id, PlayerNode* n);
   auto GetPlayerNode(int id) -> PlayerNode*;
@@ -75,9 +82,23 @@ class Scene : public Object {
     return last_step_real_time_;
   }
   auto globals_node() const -> GlobalsNode* { return globals_node_; }
+
+  /// Whether bodies remember their state going into each step so rendering
+  /// can blend between the last two (set for client scenes, whose steps
+  /// arrive in bunches).
+  auto render_interpolation() const { return render_interpolation_; }
+  void set_render_interpolation(bool val) { render_interpolation_ = val; }
+
+  /// How far rendering sits between the state before our last step (0)
+  /// and after it (1). Only applies with render_interpolation on.
+  auto render_blend() const { return render_blend_; }
+  void set_render_blend(float val) { render_blend_ = val; }
   void set_globals_node(GlobalsNode* node) { globals_node_ = node; }
 
  private:
+  void StepNodesProfiled_();
+  auto NeedsCorrection_(Node* node, const std::vector<RigidBody*>& bodies)
+      -> bool;
   GlobalsNode* globals_node_{};  // Current globals node (if any).
   std::unordered_map<int, Object::WeakRef<PlayerNode> > player_nodes_;
   int64_t stream_id_{-1};
@@ -93,9 +114,13 @@ class Scene : public Object {
   millisecs_t last_step_real_time_{};
   int bg_cover_count_{};
   bool shutting_down_{};
+  bool tearing_down_{};
+  bool render_interpolation_{};
+  float render_blend_{1.0f};
   float bounds_min_[3]{};
   float bounds_max_[3]{};
   std::vector<Object::WeakRef<Node> > out_of_bounds_nodes_;
+  std::vector<Object::WeakRef<ScorchNode> > scorch_nodes_;
   NodeList nodes_;
   Object::Ref<Dynamics> dynamics_;
 };
@@ -2,6 +2,7 @@
 
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -10,8 +11,12 @@
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/support/plus_soft.h"
 #include "ballistica/classic/support/classic_app_mode.h"
+#include "ballistica/scene_v1/assets/scene_mesh.h"
+#include "ballistica/scene_v1/assets/scene_texture.h"
 #include "ballistica/scene_v1/connection/connection_to_host.h"
+#include "ballistica/scene_v1/node/node_attribute_connection.h"
 #include "ballistica/scene_v1/node/player_node.h"
+#include "ballistica/scene_v1/node/spaz_node.h"
 #include "ballistica/scene_v1/python/class/python_class_input_device.h"
 #include "ballistica/scene_v1/support/client_session_net.h"
 #include "ballistica/scene_v1/support/host_activity.h"
@@ -191,6 +196,38 @@ void SceneV1InputDeviceDelegate::InputCommand(InputType type, float value) {
       remote_input_commands_buffer_[size] = static_cast<uint8_t>(type);
       memcpy(&(remote_input_commands_buffer_[size + 1]), &value, 4);
     }
+    if (type == InputType::kLeftRight || type == InputType::kUpDown) {
+      PredictMove_(type, value);
+    }
+  }
+}
+
+void SceneV1InputDeviceDelegate::PredictMove_(InputType type, float value) {
+  auto* appmode = classic::ClassicAppMode::GetSingleton();
+  if (!appmode->client_input_prediction()) {
+    return;
+  }
+  Scene* scene = appmode->GetForegroundScene();
+  if (!scene) {
+    return;
+  }
+
+  // Our spaz is whatever is feeding our player node its position.
+  PlayerNode* player_node = scene->GetPlayerNode(remote_player_id());
+  if (!player_node) {
+    return;
+  }
+  for (auto&& i : player_node->attribute_connections_incoming()) {
+    if (auto* spaz = dynamic_cast<SpazNode*>(i.second->src_node.get())) {
+      // Host-side players clamp these the same way before they hit nodes.
+      value = std::min(1.0f, std::max(-1.0f, value));
+      if (type == InputType::kLeftRight) {
+        spaz->PredictMoveLeftRight(value);
+      } else {
+        spaz->PredictMoveUpDown(value);
+      }
+      return;
+    }
   }
 }
 
@@ -67,6 +67,7 @@ class SceneV1InputDeviceDelegate : public base::InputDeviceDelegate {
  private:
   auto GetPyInputDevice(bool new_ref) -> PyObject*;
   void ShipBufferIfFull();
+  void PredictMove_(InputType type, float value);
 
   PyObject* py_ref_{};
 
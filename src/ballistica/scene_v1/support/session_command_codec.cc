@@ -0,0 +1,181 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/session_command_codec.h"
+
+#include <cstring>
+#include <vector>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/shared/foundation/exception.h"
+
+namespace ballistica::scene_v1 {
+
+// Per-word tags (2 bits each).
+const uint8_t kWordRaw = 0;
+const uint8_t kWordVarint = 1;
+const uint8_t kWordHigh16 = 2;
+const uint8_t kWordZero = 3;
+
+static void WriteVarint(uint32_t val, std::vector<uint8_t>* out) {
+  while (val >= 0x80) {
+    out->push_back(static_cast<uint8_t>(val | 0x80));
+    val >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(val));
+}
+
+static auto ReadVarint(const uint8_t** ptr, const uint8_t* end) -> uint32_t {
+  uint32_t val = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (*ptr >= end) {
+      throw Exception("truncated varint");
+    }
+    uint8_t byte = *((*ptr)++);
+    val |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return val;
+    }
+  }
+  throw Exception("invalid varint");
+}
+
+static void CompactCommand(const uint8_t* cmd, size_t size,
+                           std::vector<uint8_t>* out) {
+  assert(size > 0);
+  size_t word_count = (size - 1) / 4;
+  size_t tail_size = (size - 1) % 4;
+  out->push_back(cmd[0]);
+  WriteVarint(static_cast<uint32_t>(word_count), out);
+  size_t tags_offset = out->size();
+  out->resize(tags_offset + (word_count + 3) / 4, 0);
+  const uint8_t* words = cmd + 1;
+  for (size_t i = 0; i < word_count; ++i) {
+    uint32_t word;
+    memcpy(&word, words + i * 4, sizeof(word));
+    uint32_t zigzag = (word << 1) ^ (0 - (word >> 31));
+    uint8_t tag;
+    if (word == 0) {
+      tag = kWordZero;
+    } else if (zigzag < (1u << 14)) {
+      tag = kWordVarint;
+      WriteVarint(zigzag, out);
+    } else if ((word & 0xFFFF) == 0) {
+      tag = kWordHigh16;
+      out->push_back(static_cast<uint8_t>(word >> 16));
+      out->push_back(static_cast<uint8_t>(word >> 24));
+    } else if (zigzag < (1u << 21)) {
+      tag = kWordVarint;
+      WriteVarint(zigzag, out);
+    } else {
+      tag = kWordRaw;
+      size_t offset = out->size();
+      out->resize(offset + sizeof(word));
+      memcpy(out->data() + offset, &word, sizeof(word));
+    }
+    (*out)[tags_offset + i / 4] |= static_cast<uint8_t>(tag << ((i % 4) * 2));
+  }
+  out->insert(out->end(), words + word_count * 4,
+              words + word_count * 4 + tail_size);
+}
+
+void SessionCommandCodec::Compact(const std::vector<uint8_t>& message,
+                                  std::vector<uint8_t>* out) {
+  assert(out);
+  BA_PRECONDITION(!message.empty()
+                  && message[0] == BA_MESSAGE_SESSION_COMMANDS);
+  out->clear();
+  out->reserve(message.size());
+  out->push_back(BA_MESSAGE_SESSION_COMMANDS_COMPACT);
+
+  // Each command gets its compact length up front.
+  std::vector<uint8_t> command;
+  size_t offset = 1;
+  while (offset < message.size()) {
+    uint16_t size;
+    BA_PRECONDITION(offset + sizeof(size) <= message.size());
+    memcpy(&size, message.data() + offset, sizeof(size));
+    offset += sizeof(size);
+    BA_PRECONDITION(size > 0 && offset + size <= message.size());
+    command.clear();
+    CompactCommand(message.data() + offset, size, &command);
+    WriteVarint(static_cast<uint32_t>(command.size()), out);
+    out->insert(out->end(), command.begin(), command.end());
+    offset += size;
+  }
+}
+
+void SessionCommandCodec::Expand(const std::vector<uint8_t>& message,
+                                 std::vector<uint8_t>* out) {
+  assert(out);
+  BA_PRECONDITION(!message.empty()
+                  && message[0] == BA_MESSAGE_SESSION_COMMANDS_COMPACT);
+  out->clear();
+  out->reserve(message.size() * 2);
+  out->push_back(BA_MESSAGE_SESSION_COMMANDS);
+  const uint8_t* ptr = message.data() + 1;
+  const uint8_t* message_end = message.data() + message.size();
+  while (ptr < message_end) {
+    uint32_t compact_size = ReadVarint(&ptr, message_end);
+    if (compact_size == 0
+        || compact_size > static_cast<size_t>(message_end - ptr)) {
+      throw Exception("invalid compact session command size");
+    }
+    const uint8_t* end = ptr + compact_size;
+    uint8_t type = *(ptr++);
+    uint32_t word_count = ReadVarint(&ptr, end);
+    size_t tags_size = (word_count + 3) / 4;
+    if (tags_size > static_cast<size_t>(end - ptr)) {
+      throw Exception("invalid compact session command");
+    }
+    const uint8_t* tags = ptr;
+    ptr += tags_size;
+
+    // Leave room for the length prefix; we fill it in once we know it.
+    size_t size_offset = out->size();
+    out->resize(size_offset + sizeof(uint16_t));
+    out->push_back(type);
+    for (uint32_t i = 0; i < word_count; ++i) {
+      uint32_t word;
+      switch ((tags[i / 4] >> ((i % 4) * 2)) & 0x03) {
+        case kWordZero:
+          word = 0;
+          break;
+        case kWordVarint: {
+          uint32_t zigzag = ReadVarint(&ptr, end);
+          word = (zigzag >> 1) ^ (0 - (zigzag & 1));
+          break;
+        }
+        case kWordHigh16:
+          if (end - ptr < 2) {
+            throw Exception("invalid compact session command");
+          }
+          word = (static_cast<uint32_t>(ptr[0]) << 16)
+                 | (static_cast<uint32_t>(ptr[1]) << 24);
+          ptr += 2;
+          break;
+        default:
+          if (end - ptr < static_cast<ptrdiff_t>(sizeof(word))) {
+            throw Exception("invalid compact session command");
+          }
+          memcpy(&word, ptr, sizeof(word));
+          ptr += sizeof(word);
+          break;
+      }
+      size_t offset = out->size();
+      out->resize(offset + sizeof(word));
+      memcpy(out->data() + offset, &word, sizeof(word));
+    }
+
+    // Whatever is left is the raw tail.
+    out->insert(out->end(), ptr, end);
+    ptr = end;
+    size_t size = out->size() - size_offset - sizeof(uint16_t);
+    if (size > 65535) {
+      throw Exception("invalid compact session command");
+    }
+    auto size16 = static_cast<uint16_t>(size);
+    memcpy(out->data() + size_offset, &size16, sizeof(size16));
+  }
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,39 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_SESSION_COMMAND_CODEC_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_SESSION_COMMAND_CODEC_H_
+
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+
+namespace ballistica::scene_v1 {
+
+/// Converts session-commands messages to and from a compact form for
+/// clients that advertise support for it.
+///
+/// Session commands are a type byte followed by mostly 32 bit ints and
+/// floats. The compact form keeps the type byte and tags each following
+/// 32 bit word as zero, a small zigzag varint, a 16 bit value (its low 16
+/// bits being zero; common for floats such as 1.0 or 0.5), or raw. Any
+/// remaining (sub-word) bytes are passed through as-is. This does not need
+/// to know anything about individual command layouts and is lossless, so
+/// clients simply expand messages back to the regular form and process
+/// them as usual.
+class SessionCommandCodec {
+ public:
+  /// Convert a BA_MESSAGE_SESSION_COMMANDS message to a
+  /// BA_MESSAGE_SESSION_COMMANDS_COMPACT one.
+  static void Compact(const std::vector<uint8_t>& message,
+                      std::vector<uint8_t>* out);
+
+  /// Convert a BA_MESSAGE_SESSION_COMMANDS_COMPACT message back to a
+  /// BA_MESSAGE_SESSION_COMMANDS one. Throws an Exception on malformed
+  /// data.
+  static void Expand(const std::vector<uint8_t>& message,
+                     std::vector<uint8_t>* out);
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_SESSION_COMMAND_CODEC_H_
@@ -2,12 +2,17 @@
 
 #include "ballistica/scene_v1/support/session_stream.h"
 
+#include <algorithm>
+#include <optional>
 #include <string>
 #include <vector>
 
-#include "ballistica/base/assets/assets_server.h"
+#include "ballistica/base/assets/replay_writer.h"
 #include "ballistica/base/dynamics/bg/bg_dynamics.h"
+#include "ballistica/base/logic/logic_profiler.h"
+#include "ballistica/base/networking/network_writer.h"
 #include "ballistica/base/networking/networking.h"
+#include "ballistica/base/support/huffman.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/scene_v1/assets/scene_collision_mesh.h"
 #include "ballistica/scene_v1/assets/scene_data_asset.h"
@@ -16,15 +21,28 @@
 #include "ballistica/scene_v1/assets/scene_texture.h"
 #include "ballistica/scene_v1/connection/connection_set.h"
 #include "ballistica/scene_v1/connection/connection_to_client.h"
+#include "ballistica/scene_v1/connection/shared_message.h"
 #include "ballistica/scene_v1/dynamics/material/material.h"
 #include "ballistica/scene_v1/dynamics/material/material_component.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/support/host_session.h"
 #include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/scene_v1/support/session_command_codec.h"
+#include "ballistica/shared/python/python.h"
 
 namespace ballistica::scene_v1 {
 
+// How long a full-state dump can be served to joining clients before we
+// take a fresh one. Joiners have to catch up on all commands since the
+// dump, so this also bounds how far behind they start out.
+const millisecs_t kMaxFullStateCacheAge = 2000;
+
+// How often we write full-state keyframes into replays (in stream
+// base-time). Seeking a replay fast-forwards from the nearest keyframe, so
+// this bounds seek cost.
+const millisecs_t kReplayKeyframeInterval = 10000;
+
 SessionStream::SessionStream(HostSession* host_session, bool save_replay)
     : app_mode_{classic::ClassicAppMode::GetActiveOrThrow()},
       host_session_{host_session} {
@@ -36,8 +54,8 @@ SessionStream::SessionStream(HostSession* host_session, bool save_replay)
                   " shouldn't happen.");
     }
     // We always write replays as the max protocol version we support.
-    assert(g_base->assets_server);
-    g_base->assets_server->PushBeginWriteReplayCall(kProtocolVersionMax);
+    assert(g_base->replay_writer);
+    g_base->replay_writer->PushBeginWriteReplayCall(kProtocolVersionMax);
     writing_replay_ = true;
     g_scene_v1->replay_open = true;
   }
@@ -62,8 +80,8 @@ SessionStream::~SessionStream() {
                   " shouldn't happen.");
     }
     g_scene_v1->replay_open = false;
-    assert(g_base->assets_server);
-    g_base->assets_server->PushEndWriteReplayCall();
+    assert(g_base->replay_writer);
+    g_base->replay_writer->PushEndWriteReplayCall();
     writing_replay_ = false;
   }
 
@@ -201,17 +219,19 @@ void SessionStream::Fail() {
                   "g_scene_v1->replay_open false at replay close;"
                   " shouldn't happen.");
     }
-    assert(g_base->assets_server);
-    g_base->assets_server->PushEndWriteReplayCall();
+    assert(g_base->replay_writer);
+    g_base->replay_writer->PushEndWriteReplayCall();
     writing_replay_ = false;
     g_scene_v1->replay_open = false;
   }
 }
 
 void SessionStream::Flush() {
+  base::LogicProfiler::Scope profile_scope("session_stream_flush");
   if (!out_command_.empty())
     g_core->Log(LogName::kBa, LogLevel::kError,
                 "SceneStream flushing down with non-empty outCommand");
+  FlushPendingAttrCommands_();
   if (!out_message_.empty()) {
     ShipSessionCommandsMessage();
   }
@@ -348,11 +368,15 @@ void SessionStream::WriteInts64(size_t count, const int64_t* vals) {
   // FIXME: we don't actually support writing 64 bit values to the wire
   // at the moment; will need a protocol update for that.
   // This is just implemented as a placeholder.
-  std::vector<int32_t> vals32(count);
+  assert(count > 0);
+  auto size = out_command_.size();
+  out_command_.resize(size + sizeof(int32_t) * count);
+  uint8_t* ptr = &out_command_[size];
   for (size_t i = 0; i < count; i++) {
-    vals32[i] = static_cast_check_fit<int32_t>(vals[i]);
+    auto val = static_cast_check_fit<int32_t>(vals[i]);
+    memcpy(ptr, &val, sizeof(val));
+    ptr += sizeof(val);
   }
-  WriteInts32(count, vals32.data());
 }
 
 void SessionStream::WriteChars(size_t count, const char* vals) {
@@ -367,8 +391,47 @@ void SessionStream::ShipSessionCommandsMessage() {
   BA_PRECONDITION(!out_message_.empty());
 
   // Send this message to all client-connections we're attached to.
-  for (auto& connection : connections_to_clients_) {
-    (*connection).SendReliableMessage(out_message_);
+  // (batching the resulting packets into a single net-writer call).
+  // All clients (and our full-state cache) share a single encoded copy of
+  // the message.
+  Object::Ref<SharedMessage> message;
+  if (!connections_to_clients_.empty() || full_state_cache_valid_) {
+    message = Object::New<SharedMessage>(out_message_);
+  }
+  if (!connections_to_clients_.empty()) {
+    base::NetworkWriter::ScopedSendBatch batch;
+    Object::Ref<SharedMessage> compact_message;
+    for (auto& connection : connections_to_clients_) {
+      if (connection->compact_session_commands()) {
+        if (!compact_message.exists()) {
+          std::vector<uint8_t> compact;
+          {
+            std::optional<Python::ScopedNativeSection> native_section;
+            if (out_message_.size() > SharedMessage::kMaxSinglePacketSize) {
+              native_section.emplace();
+            }
+            SessionCommandCodec::Compact(out_message_, &compact);
+          }
+          compact_message = Object::New<SharedMessage>(compact);
+        }
+        (*connection).SendSessionCommandsMessage(compact_message);
+      } else {
+        (*connection).SendSessionCommandsMessage(message);
+      }
+    }
+  }
+  if (full_state_cache_valid_) {
+    full_state_cache_log_.push_back(message);
+    full_state_cache_log_size_ += out_message_.size();
+
+    // Once the log outgrows the dump it's cheaper to just take a new one.
+    if (full_state_cache_log_size_
+            > (full_state_cache_.exists() ? full_state_cache_->data().size()
+                                          : 0)
+        || g_core->AppTimeMillisecs() - full_state_cache_time_
+               > kMaxFullStateCacheAge) {
+      InvalidateFullStateCache_();
+    }
   }
   if (writing_replay_) {
     AddMessageToReplay(out_message_);
@@ -377,9 +440,16 @@ void SessionStream::ShipSessionCommandsMessage() {
   last_send_time_ = g_core->AppTimeMillisecs();
 }
 
+void SessionStream::InvalidateFullStateCache_() {
+  full_state_cache_.Clear();
+  full_state_cache_log_.clear();
+  full_state_cache_log_size_ = 0;
+  full_state_cache_valid_ = false;
+}
+
 void SessionStream::AddMessageToReplay(const std::vector<uint8_t>& message) {
   assert(writing_replay_);
-  assert(g_base->assets_server);
+  assert(g_base->replay_writer);
 
   assert(!message.empty());
   if (g_buildconfig.debug_build()) {
@@ -387,6 +457,7 @@ void SessionStream::AddMessageToReplay(const std::vector<uint8_t>& message) {
       case BA_MESSAGE_SESSION_RESET:
       case BA_MESSAGE_SESSION_COMMANDS:
       case BA_MESSAGE_SESSION_DYNAMICS_CORRECTION:
+      case BA_MESSAGE_REPLAY_KEYFRAME:
         break;
       default:
         throw Exception("unexpected message going to replay: "
@@ -394,7 +465,48 @@ void SessionStream::AddMessageToReplay(const std::vector<uint8_t>& message) {
     }
   }
 
-  g_base->assets_server->PushAddMessageToReplayCall(message);
+  g_base->replay_writer->PushAddMessageToReplayCall(message);
+}
+
+void SessionStream::AddKeyframeToReplay_() {
+  assert(host_session_ && writing_replay_);
+
+  // Should only happen with everything shipped; the keyframe needs to
+  // reflect the stream up to exactly this point.
+  assert(out_message_.empty());
+
+  SessionStream out(nullptr, false);
+  host_session_->DumpFullState(&out);
+  std::vector<std::vector<uint8_t> > messages;
+  messages.push_back(out.GetOutMessage());
+  if (messages.back().empty()) {
+    messages.pop_back();
+  }
+  host_session_->GetCorrectionMessages(false, &messages);
+
+  size_t size = 1 + sizeof(int64_t) + sizeof(uint32_t);
+  for (auto&& message : messages) {
+    size += sizeof(uint32_t) + message.size();
+  }
+  std::vector<uint8_t> keyframe(size);
+  uint8_t* ptr = keyframe.data();
+  *(ptr++) = BA_MESSAGE_REPLAY_KEYFRAME;
+  auto base_time = static_cast<int64_t>(stream_base_time_);
+  memcpy(ptr, &base_time, sizeof(base_time));
+  ptr += sizeof(base_time);
+  auto count = static_cast<uint32_t>(messages.size());
+  memcpy(ptr, &count, sizeof(count));
+  ptr += sizeof(count);
+  for (auto&& message : messages) {
+    auto message_size = static_cast<uint32_t>(message.size());
+    memcpy(ptr, &message_size, sizeof(message_size));
+    ptr += sizeof(message_size);
+    memcpy(ptr, message.data(), message.size());
+    ptr += message.size();
+  }
+  assert(ptr == keyframe.data() + keyframe.size());
+  AddMessageToReplay(keyframe);
+  last_replay_keyframe_time_ = stream_base_time_;
 }
 
 void SessionStream::SendPhysicsCorrection(bool blend) {
@@ -403,11 +515,38 @@ void SessionStream::SendPhysicsCorrection(bool blend) {
   std::vector<std::vector<uint8_t> > messages;
   host_session_->GetCorrectionMessages(blend, &messages);
 
+  // Blended corrections are periodic refreshes, so clients on congested
+  // links get them less often (up to 4x the normal interval). Non-blended
+  // ones are needed to sync up and always go to everyone.
+  millisecs_t real_time = g_core->AppTimeMillisecs();
+  std::vector<ConnectionToClient*> recipients;
+  recipients.reserve(connections_to_clients_.size());
+  for (auto& connection : connections_to_clients_) {
+    auto interval = static_cast<millisecs_t>(
+        static_cast<float>(GetDynamicsSyncTime_())
+        * (1.0f + 3.0f * connection->congestion()));
+    if (!blend
+        || real_time - connection->last_physics_correction_time()
+               >= interval) {
+      connection->set_last_physics_correction_time(real_time);
+      recipients.push_back(connection);
+    }
+  }
+
   // FIXME - have to send reliably at the moment since these will most likely be
   //  bigger than our unreliable packet limit. :-(
+  base::NetworkWriter::ScopedSendBatch batch;
   for (auto& message : messages) {
-    for (auto& connections_to_client : connections_to_clients_) {
-      (*connections_to_client).SendReliableMessage(message);
+    if (g_scene_v1->session_command_stats_enabled()) {
+      AddCommandStats_(
+          static_cast<uint8_t>(SessionCommand::kDynamicsCorrection),
+          message.data(), message.size());
+    }
+    if (!recipients.empty()) {
+      auto shared_message = Object::New<SharedMessage>(message);
+      for (auto& connections_to_client : recipients) {
+        (*connections_to_client).SendReliableMessage(shared_message);
+      }
     }
     if (writing_replay_) {
       AddMessageToReplay(message);
@@ -415,8 +554,9 @@ void SessionStream::SendPhysicsCorrection(bool blend) {
   }
 }
 
-void SessionStream::EndCommand(bool is_time_set) {
-  assert(!out_command_.empty());
+void SessionStream::AppendCommandToMessage_(
+    const std::vector<uint8_t>& command) {
+  assert(!command.empty());
 
   int out_message_size;
   if (out_message_.empty()) {
@@ -429,21 +569,100 @@ void SessionStream::EndCommand(bool is_time_set) {
   }
 
   out_message_.resize(out_message_size + 2
-                      + out_command_.size());  // command length plus data
+                      + command.size());  // command length plus data
 
-  auto val = static_cast<uint16_t>(out_command_.size());
+  auto val = static_cast<uint16_t>(command.size());
   memcpy(&(out_message_[out_message_size]), &val, 2);
-  memcpy(&(out_message_[out_message_size + 2]), &(out_command_[0]),
-         out_command_.size());
+  memcpy(&(out_message_[out_message_size + 2]), command.data(),
+         command.size());
+
+  // Count the length prefix as part of the command.
+  if (host_session_ && g_scene_v1->session_command_stats_enabled()) {
+    AddCommandStats_(command[0], &(out_message_[out_message_size]),
+                     command.size() + 2);
+  }
+}
+
+void SessionStream::AddCommandStats_(uint8_t type, const uint8_t* data,
+                                     size_t size) {
+  auto& stats = g_scene_v1->session_command_stats();
+  if (stats.size() <= type) {
+    stats.resize(static_cast<size_t>(type) + 1);
+  }
+  auto& entry = stats[type];
+  entry.count++;
+  entry.bytes += static_cast<int64_t>(size);
+  entry.compressed_bits += g_base->huffman->encoded_bit_count(data, size);
+}
+
+void SessionStream::EndAttrCommand_(const NodeAttribute& attr) {
+  if (!host_session_ || !app_mode_->coalesce_node_attrs()) {
+    EndCommand();
+    return;
+  }
+  assert(!out_command_.empty());
+
+  // Hold on to attr writes until the next non-attr command. If this attr
+  // already has a write pending, that one is superseded; we drop it and
+  // queue this one at the end so that final values still land in the
+  // order they were written. Re-writing an identical value with nothing
+  // else in between is simply dropped.
+  auto key = (static_cast<uint64_t>(attr.node->stream_id()) << 16)
+             | static_cast<uint64_t>(attr.index());
+  auto i = pending_attr_command_indices_.find(key);
+  if (i != pending_attr_command_indices_.end()) {
+    auto& pending = pending_attr_commands_[i->second];
+    if (i->second == pending_attr_commands_.size() - 1
+        && pending == out_command_) {
+      out_command_.clear();
+      return;
+    }
+    pending.clear();
+  }
+  pending_attr_command_indices_[key] = pending_attr_commands_.size();
+  pending_attr_commands_.push_back(out_command_);
+  out_command_.clear();
+}
+
+void SessionStream::FlushPendingAttrCommands_() {
+  if (pending_attr_commands_.empty()) {
+    return;
+  }
+  for (auto&& command : pending_attr_commands_) {
+    // Superseded entries are left empty.
+    if (!command.empty()) {
+      AppendCommandToMessage_(command);
+    }
+  }
+  pending_attr_commands_.clear();
+  pending_attr_command_indices_.clear();
+}
+
+auto SessionStream::GetBufferTime_() const -> millisecs_t {
+  return std::max(app_mode_->buffer_time(),
+                  app_mode_->tick_monitor()->current().min_buffer_time);
+}
+
+auto SessionStream::GetDynamicsSyncTime_() const -> millisecs_t {
+  return std::max(app_mode_->dynamics_sync_time(),
+                  app_mode_->tick_monitor()->current().min_dynamics_sync_time);
+}
+
+void SessionStream::EndCommand(bool is_time_set) {
+  assert(!out_command_.empty());
+
+  // Any coalesced attr writes need to go out ahead of this command; steps,
+  // messages, etc. can all change attr values on the client.
+  FlushPendingAttrCommands_();
+  AppendCommandToMessage_(out_command_);
 
   // When attached to a host-session, send this message to clients if it's been
   // long enough. Also send off occasional correction packets.
   if (host_session_) {
-    auto* appmode = classic::ClassicAppMode::GetSingleton();
     // Now if its been long enough *AND* this is a time-step command, send.
     millisecs_t real_time = g_core->AppTimeMillisecs();
     millisecs_t diff = real_time - last_send_time_;
-    if (is_time_set && diff >= app_mode_->buffer_time()) {
+    if (is_time_set && diff >= GetBufferTime_()) {
       ShipSessionCommandsMessage();
 
       // Also, as long as we're here, fire off a physics-correction packet every
@@ -453,10 +672,17 @@ void SessionStream::EndCommand(bool is_time_set) {
       // commands; otherwise the client will get the correction that accounts
       // for commands that they haven't been sent yet.
       diff = real_time - last_physics_correction_time_;
-      if (diff >= appmode->dynamics_sync_time()) {
+      if (diff >= GetDynamicsSyncTime_()) {
         last_physics_correction_time_ = real_time;
         SendPhysicsCorrection(true);
       }
+
+      // Same deal for replay keyframes.
+      if (writing_replay_
+          && stream_base_time_ - last_replay_keyframe_time_
+                 >= kReplayKeyframeInterval) {
+        AddKeyframeToReplay_();
+      }
     }
   }
   out_command_.clear();
@@ -546,6 +772,7 @@ void SessionStream::SetTime(millisecs_t t) {
   }
   WriteCommandInt64(SessionCommand::kBaseTimeStep, diff);
   time_ = t;
+  stream_base_time_ += diff;
   EndCommand(true);
 }
 
@@ -609,6 +836,11 @@ void SessionStream::RemoveNode(Node* n) {
   EndCommand();
 }
 
+void SessionStream::ReleaseNode(Node* n) {
+  assert(IsValidNode(n));
+  Remove(n, &nodes_, &free_indices_nodes_);
+}
+
 void SessionStream::AddTexture(SceneTexture* t) {
   // Register an ID in host mode.
   if (host_session_) {
@@ -789,21 +1021,21 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, float val) {
   WriteCommandInt64_2(SessionCommand::kSetNodeAttrFloat, attr.node->stream_id(),
                       attr.index());
   WriteFloat(val);
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, int64_t val) {
   assert(IsValidNode(attr.node));
   WriteCommandInt64_3(SessionCommand::kSetNodeAttrInt32, attr.node->stream_id(),
                       attr.index(), val);
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, bool val) {
   assert(IsValidNode(attr.node));
   WriteCommandInt64_3(SessionCommand::kSetNodeAttrBool, attr.node->stream_id(),
                       attr.index(), val);
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
@@ -816,7 +1048,7 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr,
   if (count > 0) {
     WriteFloats(count, vals.data());
   }
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
@@ -829,7 +1061,7 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr,
   if (count > 0) {
     WriteInts64(count, vals.data());
   }
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
@@ -838,7 +1070,7 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr,
   WriteCommandInt64_2(SessionCommand::kSetNodeAttrString,
                       attr.node->stream_id(), attr.index());
   WriteString(val);
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, Node* val) {
@@ -854,37 +1086,50 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, Node* val) {
     WriteCommandInt64_2(SessionCommand::kSetNodeAttrNodeNull,
                         attr.node->stream_id(), attr.index());
   }
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
-void SessionStream::SetNodeAttr(const NodeAttribute& attr,
-                                const std::vector<Node*>& vals) {
+// Writes an attr command listing the stream ids of some scene components.
+// Ids go straight into the command; no need for a temp buffer.
+template <typename T>
+void SessionStream::WriteNodeAttrStreamIDs_(
+    const NodeAttribute& attr, SessionCommand cmd, const std::vector<T*>& vals,
+    bool (SessionStream::*is_valid)(T*), const char* scene_error) {
   assert(IsValidNode(attr.node));
   if (g_buildconfig.debug_build()) {
-    if (g_buildconfig.debug_build()) {
-      for (auto val : vals) {
-        assert(IsValidNode(val));
-      }
+    for (auto val : vals) {
+      assert((this->*is_valid)(val));
     }
   }
-  size_t count{vals.size()};
-  std::vector<int32_t> vals_out;
-  if (count > 0) {
-    vals_out.resize(count);
-    Scene* scene = attr.node->scene();
-    for (size_t i = 0; i < count; i++) {
-      if (vals[i]->scene() != scene) {
-        throw Exception("nodes are from different scenes");
-      }
-      vals_out[i] = static_cast_check_fit<int32_t>(vals[i]->stream_id());
+
+  // Check everything before writing anything so a throw leaves us clean.
+  Scene* scene{attr.node->scene()};
+  for (auto val : vals) {
+    if (val->scene() != scene) {
+      throw Exception(scene_error);
     }
   }
-  WriteCommandInt64_3(SessionCommand::kSetNodeAttrNodes, attr.node->stream_id(),
-                      attr.index(), static_cast_check_fit<int64_t>(count));
+  size_t count{vals.size()};
+  WriteCommandInt64_3(cmd, attr.node->stream_id(), attr.index(),
+                      static_cast_check_fit<int64_t>(count));
   if (count > 0) {
-    WriteInts32(count, vals_out.data());
+    auto size = out_command_.size();
+    out_command_.resize(size + sizeof(int32_t) * count);
+    uint8_t* ptr = &out_command_[size];
+    for (auto val : vals) {
+      auto id = static_cast_check_fit<int32_t>(val->stream_id());
+      memcpy(ptr, &id, sizeof(id));
+      ptr += sizeof(id);
+    }
   }
-  EndCommand();
+  EndAttrCommand_(attr);
+}
+
+void SessionStream::SetNodeAttr(const NodeAttribute& attr,
+                                const std::vector<Node*>& vals) {
+  WriteNodeAttrStreamIDs_(attr, SessionCommand::kSetNodeAttrNodes, vals,
+                          &SessionStream::IsValidNode,
+                          "nodes are from different scenes");
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, Player* val) {
@@ -893,31 +1138,9 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, Player* val) {
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::vector<Material*>& vals) {
-  assert(IsValidNode(attr.node));
-  if (g_buildconfig.debug_build()) {
-    for (auto val : vals) {
-      assert(IsValidMaterial(val));
-    }
-  }
-  size_t count = vals.size();
-  std::vector<int32_t> vals_out;
-  if (count > 0) {
-    vals_out.resize(count);
-    Scene* scene = attr.node->scene();
-    for (size_t i = 0; i < count; i++) {
-      if (vals[i]->scene() != scene) {
-        throw Exception("material/node are from different scenes");
-      }
-      vals_out[i] = static_cast_check_fit<int32_t>(vals[i]->stream_id());
-    }
-  }
-  WriteCommandInt64_3(SessionCommand::kSetNodeAttrMaterials,
-                      attr.node->stream_id(), attr.index(),
-                      static_cast_check_fit<int64_t>(count));
-  if (count > 0) {
-    WriteInts32(count, &(vals_out[0]));
-  }
-  EndCommand();
+  WriteNodeAttrStreamIDs_(attr, SessionCommand::kSetNodeAttrMaterials, vals,
+                          &SessionStream::IsValidMaterial,
+                          "material/node are from different scenes");
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, SceneTexture* val) {
@@ -933,36 +1156,14 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, SceneTexture* val) {
     WriteCommandInt64_2(SessionCommand::kSetNodeAttrTextureNull,
                         attr.node->stream_id(), attr.index());
   }
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::vector<SceneTexture*>& vals) {
-  assert(IsValidNode(attr.node));
-  if (g_buildconfig.debug_build()) {
-    for (auto val : vals) {
-      assert(IsValidTexture(val));
-    }
-  }
-  size_t count{vals.size()};
-  std::vector<int32_t> vals_out;
-  if (count > 0) {
-    vals_out.resize(count);
-    Scene* scene{attr.node->scene()};
-    for (size_t i = 0; i < count; i++) {
-      if (vals[i]->scene() != scene) {
-        throw Exception("texture/node are from different scenes");
-      }
-      vals_out[i] = static_cast_check_fit<int32_t>(vals[i]->stream_id());
-    }
-  }
-  WriteCommandInt64_3(SessionCommand::kSetNodeAttrTextures,
-                      attr.node->stream_id(), attr.index(),
-                      static_cast_check_fit<int64_t>(count));
-  if (count > 0) {
-    WriteInts32(count, vals_out.data());
-  }
-  EndCommand();
+  WriteNodeAttrStreamIDs_(attr, SessionCommand::kSetNodeAttrTextures, vals,
+                          &SessionStream::IsValidTexture,
+                          "texture/node are from different scenes");
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, SceneSound* val) {
@@ -978,36 +1179,14 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, SceneSound* val) {
     WriteCommandInt64_2(SessionCommand::kSetNodeAttrSoundNull,
                         attr.node->stream_id(), attr.index());
   }
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::vector<SceneSound*>& vals) {
-  assert(IsValidNode(attr.node));
-  if (g_buildconfig.debug_build()) {
-    for (auto val : vals) {
-      assert(IsValidSound(val));
-    }
-  }
-  size_t count{vals.size()};
-  std::vector<int32_t> vals_out;
-  if (count > 0) {
-    vals_out.resize(count);
-    Scene* scene = attr.node->scene();
-    for (size_t i = 0; i < count; i++) {
-      if (vals[i]->scene() != scene) {
-        throw Exception("sound/node are from different scenes");
-      }
-      vals_out[i] = static_cast_check_fit<int32_t>(vals[i]->stream_id());
-    }
-  }
-  WriteCommandInt64_3(SessionCommand::kSetNodeAttrSounds,
-                      attr.node->stream_id(), attr.index(),
-                      static_cast_check_fit<int64_t>(count));
-  if (count > 0) {
-    WriteInts32(count, &(vals_out[0]));
-  }
-  EndCommand();
+  WriteNodeAttrStreamIDs_(attr, SessionCommand::kSetNodeAttrSounds, vals,
+                          &SessionStream::IsValidSound,
+                          "sound/node are from different scenes");
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr, SceneMesh* val) {
@@ -1023,36 +1202,14 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr, SceneMesh* val) {
     WriteCommandInt64_2(SessionCommand::kSetNodeAttrMeshNull,
                         attr.node->stream_id(), attr.index());
   }
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::vector<SceneMesh*>& vals) {
-  assert(IsValidNode(attr.node));
-  if (g_buildconfig.debug_build()) {
-    for (auto val : vals) {
-      assert(IsValidMesh(val));
-    }
-  }
-  size_t count = vals.size();
-  std::vector<int32_t> vals_out;
-  if (count > 0) {
-    vals_out.resize(count);
-    Scene* scene = attr.node->scene();
-    for (size_t i = 0; i < count; i++) {
-      if (vals[i]->scene() != scene) {
-        throw Exception("mesh/node are from different scenes");
-      }
-      vals_out[i] = static_cast_check_fit<int32_t>(vals[i]->stream_id());
-    }
-  }
-  WriteCommandInt64_3(SessionCommand::kSetNodeAttrMeshes,
-                      attr.node->stream_id(), attr.index(),
-                      static_cast_check_fit<int64_t>(count));
-  if (count > 0) {
-    WriteInts32(count, &(vals_out[0]));
-  }
-  EndCommand();
+  WriteNodeAttrStreamIDs_(attr, SessionCommand::kSetNodeAttrMeshes, vals,
+                          &SessionStream::IsValidMesh,
+                          "mesh/node are from different scenes");
 }
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 SceneCollisionMesh* val) {
@@ -1068,35 +1225,13 @@ void SessionStream::SetNodeAttr(const NodeAttribute& attr,
     WriteCommandInt64_2(SessionCommand::kSetNodeAttrCollisionMeshNull,
                         attr.node->stream_id(), attr.index());
   }
-  EndCommand();
+  EndAttrCommand_(attr);
 }
 void SessionStream::SetNodeAttr(const NodeAttribute& attr,
                                 const std::vector<SceneCollisionMesh*>& vals) {
-  assert(IsValidNode(attr.node));
-  if (g_buildconfig.debug_build()) {
-    for (auto val : vals) {
-      assert(IsValidCollisionMesh(val));
-    }
-  }
-  size_t count = vals.size();
-  std::vector<int32_t> vals_out;
-  if (count > 0) {
-    vals_out.resize(count);
-    Scene* scene = attr.node->scene();
-    for (size_t i = 0; i < count; i++) {
-      if (vals[i]->scene() != scene) {
-        throw Exception("collision_mesh/node are from different scenes");
-      }
-      vals_out[i] = static_cast_check_fit<int32_t>(vals[i]->stream_id());
-    }
-  }
-  WriteCommandInt64_3(SessionCommand::kSetNodeAttrCollisionMeshes,
-                      attr.node->stream_id(), attr.index(),
-                      static_cast_check_fit<int64_t>(count));
-  if (count > 0) {
-    WriteInts32(count, &(vals_out[0]));
-  }
-  EndCommand();
+  WriteNodeAttrStreamIDs_(attr, SessionCommand::kSetNodeAttrCollisionMeshes,
+                          vals, &SessionStream::IsValidCollisionMesh,
+                          "collision_mesh/node are from different scenes");
 }
 
 void SessionStream::PlaySoundAtPosition(SceneSound* sound, float volume,
@@ -1114,6 +1249,11 @@ void SessionStream::PlaySoundAtPosition(SceneSound* sound, float volume,
 }
 
 void SessionStream::EmitBGDynamics(const base::BGDynamicsEmission& e) {
+  // These are purely cosmetic; overloaded hosts can skip them.
+  if (host_session_
+      && !app_mode_->tick_monitor()->current().forward_bg_dynamics) {
+    return;
+  }
   WriteCommandInt64_4(SessionCommand::kEmitBGDynamics,
                       static_cast<int64_t>(e.emit_type), e.count,
                       static_cast<int64_t>(e.chunk_type),
@@ -1224,19 +1364,38 @@ void SessionStream::OnClientConnected(ConnectionToClient* c) {
 
     connections_to_clients_.push_back(c);
 
-    // We create a temporary output stream just for the purpose of building
-    // a giant session-commands message to reconstruct everything in our
-    // host-session in its current form.
-    SessionStream out(nullptr, false);
+    millisecs_t real_time = g_core->AppTimeMillisecs();
+    if (full_state_cache_valid_
+        && real_time - full_state_cache_time_ > kMaxFullStateCacheAge) {
+      InvalidateFullStateCache_();
+    }
+
+    if (!full_state_cache_valid_) {
+      // We create a temporary output stream just for the purpose of building
+      // a giant session-commands message to reconstruct everything in our
+      // host-session in its current form.
+      SessionStream out(nullptr, false);
 
-    // Ask the host-session that we came from to dump it's complete state.
-    host_session_->DumpFullState(&out);
+      // Ask the host-session that we came from to dump it's complete state.
+      host_session_->DumpFullState(&out);
 
-    // Grab the message that's been built up.
-    // If its not empty, send it to the client.
-    std::vector<uint8_t> out_message = out.GetOutMessage();
-    if (!out_message.empty()) {
-      c->SendReliableMessage(out_message);
+      // Grab the message that's been built up and hold on to it for any
+      // other clients joining soon.
+      std::vector<uint8_t> out_message = out.GetOutMessage();
+      if (!out_message.empty()) {
+        full_state_cache_ = Object::New<SharedMessage>(out_message);
+      }
+      full_state_cache_time_ = real_time;
+      full_state_cache_valid_ = true;
+    }
+
+    // Send the dump (if its not empty) plus everything that's happened
+    // since.
+    if (full_state_cache_.exists()) {
+      c->SendReliableMessage(full_state_cache_);
+    }
+    for (auto&& message : full_state_cache_log_) {
+      c->SendReliableMessage(message);
     }
 
     // Also send a correction packet to sync up all our dynamics.
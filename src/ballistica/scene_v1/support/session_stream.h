@@ -4,6 +4,7 @@
 #define BALLISTICA_SCENE_V1_SUPPORT_SESSION_STREAM_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -26,6 +27,10 @@ class SessionStream : public Object, public ClientControllerInterface {
   void AddNode(Node* n);
   void NodeOnCreate(Node* n);
   void RemoveNode(Node* n);
+
+  /// Free up a node's id without sending a removal; for nodes going down
+  /// along with their scene (whose removal takes them out on the far end).
+  void ReleaseNode(Node* n);
   void SetForegroundScene(Scene* sg);
   void AddMaterial(Material* m);
   void RemoveMaterial(Material* m);
@@ -95,11 +100,22 @@ class SessionStream : public Object, public ClientControllerInterface {
 
   void Flush();
   void AddMessageToReplay(const std::vector<uint8_t>& message);
+  void AddKeyframeToReplay_();
   void Fail();
 
   void ShipSessionCommandsMessage();
+  void InvalidateFullStateCache_();
   void SendPhysicsCorrection(bool blend);
   void EndCommand(bool is_time_set = false);
+
+  /// Our configured buffer and physics-correction times, stretched as
+  /// needed by any degradation tier we're in.
+  auto GetBufferTime_() const -> millisecs_t;
+  auto GetDynamicsSyncTime_() const -> millisecs_t;
+  void EndAttrCommand_(const NodeAttribute& attr);
+  void AppendCommandToMessage_(const std::vector<uint8_t>& command);
+  void AddCommandStats_(uint8_t type, const uint8_t* data, size_t size);
+  void FlushPendingAttrCommands_();
   void WriteString(const std::string& s);
   void WriteFloat(float val);
   void WriteFloats(size_t count, const float* vals);
@@ -128,6 +144,11 @@ class SessionStream : public Object, public ClientControllerInterface {
   void Add(T* val, std::vector<T*>* vec, std::vector<size_t>* free_indices);
   template <typename T>
   void Remove(T* val, std::vector<T*>* vec, std::vector<size_t>* free_indices);
+  template <typename T>
+  void WriteNodeAttrStreamIDs_(const NodeAttribute& attr, SessionCommand cmd,
+                               const std::vector<T*>& vals,
+                               bool (SessionStream::*is_valid)(T*),
+                               const char* scene_error);
 
   HostSession* host_session_;
   millisecs_t next_flush_time_{};
@@ -137,13 +158,33 @@ class SessionStream : public Object, public ClientControllerInterface {
 
   // The complete message full of commands.
   std::vector<uint8_t> out_message_;
+
+  // Node-attr commands held back while coalescing, and the index of the
+  // live entry for each node/attr pair.
+  std::vector<std::vector<uint8_t>> pending_attr_commands_;
+  std::unordered_map<uint64_t, size_t> pending_attr_command_indices_;
   std::vector<ConnectionToClient*> connections_to_clients_;
+
+  // Most recent full-state dump for bringing joining clients up to date,
+  // plus all session-commands messages we've shipped since taking it.
+  // Joiners get the dump followed by the log, which leaves them in the same
+  // state as a fresh dump would have.
+  Object::Ref<SharedMessage> full_state_cache_;
+  std::vector<Object::Ref<SharedMessage>> full_state_cache_log_;
+  size_t full_state_cache_log_size_{};
+  millisecs_t full_state_cache_time_{};
+  bool full_state_cache_valid_{};
   std::vector<ConnectionToClient*> connections_to_clients_ignored_;
   classic::ClassicAppMode* app_mode_;
   bool writing_replay_{};
   millisecs_t last_physics_correction_time_{};
   millisecs_t last_send_time_{};
   millisecs_t time_{};
+
+  // Sum of all time-steps we've written; matches the base-time clients
+  // reconstruct from our stream.
+  millisecs_t stream_base_time_{};
+  millisecs_t last_replay_keyframe_time_{};
   std::vector<Scene*> scenes_;
   std::vector<size_t> free_indices_scene_graphs_;
   std::vector<Node*> nodes_;
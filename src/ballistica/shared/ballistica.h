@@ -54,6 +54,14 @@ const int kBaseVirtualResY = 720;
 
 // Magic numbers at the start of our file types.
 const int kBrpFileID = 83749;
+
+// Replays containing periodic keyframes and (when finished cleanly) a
+// keyframe index at the end. After the last message comes a zero length
+// byte, then the index: a uint32 count followed by that many (int64
+// base-time, int64 file-offset) pairs. The file ends with the int64 offset
+// of the index followed by kBrpIndexFooterID.
+const int kBrpFileIDIndexed = 83750;
+const int kBrpIndexFooterID = 29471;
 const int kBobFileID = 45623;
 const int kCobFileID = 13466;
 
@@ -0,0 +1,216 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/bench/bench.h"
+
+#if BA_BENCH_BUILD
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/generic/json_stream.h"
+
+namespace ballistica {
+
+struct BenchmarkResult_ {
+  std::string name;
+  int64_t iterations{};
+  std::vector<double> ns_per_iteration;
+  double items_per_second{};
+  double bytes_per_second{};
+};
+
+static auto Benchmarks_()
+    -> std::vector<std::pair<const char*, BenchmarkCall*>>& {
+  static std::vector<std::pair<const char*, BenchmarkCall*>> benchmarks;
+  return benchmarks;
+}
+
+BenchmarkRegistration::BenchmarkRegistration(const char* name,
+                                             BenchmarkCall* call) {
+  Benchmarks_().emplace_back(name, call);
+}
+
+static auto TimeRun_(BenchmarkCall* call, int64_t iterations,
+                     BenchmarkState* state) -> microsecs_t {
+  *state = BenchmarkState();
+  state->iterations = iterations;
+  microsecs_t start = core::CorePlatform::TimeMonotonicMicrosecs();
+  call(state);
+  return core::CorePlatform::TimeMonotonicMicrosecs() - start;
+}
+
+static auto RunBenchmark_(const char* name, BenchmarkCall* call,
+                          microsecs_t min_time, int repetitions)
+    -> BenchmarkResult_ {
+  BenchmarkResult_ result;
+  result.name = name;
+
+  // Grow the iteration count until a single run takes at least min_time.
+  BenchmarkState state;
+  int64_t iterations{1};
+  while (true) {
+    microsecs_t duration = TimeRun_(call, iterations, &state);
+    if (duration >= min_time || iterations >= (int64_t{1} << 32)) {
+      break;
+    }
+    int64_t scaled =
+        duration > 0 ? static_cast<int64_t>(static_cast<double>(iterations)
+                                            * static_cast<double>(min_time)
+                                            / static_cast<double>(duration)
+                                            * 1.2)
+                     : iterations * 100;
+    iterations = std::clamp(scaled, iterations * 2, iterations * 100);
+  }
+  result.iterations = iterations;
+
+  microsecs_t total_time{};
+  int64_t total_items{};
+  int64_t total_bytes{};
+  for (int i = 0; i < repetitions; ++i) {
+    microsecs_t duration = TimeRun_(call, iterations, &state);
+    result.ns_per_iteration.push_back(static_cast<double>(duration) * 1000.0
+                                      / static_cast<double>(iterations));
+    total_time += duration;
+    total_items += state.items_processed;
+    total_bytes += state.bytes_processed;
+  }
+  std::sort(result.ns_per_iteration.begin(), result.ns_per_iteration.end());
+  if (total_time > 0) {
+    double seconds = static_cast<double>(total_time) / 1000000.0;
+    result.items_per_second = static_cast<double>(total_items) / seconds;
+    result.bytes_per_second = static_cast<double>(total_bytes) / seconds;
+  }
+  return result;
+}
+
+static void PrintUsage_(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--list] [--filter=SUBSTRING] [--min-time=SECONDS]\n"
+          "          [--repetitions=COUNT] [--output=PATH]\n",
+          program);
+}
+
+auto RunBenchmarks(int argc, char** argv) -> int {
+  std::string filter;
+  std::string output_path;
+  double min_time_secs{0.2};
+  int repetitions{5};
+  bool list{};
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    if (!strcmp(arg, "--list")) {
+      list = true;
+    } else if (!strncmp(arg, "--filter=", 9)) {
+      filter = arg + 9;
+    } else if (!strncmp(arg, "--min-time=", 11)) {
+      min_time_secs = atof(arg + 11);
+    } else if (!strncmp(arg, "--repetitions=", 14)) {
+      repetitions = atoi(arg + 14);
+    } else if (!strncmp(arg, "--output=", 9)) {
+      output_path = arg + 9;
+    } else {
+      PrintUsage_(argv[0]);
+      return 2;
+    }
+  }
+  if (min_time_secs <= 0.0 || repetitions < 1) {
+    PrintUsage_(argv[0]);
+    return 2;
+  }
+
+  auto benchmarks = Benchmarks_();
+  std::sort(benchmarks.begin(), benchmarks.end(),
+            [](const auto& a, const auto& b) {
+              return strcmp(a.first, b.first) < 0;
+            });
+  if (list) {
+    for (auto&& i : benchmarks) {
+      printf("%s\n", i.first);
+    }
+    return 0;
+  }
+
+  JsonWriter out;
+  out.BeginObject();
+  out.Key("engine_version");
+  out.String(kEngineVersion);
+  out.Key("engine_build_number");
+  out.Number(kEngineBuildNumber);
+  out.Key("debug_build");
+  out.Bool(g_buildconfig.debug_build());
+  out.Key("benchmarks");
+  out.BeginArray();
+
+  auto min_time = static_cast<microsecs_t>(min_time_secs * 1000000.0);
+  for (auto&& i : benchmarks) {
+    if (!filter.empty() && !strstr(i.first, filter.c_str())) {
+      continue;
+    }
+    auto result = RunBenchmark_(i.first, i.second, min_time, repetitions);
+    auto& times = result.ns_per_iteration;
+    double median = times[times.size() / 2];
+    fprintf(stderr, "%-40s %12.1f ns  (min %.1f, max %.1f, %lld iters)\n",
+            result.name.c_str(), median, times.front(), times.back(),
+            static_cast<long long>(result.iterations));  // NOLINT
+
+    out.BeginObject();
+    out.Key("name");
+    out.String(result.name);
+    out.Key("iterations");
+    out.Number(static_cast<double>(result.iterations));
+    out.Key("repetitions");
+    out.Number(repetitions);
+    out.Key("ns_per_iteration_median");
+    out.Number(median);
+    out.Key("ns_per_iteration_min");
+    out.Number(times.front());
+    out.Key("ns_per_iteration_max");
+    out.Number(times.back());
+    if (result.items_per_second > 0.0) {
+      out.Key("items_per_second");
+      out.Number(result.items_per_second);
+    }
+    if (result.bytes_per_second > 0.0) {
+      out.Key("bytes_per_second");
+      out.Number(result.bytes_per_second);
+    }
+    out.EndObject();
+  }
+  out.EndArray();
+  out.EndObject();
+
+  FILE* f = stdout;
+  if (!output_path.empty()) {
+    f = fopen(output_path.c_str(), "wb");
+    if (!f) {
+      fprintf(stderr, "Unable to open '%s' for writing.\n",
+              output_path.c_str());
+      return 1;
+    }
+  }
+  fprintf(f, "%s\n", out.str().c_str());
+  if (f != stdout) {
+    fclose(f);
+  }
+  return 0;
+}
+
+}  // namespace ballistica
+
+auto main(int argc, char** argv) -> int {
+  // Some of what we measure (event loops, logging on error paths, etc.)
+  // leans on core, so bring it up the same way the app does. This means
+  // the bench needs to run from a staged build dir like the app binary.
+  auto core_config = ballistica::core::CoreConfig::ForEnvVars();
+  ballistica::core::CoreFeatureSet::Import(&core_config);
+  return ballistica::RunBenchmarks(argc, argv);
+}
+
+#endif  // BA_BENCH_BUILD
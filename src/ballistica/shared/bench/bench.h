@@ -0,0 +1,59 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_BENCH_BENCH_H_
+#define BALLISTICA_SHARED_BENCH_BENCH_H_
+
+#include <cstdint>
+
+#include "ballistica/shared/ballistica.h"
+
+// Native microbenchmarks. These only get compiled into the
+// ballisticakit_bench target (BA_BENCH_BUILD=1); in regular builds the
+// benchmark sources are empty.
+
+namespace ballistica {
+
+/// Passed to a benchmark body. The body should do its unit of work
+/// `iterations` times, and can fill in how many items and/or bytes that
+/// covered so throughput gets reported alongside timings.
+struct BenchmarkState {
+  int64_t iterations{};
+  int64_t items_processed{};
+  int64_t bytes_processed{};
+};
+
+typedef void(BenchmarkCall)(BenchmarkState* state);
+
+/// Adds a benchmark to the global list at static-init time. Use the
+/// BA_BENCHMARK macro instead of this directly.
+class BenchmarkRegistration {
+ public:
+  BenchmarkRegistration(const char* name, BenchmarkCall* call);
+};
+
+/// Keep the compiler from optimizing away a value we computed.
+template <typename T>
+inline void BenchmarkKeep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static const void* volatile sink;
+  sink = &value;
+#endif
+}
+
+/// Run registered benchmarks as directed by command line args, writing
+/// json results to stdout (or --output) and a readable summary to stderr.
+/// Returns a process exit code.
+auto RunBenchmarks(int argc, char** argv) -> int;
+
+}  // namespace ballistica
+
+/// Define and register a benchmark. The body receives `state`.
+#define BA_BENCHMARK(NAME)                                          \
+  static void BenchmarkBody_##NAME(::ballistica::BenchmarkState*); \
+  static ::ballistica::BenchmarkRegistration g_benchmark_##NAME{   \
+      #NAME, BenchmarkBody_##NAME};                                 \
+  static void BenchmarkBody_##NAME(::ballistica::BenchmarkState* state)
+
+#endif  // BALLISTICA_SHARED_BENCH_BENCH_H_
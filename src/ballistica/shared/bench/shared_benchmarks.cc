@@ -0,0 +1,143 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/bench/bench.h"
+
+#if BA_BENCH_BUILD
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/generic/lambda_runnable.h"
+#include "ballistica/shared/generic/timer_list.h"
+#include "ballistica/shared/generic/utf8.h"
+#include "ballistica/shared/generic/utils.h"
+#include "ballistica/shared/math/matrix44f.h"
+#include "ballistica/shared/math/random.h"
+
+namespace ballistica {
+
+// Mostly-ascii text with some multibyte chars sprinkled in; roughly what
+// chat messages and player names look like.
+static auto MakeText_(size_t size) -> std::string {
+  static const char* kPieces[] = {"hello ", "world ", "\xc3\xa9t\xc3\xa9 ",
+                                  "\xe2\x98\x83 ", "BombSquad ",
+                                  "\xf0\x9f\x98\x80 "};
+  RandomStream random(1234);
+  std::string out;
+  while (out.size() < size) {
+    out += kPieces[random.NextUInt32() % 6];
+  }
+  return out;
+}
+
+BA_BENCHMARK(utf8_get_valid) {
+  std::string text = MakeText_(4096);
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    BenchmarkKeep(Utils::GetValidUTF8(text.c_str(), "bench"));
+  }
+  state->bytes_processed =
+      state->iterations * static_cast<int64_t>(text.size());
+}
+
+BA_BENCHMARK(utf8_is_valid) {
+  std::string text = MakeText_(4096);
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    BenchmarkKeep(Utils::IsValidUTF8(text));
+  }
+  state->bytes_processed =
+      state->iterations * static_cast<int64_t>(text.size());
+}
+
+BA_BENCHMARK(utf8_string_length) {
+  std::string text = MakeText_(4096);
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    BenchmarkKeep(Utils::UTF8StringLength(text.c_str()));
+  }
+  state->bytes_processed =
+      state->iterations * static_cast<int64_t>(text.size());
+}
+
+BA_BENCHMARK(matrix44f_multiply) {
+  Matrix44f a = Matrix44fRotate(Vector3f(0.3f, 1.0f, 0.2f), 37.0f)
+                * Matrix44fTranslate(1.0f, 2.0f, 3.0f);
+  Matrix44f b = Matrix44fRotate(Vector3f(1.0f, 0.1f, 0.5f), 12.0f);
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    a = a * b;
+    BenchmarkKeep(a);
+  }
+  state->items_processed = state->iterations;
+}
+
+BA_BENCHMARK(matrix44f_transform_points) {
+  const size_t count{1024};
+  RandomStream random(99);
+  std::vector<Vector3f> points(count);
+  for (auto&& p : points) {
+    p = Vector3f(random.NextFloat(-10.0f, 10.0f),
+                 random.NextFloat(-10.0f, 10.0f),
+                 random.NextFloat(-10.0f, 10.0f));
+  }
+  std::vector<Vector3f> out(count);
+  Matrix44f m = Matrix44fRotate(Vector3f(0.3f, 1.0f, 0.2f), 37.0f)
+                * Matrix44fTranslate(1.0f, 2.0f, 3.0f);
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    Matrix44fTransformPoints(m, points.data(), out.data(), count);
+    BenchmarkKeep(out);
+  }
+  state->items_processed = state->iterations * static_cast<int64_t>(count);
+}
+
+BA_BENCHMARK(timer_list_run) {
+  // A standing population of repeating timers at varied rates, stepped
+  // forward 1ms at a time (like the logic thread's timer lists).
+  TimerList list;
+  int64_t fired{};
+  auto runnable = NewLambdaRunnable([&fired] { fired++; });
+  RandomStream random(5);
+  for (int i = 0; i < 1000; ++i) {
+    list.NewTimer(0, 1 + random.NextUInt32() % 500, 0, -1, runnable.get());
+  }
+  TimerMedium time{};
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    list.Run(++time);
+  }
+  BenchmarkKeep(fired);
+  state->items_processed = fired;
+}
+
+BA_BENCHMARK(timer_list_new_delete) {
+  TimerList list;
+  auto runnable = NewLambdaRunnable([] {});
+  RandomStream random(6);
+  for (int i = 0; i < 1000; ++i) {
+    list.NewTimer(0, 1 + random.NextUInt32() % 500, 0, -1, runnable.get());
+  }
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    Timer* t =
+        list.NewTimer(0, 1 + random.NextUInt32() % 500, 0, 0, runnable.get());
+    list.DeleteTimer(t->id());
+  }
+  state->items_processed = state->iterations;
+}
+
+BA_BENCHMARK(event_loop_push) {
+  // Calls pushed from this thread and run on the loop's own thread. We
+  // sync up every so often so the queue never grows past its fast path.
+  static auto* event_loop = new EventLoop(EventLoopID::kAssets);
+  const int64_t kBatchSize{256};
+  std::atomic<int64_t> count{};
+  for (int64_t i = 0; i < state->iterations; ++i) {
+    event_loop->PushCall([&count] { count++; });
+    if (i % kBatchSize == kBatchSize - 1) {
+      event_loop->PushCallSynchronous([] {});
+    }
+  }
+  event_loop->PushCallSynchronous([] {});
+  state->items_processed = count;
+}
+
+}  // namespace ballistica
+
+#endif  // BA_BENCH_BUILD
@@ -64,6 +64,11 @@
 // Allow stdin commands too.
 #define BA_ENABLE_STDIO_CONSOLE 1
 
+// Batched udp sends/receives.
+#if __linux__
+#define BA_ENABLE_SOCKET_MMSG 1
+#endif
+
 #ifndef BA_DEFINE_MAIN
 #define BA_DEFINE_MAIN 1
 #endif
@@ -110,6 +110,11 @@ namespace ballistica {
 #define BA_TEST_BUILD 0
 #endif
 
+// Is this the native benchmark build (ballisticakit_bench)?
+#ifndef BA_BENCH_BUILD
+#define BA_BENCH_BUILD 0
+#endif
+
 // Does this build include its own full Python distribution?
 // Builds such as linux may use rely on system provided ones.
 #ifndef BA_CONTAINS_PYTHON_DIST
@@ -182,6 +187,18 @@ namespace ballistica {
 #define BA_ARCADE_BUILD 0
 #endif
 
+// Can we use recvmmsg()/sendmmsg() to move multiple datagrams per
+// syscall?
+#ifndef BA_ENABLE_SOCKET_MMSG
+#define BA_ENABLE_SOCKET_MMSG 0
+#endif
+
+// Compile in BA_TRACE_SCOPE() cross-thread trace spans? (They cost next
+// to nothing when not capturing, but this removes them entirely).
+#ifndef BA_ENABLE_THREAD_TRACE
+#define BA_ENABLE_THREAD_TRACE 1
+#endif
+
 #ifndef BA_SOCKET_POLL_FD
 #define BA_SOCKET_POLL_FD pollfd
 #endif
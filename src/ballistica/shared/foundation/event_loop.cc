@@ -4,6 +4,7 @@
 
 #include <Python.h>
 
+#include <algorithm>
 #include <list>
 #include <string>
 #include <unordered_map>
@@ -11,6 +12,7 @@
 
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/core/support/base_soft.h"
+#include "ballistica/core/support/thread_trace.h"
 #include "ballistica/shared/foundation/fatal_error.h"
 
 namespace ballistica {
@@ -20,6 +22,10 @@ namespace ballistica {
 using core::g_base_soft;
 using core::g_core;
 
+static std::atomic<bool> g_event_loop_metrics_enabled{};
+static std::mutex g_event_loops_mutex;
+static std::vector<EventLoop*> g_event_loops;
+
 EventLoop::EventLoop(EventLoopID identifier_in, ThreadSource source)
     : source_(source), identifier_(identifier_in) {
   switch (source_) {
@@ -45,6 +51,10 @@ EventLoop::EventLoop(EventLoopID identifier_in, ThreadSource source)
           func = ThreadMainAssets_;
           funcp = ThreadMainAssetsP_;
           break;
+        case EventLoopID::kFileOut:
+          func = ThreadMainFileOut_;
+          funcp = ThreadMainFileOutP_;
+          break;
         case EventLoopID::kMain:
           // Shouldn't happen; this thread gets wrapped; not launched.
           throw Exception();
@@ -64,6 +74,10 @@ EventLoop::EventLoop(EventLoopID identifier_in, ThreadSource source)
           func = ThreadMainStdInput_;
           funcp = ThreadMainStdInputP_;
           break;
+        case EventLoopID::kLog:
+          func = ThreadMainLog_;
+          funcp = ThreadMainLogP_;
+          break;
         default:
           throw Exception();
       }
@@ -100,6 +114,8 @@ EventLoop::EventLoop(EventLoopID identifier_in, ThreadSource source)
       break;
     }
   }
+  std::scoped_lock lock(g_event_loops_mutex);
+  g_event_loops.push_back(this);
 }
 
 // These are all exactly the same; its just a way to try and clarify
@@ -160,6 +176,24 @@ auto EventLoop::ThreadMainAssetsP_(void* data) -> void* {
   return nullptr;
 }
 
+auto EventLoop::ThreadMainFileOut_(void* data) -> int {
+  return static_cast<EventLoop*>(data)->ThreadMain_();
+}
+
+auto EventLoop::ThreadMainFileOutP_(void* data) -> void* {
+  static_cast<EventLoop*>(data)->ThreadMain_();
+  return nullptr;
+}
+
+auto EventLoop::ThreadMainLog_(void* data) -> int {
+  return static_cast<EventLoop*>(data)->ThreadMain_();
+}
+
+auto EventLoop::ThreadMainLogP_(void* data) -> void* {
+  static_cast<EventLoop*>(data)->ThreadMain_();
+  return nullptr;
+}
+
 void EventLoop::PushSetSuspended(bool suspended) {
   assert(g_core);
   // Can be toggled from the main thread only.
@@ -210,26 +244,32 @@ void EventLoop::WaitForNextEvent_(bool single_cycle) {
     microsecs_t wait_time = timers_.TimeToNextExpire(apptime);
     if (wait_time > 0) {
       std::unique_lock<std::mutex> lock(thread_message_mutex_);
-      if (thread_messages_.empty()) {
+      thread_message_waiting_ = true;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!ThreadMessagesAvailable_()) {
         thread_message_cv_.wait_for(lock, std::chrono::microseconds(wait_time),
                                     [this] {
                                       // Go back to sleep on spurious wakeups
                                       // if we didn't wind up with any new
                                       // messages.
-                                      return !thread_messages_.empty();
+                                      return ThreadMessagesAvailable_();
                                     });
       }
+      thread_message_waiting_ = false;
     }
   } else {
     // Not running timers; just wait indefinitely for the next message.
     std::unique_lock<std::mutex> lock(thread_message_mutex_);
-    if (thread_messages_.empty()) {
+    thread_message_waiting_ = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!ThreadMessagesAvailable_()) {
       thread_message_cv_.wait(lock, [this] {
         // Go back to sleep on spurious wakeups
         // (if we didn't wind up with any new messages).
-        return !(thread_messages_.empty());
+        return ThreadMessagesAvailable_();
       });
     }
+    thread_message_waiting_ = false;
   }
 
   if (acquires_python_gil_) {
@@ -270,40 +310,7 @@ void EventLoop::Run_(bool single_cycle) {
     WaitForNextEvent_(single_cycle);
 
     // Process all queued thread messages.
-    std::list<ThreadMessage_> thread_messages;
-    GetThreadMessages_(&thread_messages);
-    for (auto& thread_message : thread_messages) {
-      switch (thread_message.type) {
-        case ThreadMessage_::Type::kRunnable: {
-          PushLocalRunnable_(thread_message.runnable,
-                             thread_message.completion_flag);
-          break;
-        }
-        case ThreadMessage_::Type::kShutdown: {
-          done_ = true;
-          break;
-        }
-        case ThreadMessage_::Type::kSuspend: {
-          assert(!suspended_);
-          RunSuspendCallbacks_();
-          suspended_ = true;
-          break;
-        }
-        case ThreadMessage_::Type::kUnsuspend: {
-          assert(suspended_);
-          RunUnsuspendCallbacks_();
-          suspended_ = false;
-          break;
-        }
-        default: {
-          throw Exception();
-        }
-      }
-
-      if (done_) {
-        break;
-      }
-    }
+    ProcessThreadMessages_();
 
     if (!suspended_) {
       timers_.Run(g_core->AppTimeMicrosecs());
@@ -316,18 +323,73 @@ void EventLoop::Run_(bool single_cycle) {
   }
 }
 
-void EventLoop::GetThreadMessages_(std::list<ThreadMessage_>* messages) {
-  assert(messages);
+void EventLoop::ProcessThreadMessages_() {
   assert(std::this_thread::get_id() == thread_id());
 
-  // Make sure they passed an empty one in.
-  assert(messages->empty());
-  std::scoped_lock lock(thread_message_mutex_);
-  if (!thread_messages_.empty()) {
-    messages->swap(thread_messages_);
+  // Anything in the ring predates anything in the overflow list (pushers
+  // stick with the list once it is in use), so handle the ring's contents
+  // first. We cap this at one ring's worth so a steady stream of incoming
+  // messages can't keep us here forever.
+  ThreadMessage_ message;
+  for (size_t i = 0; i < kThreadMessageRingSize && !done_; ++i) {
+    if (!thread_message_ring_.TryPop(&message)) {
+      break;
+    }
+    HandleThreadMessage_(&message);
+  }
+  if (!done_ && thread_messages_overflow_count_ > 0) {
+    std::list<ThreadMessage_> messages;
+    {
+      std::scoped_lock lock(thread_message_mutex_);
+      messages.swap(thread_messages_);
+      thread_messages_overflow_count_ = 0;
+    }
+    for (auto& overflow_message : messages) {
+      HandleThreadMessage_(&overflow_message);
+      if (done_) {
+        break;
+      }
+    }
   }
 }
 
+void EventLoop::HandleThreadMessage_(ThreadMessage_* message) {
+  switch (message->type) {
+    case ThreadMessage_::Type::kRunnable: {
+      runnables_.emplace_back(std::move(message->call),
+                              message->completion_flag, message->push_time);
+      break;
+    }
+    case ThreadMessage_::Type::kShutdown: {
+      done_ = true;
+      break;
+    }
+    case ThreadMessage_::Type::kSuspend: {
+      assert(!suspended_);
+      RunSuspendCallbacks_();
+      suspended_ = true;
+      break;
+    }
+    case ThreadMessage_::Type::kUnsuspend: {
+      assert(suspended_);
+      RunUnsuspendCallbacks_();
+      suspended_ = false;
+      break;
+    }
+    default: {
+      throw Exception();
+    }
+  }
+}
+
+auto EventLoop::ThreadMessagesAvailable_() const -> bool {
+  return thread_message_ring_.size() > 0 || thread_messages_overflow_count_ > 0;
+}
+
+auto EventLoop::ThreadMessageCount_() const -> size_t {
+  return thread_message_ring_.size() + thread_messages_overflow_count_;
+}
+
 void EventLoop::BootstrapThread_() {
   assert(!bootstrapped_);
   assert(g_core);
@@ -358,6 +420,9 @@ void EventLoop::BootstrapThread_() {
     case EventLoopID::kNetworkWrite:
       name_ = "networkwrite";
       break;
+    case EventLoopID::kLog:
+      name_ = "log";
+      break;
     default:
       throw Exception();
   }
@@ -441,9 +506,10 @@ void EventLoop::LogThreadMessageTally_(
 
     std::unordered_map<std::string, int> tally;
     log_entries->emplace_back(std::make_pair(
-        LogLevel::kError, "EventLoop message tally ("
-                              + std::to_string(thread_messages_.size())
-                              + " in list):"));
+        LogLevel::kError,
+        "EventLoop message tally (" + std::to_string(ThreadMessageCount_())
+            + " pending; showing " + std::to_string(thread_messages_.size())
+            + " overflowed):"));
     for (auto&& m : thread_messages_) {
       std::string s;
       switch (m.type) {
@@ -465,7 +531,7 @@ void EventLoop::LogThreadMessageTally_(
       }
       if (m.type == ThreadMessage_::Type::kRunnable) {
         std::string m_name =
-            g_core->platform->DemangleCXXSymbol(typeid(*(m.runnable)).name());
+            g_core->platform->DemangleCXXSymbol(m.call.type_name());
         s += std::string(": ") + m_name;
       }
       auto j = tally.find(s);
@@ -485,8 +551,24 @@ void EventLoop::LogThreadMessageTally_(
   }
 }
 
-void EventLoop::PushThreadMessage_(const ThreadMessage_& t) {
+void EventLoop::PushThreadMessage_(ThreadMessage_&& t) {
   assert(g_core);
+
+  // Fast path: drop it in the ring. We stay off of it while there's
+  // anything in the overflow list though so that ordering is preserved.
+  if (thread_messages_overflow_count_ == 0
+      && thread_message_ring_.TryPush(std::move(t))) {
+    // If the thread is (or is about to be) asleep, wake it. Grabbing the
+    // mutex ensures it has actually started waiting so we don't notify
+    // ahead of that and get lost.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (thread_message_waiting_) {
+      { std::scoped_lock lock(thread_message_mutex_); }
+      thread_message_cv_.notify_all();
+    }
+    return;
+  }
+
   // We don't want to make log calls while holding this mutex;
   // log calls acquire the GIL and if the GIL-holder (generally
   // the logic thread) is trying to send a thread message to the
@@ -497,7 +579,9 @@ void EventLoop::PushThreadMessage_(const ThreadMessage_& t) {
     std::unique_lock lock(thread_message_mutex_);
 
     // Plop the data on to the list; we're assuming the mutex is locked.
-    thread_messages_.push_back(t);
+    thread_messages_.push_back(std::move(t));
+    thread_messages_overflow_count_ = thread_messages_.size();
+    auto message_count = ThreadMessageCount_();
 
     // Debugging: show message count states.
     if (explicit_bool(false)) {
@@ -507,7 +591,7 @@ void EventLoop::PushThreadMessage_(const ThreadMessage_& t) {
       one_off++;
 
       // Show momemtary spikes.
-      if (thread_messages_.size() > 100 && one_off > 100) {
+      if (message_count > 100 && one_off > 100) {
         one_off = 0;
         foo = 999;
       }
@@ -516,13 +600,12 @@ void EventLoop::PushThreadMessage_(const ThreadMessage_& t) {
       if ((std::this_thread::get_id() == g_core->main_thread_id())
           && foo > 100) {
         foo = 0;
-        log_entries.emplace_back(
-            LogLevel::kInfo,
-            "MSG COUNT " + std::to_string(thread_messages_.size()));
+        log_entries.emplace_back(LogLevel::kInfo,
+                                 "MSG COUNT " + std::to_string(message_count));
       }
     }
 
-    if (thread_messages_.size() > 1000) {
+    if (message_count > 1000) {
       static bool sent_error = false;
       if (!sent_error) {
         sent_error = true;
@@ -534,7 +617,7 @@ void EventLoop::PushThreadMessage_(const ThreadMessage_& t) {
     }
 
     // Prevent runaway mem usage if the list gets out of control.
-    if (thread_messages_.size() > 10000) {
+    if (message_count > 10000) {
       FatalError("ThreadMessage list > 10000 in thread: " + name_);
     }
 
@@ -602,20 +685,35 @@ void EventLoop::RunPendingRunnables_() {
   // Pull all runnables off the list first (its possible for one of these
   // runnables to add more) and then process them.
   assert(std::this_thread::get_id() == thread_id());
-  std::list<std::pair<Runnable*, bool*>> runnables;
-  runnables_.swap(runnables);
+  // We keep two lists and swap between them so their storage gets reused
+  // from cycle to cycle.
+  std::vector<PendingCall_> runnables;
+  runnables.swap(spare_runnables_);
+  runnables.swap(runnables_);
   bool do_notify_listeners{};
   for (auto&& i : runnables) {
-    i.first->RunAndLogErrors();
-    delete i.first;
+    BA_TRACE_SCOPE_DETAIL("EventLoop::RunPendingRunnables", i.call.type_name());
+    if (i.push_time != 0 && g_event_loop_metrics_enabled) {
+      auto start_time = core::CorePlatform::TimeMonotonicMicrosecs();
+      i.call.RunAndLogErrors();
+      AddCallMetrics_(i, start_time,
+                      core::CorePlatform::TimeMonotonicMicrosecs());
+    } else {
+      i.call.RunAndLogErrors();
+    }
+    i.call.Reset();
 
     // If this runnable wanted to be flagged when done, set its flag
     // and make a note to wake all client listeners.
-    if (i.second != nullptr) {
-      *(i.second) = true;
+    if (i.completion_flag != nullptr) {
+      *(i.completion_flag) = true;
       do_notify_listeners = true;
     }
   }
+  runnables.clear();
+  if (spare_runnables_.empty()) {
+    spare_runnables_.swap(runnables);
+  }
   if (do_notify_listeners) {
     {
       // Momentarily grab this lock. This ensures that whoever pushed us is
@@ -640,15 +738,87 @@ void EventLoop::RunUnsuspendCallbacks_() {
   }
 }
 
-void EventLoop::PushLocalRunnable_(Runnable* runnable, bool* completion_flag) {
-  assert(std::this_thread::get_id() == thread_id());
-  runnables_.emplace_back(runnable, completion_flag);
+void EventLoop::PushInlineCall_(InlineCall&& call, bool* completion_flag) {
+  microsecs_t push_time{g_event_loop_metrics_enabled
+                            ? core::CorePlatform::TimeMonotonicMicrosecs()
+                            : 0};
+
+  // If we're being called from within our thread, just drop it in the
+  // list. otherwise send it as a message to the other thread.
+  if (std::this_thread::get_id() == thread_id()) {
+    runnables_.emplace_back(std::move(call), completion_flag, push_time);
+    if (push_time != 0) {
+      NoteQueueDepth_(runnables_.size());
+    }
+  } else {
+    PushThreadMessage_(ThreadMessage_(ThreadMessage_::Type::kRunnable,
+                                      std::move(call), completion_flag,
+                                      push_time));
+    if (push_time != 0) {
+      NoteQueueDepth_(ThreadMessageCount_());
+    }
+  }
 }
 
-void EventLoop::PushCrossThreadRunnable_(Runnable* runnable,
-                                         bool* completion_flag) {
-  PushThreadMessage_(EventLoop::ThreadMessage_(
-      EventLoop::ThreadMessage_::Type::kRunnable, runnable, completion_flag));
+void EventLoop::NoteQueueDepth_(size_t depth) {
+  size_t prev = queue_depth_max_.load(std::memory_order_relaxed);
+  while (depth > prev
+         && !queue_depth_max_.compare_exchange_weak(
+             prev, depth, std::memory_order_relaxed)) {
+  }
+}
+
+void EventLoop::AddCallMetrics_(const PendingCall_& call,
+                                microsecs_t start_time, microsecs_t end_time) {
+  assert(ThreadIsCurrent());
+  auto latency = std::max(microsecs_t{0}, start_time - call.push_time);
+  auto duration = std::max(microsecs_t{0}, end_time - start_time);
+  int bucket = 0;
+  while (bucket < kEventLoopLatencyBucketCount - 1
+         && latency >= kEventLoopLatencyBucketBounds[bucket]) {
+    bucket++;
+  }
+  std::scoped_lock lock(metrics_mutex_);
+  metrics_.latency_counts[bucket]++;
+  metrics_.call_count++;
+  metrics_.latency_total += latency;
+  metrics_.latency_max = std::max(metrics_.latency_max, latency);
+  auto& source = metrics_.sources[call.call.type_name()];
+  source.count++;
+  source.total_time += duration;
+  source.max_time = std::max(source.max_time, duration);
+}
+
+void EventLoop::SetMetricsEnabled(bool enabled) {
+  g_event_loop_metrics_enabled = enabled;
+}
+
+auto EventLoop::metrics_enabled() -> bool {
+  return g_event_loop_metrics_enabled;
+}
+
+auto EventLoop::GetMetrics(bool reset) -> Metrics {
+  std::scoped_lock lock(metrics_mutex_);
+  Metrics metrics{metrics_};
+  metrics.queue_depth_max = queue_depth_max_;
+  if (reset) {
+    metrics_ = Metrics();
+    queue_depth_max_ = 0;
+  }
+  return metrics;
+}
+
+auto EventLoop::GetQueueDepth() const -> size_t {
+  // Our local list is only safe to look at from our own thread.
+  if (ThreadIsCurrent()) {
+    return ThreadMessageCount_() + runnables_.size();
+  }
+  return ThreadMessageCount_();
+}
+
+auto EventLoop::GetAllEventLoops() -> std::vector<EventLoop*> {
+  std::scoped_lock lock(g_event_loops_mutex);
+  return g_event_loops;
 }
 
 void EventLoop::AddSuspendCallback(Runnable* runnable) {
@@ -663,16 +833,15 @@ void EventLoop::AddUnsuspendCallback(Runnable* runnable) {
 
 void EventLoop::PushRunnable(Runnable* runnable) {
   assert(Object::IsValidUnmanagedObject(runnable));
-  // If we're being called from withing our thread, just drop it in the list.
-  // otherwise send it as a message to the other thread.
-  if (std::this_thread::get_id() == thread_id()) {
-    PushLocalRunnable_(runnable, nullptr);
-  } else {
-    PushCrossThreadRunnable_(runnable, nullptr);
-  }
+  PushInlineCall_(InlineCall(RunnableCall_(runnable)), nullptr);
 }
 
 void EventLoop::PushRunnableSynchronous(Runnable* runnable) {
+  assert(Object::IsValidUnmanagedObject(runnable));
+  PushInlineCallSynchronous_(InlineCall(RunnableCall_(runnable)));
+}
+
+void EventLoop::PushInlineCallSynchronous_(InlineCall&& call) {
   bool complete{};
   bool* complete_ptr{&complete};
 
@@ -690,7 +859,11 @@ void EventLoop::PushRunnableSynchronous(Runnable* runnable) {
         "PushRunnableSynchronous called from target thread;"
         " would deadlock.");
   } else {
-    PushCrossThreadRunnable_(runnable, &complete);
+    microsecs_t push_time{g_event_loop_metrics_enabled
+                              ? core::CorePlatform::TimeMonotonicMicrosecs()
+                              : 0};
+    PushThreadMessage_(ThreadMessage_(ThreadMessage_::Type::kRunnable,
+                                      std::move(call), &complete, push_time));
   }
 
   // Now listen until our completion flag gets set.
@@ -710,8 +883,7 @@ auto EventLoop::CheckPushSafety() -> bool {
   }
 }
 auto EventLoop::CheckPushRunnableSafety_() -> bool {
-  std::unique_lock lock(thread_message_mutex_);
-  return thread_messages_.size() < kThreadMessageSafetyThreshold;
+  return ThreadMessageCount_() < kThreadMessageSafetyThreshold;
 }
 
 void EventLoop::AcquireGIL_() {
@@ -3,22 +3,36 @@
 #ifndef BALLISTICA_SHARED_FOUNDATION_EVENT_LOOP_H_
 #define BALLISTICA_SHARED_FOUNDATION_EVENT_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "ballistica/core/core.h"
 #include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/generic/inline_call.h"
 #include "ballistica/shared/generic/lambda_runnable.h"
+#include "ballistica/shared/generic/mpsc_ring.h"
 #include "ballistica/shared/generic/timer_list.h"
 
 namespace ballistica {
 
 const int kThreadMessageSafetyThreshold{500};
 
+// Upper bounds (in microseconds) of EventLoop::Metrics latency buckets;
+// the final bucket holds everything beyond the last of these.
+const int kEventLoopLatencyBucketCount{7};
+const microsecs_t kEventLoopLatencyBucketBounds[kEventLoopLatencyBucketCount
+                                                - 1] = {50,   250,   1000,
+                                                        5000, 20000, 100000};
+
+// Thread messages beyond this many go to a (slower) locked overflow list.
+const size_t kThreadMessageRingSize{512};
+
 class EventLoop {
  public:
   explicit EventLoop(EventLoopID id,
@@ -57,20 +71,22 @@ class EventLoop {
   /// by the thread.
   void PushRunnable(Runnable* runnable);
 
-  /// Convenience function to push a lambda as a runnable.
+  /// Push a lambda to run on this thread's event-loop. Small lambdas are
+  /// stored inline in the loop's queue, so this generally does not
+  /// allocate.
   template <typename F>
   void PushCall(const F& lambda) {
-    PushRunnable(NewLambdaRunnableUnmanaged(lambda));
+    PushInlineCall_(InlineCall(lambda), nullptr);
   }
 
   /// Add a runnable to this thread's event-loop and wait until it
   /// completes.
   void PushRunnableSynchronous(Runnable* runnable);
 
-  /// Convenience function to push a lambda as a runnable.
+  /// Push a lambda and wait until it completes.
   template <typename F>
   void PushCallSynchronous(const F& lambda) {
-    PushRunnableSynchronous(NewLambdaRunnableUnmanaged(lambda));
+    PushInlineCallSynchronous_(InlineCall(lambda));
   }
 
   /// Add a callback to be run on event-loop suspends.
@@ -96,25 +112,90 @@ class EventLoop {
 
   auto name() const { return name_; }
 
+  /// Optional per-loop instrumentation; gathered only while
+  /// SetMetricsEnabled(true) is in effect.
+  struct Metrics {
+    struct SourceStats {
+      int64_t count{};
+      microsecs_t total_time{};
+      microsecs_t max_time{};
+    };
+    /// Calls run, bucketed by time from push to start of run.
+    int64_t latency_counts[kEventLoopLatencyBucketCount]{};
+    int64_t call_count{};
+    microsecs_t latency_total{};
+    microsecs_t latency_max{};
+    /// Most calls we've seen waiting at once.
+    size_t queue_depth_max{};
+    /// Time spent running calls, keyed by (mangled) callable type name.
+    std::unordered_map<const char*, SourceStats> sources;
+  };
+
+  /// Turn metrics gathering on or off for all loops.
+  static void SetMetricsEnabled(bool enabled);
+  static auto metrics_enabled() -> bool;
+
+  /// Return a copy of our metrics, optionally clearing them afterwards.
+  /// Can be called from any thread.
+  auto GetMetrics(bool reset) -> Metrics;
+
+  /// Current number of calls waiting to run (approximate).
+  auto GetQueueDepth() const -> size_t;
+
+  /// All event loops that have been created.
+  static auto GetAllEventLoops() -> std::vector<EventLoop*>;
+
  private:
   struct ThreadMessage_ {
     enum class Type { kShutdown = 999, kRunnable, kSuspend, kUnsuspend };
     Type type;
-    union {
-      Runnable* runnable{};
-    };
+    InlineCall call;
     bool* completion_flag{};
+    microsecs_t push_time{};
+    ThreadMessage_() : type(Type::kRunnable) {}
     explicit ThreadMessage_(Type type_in) : type(type_in) {}
-    explicit ThreadMessage_(Type type, Runnable* runnable,
-                            bool* completion_flag)
-        : type(type), runnable(runnable), completion_flag{completion_flag} {}
+    explicit ThreadMessage_(Type type, InlineCall&& call,
+                            bool* completion_flag, microsecs_t push_time)
+        : type(type),
+          call(std::move(call)),
+          completion_flag{completion_flag},
+          push_time{push_time} {}
+  };
+  struct PendingCall_ {
+    InlineCall call;
+    bool* completion_flag{};
+    microsecs_t push_time{};
+    PendingCall_(InlineCall&& call, bool* completion_flag,
+                 microsecs_t push_time)
+        : call(std::move(call)),
+          completion_flag{completion_flag},
+          push_time{push_time} {}
   };
+
+  /// Wraps an unmanaged Runnable so it can be pushed as an InlineCall.
+  class RunnableCall_ {
+   public:
+    explicit RunnableCall_(Runnable* runnable) : runnable_{runnable} {}
+    RunnableCall_(RunnableCall_&& other) noexcept
+        : runnable_{other.runnable_} {
+      other.runnable_ = nullptr;
+    }
+    ~RunnableCall_() { delete runnable_; }
+    void operator()() { runnable_->Run(); }
+
+   private:
+    Runnable* runnable_;
+  };
+  void PushInlineCall_(InlineCall&& call, bool* completion_flag);
+  void NoteQueueDepth_(size_t depth);
+  void AddCallMetrics_(const PendingCall_& call, microsecs_t start_time,
+                       microsecs_t end_time);
+  void PushInlineCallSynchronous_(InlineCall&& call);
   auto CheckPushRunnableSafety_() -> bool;
   void WaitForNextEvent_(bool single_cycle);
   void LogThreadMessageTally_(
       std::vector<std::pair<LogLevel, std::string>>* log_entries);
-  void PushLocalRunnable_(Runnable* runnable, bool* completion_flag);
-  void PushCrossThreadRunnable_(Runnable* runnable, bool* completion_flag);
+  void HandleThreadMessage_(ThreadMessage_* message);
   void NotifyClientListeners_();
   void Run_(bool single_cycle);
 
@@ -133,10 +214,16 @@ class EventLoop {
   static auto ThreadMainStdInputP_(void* data) -> void*;
   static auto ThreadMainAssets_(void* data) -> int;
   static auto ThreadMainAssetsP_(void* data) -> void*;
+  static auto ThreadMainFileOut_(void* data) -> int;
+  static auto ThreadMainFileOutP_(void* data) -> void*;
+  static auto ThreadMainLog_(void* data) -> int;
+  static auto ThreadMainLogP_(void* data) -> void*;
 
   auto ThreadMain_() -> int;
-  void GetThreadMessages_(std::list<ThreadMessage_>* messages);
-  void PushThreadMessage_(const ThreadMessage_& t);
+  void ProcessThreadMessages_();
+  void PushThreadMessage_(ThreadMessage_&& t);
+  auto ThreadMessagesAvailable_() const -> bool;
+  auto ThreadMessageCount_() const -> size_t;
 
   void RunPendingRunnables_();
   void RunSuspendCallbacks_();
@@ -157,12 +244,24 @@ class EventLoop {
   std::thread::id thread_id_{};
   std::condition_variable thread_message_cv_;
   std::condition_variable client_listener_cv_;
-  std::list<std::pair<Runnable*, bool*>> runnables_;
+  std::vector<PendingCall_> runnables_;
+  std::vector<PendingCall_> spare_runnables_;
   std::list<Runnable*> suspend_callbacks_;
   std::list<Runnable*> unsuspend_callbacks_;
+
+  // Cross-thread messages normally go through this lock-free ring. If it
+  // fills up they go to thread_messages_ under thread_message_mutex_
+  // instead (and keep doing so until we've drained that, to preserve
+  // ordering).
+  MPSCRing<ThreadMessage_, kThreadMessageRingSize> thread_message_ring_;
   std::list<ThreadMessage_> thread_messages_;
+  std::atomic<size_t> thread_messages_overflow_count_{};
+  std::atomic<bool> thread_message_waiting_{};
   std::mutex thread_message_mutex_;
   std::mutex client_listener_mutex_;
+  std::mutex metrics_mutex_;
+  Metrics metrics_;
+  std::atomic<size_t> queue_depth_max_{};
   std::list<std::vector<char>> data_to_client_;
   std::string name_;
   PyThreadState* py_thread_state_{};
@@ -0,0 +1,196 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/foundation/job_system.h"
+
+#include <string>
+#include <utility>
+
+#include "ballistica/core/core.h"
+
+namespace ballistica {
+
+using core::g_core;
+
+// Which job system (if any) the current thread is a worker for, and its
+// index there.
+static thread_local JobSystem* g_current_job_system{};
+static thread_local int g_current_job_worker_index{-1};
+
+// How many times idle workers look for work before going to sleep.
+const int kJobWorkerIdleSpins{64};
+
+JobSystem::JobSystem(int thread_count) {
+  if (thread_count <= 0) {
+    thread_count =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+  }
+  workers_.reserve(static_cast<size_t>(thread_count));
+  for (int i = 0; i < thread_count; ++i) {
+    workers_.push_back(std::make_unique<Worker_>());
+  }
+
+  // Only launch threads once all queues exist since workers look at all of
+  // them.
+  for (int i = 0; i < thread_count; ++i) {
+    workers_[i]->thread = std::thread([this, i] { WorkerMain_(i); });
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::scoped_lock lock(sleep_mutex_);
+    shutting_down_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto&& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void JobSystem::PushJob_(Group* group, InlineCall&& call) {
+  assert(group);
+  group->pending_++;
+
+  // Workers feed their own queue; everyone else spreads jobs around.
+  size_t index;
+  if (g_current_job_system == this) {
+    index = static_cast<size_t>(g_current_job_worker_index);
+  } else {
+    index = next_worker_++ % workers_.size();
+  }
+  {
+    auto& worker{*workers_[index]};
+    std::scoped_lock lock(worker.mutex);
+    worker.jobs.push_back(Job_{std::move(call), group});
+  }
+  queued_job_count_++;
+
+  // Wake a sleeping worker if there is one. Grabbing the mutex ensures a
+  // worker that just decided to sleep has actually started waiting before
+  // we notify.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_worker_count_ > 0) {
+    { std::scoped_lock lock(sleep_mutex_); }
+    sleep_cv_.notify_one();
+  }
+}
+
+auto JobSystem::TryPopJob_(int worker_index, Job_* job) -> bool {
+  assert(job);
+  if (queued_job_count_ == 0) {
+    return false;
+  }
+  auto count = static_cast<int>(workers_.size());
+
+  // Newest work from our own queue first (it is most likely to be hot in
+  // cache)...
+  if (worker_index >= 0) {
+    auto& worker{*workers_[worker_index]};
+    std::scoped_lock lock(worker.mutex);
+    if (!worker.jobs.empty()) {
+      *job = std::move(worker.jobs.back());
+      worker.jobs.pop_back();
+      queued_job_count_--;
+      return true;
+    }
+  }
+
+  // ...then the oldest work from someone else's.
+  int start = worker_index >= 0
+                  ? worker_index + 1
+                  : static_cast<int>(next_worker_.load() % workers_.size());
+  for (int i = 0; i < count; ++i) {
+    int victim = (start + i) % count;
+    if (victim == worker_index) {
+      continue;
+    }
+    auto& worker{*workers_[victim]};
+    std::scoped_lock lock(worker.mutex);
+    if (!worker.jobs.empty()) {
+      *job = std::move(worker.jobs.front());
+      worker.jobs.pop_front();
+      queued_job_count_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+auto JobSystem::TryRunJob_(int worker_index) -> bool {
+  Job_ job;
+  if (!TryPopJob_(worker_index, &job)) {
+    return false;
+  }
+  RunJob_(&job);
+  return true;
+}
+
+void JobSystem::RunJob_(Job_* job) {
+  Group* group{job->group};
+  try {
+    job->call.Run();
+  } catch (...) {
+    std::scoped_lock lock(group->error_mutex_);
+    if (!group->error_) {
+      group->error_ = std::current_exception();
+    }
+  }
+
+  // Kill the call before we mark it done; the group (and anything the
+  // call references) may go away as soon as we do.
+  job->call.Reset();
+  group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::Wait(Group* group) {
+  assert(group);
+  int worker_index =
+      g_current_job_system == this ? g_current_job_worker_index : -1;
+  while (group->pending_.load(std::memory_order_acquire) > 0) {
+    if (!TryRunJob_(worker_index)) {
+      std::this_thread::yield();
+    }
+  }
+  std::exception_ptr error;
+  {
+    std::scoped_lock lock(group->error_mutex_);
+    error = group->error_;
+    group->error_ = nullptr;
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void JobSystem::WorkerMain_(int worker_index) {
+  g_current_job_system = this;
+  g_current_job_worker_index = worker_index;
+  if (g_core) {
+    g_core->RegisterThread("job" + std::to_string(worker_index));
+  }
+  int idle_spins{};
+  while (!shutting_down_) {
+    if (TryRunJob_(worker_index)) {
+      idle_spins = 0;
+      continue;
+    }
+    if (idle_spins < kJobWorkerIdleSpins) {
+      idle_spins++;
+      std::this_thread::yield();
+      continue;
+    }
+    idle_spins = 0;
+    std::unique_lock lock(sleep_mutex_);
+    sleeping_worker_count_++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    sleep_cv_.wait(lock, [this] {
+      return queued_job_count_ > 0 || shutting_down_;
+    });
+    sleeping_worker_count_--;
+  }
+  if (g_core) {
+    g_core->UnregisterThread();
+  }
+}
+
+}  // namespace ballistica
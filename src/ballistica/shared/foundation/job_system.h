@@ -0,0 +1,128 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_FOUNDATION_JOB_SYSTEM_H_
+#define BALLISTICA_SHARED_FOUNDATION_JOB_SYSTEM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ballistica/shared/generic/inline_call.h"
+
+namespace ballistica {
+
+/// A pool of worker threads for data-parallel work.
+///
+/// Unlike EventLoops, which each own a particular job (logic, audio,
+/// etc.), this is a general purpose pool for splitting up big chunks of
+/// work that can be done in parallel. Each worker has its own queue; it
+/// pulls work from the back of its own queue and, when that runs dry,
+/// steals from the front of others'. Threads waiting on a Group help
+/// run jobs rather than blocking, so it is fine to wait on a Group from
+/// within a job.
+class JobSystem {
+ public:
+  /// Tracks completion of a set of jobs.
+  class Group {
+   public:
+    Group() = default;
+    Group(const Group&) = delete;
+    auto operator=(const Group&) -> Group& = delete;
+    auto done() const -> bool { return pending_ == 0; }
+
+   private:
+    friend class JobSystem;
+    std::atomic<int> pending_{};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+  };
+
+  /// Create a job system with the given number of worker threads. Pass 0
+  /// to pick based on the number of cores (leaving one for whoever is
+  /// submitting work, since waiters help out).
+  explicit JobSystem(int thread_count = 0);
+  ~JobSystem();
+
+  auto thread_count() const -> int {
+    return static_cast<int>(workers_.size());
+  }
+
+  /// Add a job to a group. Can be called from any thread, including from
+  /// within jobs.
+  template <typename F>
+  void Push(Group* group, const F& call) {
+    PushJob_(group, InlineCall(call));
+  }
+
+  /// Run jobs until all jobs in the group have completed. If any job threw
+  /// an exception, the first one is rethrown here.
+  void Wait(Group* group);
+
+  /// Call call(begin, end) for consecutive ranges covering [0, count) in
+  /// parallel and wait for them all to complete. Ranges will be at least
+  /// min_chunk long (except possibly the last). Runs everything inline
+  /// when there's not enough work to be worth splitting.
+  template <typename F>
+  void ParallelFor(size_t count, size_t min_chunk, const F& call) {
+    min_chunk = std::max(min_chunk, size_t{1});
+    auto max_chunks = static_cast<size_t>(thread_count() + 1) * 4;
+    size_t chunk_count = std::min(count / min_chunk, max_chunks);
+    if (chunk_count <= 1 || workers_.empty()) {
+      if (count > 0) {
+        call(size_t{0}, count);
+      }
+      return;
+    }
+    size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+    Group group;
+    const F* call_ptr = &call;
+    for (size_t begin = chunk_size; begin < count; begin += chunk_size) {
+      size_t end = std::min(begin + chunk_size, count);
+      Push(&group, [call_ptr, begin, end] { (*call_ptr)(begin, end); });
+    }
+
+    // Do the first chunk ourself and then help with the rest.
+    try {
+      call(size_t{0}, std::min(chunk_size, count));
+    } catch (...) {
+      Wait(&group);
+      throw;
+    }
+    Wait(&group);
+  }
+
+ private:
+  struct Job_ {
+    InlineCall call;
+    Group* group{};
+  };
+  struct Worker_ {
+    std::mutex mutex;
+    std::deque<Job_> jobs;
+    std::thread thread;
+  };
+  void PushJob_(Group* group, InlineCall&& call);
+  auto TryRunJob_(int worker_index) -> bool;
+  auto TryPopJob_(int worker_index, Job_* job) -> bool;
+  void RunJob_(Job_* job);
+  void WorkerMain_(int worker_index);
+
+  std::vector<std::unique_ptr<Worker_>> workers_;
+  std::atomic<int> queued_job_count_{};
+  std::atomic<int> sleeping_worker_count_{};
+  std::atomic<unsigned int> next_worker_{};
+  std::atomic<bool> shutting_down_{};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_FOUNDATION_JOB_SYSTEM_H_
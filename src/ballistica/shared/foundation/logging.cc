@@ -57,12 +57,11 @@ void Logging::EmitLog(const std::string& name, LogLevel level, double timestamp,
       char prestr[256];
 
       snprintf(prestr, sizeof(prestr), "%.3f  %s", rel_time, name.c_str());
-      g_base_soft->PushDevConsolePrintCall("", 0.3f, kVector4f1);
-      g_base_soft->PushDevConsolePrintCall(
-          prestr, 0.75f,
+      g_base_soft->PushDevConsoleLogCall(
+          prestr,
           Vector4f(logcolor.x * 0.4f + 0.6f, logcolor.y * 0.4f + 0.6f,
-                   logcolor.z * 0.4f + 0.6f, 0.75));
-      g_base_soft->PushDevConsolePrintCall(msg, 1.0f, logcolor);
+                   logcolor.z * 0.4f + 0.6f, 0.75),
+          msg, logcolor);
     }
   }
 
@@ -18,7 +18,9 @@ class Logging {
   /// Write a message to the log. Intended for logging use in C++ code. This
   /// is safe to call by any thread at any time as long as core has been
   /// inited. In general it simply passes through to the equivalent Python
-  /// logging call: logging.info, logging.warning, etc.
+  /// logging call: logging.info, logging.warning, etc. Non-critical
+  /// messages are queued and handed to Python from a dedicated log thread,
+  /// so logging is cheap from any thread.
   ///
   /// Be aware that Log() calls made before babase is imported will be
   /// stored and submitted all at once to Python once babase is imported
@@ -0,0 +1,146 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/foundation/memory_accounting.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica {
+
+using core::g_core;
+
+std::atomic<bool> MemoryAccounting::enabled_{};
+
+struct MemoryAccountingTag_ {
+  const char* name{};
+  bool is_type{};
+  int64_t live_bytes{};
+  int64_t live_count{};
+  int64_t alloc_bytes{};
+  int64_t alloc_count{};
+  int64_t free_count{};
+};
+
+struct MemoryAccountingBlock_ {
+  size_t tag{};
+  size_t bytes{};
+};
+
+// Leaked on purpose so allocations during static teardown are safe.
+static std::mutex* g_memory_accounting_mutex_{new std::mutex()};
+static auto* g_memory_accounting_tags_{new std::vector<MemoryAccountingTag_>()};
+static auto* g_memory_accounting_tag_indices_{
+    new std::unordered_map<const char*, size_t>()};
+static auto* g_memory_accounting_blocks_{
+    new std::unordered_map<const void*, MemoryAccountingBlock_>()};
+static microsecs_t g_memory_accounting_start_time_{};
+
+static void FreeBlock_(const MemoryAccountingBlock_& block) {
+  auto& tag{(*g_memory_accounting_tags_)[block.tag]};
+  tag.live_bytes -= static_cast<int64_t>(block.bytes);
+  tag.live_count--;
+  tag.free_count++;
+}
+
+void MemoryAccounting::SetEnabled(bool enabled) {
+  std::scoped_lock lock(*g_memory_accounting_mutex_);
+  if (enabled) {
+    g_memory_accounting_tags_->clear();
+    g_memory_accounting_tag_indices_->clear();
+    g_memory_accounting_start_time_ =
+        core::CorePlatform::TimeMonotonicMicrosecs();
+  }
+
+  // We can't see frees while off, so forget what we know of blocks.
+  g_memory_accounting_blocks_->clear();
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::Track(const void* ptr, const char* tag, size_t bytes,
+                             bool tag_is_type) {
+  std::scoped_lock lock(*g_memory_accounting_mutex_);
+  if (!enabled_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  size_t tag_index;
+  auto i = g_memory_accounting_tag_indices_->find(tag);
+  if (i == g_memory_accounting_tag_indices_->end()) {
+    tag_index = g_memory_accounting_tags_->size();
+    g_memory_accounting_tags_->push_back({tag, tag_is_type});
+    (*g_memory_accounting_tag_indices_)[tag] = tag_index;
+  } else {
+    tag_index = i->second;
+  }
+  auto& tag_stats{(*g_memory_accounting_tags_)[tag_index]};
+  tag_stats.live_bytes += static_cast<int64_t>(bytes);
+  tag_stats.live_count++;
+  tag_stats.alloc_bytes += static_cast<int64_t>(bytes);
+  tag_stats.alloc_count++;
+
+  // If we somehow missed a free at this address, count it now.
+  auto result =
+      g_memory_accounting_blocks_->emplace(ptr, MemoryAccountingBlock_{});
+  if (!result.second) {
+    FreeBlock_(result.first->second);
+  }
+  result.first->second = {tag_index, bytes};
+}
+
+void MemoryAccounting::Untrack(const void* ptr) {
+  std::scoped_lock lock(*g_memory_accounting_mutex_);
+  auto i = g_memory_accounting_blocks_->find(ptr);
+  if (i != g_memory_accounting_blocks_->end()) {
+    FreeBlock_(i->second);
+    g_memory_accounting_blocks_->erase(i);
+  }
+}
+
+auto MemoryAccounting::GetReport(bool reset) -> Report {
+  Report report;
+  std::vector<MemoryAccountingTag_> tags;
+  {
+    std::scoped_lock lock(*g_memory_accounting_mutex_);
+    tags = *g_memory_accounting_tags_;
+    auto now = core::CorePlatform::TimeMonotonicMicrosecs();
+    report.duration =
+        static_cast<double>(now - g_memory_accounting_start_time_) / 1000000.0;
+    if (reset) {
+      for (auto&& tag : *g_memory_accounting_tags_) {
+        tag.alloc_bytes = tag.alloc_count = tag.free_count = 0;
+      }
+      g_memory_accounting_start_time_ = now;
+    }
+  }
+
+  // Different pointers can carry the same name; merge those.
+  std::unordered_map<std::string, size_t> indices;
+  for (auto&& tag : tags) {
+    std::string name =
+        tag.is_type ? g_core->platform->DemangleCXXSymbol(tag.name) : tag.name;
+    auto i = indices.find(name);
+    if (i == indices.end()) {
+      i = indices.emplace(name, report.entries.size()).first;
+      report.entries.emplace_back();
+      report.entries.back().tag = name;
+    }
+    auto& entry{report.entries[i->second]};
+    entry.live_bytes += tag.live_bytes;
+    entry.live_count += tag.live_count;
+    entry.alloc_bytes += tag.alloc_bytes;
+    entry.alloc_count += tag.alloc_count;
+    entry.free_count += tag.free_count;
+  }
+  std::sort(report.entries.begin(), report.entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.live_bytes > b.live_bytes;
+            });
+  return report;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,67 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_FOUNDATION_MEMORY_ACCOUNTING_H_
+#define BALLISTICA_SHARED_FOUNDATION_MEMORY_ACCOUNTING_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica {
+
+/// An opt-in tally of memory by subsystem tag: every Object allocated
+/// through Object::New() and friends (tagged by type) plus anything else
+/// explicitly tracked such as mesh buffer data. This is meant for finding
+/// what grows a long-running process; only allocations made while
+/// accounting is enabled are counted, so live values are growth since it
+/// was turned on. Object sizes cover the object itself, not whatever it
+/// allocates separately. Can be used from any thread; costs one relaxed
+/// atomic load per allocation while off.
+class MemoryAccounting {
+ public:
+  struct Entry {
+    std::string tag;
+    int64_t live_bytes{};
+    int64_t live_count{};
+
+    // These are since enabling or the last reset.
+    int64_t alloc_bytes{};
+    int64_t alloc_count{};
+    int64_t free_count{};
+  };
+
+  struct Report {
+    /// Time covered by the alloc/free tallies.
+    seconds_t duration{};
+    std::vector<Entry> entries;
+  };
+
+  /// Start accounting (discarding anything previous) or stop. Stats from
+  /// a stopped run stay available until the next start.
+  static void SetEnabled(bool enabled);
+  static auto enabled() -> bool {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// Note that ptr now holds bytes for tag. Tag must be a string literal
+  /// or otherwise permanent; pass tag_is_type for typeid names so they get
+  /// demangled in reports. Does nothing while accounting is off.
+  static void Track(const void* ptr, const char* tag, size_t bytes,
+                    bool tag_is_type = false);
+
+  /// Note that a tracked ptr has been freed. Untracked ptrs are ignored.
+  static void Untrack(const void* ptr);
+
+  /// Current stats by tag, largest live bytes first. Resetting zeroes the
+  /// alloc/free tallies (for measuring rates) but not live values.
+  static auto GetReport(bool reset) -> Report;
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_FOUNDATION_MEMORY_ACCOUNTING_H_
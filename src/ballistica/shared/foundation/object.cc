@@ -41,6 +41,13 @@ Object::Object() {
 }
 
 Object::~Object() {
+  if (MemoryAccounting::enabled()) {
+    MemoryAccounting::Untrack(this);
+  }
+  if (object_census_slot_) {
+    ObjectCensus::OnDestroyed(object_census_slot_);
+  }
+
 #if BA_DEBUG_BUILD
   {
     assert(g_core);
@@ -83,6 +90,53 @@ Object::~Object() {
     tmp->next_ = nullptr;
     tmp->obj_ = nullptr;
   }
+
+  // And all our handles in one go.
+  if (object_handle_index_) {
+    FreeHandleSlot_();
+  }
+}
+
+// Guards handing out and recycling handle slots (lookups don't need it).
+static std::mutex g_handle_slot_mutex;
+static std::vector<uint32_t> g_free_handle_slots;
+
+// Slot 0 is reserved to mean 'no handle'.
+static uint32_t g_next_handle_slot{1};
+
+void Object::AllocHandleSlot_() {
+  assert(!object_handle_index_);
+  std::scoped_lock lock(g_handle_slot_mutex);
+  uint32_t index;
+  if (!g_free_handle_slots.empty()) {
+    index = g_free_handle_slots.back();
+    g_free_handle_slots.pop_back();
+  } else {
+    index = g_next_handle_slot;
+    uint32_t page_index = index >> kObjectHandlePageBits;
+    if (page_index >= kObjectHandleMaxPages) {
+      throw Exception("Out of Object handle slots.");
+    }
+    if (!handle_pages_[page_index].load(std::memory_order_relaxed)) {
+      // Pages are never freed or moved, so lookups can go without locks.
+      handle_pages_[page_index].store(
+          new HandleSlot_[1u << kObjectHandlePageBits],
+          std::memory_order_release);
+    }
+    g_next_handle_slot++;
+  }
+  HandleSlotAt_(index).obj.store(this, std::memory_order_release);
+  object_handle_index_ = index;
+}
+
+void Object::FreeHandleSlot_() {
+  assert(object_handle_index_);
+  std::scoped_lock lock(g_handle_slot_mutex);
+  auto& slot = HandleSlotAt_(object_handle_index_);
+  slot.obj.store(nullptr, std::memory_order_relaxed);
+  slot.generation.fetch_add(1, std::memory_order_release);
+  g_free_handle_slots.push_back(object_handle_index_);
+  object_handle_index_ = 0;
 }
 
 void Object::ObjectPostInit() {
@@ -165,8 +219,13 @@ void Object::LsObjects() {
   }
   g_core->Log(LogName::kBa, LogLevel::kInfo, s);
 #else
-  g_core->Log(LogName::kBa, LogLevel::kInfo,
-              "LsObjects() only functions in debug builds.");
+  if (ObjectCensus::enabled()) {
+    ObjectCensus::Log();
+  } else {
+    g_core->Log(LogName::kBa, LogLevel::kInfo,
+                "LsObjects() needs a debug build or the object census "
+                "enabled.");
+  }
 #endif  // BA_DEBUG_BUILD
 }
 
@@ -3,14 +3,23 @@
 #ifndef BALLISTICA_SHARED_FOUNDATION_OBJECT_H_
 #define BALLISTICA_SHARED_FOUNDATION_OBJECT_H_
 
+#include <atomic>
 #include <string>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
 #include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/foundation/memory_accounting.h"
+#include "ballistica/shared/foundation/object_census.h"
 
 namespace ballistica {
 
+/// Object::Handle slots come in pages of 1 << this many so pages never
+/// have to move as the table grows.
+const uint32_t kObjectHandlePageBits{12};
+const uint32_t kObjectHandleMaxPages{4096};
+
 /// Objects supporting strong and weak referencing and thread enforcement.
 class Object {
  public:
@@ -402,6 +411,94 @@ class Object {
     }
   };  // WeakRef
 
+  /// A compact weak reference: an index into a global slot table plus a
+  /// generation count. Unlike WeakRef, creating, copying, and dropping
+  /// one never writes to the target (beyond handing it a slot the first
+  /// time), and targets don't walk anything when they die; bumping their
+  /// slot's generation invalidates all of their handles at once. Lookups
+  /// cost a table read. Best for things that are observed by lots of
+  /// others or that get handles made and dropped constantly.
+  template <typename T = Object>
+  class Handle {
+   public:
+    Handle() = default;
+
+    /// Create from a pointer of any compatible type.
+    template <typename U>
+    explicit Handle(U* ptr) {
+      *this = ptr;
+    }
+
+    /// Create from a strong ref of any compatible type.
+    template <typename U>
+    explicit Handle(const Ref<U>& ref) {
+      *this = ref.get();
+    }
+
+    /// Assign from a pointer of any compatible type.
+    template <typename U>
+    auto operator=(U* ptr) -> Handle<T>& {
+      // Go through our template type so we catch invalid assigns at
+      // compile-time.
+      T* tmp = ptr;
+      if (tmp) {
+        static_cast<Object*>(tmp)->GetHandleSlot_(&index_, &generation_);
+      } else {
+        Clear();
+      }
+      return *this;
+    }
+
+    /// Assign from a strong ref of any compatible type.
+    template <typename U>
+    auto operator=(const Ref<U>& ref) -> Handle<T>& {
+      *this = ref.get();
+      return *this;
+    }
+
+    /// Return a pointer or nullptr.
+    auto get() const -> T* {
+      return static_cast<T*>(Object::LookupHandle_(index_, generation_));
+    }
+
+    auto exists() const -> bool { return get() != nullptr; }
+
+    void Clear() {
+      index_ = 0;
+      generation_ = 0;
+    }
+
+    /// Access the referenced object; throws an Exception if invalid.
+    auto operator->() const -> T* {
+      T* obj = get();
+      if (!obj) {
+        throw Exception(
+            "Dereferencing invalid " + static_type_name<T>() + " handle.",
+            PyExcType::kReference);
+      }
+      return obj;
+    }
+
+    /// Access the referenced object; throws an Exception if invalid.
+    auto operator*() const -> T& { return *operator->(); }
+
+    /// Compare to a pointer of any compatible type.
+    template <typename U>
+    auto operator==(U* ptr) const -> bool {
+      return get() == ptr;
+    }
+
+    /// Compare to a pointer of any compatible type.
+    template <typename U>
+    auto operator!=(U* ptr) const -> bool {
+      return get() != ptr;
+    }
+
+   private:
+    uint32_t index_{};
+    uint32_t generation_{};
+  };  // Handle
+
   // Strong-ref.
   template <typename T>
   class Ref {
@@ -572,6 +669,7 @@ class Object {
   template <typename TRETURN, typename TALLOC = TRETURN, typename... ARGS>
   [[nodiscard]] static auto New(ARGS&&... args) -> Object::Ref<TRETURN> {
     auto* ptr = new TALLOC(std::forward<ARGS>(args)...);
+    ObjectNoteCreated_(ptr);
 
 #if BA_DEBUG_BUILD
     /// Objects assume they are statically allocated by default; it's up
@@ -610,6 +708,7 @@ class Object {
   template <typename T, typename... ARGS>
   [[nodiscard]] static auto NewDeferred(ARGS&&... args) -> T* {
     T* ptr = new T(std::forward<ARGS>(args)...);
+    ObjectNoteCreated_(ptr);
 
 #if BA_DEBUG_BUILD
     /// Objects assume they are statically allocated by default; it's up
@@ -677,6 +776,7 @@ class Object {
   template <typename T, typename... ARGS>
   [[nodiscard]] static auto NewUnmanaged(ARGS&&... args) -> T* {
     T* ptr = new T(std::forward<ARGS>(args)...);
+    ObjectNoteCreated_(ptr);
 
 #if BA_DEBUG_BUILD
     /// Objects assume they are statically allocated by default; it's up
@@ -696,10 +796,25 @@ class Object {
     return ptr;
   }
 
-  /// Logs a tally of ba::Object types and counts (debug build only).
+  /// Logs a tally of ba::Object types and counts (in release builds this
+  /// comes from ObjectCensus and so needs it enabled).
   static void LsObjects();
 
  private:
+  /// Opt-in accounting for each newly allocated object.
+  template <typename T>
+  static void ObjectNoteCreated_(T* ptr) {
+    if (MemoryAccounting::enabled()) {
+      MemoryAccounting::Track(static_cast<Object*>(ptr), typeid(T).name(),
+                              sizeof(T), true);
+    }
+    if (ObjectCensus::enabled()) {
+      static ObjectCensus::Slot* slot{ObjectCensus::GetSlot(typeid(T).name())};
+      ptr->object_census_slot_ = slot;
+      ObjectCensus::OnCreated(slot);
+    }
+  }
+
 #if BA_DEBUG_BUILD
   // Making operator new private here purely to help enforce all of our
   // dynamic allocation/deallocation going through our special functions
@@ -724,7 +839,49 @@ class Object {
   millisecs_t object_birth_time_{};
   bool object_printed_warning_{};
 #endif
+  struct HandleSlot_ {
+    std::atomic<Object*> obj{};
+    std::atomic<uint32_t> generation{};
+  };
+
+  static auto HandleSlotAt_(uint32_t index) -> HandleSlot_& {
+    HandleSlot_* page = handle_pages_[index >> kObjectHandlePageBits].load(
+        std::memory_order_acquire);
+    return page[index & ((1u << kObjectHandlePageBits) - 1)];
+  }
+
+  static auto LookupHandle_(uint32_t index, uint32_t generation) -> Object* {
+    // Index 0 is never handed out, so empty handles land here.
+    if (index == 0) {
+      return nullptr;
+    }
+    auto& slot = HandleSlotAt_(index);
+    if (slot.generation.load(std::memory_order_acquire) != generation) {
+      return nullptr;
+    }
+    return slot.obj.load(std::memory_order_relaxed);
+  }
+
+  void GetHandleSlot_(uint32_t* index, uint32_t* generation) {
+#if BA_DEBUG_BUILD
+    ObjectThreadCheck();
+#endif
+    if (!object_handle_index_) {
+      AllocHandleSlot_();
+    }
+    *index = object_handle_index_;
+    *generation = HandleSlotAt_(object_handle_index_)
+                      .generation.load(std::memory_order_relaxed);
+  }
+
+  void AllocHandleSlot_();
+  void FreeHandleSlot_();
+
+  static inline std::atomic<HandleSlot_*> handle_pages_[kObjectHandleMaxPages];
+
   WeakRefBase* object_weak_refs_{};
+  ObjectCensus::Slot* object_census_slot_{};
+  uint32_t object_handle_index_{};
   int object_strong_ref_count_{};
   BA_DISALLOW_CLASS_COPIES(Object);
 };  // Object
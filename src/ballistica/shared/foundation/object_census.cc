@@ -0,0 +1,108 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/foundation/object_census.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica {
+
+using core::g_core;
+
+std::atomic<bool> ObjectCensus::enabled_{};
+
+// Slots live as long as the process (objects may point at them right up
+// until teardown) so these are leaked on purpose.
+static std::mutex* g_object_census_mutex_{new std::mutex()};
+static auto* g_object_census_slots_{
+    new std::unordered_map<std::string, std::unique_ptr<ObjectCensus::Slot>>()};
+static std::atomic<microsecs_t> g_object_census_start_time_{};
+
+void ObjectCensus::SetEnabled(bool enabled) {
+  if (enabled && !enabled_.load(std::memory_order_relaxed)) {
+    g_object_census_start_time_.store(
+        core::CorePlatform::TimeMonotonicMicrosecs(),
+        std::memory_order_relaxed);
+  }
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+auto ObjectCensus::GetSlot(const char* mangled_type_name) -> Slot* {
+  // Key on the demangled name; the same type can show up under different
+  // typeid pointers.
+  auto type_name = g_core
+                       ? g_core->platform->DemangleCXXSymbol(mangled_type_name)
+                       : std::string(mangled_type_name);
+  std::scoped_lock lock(*g_object_census_mutex_);
+  auto& slot = (*g_object_census_slots_)[type_name];
+  if (!slot) {
+    slot = std::make_unique<Slot>();
+    slot->type_name = type_name;
+  }
+  return slot.get();
+}
+
+auto ObjectCensus::GetReport(bool reset) -> Report {
+  Report report;
+  auto now = core::CorePlatform::TimeMonotonicMicrosecs();
+  auto start_time = g_object_census_start_time_.load(std::memory_order_relaxed);
+  if (start_time != 0) {
+    report.duration = static_cast<double>(now - start_time) / 1000000.0;
+  }
+  {
+    std::scoped_lock lock(*g_object_census_mutex_);
+    for (auto&& i : *g_object_census_slots_) {
+      auto& slot{*i.second};
+      Entry entry;
+      entry.type_name = slot.type_name;
+      entry.live = slot.live.load(std::memory_order_relaxed);
+      entry.peak = slot.peak.load(std::memory_order_relaxed);
+      entry.created = slot.created.load(std::memory_order_relaxed);
+      entry.destroyed = slot.destroyed.load(std::memory_order_relaxed);
+      if (reset) {
+        slot.created.store(0, std::memory_order_relaxed);
+        slot.destroyed.store(0, std::memory_order_relaxed);
+        slot.peak.store(entry.live, std::memory_order_relaxed);
+      }
+      if (entry.live != 0 || entry.created != 0 || entry.destroyed != 0) {
+        report.entries.push_back(std::move(entry));
+      }
+    }
+  }
+  if (reset) {
+    g_object_census_start_time_.store(now, std::memory_order_relaxed);
+  }
+  std::sort(report.entries.begin(), report.entries.end(),
+            [](const Entry& a, const Entry& b) { return a.live > b.live; });
+  return report;
+}
+
+void ObjectCensus::Log() {
+  auto report = GetReport(false);
+  auto duration = std::max(report.duration, 0.001);
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Object census over %.1fs%s:\n%10s %10s %10s %10s  %s",
+           report.duration, enabled() ? "" : " (stopped)", "live", "peak",
+           "created/s", "destroy/s", "type");
+  std::string s = buffer;
+  for (auto&& entry : report.entries) {
+    snprintf(buffer, sizeof(buffer), "\n%10lld %10lld %10.1f %10.1f  ",
+             static_cast<long long>(entry.live),  // NOLINT
+             static_cast<long long>(entry.peak),  // NOLINT
+             static_cast<double>(entry.created) / duration,
+             static_cast<double>(entry.destroyed) / duration);
+    s += buffer + entry.type_name;
+  }
+  g_core->Log(LogName::kBa, LogLevel::kInfo, s);
+}
+
+}  // namespace ballistica
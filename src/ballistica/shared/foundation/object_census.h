@@ -0,0 +1,81 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_FOUNDATION_OBJECT_CENSUS_H_
+#define BALLISTICA_SHARED_FOUNDATION_OBJECT_CENSUS_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica {
+
+/// A lightweight, release-safe count of live Objects by type, with
+/// creation/destruction tallies and high-water marks, for spotting slow
+/// leaks over long uptimes. Objects created while the census is enabled
+/// point at their type's slot so their destruction is counted whenever it
+/// happens; each costs a couple of relaxed atomic ops. Objects created
+/// while it is off aren't counted at all. Can be used from any thread.
+class ObjectCensus {
+ public:
+  struct Slot {
+    std::string type_name;
+    std::atomic<int64_t> live{};
+    std::atomic<int64_t> peak{};
+    std::atomic<int64_t> created{};
+    std::atomic<int64_t> destroyed{};
+  };
+
+  struct Entry {
+    std::string type_name;
+    int64_t live{};
+    int64_t peak{};
+    int64_t created{};
+    int64_t destroyed{};
+  };
+
+  struct Report {
+    /// Time covered by the created/destroyed tallies (and peaks).
+    seconds_t duration{};
+    std::vector<Entry> entries;
+  };
+
+  static void SetEnabled(bool enabled);
+  static auto enabled() -> bool {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// Return the permanent slot for a type (by mangled typeid name). Object
+  /// caches these per type so this lookup happens rarely.
+  static auto GetSlot(const char* mangled_type_name) -> Slot*;
+
+  static void OnCreated(Slot* slot) {
+    auto live = slot->live.fetch_add(1, std::memory_order_relaxed) + 1;
+    slot->created.fetch_add(1, std::memory_order_relaxed);
+    auto peak = slot->peak.load(std::memory_order_relaxed);
+    while (live > peak
+           && !slot->peak.compare_exchange_weak(peak, live,
+                                                std::memory_order_relaxed)) {
+    }
+  }
+
+  static void OnDestroyed(Slot* slot) {
+    slot->live.fetch_sub(1, std::memory_order_relaxed);
+    slot->destroyed.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Types with anything to show, most live first. Resetting zeroes the
+  /// created/destroyed tallies and brings peaks down to current values.
+  static auto GetReport(bool reset) -> Report;
+
+  /// Log a report as a table.
+  static void Log();
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_FOUNDATION_OBJECT_CENSUS_H_
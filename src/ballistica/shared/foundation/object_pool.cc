@@ -0,0 +1,68 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/foundation/object_pool.h"
+
+#include <algorithm>
+
+namespace ballistica {
+
+// Roughly how much memory we grab at a time for each pool.
+const size_t kSlabSize{64 * 1024};
+
+SlabAllocator::SlabAllocator(size_t slot_size) {
+  // Round slots up so each stays maximally aligned and can hold a
+  // free-list link.
+  auto align = alignof(std::max_align_t);
+  slot_size = std::max(slot_size, sizeof(FreeSlot_));
+  slot_size_ = (slot_size + align - 1) / align * align;
+  slots_per_slab_ = std::max(size_t{16}, kSlabSize / slot_size_);
+}
+
+auto SlabAllocator::Allocate() -> void* {
+  std::scoped_lock lock(mutex_);
+  if (!free_list_) {
+    AddSlab_();
+  }
+  FreeSlot_* slot = free_list_;
+  free_list_ = slot->next;
+  used_++;
+  return slot;
+}
+
+void SlabAllocator::Deallocate(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  auto* slot = static_cast<FreeSlot_*>(ptr);
+  slot->next = free_list_;
+  free_list_ = slot;
+  used_--;
+}
+
+auto SlabAllocator::capacity() -> size_t {
+  std::scoped_lock lock(mutex_);
+  return slabs_.size() * slots_per_slab_;
+}
+
+auto SlabAllocator::used() -> size_t {
+  std::scoped_lock lock(mutex_);
+  return used_;
+}
+
+void SlabAllocator::AddSlab_() {
+  auto units = slot_size_ * slots_per_slab_ / sizeof(std::max_align_t);
+  auto* slab = new std::max_align_t[units];
+  slabs_.push_back(slab);
+
+  // Thread the new slots onto our free list in address order so
+  // consecutive allocations come out adjacent in memory.
+  auto* bytes = reinterpret_cast<char*>(slab);
+  for (size_t i = slots_per_slab_; i > 0; --i) {
+    auto* slot = reinterpret_cast<FreeSlot_*>(bytes + (i - 1) * slot_size_);
+    slot->next = free_list_;
+    free_list_ = slot;
+  }
+}
+
+}  // namespace ballistica
@@ -0,0 +1,88 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_FOUNDATION_OBJECT_POOL_H_
+#define BALLISTICA_SHARED_FOUNDATION_OBJECT_POOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ballistica {
+
+/// Hands out fixed-size slots carved from large slabs.
+///
+/// Slots are recycled through an intrusive free list and slabs are never
+/// returned to the system, so a pool's footprint is bounded by its peak
+/// usage. Safe to use from any thread.
+class SlabAllocator {
+ public:
+  explicit SlabAllocator(size_t slot_size);
+  auto Allocate() -> void*;
+  void Deallocate(void* ptr);
+
+  auto slot_size() const { return slot_size_; }
+
+  /// Total slots carved out so far.
+  auto capacity() -> size_t;
+
+  /// Slots currently handed out.
+  auto used() -> size_t;
+
+ private:
+  struct FreeSlot_ {
+    FreeSlot_* next;
+  };
+  void AddSlab_();
+  std::mutex mutex_;
+  size_t slot_size_;
+  size_t slots_per_slab_;
+  size_t used_{};
+  FreeSlot_* free_list_{};
+  std::vector<std::max_align_t*> slabs_;
+};
+
+/// A per-type pool used by BA_OBJECT_POOLED.
+template <typename T>
+class ObjectPool {
+ public:
+  static auto Allocate(size_t size) -> void* {
+    // Subclasses of pooled types may be bigger; they just go to the heap.
+    if (size != sizeof(T)) {
+      return ::operator new(size);
+    }
+    return allocator().Allocate();
+  }
+
+  static void Deallocate(void* ptr, size_t size) {
+    if (size != sizeof(T)) {
+      ::operator delete(ptr);
+      return;
+    }
+    allocator().Deallocate(ptr);
+  }
+
+  static auto allocator() -> SlabAllocator& {
+    // Intentionally leaked; pooled objects may still be getting freed
+    // during static destruction.
+    static auto* allocator = new SlabAllocator(sizeof(T));
+    return *allocator;
+  }
+};
+
+}  // namespace ballistica
+
+/// Place this in the public section of an Object subclass with lots of
+/// churn to have Object::New() and friends allocate it from a pool instead
+/// of the general heap. It must only be used on types whose destructor is
+/// virtual (as is the case with all Objects) so deletes via base pointers
+/// come back here with the right size.
+#define BA_OBJECT_POOLED(type)                                 \
+  static auto operator new(size_t size) -> void* {             \
+    return ::ballistica::ObjectPool<type>::Allocate(size);     \
+  }                                                            \
+  static void operator delete(void* ptr, size_t size) {        \
+    ::ballistica::ObjectPool<type>::Deallocate(ptr, size);     \
+  }
+
+#endif  // BALLISTICA_SHARED_FOUNDATION_OBJECT_POOL_H_
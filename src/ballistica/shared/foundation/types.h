@@ -40,6 +40,7 @@ typedef int64_t microsecs_t;
 struct cJSON;
 class EventLoop;
 class FeatureSetNativeComponent;
+class JobSystem;
 class JsonDict;
 class Matrix44f;
 class NativeStackTrace;
@@ -325,7 +326,8 @@ enum class EventLoopID : uint8_t {
   kNetworkWrite,
   kSuicide,
   kStdin,
-  kBGDynamics
+  kBGDynamics,
+  kLog
 };
 
 }  // namespace ballistica
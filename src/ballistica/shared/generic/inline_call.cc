@@ -0,0 +1,30 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/generic/inline_call.h"
+
+#include <string>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica {
+
+using core::g_core;
+
+void InlineCall::RunAndLogErrors() {
+  try {
+    Run();
+  } catch (const std::exception& exc) {
+    std::string type_name;
+    if (g_core != nullptr) {
+      type_name = g_core->platform->DemangleCXXSymbol(typeid(exc).name());
+    } else {
+      type_name = "<type unavailable>";
+    }
+    g_core->Log(
+        LogName::kBa, LogLevel::kError,
+        std::string("Error in InlineCall: " + type_name + ": ") + exc.what());
+  }
+}
+
+}  // namespace ballistica
@@ -0,0 +1,132 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_GENERIC_INLINE_CALL_H_
+#define BALLISTICA_SHARED_GENERIC_INLINE_CALL_H_
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace ballistica {
+
+/// Callables up to this size (and suitably aligned) are stored inline.
+const size_t kInlineCallCapacity{48};
+
+/// A move-only holder for a callable (generally a lambda).
+///
+/// Small callables live directly in the InlineCall, so pushing one
+/// through a queue involves no allocations. Larger ones transparently
+/// fall back to a heap-allocated copy. Unlike LambdaRunnable this is not
+/// an Object; it is meant to be stored by value.
+class InlineCall {
+ public:
+  InlineCall() = default;
+
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, InlineCall>>>
+  explicit InlineCall(F&& callable) {
+    using T = std::decay_t<F>;
+    if constexpr (kFitsInline<T>) {
+      new (storage_) T(std::forward<F>(callable));
+      ops_ = &kInlineOps<T>;
+    } else {
+      *reinterpret_cast<T**>(storage_) = new T(std::forward<F>(callable));
+      ops_ = &kHeapOps<T>;
+    }
+  }
+
+  InlineCall(InlineCall&& other) noexcept { MoveFrom_(&other); }
+
+  auto operator=(InlineCall&& other) noexcept -> InlineCall& {
+    if (this != &other) {
+      Reset();
+      MoveFrom_(&other);
+    }
+    return *this;
+  }
+
+  InlineCall(const InlineCall&) = delete;
+  auto operator=(const InlineCall&) -> InlineCall& = delete;
+
+  ~InlineCall() { Reset(); }
+
+  /// Run the callable. Exceptions pass through to the caller.
+  void Run() {
+    assert(ops_);
+    ops_->run(storage_);
+  }
+
+  /// Run the callable, logging any exceptions instead of raising them.
+  void RunAndLogErrors();
+
+  /// Destroy any held callable, leaving us empty.
+  void Reset() {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  /// Whether the callable is stored inline (for debugging/testing).
+  auto is_inline() const -> bool { return ops_ && ops_->is_inline; }
+
+  /// Mangled type name of the held callable (for debugging).
+  auto type_name() const -> const char* {
+    return ops_ ? ops_->type_name() : "<empty>";
+  }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+ private:
+  struct Ops_ {
+    void (*run)(void* storage);
+    void (*move)(void* src, void* dst);
+    void (*destroy)(void* storage);
+    auto (*type_name)() -> const char*;
+    bool is_inline;
+  };
+
+  template <typename T>
+  static constexpr bool kFitsInline =
+      sizeof(T) <= kInlineCallCapacity
+      && alignof(T) <= alignof(std::max_align_t)
+      && std::is_nothrow_move_constructible_v<T>;
+
+  template <typename T>
+  static constexpr Ops_ kInlineOps{
+      [](void* storage) { (*static_cast<T*>(storage))(); },
+      [](void* src, void* dst) {
+        new (dst) T(std::move(*static_cast<T*>(src)));
+        static_cast<T*>(src)->~T();
+      },
+      [](void* storage) { static_cast<T*>(storage)->~T(); },
+      []() -> const char* { return typeid(T).name(); }, true};
+
+  template <typename T>
+  static constexpr Ops_ kHeapOps{
+      [](void* storage) { (**static_cast<T**>(storage))(); },
+      [](void* src, void* dst) {
+        *static_cast<T**>(dst) = *static_cast<T**>(src);
+      },
+      [](void* storage) { delete *static_cast<T**>(storage); },
+      []() -> const char* { return typeid(T).name(); }, false};
+
+  void MoveFrom_(InlineCall* other) {
+    ops_ = other->ops_;
+    if (ops_) {
+      ops_->move(other->storage_, storage_);
+      other->ops_ = nullptr;
+    }
+  }
+
+  const Ops_* ops_{};
+  alignas(std::max_align_t) unsigned char storage_[kInlineCallCapacity];
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_GENERIC_INLINE_CALL_H_
@@ -347,7 +347,10 @@ class JsonDict : public JsonObject {
     cJSON_AddItemToObject(obj(), name.c_str(), cJSON_CreateString(val.c_str()));
   }
   auto PrintUnformatted() -> std::string {
-    return cJSON_PrintUnformatted(obj());
+    char* out = cJSON_PrintUnformatted(obj());
+    std::string out_s = out;
+    cJSON_free(out);
+    return out_s;
   }
 };
 
@@ -0,0 +1,407 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/shared/generic/json_stream.h"
+
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace ballistica {
+
+void JsonWriter::AppendString(std::string* out, std::string_view value) {
+  assert(out);
+  static const char kHex[] = "0123456789abcdef";
+  out->reserve(out->size() + value.size() + 2);
+  *out += '"';
+  for (char c : value) {
+    auto uc = static_cast<unsigned char>(c);
+    switch (c) {
+      case '"':
+        *out += "\\\"";
+        break;
+      case '\\':
+        *out += "\\\\";
+        break;
+      case '\b':
+        *out += "\\b";
+        break;
+      case '\f':
+        *out += "\\f";
+        break;
+      case '\n':
+        *out += "\\n";
+        break;
+      case '\r':
+        *out += "\\r";
+        break;
+      case '\t':
+        *out += "\\t";
+        break;
+      default:
+        if (uc < 32) {
+          *out += "\\u00";
+          *out += kHex[uc >> 4];
+          *out += kHex[uc & 0xF];
+        } else {
+          *out += c;
+        }
+        break;
+    }
+  }
+  *out += '"';
+}
+
+void JsonWriter::AppendNumber(std::string* out, double value) {
+  assert(out);
+  char buffer[32];
+  if (std::isnan(value) || std::isinf(value)) {
+    *out += "null";
+    return;
+  }
+  if (value >= INT_MIN && value <= INT_MAX
+      && value == static_cast<double>(static_cast<int>(value))) {
+    snprintf(buffer, sizeof(buffer), "%d", static_cast<int>(value));
+  } else {
+    // Same approach as cJSON: 15 digits if that round-trips, else 17.
+    snprintf(buffer, sizeof(buffer), "%1.15g", value);
+    if (strtod(buffer, nullptr) != value) {
+      snprintf(buffer, sizeof(buffer), "%1.17g", value);
+    }
+  }
+  *out += buffer;
+}
+
+auto JsonReader::Parse(std::string_view json, Handler* handler) -> bool {
+  pos_ = json.data();
+  end_ = json.data() + json.size();
+
+  // Tolerate a trailing null terminator from packet buffers.
+  if (end_ > pos_ && end_[-1] == 0) {
+    end_--;
+  }
+  if (!ParseValue_(handler, 0)) {
+    return false;
+  }
+  SkipWhitespace_();
+  return pos_ == end_;
+}
+
+void JsonReader::SkipWhitespace_() {
+  while (pos_ < end_
+         && (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\n' || *pos_ == '\r')) {
+    pos_++;
+  }
+}
+
+auto JsonReader::ParseValue_(Handler* handler, int depth) -> bool {
+  SkipWhitespace_();
+  if (pos_ >= end_) {
+    return false;
+  }
+  switch (*pos_) {
+    case '{': {
+      if (depth >= kJsonReaderMaxDepth) {
+        return false;
+      }
+      pos_++;
+      if (handler && !handler->OnBeginObject()) {
+        return false;
+      }
+      SkipWhitespace_();
+      if (pos_ < end_ && *pos_ == '}') {
+        pos_++;
+        return !handler || handler->OnEndObject();
+      }
+      while (true) {
+        SkipWhitespace_();
+        std::string_view key;
+        if (pos_ >= end_ || *pos_ != '"' || !ParseString_(&key)) {
+          return false;
+        }
+        if (handler && !handler->OnKey(key)) {
+          return false;
+        }
+        SkipWhitespace_();
+        if (pos_ >= end_ || *pos_ != ':') {
+          return false;
+        }
+        pos_++;
+        if (!ParseValue_(handler, depth + 1)) {
+          return false;
+        }
+        SkipWhitespace_();
+        if (pos_ >= end_) {
+          return false;
+        }
+        if (*pos_ == ',') {
+          pos_++;
+          continue;
+        }
+        if (*pos_ == '}') {
+          pos_++;
+          return !handler || handler->OnEndObject();
+        }
+        return false;
+      }
+    }
+    case '[': {
+      if (depth >= kJsonReaderMaxDepth) {
+        return false;
+      }
+      pos_++;
+      if (handler && !handler->OnBeginArray()) {
+        return false;
+      }
+      SkipWhitespace_();
+      if (pos_ < end_ && *pos_ == ']') {
+        pos_++;
+        return !handler || handler->OnEndArray();
+      }
+      while (true) {
+        if (!ParseValue_(handler, depth + 1)) {
+          return false;
+        }
+        SkipWhitespace_();
+        if (pos_ >= end_) {
+          return false;
+        }
+        if (*pos_ == ',') {
+          pos_++;
+          continue;
+        }
+        if (*pos_ == ']') {
+          pos_++;
+          return !handler || handler->OnEndArray();
+        }
+        return false;
+      }
+    }
+    case '"': {
+      std::string_view value;
+      if (!ParseString_(&value)) {
+        return false;
+      }
+      return !handler || handler->OnString(value);
+    }
+    case 't':
+      return ParseLiteral_("true") && (!handler || handler->OnBool(true));
+    case 'f':
+      return ParseLiteral_("false") && (!handler || handler->OnBool(false));
+    case 'n':
+      return ParseLiteral_("null") && (!handler || handler->OnNull());
+    default: {
+      double value;
+      if (!ParseNumber_(&value)) {
+        return false;
+      }
+      return !handler || handler->OnNumber(value);
+    }
+  }
+}
+
+auto JsonReader::ParseLiteral_(const char* literal) -> bool {
+  for (const char* c = literal; *c; c++) {
+    if (pos_ >= end_ || *pos_ != *c) {
+      return false;
+    }
+    pos_++;
+  }
+  return true;
+}
+
+static auto HexValue_(char c) -> int {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+static auto ReadHex4_(const char* c, const char* end, uint32_t* out) -> bool {
+  if (end - c < 4) {
+    return false;
+  }
+  uint32_t value{};
+  for (int i = 0; i < 4; i++) {
+    int digit = HexValue_(c[i]);
+    if (digit < 0) {
+      return false;
+    }
+    value = (value << 4) | static_cast<uint32_t>(digit);
+  }
+  *out = value;
+  return true;
+}
+
+static void AppendUTF8_(std::string* out, uint32_t codepoint) {
+  if (codepoint < 0x80) {
+    *out += static_cast<char>(codepoint);
+  } else if (codepoint < 0x800) {
+    *out += static_cast<char>(0xC0 | (codepoint >> 6));
+    *out += static_cast<char>(0x80 | (codepoint & 0x3F));
+  } else if (codepoint < 0x10000) {
+    *out += static_cast<char>(0xE0 | (codepoint >> 12));
+    *out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    *out += static_cast<char>(0x80 | (codepoint & 0x3F));
+  } else {
+    *out += static_cast<char>(0xF0 | (codepoint >> 18));
+    *out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    *out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    *out += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+}
+
+auto JsonReader::ParseString_(std::string_view* out) -> bool {
+  assert(pos_ < end_ && *pos_ == '"');
+  pos_++;
+  const char* start = pos_;
+
+  // Fast path: no escapes means we can hand out a view of the input.
+  while (pos_ < end_ && *pos_ != '"' && *pos_ != '\\') {
+    if (static_cast<unsigned char>(*pos_) < 32) {
+      return false;
+    }
+    pos_++;
+  }
+  if (pos_ >= end_) {
+    return false;
+  }
+  if (*pos_ == '"') {
+    *out = std::string_view(start, pos_ - start);
+    pos_++;
+    return true;
+  }
+
+  // Got an escape; decode the rest into our scratch buffer.
+  scratch_.assign(start, pos_ - start);
+  while (pos_ < end_) {
+    char c = *pos_;
+    if (c == '"') {
+      pos_++;
+      *out = scratch_;
+      return true;
+    }
+    if (static_cast<unsigned char>(c) < 32) {
+      return false;
+    }
+    if (c != '\\') {
+      scratch_ += c;
+      pos_++;
+      continue;
+    }
+    pos_++;
+    if (pos_ >= end_) {
+      return false;
+    }
+    switch (*pos_) {
+      case '"':
+      case '\\':
+      case '/':
+        scratch_ += *pos_;
+        break;
+      case 'b':
+        scratch_ += '\b';
+        break;
+      case 'f':
+        scratch_ += '\f';
+        break;
+      case 'n':
+        scratch_ += '\n';
+        break;
+      case 'r':
+        scratch_ += '\r';
+        break;
+      case 't':
+        scratch_ += '\t';
+        break;
+      case 'u': {
+        uint32_t codepoint;
+        if (!ReadHex4_(pos_ + 1, end_, &codepoint)) {
+          return false;
+        }
+        pos_ += 4;
+
+        // Surrogate pairs come in as two escapes.
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+          uint32_t low;
+          if (end_ - pos_ < 7 || pos_[1] != '\\' || pos_[2] != 'u'
+              || !ReadHex4_(pos_ + 3, end_, &low) || low < 0xDC00
+              || low > 0xDFFF) {
+            return false;
+          }
+          pos_ += 6;
+          codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+        } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+          return false;
+        }
+        AppendUTF8_(&scratch_, codepoint);
+        break;
+      }
+      default:
+        return false;
+    }
+    pos_++;
+  }
+  return false;
+}
+
+auto JsonReader::ParseNumber_(double* out) -> bool {
+  // Check the grammar ourself; strtod is looser than json (and the input
+  // isn't necessarily terminated).
+  const char* start = pos_;
+  if (pos_ < end_ && *pos_ == '-') {
+    pos_++;
+  }
+  if (pos_ >= end_) {
+    return false;
+  }
+  if (*pos_ == '0') {
+    pos_++;
+  } else if (*pos_ >= '1' && *pos_ <= '9') {
+    while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9') {
+      pos_++;
+    }
+  } else {
+    return false;
+  }
+  if (pos_ < end_ && *pos_ == '.') {
+    pos_++;
+    if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9') {
+      return false;
+    }
+    while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9') {
+      pos_++;
+    }
+  }
+  if (pos_ < end_ && (*pos_ == 'e' || *pos_ == 'E')) {
+    pos_++;
+    if (pos_ < end_ && (*pos_ == '+' || *pos_ == '-')) {
+      pos_++;
+    }
+    if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9') {
+      return false;
+    }
+    while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9') {
+      pos_++;
+    }
+  }
+  char buffer[64];
+  auto len = static_cast<size_t>(pos_ - start);
+  if (len >= sizeof(buffer)) {
+    return false;
+  }
+  memcpy(buffer, start, len);
+  buffer[len] = 0;
+  *out = strtod(buffer, nullptr);
+  return true;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,255 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_GENERIC_JSON_STREAM_H_
+#define BALLISTICA_SHARED_GENERIC_JSON_STREAM_H_
+
+#include <climits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "ballistica/shared/ballistica.h"
+
+namespace ballistica {
+
+/// Deepest container nesting JsonReader will accept; anything past this is
+/// treated as invalid (keeps hostile input from blowing our stack).
+const int kJsonReaderMaxDepth{64};
+
+/// Writes compact json by appending straight to a string; no intermediate
+/// tree is built. Output matches what cJSON_PrintUnformatted produces for
+/// the same values. Callers are responsible for nesting things sensibly.
+class JsonWriter {
+ public:
+  JsonWriter() = default;
+
+  /// Reserve space up front when the rough output size is known.
+  explicit JsonWriter(size_t reserve) { out_.reserve(reserve); }
+
+  void BeginObject() {
+    Separate_();
+    out_ += '{';
+    need_comma_ = false;
+  }
+  void EndObject() {
+    out_ += '}';
+    need_comma_ = true;
+  }
+  void BeginArray() {
+    Separate_();
+    out_ += '[';
+    need_comma_ = false;
+  }
+  void EndArray() {
+    out_ += ']';
+    need_comma_ = true;
+  }
+
+  /// Write an object member name; the next value written is its value.
+  void Key(std::string_view key) {
+    Separate_();
+    AppendString(&out_, key);
+    out_ += ':';
+    need_comma_ = false;
+  }
+
+  void String(std::string_view value) {
+    Separate_();
+    AppendString(&out_, value);
+    need_comma_ = true;
+  }
+  void Number(double value) {
+    Separate_();
+    AppendNumber(&out_, value);
+    need_comma_ = true;
+  }
+  void Bool(bool value) {
+    Separate_();
+    out_ += value ? "true" : "false";
+    need_comma_ = true;
+  }
+  void Null() {
+    Separate_();
+    out_ += "null";
+    need_comma_ = true;
+  }
+
+  auto str() const -> const std::string& { return out_; }
+  auto TakeString() -> std::string { return std::move(out_); }
+
+  /// Append value to out as a quoted, escaped json string.
+  static void AppendString(std::string* out, std::string_view value);
+
+  /// Append value to out as a json number (null for nan/inf).
+  static void AppendNumber(std::string* out, double value);
+
+ private:
+  void Separate_() {
+    if (need_comma_) {
+      out_ += ',';
+    }
+  }
+
+  std::string out_;
+  bool need_comma_{};
+};
+
+/// A streaming (SAX-style) json parser. Values are handed to a Handler as
+/// they are encountered instead of being collected into a tree. Strings
+/// without escapes are passed as views into the input; escaped ones are
+/// decoded into a scratch buffer that is reused, so a parse does no
+/// allocation per value.
+class JsonReader {
+ public:
+  /// Receives values during a parse. Views passed here are only valid for
+  /// the duration of the call. Return false from any method to stop the
+  /// parse (which then returns false).
+  class Handler {
+   public:
+    virtual ~Handler() = default;
+    virtual auto OnNull() -> bool { return true; }
+    virtual auto OnBool(bool value) -> bool { return true; }
+    virtual auto OnNumber(double value) -> bool { return true; }
+    virtual auto OnString(std::string_view value) -> bool { return true; }
+    virtual auto OnKey(std::string_view key) -> bool { return true; }
+    virtual auto OnBeginObject() -> bool { return true; }
+    virtual auto OnEndObject() -> bool { return true; }
+    virtual auto OnBeginArray() -> bool { return true; }
+    virtual auto OnEndArray() -> bool { return true; }
+  };
+
+  /// A scalar value as handed out by ForEachMember().
+  struct Value {
+    enum class Type { kNull, kBool, kNumber, kString, kContainer };
+    Type type{Type::kNull};
+    bool boolean{};
+    double number{};
+    std::string_view string;
+
+    auto IsString() const -> bool { return type == Type::kString; }
+    auto IsNumber() const -> bool { return type == Type::kNumber; }
+
+    /// Number as an int, saturated to int range (as cJSON's valueint).
+    auto AsInt() const -> int {
+      if (number >= static_cast<double>(INT_MAX)) {
+        return INT_MAX;
+      }
+      if (number <= static_cast<double>(INT_MIN)) {
+        return INT_MIN;
+      }
+      return static_cast<int>(number);
+    }
+  };
+
+  /// Parse json, passing values to handler (which may be nullptr to just
+  /// validate). Returns whether the input was a single valid json value
+  /// and the handler didn't stop things early.
+  auto Parse(std::string_view json, Handler* handler) -> bool;
+
+  /// Return whether json is a single valid json value.
+  static auto Validate(std::string_view json) -> bool {
+    JsonReader reader;
+    return reader.Parse(json, nullptr);
+  }
+
+  /// Run call(key, value) for each member of a json object. This covers the
+  /// common case of small flat dicts; members that are themselves objects
+  /// or arrays are passed with type kContainer and their contents skipped.
+  /// Returns false if json is not a valid object.
+  template <typename F>
+  static auto ForEachMember(std::string_view json, F&& call) -> bool {
+    MemberHandler_<std::remove_reference_t<F>> handler(&call);
+    JsonReader reader;
+    return reader.Parse(json, &handler) && handler.was_object();
+  }
+
+ private:
+  template <typename F>
+  class MemberHandler_ : public Handler {
+   public:
+    explicit MemberHandler_(F* call) : call_(call) {}
+    auto was_object() const -> bool { return was_object_; }
+    auto OnNull() -> bool override { return Scalar_(Value{}); }
+    auto OnBool(bool value) -> bool override {
+      Value v;
+      v.type = Value::Type::kBool;
+      v.boolean = value;
+      return Scalar_(v);
+    }
+    auto OnNumber(double value) -> bool override {
+      Value v;
+      v.type = Value::Type::kNumber;
+      v.number = value;
+      return Scalar_(v);
+    }
+    auto OnString(std::string_view value) -> bool override {
+      Value v;
+      v.type = Value::Type::kString;
+      v.string = value;
+      return Scalar_(v);
+    }
+    auto OnKey(std::string_view key) -> bool override {
+      if (depth_ == 1) {
+        // Keys may live in the reader's scratch buffer which the value can
+        // overwrite, so hang on to a copy. Capacity gets reused.
+        key_.assign(key.data(), key.size());
+      }
+      return true;
+    }
+    auto OnBeginObject() -> bool override {
+      if (depth_ == 0) {
+        was_object_ = true;
+      } else if (depth_ == 1 && was_object_) {
+        Value v;
+        v.type = Value::Type::kContainer;
+        (*call_)(std::string_view(key_), v);
+      }
+      depth_++;
+      return true;
+    }
+    auto OnEndObject() -> bool override {
+      depth_--;
+      return true;
+    }
+    auto OnBeginArray() -> bool override {
+      if (depth_ == 1 && was_object_) {
+        Value v;
+        v.type = Value::Type::kContainer;
+        (*call_)(std::string_view(key_), v);
+      }
+      depth_++;
+      return true;
+    }
+    auto OnEndArray() -> bool override {
+      depth_--;
+      return true;
+    }
+
+   private:
+    auto Scalar_(const Value& value) -> bool {
+      if (depth_ == 1 && was_object_) {
+        (*call_)(std::string_view(key_), value);
+      }
+      return true;
+    }
+    F* call_;
+    std::string key_;
+    int depth_{};
+    bool was_object_{};
+  };
+
+  auto ParseValue_(Handler* handler, int depth) -> bool;
+  auto ParseString_(std::string_view* out) -> bool;
+  auto ParseNumber_(double* out) -> bool;
+  auto ParseLiteral_(const char* literal) -> bool;
+  void SkipWhitespace_();
+
+  const char* pos_{};
+  const char* end_{};
+  std::string scratch_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_GENERIC_JSON_STREAM_H_
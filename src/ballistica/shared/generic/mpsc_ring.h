@@ -0,0 +1,97 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SHARED_GENERIC_MPSC_RING_H_
+#define BALLISTICA_SHARED_GENERIC_MPSC_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace ballistica {
+
+/// A bounded lock-free queue supporting any number of producer threads
+/// and a single consumer thread.
+///
+/// Each slot carries a sequence number which producers and the consumer
+/// use to hand it back and forth, so pushing is a single compare-exchange
+/// in the common case and never allocates. Capacity must be a power of 2.
+/// Values are moved in and out of slots, so T can be move-only.
+template <typename T, size_t Capacity>
+class MPSCRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of 2.");
+
+ public:
+  MPSCRing() {
+    for (size_t i = 0; i < Capacity; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// Add a value. Can be called from any thread. Returns false (leaving
+  /// value untouched) if the ring is full.
+  auto TryPush(T&& value) -> bool {
+    size_t pos = push_pos_.load(std::memory_order_relaxed);
+    Slot_* slot;
+    while (true) {
+      slot = &slots_[pos & kMask];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff =
+          static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pull the oldest value. Must only be called from the consumer thread.
+  /// Returns false if there is nothing (fully pushed) available.
+  auto TryPop(T* value) -> bool {
+    size_t pos = pop_pos_.load(std::memory_order_relaxed);
+    Slot_* slot = &slots_[pos & kMask];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence != pos + 1) {
+      return false;
+    }
+    *value = std::move(slot->value);
+    slot->sequence.store(pos + Capacity, std::memory_order_release);
+    pop_pos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Approximate number of values currently in the ring. Can be called
+  /// from any thread but may be momentarily stale.
+  auto size() const -> size_t {
+    size_t pop_pos = pop_pos_.load(std::memory_order_relaxed);
+    size_t push_pos = push_pos_.load(std::memory_order_relaxed);
+    return push_pos > pop_pos ? push_pos - pop_pos : 0;
+  }
+
+  static constexpr auto capacity() -> size_t { return Capacity; }
+
+ private:
+  static constexpr size_t kMask = Capacity - 1;
+  struct Slot_ {
+    std::atomic<size_t> sequence;
+    T value{};
+  };
+
+  // Keep producer and consumer positions on separate cache lines.
+  alignas(64) std::atomic<size_t> push_pos_{};
+  alignas(64) std::atomic<size_t> pop_pos_{};
+  Slot_ slots_[Capacity];
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_SHARED_GENERIC_MPSC_RING_H_
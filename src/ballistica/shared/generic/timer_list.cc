@@ -38,18 +38,19 @@ TimerList::~TimerList() {
 void TimerList::Clear() {
   assert(!are_clearing_);
   are_clearing_ = true;
-  while (timers_) {
-    Timer* t = timers_;
+  std::vector<Timer*> timers;
+  std::vector<Timer*> timers_inactive;
+  timers.swap(timers_);
+  timers_inactive.swap(timers_inactive_);
+  timers_by_id_.clear();
+  for (Timer* t : timers) {
     t->on_list_ = false;
     timer_count_active_--;
-    timers_ = t->next_;
     delete t;
   }
-  while (timers_inactive_) {
-    Timer* t = timers_inactive_;
+  for (Timer* t : timers_inactive) {
     t->on_list_ = false;
     timer_count_inactive_--;
-    timers_inactive_ = t->next_;
     delete t;
   }
   are_clearing_ = false;
@@ -57,43 +58,26 @@ void TimerList::Clear() {
 
 // Pull a timer out of the list.
 auto TimerList::PullTimer(int timer_id, bool remove) -> Timer* {
-  Timer* t = timers_;
-  Timer* p = nullptr;
-  while (t) {
-    if (t->id_ == timer_id) {
-      if (remove) {
-        if (p) {
-          p->next_ = t->next_;
-        } else {
-          timers_ = t->next_;
-        }
-        t->on_list_ = false;
-        timer_count_active_--;
-      }
-      return t;
-    }
-    p = t;
-    t = t->next_;
-  }
-
-  // Didn't find it. check the inactive list.
-  t = timers_inactive_;
-  p = nullptr;
-  while (t) {
-    if (t->id_ == timer_id) {
-      if (remove) {
-        if (p) {
-          p->next_ = t->next_;
-        } else {
-          timers_inactive_ = t->next_;
-        }
-        t->on_list_ = false;
+  auto i = timers_by_id_.find(timer_id);
+  if (i != timers_by_id_.end()) {
+    Timer* t = i->second;
+    assert(t->on_list_);
+    if (remove) {
+      timers_by_id_.erase(i);
+      size_t index = t->list_index_;
+      if (index < timers_inactive_.size() && timers_inactive_[index] == t) {
+        // Inactive timers are unordered; just swap the last one in.
+        timers_inactive_[index] = timers_inactive_.back();
+        timers_inactive_[index]->list_index_ = index;
+        timers_inactive_.pop_back();
         timer_count_inactive_--;
+      } else {
+        HeapRemove_(index);
+        timer_count_active_--;
       }
-      return t;
+      t->on_list_ = false;
     }
-    p = t;
-    t = t->next_;
+    return t;
   }
 
   // Not on either list; only other possibility is the current client timer.
@@ -129,14 +113,18 @@ void TimerList::Run(TimerMedium target_time) {
 }
 auto TimerList::GetExpiredCount(TimerMedium target_time) -> int {
   assert(!are_clearing_);
+  return CountExpired_(0, target_time);
+}
 
-  Timer* t = timers_;
-  int count = 0;
-  while (t && t->expire_time_ <= target_time) {
-    count++;
-    t = t->next_;
+auto TimerList::CountExpired_(size_t index, TimerMedium target_time) const
+    -> int {
+  // Children never expire before their parent, so we only need to walk the
+  // expired part of the heap.
+  if (index >= timers_.size() || timers_[index]->expire_time_ > target_time) {
+    return 0;
   }
-  return count;
+  return 1 + CountExpired_(index * 2 + 1, target_time)
+         + CountExpired_(index * 2 + 2, target_time);
 }
 
 // Returns the next expired timer.  When done with the timer,
@@ -145,11 +133,11 @@ auto TimerList::GetExpiredCount(TimerMedium target_time) -> int {
 auto TimerList::GetExpiredTimer(TimerMedium target_time) -> Timer* {
   assert(!are_clearing_);
 
-  Timer* t;
-  if (timers_ != nullptr && timers_->expire_time_ <= target_time) {
-    t = timers_;
+  if (!timers_.empty() && timers_.front()->expire_time_ <= target_time) {
+    Timer* t = timers_.front();
     t->last_run_time_ = target_time;
-    timers_ = timers_->next_;
+    timers_by_id_.erase(t->id_);
+    HeapRemove_(0);
     timer_count_active_--;
     t->on_list_ = false;
 
@@ -182,10 +170,10 @@ auto TimerList::NewTimer(TimerMedium current_time, TimerMedium length,
 
 auto TimerList::TimeToNextExpire(TimerMedium current_time) -> TimerMedium {
   assert(!are_clearing_);
-  if (!timers_) {
+  if (timers_.empty()) {
     return (TimerMedium)-1;
   }
-  TimerMedium diff = timers_->expire_time_ - current_time;
+  TimerMedium diff = timers_.front()->expire_time_ - current_time;
   return (diff < 0) ? 0 : diff;
 }
 
@@ -254,27 +242,80 @@ void TimerList::AddTimer(Timer* t) {
 
   // If its set to never go off, throw it on the inactive list.
   if (t->length_ == -1) {
-    t->next_ = timers_inactive_;
-    timers_inactive_ = t;
+    t->list_index_ = timers_inactive_.size();
+    timers_inactive_.push_back(t);
     timer_count_inactive_++;
   } else {
-    Timer** list = &timers_;
-
-    // Go along till we find an expire time later than ourself.
-    while (*list != nullptr) {
-      if ((*list)->expire_time_ > t->expire_time_) {
-        break;
-      }
-      list = &((*list)->next_);
-    }
-    Timer* tmp = (*list);
-    (*list) = t;
-    t->next_ = tmp;
+    // Timers with equal expire times fire in the order they were added.
+    t->sequence_ = next_timer_sequence_++;
+    timers_.push_back(t);
+    t->list_index_ = timers_.size() - 1;
+    SiftUp_(t->list_index_);
     timer_count_active_++;
   }
+  timers_by_id_[t->id_] = t;
   t->on_list_ = true;
 }
 
+auto TimerList::FiresBefore_(const Timer* a, const Timer* b) -> bool {
+  if (a->expire_time_ != b->expire_time_) {
+    return a->expire_time_ < b->expire_time_;
+  }
+  return a->sequence_ < b->sequence_;
+}
+
+void TimerList::HeapSet_(size_t index, Timer* t) {
+  timers_[index] = t;
+  t->list_index_ = index;
+}
+
+void TimerList::HeapRemove_(size_t index) {
+  assert(index < timers_.size());
+  Timer* last = timers_.back();
+  timers_.pop_back();
+  if (index == timers_.size()) {
+    return;
+  }
+  HeapSet_(index, last);
+
+  // The moved timer may need to go either direction.
+  SiftUp_(index);
+  SiftDown_(last->list_index_);
+}
+
+void TimerList::SiftUp_(size_t index) {
+  Timer* t = timers_[index];
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!FiresBefore_(t, timers_[parent])) {
+      break;
+    }
+    HeapSet_(index, timers_[parent]);
+    index = parent;
+  }
+  HeapSet_(index, t);
+}
+
+void TimerList::SiftDown_(size_t index) {
+  Timer* t = timers_[index];
+  size_t count = timers_.size();
+  while (true) {
+    size_t child = index * 2 + 1;
+    if (child >= count) {
+      break;
+    }
+    if (child + 1 < count && FiresBefore_(timers_[child + 1], timers_[child])) {
+      child++;
+    }
+    if (!FiresBefore_(timers_[child], t)) {
+      break;
+    }
+    HeapSet_(index, timers_[child]);
+    index = child;
+  }
+  HeapSet_(index, t);
+}
+
 Timer::Timer(TimerList* list, int id, TimerMedium current_time,
              TimerMedium length, TimerMedium offset, int repeat_count)
     : list_(list),
@@ -4,6 +4,7 @@
 #define BALLISTICA_SHARED_GENERIC_TIMER_LIST_H_
 
 #include <cstdio>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/shared/ballistica.h"
@@ -39,7 +40,7 @@ class TimerList {
   // timer (a timer returned via GetExpiredTimer() but not yet re-submitted).
   auto ActiveTimerCount() const -> int { return timer_count_active_; }
 
-  auto Empty() -> bool { return (timers_ == nullptr); }
+  auto Empty() -> bool { return timers_.empty(); }
 
   void Clear();
 
@@ -53,12 +54,29 @@ class TimerList {
   auto SubmitTimer(Timer* t) -> Timer*;
   void AddTimer(Timer* t);
 
+  // Binary min-heap helpers for timers_.
+  static auto FiresBefore_(const Timer* a, const Timer* b) -> bool;
+  void HeapRemove_(size_t index);
+  void SiftUp_(size_t index);
+  void SiftDown_(size_t index);
+  void HeapSet_(size_t index, Timer* t);
+  auto CountExpired_(size_t index, TimerMedium target_time) const -> int;
+
   int timer_count_active_{};
   int timer_count_inactive_{};
   int timer_count_total_{};
   Timer* client_timer_{};
-  Timer* timers_{};
-  Timer* timers_inactive_{};
+
+  // Active timers as a binary min-heap ordered by expire time (ties go to
+  // whichever was added first, same as the old sorted list).
+  std::vector<Timer*> timers_;
+
+  // Timers set to never go off; unordered.
+  std::vector<Timer*> timers_inactive_;
+
+  // Everything on either of the above, by id.
+  std::unordered_map<int, Timer*> timers_by_id_;
+  uint64_t next_timer_sequence_{};
   int next_timer_id_{1};
   bool running_{};
   bool are_clearing_{};
@@ -78,13 +96,18 @@ class Timer {
   virtual ~Timer();
   TimerList* list_{};
   bool on_list_{};
-  Timer* next_{};
   bool initial_{};
   bool dead_{};
   bool list_died_{};
   TimerMedium last_run_time_{};
   TimerMedium expire_time_{};
   int id_{};
+
+  // Our slot in the list's active heap or inactive vector.
+  size_t list_index_{};
+
+  // Breaks expire-time ties in order of addition.
+  uint64_t sequence_{};
   TimerMedium length_{};
   int repeat_count_{};
   Object::Ref<Runnable> runnable_;
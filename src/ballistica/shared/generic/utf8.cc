@@ -20,8 +20,15 @@
 #include <malloc.h>
 #endif
 
-#if BA_OSTYPE_LINUX
 #include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BA_UTF8_HAVE_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BA_UTF8_HAVE_NEON 1
 #endif
 
 namespace ballistica {
@@ -441,6 +448,73 @@ auto u8_printf(char* fmt, ...) -> int {
   return cnt;
 }
 
+auto u8_ascii_prefix_len(const char* s, size_t len) -> size_t {
+  size_t i = 0;
+#if BA_UTF8_HAVE_SSE2
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    if (_mm_movemask_epi8(v) != 0) {
+      break;
+    }
+  }
+#elif BA_UTF8_HAVE_NEON
+  for (; i + 16 <= len; i += 16) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(s + i));
+    if (vmaxvq_u8(v) >= 0x80) {
+      break;
+    }
+  }
+#else
+  for (; i + 8 <= len; i += 8) {
+    uint64_t word;
+    memcpy(&word, s + i, sizeof(word));
+    if (word & 0x8080808080808080ULL) {
+      break;
+    }
+  }
+#endif
+  while (i < len && !(static_cast<unsigned char>(s[i]) & 0x80)) {
+    i++;
+  }
+  return i;
+}
+
+auto u8_printable_prefix_len(const char* s, size_t len) -> size_t {
+  size_t i = 0;
+#if BA_UTF8_HAVE_SSE2
+  // Signed compares; bytes with the high bit set come out negative and so
+  // fail the low bound.
+  const __m128i low = _mm_set1_epi8(0x1F);
+  const __m128i high = _mm_set1_epi8(0x7F);
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    __m128i ok =
+        _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high));
+    if (_mm_movemask_epi8(ok) != 0xFFFF) {
+      break;
+    }
+  }
+#elif BA_UTF8_HAVE_NEON
+  const uint8x16_t low = vdupq_n_u8(0x20);
+  const uint8x16_t high = vdupq_n_u8(0x7E);
+  for (; i + 16 <= len; i += 16) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(s + i));
+    uint8x16_t ok = vandq_u8(vcgeq_u8(v, low), vcleq_u8(v, high));
+    if (vminvq_u8(ok) != 0xFF) {
+      break;
+    }
+  }
+#endif
+  while (i < len) {
+    auto c = static_cast<unsigned char>(s[i]);
+    if (c < 0x20 || c > 0x7E) {
+      break;
+    }
+    i++;
+  }
+  return i;
+}
+
 #pragma clang diagnostic pop
 
 }  // namespace ballistica
@@ -80,6 +80,17 @@ auto u8_is_locale_utf8(const char* locale) -> int;
 auto u8_vprintf(char* fmt, va_list ap) -> int;
 auto u8_printf(char* fmt, ...) -> int;
 
+// ericf note: these are our own additions; they scan 16 bytes at a time
+// where SSE2/NEON are available so the common all-ascii case is cheap.
+
+/* number of leading bytes of s (of len total) that are plain ascii
+   (high bit clear) */
+auto u8_ascii_prefix_len(const char* s, size_t len) -> size_t;
+
+/* number of leading bytes of s (of len total) that are printable ascii
+   (0x20 through 0x7E) */
+auto u8_printable_prefix_len(const char* s, size_t len) -> size_t;
+
 }  // namespace ballistica
 
 #endif  // BALLISTICA_SHARED_GENERIC_UTF8_H_
@@ -11,7 +11,7 @@
 
 #include "ballistica/core/core.h"
 #include "ballistica/core/support/base_soft.h"
-#include "ballistica/shared/generic/json.h"
+#include "ballistica/shared/generic/json_stream.h"
 #include "ballistica/shared/generic/utf8.h"
 #include "ballistica/shared/math/random.h"
 #include "ballistica/shared/math/vector3f.h"
@@ -153,13 +153,22 @@ void Utils::StringReplaceAll(std::string* target, const std::string& key,
 }
 
 auto Utils::IsValidUTF8(const std::string& val) -> bool {
+  // Printable ascii passes through GetValidUTF8 untouched.
+  if (u8_printable_prefix_len(val.data(), val.size()) == val.size()) {
+    return true;
+  }
   std::string out = Utils::GetValidUTF8(val.c_str(), "bsivu8");
   return (out == val);
 }
 
-static auto utf8_check_is_valid(const std::string& string) -> bool {
+static auto utf8_check_is_valid(const char* string, int length) -> bool {
   int c, i, ix, n, j;
-  for (i = 0, ix = static_cast<int>(string.length()); i < ix; i++) {
+  for (i = 0, ix = length; i < ix; i++) {
+    // Skip quickly over runs of ascii.
+    if (!(static_cast<unsigned char>(string[i]) & 0x80)) {
+      i += static_cast<int>(u8_ascii_prefix_len(string + i, ix - i)) - 1;
+      continue;
+    }
     c = (unsigned char)string[i];
     // if (c==0x09 || c==0x0a || c==0x0d
     // || (0x20 <= c && c <= 0x7e) ) n = 0;  // is_printable_ascii
@@ -199,12 +208,20 @@ auto Utils::GetValidUTF8(const char* str, const char* loc) -> std::string {
   int i, f_size = static_cast<int>(strlen(str));
   unsigned char c, c2 = 0, c3, c4;
   std::string to;
+
+  // Most strings we see are plain printable ascii, which comes through
+  // unchanged; skip all per-char work in that case.
+  auto printable_len = u8_printable_prefix_len(str, f_size);
+  if (printable_len == static_cast<size_t>(f_size)) {
+    to.assign(str, printable_len);
+    return to;
+  }
   to.reserve(static_cast<size_t>(f_size));
 
   // ok, it seems we're somehow letting some funky utf8 through that's
   // causing crashes.. for now lets try this all-or-nothing func and return
   // ascii only if it fails
-  if (!utf8_check_is_valid(str)) {
+  if (!utf8_check_is_valid(str, f_size)) {
     // now strip out anything but normal ascii...
     for (i = 0; i < f_size; i++) {
       c = (unsigned char)(str)[i];
@@ -233,6 +250,14 @@ auto Utils::GetValidUTF8(const char* str, const char* loc) -> std::string {
   } else {
     for (i = 0; i < f_size; i++) {
       c = (unsigned char)(str)[i];
+
+      // Copy runs of printable ascii in one go.
+      if (c >= 32 && c < 127) {
+        auto run = u8_printable_prefix_len(str + i, f_size - i);
+        to.append(str + i, run);
+        i += static_cast<int>(run) - 1;
+        continue;
+      }
       if (c < 32) {                          // control char
         if (c == 9 || c == 10 || c == 13) {  // allow only \t \n \r
           to.append(1, static_cast<char>(c));
@@ -308,8 +333,18 @@ auto Utils::GetValidUTF8(const char* str, const char* loc) -> std::string {
 }
 
 auto Utils::UTF8StringLength(const char* val) -> int {
+  size_t len = strlen(val);
+  if (u8_printable_prefix_len(val, len) == len) {
+    return static_cast<int>(len);
+  }
   std::string valid_str = GetValidUTF8(val, "gusl1");
-  return u8_strlen(valid_str.c_str());
+
+  // Valid utf8 has exactly one non-continuation byte per char.
+  int count{};
+  for (char c : valid_str) {
+    count += ((static_cast<unsigned char>(c) & 0xC0) != 0x80);
+  }
+  return count;
 }
 
 auto Utils::GetUTF8Value(const char* c) -> uint32_t {
@@ -339,6 +374,9 @@ auto Utils::UTF8FromUnicode(std::vector<uint32_t> unichars) -> std::string {
 auto Utils::UnicodeFromUTF8(const std::string& s_in, const char* loc)
     -> std::vector<uint32_t> {
   std::string s = GetValidUTF8(s_in.c_str(), loc);
+  if (u8_ascii_prefix_len(s.data(), s.size()) == s.size()) {
+    return {s.begin(), s.end()};
+  }
   // worst case every char is a character (plus trailing 0)
   std::vector<uint32_t> vals(s.size() + 1);
   int converted = u8_toucs(&vals[0], static_cast<int>(vals.size()), s.c_str(),
@@ -361,11 +399,7 @@ void Utils::AdvanceUTF8(const char** c) {
 
 auto Utils::GetJSONString(const char* s) -> std::string {
   std::string str;
-  cJSON* str_obj = cJSON_CreateString(s);
-  char* str_buffer = cJSON_PrintUnformatted(str_obj);
-  str = str_buffer;
-  free(str_buffer);
-  cJSON_Delete(str_obj);
+  JsonWriter::AppendString(&str, s);
   return str;
 }
 
@@ -433,10 +467,11 @@ void Utils::SetRandomNameList(const std::list<std::string>& custom_names) {
 }
 
 auto Utils::Sphrand(float radius) -> Vector3f {
+  auto& random{ThreadRandomStream()};
   while (true) {
-    float x = RandomFloat();
-    float y = RandomFloat();
-    float z = RandomFloat();
+    float x = random.NextFloat();
+    float y = random.NextFloat();
+    float z = random.NextFloat();
     x = -1.0f + x * 2.0f;
     y = -1.0f + y * 2.0f;
     z = -1.0f + z * 2.0f;
@@ -4,6 +4,59 @@
 
 namespace ballistica {
 
+void Matrix44fTransformPoints(const Matrix44f& m, const Vector3f* in,
+                              Vector3f* out, size_t count) {
+  assert(in && out);
+#if BA_MATRIX44F_HAVE_SSE
+  // Load the matrix once for the whole batch.
+  __m128 c0 = _mm_loadu_ps(m.m);
+  __m128 c1 = _mm_loadu_ps(m.m + 4);
+  __m128 c2 = _mm_loadu_ps(m.m + 8);
+  __m128 c3 = _mm_loadu_ps(m.m + 12);
+  for (size_t i = 0; i < count; i++) {
+    const float* v = in[i].v;
+    __m128 sum = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+    sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+    sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+    sum = _mm_add_ps(sum, c3);
+    float prod[4];
+    _mm_storeu_ps(prod, sum);
+    float div = 1.0f / prod[3];
+    out[i] = {prod[0] * div, prod[1] * div, prod[2] * div};
+  }
+#elif BA_MATRIX44F_HAVE_NEON
+  float32x4_t c0 = vld1q_f32(m.m);
+  float32x4_t c1 = vld1q_f32(m.m + 4);
+  float32x4_t c2 = vld1q_f32(m.m + 8);
+  float32x4_t c3 = vld1q_f32(m.m + 12);
+  for (size_t i = 0; i < count; i++) {
+    const float* v = in[i].v;
+    float32x4_t sum = vmulq_n_f32(c0, v[0]);
+    sum = vaddq_f32(sum, vmulq_n_f32(c1, v[1]));
+    sum = vaddq_f32(sum, vmulq_n_f32(c2, v[2]));
+    sum = vaddq_f32(sum, c3);
+    float prod[4];
+    vst1q_f32(prod, sum);
+    float div = 1.0f / prod[3];
+    out[i] = {prod[0] * div, prod[1] * div, prod[2] * div};
+  }
+#else
+  for (size_t i = 0; i < count; i++) {
+    out[i] = m * in[i];
+  }
+#endif
+}
+
+void Matrix44fMultiplyEach(const Matrix44f* in, const Matrix44f& rhs,
+                           Matrix44f* out, size_t count) {
+  assert(in && out);
+  // Copy in case rhs lives in the array we're writing.
+  Matrix44f r{rhs};
+  for (size_t i = 0; i < count; i++) {
+    out[i] = in[i] * r;
+  }
+}
+
 auto Matrix44fRotate(const Vector3f& axis, float angle) -> Matrix44f {
   // Page 466, Graphics Gems
 
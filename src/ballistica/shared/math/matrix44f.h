@@ -7,6 +7,17 @@
 
 #include "ballistica/shared/math/vector3f.h"
 
+// Use vector instructions for the hot multiply paths where we can count on
+// having them. Results match the scalar versions (same operation order).
+#if defined(__SSE__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define BA_MATRIX44F_HAVE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BA_MATRIX44F_HAVE_NEON 1
+#endif
+
 namespace ballistica {
 
 class Matrix44f {
@@ -58,6 +69,34 @@ class Matrix44f {
   // Matrix multiplication.
   auto operator*(const Matrix44f& other) const -> Matrix44f {
     Matrix44f prod;  // NOLINT: uninitialized on purpose.
+#if BA_MATRIX44F_HAVE_SSE
+    // Each column of the product is a weighted sum of other's columns.
+    __m128 o0 = _mm_loadu_ps(other.m);
+    __m128 o1 = _mm_loadu_ps(other.m + 4);
+    __m128 o2 = _mm_loadu_ps(other.m + 8);
+    __m128 o3 = _mm_loadu_ps(other.m + 12);
+    for (int c = 0; c < 4; c++) {
+      const float* col = m + c * 4;
+      __m128 sum = _mm_mul_ps(_mm_set1_ps(col[0]), o0);
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(col[1]), o1));
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(col[2]), o2));
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(col[3]), o3));
+      _mm_storeu_ps(prod.m + c * 4, sum);
+    }
+#elif BA_MATRIX44F_HAVE_NEON
+    float32x4_t o0 = vld1q_f32(other.m);
+    float32x4_t o1 = vld1q_f32(other.m + 4);
+    float32x4_t o2 = vld1q_f32(other.m + 8);
+    float32x4_t o3 = vld1q_f32(other.m + 12);
+    for (int c = 0; c < 4; c++) {
+      const float* col = m + c * 4;
+      float32x4_t sum = vmulq_n_f32(o0, col[0]);
+      sum = vaddq_f32(sum, vmulq_n_f32(o1, col[1]));
+      sum = vaddq_f32(sum, vmulq_n_f32(o2, col[2]));
+      sum = vaddq_f32(sum, vmulq_n_f32(o3, col[3]));
+      vst1q_f32(prod.m + c * 4, sum);
+    }
+#else
     for (int c = 0; c < 4; c++) {
       for (int r = 0; r < 4; r++) {
         prod.set(c, r,
@@ -66,6 +105,7 @@ class Matrix44f {
                      + get(c, 3) * other.get(3, r));
       }
     }
+#endif
     return prod;
   }
 
@@ -90,11 +130,29 @@ class Matrix44f {
 
   // Matrix transformation of 3D vector.
   auto operator*(const Vector3f& vec) const -> Vector3f {
+#if BA_MATRIX44F_HAVE_SSE
+    __m128 sum = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(vec.v[0]));
+    sum = _mm_add_ps(sum,
+                     _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(vec.v[1])));
+    sum = _mm_add_ps(sum,
+                     _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(vec.v[2])));
+    sum = _mm_add_ps(sum, _mm_loadu_ps(m + 12));
+    float prod[4];
+    _mm_storeu_ps(prod, sum);
+#elif BA_MATRIX44F_HAVE_NEON
+    float32x4_t sum = vmulq_n_f32(vld1q_f32(m), vec.v[0]);
+    sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(m + 4), vec.v[1]));
+    sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(m + 8), vec.v[2]));
+    sum = vaddq_f32(sum, vld1q_f32(m + 12));
+    float prod[4];
+    vst1q_f32(prod, sum);
+#else
     float prod[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     for (int r = 0; r < 4; r++) {
       for (int c = 0; c < 3; c++) prod[r] += vec.v[c] * get(c, r);
       prod[r] += get(3, r);
     }
+#endif
     float div = 1.0f / prod[3];
     return {prod[0] * div, prod[1] * div, prod[2] * div};
   }
@@ -197,6 +255,17 @@ auto Matrix44fOrient(const Vector3f& direction, const Vector3f& up)
 auto Matrix44fFrustum(float left, float right, float bottom, float top,
                       float near, float far) -> Matrix44f;
 
+/// Transform count points by m (same as m * in[i] for each). In and out
+/// may be the same array.
+void Matrix44fTransformPoints(const Matrix44f& m, const Vector3f* in,
+                              Vector3f* out, size_t count);
+
+/// Set out[i] = in[i] * rhs for count matrices, such as when applying a
+/// shared transform to a batch of instance matrices. In and out may be the
+/// same array.
+void Matrix44fMultiplyEach(const Matrix44f* in, const Matrix44f& rhs,
+                           Matrix44f* out, size_t count);
+
 }  // namespace ballistica
 
 #endif  // BALLISTICA_SHARED_MATH_MATRIX44F_H_
@@ -2,17 +2,42 @@
 
 #include "ballistica/shared/math/random.h"
 
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <vector>
 
 namespace ballistica {
 
+static std::atomic<uint64_t> g_thread_random_seed{0x853c49e6748fea9bULL};
+static std::atomic<uint64_t> g_next_thread_random_stream{};
+
+struct ThreadRandomStream_ {
+  ThreadRandomStream_()
+      : stream_id{g_next_thread_random_stream++},
+        stream{g_thread_random_seed.load(), stream_id} {}
+  uint64_t stream_id;
+  RandomStream stream;
+};
+
+static thread_local ThreadRandomStream_ g_thread_random_stream;
+
+auto ThreadRandomStream() -> RandomStream& {
+  return g_thread_random_stream.stream;
+}
+
+void SeedThreadRandomStreams(uint64_t seed) {
+  g_thread_random_seed = seed;
+  g_thread_random_stream.stream.Seed(seed, g_thread_random_stream.stream_id);
+}
+
 static auto rand_range(float min, float max) -> float {
-  return min
-         + (static_cast<float>(rand())  // NOLINT
-            / static_cast<float>(RAND_MAX))
-               * (max - min);
+  return ThreadRandomStream().NextFloat(min, max);
+}
+
+static auto rand_section(int count) -> int {
+  return static_cast<int>(ThreadRandomStream().NextUInt32()
+                          % static_cast<uint32_t>(count));
 }
 
 class SmoothGen1D {
@@ -105,7 +130,7 @@ class SmoothGen1D {
     // Pull a section and remove it from our list.
     auto PullRandomSection() -> Section {
       int remaining_sections = 2 - val_count % 2;
-      int q_picked = rand() % remaining_sections;  // NOLINT
+      int q_picked = rand_section(remaining_sections);
       Section q_val = sections[q_picked];
       int pos_new = 0;
       for (int pos_old = 0; pos_old < remaining_sections; pos_old++) {
@@ -258,7 +283,7 @@ class SmoothGen2D {
     // Pull a section and remove it from our list.
     auto PullRandomSection() -> Section {
       int remaining_sections = 4 - val_count % 4;
-      int q_picked = rand() % remaining_sections;  // NOLINT
+      int q_picked = rand_section(remaining_sections);
       Section q_val = sections[q_picked];
       int pos_new = 0;
       for (int pos_old = 0; pos_old < remaining_sections; pos_old++) {
@@ -490,7 +515,7 @@ class SmoothGen3D {
     // Pull a section and remove it from our list.
     auto PullRandomSection() -> Section {
       int remaining_sections = 8 - val_count % 8;
-      int q_picked = rand() % remaining_sections;  // NOLINT
+      int q_picked = rand_section(remaining_sections);
       Section q_val = sections[q_picked];
       int pos_new = 0;
       for (int pos_old = 0; pos_old < remaining_sections; pos_old++) {
@@ -3,15 +3,92 @@
 #ifndef BALLISTICA_SHARED_MATH_RANDOM_H_
 #define BALLISTICA_SHARED_MATH_RANDOM_H_
 
+#include <cstddef>
+#include <cstdint>
+
 namespace ballistica {
 
-/// Return a random float value. Not guaranteed to be deterministic or
-/// consistent across platforms. Should do something better than this.
-inline auto RandomFloat() -> float {
-  // FIXME: should convert this to something thread-safe.
-  return static_cast<float>(
-      (static_cast<double>(rand()) / RAND_MAX));  // NOLINT
-}
+/// A small, fast random number generator (PCG32). Generators created with
+/// the same seed and stream produce the same sequence on all platforms,
+/// and different streams with the same seed are independent of each other,
+/// so subsystems and threads can each get their own reproducible sequence
+/// without any locking. Not suitable for anything security related.
+class RandomStream {
+ public:
+  explicit RandomStream(uint64_t seed = 0x853c49e6748fea9bULL,
+                        uint64_t stream = 0) {
+    Seed(seed, stream);
+  }
+
+  void Seed(uint64_t seed, uint64_t stream) {
+    state_ = 0;
+    inc_ = (stream << 1u) | 1u;
+    NextUInt32();
+    state_ += seed;
+    NextUInt32();
+  }
+
+  auto NextUInt32() -> uint32_t {
+    uint64_t old = state_;
+    state_ = old * 6364136223846793005ULL + inc_;
+    auto xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+    auto rot = static_cast<uint32_t>(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((~rot + 1u) & 31u));
+  }
+
+  /// A float in the range [0, 1).
+  auto NextFloat() -> float {
+    return static_cast<float>(NextUInt32() >> 8u) * (1.0f / 16777216.0f);
+  }
+
+  /// A float in the range [min, max).
+  auto NextFloat(float min, float max) -> float {
+    return min + NextFloat() * (max - min);
+  }
+
+  /// Fill out with count floats in the range [0, 1).
+  void Fill(float* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      out[i] = NextFloat();
+    }
+  }
+
+  /// Fill out with count raw 32 bit values.
+  void Fill(uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      out[i] = NextUInt32();
+    }
+  }
+
+  /// Create a new stream seeded from this one. Handy for giving each job
+  /// in a parallel batch its own generator while keeping the batch as a
+  /// whole reproducible.
+  auto Split() -> RandomStream {
+    // (Separate statements so the draw order is well defined.)
+    uint64_t seed = static_cast<uint64_t>(NextUInt32()) << 32u;
+    seed |= NextUInt32();
+    uint64_t stream = static_cast<uint64_t>(NextUInt32()) << 32u;
+    stream |= NextUInt32();
+    return RandomStream(seed, stream);
+  }
+
+ private:
+  uint64_t state_{};
+  uint64_t inc_{};
+};
+
+/// The calling thread's own stream. Each thread gets a distinct stream
+/// number (in the order threads first ask for one) under a shared seed.
+auto ThreadRandomStream() -> RandomStream&;
+
+/// Set the seed used for thread streams. Affects threads that have not yet
+/// asked for a stream as well as the calling thread's own (which is
+/// reseeded in place).
+void SeedThreadRandomStreams(uint64_t seed);
+
+/// Return a random float value in [0, 1) from the calling thread's stream.
+/// Safe to call from any thread.
+inline auto RandomFloat() -> float { return ThreadRandomStream().NextFloat(); }
 
 class Random {
  public:
@@ -457,6 +457,22 @@ Python::ScopedInterpreterLockRelease::~ScopedInterpreterLockRelease() {
   delete impl_;
 }
 
+thread_local int Python::ScopedNativeSection::depth_{};
+
+Python::ScopedNativeSection::ScopedNativeSection() {
+  depth_++;
+  if (HaveGIL()) {
+    thread_state_ = PyEval_SaveThread();
+  }
+}
+
+Python::ScopedNativeSection::~ScopedNativeSection() {
+  if (thread_state_) {
+    PyEval_RestoreThread(thread_state_);
+  }
+  depth_--;
+}
+
 // (some stuff borrowed from python's source code - used in our overriding of
 // objects' dir() results)
 
@@ -65,6 +65,26 @@ class Python {
     Impl* impl_{};
   };
 
+  /// Wrap stretches of pure C++ work done on a GIL-holding thread (physics
+  /// steps, encoding big messages, etc.) in one of these so other
+  /// Python-using threads can run meanwhile. Releases the GIL for its
+  /// duration if held; otherwise just marks the section. Nothing inside may
+  /// touch the Python API. Debug builds catch that through the HaveGIL()
+  /// asserts in our wrappers and checks of active() at entry points.
+  class ScopedNativeSection {
+   public:
+    ScopedNativeSection();
+    ~ScopedNativeSection();
+
+    /// Whether the calling thread is currently inside a native section.
+    static auto active() -> bool { return depth_ > 0; }
+
+   private:
+    PyThreadState* thread_state_{};
+    static thread_local int depth_;
+    BA_DISALLOW_CLASS_COPIES(ScopedNativeSection);
+  };
+
   /// Return whether the current thread holds the global-interpreter-lock.
   /// We must always hold the GIL while running python code.
   /// This *should* generally be the case by default, but this can be handy for
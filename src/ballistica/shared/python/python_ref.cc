@@ -360,6 +360,23 @@ auto PythonRef::Call(const Vector2f& val, bool print_errors) const
   return Call(args.get(), nullptr, print_errors);
 }
 
+auto PythonRef::Vectorcall(PyObject* callable, PyObject** argv, size_t nargs)
+    -> PyObject* {
+  assert(callable);
+  assert(Python::HaveGIL());
+  return PyObject_Vectorcall(callable, argv + 1,
+                             nargs | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+}
+
+auto PythonRef::Vectorcall_(PyObject** argv, size_t nargs,
+                            bool print_errors) const -> PythonRef {
+  assert(obj_);
+  assert(CallableCheck());
+  PyObject* out = Vectorcall(obj_, argv, nargs);
+  out = _HandleCallResults(out, print_errors);
+  return out ? PythonRef(out, PythonRef::kSteal) : PythonRef();
+}
+
 PythonRef::~PythonRef() { Release(); }
 
 #pragma clang diagnostic pop
@@ -207,7 +207,27 @@ class PythonRef {
   /// Call with Vector2f passed as a tuple.
   auto Call(const Vector2f& val, bool print_errors = true) const -> PythonRef;
 
+  /// Call with the provided positional args (borrowed refs) via vectorcall,
+  /// which hands them over straight from the stack instead of building an
+  /// args tuple. Prefer this in hot paths. On error, prints errors and
+  /// returns empty ref.
+  template <typename... Ts>
+  auto CallArgs(Ts... args) const -> PythonRef {
+    // The extra leading slot lets callees such as bound methods prepend
+    // 'self' without copying (PY_VECTORCALL_ARGUMENTS_OFFSET).
+    PyObject* argv[] = {nullptr, args...};
+    return Vectorcall_(argv, sizeof...(args), true);
+  }
+
+  /// Vectorcall a PyObject. Args start at argv[1]; argv[0] must be a
+  /// writable spare slot. Returns a new ref or nullptr with the Python
+  /// error set.
+  static auto Vectorcall(PyObject* callable, PyObject** argv, size_t nargs)
+      -> PyObject*;
+
  private:
+  auto Vectorcall_(PyObject** argv, size_t nargs, bool print_errors) const
+      -> PythonRef;
   void ThrowIfUnset() const;
   void SetObj(PyObject* obj);
   PyObject* obj_{};
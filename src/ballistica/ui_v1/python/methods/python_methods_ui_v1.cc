@@ -1695,6 +1695,9 @@ static auto PyScrollWidget(PyObject* self, PyObject* args, PyObject* keywds)
   PyObject* claims_left_right_obj{Py_None};
   PyObject* claims_up_down_obj{Py_None};
   PyObject* autoselect_obj{Py_None};
+  PyObject* virtual_item_count_obj{Py_None};
+  PyObject* virtual_item_size_obj{Py_None};
+  PyObject* virtual_item_call_obj{Py_None};
 
   static const char* kwlist[] = {"edit",
                                  "parent",
@@ -1714,16 +1717,21 @@ static auto PyScrollWidget(PyObject* self, PyObject* args, PyObject* keywds)
                                  "claims_left_right",
                                  "claims_up_down",
                                  "autoselect",
+                                 "virtual_item_count",
+                                 "virtual_item_size",
+                                 "virtual_item_call",
                                  nullptr};
 
   if (!PyArg_ParseTupleAndKeywords(
-          args, keywds, "|OOOOOOOOOOOOOOOOOO", const_cast<char**>(kwlist),
+          args, keywds, "|OOOOOOOOOOOOOOOOOOOOO", const_cast<char**>(kwlist),
           &edit_obj, &parent_obj, &size_obj, &pos_obj, &background_obj,
           &selected_child_obj, &capture_arrows_obj, &on_select_call_obj,
           &center_small_content_obj, &center_small_content_horizontally_obj,
           &color_obj, &highlight_obj, &border_opacity_obj,
           &simple_culling_v_obj, &selection_loops_to_parent_obj,
-          &claims_left_right_obj, &claims_up_down_obj, &autoselect_obj))
+          &claims_left_right_obj, &claims_up_down_obj, &autoselect_obj,
+          &virtual_item_count_obj, &virtual_item_size_obj,
+          &virtual_item_call_obj))
     return nullptr;
 
   if (!g_base->CurrentContext().IsEmpty()) {
@@ -1814,6 +1822,22 @@ static auto PyScrollWidget(PyObject* self, PyObject* args, PyObject* keywds)
     widget->set_auto_select(Python::GetPyBool(autoselect_obj));
   }
 
+  // Virtual items need a content container, so a new scroll widget has to
+  // be given them in a later edit call.
+  if (virtual_item_count_obj != Py_None || virtual_item_size_obj != Py_None
+      || virtual_item_call_obj != Py_None) {
+    if (virtual_item_count_obj == Py_None || virtual_item_size_obj == Py_None
+        || virtual_item_call_obj == Py_None) {
+      throw Exception(
+          "virtual_item_count, virtual_item_size, and virtual_item_call must "
+          "be passed together.",
+          PyExcType::kValue);
+    }
+    widget->SetVirtualItems(
+        Python::GetPyInt(virtual_item_count_obj),
+        Python::GetPyFloat(virtual_item_size_obj), virtual_item_call_obj);
+  }
+
   // If making a new widget add it at the end.
   if (edit_obj == Py_None) {
     g_ui_v1->AddWidget(widget.get(), parent_widget);
@@ -1850,7 +1874,11 @@ static PyMethodDef PyScrollWidgetDef = {
     "  selection_loops_to_parent: bool | None = None,\n"
     "  claims_left_right: bool | None = None,\n"
     "  claims_up_down: bool | None = None,\n"
-    "  autoselect: bool | None = None) -> bauiv1.Widget\n"
+    "  autoselect: bool | None = None,\n"
+    "  virtual_item_count: int | None = None,\n"
+    "  virtual_item_size: float | None = None,\n"
+    "  virtual_item_call: Callable[[int], bauiv1.Widget] | None = None)\n"
+    "  -> bauiv1.Widget\n"
     "\n"
     "Create or edit a scroll widget.\n"
     "\n"
@@ -1858,7 +1886,14 @@ static PyMethodDef PyScrollWidgetDef = {
     "\n"
     "Pass a valid existing bauiv1.Widget as 'edit' to modify it; otherwise\n"
     "a new one is created and returned. Arguments that are not set to None\n"
-    "are applied to the Widget.",
+    "are applied to the Widget.\n"
+    "\n"
+    "The virtual_item_* args (passed together when editing a scroll widget\n"
+    "that already has its content container) turn the content into a\n"
+    "virtualized list: virtual_item_call is passed an item index and should\n"
+    "create and return that item's widget in the content container. Items\n"
+    "are only kept alive while near the visible area, so very long lists\n"
+    "stay cheap.",
 };
 
 // ---------------------------- hscrollwidget ----------------------------------
@@ -1884,6 +1919,9 @@ static auto PyHScrollWidget(PyObject* self, PyObject* args, PyObject* keywds)
   PyObject* claims_left_right_obj{Py_None};
   PyObject* claims_up_down_obj{Py_None};
   PyObject* autoselect_obj{Py_None};
+  PyObject* virtual_item_count_obj{Py_None};
+  PyObject* virtual_item_size_obj{Py_None};
+  PyObject* virtual_item_call_obj{Py_None};
 
   static const char* kwlist[] = {"edit",
                                  "parent",
@@ -1901,15 +1939,19 @@ static auto PyHScrollWidget(PyObject* self, PyObject* args, PyObject* keywds)
                                  "claims_left_right",
                                  "claims_up_down",
                                  "autoselect",
+                                 "virtual_item_count",
+                                 "virtual_item_size",
+                                 "virtual_item_call",
                                  nullptr};
 
   if (!PyArg_ParseTupleAndKeywords(
-          args, keywds, "|OOOOOOOOOOOOOOO", const_cast<char**>(kwlist),
+          args, keywds, "|OOOOOOOOOOOOOOOOOOO", const_cast<char**>(kwlist),
           &edit_obj, &parent_obj, &size_obj, &pos_obj, &background_obj,
           &selected_child_obj, &capture_arrows_obj, &on_select_call_obj,
           &center_small_content_obj, &color_obj, &highlight_obj,
           &border_opacity_obj, &simple_culling_h_obj, &claims_left_right_obj,
-          &claims_up_down_obj, &autoselect_obj))
+          &claims_up_down_obj, &autoselect_obj, &virtual_item_count_obj,
+          &virtual_item_size_obj, &virtual_item_call_obj))
     return nullptr;
 
   if (!g_base->CurrentContext().IsEmpty()) {
@@ -1991,6 +2033,22 @@ static auto PyHScrollWidget(PyObject* self, PyObject* args, PyObject* keywds)
     widget->set_auto_select(Python::GetPyBool(autoselect_obj));
   }
 
+  // Virtual items need a content container, so a new scroll widget has to
+  // be given them in a later edit call.
+  if (virtual_item_count_obj != Py_None || virtual_item_size_obj != Py_None
+      || virtual_item_call_obj != Py_None) {
+    if (virtual_item_count_obj == Py_None || virtual_item_size_obj == Py_None
+        || virtual_item_call_obj == Py_None) {
+      throw Exception(
+          "virtual_item_count, virtual_item_size, and virtual_item_call must "
+          "be passed together.",
+          PyExcType::kValue);
+    }
+    widget->SetVirtualItems(Python::GetPyInt(virtual_item_count_obj),
+                            Python::GetPyFloat(virtual_item_size_obj),
+                            virtual_item_call_obj);
+  }
+
   // if making a new widget add it at the end
   if (edit_obj == Py_None) {
     g_ui_v1->AddWidget(widget.get(), parent_widget);
@@ -2024,7 +2082,12 @@ static PyMethodDef PyHScrollWidgetDef = {
     "  border_opacity: float | None = None,\n"
     "  simple_culling_h: float | None = None,\n"
     "  claims_left_right: bool | None = None,\n"
-    "  claims_up_down: bool | None = None)  -> bauiv1.Widget\n"
+    "  claims_up_down: bool | None = None,\n"
+    "  autoselect: bool | None = None,\n"
+    "  virtual_item_count: int | None = None,\n"
+    "  virtual_item_size: float | None = None,\n"
+    "  virtual_item_call: Callable[[int], bauiv1.Widget] | None = None)\n"
+    "  -> bauiv1.Widget\n"
     "\n"
     "Create or edit a horizontal scroll widget.\n"
     "\n"
@@ -2032,7 +2095,10 @@ static PyMethodDef PyHScrollWidgetDef = {
     "\n"
     "Pass a valid existing bauiv1.Widget as 'edit' to modify it; otherwise\n"
     "a new one is created and returned. Arguments that are not set to None\n"
-    "are applied to the Widget.",
+    "are applied to the Widget.\n"
+    "\n"
+    "The virtual_item_* args work as they do for bauiv1.scrollwidget(),\n"
+    "with items laid out left to right.",
 };
 
 // ------------------------------ textwidget -----------------------------------
@@ -0,0 +1,122 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/ui_v1/support/virtual_item_list.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/ui_v1/python/ui_v1_python.h"
+#include "ballistica/ui_v1/widget/container_widget.h"
+
+namespace ballistica::ui_v1 {
+
+VirtualItemList::VirtualItemList(int count, float item_size, PyObject* call)
+    : call_(call, PythonRef::kAcquire),
+      item_size_(item_size),
+      count_(count) {
+  if (count < 0) {
+    throw Exception("Virtual item count cannot be negative.",
+                    PyExcType::kValue);
+  }
+  if (item_size <= 0.0f) {
+    throw Exception("Virtual item size must be positive.", PyExcType::kValue);
+  }
+  if (!PyCallable_Check(call)) {
+    throw Exception("Virtual item call must be callable.", PyExcType::kType);
+  }
+}
+
+auto VirtualItemList::SetVisibleRange(float low, float high,
+                                      float content_size, bool vertical)
+    -> bool {
+  // Items count from the top for vertical lists and the left otherwise.
+  float begin = vertical ? content_size - high : low;
+  float end = vertical ? content_size - low : high;
+
+  // Keep an extra screenful around on either side so items exist before
+  // they scroll into view and we're not churning at the edges.
+  float margin = std::max(end - begin, item_size_);
+  int first = std::max(
+      0, static_cast<int>(std::floor((begin - margin) / item_size_)));
+  int last = std::min(
+      count_ - 1, static_cast<int>(std::floor((end + margin) / item_size_)));
+  if (first == first_ && last == last_) {
+    return false;
+  }
+  first_ = first;
+  last_ = last;
+  return true;
+}
+
+void VirtualItemList::Update(ContainerWidget* content, bool vertical) {
+  assert(g_base->InLogicThread());
+  assert(content);
+
+  // Kill items that have left our range (or died on their own).
+  std::vector<Widget*> dead;
+  for (auto i = items_.begin(); i != items_.end();) {
+    Widget* w = i->second.get();
+    if (w == nullptr || w->parent_widget() != content || i->first < first_
+        || i->first > last_) {
+      if (w && w->parent_widget() == content) {
+        dead.push_back(w);
+      }
+      i = items_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+  for (auto* w : dead) {
+    content->DeleteWidget(w);
+  }
+
+  // Create any that have entered it.
+  float content_size = vertical ? content->GetHeight() : content->GetWidth();
+  for (int index = first_; index <= last_; ++index) {
+    if (items_.find(index) != items_.end()) {
+      continue;
+    }
+    PythonRef result =
+        call_.CallArgs(PythonRef::Stolen(PyLong_FromLong(index)).get());
+    if (!result.exists()) {
+      continue;
+    }
+    Widget* w{};
+    try {
+      w = UIV1Python::GetPyWidget(result.get());
+    } catch (const Exception&) {
+      // Reported below.
+    }
+    if (w == nullptr || w->parent_widget() != content) {
+      g_core->Log(LogName::kBa, LogLevel::kError,
+                  "Virtual item call must return a widget created in the "
+                  "scroll widget's content container (index "
+                  + std::to_string(index) + ").");
+      continue;
+    }
+    if (vertical) {
+      w->set_translate(
+          w->tx(), content_size - static_cast<float>(index + 1) * item_size_);
+    } else {
+      w->set_translate(static_cast<float>(index) * item_size_, w->ty());
+    }
+    items_[index] = w;
+  }
+}
+
+void VirtualItemList::Clear(ContainerWidget* content) {
+  for (auto&& i : items_) {
+    Widget* w = i.second.get();
+    if (w && content && w->parent_widget() == content) {
+      content->DeleteWidget(w);
+    }
+  }
+  items_.clear();
+  first_ = 0;
+  last_ = -1;
+}
+
+}  // namespace ballistica::ui_v1
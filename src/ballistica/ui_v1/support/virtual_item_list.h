@@ -0,0 +1,56 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_UI_V1_SUPPORT_VIRTUAL_ITEM_LIST_H_
+#define BALLISTICA_UI_V1_SUPPORT_VIRTUAL_ITEM_LIST_H_
+
+#include <unordered_map>
+
+#include "ballistica/shared/python/python_ref.h"
+#include "ballistica/ui_v1/ui_v1.h"
+
+namespace ballistica::ui_v1 {
+
+/// Drives a virtualized list of equally sized items in a scroll widget's
+/// content container. Python supplies an item count and a call that
+/// creates the widget for an index; only items within (or near) the
+/// visible range are kept alive, and ones scrolling away are deleted.
+class VirtualItemList {
+ public:
+  VirtualItemList(int count, float item_size, PyObject* call);
+
+  auto count() const -> int { return count_; }
+  auto item_size() const -> float { return item_size_; }
+
+  /// Size the content needs along the scroll axis to hold all items.
+  auto GetContentSize() const -> float {
+    return static_cast<float>(count_) * item_size_;
+  }
+
+  /// Note the visible span along the scroll axis in content-local
+  /// coordinates. Returns true if the set of items that should exist has
+  /// changed and Update() should be run.
+  auto SetVisibleRange(float low, float high, float content_size,
+                       bool vertical) -> bool;
+
+  /// Delete items that have left the wanted range and create the ones that
+  /// have entered it. Runs Python, so must not be called while drawing or
+  /// otherwise traversing the widget tree.
+  void Update(ContainerWidget* content, bool vertical);
+
+  /// Delete all items we've created.
+  void Clear(ContainerWidget* content);
+
+ private:
+  PythonRef call_;
+  std::unordered_map<int, Object::WeakRef<Widget>> items_;
+  float item_size_{};
+  int count_{};
+
+  // Wanted index range (inclusive); empty when first > last.
+  int first_{};
+  int last_{-1};
+};
+
+}  // namespace ballistica::ui_v1
+
+#endif  // BALLISTICA_UI_V1_SUPPORT_VIRTUAL_ITEM_LIST_H_
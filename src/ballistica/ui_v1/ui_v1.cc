@@ -53,6 +53,7 @@ void UIV1FeatureSet::OnModuleExec(PyObject* module) {
   g_base = base::BaseFeatureSet::Import();
 
   g_core->Log(LogName::kBaLifecycle, LogLevel::kInfo, "_bauiv1 exec end");
+  g_core->MarkStartupPhase("bauiv1_exec");
 }
 
 auto UIV1FeatureSet::Import() -> UIV1FeatureSet* {
@@ -15,8 +15,14 @@ class ButtonWidget : public Widget {
   ~ButtonWidget() override;
   void Draw(base::RenderPass* pass, bool transparent) override;
   auto HandleMessage(const base::WidgetMessage& m) -> bool override;
-  void set_width(float width) { width_ = width; }
-  void set_height(float height) { height_ = height; }
+  void set_width(float width) {
+    width_ = width;
+    MarkNavIndexDirty();
+  }
+  void set_height(float height) {
+    height_ = height;
+    MarkNavIndexDirty();
+  }
   auto GetWidth() -> float override;
   auto GetHeight() -> float override;
   void set_color(float r, float g, float b) {
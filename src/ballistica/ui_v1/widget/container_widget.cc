@@ -1086,6 +1086,7 @@ void ContainerWidget::AddWidget(Widget* w) {
     BA_DEBUG_UI_WRITE_LOCK;
     w->set_parent_widget(this);
     widgets_.insert(widgets_.end(), Object::Ref<Widget>(w));
+    nav_index_dirty_ = true;
   }
 
   // If we're not selectable ourself and our child is, select it.
@@ -1130,6 +1131,7 @@ auto ContainerWidget::IsAcceptingInput() const -> bool {
 void ContainerWidget::Clear() {
   BA_DEBUG_UI_WRITE_LOCK;
   widgets_.clear();
+  nav_index_dirty_ = true;
   selected_widget_ = nullptr;
   prev_selected_widget_ = nullptr;
 }
@@ -1305,6 +1307,7 @@ void ContainerWidget::DeleteWidget(Widget* w) {
         // issues.
         auto w2 = Object::Ref<Widget>(*i);
         widgets_.erase(i);
+        nav_index_dirty_ = true;
         found = true;
         break;
       }
@@ -1482,118 +1485,107 @@ void ContainerWidget::SetSelected(bool s, SelectionCause cause) {
 
 auto ContainerWidget::GetClosestLeftWidget(float our_x, float our_y,
                                            Widget* ignore_widget) -> Widget* {
-  Widget* w = nullptr;
-  float x, y;
-  float closest_val = 9999.0f;
-  for (auto i = widgets_.begin(); i != widgets_.end(); i++) {
-    assert(i->exists());
-    (**i).GetCenter(&x, &y);
-    float slope = std::abs(x - our_x) / (std::max(0.001f, std::abs(y - our_y)));
-    slope = std::min(
-        slope, AUTO_SELECT_SLOPE_CLAMP);  // Beyond this, just go by distance.
-    float slope_weighted = AUTO_SELECT_SLOPE_WEIGHT * slope
-                           + (1.0f - AUTO_SELECT_SLOPE_WEIGHT) * 1.0f;
-    if (i->get() != ignore_widget && x < our_x && slope > AUTO_SELECT_MIN_SLOPE
-        && (**i).IsSelectable() && (**i).IsSelectableViaKeys()) {
-      // Take distance diff and multiply by our slope.
-      float xdist = x - our_x;
-      float ydist = y - our_y;
-      float dist = sqrtf(xdist * xdist + ydist * ydist);
-      float val =
-          dist / std::max(0.001f, slope_weighted + AUTO_SELECT_SLOPE_OFFSET);
-      if (val < closest_val || w == nullptr) {
-        closest_val = val;
-        w = i->get();
-      }
-    }
-  }
-  return w;
+  return GetClosestWidget_(our_x, our_y, ignore_widget, false, false);
 }
 
 auto ContainerWidget::GetClosestRightWidget(float our_x, float our_y,
                                             Widget* ignore_widget) -> Widget* {
-  Widget* w = nullptr;
-  float x, y;
-  float closest_val = 9999.0f;
-  for (auto i = widgets_.begin(); i != widgets_.end(); i++) {
-    assert(i->exists());
-    (**i).GetCenter(&x, &y);
-    float slope = std::abs(x - our_x) / (std::max(0.001f, std::abs(y - our_y)));
-    slope = std::min(
-        slope, AUTO_SELECT_SLOPE_CLAMP);  // beyond this, just go by distance
-    float slopeWeighted = AUTO_SELECT_SLOPE_WEIGHT * slope
-                          + (1.0f - AUTO_SELECT_SLOPE_WEIGHT) * 1.0f;
-    if (i->get() != ignore_widget && x > our_x && slope > AUTO_SELECT_MIN_SLOPE
-        && (**i).IsSelectable() && (**i).IsSelectableViaKeys()) {
-      // Take distance diff and multiply by our slope.
-      float xDist = x - our_x;
-      float yDist = y - our_y;
-      float dist = sqrtf(xDist * xDist + yDist * yDist);
-      float val =
-          dist / std::max(0.001f, slopeWeighted + AUTO_SELECT_SLOPE_OFFSET);
-      if (val < closest_val || w == nullptr) {
-        closest_val = val;
-        w = i->get();
-      }
-    }
-  }
-  return w;
+  return GetClosestWidget_(our_x, our_y, ignore_widget, false, true);
 }
 
 auto ContainerWidget::GetClosestUpWidget(float our_x, float our_y,
                                          Widget* ignoreWidget) -> Widget* {
-  Widget* w = nullptr;
-  float x, y;
-  float closest_val = 9999.0f;
-  for (auto i = widgets_.begin(); i != widgets_.end(); i++) {
-    assert(i->exists());
-    (**i).GetCenter(&x, &y);
-    float slope = std::abs(y - our_y) / (std::max(0.001f, std::abs(x - our_x)));
-    slope = std::min(
-        slope, AUTO_SELECT_SLOPE_CLAMP);  // Beyond this, just go by distance.
-    float slopeWeighted = AUTO_SELECT_SLOPE_WEIGHT * slope
-                          + (1.0f - AUTO_SELECT_SLOPE_WEIGHT) * 1.0f;
-    if (i->get() != ignoreWidget && y > our_y && slope > AUTO_SELECT_MIN_SLOPE
-        && (**i).IsSelectable() && (**i).IsSelectableViaKeys()) {
-      // Take distance diff and multiply by our slope.
-      float xDist = x - our_x;
-      float yDist = y - our_y;
-      float dist = sqrtf(xDist * xDist + yDist * yDist);
-      float val =
-          dist / std::max(0.001f, slopeWeighted + AUTO_SELECT_SLOPE_OFFSET);
-      if (val < closest_val || w == nullptr) {
-        closest_val = val;
-        w = i->get();
-      }
-    }
-  }
-  return w;
+  return GetClosestWidget_(our_x, our_y, ignoreWidget, true, true);
 }
 
 auto ContainerWidget::GetClosestDownWidget(float our_x, float our_y,
                                            Widget* ignoreWidget) -> Widget* {
+  return GetClosestWidget_(our_x, our_y, ignoreWidget, true, false);
+}
+
+void ContainerWidget::UpdateNavIndex_() {
+  nav_by_x_.clear();
+  nav_by_x_.reserve(widgets_.size());
+  for (size_t i = 0; i < widgets_.size(); i++) {
+    assert(widgets_[i].exists());
+    NavEntry_ entry{};
+    widgets_[i]->GetCenter(&entry.x, &entry.y);
+    entry.index = static_cast<int>(i);
+    nav_by_x_.push_back(entry);
+  }
+  nav_by_y_ = nav_by_x_;
+  std::sort(nav_by_x_.begin(), nav_by_x_.end(),
+            [](const NavEntry_& a, const NavEntry_& b) {
+              return a.x < b.x || (a.x == b.x && a.index < b.index);
+            });
+  std::sort(nav_by_y_.begin(), nav_by_y_.end(),
+            [](const NavEntry_& a, const NavEntry_& b) {
+              return a.y < b.y || (a.y == b.y && a.index < b.index);
+            });
+
+  // Clear this last; measuring children can run their layouts, which may
+  // poke us, but the values we just read are already current.
+  nav_index_dirty_ = false;
+}
+
+auto ContainerWidget::GetClosestWidget_(float our_x, float our_y,
+                                        Widget* ignore_widget, bool vertical,
+                                        bool positive) -> Widget* {
+  if (nav_index_dirty_) {
+    UpdateNavIndex_();
+  }
+  auto& entries{vertical ? nav_by_y_ : nav_by_x_};
+  float our_primary = vertical ? our_y : our_x;
+  auto primary = [vertical](const NavEntry_& e) {
+    return vertical ? e.y : e.x;
+  };
+
+  // The weighting can divide distance by at most this much, so once we're
+  // this far out along our axis nothing can beat what we have.
+  const float max_divisor = AUTO_SELECT_SLOPE_WEIGHT * AUTO_SELECT_SLOPE_CLAMP
+                            + (1.0f - AUTO_SELECT_SLOPE_WEIGHT)
+                            + AUTO_SELECT_SLOPE_OFFSET;
+
+  // Start from the nearest entry strictly on our side and walk outward.
+  auto pos = std::partition_point(
+      entries.begin(), entries.end(), [&](const NavEntry_& e) {
+        return positive ? primary(e) <= our_primary : primary(e) < our_primary;
+      });
+  ptrdiff_t start = pos - entries.begin();
+  ptrdiff_t i = positive ? start : start - 1;
+  ptrdiff_t step = positive ? 1 : -1;
+
   Widget* w = nullptr;
-  float x, y;
+  int closest_index{};
   float closest_val = 9999.0f;
-  for (auto i = widgets_.begin(); i != widgets_.end(); i++) {
-    assert(i->exists());
-    (**i).GetCenter(&x, &y);
-    float slope = std::abs(y - our_y) / (std::max(0.001f, std::abs(x - our_x)));
+  for (; i >= 0 && i < static_cast<ptrdiff_t>(entries.size()); i += step) {
+    const NavEntry_& e{entries[i]};
+    float d_primary = std::abs(primary(e) - our_primary);
+    if (w != nullptr && d_primary > closest_val * max_divisor * 1.0001f) {
+      break;
+    }
+    float d_secondary = std::abs(vertical ? e.x - our_x : e.y - our_y);
+    float slope = d_primary / (std::max(0.001f, d_secondary));
     slope = std::min(
         slope, AUTO_SELECT_SLOPE_CLAMP);  // Beyond this, just go by distance.
-    float slopeWeighted = AUTO_SELECT_SLOPE_WEIGHT * slope
-                          + (1.0f - AUTO_SELECT_SLOPE_WEIGHT) * 1.0f;
-    if (i->get() != ignoreWidget && y < our_y && slope > AUTO_SELECT_MIN_SLOPE
-        && (**i).IsSelectable() && (**i).IsSelectableViaKeys()) {
+    float slope_weighted = AUTO_SELECT_SLOPE_WEIGHT * slope
+                           + (1.0f - AUTO_SELECT_SLOPE_WEIGHT) * 1.0f;
+    Widget* candidate = widgets_[e.index].get();
+    if (candidate != ignore_widget && slope > AUTO_SELECT_MIN_SLOPE
+        && candidate->IsSelectable() && candidate->IsSelectableViaKeys()) {
       // Take distance diff and multiply by our slope.
-      float xDist = x - our_x;
-      float yDist = y - our_y;
-      float dist = sqrtf(xDist * xDist + yDist * yDist);
+      float xdist = e.x - our_x;
+      float ydist = e.y - our_y;
+      float dist = sqrtf(xdist * xdist + ydist * ydist);
       float val =
-          dist / std::max(0.001f, slopeWeighted + AUTO_SELECT_SLOPE_OFFSET);
-      if (val < closest_val || w == nullptr) {
+          dist / std::max(0.001f, slope_weighted + AUTO_SELECT_SLOPE_OFFSET);
+
+      // Ties go to the earliest child, as with a plain linear scan.
+      if (w == nullptr || val < closest_val
+          || (val == closest_val && e.index < closest_index)) {
         closest_val = val;
-        w = i->get();
+        closest_index = e.index;
+        w = candidate;
       }
     }
   }
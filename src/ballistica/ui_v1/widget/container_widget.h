@@ -48,12 +48,14 @@ class ContainerWidget : public Widget {
   virtual void SetWidth(float w) {
     bg_dirty_ = glow_dirty_ = true;
     width_ = w;
+    MarkNavIndexDirty();
     MarkForUpdate();
   }
 
   virtual void SetHeight(float h) {
     bg_dirty_ = glow_dirty_ = true;
     height_ = h;
+    MarkNavIndexDirty();
     MarkForUpdate();
   }
 
@@ -176,6 +178,9 @@ class ContainerWidget : public Widget {
 
   auto IsTransitioningOut() const -> bool override;
 
+  /// Called by children when their centers move.
+  void MarkChildNavIndexDirty() { nav_index_dirty_ = true; }
+
  protected:
   void set_single_depth_root(bool s) { single_depth_root_ = s; }
 
@@ -195,8 +200,14 @@ class ContainerWidget : public Widget {
 
   auto width() const -> float { return width_; }
   auto height() const -> float { return height_; }
-  void set_width(float val) { width_ = val; }
-  void set_height(float val) { height_ = val; }
+  void set_width(float val) {
+    width_ = val;
+    MarkNavIndexDirty();
+  }
+  void set_height(float val) {
+    height_ = val;
+    MarkNavIndexDirty();
+  }
 
  private:
   // Given a container and a point, returns a selectable widget in the
@@ -205,10 +216,27 @@ class ContainerWidget : public Widget {
   auto GetClosestUpWidget(float x, float y, Widget* ignoreWidget) -> Widget*;
   auto GetClosestRightWidget(float x, float y, Widget* ignoreWidget) -> Widget*;
   auto GetClosestLeftWidget(float x, float y, Widget* ignoreWidget) -> Widget*;
+
+  // Shared by the above; scans the nav index outward from the given
+  // point along one axis, stopping once nothing further out could win.
+  auto GetClosestWidget_(float x, float y, Widget* ignore_widget,
+                         bool vertical, bool positive) -> Widget*;
+  void UpdateNavIndex_();
+
+  struct NavEntry_ {
+    float x;
+    float y;
+    int index;
+  };
   auto GetMult(millisecs_t current_time, bool for_glow = false) const -> float;
   void PrintExitListInstructions(millisecs_t old_last_prev_next_time);
 
   std::vector<Object::Ref<Widget> > widgets_;
+
+  // Child centers sorted by x and by y; rebuilt lazily when children are
+  // added, removed, moved, or resized.
+  std::vector<NavEntry_> nav_by_x_;
+  std::vector<NavEntry_> nav_by_y_;
   Object::Ref<base::TextureAsset> tex_;
   Object::WeakRef<ButtonWidget> cancel_button_;
   Object::WeakRef<ButtonWidget> start_button_;
@@ -262,6 +290,7 @@ class ContainerWidget : public Widget {
   bool dragging_{};
   bool managed_{true};
   bool needs_update_{};
+  bool nav_index_dirty_{true};
   bool claims_tab_{true};
   bool claims_left_right_{true};
   bool claims_up_down_{true};
@@ -3,12 +3,16 @@
 #include "ballistica/ui_v1/widget/h_scroll_widget.h"
 
 #include <algorithm>
+#include <memory>
+#include <utility>
 
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/graphics/component/empty_component.h"
 #include "ballistica/base/graphics/component/simple_component.h"
+#include "ballistica/base/logic/logic.h"
 #include "ballistica/base/support/app_timer.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/foundation/inline.h"
 
 namespace ballistica::ui_v1 {
@@ -23,6 +27,34 @@ HScrollWidget::HScrollWidget()
 
 HScrollWidget::~HScrollWidget() = default;
 
+void HScrollWidget::SetVirtualItems(int count, float item_size,
+                                    PyObject* call) {
+  auto* content = widgets().empty()
+                      ? nullptr
+                      : dynamic_cast<ContainerWidget*>(widgets()[0].get());
+  if (content == nullptr) {
+    throw Exception("Virtual items require a content container widget.",
+                    PyExcType::kWidgetNotFound);
+  }
+  auto virtual_items =
+      std::make_unique<VirtualItemList>(count, item_size, call);
+  if (virtual_items_) {
+    virtual_items_->Clear(content);
+  }
+  virtual_items_ = std::move(virtual_items);
+  content->SetWidth(virtual_items_->GetContentSize());
+  MarkForUpdate();
+}
+
+void HScrollWidget::UpdateVirtualItems_() {
+  if (!virtual_items_ || widgets().empty()) {
+    return;
+  }
+  if (auto* content = dynamic_cast<ContainerWidget*>(widgets()[0].get())) {
+    virtual_items_->Update(content, false);
+  }
+}
+
 void HScrollWidget::OnTouchDelayTimerExpired() {
   if (touch_held_) {
     // Pass a mouse-down event if we haven't moved.
@@ -587,6 +619,23 @@ void HScrollWidget::Draw(base::RenderPass* pass, bool draw_transparent) {
 
   CheckLayout();
 
+  // Note where our virtual items need to be. We can't create widgets in
+  // the middle of drawing so do it right after.
+  if (virtual_items_ && !draw_transparent && !widgets().empty()) {
+    Widget& content = *widgets()[0];
+    float low = border_width_ + kHMargin - content.tx();
+    float high = width() - (border_width_ + kHMargin) - content.tx();
+    if (virtual_items_->SetVisibleRange(low, high, content.GetWidth(),
+                                        false)) {
+      Object::WeakRef<HScrollWidget> weakref(this);
+      g_base->logic->event_loop()->PushCall([weakref] {
+        if (auto* w = weakref.get()) {
+          w->UpdateVirtualItems_();
+        }
+      });
+    }
+  }
+
   Vector3f tilt = 0.02f * g_base->graphics->tilt();
   float extra_offs_x = tilt.y;
   float extra_offs_y = -tilt.x;
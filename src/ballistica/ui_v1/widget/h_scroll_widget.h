@@ -3,8 +3,10 @@
 #ifndef BALLISTICA_UI_V1_WIDGET_H_SCROLL_WIDGET_H_
 #define BALLISTICA_UI_V1_WIDGET_H_SCROLL_WIDGET_H_
 
+#include <memory>
 #include <string>
 
+#include "ballistica/ui_v1/support/virtual_item_list.h"
 #include "ballistica/ui_v1/widget/container_widget.h"
 
 namespace ballistica::ui_v1 {
@@ -43,11 +45,20 @@ class HScrollWidget : public ContainerWidget {
   void setBorderOpacity(float val) { border_opacity_ = val; }
   auto getBorderOpacity() const -> float { return border_opacity_; }
 
+  /// Turn our content container into a virtualized list of count items,
+  /// each item_size wide. Call is passed an index and should create
+  /// and return that item's widget in the content container; items only
+  /// exist while near the visible area.
+  void SetVirtualItems(int count, float item_size, PyObject* call);
+
  protected:
   void UpdateLayout() override;
 
  private:
   void ClampThumb_(bool velocity_clamp, bool position_clamp);
+  void UpdateVirtualItems_();
+
+  std::unique_ptr<VirtualItemList> virtual_items_;
 
   Object::Ref<base::AppTimer> touch_delay_timer_;
   seconds_t last_scroll_bar_show_time_{};
@@ -21,10 +21,12 @@ class ImageWidget : public Widget {
   void set_width(float width) {
     image_dirty_ = true;
     width_ = width;
+    MarkNavIndexDirty();
   }
   void set_height(float val) {
     image_dirty_ = true;
     height_ = val;
+    MarkNavIndexDirty();
   }
   auto GetWidth() -> float override;
   auto GetHeight() -> float override;
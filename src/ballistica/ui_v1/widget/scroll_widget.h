@@ -3,8 +3,10 @@
 #ifndef BALLISTICA_UI_V1_WIDGET_SCROLL_WIDGET_H_
 #define BALLISTICA_UI_V1_WIDGET_SCROLL_WIDGET_H_
 
+#include <memory>
 #include <string>
 
+#include "ballistica/ui_v1/support/virtual_item_list.h"
 #include "ballistica/ui_v1/widget/container_widget.h"
 
 namespace ballistica::ui_v1 {
@@ -47,11 +49,20 @@ class ScrollWidget : public ContainerWidget {
   auto set_border_opacity(float val) { border_opacity_ = val; }
   auto border_opacity() const -> float { return border_opacity_; }
 
+  /// Turn our content container into a virtualized list of count items,
+  /// each item_size tall. Call is passed an index and should create
+  /// and return that item's widget in the content container; items only
+  /// exist while near the visible area.
+  void SetVirtualItems(int count, float item_size, PyObject* call);
+
  protected:
   void UpdateLayout() override;
 
  private:
   void ClampThumb_(bool velocity_clamp, bool position_clamp);
+  void UpdateVirtualItems_();
+
+  std::unique_ptr<VirtualItemList> virtual_items_;
 
   Object::Ref<base::AppTimer> touch_delay_timer_;
   millisecs_t last_sub_widget_h_scroll_claim_time_{};
@@ -19,7 +19,10 @@ class SpinnerWidget : public Widget {
   ~SpinnerWidget() override;
   void Draw(base::RenderPass* pass, bool transparent) override;
   auto HandleMessage(const base::WidgetMessage& m) -> bool override;
-  void set_size(float size) { size_ = size; }
+  void set_size(float size) {
+    size_ = size;
+    MarkNavIndexDirty();
+  }
 
   /// Setting the visibility attr on a spinner will cause it to fade in
   /// gradually when made visible. Setting visible-in-container will not
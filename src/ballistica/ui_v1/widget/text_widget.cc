@@ -58,11 +58,13 @@ void TextWidget::SetOnActivateCall(PyObject* call_tuple) {
 void TextWidget::SetWidth(float width_in) {
   highlight_dirty_ = outline_dirty_ = true;
   width_ = width_in;
+  MarkNavIndexDirty();
 }
 
 void TextWidget::SetHeight(float height_in) {
   highlight_dirty_ = outline_dirty_ = true;
   height_ = height_in;
+  MarkNavIndexDirty();
 }
 
 void TextWidget::SetEditable(bool e) {
@@ -213,6 +213,12 @@ auto Widget::GetPyWidget_(bool new_ref) -> PyObject* {
   return py_ref_;
 }
 
+void Widget::MarkNavIndexDirty() {
+  if (parent_widget_) {
+    parent_widget_->MarkChildNavIndexDirty();
+  }
+}
+
 void Widget::GetCenter(float* x, float* y) {
   *x = tx() + scale() * GetWidth() * 0.5f;
   *y = ty() + scale() * GetHeight() * 0.5f;
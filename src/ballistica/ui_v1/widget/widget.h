@@ -147,6 +147,7 @@ class Widget : public Object {
   void set_translate(float x, float y) {
     tx_ = x;
     ty_ = y;
+    MarkNavIndexDirty();
   }
   void set_stack_offset(float x, float y) {
     stack_offset_x_ = x;
@@ -161,11 +162,18 @@ class Widget : public Object {
 
   // Overall scale of the widget.
   auto scale() const { return scale_; }
-  void set_scale(float s) { scale_ = s; }
+  void set_scale(float s) {
+    scale_ = s;
+    MarkNavIndexDirty();
+  }
 
   // Return the widget's center in its parent's space.
   virtual void GetCenter(float* x, float* y);
 
+  // Should be called whenever something our GetCenter() depends on
+  // changes, so our parent rebuilds its directional-navigation index.
+  void MarkNavIndexDirty();
+
   // Translates a point from screen space to widget space.
   void ScreenPointToWidget(float* x, float* y) const;
   void WidgetPointToScreen(float* x, float* y) const;
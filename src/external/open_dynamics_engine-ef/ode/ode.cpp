@@ -1453,6 +1453,8 @@ dxWorld * dWorldCreate()
   w->contactp.max_vel = dInfinity;
   w->contactp.min_depth = 0;
 
+  w->defer_geom_moved = 0;
+
   return w;
 }
 
@@ -1547,6 +1549,13 @@ void dWorldQuickStep (dWorldID w, dReal stepsize) {
   dxProcessIslands (w,stepsize,&dxQuickStepper);
 }
 
+void dWorldQuickStepParallel (dWorldID w, dReal stepsize,
+                              dIslandRunnerFn runner, void *runner_data) {
+  dUASSERT (w,"bad world argument");
+  dUASSERT (stepsize > 0,"stepsize must be > 0");
+  dxProcessIslandsParallel (w,stepsize,&dxQuickStepper,runner,runner_data);
+}
+
 int dWorldGetQuickStepWarmStartingDataSize(dWorldID w) {
 	return 6 * w->nj;
 }
@@ -32,6 +32,15 @@
 
 #include <cmath>
 
+#if defined(dSINGLE) && (defined(__SSE__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#include <xmmintrin.h>
+#define TRIMESH_SPHERE_SSE 1
+#elif defined(dSINGLE) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TRIMESH_SPHERE_NEON 1
+#endif
+
 #include "ode/ode_collision.h"
 #include "ode/ode_matrix.h"
 #include "ode/ode_rotation.h"
@@ -274,6 +283,91 @@ static bool GetContactData(const dVector3& Center, dReal Radius, const dVector3
 	else return false;
 }
 
+// ericf: quick rejection of up to 4 triangles at once. Returns a bitmask
+// of triangles that *may* touch the sphere; anything rejected here would
+// also be rejected by GetContactData() (those facing away from the sphere
+// center or whose plane is farther than the radius), and margins are
+// generous so rounding differences can only let extra triangles through
+// to the full test.
+static int SphereTriPrefilter4(const dVector3 Tris[4][3], int Count,
+                               const dVector3 Center, dReal Radius){
+	float ax[4], ay[4], az[4], ux[4], uy[4], uz[4], vx[4], vy[4], vz[4];
+	for (int i = 0; i < 4; i++){
+		const dVector3* t = Tris[i < Count ? i : 0];
+		ax[i] = (float) (Center[0] - t[0][0]);
+		ay[i] = (float) (Center[1] - t[0][1]);
+		az[i] = (float) (Center[2] - t[0][2]);
+		ux[i] = (float) (t[1][0] - t[0][0]);
+		uy[i] = (float) (t[1][1] - t[0][1]);
+		uz[i] = (float) (t[1][2] - t[0][2]);
+		vx[i] = (float) (t[2][0] - t[0][0]);
+		vy[i] = (float) (t[2][1] - t[0][1]);
+		vz[i] = (float) (t[2][2] - t[0][2]);
+	}
+	float r = (float) Radius * 1.001f + 0.0001f;
+	float r2 = r * r;
+	const float back2 = 0.0001f * 0.0001f;
+	int mask;
+
+	// With n the (unnormalized) face normal and d = n . (center - v0), we
+	// reject if d < 0 and d^2 > back2 * |n|^2, or if d > 0 and
+	// d^2 > r^2 * |n|^2.
+#if TRIMESH_SPHERE_SSE
+	__m128 Ux = _mm_loadu_ps(ux), Uy = _mm_loadu_ps(uy), Uz = _mm_loadu_ps(uz);
+	__m128 Vx = _mm_loadu_ps(vx), Vy = _mm_loadu_ps(vy), Vz = _mm_loadu_ps(vz);
+	__m128 Nx = _mm_sub_ps(_mm_mul_ps(Uy, Vz), _mm_mul_ps(Uz, Vy));
+	__m128 Ny = _mm_sub_ps(_mm_mul_ps(Uz, Vx), _mm_mul_ps(Ux, Vz));
+	__m128 Nz = _mm_sub_ps(_mm_mul_ps(Ux, Vy), _mm_mul_ps(Uy, Vx));
+	__m128 D = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Nx, _mm_loadu_ps(ax)),
+	                                 _mm_mul_ps(Ny, _mm_loadu_ps(ay))),
+	                      _mm_mul_ps(Nz, _mm_loadu_ps(az)));
+	__m128 N2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Nx, Nx), _mm_mul_ps(Ny, Ny)),
+	                       _mm_mul_ps(Nz, Nz));
+	__m128 D2 = _mm_mul_ps(D, D);
+	__m128 Zero = _mm_setzero_ps();
+	__m128 Back = _mm_and_ps(_mm_cmplt_ps(D, Zero),
+	                         _mm_cmpgt_ps(D2, _mm_mul_ps(N2, _mm_set1_ps(back2))));
+	__m128 Far = _mm_and_ps(_mm_cmpgt_ps(D, Zero),
+	                        _mm_cmpgt_ps(D2, _mm_mul_ps(N2, _mm_set1_ps(r2))));
+	mask = ~_mm_movemask_ps(_mm_or_ps(Back, Far)) & 0xf;
+#elif TRIMESH_SPHERE_NEON
+	float32x4_t Ux = vld1q_f32(ux), Uy = vld1q_f32(uy), Uz = vld1q_f32(uz);
+	float32x4_t Vx = vld1q_f32(vx), Vy = vld1q_f32(vy), Vz = vld1q_f32(vz);
+	float32x4_t Nx = vmlsq_f32(vmulq_f32(Uy, Vz), Uz, Vy);
+	float32x4_t Ny = vmlsq_f32(vmulq_f32(Uz, Vx), Ux, Vz);
+	float32x4_t Nz = vmlsq_f32(vmulq_f32(Ux, Vy), Uy, Vx);
+	float32x4_t D = vmlaq_f32(vmlaq_f32(vmulq_f32(Nx, vld1q_f32(ax)),
+	                                    Ny, vld1q_f32(ay)),
+	                          Nz, vld1q_f32(az));
+	float32x4_t N2 = vmlaq_f32(vmlaq_f32(vmulq_f32(Nx, Nx), Ny, Ny), Nz, Nz);
+	float32x4_t D2 = vmulq_f32(D, D);
+	float32x4_t Zero = vdupq_n_f32(0.0f);
+	uint32x4_t Back = vandq_u32(vcltq_f32(D, Zero),
+	                            vcgtq_f32(D2, vmulq_n_f32(N2, back2)));
+	uint32x4_t Far = vandq_u32(vcgtq_f32(D, Zero),
+	                           vcgtq_f32(D2, vmulq_n_f32(N2, r2)));
+	uint32_t reject[4];
+	vst1q_u32(reject, vorrq_u32(Back, Far));
+	mask = 0;
+	for (int i = 0; i < 4; i++){
+		if (!reject[i]) mask |= 1 << i;
+	}
+#else
+	mask = 0;
+	for (int i = 0; i < 4; i++){
+		float nx = uy[i] * vz[i] - uz[i] * vy[i];
+		float ny = uz[i] * vx[i] - ux[i] * vz[i];
+		float nz = ux[i] * vy[i] - uy[i] * vx[i];
+		float d = nx * ax[i] + ny * ay[i] + nz * az[i];
+		float n2 = nx * nx + ny * ny + nz * nz;
+		bool back = d < 0.0f && d * d > n2 * back2;
+		bool far = d > 0.0f && d * d > n2 * r2;
+		if (!(back || far)) mask |= 1 << i;
+	}
+#endif
+	return mask & ((1 << Count) - 1);
+}
+
 int dCollideSTL(dxGeom* g1, dxGeom* SphereGeom, int Flags, dContactGeom* Contacts, int Stride){
 	dxTriMesh* TriMesh = (dxTriMesh*)g1;
 
@@ -333,15 +427,27 @@ int dCollideSTL(dxGeom* g1, dxGeom* SphereGeom, int Flags, dContactGeom* Contact
 		}
 
 		int OutTriCount = 0;
+		dVector3 Batch[4][3];
+		int BatchMask = 0;
 		for (int i = 0; i < TriCount; i++){
 			if (OutTriCount == (Flags & 0xffff)){
 				break;
 			}
 
-			const int& TriIndex = Triangles[i];
+			// Fetch and pre-test triangles in groups of 4.
+			int BatchIndex = i & 3;
+			if (BatchIndex == 0){
+				int BatchCount = TriCount - i < 4 ? TriCount - i : 4;
+				for (int j = 0; j < BatchCount; j++){
+					FetchTriangle(TriMesh, Triangles[i + j], TLPosition, TLRotation, Batch[j]);
+				}
+				BatchMask = SphereTriPrefilter4(Batch, BatchCount, Position, Radius);
+			}
+			if (!(BatchMask & (1 << BatchIndex))){
+				continue;
+			}
 
-			dVector3 dv[3];
-			FetchTriangle(TriMesh, TriIndex, TLPosition, TLRotation, dv);
+			dVector3* dv = Batch[BatchIndex];
 
 			dVector3& v0 = dv[0];
 			dVector3& v1 = dv[1];
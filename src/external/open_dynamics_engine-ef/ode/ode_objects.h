@@ -51,6 +51,19 @@ void dWorldImpulseToForce (dWorldID, dReal stepsize,
 /* World QuickStep functions */
 
 void dWorldQuickStep (dWorldID w, dReal stepsize);
+
+/* ericf: island-parallel quickstep. ODE finds all islands up front and
+ * then calls runner, which must call step_island(context, i) exactly once
+ * for each i in [0, island_count) (from any threads, in any order) and
+ * return once they have all finished. Islands share no bodies or joints
+ * and geom notifications are replayed in serial order afterwards, so
+ * results match dWorldQuickStep exactly. */
+typedef void (*dIslandRunnerFn) (void *runner_data, int island_count,
+                                 void (*step_island) (void *context,
+                                                      int island),
+                                 void *context);
+void dWorldQuickStepParallel (dWorldID w, dReal stepsize,
+                              dIslandRunnerFn runner, void *runner_data);
 void dWorldSetQuickStepNumIterations (dWorldID, int num);
 int dWorldGetQuickStepNumIterations (dWorldID);
 void dWorldSetQuickStepW (dWorldID, dReal param);
@@ -119,6 +119,7 @@ struct dxWorld : public dBase {
   int adis_flag;		// auto-disable flag for new bodies
   dxQuickStepParameters qs;
   dxContactParameters contactp;
+  int defer_geom_moved;		// ericf: set while islands step in parallel
 };
 
 
@@ -493,17 +493,20 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 
 //ericf: we save and restore the random seed here so each island is not affected by the
 //existance of other islands
+//ericf: we also run the generator on a local copy (same sequence as
+//dRandInt) so islands can be stepped on multiple threads at once
 #ifdef RANDOMLY_REORDER_CONSTRAINTS
-		unsigned long oldSeed = dRandGetSeed();
+		unsigned long randSeed = dRandGetSeed();
 		if ((iteration & 7) == 0) {
 			for (i=1; i<m; ++i) {
 				IndexError tmp = order[i];
-				int swapi = dRandInt(i+1);
+				randSeed = (1664525L*randSeed + 1013904223L) & 0xffffffff;
+				int swapi = (int) (double(randSeed)
+				                   * (double(i+1) / 4294967296.0));
 				order[i] = order[swapi];
 				order[swapi] = tmp;
 			}
 		}
-		dRandSetSeed(oldSeed);
 #endif
 
 		//@@@ potential optimization: swap lambda and last_lambda pointers rather
@@ -167,6 +167,9 @@ void dxStepBody (dxBody *b, dReal h)
     dQtoR (b->q,b->R);
 
     // notify all attached geoms that this body has moved
+    // (ericf: when stepping islands in parallel this touches shared space
+    // lists, so the caller does it afterwards instead)
+    if (b->world->defer_geom_moved) return;
     for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
         dGeomMoved (geom);
 }
@@ -283,3 +286,118 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   }
 # endif
 }
+
+// ericf: like dxProcessIslands(), but finds all islands first and hands
+// them to a runner to step (typically in parallel). islands are found in
+// the same order and each one only touches its own bodies and joints, so
+// the results are identical to the serial version.
+
+struct dxIslandSet {
+  dxWorld *world;
+  dReal stepsize;
+  dstepper_fn_t stepper;
+  dxBody **body;
+  dxJoint **joint;
+  int *body_start;	// island i's bodies are [body_start[i],body_start[i+1])
+  int *joint_start;	// likewise for joints
+};
+
+static void dxStepIslandInSet (void *context, int island)
+{
+  dxIslandSet *set = (dxIslandSet*) context;
+  int b0 = set->body_start[island];
+  int j0 = set->joint_start[island];
+  set->stepper (set->world,set->body+b0,set->body_start[island+1]-b0,
+		set->joint+j0,set->joint_start[island+1]-j0,set->stepsize);
+}
+
+void dxProcessIslandsParallel (dxWorld *world, dReal stepsize,
+			       dstepper_fn_t stepper, dIslandRunnerFn runner,
+			       void *runner_data)
+{
+  dxBody *b,*bb,**body;
+  dxJoint *j,**joint;
+
+  // nothing to do if no bodies
+  if (world->nb <= 0) return;
+
+  // handle auto-disabling of bodies
+  dInternalHandleAutoDisabling (world,stepsize);
+
+  // body and joint lists for all islands, packed one after another
+  body = (dxBody**) ALLOCA (world->nb * sizeof(dxBody*));
+  joint = (dxJoint**) ALLOCA ((world->nj + 1) * sizeof(dxJoint*));
+  int *body_start = (int*) ALLOCA ((world->nb + 1) * sizeof(int));
+  int *joint_start = (int*) ALLOCA ((world->nb + 1) * sizeof(int));
+  int bcount = 0;
+  int jcount = 0;
+  int icount = 0;
+
+  for (b=world->firstbody; b; b=(dxBody*)b->next) b->tag = 0;
+  for (j=world->firstjoint; j; j=(dxJoint*)j->next) j->tag = 0;
+
+  int stackalloc = (world->nj < world->nb) ? world->nj : world->nb;
+  dxBody **stack = (dxBody**) ALLOCA ((stackalloc + 1) * sizeof(dxBody*));
+
+  for (bb=world->firstbody; bb; bb=(dxBody*)bb->next) {
+    if (bb->tag || (bb->flags & dxBodyDisabled)) continue;
+    bb->tag = 1;
+    body_start[icount] = bcount;
+    joint_start[icount] = jcount;
+    icount++;
+
+    int stacksize = 0;
+    body[bcount++] = bb;
+    b = bb;
+    for (;;) {
+      for (dxJointNode *n=b->firstjoint; n; n=n->next) {
+	if (!n->joint->tag) {
+	  n->joint->tag = 1;
+	  joint[jcount++] = n->joint;
+	  if (n->body && !n->body->tag) {
+	    n->body->tag = 1;
+	    stack[stacksize++] = n->body;
+	  }
+	}
+      }
+      if (stacksize == 0) break;
+      b = stack[--stacksize];
+      body[bcount++] = b;
+    }
+  }
+  body_start[icount] = bcount;
+  joint_start[icount] = jcount;
+
+  dxIslandSet set;
+  set.world = world;
+  set.stepsize = stepsize;
+  set.stepper = stepper;
+  set.body = body;
+  set.joint = joint;
+  set.body_start = body_start;
+  set.joint_start = joint_start;
+
+  if (runner && icount > 1) {
+    world->defer_geom_moved = 1;
+    runner (runner_data,icount,&dxStepIslandInSet,&set);
+    world->defer_geom_moved = 0;
+
+    // now that we're single threaded again, let spaces know what moved
+    // (in the same order the serial stepper would have)
+    for (int i=0; i<bcount; i++) {
+      for (dxGeom *geom = body[i]->geom; geom; geom = dGeomGetBodyNext (geom))
+	dGeomMoved (geom);
+    }
+  }
+  else {
+    for (int i=0; i<icount; i++) dxStepIslandInSet (&set,i);
+  }
+
+  // steppers may have altered tags; restore them and make sure all
+  // bodies are in the enabled state
+  for (int i=0; i<bcount; i++) {
+    body[i]->tag = 1;
+    body[i]->flags &= ~dxBodyDisabled;
+  }
+  for (int i=0; i<jcount; i++) joint[i]->tag = 1;
+}
@@ -24,6 +24,7 @@
 #define _ODE_UTIL_H_
 
 #include "ode/ode_objects_private.h"
+#include "ode/ode_objects.h"
 
 
 void dInternalHandleAutoDisabling (dxWorld *world, dReal stepsize);
@@ -33,6 +34,9 @@ typedef void (*dstepper_fn_t) (dxWorld *world, dxBody * const *body, int nb,
         dxJoint * const *_joint, int nj, dReal stepsize);
 
 void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper);
+void dxProcessIslandsParallel (dxWorld *world, dReal stepsize,
+                               dstepper_fn_t stepper, dIslandRunnerFn runner,
+                               void *runner_data);
 
 
 
@@ -6,6 +6,7 @@ from __future__ import annotations
 
 from bascenev1 import _messages
 from bascenev1 import _hooks
+from bascenev1 import _collision
 from bascenev1._player import Player
 from bascenev1._dependency import AssetPackage
 from bascenev1._activity import Activity
@@ -32,4 +33,5 @@ values = [
     Activity,  # kActivityClass
     Session,  # kSceneV1SessionClass
     HostInfo,  # kHostInfoClass
+    _collision.dispatch_collision_batch,  # kDispatchCollisionBatchCall
 ]
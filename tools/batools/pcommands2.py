@@ -686,3 +686,60 @@ def asset_package_assemble() -> None:
         raise CleanError(
             f'Failed to assemble {apversion} ({flavor} flavor).'
         ) from exc
+
+
+def asset_archive_build() -> None:
+    """Pack an asset dir (such as ba_data) into a '.bapack' archive.
+
+    The engine maps these at launch and serves files out of them in
+    place of loose files, saving a pile of per-file opens and stats.
+    Audio is left out since it is still read directly from disk.
+    """
+    import os
+    import struct
+
+    from efro.error import CleanError
+    from efro.terminal import Clr
+
+    args = pcommand.get_args()
+    if len(args) not in (1, 2):
+        raise CleanError('Expected a src dir and optional output path.')
+    srcdir = os.path.abspath(args[0])
+    outpath = args[1] if len(args) > 1 else srcdir + '.bapack'
+    if not os.path.isdir(srcdir):
+        raise CleanError(f"Not a directory: '{srcdir}'.")
+
+    names: list[str] = []
+    for root, dirs, files in os.walk(srcdir):
+        dirs.sort()
+        relroot = os.path.relpath(root, srcdir).replace(os.sep, '/')
+        if relroot.split('/')[0] in ('audio', 'audio2', 'python'):
+            dirs.clear()
+            continue
+        for fname in sorted(files):
+            names.append(fname if relroot == '.' else f'{relroot}/{fname}')
+
+    # Index size is known up front, so we can lay out data right after.
+    encoded = [name.encode() for name in names]
+    index_size = 16 + sum(20 + len(name) for name in encoded)
+    entries: list[tuple[int, int]] = []
+    offset = (index_size + 15) & ~15
+    for name in names:
+        size = os.path.getsize(os.path.join(srcdir, name))
+        entries.append((offset, size))
+        offset = (offset + size + 15) & ~15
+
+    # Write to a temp path and move into place so the engine never sees
+    # a partial archive.
+    tmppath = outpath + '.tmp'
+    with open(tmppath, 'wb') as outfile:
+        outfile.write(struct.pack('<4sIII', b'BAPK', 1, len(names), 0))
+        for name, (entry_offset, size) in zip(encoded, entries):
+            outfile.write(struct.pack('<QQI', entry_offset, size, len(name)))
+            outfile.write(name)
+        for name, (entry_offset, _size) in zip(names, entries):
+            outfile.write(b'\0' * (entry_offset - outfile.tell()))
+            with open(os.path.join(srcdir, name), 'rb') as infile:
+                outfile.write(infile.read())
+    os.replace(tmppath, outpath)
+    print(f'{Clr.BLU}Wrote {len(names)} files to {outpath}.{Clr.RST}')